@@ -4,240 +4,925 @@
 #include "App.h"
 #include "../config/pins.h"
 #include "../config/params.h"
+#include "../core/LatencyTrace.h"
+#include "../core/CpuLoad.h"
+#include "../core/Profiler.h"
+#include "../core/HeapGuard.h"
+#include "../core/Placement.h"
+#include <Preferences.h>
+#include <LittleFS.h>
+#include <esp_timer.h>
 
-bool App::begin(){
-  Serial.begin(115200);
-  //Serial.setTxTimeoutMs(0);
-  unsigned long t0 = millis();
-  while (!Serial && (millis() - t0) < 2000) { delay(10); }
-  delay(100); // Mehr Zeit für Serial
-  
-  Serial.println("\n" + String('=', 60));
-  Serial.println("[APP] ESP32-S3 Touch LCD 2.8\" - Debug Version");
-  Serial.println("[APP] Start initialization...");
-  Serial.println(String('=', 60));
-
-  // I2C Busse mit mehr Debug
-  Serial.println("[APP] Setting up I2C buses...");
-  Wire.begin(PIN_IMU_SDA, PIN_IMU_SCL, I2C_FREQ_HZ);
-  Wire1.begin(PIN_TOUCH_SDA, PIN_TOUCH_SCL, I2C_FREQ_HZ);
-  delay(100); // Mehr Zeit
-  
-  Serial.printf("[APP] I2C0 (IMU): SDA=%d SCL=%d @ %dHz\n", 
-                PIN_IMU_SDA, PIN_IMU_SCL, I2C_FREQ_HZ);
-  Serial.printf("[APP] I2C1 (TOUCH): SDA=%d SCL=%d @ %dHz\n", 
-                PIN_TOUCH_SDA, PIN_TOUCH_SCL, I2C_FREQ_HZ);
-  
-  scanI2C(Wire,  "I2C0(IMU)");
-  scanI2C(Wire1, "I2C1(TOUCH)");
-
-  // Display init
-  Serial.println("[APP] Display init...");
-  if (!_disp.begin()) { 
-    Serial.println("[APP] ERROR: Display init failed!"); 
-    return false; 
-  }
-  Serial.println("[APP] Display OK");
-
-  // Touch init mit mehr Debug
-  Serial.println("[APP] Touch init...");
-  bool touchOK = _touch.begin();
-  if (!touchOK) {
-    Serial.println("[APP] WARNING: Touch init failed - continuing anyway");
-  } else {
-    Serial.println("[APP] Touch OK");
-  }
+// ---------------------------- Modbus-Registerkarte --------------------------
+// Statische, nach Adresse sortierte Tabellen (Binärsuche im Slave).
+// Input-Register (0x04) werden im Loop aus dem App-Zustand gefüllt.
+static uint16_t s_mbInput[9];
+static const ModbusReg MB_INPUT_REGS[] = {
+  {0x0000, &s_mbInput[0], false},   // letzte Geste (GestureType)
+  {0x0001, &s_mbInput[1], false},   // aktive Touchpunkte
+  {0x0002, &s_mbInput[2], false},   // ax [mg] (int16)
+  {0x0003, &s_mbInput[3], false},   // ay [mg]
+  {0x0004, &s_mbInput[4], false},   // az [mg]
+  {0x0005, &s_mbInput[5], false},   // gx [0.1 dps] (int16)
+  {0x0006, &s_mbInput[6], false},   // gy
+  {0x0007, &s_mbInput[7], false},   // gz
+  {0x0008, &s_mbInput[8], false},   // FPS x10
+};
 
-  // IMU init mit Debug
-  Serial.println("[APP] IMU init...");
-  bool imuOK = _imu.begin();
-  if (!imuOK) {
-    Serial.println("[APP] WARNING: IMU init failed - continuing anyway");
-  } else {
-    Serial.println("[APP] IMU OK");
-  }
+// Holding-Register (0x03/0x06/0x10)
+static uint16_t s_mbHolding[4] = {1, 0, 0, 0};
+static const ModbusReg MB_HOLDING_REGS[] = {
+  {0x0000, &s_mbHolding[0], true},  // Backlight 0/1
+  {0x0001, &s_mbHolding[1], true},  // Audio-Cue abspielen (GestureType)
+  {0x0002, &s_mbHolding[2], true},  // frei für SPS
+  {0x0003, &s_mbHolding[3], true},  // frei für SPS
+};
 
-  // Audio init
-  Serial.println("[APP] Audio init...");
-  if (!_audio.begin()) {
-    Serial.println("[APP] WARNING: Audio init failed - continuing anyway");
-  } else {
-    Serial.println("[APP] Audio OK");
-  }
+// Loop-Task für den Stall-Monitor (blockierende Aufrufe anderer Tasks zählen nicht)
+static TaskHandle_t s_loopTask = nullptr;
 
-  // RS485 & Console
-  _rs485.begin(115200);
-  _console.begin(115200);
-  _console.onLine([this](const String& line){
-    if (line.startsWith("rs485send ")){
-      String payload = line.substring(10);
-      _rs485.write(payload + "\r\n");
-      Serial.println("[RS485] TX: " + payload);
-    }
-    else if (line.startsWith("rs485baud ")){
-      uint32_t b = line.substring(10).toInt();
-      if (b > 0){
-        _rs485.setBaud(b);
-        Serial.printf("[RS485] Baud -> %u\n", b);
-      }
+bool App::begin(){
+  // Boot-Schritte: Wartezeiten (Touch-Reset, IMU-Anlauf) laufen verschränkt,
+  // Display/Audio füllen die Lücken; Zeitleiste danach bzw. mit "boot"
+  _boot.begin([]{ return (uint32_t)micros(); },
+              [](uint32_t us){ if (us >= 1000) delay((us + 999) / 1000); else delayMicroseconds(us); });
+
+  const int serial = _boot.add("serial", [](void*, uint8_t phase){
+    if (phase == 0) Serial.begin(115200);
+    // Nur zum Debuggen: auf den Monitor warten, damit nichts verloren geht
+    if (BOOT_DEBUG_DELAYS && !Serial && phase * 10u < BOOT_SERIAL_WAIT_MS) return BootResult::waitMs(10);
+    Serial.println("\n============================================================");
+    Serial.println("[APP] ESP32-S3 Touch LCD 2.8\" - Debug Version");
+    Serial.println("[APP] Start initialization...");
+    Serial.println("============================================================");
+    return BootResult::done();
+  }, this);
+  const uint32_t afterSerial = 1u << serial;
+
+  // I2C Busse – je Bus ein Worker-Task (laufen parallel)
+  const int i2c = _boot.add("i2c", [](void* c, uint8_t){
+    App& app = *static_cast<App*>(c);
+    if (!app._i2c0.begin("i2c0", PIN_IMU_SDA, PIN_IMU_SCL, I2C_FREQ_HZ) ||
+        !app._i2c1.begin("i2c1", PIN_TOUCH_SDA, PIN_TOUCH_SCL, I2C_FREQ_HZ)) {
+      Serial.println("[APP] ERROR: I2C engine init failed!");
+      return BootResult::failed();
     }
-    else if (line == "rs485echo on"){
-      _echo485 = true;  Serial.println("[RS485] Echo ON");
+    Serial.printf("[APP] I2C0 (IMU): SDA=%d SCL=%d @ %dHz\n", PIN_IMU_SDA, PIN_IMU_SCL, I2C_FREQ_HZ);
+    Serial.printf("[APP] I2C1 (TOUCH): SDA=%d SCL=%d @ %dHz\n", PIN_TOUCH_SDA, PIN_TOUCH_SCL, I2C_FREQ_HZ);
+    return BootResult::done();
+  }, this, afterSerial);
+
+  // Touch: Reset-Puls und Anlaufzeit ohne delay(), danach IRQ + Probe
+  const int touch = _boot.add("touch", [](void* c, uint8_t phase){
+    App& app = *static_cast<App*>(c);
+    switch (phase) {
+      case 0:  app._touch.resetAssert(app._i2c1); return BootResult::waitMs(TOUCH_RST_LOW_MS);
+      case 1:  app._touch.resetRelease();         return BootResult::waitMs(TOUCH_RST_BOOT_MS);
+      default: break;
     }
-    else if (line == "rs485echo off"){
-      _echo485 = false; Serial.println("[RS485] Echo OFF");
+    const bool ok = app._touch.attach();
+    Serial.println(ok ? "[APP] Touch OK" : "[APP] WARNING: Touch init failed - continuing anyway");
+    return BootResult::of(ok);
+  }, this, 1u << i2c);
+
+  const int imu = _boot.add("imu", [](void* c, uint8_t phase){
+    App& app = *static_cast<App*>(c);
+    bool ok = true;
+    switch (phase) {
+      case 0:
+        if (app._imu.beginReset(app._i2c0)) return BootResult::waitMs(IMU_RESET_MS);
+        ok = false;
+        break;
+      case 1:
+        if (app._imu.beginConfigure()) return BootResult::waitMs(IMU_ENABLE_MS);
+        ok = false;
+        break;
+      default: break;
     }
-    else if (line == "debug touch"){
-      Serial.println("[DEBUG] Touch active points: " + String(_touch.activeCount()));
-      TouchPoint pts[MAX_TOUCH_POINTS];
-      _touch.getTouchPoints(pts);
-      for(int i=0; i<MAX_TOUCH_POINTS; i++){
-        if(pts[i].active) {
-          Serial.printf("[DEBUG] Touch %d: (%d,%d) strength=%d\n", 
-                        i, pts[i].x, pts[i].y, pts[i].strength);
-        }
+    Serial.println(ok ? "[APP] IMU OK" : "[APP] WARNING: IMU init failed - continuing anyway");
+    return BootResult::of(ok);
+  }, this, 1u << i2c);
+
+  // Display-Init (Panel-Reset, Sleep-Out – in LovyanGFX blockierend) in
+  // einem kurzlebigen Task auf dem noch freien Core 0; der Loop-Task
+  // erledigt derweil die Touch-/IMU-Schritte
+  const int display = _boot.add("display", [](void* c, uint8_t){
+    App& app = *static_cast<App*>(c);
+    if (app._dispBoot == DISP_BOOT_IDLE) {        // genau einmal starten, egal wie lange gepollt wird
+      app._dispBoot = DISP_BOOT_RUNNING;
+      if (xTaskCreatePinnedToCore([](void* a){
+            App& app = *static_cast<App*>(a);
+            app._dispBoot = app._disp.begin() ? DISP_BOOT_OK : DISP_BOOT_FAILED;
+            vTaskDelete(nullptr);
+          }, "dispboot", 4096, &app, 1, nullptr, BOOT_DISPLAY_CORE) != pdPASS) {
+        app._dispBoot = app._disp.begin() ? DISP_BOOT_OK : DISP_BOOT_FAILED;   // ohne Task: hier
       }
     }
-    else if (line == "debug imu"){
-      Serial.printf("[DEBUG] IMU: ax=%.3f ay=%.3f az=%.3f gx=%.1f gy=%.1f gz=%.1f\n",
-                    _imuData.ax, _imuData.ay, _imuData.az, 
-                    _imuData.gx, _imuData.gy, _imuData.gz);
-      float total_g = sqrt(_imuData.ax*_imuData.ax + _imuData.ay*_imuData.ay + _imuData.az*_imuData.az);
-      Serial.printf("[DEBUG] |g| = %.3f (should be ~1.0)\n", total_g);
+    if (app._dispBoot == DISP_BOOT_RUNNING) return BootResult::waitMs(BOOT_POLL_MS);
+    if (app._dispBoot != DISP_BOOT_OK) {
+      Serial.println("[APP] ERROR: Display init failed!");
+      return BootResult::failed();
     }
+    Serial.println("[APP] Display OK");
+    return BootResult::done();
+  }, this, afterSerial);
 
-    
-    else {
-      Serial.println("Commands: rs485send <text> | rs485baud <n> | rs485echo on|off");
-      Serial.println("          debug touch | debug imu");
-    }
-  });
+  _boot.add("audio", [](void* c, uint8_t){
+    const bool ok = static_cast<App*>(c)->_audio.begin();
+    Serial.println(ok ? "[APP] Audio OK" : "[APP] WARNING: Audio init failed - continuing anyway");
+    return BootResult::of(ok);
+  }, this, afterSerial);
+
+  // Adresskarten erst nach den Treibern: deren Reset/Anlauf ist dann vorbei
+  _boot.add("scan i2c0", [](void* c, uint8_t){
+    App& app = *static_cast<App*>(c);
+    app.scanBus(app._i2c0);
+    return BootResult::done();
+  }, this, 1u << imu);
+  _boot.add("scan i2c1", [](void* c, uint8_t){
+    App& app = *static_cast<App*>(c);
+    app.scanBus(app._i2c1);
+    return BootResult::done();
+  }, this, 1u << touch);
+
+  // RS485 & Console
+  _boot.add("comm", [](void* c, uint8_t){
+    App& app = *static_cast<App*>(c);
+    app._rs485.begin(115200);
+    app._rs485.setFraming(RS485Framing::Delimiter, '\n');
+    app._console.begin(115200);
+    app.registerCommands(app._console.commands());
+    return BootResult::done();
+  }, this, afterSerial);
+
+  _boot.run();
+  if (!_boot.stats(display).ok) return false;
 
   _gest.reset();
   _lastGesture.type = GestureType::None;
   _lastFrame = millis();
-  
+
+  // Eingabe auf Core 0, Loop (Display/RS485/Konsole) auf Core 1
+  subscribeEvents();                 // vor dem Eingabe-Task: Abonnentenliste fest
+  if (INPUT_ON_OWN_CORE && !startInputTask()) {
+    Serial.println("[APP] ERROR: Input task failed - Eingabe läuft im Loop");
+  }
+  addJobs();
+
+  // Stall-Monitor: BLOCKING_SCOPE zählt nur im Loop-Task (setup() läuft schon dort)
+  s_loopTask = xTaskGetCurrentTaskHandle();
+  _stall.begin([]{ return (uint32_t)micros(); },
+               []{ return xTaskGetCurrentTaskHandle() == s_loopTask; }, STALL_BUDGET_US);
+  _stall.install();
+
+#if STATIC_ALLOC_MODE
+  // Statischer Betrieb: Stream-Task schon jetzt anlegen (schläft bis "stream on")
+  if (!_stream.begin()) Serial.println("[APP] WARNING: Stream-Task nicht angelegt");
+#endif
+  // Bildschirm-Spiegel: Schatten im PSRAM + Task (schläft bis "mirror on")
+  if (!_disp.mirror().begin(_disp.gfx())) Serial.println("[APP] WARNING: Bildschirm-Spiegel nicht verfügbar");
+  printBootStats();
+  heapguard::seal();                 // ab hier: kein Heap mehr ("heap")
+
   Serial.println("[APP] ==> INIT COMPLETE <==");
   Serial.println();
   return true;
 }
 
-void App::scanI2C(TwoWire& w, const char* name){
-  Serial.printf("[SCAN] %s...\n", name);
-  bool found = false;
-  for (uint8_t a=1; a<127; a++){
-    w.beginTransmission(a);
-    if (w.endTransmission()==0){
-      Serial.printf("  -> FOUND: 0x%02X (%d)\n", a, a);
-      found = true;
+// ---------------------------- Konsole ---------------------------------------
+// Modul-Befehle kommen aus den Modulen selbst, hier nur die App-weiten
+// (Betriebsarten, Modbus, I²C beider Busse). Tabelle nach Name sortiert.
+void App::registerCommands(cmd::Registry& r){
+  static constexpr cmd::Command APP_CMDS[] = {
+    {"boot", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->printBootStats();
+    }},
+    {"boot rescan", "", "", [](void* c, const cmd::Args&){
+      App& app = *static_cast<App*>(c);
+      app.scanBus(app._i2c0, true);
+      app.scanBus(app._i2c1, true);
+    }},
+    {"bus reset", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->_bus.resetStats();
+      Serial.println("[BUS] Stats reset");
+    }},
+    {"bus stats", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->printBusStats();
+    }},
+    {"i2c reset", "", "", [](void* c, const cmd::Args&){
+      App& app = *static_cast<App*>(c);
+      app._i2c0.resetStats();
+      app._i2c1.resetStats();
+      Serial.println("[I2C] Stats reset");
+    }},
+    {"i2c stats", "", "", [](void* c, const cmd::Args&){
+      App& app = *static_cast<App*>(c);
+      app._i2c0.printStats(Serial);
+      app._i2c1.printStats(Serial);
+    }},
+    {"input stats", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->printInputStats();
+    }},
+    {"modbus master", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->setRS485Mode(RS485_MB_MASTER);
+    }},
+    {"modbus off", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->setRS485Mode(RS485_TEXT);
+    }},
+    {"modbus poll add", "cchhh?c", "<id> <fn> <addr> <n> <ms> [prio]", [](void* c, const cmd::Args& a){
+      App* app = masterOnly(c);
+      if (!app) return;
+      int idx = app->_mbPoll.add((uint8_t)a.u(0), (uint8_t)a.u(1), (uint16_t)a.u(2), (uint16_t)a.u(3),
+                                 (uint16_t)a.u(4), (uint8_t)a.u(5));
+      if (idx < 0) Serial.println("[MB-POLL] ungültig/voll (erst 'modbus poll stop')");
+      else Serial.printf("[MB-POLL] #%d angelegt\n", idx);
+    }},
+    {"modbus poll clear", "", "", [](void* c, const cmd::Args&){
+      App* app = masterOnly(c);
+      if (!app) return;
+      app->_mbPoll.end();
+      app->_mbPoll.clear();
+      Serial.println("[MB-POLL] Tabelle geleert");
+    }},
+    {"modbus poll start", "", "", [](void* c, const cmd::Args&){
+      App* app = masterOnly(c);
+      if (!app) return;
+      app->_mbPoll.begin(app->_mbMaster);
+      app->_mbPoll.start();
+      Serial.printf("[MB-POLL] %s\n", app->_mbPoll.running() ? "gestartet" : "keine Abfragen");
+    }},
+    {"modbus poll stats", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->_mbPoll.printStats(Serial);
+    }},
+    {"modbus poll stop", "", "", [](void* c, const cmd::Args&){
+      App* app = masterOnly(c);
+      if (!app) return;
+      app->_mbPoll.end();
+      Serial.println("[MB-POLL] gestoppt");
+    }},
+    {"modbus read", "chu", "<id> <addr> <n>", [](void* c, const cmd::Args& a){
+      if (App* app = masterOnly(c)) app->modbusRead(modbus::ReadHolding, a);
+    }},
+    {"modbus readin", "chu", "<id> <addr> <n>", [](void* c, const cmd::Args& a){
+      if (App* app = masterOnly(c)) app->modbusRead(modbus::ReadInput, a);
+    }},
+    {"modbus slave", "?u", "[id]", [](void* c, const cmd::Args& a){
+      const uint32_t id = a.u(0, MODBUS_DEFAULT_SLAVE_ID);
+      static_cast<App*>(c)->setRS485Mode(RS485_MB_SLAVE, id > 0 && id < 248 ? (uint8_t)id : MODBUS_DEFAULT_SLAVE_ID);
+    }},
+    {"modbus stats", "", "", [](void* c, const cmd::Args&){
+      App& app = *static_cast<App*>(c);
+      app._mbSlave.printStats(Serial);
+      app._mbMaster.printStats(Serial);
+    }},
+    {"modbus write", "chh", "<id> <addr> <val>", [](void* c, const cmd::Args& a){
+      App* app = masterOnly(c);
+      if (!app) return;
+      app->_mbReadCount = 0;
+      if (!app->_mbMaster.writeSingle((uint8_t)a.u(0), (uint16_t)a.u(1), (uint16_t)a.u(2), onModbusResult, app)) {
+        Serial.println("[MODBUS] busy/ungültig");
+      }
+    }},
+    {"rs485 load", "u", "<us>", [](void* c, const cmd::Args& a){
+      static_cast<App*>(c)->_loadUs = a.u(0);
+      Serial.printf("[RS485] künstliche Loop-Last: %u us\n", a.u(0));
+    }},
+    {"rs485 sink", "b", "on|off", [](void* c, const cmd::Args& a){
+      static_cast<App*>(c)->_rs485Sink = a.b(0);
+      Serial.printf("[RS485] Sink %s\n", a.b(0) ? "ON (Zeilen nur zählen)" : "OFF");
+    }},
+    {"rs485baud", "u", "<baud>", [](void* c, const cmd::Args& a){
+      App& app = *static_cast<App*>(c);
+      if (a.u(0) == 0) return;
+      app._rs485.setBaud(a.u(0));
+      app._rs485.setGap(modbus::gapSymbols(a.u(0)));   // t3.5 nachführen, Modus läuft weiter
+      Serial.printf("[RS485] Baud -> %u\n", a.u(0));
+    }},
+    {"rs485bench peer", "", "", [](void* c, const cmd::Args&){
+      App& app = *static_cast<App*>(c);
+      app.setRS485Mode(RS485_BENCH);
+      app._bench.startPeer();
+    }},
+    {"rs485bench run", "?u", "[maxBaud]", [](void* c, const cmd::Args& a){
+      App& app = *static_cast<App*>(c);
+      app.setRS485Mode(RS485_BENCH);
+      if (!app._bench.run(a.u(0))) Serial.println("[BENCH] läuft bereits");
+    }},
+    {"rs485bench stop", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->setRS485Mode(RS485_TEXT);
+    }},
+    {"rs485echo", "b", "on|off", [](void* c, const cmd::Args& a){
+      static_cast<App*>(c)->_echo485 = a.b(0);
+      Serial.printf("[RS485] Echo %s\n", a.b(0) ? "ON" : "OFF");
+    }},
+    {"sched reset", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->_sched.resetStats();
+      Serial.println("[SCHED] Stats reset");
+    }},
+    {"sched stats", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->printSchedStats();
+    }},
+    {"stall", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->printStallStats();
+    }},
+    {"stall budget", "u", "<us>", [](void* c, const cmd::Args& a){
+      static_cast<App*>(c)->_stall.setBudget(a.u(0));
+      Serial.printf("[STALL] Budget %u us\n", a.u(0));
+    }},
+    {"stall reset", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->_stall.reset();
+      Serial.println("[STALL] Stats reset");
+    }},
+    {"telemetry off", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->setRS485Mode(RS485_TEXT);
+    }},
+    {"telemetry on", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->setRS485Mode(RS485_TELEMETRY);
+    }},
+    {"telemetry stats", "", "", [](void* c, const cmd::Args&){
+      static_cast<App*>(c)->_telem.stats().print(Serial);
+    }},
+    {"touchrec play", "?wf", "[datei|-|off] [tempo]", [](void* c, const cmd::Args& a){
+      static_cast<App*>(c)->startReplay(a);
+    }},
+  };
+  static_assert(cmd::sorted(APP_CMDS), "APP_CMDS nicht sortiert");
+
+  r.add(APP_CMDS, this, "app");
+  _rs485.registerCommands(r);
+  _touch.registerCommands(r);
+  _imu.registerCommands(r);
+  _audio.registerCommands(r);
+  _stream.registerCommands(r);
+  _disp.mirror().registerCommands(r);
+  latency::registerCommands(r);
+  cpuload::registerCommands(r);
+  prof::registerCommands(r);
+  heapguard::registerCommands(r);
+  place::registerCommands(r);
+}
+
+App* App::masterOnly(void* ctx){
+  App* app = static_cast<App*>(ctx);
+  if (app->_rs485Mode == RS485_MB_MASTER) return app;
+  Serial.println("[MODBUS] erst 'modbus master'");
+  return nullptr;
+}
+
+void App::modbusRead(uint8_t fn, const cmd::Args& a){
+  _mbReadCount = (uint16_t)constrain(a.u(2), 1u, 16u);
+  if (!_mbMaster.readRegisters((uint8_t)a.u(0), fn, (uint16_t)a.u(1), _mbReadCount, _mbReadBuf, onModbusResult, this)) {
+    Serial.println("[MODBUS] busy/ungültig");
+  }
+}
+
+// ---------------------------- Modbus ----------------------------------------
+void App::setRS485Mode(uint8_t mode, uint8_t slaveId){
+  _mbPoll.end();
+  _mbSlave.end();
+  _mbMaster.end();
+  _telem.end();
+  if (mode != RS485_BENCH) _bench.end();
+  _rs485Mode = mode;
+  if (mode == RS485_MB_SLAVE) {
+    ModbusRegMap map;
+    map.holding      = MB_HOLDING_REGS;
+    map.holdingCount = sizeof(MB_HOLDING_REGS) / sizeof(MB_HOLDING_REGS[0]);
+    map.input        = MB_INPUT_REGS;
+    map.inputCount   = sizeof(MB_INPUT_REGS) / sizeof(MB_INPUT_REGS[0]);
+    map.onWrite      = onModbusWrite;
+    map.ctx          = this;
+    _mbSlave.begin(_rs485, slaveId, map);
+    Serial.printf("[MODBUS] Slave-ID %u aktiv\n", slaveId);
+  } else if (mode == RS485_MB_MASTER) {
+    _mbMaster.begin(_rs485);
+    Serial.println("[MODBUS] Master aktiv");
+  } else if (mode == RS485_TELEMETRY) {
+    _rs485.setFraming(RS485Framing::Off, 0);
+    _telem.begin(_rs485);
+    Serial.printf("[TELEM] aktiv (MTU %u)\n", (unsigned)TELEM_MTU);
+  } else if (mode == RS485_BENCH) {
+    _bench.begin(_rs485);
+  } else if (mode == RS485_TEXT) {
+    _rs485.setFraming(RS485Framing::Delimiter, '\n');
+    Serial.println("[MODBUS] aus (Textmodus)");
+  }
+}
+
+// Läuft im UART-Event-Task
+// Auswertung im Abonnenten "panel" (subscribeEvents)
+void App::onModbusWrite(uint16_t addr, uint16_t value, void* ctx){
+  CommEvent m;
+  m.kind  = CommKind::ModbusWrite;
+  m.addr  = addr;
+  m.value = value;
+  publishEvent(static_cast<App*>(ctx)->_bus, m);
+}
+
+// Läuft in ModbusMaster::loop() (Loop-Kontext)
+void App::onModbusResult(ModbusResult r, uint8_t exc, void* ctx){
+  App* app = static_cast<App*>(ctx);
+  CommEvent m;
+  m.kind  = CommKind::ModbusResult;
+  m.code  = (uint8_t)r;
+  m.value = exc;
+  publishEvent(app->_bus, m);
+  if (r != ModbusResult::Ok) {
+    Serial.printf("[MODBUS] Fehler %u (exception=0x%02X)\n", (unsigned)r, exc);
+    return;
+  }
+  Serial.printf("[MODBUS] OK (%uus)", app->_mbMaster.stats().turnLastUs);
+  for (uint16_t i = 0; i < app->_mbReadCount; i++) Serial.printf(" %u", app->_mbReadBuf[i]);
+  Serial.println();
+}
+
+void App::updateModbusRegs(){
+  s_mbInput[0] = (uint16_t)_lastGesture.type;
+  s_mbInput[1] = _activeCount;
+  s_mbInput[2] = (uint16_t)(int16_t)lroundf(_imuData.ax * 1000.f);
+  s_mbInput[3] = (uint16_t)(int16_t)lroundf(_imuData.ay * 1000.f);
+  s_mbInput[4] = (uint16_t)(int16_t)lroundf(_imuData.az * 1000.f);
+  s_mbInput[5] = (uint16_t)(int16_t)lroundf(_imuData.gx * 10.f);
+  s_mbInput[6] = (uint16_t)(int16_t)lroundf(_imuData.gy * 10.f);
+  s_mbInput[7] = (uint16_t)(int16_t)lroundf(_imuData.gz * 10.f);
+  s_mbInput[8] = (uint16_t)lroundf(_fps * 10.f);
+}
+
+// Adresskarte je Bus (1 Bit je 7-Bit-Adresse) im NVS. Antworten alle
+// gespeicherten Adressen, entfällt der volle Scan über 126 Adressen;
+// sonst voller Scan und neue Karte ("boot rescan" erzwingt ihn).
+bool App::scanBus(I2CEngine& bus, bool force){
+  uint8_t map[16] = {0}, old[16] = {0};
+  Preferences nvs;
+  const bool nvsOk = nvs.begin(BOOT_NVS_NS, false);
+  bool hit = !force && nvsOk && nvs.getBytes(bus.name(), old, sizeof(old)) == sizeof(old);
+  uint8_t n = 0;
+  for (uint8_t a = 1; a < 127 && hit; a++) {
+    if (!(old[a >> 3] & (1u << (a & 7)))) continue;
+    if (!bus.probe(a)) hit = false;
+    n++;
+  }
+  if (hit && n) {
+    memcpy(map, old, sizeof(map));
+  } else {
+    hit = false;
+    n = 0;
+    for (uint8_t a = 1; a < 127; a++) {
+      if (bus.probe(a)) { map[a >> 3] |= 1u << (a & 7); n++; }
     }
+    if (nvsOk && memcmp(map, old, sizeof(map)) != 0) nvs.putBytes(bus.name(), map, sizeof(map));
+  }
+  if (nvsOk) nvs.end();
+
+  Serial.printf("[SCAN] %s%s:", bus.name(), hit ? " (Cache)" : "");
+  for (uint8_t a = 1; a < 127; a++) {
+    if (map[a >> 3] & (1u << (a & 7))) Serial.printf(" 0x%02X", a);
   }
-  if (!found) {
-    Serial.println("  -> NO DEVICES FOUND!");
+  Serial.println(n ? "" : " NO DEVICES FOUND!");
+  if (hit) _scanCached++;
+  return hit;
+}
+
+// ---------------------------- Loop-Jobs -------------------------------------
+// Reihenfolge bestimmt der Scheduler (früheste Deadline zuerst), nicht die
+// Position im Code. Kein Job blockiert: I²C läuft in den Worker-Tasks, hier
+// wird nur angefordert und abgeholt.
+void App::addJobs(){
+  _sched.begin([]{ return (uint32_t)micros(); });
+  if (!_inputTask) {
+    _jobInput = _sched.add("input", [](void* c){ static_cast<App*>(c)->inputStep(); }, this,
+                           SCHED_INPUT_US, 0, 3);
   }
-  Serial.flush();
+  _sched.add("comm", [](void* c){ static_cast<App*>(c)->jobComm(); }, this,
+             SCHED_COMM_US, SCHED_COMM_DL_US, 2);
+  _sched.add("hud", [](void* c){ static_cast<App*>(c)->jobHud(); }, this,
+             SCHED_HUD_US, 0, 1, SCHED_HUD_BUDGET_US);
+  _sched.add("console", [](void* c){ static_cast<App*>(c)->_console.loop(); }, this,
+             SCHED_CONSOLE_US, SCHED_CONSOLE_DL_US, 0);
+  _sched.add("cpuload", [](void*){ cpuload::sample(); }, nullptr,
+             SCHED_CPULOAD_US, 0, 0);
+  _sched.add("heap", [](void*){ heapguard::sample(); }, nullptr,
+             SCHED_HEAP_US, 0, 0);
 }
 
 void App::loop(){
+  _stall.iterationStart();
   unsigned long now = millis();
   
-  // FPS berechnen
+  // FPS berechnen (Loop-Durchläufe)
   float dt = (now - _lastFrame) / 1000.0f; 
   if (dt < 1e-6f) dt = 1e-6f;
   _fps = 0.9f * _fps + 0.1f * (1.0f / dt); 
   _lastFrame = now;
 
-  // TOUCH: Aggressive reading - sowohl IRQ als auch Poll
-  bool doRead = false;
-  if (CST328Touch::irqFlag) {
+  // Eingabe im Loop (ohne eigenen Task): INT-Flanke gibt den Job sofort frei
+  if (!_inputTask && CST328Touch::irqFlag) _sched.trigger(_jobInput);
+
+  _sched.runReady();
+
+  // Testlast für RX-Messungen ("rs485 load <us>")
+  if (_loadUs) {
+    BLOCKING_SCOPE(BlockSite::LoopLoad);
+    const uint32_t t0 = micros();
+    while (micros() - t0 < _loadUs) {}
+  }
+
+}
+
+// ---------------------------- Eingabe-Pipeline ------------------------------
+// Touch lesen/tracken, Gesten, IMU: eigener Task auf INPUT_TASK_CORE, geweckt
+// von INT-Flanke bzw. fertigem Frame, sonst jede Millisekunde. Der Loop sieht
+// nur den zuletzt veröffentlichten InputSnapshot (TripleBuffer, kein Mutex).
+// Audio-Cues und USB-Stream gehen direkt von hier ab (Queue bzw. SPSC-Ring),
+// Telemetrie und HUD übernehmen den Stand im Loop.
+bool App::startInputTask(){
+  if (xTaskCreatePinnedToCore(inputTaskEntry, "input", 4096, this, INPUT_TASK_PRIORITY,
+                              &_inputTask, INPUT_TASK_CORE) != pdPASS) {
+    _inputTask = nullptr;
+    return false;
+  }
+  CST328Touch::setNotifyTask(_inputTask);
+  return true;
+}
+
+void App::inputTaskEntry(void* arg){
+  App* self = static_cast<App*>(arg);
+  InputTaskStats st;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, 1);     // INT/Frame fertig oder spätestens nach 1 Tick
+    const uint32_t t0 = micros();
+    self->inputStep();
+    const uint32_t dt = micros() - t0;
+    st.steps++;
+    st.busyUs += dt;
+    if (dt > st.busyMaxUs) st.busyMaxUs = dt;
+    self->_inputStats.write(st);
+  }
+}
+
+void App::inputStep(){
+  PROF_ZONE(ProfZone::InputStep);
+  const uint32_t nowUs = micros();
+  unsigned long now = millis();
+
+  // Anfordern: Touch bei INT-Flanke, zusätzlich Poll; IMU im festen Takt
+  // (500 Hz während des Streams, sonst 20 Hz). I²C läuft in den Workern.
+  if (CST328Touch::irqFlag || nowUs - _touchReqUs >= INPUT_TOUCH_POLL_US) {
     CST328Touch::irqFlag = false;
-    doRead = true;
+    _touch.requestFrame();
+    _touchReqUs = nowUs;
   }
-  // Poll alle 5ms zusätzlich
-  static unsigned long lastTouchPoll = 0;
-  if (now - lastTouchPoll >= 5) {
-    doRead = true;
-    lastTouchPoll = now;
+  const uint32_t imuPeriod = _stream.active() ? STREAM_IMU_PERIOD_MS * 1000u : INPUT_IMU_PERIOD_US;
+  if (nowUs - _imuReqUs >= imuPeriod) {
+    _imu.requestRead();
+    _imuReqUs = nowUs;
   }
-  
-  if (doRead) { 
-    if (_touch.readFrame()) { 
-      _touch.mapAndTrack(); 
+
+  // Abholen und dekodieren
+  const bool newFrame = _touch.collectFrame();
+  if (newFrame) {
+    _touch.mapAndTrack();
+  }
+
+  // Während "touchrec play" ersetzt die Aufnahme den Touch (Aufnahme läuft weiter)
+  TouchPoint pts[MAX_TOUCH_POINTS];
+  const uint8_t ac = _replayOn ? replayStep(pts) : touchStep(newFrame, now, pts);
+
+  bool imuFailed = false;
+  if (_imu.collect(_inImu, &imuFailed)) {
+    publishEvent(_bus, _inImu);
+  }
+  if (imuFailed) {
+    static int imuFailCount = 0;
+    imuFailCount++;
+    if (imuFailCount % 100 == 1) { // Log every 100th failure
+      Serial.printf("[IMU] Read failures: %d\n", imuFailCount);
     }
   }
 
+  // Veröffentlichen: Back-Puffer ist ein alter Stand, daher komplett füllen
+  InputSnapshot& snap = _input.back();
+  memcpy(snap.pts, pts, sizeof(snap.pts));
+  snap.activeCount = ac;
+  snap.imu         = _inImu;
+  _input.publish();
+}
+
+uint8_t App::touchStep(bool newFrame, unsigned long now, TouchPoint pts[MAX_TOUCH_POINTS]){
   // Gesten - VEREINFACHT: Weniger Stabilität erforderlich
-  TouchPoint pts[MAX_TOUCH_POINTS]; 
   _touch.getTouchPoints(pts);
+  if (newFrame) {
+    TouchFrameEvent f;
+    f.originUs = _touch.lastFrameOriginUs();
+    for (uint8_t i = 0; i < MAX_TOUCH_POINTS; i++) {
+      if (!pts[i].active) continue;
+      f.activeMask |= (uint8_t)(1u << i);
+      f.count++;
+      f.x[i] = pts[i].x;
+      f.y[i] = pts[i].y;
+      f.strength[i] = pts[i].strength;
+    }
+    publishEvent(_bus, f);
+  }
   uint8_t ac = _touch.activeCount();
   
   static uint8_t lastAc = 0; 
-  static unsigned long acChangedAt = 0;
   if (ac != lastAc) { 
     lastAc = ac; 
-    acChangedAt = now; 
     Serial.printf("[GESTURE] Touch count changed: %d\n", ac);
   }
   
-  // Reduzierte Settle-Zeit
-  bool countStable = (now - acChangedAt) >= TOUCH_SETTLE_MS;
-
+  // Abnehmer (Audio, Stream, Telemetrie, HUD, Log) hängen am Bus;
+  // Settle-Zeit der Fingerzahl prüft die Engine selbst
   GestureEvent g;
-  if (countStable) {
-    g = _gest.process(pts, ac);
-  } else {
-    g.type = GestureType::None;
+  {
+    PROF_ZONE(ProfZone::Gesture);
+    g = _gest.process(pts, ac, (uint32_t)now, _touch.lastFrameOriginUs());
   }
-  
   if (g.type != GestureType::None) {
-    _lastGesture = g;
-    Serial.printf("[GESTURE] Detected: %d at (%d,%d) value=%.2f\n", 
-                  (int)g.type, g.x, g.y, g.value);
-    _audio.playGesture(g.type);
-  }
-
-  // IMU lesen - häufiger für Debug
-  static unsigned long lastIMU = 0;
-  if (now - lastIMU >= 50){ // 20Hz
-    bool imuSuccess = _imu.read(_imuData); 
-    if (!imuSuccess) {
-      static int imuFailCount = 0;
-      imuFailCount++;
-      if (imuFailCount % 100 == 1) { // Log every 100th failure
-        Serial.printf("[IMU] Read failures: %d\n", imuFailCount);
-      }
+    g.event_us = micros();
+    latency::record(LatStage::FrameToGesture, g.event_us - _touch.lastFrameDoneUs());
+    publishEvent(_bus, g);
+  }
+  return ac;
+}
+
+// ---------------------------- Touch-Wiedergabe ------------------------------
+// Eigener Tracker + Engine in TouchReplay (Aufnahmezeit, festes Tick-Raster):
+// gleiche Aufnahme, gleiche Gesten und Prüfsumme wie tools/touchrec_tool
+void App::startReplay(const cmd::Args& a){
+  const char* src = a.s(0, "-");
+  if (!strcmp(src, "off")) {
+    if (_replayOn) _replayStop = true;
+    return;
+  }
+  if (_replayOn) { Serial.println("[TREC] Wiedergabe läuft ('touchrec play off')"); return; }
+  TouchRecorder& rec = _touch.recorder();
+  if (rec.recording() || !rec.data()) { Serial.println("[TREC] erst 'touchrec stop'"); return; }
+
+  if (strcmp(src, "-")) {
+    File f;
+    if (LittleFS.begin(false)) f = LittleFS.open(src, "r");
+    if (!f) { Serial.printf("[TREC] %s nicht lesbar\n", src); return; }
+    if (f.size() > rec.capacity()) {
+      Serial.printf("[TREC] %s: %u B > Puffer %u B\n", src, (unsigned)f.size(), (unsigned)rec.capacity());
+      return;
     }
-    lastIMU = now;
-  }
-
-  // HUD ~30 Hz
-  if (now - _lastHUD >= 33){
-    _disp.renderHUD(_lastGesture, _fps,
-                    _imuData.ax, _imuData.ay, _imuData.az,
-                    _imuData.gx, _imuData.gy, _imuData.gz);
-    
-    // Touch-Visualisierung temporär auskommentiert
-    // _disp.renderTouchPoints(pts, ac);
-    
-    _lastHUD = now;
-  }
-
-  // Konsole & RS485
-  _console.loop();
-
-  // RS485 RX
-  static char rxbuf[256]; static size_t rxi = 0;
-  while (_rs485.available() > 0){
-    int c = _rs485.read(); if (c < 0) break;
-    if (c == '\r') continue;
-    if (rxi < sizeof(rxbuf) - 1) rxbuf[rxi++] = (char)c;
-    if (c == '\n'){
-      rxbuf[rxi] = 0;
-      String line = String(rxbuf);
-      if (_echo485) _rs485.write(line);
-      Serial.print("[RS485] RX: "); Serial.print(line);
-      rxi = 0;
+    rec.setLength(f.read(rec.buffer(), f.size()));
+    f.close();
+  }
+  if (!_replay.begin(rec.data(), rec.size(), _gest.params(), onReplayEvent, this)) {
+    Serial.println("[TREC] keine gültige Aufnahme");
+    return;
+  }
+  _replaySpeed = a.f(1, 1.f);
+  _replayWall0 = esp_timer_get_time();
+  _replayStop  = false;
+  _replayOn    = true;
+  Serial.printf("[TREC] Wiedergabe: %lu Frames, %.1f s, Tempo x%.2f (0 = max)\n",
+                (unsigned long)_replay.totalFrames(), _replay.lengthUs() / 1e6f, _replaySpeed);
+}
+
+uint8_t App::replayStep(TouchPoint pts[MAX_TOUCH_POINTS]){
+  bool more;
+  {
+    PROF_ZONE(ProfZone::Gesture);
+    const int64_t wallUs = esp_timer_get_time() - _replayWall0;
+    more = _replaySpeed > 0.f ? _replay.advance((uint64_t)((double)wallUs * _replaySpeed))
+                              : _replay.advance(UINT64_MAX, TOUCH_REPLAY_MAX_CALLS);
+  }
+  memcpy(pts, _replay.points(), sizeof(TouchPoint) * MAX_TOUCH_POINTS);
+  const uint8_t ac = _replay.activeCount();
+  if (!more || _replayStop) {
+    Serial.printf("[TREC] Wiedergabe %s: frames=%lu calls=%lu events=%lu hash=%08lX, %.1f s in %.1f s\n",
+                  more ? "abgebrochen" : "fertig", (unsigned long)_replay.frames(),
+                  (unsigned long)_replay.calls(), (unsigned long)_replay.events(),
+                  (unsigned long)_replay.hash(), _replay.positionUs() / 1e6f,
+                  (esp_timer_get_time() - _replayWall0) / 1e6f);
+    _replayStop = false;
+    _replayOn   = false;
+  }
+  return ac;
+}
+
+// Läuft im Eingabe-Task: wie live an den Bus, ohne Latenz-Trace
+void App::onReplayEvent(void* ctx, const GestureEvent& e){
+  App* app = static_cast<App*>(ctx);
+  GestureEvent g = e;
+  g.event_us = micros();
+  publishEvent(app->_bus, g);
+}
+
+// Loop-Seite: Deferred-Abonnenten bedienen, Zustand für HUD/Modbus übernehmen
+void App::takeInput(){
+  _bus.dispatchPending();
+  if (!_input.update()) return;
+  const InputSnapshot& s = _input.front();
+  _activeCount = s.activeCount;
+  _imuData     = s.imu;
+}
+
+// ---------------------------- Event-Bus -------------------------------------
+static void toTouchPoints(const TouchFrameEvent& f, TouchPoint out[MAX_TOUCH_POINTS]){
+  for (uint8_t i = 0; i < MAX_TOUCH_POINTS; i++) {
+    out[i] = TouchPoint{};
+    out[i].active   = (f.activeMask >> i) & 1u;
+    out[i].x        = f.x[i];
+    out[i].y        = f.y[i];
+    out[i].strength = f.strength[i];
+  }
+}
+
+// Sync-Abonnenten laufen im Eingabe-Task: nur Queue/Ring-Übergaben.
+// Alles mit Serial, RS485 oder App-Zustand ist Deferred (Loop).
+void App::subscribeEvents(){
+  _bus.begin([]{ return (uint32_t)micros(); });
+  _bus.subscribe("audio", topicMask(Topic::Gesture), Delivery::Sync,
+                 [](const Event& e, void* c){ static_cast<App*>(c)->_audio.playGesture(e.as<GestureEvent>()); }, this);
+  _bus.subscribe("stream", topicMask(Topic::Touch) | topicMask(Topic::Gesture) | topicMask(Topic::Imu), Delivery::Sync,
+                 [](const Event& e, void* c){
+                   UsbStream& s = static_cast<App*>(c)->_stream;
+                   if (!s.active()) return;
+                   if (e.topic == (uint8_t)Topic::Imu) s.pushImu(e.as<IMUData>());
+                   else if (e.topic == (uint8_t)Topic::Gesture) s.pushGesture(e.as<GestureEvent>());
+                   else {
+                     TouchPoint pts[MAX_TOUCH_POINTS];
+                     toTouchPoints(e.as<TouchFrameEvent>(), pts);
+                     s.pushTouch(pts, MAX_TOUCH_POINTS);
+                   }
+                 }, this);
+  _bus.subscribe("telemetry", topicMask(Topic::Touch) | topicMask(Topic::Gesture) | topicMask(Topic::Imu), Delivery::Deferred,
+                 [](const Event& e, void* c){
+                   TelemetryLink& t = static_cast<App*>(c)->_telem;
+                   if (e.topic == (uint8_t)Topic::Imu) t.pushImu(e.as<IMUData>());
+                   else if (e.topic == (uint8_t)Topic::Gesture) t.pushGesture(e.as<GestureEvent>());
+                   else {
+                     TouchPoint pts[MAX_TOUCH_POINTS];
+                     toTouchPoints(e.as<TouchFrameEvent>(), pts);
+                     t.pushTouch(pts, MAX_TOUCH_POINTS);
+                   }
+                 }, this);
+  _bus.subscribe("hud", topicMask(Topic::Gesture), Delivery::Deferred,
+                 [](const Event& e, void* c){ static_cast<App*>(c)->_lastGesture = e.as<GestureEvent>(); }, this);
+  _bus.subscribe("log", topicMask(Topic::Gesture), Delivery::Deferred,
+                 [](const Event& e, void*){
+                   const GestureEvent& g = e.as<GestureEvent>();
+                   BLOCKING_SCOPE(BlockSite::SerialOut);
+                   Serial.printf("[GESTURE] Detected: %d at (%d,%d) value=%.2f\n",
+                                 (int)g.type, g.x, g.y, g.value);
+                 }, nullptr);
+  // Modbus-Slave: Register 0x0000 = Hintergrundbeleuchtung, 0x0001 = Gesten-Ton
+  _bus.subscribe("panel", topicMask(Topic::Comm), Delivery::Deferred,
+                 [](const Event& e, void* c){
+                   const CommEvent& m = e.as<CommEvent>();
+                   if (m.kind != CommKind::ModbusWrite) return;
+                   if (m.addr == 0x0000) {
+                     bool on = m.value != 0;
+                     digitalWrite(PIN_LCD_BL, (on == PIN_LCD_BL_ACTIVE_HIGH) ? HIGH : LOW);
+                   } else if (m.addr == 0x0001 && m.value <= (uint16_t)GestureType::ThreeFingerTap) {
+                     static_cast<App*>(c)->_audio.playGesture((GestureType)m.value);
+                   }
+                 }, this);
+}
+
+void App::printBusStats(){
+  static BusTopicStats prev[(size_t)Topic::Count];
+  static uint32_t prevUs = 0;
+  const uint32_t nowUs = micros();
+  const float dt = prevUs ? (nowUs - prevUs) / 1e6f : 0.f;
+  Serial.println("[BUS] topic      published      /s  delivered  dropped  pending max");
+  for (uint8_t t = 0; t < (uint8_t)Topic::Count; t++) {
+    const BusTopicStats s = _bus.topicStats(t);
+    const float rate = dt > 0.f && s.published >= prev[t].published ? (s.published - prev[t].published) / dt : 0.f;
+    Serial.printf("[BUS] %-9s %10u %7.0f %10u %8u %12u\n", topicName(t), s.published, rate,
+                  s.delivered, s.dropped, s.pendingHigh);
+    prev[t] = s;
+  }
+  prevUs = nowUs;
+  Serial.printf("[BUS] Queue max %u/%u\n", _bus.queueHigh(), (unsigned)EventBus::QUEUE_DEPTH);
+  for (size_t i = 0; i < _bus.subscriberCount(); i++) {
+    Serial.printf("[BUS] sub %-9s %s mask=0x%02X\n", _bus.subscriberName(i),
+                  _bus.subscriberDelivery(i) == Delivery::Sync ? "sync    " : "deferred", _bus.subscriberMask(i));
+  }
+}
+
+// HUD ~30 Hz
+void App::jobHud(){
+  takeInput();
+  _disp.renderHUD(_lastGesture, _fps,
+                  _imuData.ax, _imuData.ay, _imuData.az,
+                  _imuData.gx, _imuData.gy, _imuData.gz);
+  if (!_firstFrameUs) {
+    // micros() zählt ab App-Start (esp_timer), ROM/Bootloader davor nicht
+    _firstFrameUs = micros();
+    BLOCKING_SCOPE(BlockSite::SerialOut);
+    Serial.printf("[BOOT] erster Frame nach %.1f ms (Ziel %u ms)\n", _firstFrameUs / 1000.f, BOOT_TTFF_TARGET_MS);
+  }
+  
+  updateModbusRegs();
+
+  // Touch-Visualisierung temporär auskommentiert
+  // _disp.renderTouchPoints(pts, ac);
+}
+
+// RS485 je nach Betriebsart
+void App::jobComm(){
+  takeInput();
+  _rs485.loop();
+  if (_rs485Mode == RS485_MB_MASTER) {
+    if (_mbPoll.running()) _mbPoll.loop();
+    else _mbMaster.loop();
+  }
+  _telem.loop();
+  if (_rs485Mode == RS485_BENCH) _bench.loop();
+
+  // RS485 RX (Textmodus): fertige Zeilen aus dem RX-Pool, gefüllt im
+  // UART-Event-Task – hier nur Zeiger abholen und zurückgeben
+  while (RS485Frame* f = _rs485.receive()){
+    CommEvent m;
+    m.kind = CommKind::Rs485Line;
+    m.addr = f->len;
+    publishEvent(_bus, m);
+    if (!_rs485Sink) {
+      if (_echo485) _rs485.write(f->data, f->len);
+      BLOCKING_SCOPE(BlockSite::SerialOut);
+      Serial.print("[RS485] RX: ");
+      Serial.write(f->data, f->len);
+      if (f->flags & RS485Frame::Truncated) Serial.println(" [abgeschnitten]");
     }
+    _rs485.release(f);
   }
+}
+
+void App::printInputStats(){
+  if (!_inputTask) {
+    Serial.println("[INPUT] läuft im Loop (Job \"input\", siehe sched stats)");
+    return;
+  }
+  // Fenster seit dem letzten Aufruf
+  static InputTaskStats prev;
+  static uint32_t prevUs = 0;
+  InputTaskStats st;
+  if (!_inputStats.read(st)) { Serial.println("[INPUT] Stats gerade nicht lesbar"); return; }
+  const uint32_t nowUs = micros(), dt = nowUs - prevUs;
+  const uint32_t steps = st.steps - prev.steps, busy = st.busyUs - prev.busyUs;
+  Serial.printf("[INPUT] core%d: %u Durchläufe, %.0f/s, busy avg %u us, max %u us, %.1f %% des Kerns\n",
+                INPUT_TASK_CORE, steps, prevUs ? steps * 1e6f / dt : 0.f, steps ? busy / steps : 0u,
+                st.busyMaxUs, prevUs ? 100.f * busy / dt : 0.f);
+  prev = st;
+  prevUs = nowUs;
+  cpuload::print(Serial);
+}
+
+void App::printSchedStats(){
+  Serial.println("[SCHED] job       per/us  dl/us prio    runs  run avg/max us  late avg/max us  miss ovr  skip");
+  for (size_t i = 0; i < _sched.count(); i++) {
+    const JobStats& s = _sched.stats((int)i);
+    Serial.printf("[SCHED] %-9s %6u %6u %4u %7u %7u/%-7u %7u/%-7u %5u %4u %5u\n",
+                  _sched.name((int)i), _sched.periodUs((int)i), _sched.deadlineUs((int)i), _sched.priority((int)i),
+                  s.runs, s.runAvgUs(), s.runMaxUs, s.lateAvgUs(), s.lateMaxUs, s.misses, s.overruns, s.skipped);
+  }
+}
+
+void App::printBootStats(){
+  Serial.println("[BOOT] step        start/ms   ende/ms  aktiv/ms phasen");
+  for (size_t i = 0; i < _boot.count(); i++) {
+    const BootStepStats& s = _boot.stats((int)i);
+    Serial.printf("[BOOT] %-10s %9.1f %9.1f %9.1f %6u%s\n", _boot.name((int)i), s.startUs / 1000.f,
+                  s.endUs / 1000.f, s.activeUs / 1000.f, s.phases, s.ok ? "" : "  FEHLER");
+  }
+  Serial.printf("[BOOT] Sequenz %.1f ms ab %.1f ms, davon gewartet %.1f ms, Scan-Cache %u/2\n",
+                _boot.totalUs() / 1000.f, _boot.startUs() / 1000.f, _boot.sleptUs() / 1000.f, _scanCached);
+  if (_firstFrameUs) {
+    Serial.printf("[BOOT] erster Frame %.1f ms, Ziel %u ms: %s\n", _firstFrameUs / 1000.f, BOOT_TTFF_TARGET_MS,
+                  _firstFrameUs <= BOOT_TTFF_TARGET_MS * 1000u ? "OK" : "VERFEHLT");
+  }
+}
 
+void App::printStallStats(){
+  const StallMonitor& m = _stall;
+  Serial.printf("[STALL] iter=%u mean=%uus p50=%uus p95=%uus p99=%uus max=%uus\n",
+                m.iterations(), m.iterMeanUs(), m.percentile(0.50f), m.percentile(0.95f),
+                m.percentile(0.99f), m.iterMaxUs());
+  Serial.printf("[STALL] budget=%uus stalls=%u\n", m.budgetUs(), m.stalls());
+  Serial.print("[STALL] hist(us)");
+  for (uint8_t b = 0; b < StallMonitor::BUCKETS; b++) {
+    if (!m.bin(b)) continue;
+    if (b < StallMonitor::BUCKETS - 1) Serial.printf(" <=%u:%u", StallMonitor::bucketUpper(b), m.bin(b));
+    else Serial.printf(" >%u:%u", StallMonitor::bucketUpper(b - 1), m.bin(b));   // Sättigung
+  }
+  Serial.println();
+  Serial.println("[STALL] site          calls   avg/us   max/us  stalls");
+  for (uint8_t i = 0; i < (uint8_t)BlockSite::Count; i++) {
+    const BlockSiteStats& s = m.siteStats((BlockSite)i);
+    Serial.printf("[STALL] %-10s %9u %8u %8u %7u\n", blockSiteName((BlockSite)i), s.calls,
+                  s.calls ? (uint32_t)(s.sumUs / s.calls) : 0u, s.maxUs, s.stalls);
+  }
+  Serial.println("[STALL] worst   iter/us  site        site/us  blocked/us    at/ms");
+  for (size_t i = 0; i < m.worstCount(); i++) {
+    const StallRecord& r = m.worst(i);
+    Serial.printf("[STALL] #%u %11u  %-10s %8u %11u %8u\n", (unsigned)i, r.iterUs,
+                  blockSiteName(r.site), r.siteUs, r.blockedUs, r.atMs);
+  }
 }
+
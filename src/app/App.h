@@ -7,7 +7,32 @@
 #include "../imu/QMI8658.h"
 #include "../comm/RS485Bus.h"
 #include "../comm/SerialConsole.h"
+#include "../comm/Modbus.h"
+#include "../comm/ModbusPoller.h"
+#include "../comm/Telemetry.h"
+#include "../comm/RS485LinkBench.h"
+#include "../comm/UsbStream.h"
+#include "../i2c/I2CEngine.h"
 #include "../core/types.h"
+#include "../core/Scheduler.h"
+#include "../core/BootSequencer.h"
+#include "../core/StallMonitor.h"
+#include "../core/Snapshot.h"
+#include "../core/Events.h"
+
+// Eingabe-Zustand, vom Eingabe-Task (Core 0) je Durchlauf veröffentlicht.
+// Einzelereignisse (Frames, Gesten, IMU-Proben) laufen über den Event-Bus.
+struct InputSnapshot {
+  TouchPoint   pts[MAX_TOUCH_POINTS];
+  uint8_t      activeCount = 0;
+  IMUData      imu {0,0,0,0,0,0};
+};
+
+struct InputTaskStats {
+  uint32_t steps = 0;
+  uint32_t busyUs = 0;                // Summe (umlaufend)
+  uint32_t busyMaxUs = 0;
+};
 
 class App {
 public:
@@ -15,10 +40,37 @@ public:
   void loop();
 
 private:
-  void scanI2C(TwoWire& w, const char* name);
+  bool scanBus(I2CEngine& bus, bool force = false);   // true = NVS-Karte bestätigt
   void updateMultiTouch();  // <- Diese Zeile hinzufügen
   void processReleaseGestures(TouchPoint pts[], uint8_t last_count, unsigned long now);
   void setGesture(GestureType type, uint16_t x, uint16_t y, float value, uint8_t fingers, unsigned long timestamp);
+  void updateModbusRegs();
+  void addJobs();
+  bool startInputTask();
+  static void inputTaskEntry(void* arg);
+  void inputStep();                   // Eingabe-Task bzw. Loop-Job
+  uint8_t touchStep(bool newFrame, unsigned long now, TouchPoint pts[MAX_TOUCH_POINTS]);   // Tracker -> Gesten
+  uint8_t replayStep(TouchPoint pts[MAX_TOUCH_POINTS]);                 // statt Touch: Aufnahme
+  void startReplay(const cmd::Args& a);
+  static void onReplayEvent(void* ctx, const GestureEvent& e);
+  void takeInput();                   // Loop: Deferred-Ereignisse + neuester Eingabe-Stand
+  void subscribeEvents();
+  void printBusStats();
+  void jobHud();
+  void jobComm();
+  void printSchedStats();
+  void printStallStats();
+  void printBootStats();
+  void printInputStats();
+  void registerCommands(cmd::Registry& r);
+  static App* masterOnly(void* ctx);          // nullptr + Hinweis, wenn nicht Master
+  void modbusRead(uint8_t fn, const cmd::Args& a);
+  void setRS485Mode(uint8_t mode, uint8_t slaveId = MODBUS_DEFAULT_SLAVE_ID);
+  static void onModbusWrite(uint16_t addr, uint16_t value, void* ctx);
+  static void onModbusResult(ModbusResult r, uint8_t exc, void* ctx);
+
+  I2CEngine      _i2c0{Wire};   // IMU
+  I2CEngine      _i2c1{Wire1};  // Touch
 
   DisplayManager _disp;
   CST328Touch    _touch;
@@ -29,8 +81,53 @@ private:
   RS485Bus       _rs485;      // <-- Member
   SerialConsole  _console;    // <-- Member
   bool           _echo485 = false;
+  bool           _rs485Sink = false;   // RX-Zeilen nur zählen (Durchsatzmessung)
+  uint32_t       _loadUs = 0;          // künstliche Loop-Last
+
+  // RS485-Betriebsart: Textzeilen (rs485send/echo), Modbus RTU, Telemetrie
+  // oder Streckentest
+  enum : uint8_t { RS485_TEXT = 0, RS485_MB_SLAVE, RS485_MB_MASTER, RS485_TELEMETRY, RS485_BENCH };
+  uint8_t        _rs485Mode = RS485_TEXT;
+  ModbusSlave    _mbSlave;
+  ModbusMaster   _mbMaster;
+  ModbusPoller   _mbPoll;
+  uint16_t       _mbReadBuf[16] = {0};
+  uint16_t       _mbReadCount = 0;
+  TelemetryLink  _telem;
+  RS485LinkBench _bench;
+  UsbStream      _stream;     // Messdaten über USB ("stream on")
+
+  Scheduler      _sched;      // ersetzt die millis()-Timer in loop()
+  int            _jobInput = -1;      // nur ohne INPUT_ON_OWN_CORE
+  StallMonitor   _stall;      // Loop-Jitter, blockierende Aufrufe ("stall")
+  BootSequencer  _boot;       // Boot-Zeitleiste ("boot")
+  enum : uint8_t { DISP_BOOT_IDLE = 0, DISP_BOOT_RUNNING, DISP_BOOT_OK, DISP_BOOT_FAILED };
+  volatile uint8_t _dispBoot = DISP_BOOT_IDLE;      // Display-Init im Task "dispboot"
+  uint8_t        _scanCached = 0;     // Busse, deren NVS-Adresskarte gepasst hat
+  uint32_t       _firstFrameUs = 0;   // erster HUD-Frame (micros)
+
+  // Eingabe-Seite (nur Eingabe-Task bzw. Loop-Job)
+  TripleBuffer<InputSnapshot> _input;
+  Seqlock<InputTaskStats>     _inputStats;
+  TaskHandle_t   _inputTask = nullptr;
+  uint32_t       _touchReqUs = 0;
+  uint32_t       _imuReqUs = 0;
+  IMUData        _inImu {0,0,0,0,0,0};
+
+  // Wiedergabe einer Touch-Aufnahme ("touchrec play"): die Konsole richtet
+  // sie ein, solange _replayOn false ist, danach gehört sie dem Eingabe-Task
+  TouchReplay    _replay;
+  volatile bool  _replayOn = false;
+  volatile bool  _replayStop = false;
+  float          _replaySpeed = 1.f;   // 0 = so schnell wie möglich
+  int64_t        _replayWall0 = 0;
+
+  // Loop-Seite: übernommener Stand
+  uint8_t        _activeCount = 0;
+
+  // Touch/Gesten/IMU/Comm-Ereignisse; Abonnenten in subscribeEvents()
+  EventBus       _bus;
 
-  unsigned long  _lastHUD   = 0;
   unsigned long  _lastFrame = 0;
   float          _fps       = 0.f;
 
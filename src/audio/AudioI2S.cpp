@@ -3,13 +3,68 @@
 // ----------------------------------------------------------------------------
 #include "AudioI2S.h"
 #include <driver/i2s.h>
-#include <math.h>
+#include <LittleFS.h>
+#include "../core/LatencyTrace.h"
+#include "../core/Placement.h"
+#include "../core/Profiler.h"
 
 static i2s_port_t I2S_PORT = I2S_NUM_0;
 static uint32_t SR = 22050;
 
+// ---------------------------- Cue-Tabellen ----------------------------------
+// Ein Cue = Folge von Tönen; hz=0 ist eine Pause. Beim Start wird jeder Ton
+// eine eigene Stimme mit Startverzögerung – Cues laufen so parallel.
+struct ToneStep { uint16_t hz; uint16_t ms; };
+
+static const ToneStep CUE_TAP[]        = {{1200, 60}};
+static const ToneStep CUE_DOUBLE_TAP[] = {{1200, 60}, {0, 40}, {1200, 60}};
+static const ToneStep CUE_LONG_PRESS[] = {{600, 200}};
+static const ToneStep CUE_SWIPE_H[]    = {{900, 80}};
+static const ToneStep CUE_SWIPE_V[]    = {{700, 80}};
+static const ToneStep CUE_PINCH_IN[]   = {{500, 80}, {0, 40}, {400, 100}};
+static const ToneStep CUE_PINCH_OUT[]  = {{400, 80}, {0, 40}, {500, 100}};
+static const ToneStep CUE_ROT_CW[]     = {{1000, 70}, {0, 30}, {1200, 70}};
+static const ToneStep CUE_ROT_CCW[]    = {{1200, 70}, {0, 30}, {1000, 70}};
+static const ToneStep CUE_TWO_TAP[]    = {{1000, 60}, {0, 20}, {1000, 60}};
+static const ToneStep CUE_THREE_TAP[]  = {{800, 120}};
+
+#define CUE(a) steps = a; n = (uint8_t)(sizeof(a) / sizeof(a[0]))
+
+static const ToneStep* cueFor(GestureType g, uint8_t& n){
+  const ToneStep* steps = nullptr; n = 0;
+  switch (g){
+    case GestureType::Tap:            CUE(CUE_TAP); break;
+    case GestureType::DoubleTap:      CUE(CUE_DOUBLE_TAP); break;
+    case GestureType::LongPress:      CUE(CUE_LONG_PRESS); break;
+    case GestureType::SwipeLeft:
+    case GestureType::SwipeRight:     CUE(CUE_SWIPE_H); break;
+    case GestureType::SwipeUp:
+    case GestureType::SwipeDown:      CUE(CUE_SWIPE_V); break;
+    case GestureType::PinchIn:        CUE(CUE_PINCH_IN); break;
+    case GestureType::PinchOut:       CUE(CUE_PINCH_OUT); break;
+    case GestureType::RotateCW:       CUE(CUE_ROT_CW); break;
+    case GestureType::RotateCCW:      CUE(CUE_ROT_CCW); break;
+    case GestureType::TwoFingerTap:   CUE(CUE_TWO_TAP); break;
+    case GestureType::ThreeFingerTap: CUE(CUE_THREE_TAP); break;
+    default: break;
+  }
+  return steps;
+}
+
+#undef CUE
+
+// Dateinamen der optionalen Clips, Index = GestureType
+static const char* const CLIP_NAMES[] = {
+  nullptr, "tap", "doubletap", "longpress",
+  "swipeleft", "swiperight", "swipeup", "swipedown",
+  "pinchin", "pinchout", "rotatecw", "rotateccw",
+  "twofingertap", "threefingertap"
+};
+
+// ---------------------------- Init ------------------------------------------
 bool AudioI2S::begin(uint32_t rate){
   SR = rate;
+  dds::initTables();
   i2s_config_t cfg = {
     .mode = (i2s_mode_t)(I2S_MODE_MASTER | I2S_MODE_TX),
     .sample_rate = (int)SR,
@@ -18,7 +73,7 @@ bool AudioI2S::begin(uint32_t rate){
     .communication_format = I2S_COMM_FORMAT_STAND_I2S,
     .intr_alloc_flags = ESP_INTR_FLAG_LEVEL1,
     .dma_buf_count = 4,
-    .dma_buf_len = 256,
+    .dma_buf_len = AUDIO_BLOCK_SAMPLES,
     .use_apll = false,
     .tx_desc_auto_clear = true,
     .fixed_mclk = 0
@@ -30,58 +85,294 @@ bool AudioI2S::begin(uint32_t rate){
     .data_out_num = PIN_I2S_DIN,
     .data_in_num = I2S_PIN_NO_CHANGE
   };
-  if (i2s_driver_install(I2S_PORT, &cfg, 0, nullptr) != ESP_OK) return false;
+  if (i2s_driver_install(I2S_PORT, &cfg, 8, &_evtQueue) != ESP_OK) return false;
   if (i2s_set_pin(I2S_PORT, &pins) != ESP_OK) return false;
   i2s_zero_dma_buffer(I2S_PORT);
-  return true;
+  loadClips();
+
+  _cmdQueue = xQueueCreate(AUDIO_QUEUE_DEPTH, sizeof(AudioCmd));
+  if (!_cmdQueue) return false;
+  return xTaskCreatePinnedToCore(taskEntry, "audio", 4096, this, AUDIO_TASK_PRIORITY,
+                                 &_task, AUDIO_TASK_CORE) == pdPASS;
+}
+
+// ---------------------------- Loop-Seite ------------------------------------
+void AudioI2S::playGesture(const GestureType g){
+  GestureEvent ev;
+  ev.type = g;
+  playGesture(ev);
+}
+
+void AudioI2S::playGesture(const GestureEvent& g){
+  uint32_t t0 = micros();
+  if (g.type == GestureType::None || !_cmdQueue) return;
+
+  AudioCmd cmd{g.type, g.origin_us, g.event_us};
+  if (xQueueSend(_cmdQueue, &cmd, 0) == pdTRUE) {
+    _stats.cues++;
+    uint16_t depth = (uint16_t)uxQueueMessagesWaiting(_cmdQueue);
+    if (depth > _stats.queueHigh) _stats.queueHigh = depth;
+  } else {
+    _stats.dropped++;
+  }
+
+  _stats.enqueueLastUs = micros() - t0;
+  if (_stats.enqueueLastUs > _stats.enqueueMaxUs) _stats.enqueueMaxUs = _stats.enqueueLastUs;
+}
+
+void AudioI2S::printStats(Print& out) const {
+  out.printf("[AUDIO] cues=%u dropped=%u steals=%u underruns=%u blocks=%u\n",
+             _stats.cues, _stats.dropped, _stats.voiceSteals, _stats.underruns, _stats.blocks);
+  out.printf("[AUDIO] clips=%u clipErrors=%u\n", _stats.clips, _stats.clipErrors);
+  out.printf("[AUDIO] queue=%u/%u (high=%u) voices=%u/%u (high=%u)\n",
+             _cmdQueue ? (unsigned)uxQueueMessagesWaiting(_cmdQueue) : 0u, AUDIO_QUEUE_DEPTH,
+             _stats.queueHigh, activeVoices(), AUDIO_MAX_VOICES + AUDIO_MAX_CLIP_VOICES, _stats.voicesHigh);
+  out.printf("[AUDIO] playGesture blocks loop: last=%uus max=%uus\n",
+             _stats.enqueueLastUs, _stats.enqueueMaxUs);
 }
 
-void AudioI2S::toneHz(float hz, uint16_t ms, float amp){
-  if (hz <= 0) { delay(ms); return; }
-  const int N = (int)((SR * ms) / 1000);
-  const float twoPiOverSR = 2.0f * (float)M_PI / (float)SR;
-  const int BUF = 256;
-  int16_t buf[BUF];
-  float phase = 0.f;
-
-  // kurze, nicht-blockierende Writes (Timeout 10ms). Droppt zur Not Samples.
-  for (int i=0; i<N; ){
-    int chunk = min(BUF, N - i);
-    for (int j=0; j<chunk; j++, i++){
-      float s = sinf(phase) * amp;
-      buf[j] = (int16_t)(s * 32767);
-      phase += twoPiOverSR * hz;
-      if (phase > 2*M_PI) phase -= 2*M_PI;
+// ---------------------------- Audio-Task ------------------------------------
+void AudioI2S::taskEntry(void* arg){
+  static_cast<AudioI2S*>(arg)->taskLoop();
+}
+
+void AudioI2S::taskLoop(){
+  int16_t buf[AUDIO_BLOCK_SAMPLES];
+  AudioCmd cmd;
+
+  for (;;) {
+    // Ruhezustand: auf den nächsten Befehl schlafen (DMA spielt Nullen)
+    if (activeVoices() == 0) {
+      if (xQueueReceive(_cmdQueue, &cmd, portMAX_DELAY) == pdTRUE) startCue(cmd);
+      drainEvents(false);
     }
+    while (xQueueReceive(_cmdQueue, &cmd, 0) == pdTRUE) startCue(cmd);
+
+    renderBlock(buf, AUDIO_BLOCK_SAMPLES);
     size_t written = 0;
-    // 10 ms Timeout statt portMAX_DELAY
-    i2s_write(I2S_PORT, (const char*)buf, chunk*sizeof(int16_t),
-              &written, 10 / portTICK_PERIOD_MS);
-    // wenn Puffer voll: written kann < chunk sein -> rest wird im nächsten Zyklus erzeugt
+    // Der Task besitzt den DMA: hier darf blockiert werden, der Loop merkt nichts
+    i2s_write(I2S_PORT, (const char*)buf, sizeof(buf), &written, portMAX_DELAY);
+    _stats.blocks++;
+    drainEvents(true);
+
+    // Erstes Sample jedes neuen Cues steckt in diesem Block -> an I2S übergeben
+    uint32_t now = micros();
+    for (uint8_t i = 0; i < _traceCount; i++) {
+      const AudioCmd& c = _traceCues[i];
+      if (c.eventUs)  latency::record(LatStage::GestureToAudio, now - c.eventUs);
+      if (c.originUs) latency::record(LatStage::IrqToAudio, now - c.originUs);
+    }
+    _traceCount = 0;
   }
 }
 
-void AudioI2S::playGesture(const GestureType g){
-  unsigned long now = millis();
-  if (now < _gateUntil) return;     // simple flood-guard
+// TX_Q_OVF: alle DMA-Puffer wurden ausgespielt, ohne dass neue kamen
+void AudioI2S::drainEvents(bool playing){
+  if (!_evtQueue) return;
+  i2s_event_t ev;
+  while (xQueueReceive(_evtQueue, &ev, 0) == pdTRUE) {
+    if (playing && ev.type == I2S_EVENT_TX_Q_OVF) _stats.underruns++;
+  }
+}
 
-  switch (g){
-    case GestureType::Tap:          toneHz(1200, 60); break;
-    case GestureType::DoubleTap:    toneHz(1200, 60); toneHz(0, 40); toneHz(1200, 60); break;
-    case GestureType::LongPress:    toneHz(600, 200); break;
-    case GestureType::SwipeLeft:
-    case GestureType::SwipeRight:   toneHz(900, 80); break;
-    case GestureType::SwipeUp:
-    case GestureType::SwipeDown:    toneHz(700, 80); break;
-    case GestureType::PinchIn:      toneHz(500, 80); toneHz(0, 40); toneHz(400, 100); break;
-    case GestureType::PinchOut:     toneHz(400, 80); toneHz(0, 40); toneHz(500, 100); break;
-    case GestureType::RotateCW:     toneHz(1000, 70); toneHz(0, 30); toneHz(1200, 70); break;
-    case GestureType::RotateCCW:    toneHz(1200, 70); toneHz(0, 30); toneHz(1000, 70); break;
-    case GestureType::TwoFingerTap: toneHz(1000, 60); toneHz(0, 20); toneHz(1000, 60); break;
-    case GestureType::ThreeFingerTap:toneHz(800, 120); break;
-    default: break;
+void AudioI2S::startCue(const AudioCmd& cmd){
+  if (_traceCount < AUDIO_QUEUE_DEPTH) _traceCues[_traceCount++] = cmd;
+
+  const GestureType g = cmd.type;
+  if ((size_t)g < CLIP_SLOTS && _clips[(size_t)g].file && startClip((uint8_t)g)) return;
+
+  uint8_t n = 0;
+  const ToneStep* steps = cueFor(g, n);
+  uint32_t offset = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    uint32_t len = (SR * steps[i].ms) / 1000;
+    if (steps[i].hz > 0) {
+      Voice* v = allocVoice();
+      v->active   = true;
+      v->delay    = offset;
+      v->pos      = 0;
+      v->length   = len;
+      v->osc.phase = 0;
+      v->osc.inc   = dds::phaseIncrement(steps[i].hz, SR);
+      v->osc.wave  = Waveform::Sine;
+      v->amp       = (int32_t)(AUDIO_VOICE_AMP * 32767.f);
+      v->age      = _voiceSeq++;
+    }
+    offset += len;
   }
+  uint8_t av = activeVoices();
+  if (av > _stats.voicesHigh) _stats.voicesHigh = av;
+}
 
-  // nächstes Signal frühestens in ~150ms (verhindert Ton-Staus im Loop)
-  _gateUntil = now + 150;
-}
\ No newline at end of file
+AudioI2S::Voice* AudioI2S::allocVoice(){
+  Voice* oldest = &_voices[0];
+  for (auto& v : _voices) {
+    if (!v.active) return &v;
+    if (v.age < oldest->age) oldest = &v;
+  }
+  _stats.voiceSteals++;
+  return oldest;
+}
+
+uint8_t AudioI2S::activeVoices() const {
+  uint8_t n = 0;
+  for (const auto& v : _voices) if (v.active) n++;
+  for (const auto& v : _clipVoices) if (v.active) n++;
+  return n;
+}
+
+// Summe aller Stimmen in int32, danach auf int16 geklemmt
+void HOT_FN AudioI2S::renderBlock(int16_t* out, size_t n){
+  PROF_ZONE(ProfZone::Audio);
+  static int32_t mix[AUDIO_BLOCK_SAMPLES];
+  memset(mix, 0, n * sizeof(int32_t));
+
+  for (auto& v : _voices) {
+    if (v.active) renderVoice(v, mix, n);
+  }
+  for (auto& v : _clipVoices) {
+    if (v.active) renderClip(v, mix, n);
+  }
+
+  for (size_t j = 0; j < n; j++) {
+    int32_t s = mix[j];
+    if (s > 32767) s = 32767;
+    if (s < -32768) s = -32768;
+    out[j] = (int16_t)s;
+  }
+}
+
+// Hüllkurve stückweise linear (Attack / Sustain / Release): pro Segment ein
+// DDS-Aufruf mit Verstärkungsrampe statt Hüllkurve pro Sample
+void HOT_FN AudioI2S::renderVoice(Voice& v, int32_t* mix, size_t n){
+  size_t j = 0;
+  if (v.delay) {
+    uint32_t skip = min<uint32_t>(v.delay, n);
+    v.delay -= skip;
+    j += skip;
+  }
+
+  const uint32_t release    = (SR * AUDIO_RELEASE_MS) / 1000;
+  const uint32_t relStart   = v.length > release ? v.length - release : 0;
+  const uint32_t attackEnd  = min<uint32_t>((SR * AUDIO_ATTACK_MS) / 1000, relStart);
+  const int32_t  amp16      = v.amp << 16;
+
+  while (j < n && v.pos < v.length) {
+    uint32_t segEnd;
+    int32_t  gain, step;
+    if (v.pos < attackEnd) {
+      segEnd = attackEnd;
+      step   = amp16 / (int32_t)attackEnd;
+      gain   = step * (int32_t)v.pos;
+    } else if (v.pos < relStart) {
+      segEnd = relStart;
+      gain   = amp16;
+      step   = 0;
+    } else {
+      segEnd = v.length;
+      uint32_t left = v.length - v.pos;
+      gain   = (int32_t)(((int64_t)amp16 * left) / (v.length - relStart));
+      step   = -(gain / (int32_t)left);
+    }
+    size_t cnt = min<size_t>(n - j, segEnd - v.pos);
+    dds::renderAdd(v.osc, mix + j, cnt, gain, step);
+    j     += cnt;
+    v.pos += cnt;
+  }
+
+  if (v.pos >= v.length) v.active = false;
+}
+
+// ---------------------------- ADPCM-Clips -----------------------------------
+// Clips werden beim Start einmal geöffnet und bleiben offen: Abspielen
+// braucht dann nur noch seek/read, keine Allokation im Audio-Task.
+void AudioI2S::loadClips(){
+  if (!LittleFS.begin(false)) {
+    Serial.println("[AUDIO] LittleFS nicht gemountet - nur Töne");
+    return;
+  }
+  char path[40];
+  uint8_t hdr[IMA_HEADER_BYTES];
+  for (size_t i = 1; i < CLIP_SLOTS; i++) {
+    snprintf(path, sizeof(path), "%s/%s.ima", AUDIO_SFX_DIR, CLIP_NAMES[i]);
+    if (!LittleFS.exists(path)) continue;
+
+    File f = LittleFS.open(path, "r");
+    Clip& c = _clips[i];
+    if (!f || f.read(hdr, sizeof(hdr)) != sizeof(hdr) || !ima::parseHeader(hdr, c.hdr)) {
+      Serial.printf("[AUDIO] %s: kein gültiger IMA-Header\n", path);
+      continue;
+    }
+    if (c.hdr.sampleRate != SR || c.hdr.blockBytes > AUDIO_CLIP_BLOCK_BYTES) {
+      Serial.printf("[AUDIO] %s: %u Hz / Block %u B nicht unterstützt\n",
+                    path, c.hdr.sampleRate, c.hdr.blockBytes);
+      continue;
+    }
+    c.file = f;
+    Serial.printf("[AUDIO] Clip %s: %u Samples, %u B Flash (PCM %u B)\n",
+                  path, c.hdr.numSamples, (unsigned)f.size(), c.hdr.numSamples * 2);
+  }
+}
+
+bool AudioI2S::startClip(uint8_t idx){
+  ClipVoice* v = nullptr;
+  for (auto& cv : _clipVoices) if (!cv.active) { v = &cv; break; }
+  if (!v) { _stats.voiceSteals++; v = &_clipVoices[0]; }
+
+  const Clip& c = _clips[idx];
+  v->active     = true;
+  v->clip       = idx;
+  v->fileOffset = IMA_HEADER_BYTES;
+  v->remaining  = c.hdr.numSamples;
+  v->bytePos    = c.hdr.blockBytes;     // erzwingt Laden des ersten Blocks
+  v->hiNibble   = false;
+  _stats.clips++;
+  uint8_t av = activeVoices();
+  if (av > _stats.voicesHigh) _stats.voicesHigh = av;
+  return true;
+}
+
+bool AudioI2S::loadBlock(ClipVoice& v, Clip& c){
+  if (!c.file.seek(v.fileOffset) ||
+      c.file.read(v.block, c.hdr.blockBytes) != c.hdr.blockBytes) {
+    _stats.clipErrors++;
+    return false;
+  }
+  v.fileOffset += c.hdr.blockBytes;
+  return true;
+}
+
+// Dekodiert direkt in den Mix-Bus, ohne PCM-Zwischenpuffer
+void HOT_FN AudioI2S::renderClip(ClipVoice& v, int32_t* mix, size_t n){
+  Clip& c = _clips[v.clip];
+  const int32_t gain = (int32_t)(AUDIO_CLIP_GAIN * 32767.f);
+
+  for (size_t j = 0; j < n && v.remaining; j++) {
+    int16_t s;
+    if (v.bytePos >= c.hdr.blockBytes) {
+      if (!loadBlock(v, c)) { v.active = false; return; }
+      s = ima::beginBlock(v.block, v.st);
+      v.bytePos  = IMA_BLOCK_HEADER;
+      v.hiNibble = false;
+    } else if (!v.hiNibble) {
+      s = ima::decodeNibble(v.block[v.bytePos] & 0x0F, v.st);
+      v.hiNibble = true;
+    } else {
+      s = ima::decodeNibble(v.block[v.bytePos] >> 4, v.st);
+      v.hiNibble = false;
+      v.bytePos++;
+    }
+    mix[j] += ((int32_t)s * gain) >> 15;
+    v.remaining--;
+  }
+  if (!v.remaining) v.active = false;
+}
+
+// ---------------------------- Konsole ---------------------------------------
+static constexpr cmd::Command AUDIO_CMDS[] = {
+  {"audio stats", "", "", [](void* c, const cmd::Args&){ static_cast<AudioI2S*>(c)->printStats(Serial); }},
+};
+
+void AudioI2S::registerCommands(cmd::Registry& r){
+  r.add(AUDIO_CMDS, this, "audio");
+}
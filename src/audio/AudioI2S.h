@@ -1,17 +1,109 @@
 // ============================================================================
 // File: src/audio/AudioI2S.h
 // ----------------------------------------------------------------------------
+// Purpose: I2S-Audio mit eigenem Task (besitzt den DMA) und Polyphonie-Mixer
+//  • playGesture() reiht nur einen Befehl ein (kein Blockieren des Loops)
+//  • Der Audio-Task mischt mehrere Stimmen mit Hüllkurve in jeden DMA-Block,
+//    überlappende Cues werden gemischt statt verworfen
+//  • Liegt /sfx/<geste>.ima im LittleFS, wird statt des Tons der
+//    IMA-ADPCM-Clip blockweise aus dem Flash gestreamt
+// ============================================================================
 #pragma once
 #include <Arduino.h>
+#include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 #include "../config/pins.h"
+#include "../config/params.h"
 #include "../core/types.h"
+#include "Dds.h"
+#include "ImaAdpcm.h"
+#include "../comm/CommandTable.h"
+
+struct AudioStats {
+  uint32_t cues = 0;          // eingereihte Cues
+  uint32_t dropped = 0;       // Queue voll
+  uint32_t voiceSteals = 0;   // keine freie Stimme -> älteste ersetzt
+  uint32_t underruns = 0;     // DMA lief leer, während Stimmen aktiv waren
+  uint32_t blocks = 0;        // geschriebene DMA-Blöcke
+  uint16_t queueHigh = 0;
+  uint8_t  voicesHigh = 0;
+  uint32_t clips = 0;         // gestartete ADPCM-Clips
+  uint32_t clipErrors = 0;    // Lesefehler beim Streamen
+  uint32_t enqueueMaxUs = 0;  // längste Blockade des Aufrufers in playGesture()
+  uint32_t enqueueLastUs = 0;
+};
 
 class AudioI2S {
 public:
 
   bool begin(uint32_t sampleRate = 22050);
   void playGesture(const GestureType g);
+  void playGesture(const GestureEvent& g);   // mit Latenz-Trace (origin_us/event_us)
+
+  const AudioStats& stats() const { return _stats; }
+  void resetStats() { _stats = AudioStats{}; }
+  void printStats(Print& out) const;
+  void registerCommands(cmd::Registry& r);   // audio stats
+
 private:
-  void toneHz(float hz, uint16_t ms, float amp=0.2f);
-  unsigned long _gateUntil = 0;   // einfache Rate-Limitierung
-};
\ No newline at end of file
+  struct AudioCmd {
+    GestureType type;
+    uint32_t    originUs;
+    uint32_t    eventUs;
+  };
+
+  struct Voice {
+    bool     active = false;
+    uint32_t delay = 0;       // Samples bis Start (Pausen innerhalb eines Cues)
+    uint32_t pos = 0;         // Samples seit Start
+    uint32_t length = 0;      // Gesamtlänge in Samples
+    DdsOsc   osc;
+    int32_t  amp = 0;         // Q15
+    uint32_t age = 0;         // für Voice-Stealing
+  };
+
+  // Pro Clip-Stimme nur ein Block + Decoderzustand (~270 Byte)
+  struct ClipVoice {
+    bool     active = false;
+    uint8_t  clip = 0;        // Index in _clips (= GestureType)
+    uint32_t fileOffset = 0;  // nächster Block in der Datei
+    uint32_t remaining = 0;   // Samples bis Clip-Ende
+    uint16_t bytePos = 0;     // Lesezeiger im Block
+    bool     hiNibble = false;
+    ImaState st;
+    uint8_t  block[AUDIO_CLIP_BLOCK_BYTES];
+  };
+
+  struct Clip {
+    File      file;
+    ImaHeader hdr;
+  };
+
+  static constexpr size_t CLIP_SLOTS = (size_t)GestureType::ThreeFingerTap + 1;
+
+  static void taskEntry(void* arg);
+  void taskLoop();
+  void startCue(const AudioCmd& cmd);
+  Voice* allocVoice();
+  void renderBlock(int16_t* out, size_t n);
+  void renderVoice(Voice& v, int32_t* mix, size_t n);
+  void loadClips();
+  bool startClip(uint8_t idx);
+  bool loadBlock(ClipVoice& v, Clip& c);
+  void renderClip(ClipVoice& v, int32_t* mix, size_t n);
+  uint8_t activeVoices() const;
+  void drainEvents(bool playing);
+
+  QueueHandle_t _cmdQueue = nullptr;
+  QueueHandle_t _evtQueue = nullptr;   // I2S-Treiber-Events (Underrun)
+  TaskHandle_t  _task = nullptr;
+  Voice         _voices[AUDIO_MAX_VOICES];
+  ClipVoice     _clipVoices[AUDIO_MAX_CLIP_VOICES];
+  Clip          _clips[CLIP_SLOTS];
+  uint32_t      _voiceSeq = 0;
+  AudioCmd      _traceCues[AUDIO_QUEUE_DEPTH];   // seit letztem i2s_write gestartet
+  uint8_t       _traceCount = 0;
+  AudioStats    _stats;
+};
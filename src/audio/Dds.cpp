@@ -0,0 +1,85 @@
+// ============================================================================
+// File: src/audio/Dds.cpp
+// ----------------------------------------------------------------------------
+#include "Dds.h"
+#include "../core/Placement.h"
+#include <math.h>
+
+namespace dds {
+
+// +1 Guard-Eintrag, damit die Interpolation ohne Maskierung auskommt
+static int16_t s_sine[SINE_SIZE + 1];
+
+void initTables(){
+  for (uint16_t i = 0; i <= SINE_SIZE; i++) {
+    s_sine[i] = (int16_t)lrintf(32767.0f * sinf(2.0f * (float)M_PI * (float)i / (float)SINE_SIZE));
+  }
+}
+
+uint32_t phaseIncrement(float hz, uint32_t sampleRate){
+  if (hz <= 0.f || sampleRate == 0) return 0;
+  return (uint32_t)((double)hz * 4294967296.0 / (double)sampleRate);
+}
+
+// Obere SINE_BITS = Tabellenindex, nächste 16 Bit = Interpolationsanteil
+static inline int32_t sineAt(uint32_t phase){
+  const uint32_t idx  = phase >> (32 - SINE_BITS);
+  const int32_t  frac = (int32_t)((phase >> (16 - SINE_BITS)) & 0xFFFF);
+  const int32_t  a = s_sine[idx];
+  const int32_t  b = s_sine[idx + 1];
+  return a + (((b - a) * frac) >> 16);
+}
+
+static inline int32_t squareAt(uint32_t phase){
+  return (phase & 0x80000000u) ? -32767 : 32767;
+}
+
+// 0..π steigt -32767..32767, π..2π fällt zurück
+static inline int32_t triangleAt(uint32_t phase){
+  int32_t t = (int32_t)(phase >> 16);              // 0..65535
+  int32_t v = (t < 32768) ? (t * 2) : ((65535 - t) * 2);
+  return v - 32767;
+}
+
+int16_t HOT_FN sample(const DdsOsc& o){
+  switch (o.wave) {
+    case Waveform::Square:   return (int16_t)squareAt(o.phase);
+    case Waveform::Triangle: return (int16_t)triangleAt(o.phase);
+    default:                 return (int16_t)sineAt(o.phase);
+  }
+}
+
+// Eigene Schleife je Wellenform: kein switch im inneren Loop
+#define DDS_RENDER_ADD(fn)                                         \
+  for (size_t i = 0; i < n; i++) {                                 \
+    acc[i] += (fn(phase) * (gain >> 16)) >> 15;                    \
+    phase += inc;                                                  \
+    gain  += gainStep;                                             \
+  }
+
+void HOT_FN renderAdd(DdsOsc& o, int32_t* acc, size_t n, int32_t gain, int32_t gainStep){
+  uint32_t phase = o.phase;
+  const uint32_t inc = o.inc;
+  switch (o.wave) {
+    case Waveform::Square:   DDS_RENDER_ADD(squareAt);   break;
+    case Waveform::Triangle: DDS_RENDER_ADD(triangleAt); break;
+    default:                 DDS_RENDER_ADD(sineAt);     break;
+  }
+  o.phase = phase;
+}
+
+#undef DDS_RENDER_ADD
+
+void render(DdsOsc& o, int16_t* out, size_t n, int16_t gainQ15){
+  int32_t acc[64];
+  while (n) {
+    size_t chunk = n < 64 ? n : 64;
+    for (size_t i = 0; i < chunk; i++) acc[i] = 0;
+    renderAdd(o, acc, chunk, (int32_t)gainQ15 << 16, 0);
+    for (size_t i = 0; i < chunk; i++) out[i] = (int16_t)acc[i];
+    out += chunk;
+    n   -= chunk;
+  }
+}
+
+}  // namespace dds
@@ -0,0 +1,47 @@
+// ============================================================================
+// File: src/audio/Dds.h
+// ----------------------------------------------------------------------------
+// Purpose: DDS-Oszillator (32-bit Phasenakku, interpolierte Sinus-Wavetable)
+//  • Ganzzahl-Kernel, rendert einen ganzen DMA-Block pro Aufruf
+//  • Sinus / Rechteck / Dreieck
+//  • Plattformneutral (kein Arduino.h) – läuft auch im Host-Benchmark
+//    (tools/dds_bench.cpp)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+enum class Waveform : uint8_t {
+  Sine = 0,
+  Square,
+  Triangle
+};
+
+struct DdsOsc {
+  uint32_t phase = 0;          // 0..2^32 = 0..2π
+  uint32_t inc   = 0;          // Phasenschritt pro Sample
+  Waveform wave  = Waveform::Sine;
+};
+
+namespace dds {
+
+static constexpr uint8_t  SINE_BITS  = 10;                 // 1024 Stützstellen (2 KB)
+static constexpr uint16_t SINE_SIZE  = 1u << SINE_BITS;
+
+// Sinustabelle einmalig füllen (vor dem ersten render*)
+void initTables();
+
+// hz * 2^32 / sampleRate
+uint32_t phaseIncrement(float hz, uint32_t sampleRate);
+
+// Ein Sample (int16, Vollaussteuerung) an der aktuellen Phase
+int16_t sample(const DdsOsc& o);
+
+// n Samples mit linearer Verstärkungsrampe auf acc addieren.
+// gain/gainStep im Format 16.16 (gain 32767<<16 = Vollaussteuerung).
+void renderAdd(DdsOsc& o, int32_t* acc, size_t n, int32_t gain, int32_t gainStep);
+
+// n Samples mit fester Verstärkung (Q15) nach out schreiben
+void render(DdsOsc& o, int16_t* out, size_t n, int16_t gainQ15);
+
+}  // namespace dds
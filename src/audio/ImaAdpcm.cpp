@@ -0,0 +1,116 @@
+// ============================================================================
+// File: src/audio/ImaAdpcm.cpp
+// ----------------------------------------------------------------------------
+#include "ImaAdpcm.h"
+#include "../core/Placement.h"
+
+namespace ima {
+
+static const int16_t HOT_DATA STEP_TABLE[89] = {
+      7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+     19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+     50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+    876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+   2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+   5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+  15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t HOT_DATA INDEX_TABLE[16] = {
+  -1, -1, -1, -1, 2, 4, 6, 8,
+  -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static inline int32_t clamp16(int32_t v){
+  return v > 32767 ? 32767 : (v < -32768 ? -32768 : v);
+}
+
+static inline int8_t clampIndex(int32_t i){
+  return (int8_t)(i < 0 ? 0 : (i > 88 ? 88 : i));
+}
+
+static inline uint16_t rd16(const uint8_t* p){ return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t rd32(const uint8_t* p){ return (uint32_t)rd16(p) | ((uint32_t)rd16(p + 2) << 16); }
+static inline void wr16(uint8_t* p, uint16_t v){ p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static inline void wr32(uint8_t* p, uint32_t v){ wr16(p, (uint16_t)v); wr16(p + 2, (uint16_t)(v >> 16)); }
+
+// Header: magic, sampleRate, numSamples, blockBytes, samplesPerBlock (alles LE)
+bool parseHeader(const uint8_t* in, ImaHeader& h){
+  if (rd32(in) != IMA_MAGIC) return false;
+  h.sampleRate      = rd32(in + 4);
+  h.numSamples      = rd32(in + 8);
+  h.blockBytes      = rd16(in + 12);
+  h.samplesPerBlock = rd16(in + 14);
+  return h.blockBytes > IMA_BLOCK_HEADER && h.samplesPerBlock == samplesPerBlock(h.blockBytes);
+}
+
+void writeHeader(const ImaHeader& h, uint8_t* out){
+  wr32(out, IMA_MAGIC);
+  wr32(out + 4, h.sampleRate);
+  wr32(out + 8, h.numSamples);
+  wr16(out + 12, h.blockBytes);
+  wr16(out + 14, h.samplesPerBlock);
+}
+
+int16_t HOT_FN beginBlock(const uint8_t* block, ImaState& st){
+  st.predictor = (int16_t)rd16(block);
+  st.index     = clampIndex(block[2]);
+  return (int16_t)st.predictor;
+}
+
+int16_t HOT_FN decodeNibble(uint8_t nibble, ImaState& st){
+  const int32_t step = STEP_TABLE[st.index];
+  int32_t diff = step >> 3;
+  if (nibble & 1) diff += step >> 2;
+  if (nibble & 2) diff += step >> 1;
+  if (nibble & 4) diff += step;
+  if (nibble & 8) diff = -diff;
+  st.predictor = clamp16(st.predictor + diff);
+  st.index     = clampIndex(st.index + INDEX_TABLE[nibble & 0x0F]);
+  return (int16_t)st.predictor;
+}
+
+size_t decodeBlock(const uint8_t* block, size_t blockBytes, int16_t* out, size_t maxSamples){
+  if (maxSamples == 0 || blockBytes <= IMA_BLOCK_HEADER) return 0;
+  ImaState st;
+  size_t n = 0;
+  out[n++] = beginBlock(block, st);
+  for (size_t i = IMA_BLOCK_HEADER; i < blockBytes && n < maxSamples; i++) {
+    out[n++] = decodeNibble(block[i] & 0x0F, st);
+    if (n < maxSamples) out[n++] = decodeNibble(block[i] >> 4, st);
+  }
+  return n;
+}
+
+static uint8_t encodeSample(int32_t sample, ImaState& st){
+  const int32_t step = STEP_TABLE[st.index];
+  int32_t diff = sample - st.predictor;
+  uint8_t code = 0;
+  if (diff < 0) { code = 8; diff = -diff; }
+  if (diff >= step)        { code |= 4; diff -= step; }
+  if (diff >= (step >> 1)) { code |= 2; diff -= step >> 1; }
+  if (diff >= (step >> 2)) { code |= 1; }
+  decodeNibble(code, st);       // Encoder verfolgt exakt den Decoder-Zustand
+  return code;
+}
+
+void encodeBlock(const int16_t* pcm, size_t n, ImaState& st, uint8_t* block, size_t blockBytes){
+  const size_t spb = samplesPerBlock((uint16_t)blockBytes);
+  st.predictor = n ? pcm[0] : 0;
+  wr16(block, (uint16_t)(int16_t)st.predictor);
+  block[2] = (uint8_t)st.index;
+  block[3] = 0;
+
+  size_t s = 1;
+  for (size_t i = IMA_BLOCK_HEADER; i < blockBytes; i++) {
+    int32_t lo = (s < n && s < spb) ? pcm[s] : 0; s++;
+    int32_t hi = (s < n && s < spb) ? pcm[s] : 0; s++;
+    uint8_t cl = encodeSample(lo, st);
+    uint8_t ch = encodeSample(hi, st);
+    block[i] = (uint8_t)(cl | (ch << 4));
+  }
+}
+
+}  // namespace ima
@@ -0,0 +1,54 @@
+// ============================================================================
+// File: src/audio/ImaAdpcm.h
+// ----------------------------------------------------------------------------
+// Purpose: IMA-ADPCM (4 bit/Sample) Codec für komprimierte UI-Sounds
+//  • Container ".ima": 16-Byte-Header + Blöcke fester Größe
+//  • Block = [int16 Prädiktor][uint8 Index][0] + Nibbles (Low-Nibble zuerst),
+//    wie WAV/IMA: der Prädiktor ist das erste Sample des Blocks
+//  • Decoder arbeitet Sample für Sample (Zustand: 4 Byte) – der Aufrufer
+//    hält nur den aktuellen Block im RAM
+//  • Plattformneutral: Encoder/Benchmark auf dem Host (tools/adpcm_tool.cpp)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+static constexpr uint32_t IMA_MAGIC        = 0x31414D49;  // "IMA1" (LE)
+static constexpr size_t   IMA_HEADER_BYTES = 16;
+static constexpr size_t   IMA_BLOCK_HEADER = 4;
+
+struct ImaHeader {
+  uint32_t sampleRate = 0;
+  uint32_t numSamples = 0;
+  uint16_t blockBytes = 0;
+  uint16_t samplesPerBlock = 0;   // = 1 + (blockBytes - 4) * 2
+};
+
+struct ImaState {
+  int32_t predictor = 0;
+  int8_t  index = 0;
+};
+
+namespace ima {
+
+inline uint16_t samplesPerBlock(uint16_t blockBytes){
+  return (uint16_t)(1 + (blockBytes - IMA_BLOCK_HEADER) * 2);
+}
+
+bool parseHeader(const uint8_t* in, ImaHeader& h);
+void writeHeader(const ImaHeader& h, uint8_t* out);
+
+// Blockkopf übernehmen; liefert das erste Sample des Blocks
+int16_t beginBlock(const uint8_t* block, ImaState& st);
+
+// Ein 4-bit Code -> ein Sample
+int16_t decodeNibble(uint8_t nibble, ImaState& st);
+
+// Ganzen Block dekodieren (Host-Tools/Benchmark); liefert Sampleanzahl
+size_t decodeBlock(const uint8_t* block, size_t blockBytes, int16_t* out, size_t maxSamples);
+
+// n PCM-Samples (n <= samplesPerBlock) als einen Block kodieren. Der Rest
+// eines kurzen letzten Blocks wird mit Stille aufgefüllt.
+void encodeBlock(const int16_t* pcm, size_t n, ImaState& st, uint8_t* block, size_t blockBytes);
+
+}  // namespace ima
@@ -0,0 +1,169 @@
+// ============================================================================
+// File: src/comm/CommandTable.cpp
+// ----------------------------------------------------------------------------
+#include "CommandTable.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace cmd {
+
+static constexpr size_t MAX_NAME_WORDS = 4;
+
+static inline bool isSpace(char c){ return c == ' ' || c == '\t'; }
+
+// Ganze Zeichenkette, kein Überlauf (ERANGE: long ist am Gerät 32 Bit breit)
+static bool toUnsigned(const char* tok, uint32_t max, uint32_t& out){
+  if (*tok == '-') return false;
+  char* end = nullptr;
+  errno = 0;
+  const unsigned long x = strtoul(tok, &end, 0);
+  if (end == tok || *end || errno == ERANGE || x > max) return false;
+  out = (uint32_t)x;
+  return true;
+}
+
+bool Registry::add(const Command* table, size_t n, void* ctx, const char* group){
+  if (_count >= MAX_TABLES || !table || !n) return false;
+  _tables[_count++] = Table{table, n, ctx, group};
+  return true;
+}
+
+// Vergleicht name mit den ersten k Wörtern, als wären sie mit genau einem
+// Leerzeichen verbunden – gleiche Ordnung wie compare()/strcmp
+int Registry::compareKey(const char* name, const Word* w, size_t k){
+  size_t j = 0, i = 0;
+  for (;;) {
+    int kc;
+    if (i < w[j].len) {
+      kc = (uint8_t)w[j].p[i++];
+    } else {
+      j++;
+      i = 0;
+      kc = j < k ? ' ' : 0;
+    }
+    const int nc = (uint8_t)*name;
+    if (nc != kc) return nc - kc;
+    if (nc == 0) return 0;
+    name++;
+  }
+}
+
+const Command* Registry::find(const Word* w, size_t k, void** ctx) const {
+  for (size_t t = 0; t < _count; t++) {
+    const Table& tab = _tables[t];
+    size_t lo = 0, hi = tab.n;
+    while (lo < hi) {
+      const size_t mid = (lo + hi) / 2;
+      const int c = compareKey(tab.cmds[mid].name, w, k);
+      if (c == 0) { *ctx = tab.ctx; return &tab.cmds[mid]; }
+      if (c < 0) lo = mid + 1;
+      else hi = mid;
+    }
+  }
+  return nullptr;
+}
+
+bool Registry::parseArgs(const char* schema, const Word* w, size_t nw, bool more, Args& a){
+  bool optional = false;
+  size_t j = 0;
+  a.count = 0;
+  for (const char* s = schema; *s; s++) {
+    if (*s == '?') { optional = true; continue; }
+    if (a.count >= MAX_ARGS) return false;
+    if (j >= nw) return optional;
+    Args::Value& v = a.v[a.count];
+    if (*s == 'r') {                       // Rest der Zeile (Ende ist bereits getrimmt)
+      v.s = w[j].p;
+      a.count++;
+      return true;
+    }
+    char* tok = w[j].p;
+    tok[w[j].len] = '\0';
+    j++;
+    char* end = nullptr;
+    switch (*s) {
+      case 'i': {
+        errno = 0;
+        const long x = strtol(tok, &end, 0);
+        if (end == tok || *end || errno == ERANGE || x < INT32_MIN || x > INT32_MAX) return false;
+        v.i = (int32_t)x;
+        break;
+      }
+      case 'u':
+        if (!toUnsigned(tok, UINT32_MAX, v.u)) return false;
+        break;
+      case 'h':
+        if (!toUnsigned(tok, UINT16_MAX, v.u)) return false;
+        break;
+      case 'c':
+        if (!toUnsigned(tok, UINT8_MAX, v.u)) return false;
+        break;
+      case 'f':
+        v.f = strtof(tok, &end);
+        if (*end) return false;
+        break;
+      case 'b':
+        if (!strcmp(tok, "on") || !strcmp(tok, "1")) v.b = true;
+        else if (!strcmp(tok, "off") || !strcmp(tok, "0")) v.b = false;
+        else return false;
+        break;
+      case 'w':
+        v.s = tok;
+        break;
+      default:
+        return false;                      // Schemafehler in der Tabelle
+    }
+    a.count++;
+  }
+  return j == nw && !more;                 // überzählige Argumente
+}
+
+Result Registry::dispatch(char* line){
+  _matched = nullptr;
+  size_t len = strlen(line);
+  while (len && isSpace(line[len - 1])) line[--len] = '\0';
+
+  Word w[MAX_WORDS];
+  size_t nw = 0;
+  bool more = false;
+  for (char* p = line; *p; ) {
+    while (isSpace(*p)) p++;
+    if (!*p) break;
+    if (nw == MAX_WORDS) { more = true; break; }
+    char* start = p;
+    while (*p && !isSpace(*p)) p++;
+    w[nw++] = Word{start, (uint16_t)(p - start)};
+  }
+  if (nw == 0) return Result::Empty;
+
+  // Längster Name zuerst: "modbus poll add" vor "modbus"
+  for (size_t k = nw < MAX_NAME_WORDS ? nw : MAX_NAME_WORDS; k >= 1; k--) {
+    void* ctx = nullptr;
+    const Command* c = find(w, k, &ctx);
+    if (!c) continue;
+    _matched = c;
+    Args a;
+    if (!parseArgs(c->schema, w + k, nw - k, more, a)) return Result::BadArgs;
+    c->fn(ctx, a);
+    return Result::Ok;
+  }
+  return Result::Unknown;
+}
+
+void Registry::help(Emit out, void* ctx) const {
+  char line[112];
+  for (size_t t = 0; t < _count; t++) {
+    const Table& tab = _tables[t];
+    snprintf(line, sizeof(line), "[%s]", tab.group);
+    out(line, ctx);
+    for (size_t k = 0; k < tab.n; k++) {
+      const Command& c = tab.cmds[k];
+      snprintf(line, sizeof(line), "  %s%s%s", c.name, c.usage[0] ? " " : "", c.usage);
+      out(line, ctx);
+    }
+  }
+}
+
+}  // namespace cmd
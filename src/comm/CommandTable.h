@@ -0,0 +1,92 @@
+// ============================================================================
+// File: src/comm/CommandTable.h
+// ----------------------------------------------------------------------------
+// Purpose: Konsolenbefehle als statische Tabellen {Name, Schema, Hilfe, Handler}
+//  • Jede Tabelle ist nach Name sortiert (static_assert(cmd::sorted(...)))
+//    und wird per Binärsuche durchsucht; Module registrieren eigene Tabellen
+//  • Namen dürfen mehrere Wörter haben ("modbus poll add"), es gewinnt der
+//    längste passende Name
+//  • Die Zeile wird in place zerlegt, Argumente typisiert geparst – kein Heap
+//  • Plattformneutral (Host-Test: tools/console_test.cpp)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace cmd {
+
+static constexpr size_t MAX_ARGS   = 8;
+static constexpr size_t MAX_WORDS  = MAX_ARGS + 4;   // Name + Argumente
+static constexpr size_t MAX_TABLES = 12;
+
+// Schema, ein Zeichen je Argument:
+//   i = int32, u = uint32, h = uint16, c = uint8 (h/c: Zugriff mit u()),
+//   f = float, b = on/off (1/0), w = Wort,
+//   r = Rest der Zeile (nur am Ende, darf Leerzeichen enthalten)
+// Alles nach '?' ist optional. Zahlen auch hex ("0x10"); Werte außerhalb
+// des Typs (Überlauf, negativ bei u/h/c) -> Result::BadArgs.
+struct Args {
+  union Value { int32_t i; uint32_t u; float f; bool b; const char* s; };
+
+  uint8_t count = 0;
+  Value   v[MAX_ARGS];
+
+  bool        has(size_t k) const { return k < count; }
+  int32_t     i(size_t k, int32_t def = 0) const { return k < count ? v[k].i : def; }
+  uint32_t    u(size_t k, uint32_t def = 0) const { return k < count ? v[k].u : def; }
+  float       f(size_t k, float def = 0.f) const { return k < count ? v[k].f : def; }
+  bool        b(size_t k, bool def = false) const { return k < count ? v[k].b : def; }
+  const char* s(size_t k, const char* def = "") const { return k < count ? v[k].s : def; }
+};
+
+using Handler = void (*)(void* ctx, const Args& a);
+
+struct Command {
+  const char* name;
+  const char* schema;
+  const char* usage;     // Argumente für die Hilfe, z.B. "<id> [prio]"
+  Handler     fn;
+};
+
+constexpr int compare(const char* a, const char* b){
+  while (*a && *a == *b) { a++; b++; }
+  return (int)(uint8_t)*a - (int)(uint8_t)*b;
+}
+
+template <size_t N>
+constexpr bool sorted(const Command (&t)[N]){
+  for (size_t k = 1; k < N; k++) if (compare(t[k - 1].name, t[k].name) >= 0) return false;
+  return true;
+}
+
+enum class Result : uint8_t { Ok, Empty, Unknown, BadArgs };
+
+using Emit = void (*)(const char* line, void* ctx);
+
+class Registry {
+public:
+  bool add(const Command* table, size_t n, void* ctx, const char* group);
+  template <size_t N>
+  bool add(const Command (&t)[N], void* ctx, const char* group){ return add(t, N, ctx, group); }
+
+  // line wird verändert (Argumente nullterminiert). Bei BadArgs zeigt
+  // matched() auf den Befehl (für die Aufrufhilfe).
+  Result dispatch(char* line);
+  const Command* matched() const { return _matched; }
+
+  void help(Emit out, void* ctx) const;
+
+private:
+  struct Word { char* p; uint16_t len; };
+  struct Table { const Command* cmds; size_t n; void* ctx; const char* group; };
+
+  static int  compareKey(const char* name, const Word* w, size_t k);
+  static bool parseArgs(const char* schema, const Word* w, size_t nw, bool more, Args& a);
+  const Command* find(const Word* w, size_t k, void** ctx) const;
+
+  Table          _tables[MAX_TABLES];
+  size_t         _count = 0;
+  const Command* _matched = nullptr;
+};
+
+}  // namespace cmd
@@ -0,0 +1,357 @@
+// ============================================================================
+// File: src/comm/LinkBench.cpp
+// ----------------------------------------------------------------------------
+#include "LinkBench.h"
+#include "TelemetryProto.h"
+#include <algorithm>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+enum FrameType : uint8_t {
+  PING = 1, PONG, DATA, END, REPORT, BAUD, BAUD_ACK
+};
+
+static constexpr size_t RAW_MAX  = 1 + 4 + LinkBenchConfig::MAX_PAYLOAD + 4;
+static constexpr size_t WIRE_MAX = RAW_MAX + RAW_MAX / 254 + 2;
+
+inline void wr32(uint8_t* p, uint32_t v){ p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24); }
+inline uint32_t rd32(const uint8_t* p){ return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+// [type][seq LE32][payload][CRC32] -> COBS + 0x00
+bool encodeAndSend(BenchTransport& t, uint8_t type, uint32_t seq, const uint8_t* payload, size_t len){
+  uint8_t raw[RAW_MAX], wire[WIRE_MAX];
+  if (len > LinkBenchConfig::MAX_PAYLOAD) return false;
+  raw[0] = type;
+  wr32(raw + 1, seq);
+  if (len) memcpy(raw + 5, payload, len);
+  wr32(raw + 5 + len, telem::crc32(raw, 5 + len));
+  size_t n = telem::cobsEncode(raw, 9 + len, wire);
+  wire[n++] = 0x00;
+  return t.send(wire, n);
+}
+
+struct Frame {
+  uint8_t        type;
+  uint32_t       seq;
+  const uint8_t* payload;
+  size_t         len;
+  size_t         wireLen;       // inkl. Trenner
+};
+
+enum class Rx : uint8_t { None, Ok, Bad };
+
+// Nächsten Frame holen; raw dient als Puffer für die Nutzlast
+Rx receiveFrame(BenchTransport& t, uint8_t* raw, Frame& f){
+  uint8_t wire[WIRE_MAX];
+  const size_t n = t.receive(wire, sizeof(wire));
+  if (n == 0) return Rx::None;
+  const size_t r = telem::cobsDecode(wire, n, raw, RAW_MAX);
+  if (r < 9 || telem::crc32(raw, r - 4) != rd32(raw + r - 4)) return Rx::Bad;
+  f.type    = raw[0];
+  f.seq     = rd32(raw + 1);
+  f.payload = raw + 5;
+  f.len     = r - 9;
+  f.wireLen = n + 1;
+  return Rx::Ok;
+}
+
+inline void fillPattern(uint8_t* p, size_t n, uint32_t seq){
+  for (size_t i = 0; i < n; i++) p[i] = (uint8_t)(seq * 31u + i * 7u);
+}
+
+}  // namespace
+
+// ---------------------------- Master -----------------------------------------
+void LinkBench::begin(BenchTransport& t, BenchLog log, void* logCtx){
+  _t      = &t;
+  _log    = log;
+  _logCtx = logCtx;
+}
+
+void LinkBench::log(const char* fmt, ...){
+  if (!_log) return;
+  char line[160];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(line, sizeof(line), fmt, ap);
+  va_end(ap);
+  _log(line, _logCtx);
+}
+
+bool LinkBench::start(const LinkBenchConfig& cfg){
+  if (!_t || running()) return false;
+  _cfg = cfg;
+  if (_cfg.baudCount > LinkBenchConfig::MAX_BAUDS) _cfg.baudCount = LinkBenchConfig::MAX_BAUDS;
+  if (_cfg.pings > LinkBenchConfig::MAX_PINGS) _cfg.pings = LinkBenchConfig::MAX_PINGS;
+  if (_cfg.pingPayload > LinkBenchConfig::MAX_PAYLOAD) _cfg.pingPayload = LinkBenchConfig::MAX_PAYLOAD;
+  if (_cfg.streamPayload > LinkBenchConfig::MAX_PAYLOAD) _cfg.streamPayload = LinkBenchConfig::MAX_PAYLOAD;
+  _resultCount = 0;
+  _baudIdx     = 0;
+  _baud        = _cfg.baseBaud;
+  _t->setBaud(_baud);
+  log("start: %u Baudraten, %u Pings x %u B, %u Stream-Frames x %u B",
+      _cfg.baudCount, _cfg.pings, _cfg.pingPayload, _cfg.streamFrames, _cfg.streamPayload);
+  enter(State::SwitchBaud);
+  return true;
+}
+
+void LinkBench::stop(){
+  if (!running()) return;
+  _t->setBaud(_cfg.baseBaud);
+  _state = State::Idle;
+  log("abgebrochen");
+}
+
+void LinkBench::enter(State s){
+  _state   = s;
+  _stateUs = _t->nowUs();
+  _gotReply = false;
+  _cmdSent  = false;
+}
+
+// Leitungszeit für n Byte (10 Bit/Zeichen, 8N1)
+uint32_t LinkBench::frameUs(size_t bytes) const {
+  return _baud ? (uint32_t)((uint64_t)bytes * 10u * 1000000u / _baud) : 0;
+}
+
+bool LinkBench::sendFrame(uint8_t type, uint32_t seq, const uint8_t* payload, size_t len){
+  return encodeAndSend(*_t, type, seq, payload, len);
+}
+
+void LinkBench::handleFrames(){
+  uint8_t raw[RAW_MAX];
+  Frame f;
+  Rx r;
+  while ((r = receiveFrame(*_t, raw, f)) != Rx::None) {
+    if (r == Rx::Bad) { if (_cur) _cur->crcErrors++; continue; }
+    switch (f.type) {
+      case PONG:
+        if (_state != State::WaitPong || !_cur) break;
+        fillPattern(_payload, _cfg.pingPayload, _seq);
+        if (f.seq == _seq && f.len == _cfg.pingPayload && memcmp(f.payload, _payload, f.len) == 0) {
+          _rtt[_cur->pingsOk++] = _t->nowUs() - _sentUs;
+          enter(State::Ping);
+        } else {
+          _cur->mismatches++;              // z.B. verspätete Antwort auf alten Ping
+        }
+        break;
+      case BAUD_ACK:
+        if ((_state == State::WaitBaudAck || _state == State::Finish) && f.seq == _seq) _gotReply = true;
+        break;
+      case REPORT:
+        if (_state == State::WaitReport && _cur && f.len >= 20) {
+          _cur->streamFrames = rd32(f.payload);
+          _cur->streamBytes  = rd32(f.payload + 4);
+          _cur->streamLost   = rd32(f.payload + 8);
+          _cur->crcErrors   += (uint16_t)rd32(f.payload + 12);
+          _cur->streamUs     = rd32(f.payload + 16);
+          _gotReply = true;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void LinkBench::nextBaud(){
+  _baudIdx++;
+  enter(State::SwitchBaud);
+}
+
+void LinkBench::finishBaud(){
+  LinkBenchResult& r = *_cur;
+  if (r.pingsOk) {
+    std::sort(_rtt, _rtt + r.pingsOk);
+    auto pct = [&](float p){ size_t i = (size_t)(p * (r.pingsOk - 1) + 0.5f); return _rtt[i]; };
+    r.rttP50 = pct(0.50f);
+    r.rttP95 = pct(0.95f);
+    r.rttP99 = pct(0.99f);
+    r.rttMax = _rtt[r.pingsOk - 1];
+  }
+  log("%7u Bd: ping %u/%u rtt p50=%u p95=%u p99=%u max=%u us | stream %u B/s, %u Frames, %u verloren | crc=%u mism=%u",
+      r.baud, r.pingsOk, r.pingsSent, r.rttP50, r.rttP95, r.rttP99, r.rttMax,
+      r.bytesPerSec(), r.streamFrames, r.streamLost, r.crcErrors, r.mismatches);
+  nextBaud();
+}
+
+void LinkBench::poll(){
+  if (_state == State::Idle) return;
+  handleFrames();
+  const uint32_t now     = _t->nowUs();
+  const uint32_t inState = now - _stateUs;
+  const uint32_t replyUs = (uint32_t)_cfg.replyTimeoutMs * 1000u;
+
+  switch (_state) {
+    case State::SwitchBaud: {
+      if (_baudIdx >= _cfg.baudCount) { enter(State::Finish); break; }
+      _cur = &_results[_baudIdx];
+      if (_resultCount <= _baudIdx) {          // erster Versuch (send() kann scheitern)
+        _resultCount = _baudIdx + 1;
+        *_cur = LinkBenchResult{};
+        _cur->baud = _cfg.bauds[_baudIdx];
+      }
+      if (_cur->baud == _baud) { enter(State::Settle); break; }
+      uint8_t p[4];
+      wr32(p, _cur->baud);
+      if (sendFrame(BAUD, ++_seq, p, 4)) enter(State::WaitBaudAck);
+      break;
+    }
+    case State::WaitBaudAck:
+      if (_gotReply) {
+        // ACK empfangen -> unser Kommando ist draußen; Peer schaltet nach seinem ACK
+        _baud = _cur->baud;
+        _t->setBaud(_baud);
+        enter(State::Settle);
+      } else if (inState > replyUs + frameUs(32)) {
+        log("%7u Bd: keine Bestätigung, übersprungen", _cur->baud);
+        nextBaud();
+      }
+      break;
+    case State::Settle:
+      if (inState >= (uint32_t)_cfg.settleMs * 1000u) {
+        _cur->linkOk = true;
+        enter(State::Ping);
+      }
+      break;
+    case State::Ping:
+      if (_cur->pingsSent >= _cfg.pings) { _streamSent = 0; enter(State::Stream); break; }
+      // Strecke tot: die ersten Pings nach dem Wechsel bleiben alle aus
+      if (_cur->pingsSent >= 5 && _cur->pingsOk == 0) {
+        log("%7u Bd: keine Antwort, zurück auf %u Bd", _cur->baud, _cfg.baseBaud);
+        _cur->linkOk = false;
+        _baud = _cfg.baseBaud;
+        _t->setBaud(_baud);
+        enter(State::Recover);
+        break;
+      }
+      fillPattern(_payload, _cfg.pingPayload, _seq + 1);
+      if (sendFrame(PING, _seq + 1, _payload, _cfg.pingPayload)) {
+        _seq++;
+        _sentUs = _t->nowUs();
+        _cur->pingsSent++;
+        enter(State::WaitPong);
+      }
+      break;
+    case State::WaitPong:
+      if (inState > replyUs + 2 * frameUs(_cfg.pingPayload + 12)) {
+        _cur->timeouts++;
+        enter(State::Ping);
+      }
+      break;
+    case State::Stream:
+      while (_streamSent < _cfg.streamFrames) {
+        fillPattern(_payload, _cfg.streamPayload, _streamSent);
+        if (!sendFrame(DATA, _streamSent, _payload, _cfg.streamPayload)) break;   // TX voll
+        _streamSent++;
+      }
+      if (_streamSent >= _cfg.streamFrames) enter(State::StreamDrain);
+      break;
+    case State::StreamDrain:
+      if (_t->txIdle() && sendFrame(END, ++_seq, nullptr, 0)) enter(State::WaitReport);
+      break;
+    case State::WaitReport:
+      if (_gotReply) finishBaud();
+      else if (inState > 5 * replyUs) { log("%7u Bd: kein Stream-Report", _cur->baud); finishBaud(); }
+      break;
+    case State::Recover:
+      // Peer fällt nach revertMs ohne gültigen Frame selbst auf die Startbaudrate
+      if (inState > ((uint32_t)_cfg.revertMs + 500u) * 1000u) nextBaud();
+      break;
+    case State::Finish:
+      if (_baud == _cfg.baseBaud) {
+        log("fertig");
+        _state = State::Idle;
+      } else if (!_cmdSent) {
+        uint8_t p[4];
+        wr32(p, _cfg.baseBaud);
+        if (sendFrame(BAUD, ++_seq, p, 4)) { _cmdSent = true; _stateUs = now; }
+      } else if (_gotReply || inState > replyUs + frameUs(32)) {
+        // ACK oder Timeout: zurück auf Start (der Peer fällt sonst selbst zurück)
+        _baud = _cfg.baseBaud;
+        _t->setBaud(_baud);
+      }
+      break;
+    case State::Idle:
+      break;
+  }
+}
+
+// ---------------------------- Peer -------------------------------------------
+void LinkBenchPeer::begin(BenchTransport& t, uint32_t baseBaud, uint16_t revertMs){
+  _t        = &t;
+  _baseBaud = baseBaud;
+  _baud     = baseBaud;
+  _revertMs = revertMs;
+  _pendingBaud = 0;
+  _confirmed   = true;
+  _rxFrames = _rxBytes = _lost = _crcErrors = 0;
+  _t->setBaud(_baud);
+}
+
+bool LinkBenchPeer::sendFrame(uint8_t type, uint32_t seq, const uint8_t* payload, size_t len){
+  return encodeAndSend(*_t, type, seq, payload, len);
+}
+
+void LinkBenchPeer::poll(){
+  if (!_t) return;
+  const uint32_t now = _t->nowUs();
+
+  if (_pendingBaud && _t->txIdle()) {
+    _baud = _pendingBaud;
+    _t->setBaud(_baud);
+    _pendingBaud = 0;
+    _switchedUs  = now;
+    _confirmed   = (_baud == _baseBaud);
+  }
+  if (!_confirmed && (now - _switchedUs) > (uint32_t)_revertMs * 1000u) {
+    _baud = _baseBaud;
+    _t->setBaud(_baud);
+    _confirmed = true;
+  }
+
+  uint8_t raw[RAW_MAX];
+  Frame f;
+  Rx r;
+  while ((r = receiveFrame(*_t, raw, f)) != Rx::None) {
+    if (r == Rx::Bad) { _crcErrors++; continue; }
+    _confirmed = true;
+    switch (f.type) {
+      case PING:
+        sendFrame(PONG, f.seq, f.payload, f.len);
+        break;
+      case DATA:
+        if (_rxFrames == 0) {
+          _firstUs = now;
+          _nextSeq = f.seq;
+          _rxBytes = 0;                    // Zeitbasis beginnt mit dem ersten Frame
+        } else {
+          _rxBytes += (uint32_t)f.wireLen;
+        }
+        if (f.seq != _nextSeq) _lost += f.seq - _nextSeq;
+        _nextSeq = f.seq + 1;
+        _rxFrames++;
+        _lastUs = now;
+        break;
+      case END: {
+        uint8_t p[20];
+        wr32(p, _rxFrames);
+        wr32(p + 4, _rxBytes);
+        wr32(p + 8, _lost);
+        wr32(p + 12, _crcErrors);
+        wr32(p + 16, _rxFrames > 1 ? _lastUs - _firstUs : 0);
+        sendFrame(REPORT, f.seq, p, sizeof(p));
+        _rxFrames = _rxBytes = _lost = _crcErrors = 0;
+        break;
+      }
+      case BAUD:
+        if (f.len >= 4 && sendFrame(BAUD_ACK, f.seq, nullptr, 0)) _pendingBaud = rd32(f.payload);
+        break;
+      default:
+        break;
+    }
+  }
+}
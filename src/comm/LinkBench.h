@@ -0,0 +1,133 @@
+// ============================================================================
+// File: src/comm/LinkBench.h
+// ----------------------------------------------------------------------------
+// Purpose: RS485-Streckentest (Durchsatz, Round-Trip, Fehler) gegen eine
+//          Gegenstelle mit derselben Firmware im Peer-Modus
+//  • Frames wie die Telemetrie: COBS + CRC32, 0x00 als Trenner
+//  • Je Baudrate: Ping-Pong (Echo der Nutzlast, RTT-Perzentile) und
+//    einseitiges Streaming (Peer zählt und meldet Bytes/Zeit/Verluste)
+//  • Baudwechsel per Kommando; bleibt der Peer nach dem Wechsel ohne
+//    gültigen Frame, fällt er nach revertMs auf die Startbaudrate zurück
+//  • Plattformneutral, nicht-blockierend (poll()); Transport ist abstrakt:
+//    RS485Bus auf dem Gerät, PTY/TTY unter Linux (tools/linkbench_host.cpp)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+class BenchTransport {
+public:
+  virtual ~BenchTransport() {}
+  // Frame komplett einreihen oder false (kein Platz) – nie teilweise
+  virtual bool     send(const uint8_t* data, size_t len) = 0;
+  // Ein empfangener Frame ohne 0x00-Trenner, 0 = nichts da
+  virtual size_t   receive(uint8_t* buf, size_t cap) = 0;
+  virtual bool     txIdle() = 0;
+  virtual void     setBaud(uint32_t baud) = 0;
+  virtual uint32_t nowUs() = 0;
+};
+
+using BenchLog = void (*)(const char* line, void* ctx);
+
+struct LinkBenchConfig {
+  static constexpr size_t MAX_BAUDS   = 8;
+  static constexpr size_t MAX_PINGS   = 256;
+  static constexpr size_t MAX_PAYLOAD = 240;
+
+  uint32_t bauds[MAX_BAUDS] = {9600, 19200, 57600, 115200, 230400, 460800, 921600};
+  uint8_t  baudCount = 7;
+  uint32_t baseBaud = 115200;      // Start/Ende und Rückfall des Peers
+  uint16_t pings = 200;
+  uint16_t pingPayload = 32;
+  uint16_t streamFrames = 300;
+  uint16_t streamPayload = 200;
+  uint16_t replyTimeoutMs = 100;   // zzgl. Leitungszeit
+  uint16_t settleMs = 20;          // nach Baudwechsel
+  uint16_t revertMs = 3000;
+};
+
+struct LinkBenchResult {
+  uint32_t baud = 0;
+  bool     linkOk = false;         // Baudwechsel bestätigt
+  uint16_t pingsSent = 0;
+  uint16_t pingsOk = 0;
+  uint16_t timeouts = 0;
+  uint16_t crcErrors = 0;          // beide Seiten zusammen
+  uint16_t mismatches = 0;         // falsche Sequenz / veränderte Nutzlast
+  uint32_t rttP50 = 0, rttP95 = 0, rttP99 = 0, rttMax = 0;
+  uint32_t streamBytes = 0;        // vom Peer empfangen (Leitung)
+  uint32_t streamFrames = 0;
+  uint32_t streamLost = 0;
+  uint32_t streamUs = 0;
+  uint32_t bytesPerSec() const { return streamUs ? (uint32_t)((uint64_t)streamBytes * 1000000u / streamUs) : 0; }
+};
+
+// ---------------------------- Master -----------------------------------------
+class LinkBench {
+public:
+  void begin(BenchTransport& t, BenchLog log, void* logCtx);
+  bool start(const LinkBenchConfig& cfg);
+  void stop();
+  bool running() const { return _state != State::Idle; }
+  void poll();
+
+  size_t resultCount() const { return _resultCount; }
+  const LinkBenchResult& result(size_t i) const { return _results[i]; }
+
+private:
+  enum class State : uint8_t {
+    Idle, SwitchBaud, WaitBaudAck, Settle, Ping, WaitPong,
+    Stream, StreamDrain, WaitReport, Recover, Finish
+  };
+
+  void enter(State s);
+  void nextBaud();
+  void finishBaud();
+  bool sendFrame(uint8_t type, uint32_t seq, const uint8_t* payload, size_t len);
+  void handleFrames();
+  uint32_t frameUs(size_t bytes) const;
+  void log(const char* fmt, ...);
+
+  BenchTransport* _t = nullptr;
+  BenchLog        _log = nullptr;
+  void*           _logCtx = nullptr;
+  LinkBenchConfig _cfg;
+  State           _state = State::Idle;
+  uint32_t        _stateUs = 0;
+  uint8_t         _baudIdx = 0;
+  uint32_t        _baud = 0;
+  uint32_t        _seq = 0;
+  uint32_t        _sentUs = 0;
+  uint16_t        _streamSent = 0;
+  bool            _gotReply = false;
+  bool            _cmdSent = false;
+
+  uint32_t        _rtt[LinkBenchConfig::MAX_PINGS];
+  uint8_t         _payload[LinkBenchConfig::MAX_PAYLOAD];
+  LinkBenchResult _results[LinkBenchConfig::MAX_BAUDS];
+  size_t          _resultCount = 0;
+  LinkBenchResult* _cur = nullptr;
+};
+
+// ---------------------------- Peer (Echo) ------------------------------------
+class LinkBenchPeer {
+public:
+  void begin(BenchTransport& t, uint32_t baseBaud, uint16_t revertMs = 3000);
+  void poll();
+  uint32_t baud() const { return _baud; }
+
+private:
+  bool sendFrame(uint8_t type, uint32_t seq, const uint8_t* payload, size_t len);
+
+  BenchTransport* _t = nullptr;
+  uint32_t _baseBaud = 115200;
+  uint32_t _baud = 115200;
+  uint16_t _revertMs = 3000;
+  uint32_t _pendingBaud = 0;       // nach ACK umschalten, sobald TX leer
+  uint32_t _switchedUs = 0;
+  bool     _confirmed = true;      // gültiger Frame seit dem Wechsel
+
+  // Streaming-Zähler
+  uint32_t _rxFrames = 0, _rxBytes = 0, _lost = 0, _crcErrors = 0;
+  uint32_t _firstUs = 0, _lastUs = 0, _nextSeq = 0;
+};
@@ -0,0 +1,128 @@
+// ============================================================================
+// File: src/comm/MirrorProto.cpp
+// ----------------------------------------------------------------------------
+#include "MirrorProto.h"
+#include "TelemetryProto.h"
+
+namespace mirror {
+
+static inline void putPixel(uint8_t* out, size_t& k, uint16_t v){
+  out[k++] = (uint8_t)v;
+  out[k++] = (uint8_t)(v >> 8);
+}
+
+size_t rleEncode(const uint16_t* px, size_t n, uint8_t* out){
+  size_t k = 0, i = 0;
+  while (i < n) {
+    size_t run = 1;
+    while (i + run < n && run < 128 && px[i + run] == px[i]) run++;
+    if (run >= 2) {                       // 2 gleiche Pixel: Lauf (3 statt 4 Byte)
+      out[k++] = (uint8_t)(0x80 | (run - 1));
+      putPixel(out, k, px[i]);
+      i += run;
+      continue;
+    }
+    // Einzelpixel bis zum nächsten Lauf
+    size_t j = i + 1;
+    while (j < n && j - i < 128 && !(j + 1 < n && px[j] == px[j + 1])) j++;
+    out[k++] = (uint8_t)(j - i - 1);
+    for (; i < j; i++) putPixel(out, k, px[i]);
+  }
+  return k;
+}
+
+bool rleDecode(const uint8_t*& p, const uint8_t* end, uint16_t* px, size_t n){
+  size_t i = 0;
+  while (i < n) {
+    if (p >= end) return false;
+    const uint8_t c = *p++;
+    const size_t cnt = (size_t)(c & 0x7F) + 1;
+    if (i + cnt > n) return false;
+    if (c & 0x80) {
+      if (end - p < 2) return false;
+      const uint16_t v = (uint16_t)(p[0] | (p[1] << 8));
+      p += 2;
+      for (size_t k = 0; k < cnt; k++) px[i++] = v;
+    } else {
+      if ((size_t)(end - p) < 2 * cnt) return false;
+      for (size_t k = 0; k < cnt; k++, p += 2) px[i++] = (uint16_t)(p[0] | (p[1] << 8));
+    }
+  }
+  return true;
+}
+
+// ---------------------------- Encoder ---------------------------------------
+void ChunkEncoder::putVarint(uint32_t v){
+  while (v >= 0x80) { _buf[_len++] = (uint8_t)(v | 0x80); v >>= 7; }
+  _buf[_len++] = (uint8_t)v;
+}
+
+void ChunkEncoder::begin(uint8_t* buf, size_t cap, const ChunkHeader& h){
+  _buf   = buf;
+  _cap   = cap;
+  _len   = 0;
+  _tiles = 0;
+  _buf[_len++] = MAGIC;
+  _buf[_len++] = VERSION;
+  _buf[_len++] = h.flags;
+  putVarint(h.seq);
+  putVarint(h.frame);
+  putVarint(h.ms);
+  putVarint(h.width);
+  putVarint(h.height);
+}
+
+bool ChunkEncoder::addTile(uint16_t index, const uint16_t* px){
+  if (_len + TILE_MAX + TRAILER > _cap) return false;
+  putVarint(index);
+  _len += rleEncode(px, TILE_PIXELS, _buf + _len);
+  _tiles++;
+  return true;
+}
+
+size_t ChunkEncoder::finish(uint8_t flags){
+  _buf[2] |= flags;
+  const uint32_t crc = telem::crc32(_buf, _len);
+  for (int i = 0; i < 4; i++) _buf[_len++] = (uint8_t)(crc >> (8 * i));
+  return _len;
+}
+
+// ---------------------------- Decoder ---------------------------------------
+static bool getVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v){
+  v = 0;
+  for (unsigned shift = 0; shift < 35 && p < end; shift += 7) {
+    const uint8_t b = *p++;
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+bool decodeChunk(const uint8_t* raw, size_t n, ChunkHeader& h, TileVisitor visit, void* ctx){
+  if (n < 3 + TRAILER || raw[0] != MAGIC) return false;
+  const size_t body = n - TRAILER;
+  const uint32_t crc = (uint32_t)raw[body] | (uint32_t)raw[body + 1] << 8 |
+                       (uint32_t)raw[body + 2] << 16 | (uint32_t)raw[body + 3] << 24;
+  if (telem::crc32(raw, body) != crc || raw[1] != VERSION) return false;
+
+  const uint8_t* p = raw + 2;
+  const uint8_t* end = raw + body;
+  h.flags = *p++;
+  uint32_t w, hh;
+  if (!getVarint(p, end, h.seq) || !getVarint(p, end, h.frame) || !getVarint(p, end, h.ms) ||
+      !getVarint(p, end, w) || !getVarint(p, end, hh) || w > 0xFFFF || hh > 0xFFFF) return false;
+  h.width  = (uint16_t)w;
+  h.height = (uint16_t)hh;
+  const uint32_t tiles = ((w + TILE - 1) / TILE) * ((hh + TILE - 1) / TILE);
+
+  uint16_t px[TILE_PIXELS];
+  while (p < end) {
+    uint32_t idx;
+    if (!getVarint(p, end, idx) || idx >= tiles) return false;
+    if (!rleDecode(p, end, px, TILE_PIXELS)) return false;
+    if (visit) visit(ctx, (uint16_t)idx, px);
+  }
+  return true;
+}
+
+}  // namespace mirror
@@ -0,0 +1,77 @@
+// ============================================================================
+// File: src/comm/MirrorProto.h
+// ----------------------------------------------------------------------------
+// Purpose: Bildschirm-Spiegel über USB-CDC (Sender: display/ScreenMirror)
+//  • Chunk = 0x00 COBS( Kopf {Tile}* [CRC32 LE] ) 0x00 – Rahmung wie der
+//    Messdaten-Strom (UsbStreamProto.h), erstes Byte MAGIC statt Version:
+//    beide Decoder überspringen die Chunks des anderen
+//  • Kopf: [MAGIC][VERSION][flags][seq varint][frame varint][ms varint]
+//          [breite varint][höhe varint]
+//    flags: FRAME_END = letzter Chunk des Bildes, KEY = Bild enthält alle Tiles
+//  • Tile: [index varint] RLE(TILE x TILE Pixel, zeilenweise)
+//    index = ty * tilesX + tx; Randtiles werden ebenfalls voll übertragen
+//  • RLE über RGB565 (Little Endian): Steuerbyte c
+//      c & 0x80: Lauf, (c & 0x7F) + 1 Pixel gleich, danach 1 Pixel
+//      sonst:    c + 1 einzelne Pixel
+//    Worst Case je Tile 2 + 2 * 256 Byte, einfarbig 6 Byte
+//  • Jeder Chunk ist für sich dekodierbar; ein verlorener Chunk lässt nur
+//    seine Tiles veraltet stehen (nächstes KEY-Bild: "mirror key")
+//  • Plattformneutral: Viewer/Selbsttest in tools/mirror_view.cpp
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace mirror {
+
+static constexpr uint8_t  MAGIC       = 0xD5;
+static constexpr uint8_t  VERSION     = 1;
+static constexpr uint8_t  TILE        = 16;
+static constexpr size_t   TILE_PIXELS = (size_t)TILE * TILE;
+static constexpr size_t   TILE_MAX    = 3 + 2 + 2 * TILE_PIXELS;    // Index + RLE Worst Case
+static constexpr size_t   HEADER_MAX  = 3 + 5 + 5 + 5 + 3 + 3;
+static constexpr size_t   TRAILER     = 4;                          // CRC32
+
+enum Flags : uint8_t {
+  FRAME_END = 0x01,
+  KEY       = 0x02,
+};
+
+// Rückgabe: geschriebene Bytes (out >= 2 * n + (n + 127) / 128)
+size_t rleEncode(const uint16_t* px, size_t n, uint8_t* out);
+// false bei Überlauf/Ende vor n Pixeln
+bool   rleDecode(const uint8_t*& p, const uint8_t* end, uint16_t* px, size_t n);
+
+struct ChunkHeader {
+  uint8_t  flags = 0;
+  uint32_t seq = 0;
+  uint32_t frame = 0;
+  uint32_t ms = 0;            // millis() beim Bildbeginn
+  uint16_t width = 0, height = 0;
+};
+
+class ChunkEncoder {
+public:
+  // cap >= HEADER_MAX + TILE_MAX + TRAILER
+  void   begin(uint8_t* buf, size_t cap, const ChunkHeader& h);
+  bool   addTile(uint16_t index, const uint16_t* px);   // false = Chunk voll
+  size_t finish(uint8_t flags);                         // flags dazu, CRC, Rohlänge
+  size_t size() const { return _len; }
+  uint16_t tiles() const { return _tiles; }
+
+private:
+  void putVarint(uint32_t v);
+
+  uint8_t* _buf = nullptr;
+  size_t   _cap = 0;
+  size_t   _len = 0;
+  uint16_t _tiles = 0;
+};
+
+using TileVisitor = void (*)(void* ctx, uint16_t index, const uint16_t* px);
+
+// raw = COBS-dekodierter Chunk. false: CRC, MAGIC/Version oder Aufbau falsch
+// (Tiles vor dem Fehler sind dann schon gemeldet – nur bei CRC-Fehler nicht)
+bool decodeChunk(const uint8_t* raw, size_t n, ChunkHeader& h, TileVisitor visit, void* ctx);
+
+}  // namespace mirror
@@ -0,0 +1,340 @@
+// ============================================================================
+// File: src/comm/Modbus.cpp
+// ----------------------------------------------------------------------------
+#include "Modbus.h"
+#include "../core/Profiler.h"
+
+namespace modbus {
+
+// CRC-16/MODBUS (Polynom 0xA001 reflektiert, Start 0xFFFF)
+static const uint16_t CRC_TABLE[256] = {
+  0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+  0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+  0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+  0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+  0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+  0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+  0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+  0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+  0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+  0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+  0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+  0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+  0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+  0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+  0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+  0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+  0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+  0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+  0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+  0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+  0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+  0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+  0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+  0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+  0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+  0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+  0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+  0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+  0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+  0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+  0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+  0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040,
+};
+
+uint16_t crc16(const uint8_t* data, size_t len){
+  uint16_t crc = 0xFFFF;
+  while (len--) crc = (crc >> 8) ^ CRC_TABLE[(crc ^ *data++) & 0xFF];
+  return crc;
+}
+
+uint8_t gapSymbols(uint32_t baud){
+  if (baud <= 19200) return 4;                       // 3.5 aufgerundet
+  uint32_t sym = (1750UL * (baud / 100) + 99999UL) / 100000UL;  // 1750 µs / (10 bit / baud)
+  return (uint8_t)constrain(sym, 4UL, 100UL);
+}
+
+static inline uint16_t be16(const uint8_t* p){ return (uint16_t)((p[0] << 8) | p[1]); }
+static inline void put16(uint8_t* p, uint16_t v){ p[0] = (uint8_t)(v >> 8); p[1] = (uint8_t)v; }
+
+static size_t appendCrc(uint8_t* buf, size_t len){
+  uint16_t crc = crc16(buf, len);
+  buf[len]     = (uint8_t)(crc & 0xFF);   // CRC low byte zuerst
+  buf[len + 1] = (uint8_t)(crc >> 8);
+  return len + 2;
+}
+
+static bool crcOk(const uint8_t* buf, size_t len){
+  if (len < 4) return false;
+  uint16_t crc = crc16(buf, len - 2);
+  return buf[len - 2] == (uint8_t)(crc & 0xFF) && buf[len - 1] == (uint8_t)(crc >> 8);
+}
+
+static const ModbusReg* findReg(const ModbusReg* tbl, size_t n, uint16_t addr){
+  size_t lo = 0, hi = n;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (tbl[mid].addr < addr) lo = mid + 1;
+    else hi = mid;
+  }
+  return (lo < n && tbl[lo].addr == addr) ? &tbl[lo] : nullptr;
+}
+
+}  // namespace modbus
+
+using namespace modbus;
+
+// ---------------------------- Statistik -------------------------------------
+void ModbusStats::addTurnaround(uint32_t us){
+  turnCount++;
+  turnLastUs = us;
+  turnSumUs += us;
+  if (us < turnMinUs) turnMinUs = us;
+  if (us > turnMaxUs) turnMaxUs = us;
+}
+
+void ModbusStats::print(Print& out, const char* tag) const {
+  out.printf("[%s] frames=%u crc=%u exc=%u ignored=%u timeouts=%u\n",
+             tag, frames, crcErrors, exceptions, ignored, timeouts);
+  out.printf("[%s] turnaround n=%u last=%uus min=%uus avg=%uus max=%uus\n",
+             tag, turnCount, turnLastUs, turnCount ? turnMinUs : 0u,
+             turnCount ? (uint32_t)(turnSumUs / turnCount) : 0u, turnMaxUs);
+}
+
+// ---------------------------- Slave -----------------------------------------
+bool ModbusSlave::begin(RS485Bus& bus, uint8_t id, const ModbusRegMap& map){
+  _bus   = &bus;
+  _id    = id;
+  _map   = map;
+  _stats = ModbusStats{};
+  _bus->setFraming(RS485Framing::Gap, gapSymbols(_bus->baud()), onFrame, this);
+  return true;
+}
+
+void ModbusSlave::end(){
+  if (_bus) _bus->setFraming(RS485Framing::Off, 0);
+  _bus = nullptr;
+}
+
+// UART-Event-Task: RX-Timeout = Frame komplett
+void ModbusSlave::onFrame(const RS485Frame& f, void* ctx){
+  ModbusSlave* self = static_cast<ModbusSlave*>(ctx);
+  if (!self->_bus) return;
+  if ((f.flags & RS485Frame::Truncated) || f.len > MAX_ADU) {   // länger als jedes gültige ADU
+    self->_stats.ignored++;
+    return;
+  }
+  self->_rx = f.data;
+  self->handleFrame(f.len);
+  self->_rx = nullptr;
+}
+
+void ModbusSlave::handleFrame(size_t len){
+  PROF_ZONE(ProfZone::Modbus);
+  const uint32_t t0 = micros();
+  if (len < 4) { _stats.ignored++; return; }
+  if (!crcOk(_rx, len)) { _stats.crcErrors++; return; }
+
+  const uint8_t addr = _rx[0];
+  if (addr != _id && addr != 0) { _stats.ignored++; return; }
+  _stats.frames++;
+
+  size_t txLen = process(_rx[1], len);
+  if (addr == 0 || txLen == 0) return;        // Broadcast: keine Antwort
+
+  _bus->write(_tx, appendCrc(_tx, txLen));
+  _stats.addTurnaround(micros() - t0);
+}
+
+// Request liegt in _rx (inkl. CRC), Antwort-PDU (ohne CRC) nach _tx
+size_t ModbusSlave::process(uint8_t fn, size_t len){
+  _tx[0] = _id;
+  _tx[1] = fn;
+
+  switch (fn) {
+    case ReadHolding:
+    case ReadInput: {
+      if (len != 8) return exception(fn, IllegalValue);
+      const uint16_t start = be16(_rx + 2), count = be16(_rx + 4);
+      if (count == 0 || count > 125) return exception(fn, IllegalValue);
+      const ModbusReg* tbl = (fn == ReadHolding) ? _map.holding : _map.input;
+      const size_t     n   = (fn == ReadHolding) ? _map.holdingCount : _map.inputCount;
+      _tx[2] = (uint8_t)(count * 2);
+      for (uint16_t i = 0; i < count; i++) {
+        const ModbusReg* r = findReg(tbl, n, (uint16_t)(start + i));
+        if (!r) return exception(fn, IllegalAddress);
+        put16(_tx + 3 + i * 2, *r->value);
+      }
+      return 3 + count * 2;
+    }
+
+    case WriteSingle: {
+      if (len != 8) return exception(fn, IllegalValue);
+      const uint16_t a = be16(_rx + 2), v = be16(_rx + 4);
+      const ModbusReg* r = findReg(_map.holding, _map.holdingCount, a);
+      if (!r || !r->writable) return exception(fn, IllegalAddress);
+      *r->value = v;
+      if (_map.onWrite) _map.onWrite(a, v, _map.ctx);
+      memcpy(_tx + 2, _rx + 2, 4);             // Echo von Adresse + Wert
+      return 6;
+    }
+
+    case WriteMultiple: {
+      if (len < 9) return exception(fn, IllegalValue);
+      const uint16_t start = be16(_rx + 2), count = be16(_rx + 4);
+      const uint8_t  bytes = _rx[6];
+      if (count == 0 || count > 123 || bytes != count * 2 || len != 9u + bytes) {
+        return exception(fn, IllegalValue);
+      }
+      // Erst alles prüfen, dann schreiben (keine halben Updates)
+      for (uint16_t i = 0; i < count; i++) {
+        const ModbusReg* r = findReg(_map.holding, _map.holdingCount, (uint16_t)(start + i));
+        if (!r || !r->writable) return exception(fn, IllegalAddress);
+      }
+      for (uint16_t i = 0; i < count; i++) {
+        const uint16_t a = (uint16_t)(start + i), v = be16(_rx + 7 + i * 2);
+        *findReg(_map.holding, _map.holdingCount, a)->value = v;
+        if (_map.onWrite) _map.onWrite(a, v, _map.ctx);
+      }
+      put16(_tx + 2, start);
+      put16(_tx + 4, count);
+      return 6;
+    }
+
+    default:
+      return exception(fn, IllegalFunction);
+  }
+}
+
+size_t ModbusSlave::exception(uint8_t fn, uint8_t code){
+  _stats.exceptions++;
+  _tx[1] = (uint8_t)(fn | 0x80);
+  _tx[2] = code;
+  return 3;
+}
+
+// ---------------------------- Master ----------------------------------------
+bool ModbusMaster::begin(RS485Bus& bus){
+  _bus   = &bus;
+  _state = State::Idle;
+  _stats = ModbusStats{};
+  _bus->setFraming(RS485Framing::Gap, gapSymbols(_bus->baud()), onFrame, this);
+  return true;
+}
+
+void ModbusMaster::end(){
+  if (_bus) _bus->setFraming(RS485Framing::Off, 0);
+  _bus = nullptr;
+  _state = State::Idle;
+}
+
+bool ModbusMaster::readRegisters(uint8_t slave, uint8_t function, uint16_t addr, uint16_t count,
+                                 uint16_t* dest, ModbusCallback cb, void* ctx){
+  if (!_bus || busy() || slave == 0 || count == 0 || count > 125) return false;
+  if (function != ReadHolding && function != ReadInput) return false;
+  _tx[0] = slave; _tx[1] = function;
+  put16(_tx + 2, addr);
+  put16(_tx + 4, count);
+  _dest = dest; _count = count; _cb = cb; _ctx = ctx;
+  return send(6);
+}
+
+bool ModbusMaster::writeSingle(uint8_t slave, uint16_t addr, uint16_t value, ModbusCallback cb, void* ctx){
+  if (!_bus || busy()) return false;
+  _tx[0] = slave; _tx[1] = WriteSingle;
+  put16(_tx + 2, addr);
+  put16(_tx + 4, value);
+  _dest = nullptr; _count = 1; _cb = cb; _ctx = ctx;
+  return send(6);
+}
+
+bool ModbusMaster::writeMultiple(uint8_t slave, uint16_t addr, const uint16_t* values, uint16_t count,
+                                 ModbusCallback cb, void* ctx){
+  if (!_bus || busy() || count == 0 || count > 123) return false;
+  _tx[0] = slave; _tx[1] = WriteMultiple;
+  put16(_tx + 2, addr);
+  put16(_tx + 4, count);
+  _tx[6] = (uint8_t)(count * 2);
+  for (uint16_t i = 0; i < count; i++) put16(_tx + 7 + i * 2, values[i]);
+  _dest = nullptr; _count = count; _cb = cb; _ctx = ctx;
+  return send(7 + count * 2);
+}
+
+bool ModbusMaster::send(size_t pduLen){
+  _slave    = _tx[0];
+  _function = _tx[1];
+  _state    = State::Waiting;
+  _sentUs   = micros();
+  _bus->write(_tx, appendCrc(_tx, pduLen));
+  if (_slave == 0) finish(ModbusResult::Ok, 0);   // Broadcast: keine Antwort
+  return true;
+}
+
+void ModbusMaster::onFrame(const RS485Frame& f, void* ctx){
+  ModbusMaster* self = static_cast<ModbusMaster*>(ctx);
+  if (!self->_bus) return;
+  if (self->_state != State::Waiting || (f.flags & RS485Frame::Truncated) || f.len > MAX_ADU) {
+    self->_stats.ignored++;
+    return;
+  }
+  self->_rx = f.data;
+  self->handleResponse(f.len);
+  self->_rx = nullptr;
+}
+
+void ModbusMaster::handleResponse(size_t len){
+  PROF_ZONE(ProfZone::Modbus);
+  if (len < 4) { _stats.ignored++; return; }
+  if (!crcOk(_rx, len)) { _stats.crcErrors++; finish(ModbusResult::CrcError, 0); return; }
+  if (_rx[0] != _slave) { _stats.ignored++; return; }
+  _stats.frames++;
+
+  if (_rx[1] == (_function | 0x80)) {
+    _stats.exceptions++;
+    finish(ModbusResult::Exception, _rx[2]);
+    return;
+  }
+  if (_rx[1] != _function) { finish(ModbusResult::BadResponse, 0); return; }
+
+  if (_function == ReadHolding || _function == ReadInput) {
+    if (_rx[2] != _count * 2 || len != 5u + _rx[2]) { finish(ModbusResult::BadResponse, 0); return; }
+    if (_dest) for (uint16_t i = 0; i < _count; i++) _dest[i] = be16(_rx + 3 + i * 2);
+  } else if (len != 8) {
+    finish(ModbusResult::BadResponse, 0);
+    return;
+  }
+  _stats.addTurnaround(micros() - _sentUs);
+  finish(ModbusResult::Ok, 0);
+}
+
+// Antwort (Gap-Task) und Timeout (loop) können sich überholen: wer zuerst
+// kommt, gewinnt
+void ModbusMaster::finish(ModbusResult r, uint8_t code){
+  ModbusCallback cb = nullptr;
+  void* ctx = nullptr;
+  portENTER_CRITICAL(&_mux);
+  if (_state == State::Waiting) {
+    _result    = r;
+    _exception = code;
+    if (_direct) {                 // sofort zustellen, Master ist danach frei
+      cb  = _cb;
+      ctx = _ctx;
+      _state = State::Idle;
+    } else {
+      _state = State::Done;
+    }
+  }
+  portEXIT_CRITICAL(&_mux);
+  if (cb) cb(r, code, ctx);
+}
+
+void ModbusMaster::loop(){
+  if (_state == State::Waiting && (micros() - _sentUs) > MODBUS_RESPONSE_TIMEOUT_MS * 1000UL) {
+    _stats.timeouts++;
+    finish(ModbusResult::Timeout, 0);
+  }
+  if (_state == State::Done) {
+    _state = State::Idle;
+    if (_cb) _cb(_result, _exception, _ctx);
+  }
+}
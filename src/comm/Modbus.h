@@ -0,0 +1,156 @@
+// ============================================================================
+// File: src/comm/Modbus.h
+// ----------------------------------------------------------------------------
+// Purpose: Modbus RTU (Slave + Master) auf RS485Bus
+//  • Frame-Ende = RX-Timeout-Interrupt der UART (t3.5), kein Byte-Polling
+//  • Frames werden in-place im RX-Pool-Puffer von RS485Bus geparst, CRC16 per Tabelle
+//  • Registerkarten sind statische, nach Adresse sortierte Tabellen
+//    (Binärsuche), Schreibzugriffe optional mit onWrite-Hook
+//  • Slave antwortet direkt aus dem UART-Event-Task (kürzeste Turnaround-Zeit),
+//    Master meldet Ergebnisse in loop() (Loop-Kontext)
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include "RS485Bus.h"
+#include "../config/params.h"
+
+namespace modbus {
+
+static constexpr size_t MAX_ADU = 256;
+
+enum Function : uint8_t {
+  ReadHolding   = 0x03,
+  ReadInput     = 0x04,
+  WriteSingle   = 0x06,
+  WriteMultiple = 0x10
+};
+
+enum Exception : uint8_t {
+  None            = 0x00,
+  IllegalFunction = 0x01,
+  IllegalAddress  = 0x02,
+  IllegalValue    = 0x03,
+  DeviceFailure   = 0x04
+};
+
+uint16_t crc16(const uint8_t* data, size_t len);
+
+// Anzahl Zeichenzeiten für t3.5 (ab 19200 Baud fest 1750 µs laut Spezifikation)
+uint8_t gapSymbols(uint32_t baud);
+
+}  // namespace modbus
+
+struct ModbusReg {
+  uint16_t  addr;
+  uint16_t* value;
+  bool      writable;
+};
+
+// Tabellen müssen nach addr aufsteigend sortiert sein
+struct ModbusRegMap {
+  const ModbusReg* holding = nullptr;
+  size_t           holdingCount = 0;
+  const ModbusReg* input = nullptr;
+  size_t           inputCount = 0;
+  void (*onWrite)(uint16_t addr, uint16_t value, void* ctx) = nullptr;  // läuft im UART-Event-Task
+  void*            ctx = nullptr;
+};
+
+struct ModbusStats {
+  uint32_t frames = 0;        // gültige Frames (CRC ok)
+  uint32_t crcErrors = 0;
+  uint32_t exceptions = 0;    // gesendete bzw. empfangene Exception-Antworten
+  uint32_t ignored = 0;       // fremde Adresse / zu kurz / übergelaufen
+  uint32_t timeouts = 0;      // nur Master
+  uint32_t turnCount = 0;     // Turnaround: Slave Gap->Antwort gesendet, Master Request->Antwort
+  uint32_t turnLastUs = 0;
+  uint32_t turnMinUs = 0xFFFFFFFF;
+  uint32_t turnMaxUs = 0;
+  uint64_t turnSumUs = 0;
+
+  void addTurnaround(uint32_t us);
+  void print(Print& out, const char* tag) const;
+};
+
+class ModbusSlave {
+public:
+  bool begin(RS485Bus& bus, uint8_t id, const ModbusRegMap& map);
+  void end();
+  bool active() const { return _bus != nullptr; }
+  uint8_t id() const { return _id; }
+
+  const ModbusStats& stats() const { return _stats; }
+  void printStats(Print& out) const { _stats.print(out, "MB-SLAVE"); }
+
+private:
+  static void onFrame(const RS485Frame& f, void* ctx);
+  void handleFrame(size_t len);
+  size_t process(uint8_t fn, size_t len);
+  size_t exception(uint8_t fn, uint8_t code);
+
+  RS485Bus*    _bus = nullptr;
+  uint8_t      _id = 1;
+  ModbusRegMap _map;
+  ModbusStats  _stats;
+  const uint8_t* _rx = nullptr;        // aktueller Request (Puffer aus dem RX-Pool)
+  uint8_t      _tx[modbus::MAX_ADU];
+};
+
+enum class ModbusResult : uint8_t {
+  Ok = 0,
+  Timeout,
+  CrcError,
+  Exception,
+  BadResponse
+};
+
+// Completion: läuft in ModbusMaster::loop()
+using ModbusCallback = void (*)(ModbusResult r, uint8_t exceptionCode, void* ctx);
+
+class ModbusMaster {
+public:
+  bool begin(RS485Bus& bus);
+  void end();
+  bool active() const { return _bus != nullptr; }
+
+  // Funktion 0x03/0x04; dest muss count Register fassen
+  bool readRegisters(uint8_t slave, uint8_t function, uint16_t addr, uint16_t count,
+                     uint16_t* dest, ModbusCallback cb, void* ctx);
+  bool writeSingle(uint8_t slave, uint16_t addr, uint16_t value, ModbusCallback cb, void* ctx);
+  bool writeMultiple(uint8_t slave, uint16_t addr, const uint16_t* values, uint16_t count,
+                     ModbusCallback cb, void* ctx);
+
+  void loop();                // Timeout-Überwachung + Callbacks
+  bool busy() const { return _state != State::Idle; }
+
+  // true: Callback direkt bei Antwort (UART-Event-Task) bzw. Timeout (loop),
+  // damit ein Scheduler die nächste Anfrage ohne Loop-Umweg starten kann
+  void setDirectCompletion(bool on) { _direct = on; }
+
+  const ModbusStats& stats() const { return _stats; }
+  void printStats(Print& out) const { _stats.print(out, "MB-MASTER"); }
+
+private:
+  enum class State : uint8_t { Idle = 0, Waiting, Done };
+
+  bool send(size_t pduLen);
+  static void onFrame(const RS485Frame& f, void* ctx);
+  void handleResponse(size_t len);
+  void finish(ModbusResult r, uint8_t code);   // nur aus Waiting heraus
+
+  RS485Bus*      _bus = nullptr;
+  volatile State _state = State::Idle;
+  ModbusResult   _result = ModbusResult::Ok;
+  uint8_t        _exception = 0;
+  uint8_t        _slave = 0, _function = 0;
+  uint16_t       _count = 0;
+  uint16_t*      _dest = nullptr;
+  uint32_t       _sentUs = 0;
+  ModbusCallback _cb = nullptr;
+  void*          _ctx = nullptr;
+  bool           _direct = false;
+  ModbusStats    _stats;
+  portMUX_TYPE   _mux = portMUX_INITIALIZER_UNLOCKED;   // Gap-Task vs. loop()
+  const uint8_t* _rx = nullptr;       // aktuelle Antwort (Puffer aus dem RX-Pool)
+  uint8_t        _tx[modbus::MAX_ADU];
+};
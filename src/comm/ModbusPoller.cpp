@@ -0,0 +1,139 @@
+// ============================================================================
+// File: src/comm/ModbusPoller.cpp
+// ----------------------------------------------------------------------------
+#include "ModbusPoller.h"
+
+bool ModbusPoller::begin(ModbusMaster& master){
+  _master = &master;
+  _master->setDirectCompletion(true);
+  return true;
+}
+
+void ModbusPoller::end(){
+  stop();
+  if (_master) _master->setDirectCompletion(false);
+  _master = nullptr;
+}
+
+int ModbusPoller::deviceIndex(uint8_t slave){
+  for (size_t d = 0; d < _devCount; d++) if (_devIds[d] == slave) return (int)d;
+  if (_devCount >= MODBUS_POLL_MAX_DEVICES) return -1;
+  _devIds[_devCount] = slave;
+  return (int)_devCount++;
+}
+
+int ModbusPoller::add(uint8_t slave, uint8_t function, uint16_t addr, uint16_t count,
+                      uint16_t periodMs, uint8_t priority){
+  if (_running || _reqCount >= MODBUS_POLL_MAX || slave == 0) return -1;
+  if (function != modbus::ReadHolding && function != modbus::ReadInput) return -1;
+  if (count == 0 || count > MODBUS_POLL_MAX_REGS) return -1;
+  const int dev = deviceIndex(slave);
+  if (dev < 0) return -1;
+
+  PollEntry& e = _entries[_reqCount];
+  e = PollEntry{};
+  e.device   = (uint8_t)dev;
+  e.priority = priority;
+  e.periodMs = periodMs ? periodMs : 1;
+  _reqs[_reqCount] = Request{slave, function, addr, count};
+  memset(_values[_reqCount], 0, sizeof(_values[0]));
+  return (int)_reqCount++;
+}
+
+void ModbusPoller::clear(){
+  stop();
+  _reqCount = 0;
+  _devCount = 0;
+}
+
+void ModbusPoller::start(){
+  if (!_master || _reqCount == 0) return;
+  // Eine Antwort aus einem früheren Lauf kann noch eintreffen
+  portENTER_CRITICAL(&_mux);
+  _sched.init(_entries, _reqCount, _devStats, _devCount,
+              MODBUS_POLL_RETRIES, MODBUS_OFFLINE_AFTER, MODBUS_OFFLINE_BACKOFF);
+  _sched.start(millis());
+  _busyUs  = 0;
+  _polls   = 0;
+  _sinceUs = micros();
+  _inFlight = -1;
+  portEXIT_CRITICAL(&_mux);
+  _running = true;
+  kick();
+}
+
+void ModbusPoller::stop(){
+  _running = false;
+}
+
+// Nächste fällige Abfrage senden. Aufruf aus loop() oder direkt aus dem
+// Antwort-Callback; _inFlight stellt sicher, dass nur einer sendet.
+void ModbusPoller::kick(){
+  if (!_running) return;
+  int idx;
+  portENTER_CRITICAL(&_mux);
+  idx = (_inFlight < 0) ? _sched.next(millis()) : -1;
+  if (idx >= 0) {
+    _inFlight = idx;
+    _startUs  = micros();
+  }
+  portEXIT_CRITICAL(&_mux);
+  if (idx < 0) return;
+
+  const Request& r = _reqs[idx];
+  if (!_master->readRegisters(r.slave, r.function, r.addr, r.count, _values[idx], onResult, this)) {
+    portENTER_CRITICAL(&_mux);
+    if (_inFlight == idx) _inFlight = -1;   // Master belegt (z.B. Konsole) -> nächster Loop
+    portEXIT_CRITICAL(&_mux);
+  }
+}
+
+// Direkte Completion: UART-Event-Task (Antwort) oder loop() (Timeout)
+void ModbusPoller::onResult(ModbusResult r, uint8_t exc, void* ctx){
+  ModbusPoller* self = static_cast<ModbusPoller*>(ctx);
+  PollOutcome o = PollOutcome::Error;
+  if (r == ModbusResult::Ok)           o = PollOutcome::Ok;
+  else if (r == ModbusResult::Timeout) o = PollOutcome::Timeout;
+
+  portENTER_CRITICAL(&self->_mux);
+  const int idx = self->_inFlight;
+  if (idx >= 0) {
+    const uint32_t rtt = micros() - self->_startUs;
+    self->_busyUs += rtt;
+    self->_polls++;
+    self->_sched.complete(idx, o, rtt, millis());
+    self->_inFlight = -1;
+  }
+  portEXIT_CRITICAL(&self->_mux);
+  if (idx >= 0) self->kick();
+}
+
+void ModbusPoller::loop(){
+  if (!_master) return;
+  _master->loop();                  // Timeout-Erkennung
+  if (_running) kick();              // prüft _inFlight unter der Sperre
+}
+
+void ModbusPoller::printStats(Print& out) const {
+  portENTER_CRITICAL(&_mux);
+  const uint32_t el = micros() - _sinceUs, polls = _polls, busy = _busyUs;
+  portEXIT_CRITICAL(&_mux);
+  out.printf("[MB-POLL] %s, %u Abfragen, %u Polls, Bus belegt %.1f %%\n",
+             _running ? "läuft" : "gestoppt", (unsigned)_reqCount, polls,
+             el ? 100.0f * (float)busy / (float)el : 0.f);
+  for (size_t d = 0; d < _devCount; d++) {
+    portENTER_CRITICAL(&_mux);
+    const PollDeviceStats s = _devStats[d];
+    portEXIT_CRITICAL(&_mux);
+    out.printf("[MB-POLL] slave %3u: ok=%u to=%u err=%u retry=%u%s rtt last=%uus min=%uus avg=%uus max=%uus\n",
+               _devIds[d], s.ok, s.timeouts, s.errors, s.retries, s.offline ? " OFFLINE" : "",
+               s.rttLastUs, s.ok ? s.rttMinUs : 0u, s.rttAvgUs(), s.rttMaxUs);
+  }
+  for (size_t i = 0; i < _reqCount; i++) {
+    const Request& r = _reqs[i];
+    out.printf("[MB-POLL] #%u slave %u fn%u @%u x%u /%ums prio %u:", (unsigned)i, r.slave, r.function,
+               r.addr, r.count, _entries[i].periodMs, _entries[i].priority);
+    for (uint16_t k = 0; k < r.count; k++) out.printf(" %u", _values[i][k]);
+    out.println();
+  }
+}
@@ -0,0 +1,69 @@
+// ============================================================================
+// File: src/comm/ModbusPoller.h
+// ----------------------------------------------------------------------------
+// Purpose: Zyklisches Abfragen mehrerer Modbus-Slaves (Multi-Drop RS485)
+//  • Abfragetabelle mit Periode/Priorität je Eintrag (Plan: PollSchedule)
+//  • Nächste Abfrage startet direkt im Antwort-Callback (UART-Event-Task),
+//    nicht erst beim nächsten Loop-Durchlauf – die Leitung bleibt nur t3.5
+//    plus Slave-Antwortzeit frei
+//  • Timeouts/Wiederholungen/Offline-Erkennung, Round-Trip und Fehler je Gerät
+//  • Loop (Timeout, Anstoß) und UART-Event-Task (Antwort) teilen sich
+//    _inFlight, Zeiten, Zähler und den Plan: alle Zugriffe unter _mux, nur
+//    das Senden selbst läuft außerhalb
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include "Modbus.h"
+#include "PollSchedule.h"
+#include "../config/params.h"
+
+class ModbusPoller {
+public:
+  bool begin(ModbusMaster& master);
+  void end();
+
+  // Liefert den Index der Abfrage oder -1 (Tabelle voll / ungültig)
+  int  add(uint8_t slave, uint8_t function, uint16_t addr, uint16_t count,
+           uint16_t periodMs, uint8_t priority = 0);
+  void clear();
+
+  void start();
+  void stop();
+  bool running() const { return _running; }
+  void loop();                         // Timeouts + leere Leitung anstoßen
+
+  size_t count() const { return _sched.count(); }
+  const uint16_t* values(int idx) const { return _values[idx]; }
+  void printStats(Print& out) const;
+
+private:
+  struct Request {
+    uint8_t  slave;
+    uint8_t  function;
+    uint16_t addr;
+    uint16_t count;
+  };
+
+  static void onResult(ModbusResult r, uint8_t exc, void* ctx);
+  void kick();
+  int  deviceIndex(uint8_t slave);
+
+  ModbusMaster*   _master = nullptr;
+  PollSchedule    _sched;
+  PollEntry       _entries[MODBUS_POLL_MAX];
+  Request         _reqs[MODBUS_POLL_MAX];
+  uint16_t        _values[MODBUS_POLL_MAX][MODBUS_POLL_MAX_REGS];
+  PollDeviceStats _devStats[MODBUS_POLL_MAX_DEVICES];
+  uint8_t         _devIds[MODBUS_POLL_MAX_DEVICES];
+  size_t          _reqCount = 0;
+  size_t          _devCount = 0;
+
+  bool            _running = false;
+  // ---- unter _mux ----
+  int             _inFlight = -1;      // Loop und UART-Task konkurrieren um kick()
+  uint32_t        _startUs = 0;
+  uint32_t        _busyUs = 0;         // Summe Request->Antwort
+  uint32_t        _sinceUs = 0;
+  uint32_t        _polls = 0;
+  mutable portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+};
@@ -0,0 +1,96 @@
+// ============================================================================
+// File: src/comm/PollSchedule.cpp
+// ----------------------------------------------------------------------------
+#include "PollSchedule.h"
+
+static inline bool due(uint32_t nextDueMs, uint32_t nowMs){
+  return (int32_t)(nowMs - nextDueMs) >= 0;
+}
+
+void PollSchedule::init(PollEntry* entries, size_t count, PollDeviceStats* devices, size_t deviceCount,
+                        uint8_t maxRetries, uint8_t offlineAfter, uint8_t offlineBackoff){
+  _entries        = entries;
+  _count          = count;
+  _devices        = devices;
+  _deviceCount    = deviceCount;
+  _maxRetries     = maxRetries;
+  _offlineAfter   = offlineAfter;
+  _offlineBackoff = offlineBackoff ? offlineBackoff : 1;
+}
+
+void PollSchedule::start(uint32_t nowMs){
+  for (size_t i = 0; i < _count; i++) {
+    _entries[i].nextDueMs = nowMs + (uint32_t)i;   // feste Startreihenfolge
+    _entries[i].tries     = 0;
+  }
+  for (size_t d = 0; d < _deviceCount; d++) _devices[d] = PollDeviceStats{};
+}
+
+// Priorität + Anzahl verpasster Perioden (Aging)
+static inline uint32_t effectivePriority(const PollEntry& e, uint32_t nowMs){
+  return e.priority + (nowMs - e.nextDueMs) / e.periodMs;
+}
+
+int PollSchedule::next(uint32_t nowMs) const {
+  int best = -1;
+  uint32_t bestPrio = 0;
+  for (size_t i = 0; i < _count; i++) {
+    const PollEntry& e = _entries[i];
+    if (!due(e.nextDueMs, nowMs)) continue;
+    const uint32_t p = effectivePriority(e, nowMs);
+    if (best < 0 || p > bestPrio ||
+        (p == bestPrio && (int32_t)(e.nextDueMs - _entries[best].nextDueMs) < 0)) {
+      best = (int)i;
+      bestPrio = p;
+    }
+  }
+  return best;
+}
+
+void PollSchedule::complete(int idx, PollOutcome r, uint32_t rttUs, uint32_t nowMs){
+  if (idx < 0 || (size_t)idx >= _count) return;
+  PollEntry& e = _entries[idx];
+  PollDeviceStats* d = e.device < _deviceCount ? &_devices[e.device] : nullptr;
+
+  if (r == PollOutcome::Ok) {
+    if (d) {
+      d->ok++;
+      d->failStreak = 0;
+      d->offline    = false;
+      d->rttLastUs  = rttUs;
+      d->rttSumUs  += rttUs;
+      if (rttUs < d->rttMinUs) d->rttMinUs = rttUs;
+      if (rttUs > d->rttMaxUs) d->rttMaxUs = rttUs;
+    }
+    e.tries = 0;
+    // Im Takt bleiben; wer mehr als eine Periode hinterher ist, setzt neu auf
+    e.nextDueMs += e.periodMs;
+    if (due(e.nextDueMs, nowMs)) e.nextDueMs = nowMs + e.periodMs;
+    return;
+  }
+
+  if (d) {
+    if (r == PollOutcome::Timeout) d->timeouts++; else d->errors++;
+    if (d->failStreak < UINT16_MAX) d->failStreak++;
+    if (d->failStreak >= _offlineAfter) d->offline = true;
+  }
+  // Offline-Geräte nicht wiederholen – jeder Timeout kostet die volle Wartezeit
+  if (e.tries < _maxRetries && !(d && d->offline)) {
+    e.tries++;
+    if (d) d->retries++;
+    return;                                  // bleibt fällig -> sofort erneut
+  }
+  e.tries = 0;
+  const uint32_t period = (uint32_t)e.periodMs * ((d && d->offline) ? _offlineBackoff : 1);
+  e.nextDueMs = nowMs + period;
+}
+
+uint32_t PollSchedule::msUntilDue(uint32_t nowMs) const {
+  uint32_t best = UINT32_MAX;
+  for (size_t i = 0; i < _count; i++) {
+    int32_t dt = (int32_t)(_entries[i].nextDueMs - nowMs);
+    uint32_t w = dt > 0 ? (uint32_t)dt : 0;
+    if (w < best) best = w;
+  }
+  return best;
+}
@@ -0,0 +1,68 @@
+// ============================================================================
+// File: src/comm/PollSchedule.h
+// ----------------------------------------------------------------------------
+// Purpose: Abfrageplan für einen RS485-Bus-Master mit mehreren Slaves
+//  • Jede Abfrage hat Periode und Priorität; fällig ist sie ab nextDueMs
+//  • next(): unter allen fälligen die höchste effektive Priorität, bei
+//    Gleichstand die am längsten fällige (= Round-Robin). Jede verpasste
+//    Periode hebt die Priorität um 1 – ein überlasteter Bus hungert
+//    niedrige Prioritäten so nicht aus
+//  • Fehlversuche werden sofort wiederholt (maxRetries), danach wartet die
+//    Abfrage bis zur nächsten Periode; Geräte mit vielen Fehlern in Folge
+//    gelten als offline und werden nur noch mit offlineBackoff-facher
+//    Periode angefragt
+//  • Plattformneutral: Bus-Simulation in tools/rs485_poll_sim.cpp
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+struct PollEntry {
+  uint8_t  device = 0;         // Index in die Geräteliste
+  uint8_t  priority = 0;       // höher = wichtiger
+  uint16_t periodMs = 1000;
+  uint32_t nextDueMs = 0;
+  uint8_t  tries = 0;          // Fehlversuche in Folge
+};
+
+// Round-Trip in µs, Fehler je Gerät
+struct PollDeviceStats {
+  uint32_t ok = 0;
+  uint32_t timeouts = 0;
+  uint32_t errors = 0;         // CRC, Exception, unpassende Antwort
+  uint32_t retries = 0;
+  uint16_t failStreak = 0;
+  bool     offline = false;
+  uint32_t rttLastUs = 0;
+  uint32_t rttMinUs = UINT32_MAX;
+  uint32_t rttMaxUs = 0;
+  uint64_t rttSumUs = 0;
+
+  uint32_t rttAvgUs() const { return ok ? (uint32_t)(rttSumUs / ok) : 0; }
+};
+
+enum class PollOutcome : uint8_t { Ok = 0, Timeout, Error };
+
+class PollSchedule {
+public:
+  void init(PollEntry* entries, size_t count, PollDeviceStats* devices, size_t deviceCount,
+            uint8_t maxRetries, uint8_t offlineAfter, uint8_t offlineBackoff);
+  void start(uint32_t nowMs);            // alle sofort fällig, leicht gestaffelt
+
+  int  next(uint32_t nowMs) const;       // Index der nächsten Abfrage oder -1
+  void complete(int idx, PollOutcome r, uint32_t rttUs, uint32_t nowMs);
+  uint32_t msUntilDue(uint32_t nowMs) const;
+
+  size_t count() const { return _count; }
+  const PollEntry& entry(size_t i) const { return _entries[i]; }
+  const PollDeviceStats& device(size_t i) const { return _devices[i]; }
+
+private:
+  PollEntry*       _entries = nullptr;
+  size_t           _count = 0;
+  PollDeviceStats* _devices = nullptr;
+  size_t           _deviceCount = 0;
+  uint8_t          _maxRetries = 1;
+  uint8_t          _offlineAfter = 3;
+  uint8_t          _offlineBackoff = 10;
+};
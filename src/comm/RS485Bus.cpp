@@ -2,29 +2,317 @@
 // File: src/comm/RS485Bus.cpp
 // ----------------------------------------------------------------------------
 #include "RS485Bus.h"
+#include <driver/uart.h>
+#include "../core/Profiler.h"
+#include "../core/StallMonitor.h"
 
 bool RS485Bus::begin(uint32_t baud, uint32_t config){
-  pinMode(PIN_RS485_DE, OUTPUT);
-  setTxMode(false);
-  _ser.begin((unsigned long)baud, (uint32_t)config, PIN_RS485_RX, PIN_RS485_TX);
+  _baud   = baud;
+  _config = config;
+  if (!_freeQ) {
+    _freeQ  = xQueueCreate(RS485_RX_POOL, sizeof(RS485Frame*));
+    _readyQ = xQueueCreate(RS485_RX_POOL, sizeof(RS485Frame*));
+    if (!_freeQ || !_readyQ) return false;
+    for (auto& f : _pool) { RS485Frame* p = &f; xQueueSend(_freeQ, &p, 0); }
+  }
+  resetRxStats();
+  startUart();
+  applyFraming();
   return true;
 }
 
 void RS485Bus::setBaud(uint32_t baud, uint32_t config){
-  _ser.updateBaudRate((unsigned long)baud);
+  _baud   = baud;
+  _config = config;
   // Falls Config wechseln soll: neu starten
   _ser.end();
-  _ser.begin((unsigned long)baud, (uint32_t)config, PIN_RS485_RX, PIN_RS485_TX);
+  startUart();
+  applyFraming();
+}
+
+// TX-Ring muss vor begin() gesetzt sein; RTS/Modus erst nach begin()
+void RS485Bus::startUart(){
+  _txDoneSeq.store(_txSeq.load());
+  _ser.setTxBufferSize(RS485_TX_RING_BYTES);
+  _ser.setRxBufferSize(RS485_RX_RING_BYTES);
+  if (_hwDir) {
+    _ser.begin((unsigned long)_baud, _config, PIN_RS485_RX, PIN_RS485_TX);
+    _ser.setPins(-1, -1, -1, PIN_RS485_DE);     // RTS -> DE (HIGH während TX)
+    if (!_ser.setMode(UART_MODE_RS485_HALF_DUPLEX)) {
+      Serial.println("[RS485] HW-Halbduplex nicht verfügbar -> GPIO-DE");
+      _hwDir = false;
+    }
+  } else {
+    _ser.begin((unsigned long)_baud, _config, PIN_RS485_RX, PIN_RS485_TX);
+  }
+  if (!_hwDir) {
+    pinMode(PIN_RS485_DE, OUTPUT);            // löst auch die RTS-Zuordnung
+    setTxMode(false);
+  }
+}
+
+void RS485Bus::setHwDirection(bool hw){
+  if (hw == _hwDir) return;
+  _hwDir = hw;
+  _ser.end();
+  startUart();
+  applyFraming();
+}
+
+// ---------------------------- RX ---------------------------------------------
+void RS485Bus::setFraming(RS485Framing mode, uint8_t param, FrameHandler h, void* ctx){
+  _ser.onReceive(nullptr);            // Event-Task ruft uns nicht mehr
+  dropFrame();
+  RS485Frame* f;
+  while (_readyQ && xQueueReceive(_readyQ, &f, 0) == pdTRUE) release(f);
+  _framing      = mode;
+  _framingParam = param;
+  _frameHandler = h;
+  _frameCtx     = ctx;
+  applyFraming();
+}
+
+void RS485Bus::setGap(uint8_t symbols){
+  if (_framing != RS485Framing::Gap) return;
+  _framingParam = symbols;
+  _ser.setRxTimeout(symbols);
+}
+
+// Gap: Callback nur bei RX-Timeout (= Frame-Ende). Trennzeichen: auch bei
+// FIFO-Schwelle, damit lange Zeilen den Treiber-Ring nicht füllen.
+// Nach jedem (Neu-)Start der UART: end() löscht beide Callbacks
+void RS485Bus::applyFraming(){
+  if (!_freeQ) return;
+  const bool gap = (_framing == RS485Framing::Gap);
+  _ser.setRxTimeout(gap ? _framingParam : RS485_RX_TIMEOUT_SYMBOLS);
+  _ser.onReceive([this](){ onRxEvent(); }, gap);
+  _ser.onReceiveError([this](hardwareSerial_error_t e){
+    if (e == UART_BUFFER_FULL_ERROR || e == UART_FIFO_OVF_ERROR) _rxStats.uartOverflows++;
+  });
+}
+
+bool RS485Bus::openFrame(){
+  if (_cur) return true;
+  if (xQueueReceive(_freeQ, &_cur, 0) != pdTRUE) { _cur = nullptr; return false; }
+  _cur->len   = 0;
+  _cur->flags = 0;
+  return true;
+}
+
+void RS485Bus::closeFrame(){
+  if (!_cur) return;
+  RS485Frame* f = _cur;
+  _cur = nullptr;
+  f->rxUs = micros();
+  _rxStats.frames++;
+  if (_frameHandler) {
+    _frameHandler(*f, _frameCtx);
+    xQueueSend(_freeQ, &f, 0);
+  } else {
+    xQueueSend(_readyQ, &f, 0);       // Pool == Queue-Tiefe: kann nicht voll sein
+  }
+}
+
+void RS485Bus::dropFrame(){
+  if (_cur) { xQueueSend(_freeQ, &_cur, 0); _cur = nullptr; }
+  _discarding = false;
+}
+
+// UART-Event-Task: Treiber-Ring in Blöcken leeren und in Frames zerlegen
+void RS485Bus::onRxEvent(){
+  PROF_ZONE(ProfZone::Rs485Rx);
+  uint8_t chunk[128];
+  size_t n;
+  while ((n = _ser.read(chunk, sizeof(chunk))) > 0) {
+    _rxStats.bytes += n;
+    if (_framing == RS485Framing::Off) continue;
+
+    size_t i = 0;
+    while (i < n) {
+      size_t take = n - i;
+      bool   end  = false;
+      if (_framing == RS485Framing::Delimiter) {
+        const uint8_t* d = (const uint8_t*)memchr(chunk + i, _framingParam, take);
+        if (d) { take = (size_t)(d - (chunk + i)) + 1; end = true; }
+      }
+      if (!_discarding && !openFrame()) _discarding = true;
+      if (_discarding) {
+        _rxStats.droppedBytes += take;
+      } else {
+        const size_t room = RS485_FRAME_BYTES - _cur->len;
+        const size_t copy = take < room ? take : room;
+        memcpy(_cur->data + _cur->len, chunk + i, copy);
+        _cur->len += copy;
+        if (copy < take) {
+          if (!(_cur->flags & RS485Frame::Truncated)) _rxStats.truncated++;
+          _cur->flags |= RS485Frame::Truncated;
+          _rxStats.droppedBytes += take - copy;
+        }
+      }
+      if (end) {
+        if (_discarding) _discarding = false;
+        else closeFrame();
+      }
+      i += take;
+    }
+  }
+  // Gap-Modus: dieser Callback kommt nur nach der Ruhezeit -> Frame fertig
+  if (_framing == RS485Framing::Gap) {
+    if (_discarding) _discarding = false;
+    else closeFrame();
+  }
+}
+
+RS485Frame* RS485Bus::receive(){
+  RS485Frame* f = nullptr;
+  if (!_readyQ || xQueueReceive(_readyQ, &f, 0) != pdTRUE) return nullptr;
+  return f;
+}
+
+void RS485Bus::release(RS485Frame* f){
+  if (f) xQueueSend(_freeQ, &f, 0);
+}
+
+void RS485Bus::resetRxStats(){
+  _rxStats = RS485RxStats{};
+  _rxStats.sinceMs = millis();
+}
+
+void RS485RxStats::print(Print& out) const {
+  const uint32_t ms = millis() - sinceMs;
+  out.printf("[RS485] RX bytes=%u (%u B/s) frames=%u dropped=%u truncated=%u uartOvf=%u\n",
+             bytes, ms ? (uint32_t)((uint64_t)bytes * 1000 / ms) : 0u, frames,
+             droppedBytes, truncated, uartOverflows);
 }
 
 void RS485Bus::setTxMode(bool on){
   digitalWrite(PIN_RS485_DE, on ? HIGH : LOW);
 }
 
+// Sollzeit für len Zeichen: Start + Daten + Parität + Stopp aus _config
+// (Arduino-ESP32-Kodierung: Bit 0-1 Parität, 2-3 Datenbits - 5, 4-5 Stopp
+// 1 / 1,5 / 2), in halben Bits wegen 1,5 Stoppbits
+uint32_t RS485Bus::frameUs(size_t len) const {
+  if (!_baud) return 0;
+  static constexpr uint8_t STOP_HALF[4] = {2, 2, 3, 4};
+  const uint32_t halfBits = 2u * (1u + 5u + ((_config >> 2) & 3u) + ((_config & 3u) ? 1u : 0u)) +
+                            STOP_HALF[(_config >> 4) & 3u];
+  return (uint32_t)(((uint64_t)len * halfBits * 1000000u) / (2u * _baud));
+}
+
 size_t RS485Bus::write(const uint8_t* data, size_t len){
-  setTxMode(true);
-  size_t w = _ser.write(data, len);
-  _ser.flush();
-  setTxMode(false);
+  if (len == 0) return 0;
+  PROF_ZONE(ProfZone::Rs485Write);
+  BLOCKING_SCOPE(BlockSite::Rs485Write);
+  const uint32_t t0 = micros();
+  size_t w = 0;
+
+  if (_hwDir) {
+    // Nur ganze Frames einreihen – ein halber Modbus-Frame ist wertlos
+    if ((size_t)_ser.availableForWrite() < len) {
+      _txStats.rejected++;
+      return 0;
+    }
+    // Kette: liegt noch eine Sendung an, endet die neue entsprechend später
+    const uint32_t start = (txBusy() && (int32_t)(_txEndUs - t0) > 0) ? _txEndUs : t0;
+    w = _ser.write(data, len);
+    _txEndUs = start + frameUs(w);
+    _txSeq.fetch_add(1, std::memory_order_release);   // nach den Bytes im Ring
+  } else {
+    // Referenz: blockiert bis das letzte Bit draußen ist
+    setTxMode(true);
+    w = _ser.write(data, len);
+    _ser.flush();
+    setTxMode(false);
+    _txEndUs = t0 + frameUs(w);
+    noteTail(micros());
+  }
+
+  const uint32_t stall = micros() - t0;
+  _txStats.frames++;
+  _txStats.bytes      += w;
+  _txStats.stallLastUs = stall;
+  _txStats.stallSumUs += stall;
+  if (stall > _txStats.stallMaxUs) _txStats.stallMaxUs = stall;
   return w;
-}
\ No newline at end of file
+}
+
+void RS485Bus::noteTail(uint32_t doneUs){
+  int32_t tail = (int32_t)(doneUs - _txEndUs);
+  uint32_t t = tail > 0 ? (uint32_t)tail : 0;
+  _txStats.tailCount++;
+  _txStats.tailSumUs += t;
+  if (t < _txStats.tailMinUs) _txStats.tailMinUs = t;
+  if (t > _txStats.tailMaxUs) _txStats.tailMaxUs = t;
+}
+
+// Nicht-blockierend: uart_wait_tx_done mit 0 Ticks ist ein reiner Statuscheck
+void RS485Bus::loop(){
+  // Stand vor der Prüfung: was danach eingereiht wird, bleibt offen
+  const uint32_t seq = _txSeq.load(std::memory_order_acquire);
+  if (seq == _txDoneSeq.load(std::memory_order_relaxed)) return;
+  if (uart_wait_tx_done((uart_port_t)_port, 0) != ESP_OK) return;
+  const uint32_t now = micros();
+  _txDoneSeq.store(seq, std::memory_order_release);
+
+  bool coll = false;
+  uart_get_collision_flag((uart_port_t)_port, &coll);
+  _lastCollision = coll;
+  if (coll) _txStats.collisions++;
+  noteTail(now);
+  if (_txDone) _txDone(coll, _txDoneCtx);
+}
+
+void RS485TxStats::print(Print& out, bool hwDirection) const {
+  out.printf("[RS485] DE=%s frames=%u bytes=%u rejected=%u collisions=%u\n",
+             hwDirection ? "UART-RTS" : "GPIO+flush", frames, bytes, rejected, collisions);
+  out.printf("[RS485] write() stall last=%uus avg=%uus max=%uus\n",
+             stallLastUs, frames ? (uint32_t)(stallSumUs / frames) : 0u, stallMaxUs);
+  out.printf("[RS485] tail n=%u min=%uus avg=%uus max=%uus\n",
+             tailCount, tailCount ? tailMinUs : 0u,
+             tailCount ? (uint32_t)(tailSumUs / tailCount) : 0u, tailMaxUs);
+}
+
+// ---------------------------- Konsole ---------------------------------------
+static constexpr cmd::Command RS485_CMDS[] = {
+  {"rs485 reset", "", "", [](void* c, const cmd::Args&){
+    RS485Bus& bus = *static_cast<RS485Bus*>(c);
+    bus.resetTxStats();
+    bus.resetRxStats();
+    Serial.println("[RS485] Statistik zurückgesetzt");
+  }},
+  {"rs485 stats", "", "", [](void* c, const cmd::Args&){
+    RS485Bus& bus = *static_cast<RS485Bus*>(c);
+    bus.txStats().print(Serial, bus.hwDirection());
+    bus.rxStats().print(Serial);
+  }},
+  {"rs485de", "w", "hw|sw", [](void* c, const cmd::Args& a){
+    RS485Bus& bus = *static_cast<RS485Bus*>(c);
+    const bool hw = !strcmp(a.s(0), "hw");
+    if (!hw && strcmp(a.s(0), "sw")) { Serial.println("[RS485] rs485de hw|sw"); return; }
+    bus.setHwDirection(hw);
+    bus.resetTxStats();
+    Serial.printf("[RS485] DE-Steuerung: %s\n", bus.hwDirection() ? "UART-RTS" : "GPIO+flush");
+  }},
+  {"rs485send", "r", "<text>", [](void* c, const cmd::Args& a){
+    RS485Bus& bus = *static_cast<RS485Bus*>(c);
+    const char* text = a.s(0);
+    // Text und Zeilenende in einem write(): sonst zwei Frames auf dem Bus
+    static char line[CONSOLE_LINE_BYTES + 2];
+    size_t n = strlen(text);
+    if (n > CONSOLE_LINE_BYTES) n = CONSOLE_LINE_BYTES;
+    memcpy(line, text, n);
+    line[n++] = '\r';
+    line[n++] = '\n';
+    if (bus.write((const uint8_t*)line, n) != n) {
+      Serial.println("[RS485] TX-Ring voll");
+      return;
+    }
+    Serial.printf("[RS485] TX: %s\n", text);
+  }},
+};
+static_assert(cmd::sorted(RS485_CMDS), "RS485_CMDS nicht sortiert");
+
+void RS485Bus::registerCommands(cmd::Registry& r){
+  r.add(RS485_CMDS, this, "rs485");
+}
@@ -4,10 +4,72 @@
 #pragma once
 #include <Arduino.h>
 #include <HardwareSerial.h>
+#include <atomic>
 #include "../config/pins.h"
+#include "../config/params.h"
+#include "CommandTable.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 
 // Einfaches, halbduplexes RS485-Modul für MAX3485/compatible Transceiver
 // DE und /RE sind meist gebrückt und aktiv HIGH für TX.
+//
+// TX ist nicht-blockierend: write() kopiert in den TX-Ring des UART-Treibers
+// und kehrt sofort zurück. Im Hardware-Modus (UART_MODE_RS485_HALF_DUPLEX)
+// treibt der UART DE über seinen RTS-Ausgang und gibt die Leitung im
+// TX_DONE-Interrupt frei – kein flush() im Loop mehr.
+// Der alte Software-Modus (DE per GPIO + flush) bleibt zum Vergleich
+// umschaltbar (setHwDirection(false)).
+//
+// RX läuft komplett im UART-Event-Task: Frames werden per RX-Timeout (Gap)
+// oder Trennzeichen abgegrenzt und landen in einem Pool fester Puffer.
+// Verbraucher bekommen den Puffer per Zeiger (receive()/release()) oder
+// direkt im Event-Task über einen FrameHandler – ohne Heap, ohne Byte-Polling.
+
+// Statistik für "rs485 stats" (µs)
+struct RS485TxStats {
+  uint32_t frames = 0;
+  uint32_t bytes = 0;
+  uint32_t rejected = 0;     // TX-Ring voll -> Frame verworfen
+  uint32_t collisions = 0;   // Kollisionsflag des UART (nur HW-Modus)
+  // Loop-Blockade: Dauer des write()-Aufrufs
+  uint32_t stallLastUs = 0;
+  uint32_t stallMaxUs = 0;
+  uint64_t stallSumUs = 0;
+  // Nachlauf nach dem letzten Stoppbit (Ende erkannt - Sollende)
+  uint32_t tailCount = 0;
+  uint32_t tailMinUs = UINT32_MAX;
+  uint32_t tailMaxUs = 0;
+  uint64_t tailSumUs = 0;
+
+  void print(Print& out, bool hwDirection) const;
+};
+
+struct RS485RxStats {
+  uint32_t bytes = 0;          // angenommene Bytes
+  uint32_t frames = 0;
+  uint32_t droppedBytes = 0;   // kein freier Puffer
+  uint32_t truncated = 0;      // Frame länger als RS485_FRAME_BYTES
+  uint32_t uartOverflows = 0;  // FIFO/Ring des Treibers übergelaufen
+  uint32_t sinceMs = 0;        // Bezug für Bytes/s
+
+  void print(Print& out) const;
+};
+
+// Fester Puffer aus dem RX-Pool
+struct RS485Frame {
+  enum : uint8_t { Truncated = 0x01 };
+  uint16_t len = 0;
+  uint8_t  flags = 0;
+  uint32_t rxUs = 0;           // micros() bei Frame-Ende
+  uint8_t  data[RS485_FRAME_BYTES];
+};
+
+enum class RS485Framing : uint8_t {
+  Off = 0,     // RX verwerfen
+  Gap,         // Frame-Ende = N Zeichenzeiten Ruhe (Modbus t3.5)
+  Delimiter,   // Frame-Ende = Trennzeichen (inkl.), z.B. '\n'
+};
 
 #ifndef PIN_RS485_TX
   #define PIN_RS485_TX 15
@@ -24,14 +86,84 @@
 
 class RS485Bus {
 public:
+  // Läuft im UART-Event-Task; der Puffer geht danach automatisch zurück
+  using FrameHandler = void (*)(const RS485Frame& f, void* ctx);
+  // Sendung fertig (letztes Bit draußen, DE wieder LOW); läuft in loop()
+  using TxDoneHandler = void (*)(bool collision, void* ctx);
+
+  // port: UART des Transceivers (Host-Tests: zwei Busse über sim::uartLink)
+  explicit RS485Bus(uint8_t port = RS485_UART_PORT) : _port(port), _ser(port) {}
+
   bool begin(uint32_t baud = 115200, uint32_t config = SERIAL_8N1);
+  // Liefert 0, wenn der Frame nicht komplett in den TX-Ring passt
   size_t write(const uint8_t* data, size_t len);
-  size_t write(const String& s){ return write((const uint8_t*)s.c_str(), s.length()); }
   int available() { return _ser.available(); }
   int read() { return _ser.read(); }
+  size_t readBytes(uint8_t* buf, size_t n) { return _ser.read(buf, n); }
   void flush() { _ser.flush(); }
+  void loop();                       // TX-Fertigmeldung pollen
+  bool txBusy() const { return _txSeq.load() != _txDoneSeq.load(); }
+  bool lastCollision() const { return _lastCollision; }
+  void onTxDone(TxDoneHandler h, void* ctx){ _txDone = h; _txDoneCtx = ctx; }
+
+  void setHwDirection(bool hw);
+  bool hwDirection() const { return _hwDir; }
+  const RS485TxStats& txStats() const { return _txStats; }
+  void resetTxStats() { _txStats = RS485TxStats{}; }
   void setBaud(uint32_t baud, uint32_t config = SERIAL_8N1);
+  uint32_t baud() const { return _baud; }
+
+  // param = Gap in Zeichenzeiten bzw. Trennzeichen. Ohne Handler landen
+  // fertige Frames in der Queue für receive().
+  void setFraming(RS485Framing mode, uint8_t param, FrameHandler h = nullptr, void* ctx = nullptr);
+  // Nur bei Gap-Framing: Gap (RX-Timeout) nachführen, z.B. nach setBaud();
+  // Handler, Queues und laufender Betrieb bleiben unberührt
+  void setGap(uint8_t symbols);
+  RS485Frame* receive();             // nächster fertiger Frame oder nullptr
+  void release(RS485Frame* f);
+  const RS485RxStats& rxStats() const { return _rxStats; }
+  void resetRxStats();
+
+  // rs485send, rs485de, rs485 stats|reset
+  void registerCommands(cmd::Registry& r);
 private:
   void setTxMode(bool on);
-  HardwareSerial _ser{RS485_UART_PORT};
+  void startUart();
+  void applyFraming();
+  void onRxEvent();
+  bool openFrame();
+  void closeFrame();
+  void dropFrame();
+  void noteTail(uint32_t doneUs);
+  uint32_t frameUs(size_t len) const;
+  uint8_t    _port;
+  HardwareSerial _ser;
+  uint32_t   _baud = 0;
+  uint32_t   _config = SERIAL_8N1;
+  bool       _hwDir = RS485_HW_DIRECTION;
+
+  // Laufende Sendung: write() (Loop oder Modbus-Slave im UART-Event-Task)
+  // zählt _txSeq hoch, loop() meldet bis zum vorher gelesenen Stand fertig.
+  // Ein write() zwischen Prüfung und Meldung bleibt so offen (kein Flag,
+  // das der Loop einer neuen Sendung wegnimmt)
+  std::atomic<uint32_t> _txSeq{0};
+  std::atomic<uint32_t> _txDoneSeq{0};
+  bool       _lastCollision = false;
+  uint32_t   _txEndUs = 0;         // Sollende der zuletzt eingereihten Bytes
+  TxDoneHandler _txDone = nullptr;
+  void*      _txDoneCtx = nullptr;
+  RS485TxStats _txStats;
+
+
+  // RX-Pool: _freeQ/_readyQ halten Zeiger in _pool, _cur wird gerade gefüllt
+  RS485Framing  _framing = RS485Framing::Off;
+  uint8_t       _framingParam = 0;
+  FrameHandler  _frameHandler = nullptr;
+  void*         _frameCtx = nullptr;
+  RS485Frame    _pool[RS485_RX_POOL];
+  QueueHandle_t _freeQ = nullptr;
+  QueueHandle_t _readyQ = nullptr;
+  RS485Frame*   _cur = nullptr;
+  bool          _discarding = false;   // kein Puffer frei: bis Frame-Ende verwerfen
+  RS485RxStats  _rxStats;
 };
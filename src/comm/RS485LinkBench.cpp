@@ -0,0 +1,83 @@
+// ============================================================================
+// File: src/comm/RS485LinkBench.cpp
+// ----------------------------------------------------------------------------
+#include "RS485LinkBench.h"
+
+bool RS485BenchTransport::send(const uint8_t* data, size_t len){
+  return _bus->write(data, len) == len;
+}
+
+size_t RS485BenchTransport::receive(uint8_t* buf, size_t cap){
+  RS485Frame* f;
+  while ((f = _bus->receive()) != nullptr) {
+    size_t n = f->len;
+    if (n && f->data[n - 1] == 0x00) n--;          // Trenner abschneiden
+    const bool ok = n > 0 && n <= cap && !(f->flags & RS485Frame::Truncated);
+    if (ok) memcpy(buf, f->data, n);
+    _bus->release(f);
+    if (ok) return n;
+  }
+  return 0;
+}
+
+void RS485BenchTransport::setBaud(uint32_t baud){
+  if (_bus->baud() == baud) return;
+  _bus->setBaud(baud);
+  _bus->setFraming(RS485Framing::Delimiter, 0x00);
+}
+
+void RS485LinkBench::begin(RS485Bus& bus){
+  _bus = &bus;
+  _transport.begin(bus);
+  _bus->setFraming(RS485Framing::Delimiter, 0x00);
+}
+
+void RS485LinkBench::end(){
+  if (_mode == Mode::Master) _master.stop();
+  _mode = Mode::Off;
+}
+
+void RS485LinkBench::logLine(const char* line, void*){
+  Serial.printf("[BENCH] %s\n", line);
+}
+
+void RS485LinkBench::startPeer(){
+  if (!_bus) return;
+  if (_mode == Mode::Master) _master.stop();
+  _peer.begin(_transport, _bus->baud());
+  _mode = Mode::Peer;
+  Serial.printf("[BENCH] Peer aktiv, %u Bd\n", (unsigned)_bus->baud());
+}
+
+bool RS485LinkBench::run(uint32_t maxBaud){
+  if (!_bus || _mode == Mode::Master) return false;
+  LinkBenchConfig cfg;
+  cfg.baseBaud = _bus->baud();
+  if (maxBaud) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < cfg.baudCount; i++) {
+      if (cfg.bauds[i] <= maxBaud) cfg.bauds[n++] = cfg.bauds[i];
+    }
+    cfg.baudCount = n;
+  }
+  _master.begin(_transport, logLine, nullptr);
+  if (!_master.start(cfg)) return false;
+  _mode = Mode::Master;
+  return true;
+}
+
+void RS485LinkBench::stop(){
+  if (_mode == Mode::Master) _master.stop();
+  _mode = Mode::Off;
+}
+
+void RS485LinkBench::loop(){
+  if (_mode == Mode::Peer) {
+    _peer.poll();
+  } else if (_mode == Mode::Master) {
+    _master.poll();
+    if (!_master.running()) _mode = Mode::Off;
+  } else if (_bus) {
+    while (RS485Frame* f = _bus->receive()) _bus->release(f);   // Nachzügler verwerfen
+  }
+}
@@ -0,0 +1,45 @@
+// ============================================================================
+// File: src/comm/RS485LinkBench.h
+// ----------------------------------------------------------------------------
+// Purpose: Streckentest (LinkBench.h) auf RS485Bus
+//  • Transport: TX-Ring von RS485Bus, RX-Pool mit 0x00 als Trenner
+//  • Master ("rs485bench run") oder Peer ("rs485bench peer"), Ausgabe "[BENCH]"
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include "RS485Bus.h"
+#include "LinkBench.h"
+
+class RS485BenchTransport : public BenchTransport {
+public:
+  void begin(RS485Bus& bus){ _bus = &bus; }
+  bool     send(const uint8_t* data, size_t len) override;
+  size_t   receive(uint8_t* buf, size_t cap) override;
+  bool     txIdle() override { return !_bus->txBusy(); }
+  void     setBaud(uint32_t baud) override;
+  uint32_t nowUs() override { return micros(); }
+private:
+  RS485Bus* _bus = nullptr;
+};
+
+class RS485LinkBench {
+public:
+  void begin(RS485Bus& bus);
+  void end();
+  bool active() const { return _mode != Mode::Off; }
+
+  void startPeer();
+  bool run(uint32_t maxBaud = 0);       // 0 = alle Standard-Baudraten
+  void stop();
+  void loop();
+
+private:
+  enum class Mode : uint8_t { Off, Peer, Master };
+  static void logLine(const char* line, void* ctx);
+
+  RS485Bus*           _bus = nullptr;
+  RS485BenchTransport _transport;
+  LinkBench           _master;
+  LinkBenchPeer       _peer;
+  Mode                _mode = Mode::Off;
+};
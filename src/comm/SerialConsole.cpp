@@ -0,0 +1,60 @@
+// ============================================================================
+// File: src/comm/SerialConsole.cpp
+// ----------------------------------------------------------------------------
+#include "SerialConsole.h"
+#include "../core/Profiler.h"
+#include "../core/StallMonitor.h"
+#include "../core/HeapGuard.h"
+
+static void cmdHelp(void* ctx, const cmd::Args&){
+  static_cast<cmd::Registry*>(ctx)->help([](const char* line, void*){ Serial.println(line); }, nullptr);
+}
+
+static constexpr cmd::Command CONSOLE_CMDS[] = {
+  {"help", "", "", cmdHelp},
+};
+static_assert(cmd::sorted(CONSOLE_CMDS), "CONSOLE_CMDS nicht sortiert");
+
+void SerialConsole::begin(uint32_t baud){
+  Serial.begin(baud);
+  _cmds.add(CONSOLE_CMDS, &_cmds, "console");
+}
+
+void SerialConsole::loop(){
+  while (Serial.available()) {
+    const char c = (char)Serial.read();
+    if (c == '\r') continue;               // CR ignorieren (CRLF)
+    if (c == '\n') {                       // LF = Zeilenende
+      if (_overflow) {
+        Serial.printf("[CON] Zeile zu lang (max %u Zeichen), verworfen\n", (unsigned)(CONSOLE_LINE_BYTES - 1));
+      } else {
+        _line[_len] = '\0';
+        execute();
+      }
+      _len = 0;
+      _overflow = false;
+    } else if (_len < CONSOLE_LINE_BYTES - 1) {
+      _line[_len++] = c;
+    } else {
+      _overflow = true;
+    }
+  }
+}
+
+void SerialConsole::execute(){
+  PROF_ZONE(ProfZone::Console);
+  BLOCKING_SCOPE(BlockSite::Console);
+  heapguard::Allow allow;          // Befehle auf Anforderung, kein Dauerbetrieb
+  switch (_cmds.dispatch(_line)) {
+    case cmd::Result::Unknown:
+      Serial.printf("[CON] unbekannt: %s ('help' listet alle Befehle)\n", _line);
+      break;
+    case cmd::Result::BadArgs: {
+      const cmd::Command* c = _cmds.matched();
+      Serial.printf("[CON] Aufruf: %s %s\n", c->name, c->usage);
+      break;
+    }
+    default:
+      break;
+  }
+}
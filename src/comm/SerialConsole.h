@@ -1,32 +1,27 @@
 // ============================================================================
 // File: src/comm/SerialConsole.h
 // ----------------------------------------------------------------------------
+// Purpose: Zeilen von der USB-Konsole in einen festen Puffer, Dispatch über
+//          statische Befehlstabellen (CommandTable.h) – ohne Heap je Befehl
+// ============================================================================
 #pragma once
 #include <Arduino.h>
-#include <functional>
+#include "CommandTable.h"
+#include "../config/params.h"
 
 class SerialConsole {
 public:
-  using Handler = std::function<void(const String&)>;
-
-  void begin(uint32_t baud = 115200) { Serial.begin(baud); }
-  void onLine(Handler h) { _handler = h; }
+  void begin(uint32_t baud = 115200);
+  void loop();
 
-  void loop() {
-    while (Serial.available()) {
-      char c = (char)Serial.read();
-      if (c == '\r') continue;             // CR ignorieren (CRLF)
-      if (c == '\n') {                     // LF = Zeilenende
-        if (_handler) _handler(_buf);
-        _buf = "";
-      } else {
-        _buf += c;
-        if (_buf.length() > 512) _buf.remove(0); // primitive Überlaufsicherung
-      }
-    }
-  }
+  // Module hängen hier ihre Tabellen an (registerCommands(cmd::Registry&))
+  cmd::Registry& commands() { return _cmds; }
 
 private:
-  String  _buf;
-  Handler _handler;
+  void execute();
+
+  cmd::Registry _cmds;
+  char          _line[CONSOLE_LINE_BYTES];
+  size_t        _len = 0;
+  bool          _overflow = false;   // Rest der Zeile bis '\n' verwerfen
 };
@@ -0,0 +1,113 @@
+// ============================================================================
+// File: src/comm/Telemetry.cpp
+// ----------------------------------------------------------------------------
+#include "Telemetry.h"
+#include "../imu/QMI8658.h"
+
+using namespace telem;
+
+static_assert(TELEM_IMU_BATCH <= IMU_BATCH_MAX, "TELEM_IMU_BATCH zu groß");
+
+void TelemetryLink::begin(RS485Bus& bus, size_t mtu){
+  _bus = &bus;
+  _mtu = constrain(mtu, (size_t)32, (size_t)MAX_RAW);
+  _imu.count  = 0;
+  _touchDirty = false;
+  _frame.begin(_seq, _mtu);
+}
+
+void TelemetryLink::end(){
+  _bus = nullptr;
+}
+
+void TelemetryLink::add(MsgType type, const uint8_t* payload, size_t len){
+  if (!_frame.fits(len)) send();
+  if (_frame.empty()) _openedMs = millis();
+  if (_frame.add(type, payload, len)) _stats.messages++;
+}
+
+void TelemetryLink::pushGesture(const GestureEvent& g){
+  if (!_bus) return;
+  GestureMsg m;
+  m.type       = (uint8_t)g.type;
+  m.fingers    = g.finger_count;
+  m.x          = g.x;
+  m.y          = g.y;
+  m.valueMilli = (int32_t)lroundf(g.value * 1000.f);
+  m.ageMs      = (uint16_t)min<uint32_t>((micros() - g.event_us) / 1000, 0xFFFF);
+  uint8_t buf[12];
+  add(MsgType::Gesture, buf, encodeGesture(m, buf));
+}
+
+void TelemetryLink::pushImu(const IMUData& d){
+  if (!_bus) return;
+  const uint32_t now = millis();
+  if (_imu.count == 0) {
+    _imu.t0Ms = now;
+  } else if (_imu.count == 1) {
+    _imu.dtMs = (uint16_t)(now - _imu.t0Ms);
+  }
+  ImuSample& s = _imu.s[_imu.count++];
+  s.ax = (int16_t)lroundf(d.ax * 1000.f);
+  s.ay = (int16_t)lroundf(d.ay * 1000.f);
+  s.az = (int16_t)lroundf(d.az * 1000.f);
+  s.gx = (int16_t)lroundf(d.gx * 10.f);
+  s.gy = (int16_t)lroundf(d.gy * 10.f);
+  s.gz = (int16_t)lroundf(d.gz * 10.f);
+  if (_imu.count >= TELEM_IMU_BATCH) appendImuBatch();
+}
+
+void TelemetryLink::appendImuBatch(){
+  if (_imu.count == 0) return;
+  uint8_t buf[7 + IMU_BATCH_MAX * 12];
+  add(MsgType::ImuBatch, buf, encodeImuBatch(_imu, buf));
+  _imu.count = 0;
+  _imu.dtMs  = 0;
+}
+
+void TelemetryLink::pushTouch(const TouchPoint* pts, uint8_t n){
+  if (!_bus) return;
+  TouchStateMsg m;
+  for (uint8_t i = 0; i < n && m.count < TOUCH_MAX; i++) {
+    if (!pts[i].active) continue;
+    auto& p = m.p[m.count++];
+    p.id = i; p.x = pts[i].x; p.y = pts[i].y; p.strength = pts[i].strength;
+  }
+  // Nur Änderungen übertragen
+  bool same = (m.count == _touch.count);
+  for (uint8_t i = 0; same && i < m.count; i++) {
+    same = m.p[i].id == _touch.p[i].id && m.p[i].x == _touch.p[i].x &&
+           m.p[i].y == _touch.p[i].y && m.p[i].strength == _touch.p[i].strength;
+  }
+  if (same) return;
+  _touch = m;
+  _touchDirty = true;
+}
+
+void TelemetryLink::send(){
+  if (_frame.empty()) return;
+  const size_t n = _frame.finish(_wire);
+  if (_bus->write(_wire, n) == n) {
+    _stats.frames++;
+    _stats.bytes += n;
+    if (n > _stats.maxFrame) _stats.maxFrame = n;
+  } else {
+    _stats.dropped++;
+  }
+  _frame.begin(++_seq, _mtu);
+}
+
+void TelemetryLink::loop(){
+  if (!_bus) return;
+  if (_touchDirty) {
+    uint8_t buf[1 + TOUCH_MAX * 7];
+    add(MsgType::TouchState, buf, encodeTouchState(_touch, buf));
+    _touchDirty = false;
+  }
+  if (!_frame.empty() && (millis() - _openedMs) >= TELEM_FLUSH_MS) send();
+}
+
+void TelemetryStats::print(Print& out) const {
+  out.printf("[TELEM] frames=%u bytes=%u msgs=%u (%.1f/frame) maxFrame=%u dropped=%u\n",
+             frames, bytes, messages, frames ? (float)messages / frames : 0.f, maxFrame, dropped);
+}
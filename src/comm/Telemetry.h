@@ -0,0 +1,59 @@
+// ============================================================================
+// File: src/comm/Telemetry.h
+// ----------------------------------------------------------------------------
+// Purpose: Telemetrie-Sender über RS485 (Protokoll: TelemetryProto.h)
+//  • Gesten gehen sofort in den offenen Frame, IMU-Proben gesammelt als
+//    Batch, Touch-Zustand nur der jeweils letzte ("latest wins")
+//  • Frame wird gesendet, wenn die MTU voll ist oder TELEM_FLUSH_MS nach der
+//    ersten Nachricht – write() blockiert nicht (TX-Ring in RS485Bus)
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include "RS485Bus.h"
+#include "TelemetryProto.h"
+#include "../core/types.h"
+#include "../config/params.h"
+
+struct IMUData;
+
+struct TelemetryStats {
+  uint32_t frames = 0;
+  uint32_t bytes = 0;
+  uint32_t messages = 0;
+  uint32_t dropped = 0;     // TX-Ring voll
+  uint32_t maxFrame = 0;
+
+  void print(Print& out) const;
+};
+
+class TelemetryLink {
+public:
+  void begin(RS485Bus& bus, size_t mtu = TELEM_MTU);
+  void end();
+  bool active() const { return _bus != nullptr; }
+
+  void pushGesture(const GestureEvent& g);
+  void pushImu(const IMUData& d);
+  void pushTouch(const TouchPoint* pts, uint8_t n);
+  void loop();
+
+  const TelemetryStats& stats() const { return _stats; }
+
+private:
+  void add(telem::MsgType type, const uint8_t* payload, size_t len);
+  void appendImuBatch();
+  void send();
+
+  RS485Bus*           _bus = nullptr;
+  size_t              _mtu = TELEM_MTU;
+  uint16_t            _seq = 0;
+  uint32_t            _openedMs = 0;     // erste Nachricht im offenen Frame
+  telem::FrameBuilder _frame;
+  uint8_t             _wire[telem::MAX_RAW + telem::MAX_RAW / 254 + 2];
+
+  telem::ImuBatchMsg  _imu;
+  telem::TouchStateMsg _touch;
+  bool                _touchDirty = false;
+
+  TelemetryStats      _stats;
+};
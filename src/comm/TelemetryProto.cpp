@@ -0,0 +1,214 @@
+// ============================================================================
+// File: src/comm/TelemetryProto.cpp
+// ----------------------------------------------------------------------------
+#include "TelemetryProto.h"
+#include <string.h>
+
+namespace telem {
+
+static inline void wr16(uint8_t* p, uint16_t v){ p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static inline void wr32(uint8_t* p, uint32_t v){ wr16(p, (uint16_t)v); wr16(p + 2, (uint16_t)(v >> 16)); }
+static inline uint16_t rd16(const uint8_t* p){ return (uint16_t)(p[0] | (p[1] << 8)); }
+static inline uint32_t rd32(const uint8_t* p){ return (uint32_t)rd16(p) | ((uint32_t)rd16(p + 2) << 16); }
+
+// ---------------------------- Nachrichten ------------------------------------
+size_t encodeGesture(const GestureMsg& m, uint8_t* out){
+  out[0] = m.type;
+  out[1] = m.fingers;
+  wr16(out + 2, m.x);
+  wr16(out + 4, m.y);
+  wr32(out + 6, (uint32_t)m.valueMilli);
+  wr16(out + 10, m.ageMs);
+  return 12;
+}
+
+bool decodeGesture(const uint8_t* in, size_t n, GestureMsg& m){
+  if (n != 12) return false;
+  m.type       = in[0];
+  m.fingers    = in[1];
+  m.x          = rd16(in + 2);
+  m.y          = rd16(in + 4);
+  m.valueMilli = (int32_t)rd32(in + 6);
+  m.ageMs      = rd16(in + 10);
+  return true;
+}
+
+size_t encodeImuBatch(const ImuBatchMsg& m, uint8_t* out){
+  const uint8_t cnt = m.count > IMU_BATCH_MAX ? IMU_BATCH_MAX : m.count;
+  wr32(out, m.t0Ms);
+  wr16(out + 4, m.dtMs);
+  out[6] = cnt;
+  uint8_t* p = out + 7;
+  for (uint8_t i = 0; i < cnt; i++, p += 12) {
+    const ImuSample& s = m.s[i];
+    wr16(p + 0,  (uint16_t)s.ax); wr16(p + 2,  (uint16_t)s.ay); wr16(p + 4,  (uint16_t)s.az);
+    wr16(p + 6,  (uint16_t)s.gx); wr16(p + 8,  (uint16_t)s.gy); wr16(p + 10, (uint16_t)s.gz);
+  }
+  return 7 + (size_t)cnt * 12;
+}
+
+bool decodeImuBatch(const uint8_t* in, size_t n, ImuBatchMsg& m){
+  if (n < 7) return false;
+  m.t0Ms  = rd32(in);
+  m.dtMs  = rd16(in + 4);
+  m.count = in[6];
+  if (m.count > IMU_BATCH_MAX || n != 7 + (size_t)m.count * 12) return false;
+  const uint8_t* p = in + 7;
+  for (uint8_t i = 0; i < m.count; i++, p += 12) {
+    ImuSample& s = m.s[i];
+    s.ax = (int16_t)rd16(p + 0); s.ay = (int16_t)rd16(p + 2); s.az = (int16_t)rd16(p + 4);
+    s.gx = (int16_t)rd16(p + 6); s.gy = (int16_t)rd16(p + 8); s.gz = (int16_t)rd16(p + 10);
+  }
+  return true;
+}
+
+size_t encodeTouchState(const TouchStateMsg& m, uint8_t* out){
+  const uint8_t cnt = m.count > TOUCH_MAX ? TOUCH_MAX : m.count;
+  out[0] = cnt;
+  uint8_t* p = out + 1;
+  for (uint8_t i = 0; i < cnt; i++, p += 7) {
+    p[0] = m.p[i].id;
+    wr16(p + 1, m.p[i].x);
+    wr16(p + 3, m.p[i].y);
+    wr16(p + 5, m.p[i].strength);
+  }
+  return 1 + (size_t)cnt * 7;
+}
+
+bool decodeTouchState(const uint8_t* in, size_t n, TouchStateMsg& m){
+  if (n < 1) return false;
+  m.count = in[0];
+  if (m.count > TOUCH_MAX || n != 1 + (size_t)m.count * 7) return false;
+  const uint8_t* p = in + 1;
+  for (uint8_t i = 0; i < m.count; i++, p += 7) {
+    m.p[i].id       = p[0];
+    m.p[i].x        = rd16(p + 1);
+    m.p[i].y        = rd16(p + 3);
+    m.p[i].strength = rd16(p + 5);
+  }
+  return true;
+}
+
+// ---------------------------- COBS -------------------------------------------
+// Jeder Block: Code-Byte (Abstand zur nächsten 0, max. 0xFF = 254 Daten ohne 0)
+size_t cobsEncode(const uint8_t* in, size_t n, uint8_t* out){
+  size_t  o = 1, codePos = 0;
+  uint8_t code = 1;
+  for (size_t i = 0; i < n; i++) {
+    if (in[i] == 0) {
+      out[codePos] = code;
+      codePos = o++;
+      code = 1;
+    } else {
+      out[o++] = in[i];
+      if (++code == 0xFF) {
+        out[codePos] = code;
+        codePos = o++;
+        code = 1;
+      }
+    }
+  }
+  out[codePos] = code;
+  return o;
+}
+
+size_t cobsDecode(const uint8_t* in, size_t n, uint8_t* out, size_t cap){
+  size_t i = 0, o = 0;
+  while (i < n) {
+    const uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > n) return 0;
+    for (uint8_t k = 1; k < code; k++) {
+      if (in[i] == 0 || o >= cap) return 0;
+      out[o++] = in[i++];
+    }
+    if (code != 0xFF && i < n) {
+      if (o >= cap) return 0;
+      out[o++] = 0;
+    }
+  }
+  return o;
+}
+
+// ---------------------------- CRC32 (IEEE, reflektiert) ----------------------
+// Zur Compile-Zeit erzeugt (liegt im Flash): kein Init-Lauf, den Stream-,
+// Spiegel-Task und Loop gleichzeitig anstoßen könnten
+struct CrcTable {
+  uint32_t v[256];
+  constexpr CrcTable() : v() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (uint8_t k = 0; k < 8; k++) c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+      v[i] = c;
+    }
+  }
+};
+static constexpr CrcTable CRC_TABLE{};
+static_assert(CRC_TABLE.v[1] == 0x77073096u && CRC_TABLE.v[255] == 0x2D02EF8Du, "CRC32-Tabelle falsch");
+
+uint32_t crc32(const uint8_t* data, size_t n, uint32_t crc){
+  crc = ~crc;
+  for (size_t i = 0; i < n; i++) crc = CRC_TABLE.v[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+// ---------------------------- FrameBuilder -----------------------------------
+void FrameBuilder::begin(uint16_t seq, size_t mtu){
+  _mtu = mtu;
+  _raw[0] = VERSION;
+  wr16(_raw + 1, seq);
+  _raw[3] = 0;
+  _len = HEADER;
+}
+
+bool FrameBuilder::fits(size_t payloadLen) const {
+  const size_t raw = _len + MSG_HEADER + payloadLen + TRAILER;
+  return payloadLen <= MAX_PAYLOAD && raw <= MAX_RAW && _raw[3] < 0xFF &&
+         cobsMaxEncoded(raw) + 1 <= _mtu;
+}
+
+bool FrameBuilder::add(MsgType type, const uint8_t* payload, size_t len){
+  if (!fits(len)) return false;
+  _raw[_len++] = (uint8_t)type;
+  _raw[_len++] = (uint8_t)len;
+  memcpy(_raw + _len, payload, len);
+  _len += len;
+  _raw[3]++;
+  return true;
+}
+
+size_t FrameBuilder::finish(uint8_t* out){
+  wr32(_raw + _len, crc32(_raw, _len));
+  size_t n = cobsEncode(_raw, _len + TRAILER, out);
+  out[n++] = 0x00;
+  return n;
+}
+
+// ---------------------------- Parser -----------------------------------------
+ParseResult parseFrame(const uint8_t* enc, size_t n, uint8_t* scratch,
+                       uint16_t& seq, MsgVisitor visit, void* ctx){
+  const size_t raw = cobsDecode(enc, n, scratch, n);
+  if (raw == 0) return ParseResult::Cobs;
+  if (raw < HEADER + TRAILER) return ParseResult::Short;
+  if (crc32(scratch, raw - TRAILER) != rd32(scratch + raw - TRAILER)) return ParseResult::Crc;
+  if (scratch[0] != VERSION) return ParseResult::Version;
+  seq = rd16(scratch + 1);
+
+  // Erst vollständig prüfen, dann besuchen – kein halb ausgewerteter Frame
+  const size_t end = raw - TRAILER;
+  size_t pos = HEADER;
+  for (uint8_t i = 0; i < scratch[3]; i++) {
+    if (pos + MSG_HEADER > end || pos + MSG_HEADER + scratch[pos + 1] > end) return ParseResult::Malformed;
+    pos += MSG_HEADER + scratch[pos + 1];
+  }
+  if (pos != end) return ParseResult::Malformed;
+
+  pos = HEADER;
+  for (uint8_t i = 0; i < scratch[3]; i++) {
+    const uint8_t len = scratch[pos + 1];
+    if (visit) visit((MsgType)scratch[pos], scratch + pos + MSG_HEADER, len, ctx);
+    pos += MSG_HEADER + len;
+  }
+  return ParseResult::Ok;
+}
+
+}  // namespace telem
@@ -0,0 +1,101 @@
+// ============================================================================
+// File: src/comm/TelemetryProto.h
+// ----------------------------------------------------------------------------
+// Purpose: Binäres Telemetrie-Protokoll (Touch/Gesten/IMU -> SPS über RS485)
+//  • Frame = COBS( [ver][seq LE16][nMsg] {[type][len][payload]}* [CRC32 LE] ) 0x00
+//  • 0x00 kommt nur als Frame-Ende vor -> Empfänger synchronisiert sich nach
+//    Störungen am nächsten Trenner neu
+//  • Mehrere Nachrichten pro Frame bis zur MTU (weniger Bus-Turnarounds)
+//  • Alle Felder little-endian, byteweise serialisiert (keine struct-Casts)
+//  • Plattformneutral: Host-Decoder/Benchmark in tools/telemetry_tool.cpp
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace telem {
+
+static constexpr uint8_t VERSION     = 1;
+static constexpr size_t  HEADER      = 4;    // ver, seq(2), nMsg
+static constexpr size_t  MSG_HEADER  = 2;    // type, len
+static constexpr size_t  TRAILER     = 4;    // CRC32
+static constexpr size_t  MAX_PAYLOAD = 255;
+static constexpr size_t  MAX_RAW     = 512;  // obere Grenze für MTU-Puffer
+
+enum class MsgType : uint8_t {
+  Gesture    = 1,
+  ImuBatch   = 2,
+  TouchState = 3,
+};
+
+// ---------------------------- Nachrichteninhalte -----------------------------
+struct GestureMsg {          // 12 Byte
+  uint8_t  type = 0;         // GestureType
+  uint8_t  fingers = 0;
+  uint16_t x = 0, y = 0;
+  int32_t  valueMilli = 0;   // GestureEvent::value * 1000
+  uint16_t ageMs = 0;        // Erkennung -> Serialisierung
+};
+
+struct ImuSample {           // 12 Byte
+  int16_t ax, ay, az;        // mg
+  int16_t gx, gy, gz;        // 0.1 dps
+};
+
+static constexpr uint8_t IMU_BATCH_MAX = 20;   // (255 - 7) / 12
+struct ImuBatchMsg {         // 7 + n * 12 Byte
+  uint32_t t0Ms = 0;         // millis() der ersten Probe
+  uint16_t dtMs = 0;         // Abstand der Proben
+  uint8_t  count = 0;
+  ImuSample s[IMU_BATCH_MAX];
+};
+
+static constexpr uint8_t TOUCH_MAX = 5;
+struct TouchStateMsg {       // 1 + n * 7 Byte
+  uint8_t count = 0;
+  struct { uint8_t id; uint16_t x, y, strength; } p[TOUCH_MAX];
+};
+
+size_t encodeGesture(const GestureMsg& m, uint8_t* out);
+size_t encodeImuBatch(const ImuBatchMsg& m, uint8_t* out);
+size_t encodeTouchState(const TouchStateMsg& m, uint8_t* out);
+bool   decodeGesture(const uint8_t* in, size_t n, GestureMsg& m);
+bool   decodeImuBatch(const uint8_t* in, size_t n, ImuBatchMsg& m);
+bool   decodeTouchState(const uint8_t* in, size_t n, TouchStateMsg& m);
+
+// ---------------------------- COBS / CRC -------------------------------------
+inline size_t cobsMaxEncoded(size_t n){ return n + n / 254 + 1; }
+size_t   cobsEncode(const uint8_t* in, size_t n, uint8_t* out);
+// 0 bei ungültiger Codierung oder zu kleinem Puffer
+size_t   cobsDecode(const uint8_t* in, size_t n, uint8_t* out, size_t cap);
+uint32_t crc32(const uint8_t* data, size_t n, uint32_t crc = 0);
+
+// ---------------------------- Frame bauen ------------------------------------
+// Sammelt Nachrichten in einem Rohpuffer; add() lehnt ab, sobald der
+// COBS-codierte Frame inkl. Trenner die MTU überschreiten würde.
+class FrameBuilder {
+public:
+  void   begin(uint16_t seq, size_t mtu);
+  bool   add(MsgType type, const uint8_t* payload, size_t len);
+  bool   fits(size_t payloadLen) const;
+  uint8_t count() const { return _raw[3]; }
+  bool   empty() const { return _raw[3] == 0; }
+  // CRC anhängen, COBS-codieren, 0x00 anhängen; out >= mtu Byte
+  size_t finish(uint8_t* out);
+
+private:
+  uint8_t _raw[MAX_RAW];
+  size_t  _len = 0;
+  size_t  _mtu = 0;
+};
+
+// ---------------------------- Frame parsen -----------------------------------
+enum class ParseResult : uint8_t { Ok = 0, Cobs, Short, Crc, Version, Malformed };
+
+using MsgVisitor = void (*)(MsgType type, const uint8_t* payload, size_t len, void* ctx);
+
+// enc = ein Frame ohne 0x00-Trenner; scratch >= n Byte
+ParseResult parseFrame(const uint8_t* enc, size_t n, uint8_t* scratch,
+                       uint16_t& seq, MsgVisitor visit, void* ctx);
+
+}  // namespace telem
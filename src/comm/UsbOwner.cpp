@@ -0,0 +1,35 @@
+// ============================================================================
+// File: src/comm/UsbOwner.cpp
+// ----------------------------------------------------------------------------
+#include "UsbOwner.h"
+
+namespace usbowner {
+
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;   // Loop vs. Strom-Tasks
+static const char* volatile s_holder = nullptr;
+
+bool acquire(const char* who, volatile bool& active){
+  portENTER_CRITICAL(&s_mux);
+  const bool ok = !s_holder || s_holder == who;
+  if (ok) {
+    s_holder = who;
+    active = true;
+  }
+  portEXIT_CRITICAL(&s_mux);
+  return ok;
+}
+
+void releaseIfIdle(const char* who, const volatile bool& active){
+  portENTER_CRITICAL(&s_mux);
+  if (s_holder == who && !active) s_holder = nullptr;
+  portEXIT_CRITICAL(&s_mux);
+}
+
+const char* holder(){ return s_holder; }
+
+bool busy(const char* who){
+  const char* h = s_holder;
+  return h && h != who;
+}
+
+}  // namespace usbowner
@@ -0,0 +1,25 @@
+// ============================================================================
+// File: src/comm/UsbOwner.h
+// ----------------------------------------------------------------------------
+// Purpose: Höchstens ein Binärstrom zur Zeit auf der USB-Konsole
+//  • "stream on" (UsbStream) und "mirror on" (ScreenMirror) schreiben
+//    COBS-Chunks aus je eigenem Task auf dieselbe Serial; gleichzeitig
+//    würden sich die Chunks mischen und der Host verwirft beide
+//  • acquire() in start(): belegt die Konsole und setzt active unter einer
+//    Sperre; hält schon der andere Strom sie, wird der Start abgelehnt
+//  • releaseIfIdle() im Task nach dem letzten Chunk: gibt nur frei, wenn
+//    active nicht inzwischen wieder gesetzt wurde
+//  • Textausgaben der Konsole bleiben unberührt (COBS-Rahmen trennen sie ab)
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+
+namespace usbowner {
+
+// who: Name des Stroms, je Modul dieselbe Konstante (Zeigervergleich)
+bool acquire(const char* who, volatile bool& active);
+void releaseIfIdle(const char* who, const volatile bool& active);
+const char* holder();                // nullptr = frei
+bool busy(const char* who);          // von einem anderen Strom belegt
+
+}  // namespace usbowner
@@ -0,0 +1,203 @@
+// ============================================================================
+// File: src/comm/UsbStream.cpp
+// ----------------------------------------------------------------------------
+#include "UsbStream.h"
+#include "UsbOwner.h"
+#include "../imu/QMI8658.h"
+
+using namespace usbstream;
+
+static const char* const USB_OWNER = "stream";
+
+bool UsbStream::begin(){
+  if (_task) return true;
+  return xTaskCreatePinnedToCore(taskEntry, "stream", 3072, this, STREAM_TASK_PRIORITY,
+                                 &_task, STREAM_TASK_CORE) == pdPASS;
+}
+
+bool UsbStream::start(){
+  if (!_task) return false;
+  if (_active) return true;
+  _stats  = UsbStreamStats{};
+  _rateMs = millis();
+  _rateRecords = _rateBytes = 0;
+  if (!usbowner::acquire(USB_OWNER, _active)) return false;
+  xTaskNotifyGive(_task);
+  return true;
+}
+
+void UsbStream::stop(){
+  _active = false;   // Task schreibt den offenen Chunk noch weg
+}
+
+// ---------------------------- Loop-Seite -------------------------------------
+bool UsbStream::push(const Record& r){
+  const uint32_t head = _head.load(std::memory_order_relaxed);
+  const uint32_t used = head - _tail.load(std::memory_order_acquire);
+  if (used >= STREAM_RING_RECORDS) {
+    _stats.dropped++;
+    return false;
+  }
+  _ring[head & MASK] = r;
+  _head.store(head + 1, std::memory_order_release);
+  _stats.records++;
+  if (used + 1 > _stats.ringHigh) _stats.ringHigh = used + 1;
+  return true;
+}
+
+void UsbStream::pushImu(const IMUData& d){
+  if (!_active) return;
+  Record r;
+  r.type   = RecType::Imu;
+  r.count  = 0;
+  r.us     = micros();
+  r.imu.ax = (int16_t)lroundf(d.ax * 1000.f);
+  r.imu.ay = (int16_t)lroundf(d.ay * 1000.f);
+  r.imu.az = (int16_t)lroundf(d.az * 1000.f);
+  r.imu.gx = (int16_t)lroundf(d.gx * 10.f);
+  r.imu.gy = (int16_t)lroundf(d.gy * 10.f);
+  r.imu.gz = (int16_t)lroundf(d.gz * 10.f);
+  push(r);
+}
+
+void UsbStream::pushTouch(const TouchPoint* pts, uint8_t n){
+  if (!_active) return;
+  Record r;
+  r.type  = RecType::Touch;
+  r.count = 0;
+  r.us    = micros();
+  for (uint8_t i = 0; i < n && r.count < TOUCH_MAX; i++) {
+    if (!pts[i].active) continue;
+    TouchVals& t = r.touch[r.count++];
+    t.slot     = i;
+    t.x        = pts[i].x;
+    t.y        = pts[i].y;
+    t.strength = pts[i].strength;
+  }
+  // Leere Frames nur als Loslass-Flanke, nicht bei jedem Poll
+  if (r.count == 0 && _lastTouchCount == 0) return;
+  _lastTouchCount = r.count;
+  push(r);
+}
+
+void UsbStream::pushGesture(const GestureEvent& g){
+  if (!_active) return;
+  Record r;
+  r.type               = RecType::Gesture;
+  r.count              = 0;
+  r.us                 = g.event_us;
+  r.gesture.type       = (uint8_t)g.type;
+  r.gesture.fingers    = g.finger_count;
+  r.gesture.x          = g.x;
+  r.gesture.y          = g.y;
+  r.gesture.valueMilli = (int32_t)lroundf(g.value * 1000.f);
+  push(r);
+}
+
+// ---------------------------- Task -------------------------------------------
+void UsbStream::taskEntry(void* arg){
+  static_cast<UsbStream*>(arg)->taskLoop();
+}
+
+void UsbStream::addRecord(const Record& r){
+  if (_enc.records() == 0) _openedMs = millis();
+  if (!_enc.add(r)) {
+    flush();
+    _openedMs = millis();
+    _enc.add(r);
+  }
+}
+
+void UsbStream::flush(){
+  if (_enc.records() == 0) return;
+  const size_t raw = _enc.finish();
+  // 0x00 auch vorn: Konsolentext davor endet so als eigener (ungültiger) Frame
+  _wire[0] = 0x00;
+  size_t n = 1 + telem::cobsEncode(_raw, raw, _wire + 1);
+  _wire[n++] = 0x00;
+  const uint32_t t0 = micros();
+  Serial.write(_wire, n);                  // ein großer Write je Chunk
+  const uint32_t dt = micros() - t0;
+  if (dt > _stats.writeMaxUs) _stats.writeMaxUs = dt;
+  _stats.chunks++;
+  _stats.bytes += n;
+  _rateBytes   += n;
+  _enc.begin(_raw, sizeof(_raw), ++_seq);
+}
+
+void UsbStream::updateRate(uint32_t nowMs){
+  const uint32_t dt = nowMs - _rateMs;
+  if (dt < 1000) return;
+  _stats.recPerSec   = (uint32_t)((uint64_t)(_stats.records - _rateRecords) * 1000u / dt);
+  _stats.bytesPerSec = (uint32_t)((uint64_t)_rateBytes * 1000u / dt);
+  _rateRecords = _stats.records;
+  _rateBytes   = 0;
+  _rateMs      = nowMs;
+
+  // Zähler auch im Strom, damit der Host Überläufe ohne Konsole sieht
+  Record r;
+  r.type            = RecType::Stats;
+  r.count           = 0;
+  r.us              = micros();
+  r.stats.records   = _stats.records;
+  r.stats.dropped   = _stats.dropped;
+  r.stats.ringHigh  = _stats.ringHigh;
+  r.stats.recPerSec = _stats.recPerSec;
+  addRecord(r);
+}
+
+void UsbStream::taskLoop(){
+  _enc.begin(_raw, sizeof(_raw), _seq);
+  for (;;) {
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    const uint32_t head = _head.load(std::memory_order_acquire);
+    while (tail != head) {
+      addRecord(_ring[tail & MASK]);
+      _tail.store(++tail, std::memory_order_release);
+    }
+    if (!_active) {                        // Rest wegschreiben, schlafen bis start()
+      flush();
+      usbowner::releaseIfIdle(USB_OWNER, _active);
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    const uint32_t now = millis();
+    updateRate(now);
+    if (_enc.records() && now - _openedMs >= STREAM_FLUSH_MS) flush();
+    vTaskDelay(pdMS_TO_TICKS(5));
+  }
+}
+
+// ---------------------------- Konsole ---------------------------------------
+void UsbStreamStats::print(Print& out) const {
+  out.printf("[STREAM] records=%u (%u/s) dropped=%u ringHigh=%u/%u\n",
+             records, recPerSec, dropped, ringHigh, (unsigned)STREAM_RING_RECORDS);
+  out.printf("[STREAM] chunks=%u bytes=%u (%u B/s) write max=%uus\n",
+             chunks, bytes, bytesPerSec, writeMaxUs);
+}
+
+static constexpr cmd::Command STREAM_CMDS[] = {
+  {"stream off", "", "", [](void* c, const cmd::Args&){
+    UsbStream& s = *static_cast<UsbStream*>(c);
+    s.stop();
+    Serial.println();
+    s.stats().print(Serial);
+  }},
+  {"stream on", "", "", [](void* c, const cmd::Args&){
+    UsbStream& s = *static_cast<UsbStream*>(c);
+    if (!s.begin()) { Serial.println("[STREAM] Task-Start fehlgeschlagen"); return; }
+    const char* other = usbowner::holder();
+    if (other && usbowner::busy(USB_OWNER)) {
+      Serial.printf("[STREAM] USB belegt durch \"%s\" ('%s off', dann erneut)\n", other, other);
+      return;
+    }
+    Serial.println("[STREAM] an (binär, 'stream off' beendet)");
+    if (!s.start()) Serial.println("[STREAM] USB belegt");
+  }},
+  {"stream stats", "", "", [](void* c, const cmd::Args&){ static_cast<UsbStream*>(c)->stats().print(Serial); }},
+};
+static_assert(cmd::sorted(STREAM_CMDS), "STREAM_CMDS nicht sortiert");
+
+void UsbStream::registerCommands(cmd::Registry& r){
+  r.add(STREAM_CMDS, this, "stream");
+}
@@ -0,0 +1,79 @@
+// ============================================================================
+// File: src/comm/UsbStream.h
+// ----------------------------------------------------------------------------
+// Purpose: Hochraten-Messdaten über die USB-Konsole (Protokoll: UsbStreamProto.h)
+//  • push*() im Loop: Rohrecord in einen SPSC-Ring kopieren, sonst nichts
+//  • Eigener Task kodiert (Delta/Varint) und schreibt ganze Chunks
+//    (bis STREAM_CHUNK_BYTES) mit einem write()
+//  • Records/s und Ring-Überläufe: "stream stats" und ~1/s als Stats-Record
+//  • Schließt "mirror on" aus (UsbOwner.h): beide schreiben binär auf Serial
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "UsbStreamProto.h"
+#include "TelemetryProto.h"
+#include "CommandTable.h"
+#include "../core/types.h"
+#include "../config/params.h"
+
+struct IMUData;
+
+struct UsbStreamStats {
+  uint32_t records = 0;       // angenommen
+  uint32_t dropped = 0;       // Ring voll
+  uint32_t ringHigh = 0;
+  uint32_t chunks = 0;
+  uint32_t bytes = 0;         // auf USB geschrieben (inkl. COBS)
+  uint32_t recPerSec = 0;     // letzte volle Sekunde
+  uint32_t bytesPerSec = 0;
+  uint32_t writeMaxUs = 0;    // längster write() im Task
+
+  void print(Print& out) const;
+};
+
+class UsbStream {
+public:
+  bool begin();
+  bool start();                    // false: USB-Konsole vom Spiegel belegt
+  void stop();
+  bool active() const { return _active; }
+
+  void pushImu(const IMUData& d);
+  void pushTouch(const TouchPoint* pts, uint8_t n);
+  void pushGesture(const GestureEvent& g);
+
+  const UsbStreamStats& stats() const { return _stats; }
+  void registerCommands(cmd::Registry& r);   // stream on|off|stats
+
+private:
+  static constexpr uint32_t MASK = STREAM_RING_RECORDS - 1;
+  static_assert((STREAM_RING_RECORDS & MASK) == 0, "STREAM_RING_RECORDS muss 2er-Potenz sein");
+
+  bool push(const usbstream::Record& r);
+  static void taskEntry(void* arg);
+  void taskLoop();
+  void addRecord(const usbstream::Record& r);
+  void flush();
+  void updateRate(uint32_t nowMs);
+
+  usbstream::Record     _ring[STREAM_RING_RECORDS];
+  std::atomic<uint32_t> _head{0};     // schreibt nur der Loop
+  std::atomic<uint32_t> _tail{0};     // schreibt nur der Task
+  volatile bool         _active = false;
+  uint8_t               _lastTouchCount = 0;
+  TaskHandle_t          _task = nullptr;
+
+  // nur im Task
+  usbstream::ChunkEncoder _enc;
+  uint8_t  _raw[STREAM_CHUNK_BYTES];
+  uint8_t  _wire[STREAM_CHUNK_BYTES + STREAM_CHUNK_BYTES / 254 + 3];
+  uint32_t _seq = 0;
+  uint32_t _openedMs = 0;
+  uint32_t _rateMs = 0;
+  uint32_t _rateRecords = 0, _rateBytes = 0;
+
+  UsbStreamStats _stats;
+};
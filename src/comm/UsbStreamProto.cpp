@@ -0,0 +1,174 @@
+// ============================================================================
+// File: src/comm/UsbStreamProto.cpp
+// ----------------------------------------------------------------------------
+#include "UsbStreamProto.h"
+#include "TelemetryProto.h"
+#include <string.h>
+
+namespace usbstream {
+
+static inline uint32_t zigzag(int32_t v){ return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static inline int32_t unzigzag(uint32_t v){ return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+
+void ChunkEncoder::begin(uint8_t* buf, size_t cap, uint32_t seq){
+  _buf     = buf;
+  _cap     = cap;
+  _len     = 0;
+  _records = 0;
+  _prevUs  = 0;
+  _prevImu = ImuVals{};
+  memset(_prevX, 0, sizeof(_prevX));
+  memset(_prevY, 0, sizeof(_prevY));
+  _buf[_len++] = VERSION;
+  putVarint(seq);
+}
+
+void ChunkEncoder::putVarint(uint32_t v){
+  while (v >= 0x80) { _buf[_len++] = (uint8_t)(v | 0x80); v >>= 7; }
+  _buf[_len++] = (uint8_t)v;
+}
+
+void ChunkEncoder::putSigned(int32_t v){ putVarint(zigzag(v)); }
+
+bool ChunkEncoder::add(const Record& r){
+  if (_len + MAX_RECORD + TRAILER > _cap) return false;
+  const uint8_t count = r.type == RecType::Touch ? (r.count > TOUCH_MAX ? TOUCH_MAX : r.count) : 0;
+  _buf[_len++] = (uint8_t)((uint8_t)r.type | (count << 2));
+  putVarint(_records == 0 ? r.us : r.us - _prevUs);
+  _prevUs = r.us;
+
+  switch (r.type) {
+    case RecType::Imu: {
+      const int16_t* v = &r.imu.ax;
+      int16_t* p = &_prevImu.ax;
+      for (int i = 0; i < 6; i++) { putSigned((int32_t)v[i] - p[i]); p[i] = v[i]; }
+      break;
+    }
+    case RecType::Touch:
+      for (uint8_t i = 0; i < count; i++) {
+        const TouchVals& t = r.touch[i];
+        const uint8_t s = t.slot < TOUCH_MAX ? t.slot : 0;
+        _buf[_len++] = s;
+        putSigned((int32_t)t.x - _prevX[s]);
+        putSigned((int32_t)t.y - _prevY[s]);
+        putVarint(t.strength);
+        _prevX[s] = t.x;
+        _prevY[s] = t.y;
+      }
+      break;
+    case RecType::Gesture:
+      _buf[_len++] = r.gesture.type;
+      _buf[_len++] = r.gesture.fingers;
+      putVarint(r.gesture.x);
+      putVarint(r.gesture.y);
+      putSigned(r.gesture.valueMilli);
+      break;
+    case RecType::Stats:
+      putVarint(r.stats.records);
+      putVarint(r.stats.dropped);
+      putVarint(r.stats.ringHigh);
+      putVarint(r.stats.recPerSec);
+      break;
+  }
+  _records++;
+  return true;
+}
+
+size_t ChunkEncoder::finish(){
+  const uint32_t crc = telem::crc32(_buf, _len);
+  for (int i = 0; i < 4; i++) _buf[_len++] = (uint8_t)(crc >> (8 * i));
+  return _len;
+}
+
+// ---------------------------- Decoder ----------------------------------------
+namespace {
+
+struct Reader {
+  const uint8_t* p;
+  const uint8_t* end;
+  bool ok = true;
+
+  uint8_t byte(){
+    if (p >= end) { ok = false; return 0; }
+    return *p++;
+  }
+  uint32_t varint(){
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      const uint8_t b = byte();
+      v |= (uint32_t)(b & 0x7F) << shift;
+      if (!(b & 0x80)) return v;
+    }
+    ok = false;
+    return 0;
+  }
+  int32_t sint(){ return unzigzag(varint()); }
+};
+
+}  // namespace
+
+bool decodeChunk(const uint8_t* raw, size_t n, uint32_t& seq, RecordVisitor visit, void* ctx){
+  if (n < 2 + TRAILER) return false;
+  const size_t body = n - TRAILER;
+  const uint32_t crc = (uint32_t)raw[body] | ((uint32_t)raw[body + 1] << 8) |
+                       ((uint32_t)raw[body + 2] << 16) | ((uint32_t)raw[body + 3] << 24);
+  if (telem::crc32(raw, body) != crc || raw[0] != VERSION) return false;
+
+  Reader rd{raw + 1, raw + body};
+  seq = rd.varint();
+  uint32_t prevUs = 0;
+  ImuVals  prevImu{};
+  uint16_t prevX[TOUCH_MAX] = {0}, prevY[TOUCH_MAX] = {0};
+  bool first = true;
+
+  while (rd.ok && rd.p < rd.end) {
+    Record r;
+    memset(&r, 0, sizeof(r));
+    const uint8_t h = rd.byte();
+    r.type  = (RecType)(h & 0x03);
+    r.count = h >> 2;
+    r.us    = first ? rd.varint() : prevUs + rd.varint();
+    prevUs  = r.us;
+    first   = false;
+
+    switch (r.type) {
+      case RecType::Imu: {
+        int16_t* v = &r.imu.ax;
+        int16_t* p = &prevImu.ax;
+        for (int i = 0; i < 6; i++) { v[i] = (int16_t)(p[i] + rd.sint()); p[i] = v[i]; }
+        break;
+      }
+      case RecType::Touch:
+        if (r.count > TOUCH_MAX) return false;
+        for (uint8_t i = 0; i < r.count; i++) {
+          TouchVals& t = r.touch[i];
+          t.slot = rd.byte();
+          if (t.slot >= TOUCH_MAX) return false;
+          t.x = (uint16_t)(prevX[t.slot] + rd.sint());
+          t.y = (uint16_t)(prevY[t.slot] + rd.sint());
+          t.strength = (uint16_t)rd.varint();
+          prevX[t.slot] = t.x;
+          prevY[t.slot] = t.y;
+        }
+        break;
+      case RecType::Gesture:
+        r.gesture.type       = rd.byte();
+        r.gesture.fingers    = rd.byte();
+        r.gesture.x          = (uint16_t)rd.varint();
+        r.gesture.y          = (uint16_t)rd.varint();
+        r.gesture.valueMilli = rd.sint();
+        break;
+      case RecType::Stats:
+        r.stats.records   = rd.varint();
+        r.stats.dropped   = rd.varint();
+        r.stats.ringHigh  = rd.varint();
+        r.stats.recPerSec = rd.varint();
+        break;
+    }
+    if (!rd.ok) return false;
+    visit(r, ctx);
+  }
+  return rd.ok;
+}
+
+}  // namespace usbstream
@@ -0,0 +1,97 @@
+// ============================================================================
+// File: src/comm/UsbStreamProto.h
+// ----------------------------------------------------------------------------
+// Purpose: Binärer Messdaten-Strom über USB-CDC (IMU, Touch-Frames, Gesten)
+//  • Chunk = 0x00 COBS( [ver][seq varint] {Record}* [CRC32 LE] ) 0x00
+//    – 0x00 nur als Trenner: Konsolentext zwischen Chunks fällt beim
+//      Empfänger durch die CRC, der nächste Chunk synchronisiert neu
+//  • Record = [type | count<<2][dt varint] Felder
+//    – Zeit als Abstand zum vorigen Record (erster im Chunk: absolut, µs)
+//    – IMU und Touch-Koordinaten als Differenz zum Vorgänger im selben
+//      Chunk (ZigZag-Varint) – Ruhephasen kosten ~1 Byte je Achse
+//    – Jeder Chunk beginnt mit leerem Delta-Zustand: ein verlorener Chunk
+//      beschädigt keine folgenden
+//  • Plattformneutral: Decoder/Selbsttest in tools/stream_decode.cpp
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace usbstream {
+
+static constexpr uint8_t VERSION    = 1;
+static constexpr uint8_t TOUCH_MAX  = 5;
+static constexpr size_t  MAX_RECORD = 64;   // Worst Case eines kodierten Records
+static constexpr size_t  TRAILER    = 4;    // CRC32
+
+enum class RecType : uint8_t {
+  Imu     = 0,
+  Touch   = 1,
+  Gesture = 2,
+  Stats   = 3,    // Zähler der Firmware (Records, Überläufe), ~1/s
+};
+
+struct ImuVals {            // mg bzw. 0.1 dps (wie Telemetrie)
+  int16_t ax, ay, az;
+  int16_t gx, gy, gz;
+};
+
+struct TouchVals {
+  uint8_t  slot;
+  uint16_t x, y, strength;
+};
+
+struct GestureVals {
+  uint8_t  type, fingers;
+  uint16_t x, y;
+  int32_t  valueMilli;
+};
+
+struct StatsVals {
+  uint32_t records;         // angenommen seit Start
+  uint32_t dropped;         // Ring voll
+  uint32_t ringHigh;        // max. Füllstand
+  uint32_t recPerSec;       // zuletzt gemessen
+};
+
+// Rohformat im Ring: feste Größe, der Loop kopiert nur
+struct Record {
+  RecType  type;
+  uint8_t  count;           // Touch: Anzahl Punkte
+  uint32_t us;              // micros()
+  union {
+    ImuVals     imu;
+    TouchVals   touch[TOUCH_MAX];
+    GestureVals gesture;
+    StatsVals   stats;
+  };
+};
+
+class ChunkEncoder {
+public:
+  // cap >= 8 + MAX_RECORD + TRAILER
+  void   begin(uint8_t* buf, size_t cap, uint32_t seq);
+  bool   add(const Record& r);          // false = Chunk voll
+  size_t finish();                      // CRC anhängen, liefert Rohlänge
+  size_t size() const { return _len; }
+  uint16_t records() const { return _records; }
+
+private:
+  void putVarint(uint32_t v);
+  void putSigned(int32_t v);
+
+  uint8_t* _buf = nullptr;
+  size_t   _cap = 0;
+  size_t   _len = 0;
+  uint16_t _records = 0;
+  uint32_t _prevUs = 0;
+  ImuVals  _prevImu{};
+  uint16_t _prevX[TOUCH_MAX] = {0}, _prevY[TOUCH_MAX] = {0};
+};
+
+using RecordVisitor = void (*)(const Record& r, void* ctx);
+
+// Prüft CRC/Version; false bei defektem Chunk (Records bis dahin evtl. schon gemeldet)
+bool decodeChunk(const uint8_t* raw, size_t n, uint32_t& seq, RecordVisitor visit, void* ctx);
+
+}  // namespace usbstream
@@ -2,7 +2,9 @@
 // File: src/config/params.h - KORRIGIERTE TOUCH PARAMETER
 // ----------------------------------------------------------------------------
 #pragma once
-#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "../gestures/gesture_params.h"   // Gestenschwellen (generiert)
 
 // ---------------------------- Display Parameter ----------------------------
 static constexpr uint16_t DISPLAY_WIDTH    = 320;
@@ -12,6 +14,128 @@ static constexpr uint8_t  DISPLAY_ROTATION = 1; // 0..3
 // ---------------------------- I2C Frequenzen --------------------------------
 static constexpr uint32_t I2C_FREQ_HZ = 400000; // 400 kHz
 
+// ---------------------------- I2C Engine (Queue/Worker) ---------------------
+static constexpr uint8_t  I2C_QUEUE_DEPTH          = 8;   // Transaktionen pro Bus
+static constexpr uint16_t I2C_TIMEOUT_MS           = 20;  // pro Transfer
+static constexpr uint8_t  I2C_RECOVER_AFTER_ERRORS = 3;   // Folgefehler bis Bus-Recovery
+static constexpr uint8_t  I2C_TASK_PRIORITY        = 5;
+static constexpr uint8_t  I2C_HIST_BUCKETS         = 17;  // log2-µs Buckets, letzter ab 32,8 ms
+
+// ---------------------------- Audio (Task/Mixer) ---------------------------
+static constexpr uint8_t  AUDIO_QUEUE_DEPTH   = 8;    // Cue-Befehle
+static constexpr uint8_t  AUDIO_MAX_VOICES    = 6;    // gleichzeitige Töne
+static constexpr uint16_t AUDIO_BLOCK_SAMPLES = 256;  // = dma_buf_len
+static constexpr uint8_t  AUDIO_ATTACK_MS     = 2;
+static constexpr uint8_t  AUDIO_RELEASE_MS    = 8;
+static constexpr float    AUDIO_VOICE_AMP     = 0.2f;
+static constexpr uint8_t  AUDIO_TASK_PRIORITY = 6;
+static constexpr int      AUDIO_TASK_CORE     = 1;    // Ausgabe-Kern (mit Loop), Core 0 = Eingabe
+static constexpr uint8_t  AUDIO_MAX_CLIP_VOICES  = 2;    // gleichzeitige ADPCM-Clips
+static constexpr uint16_t AUDIO_CLIP_BLOCK_BYTES = 256;  // max. Blockgröße .ima
+static constexpr float    AUDIO_CLIP_GAIN        = 0.5f;
+static constexpr const char* AUDIO_SFX_DIR       = "/sfx";
+
+// ---------------------------- RS485 ----------------------------------------
+static constexpr size_t   RS485_TX_RING_BYTES = 512;   // > MODBUS MAX_ADU
+static constexpr bool     RS485_HW_DIRECTION  = true;  // DE über UART-RTS
+static constexpr size_t   RS485_RX_RING_BYTES = 2048;  // Treiber-Ring (921600 Baud: ~22 ms)
+static constexpr size_t   RS485_FRAME_BYTES   = 256;   // >= Modbus MAX_ADU
+static constexpr uint8_t  RS485_RX_POOL       = 32;    // feste Frame-Puffer: 921600 Baud,
+                                                        // 33-Byte-Zeilen -> ~11 ms Loop-Pause (HUD-Frame)
+static constexpr uint8_t  RS485_RX_TIMEOUT_SYMBOLS = 2; // Trennzeichen-Modus
+
+// ---------------------------- Loop-Scheduler (App::loop) -------------------
+// Perioden/Deadlines in µs; Priorität nur bei gleicher Deadline (höher = zuerst)
+static constexpr uint32_t SCHED_INPUT_US      = 1000;   // nur ohne INPUT_ON_OWN_CORE
+static constexpr uint32_t SCHED_COMM_US       = 1000;   // RS485/Modbus/Telemetrie
+static constexpr uint32_t SCHED_COMM_DL_US    = 2000;
+static constexpr uint32_t SCHED_HUD_US        = 33000;  // ~30 Hz
+static constexpr uint32_t SCHED_HUD_BUDGET_US = 10000;  // darüber: Overrun zählen
+static constexpr uint32_t SCHED_CONSOLE_US    = 10000;
+static constexpr uint32_t SCHED_CONSOLE_DL_US = 50000;
+static constexpr uint32_t SCHED_CPULOAD_US    = 1000000;
+static constexpr uint32_t SCHED_HEAP_US       = 1000000;  // Heap-Blockstand (core/HeapGuard)
+
+// ---------------------------- Stall-Monitor (Loop-Jitter) ------------------
+// Durchlauf länger als ein HUD-Frame im Budget plus Comm-Deadline = Stall;
+// zur Laufzeit änderbar ("stall budget <us>")
+static constexpr uint32_t STALL_BUDGET_US = SCHED_HUD_BUDGET_US + SCHED_COMM_DL_US;
+
+// ---------------------------- Eingabe-Pipeline (Core 0) --------------------
+// Touch/IMU/Gesten in eigenem Task; Übergabe an den Loop per TripleBuffer.
+// false: alles als Scheduler-Job im Loop (Vergleichsmessung "vorher")
+static constexpr bool     INPUT_ON_OWN_CORE   = true;
+static constexpr int      INPUT_TASK_CORE     = 0;
+static constexpr uint8_t  INPUT_TASK_PRIORITY = 4;      // unter I2C (5)
+static constexpr uint32_t INPUT_TOUCH_POLL_US = 5000;   // Poll zusätzlich zum IRQ
+static constexpr uint32_t INPUT_IMU_PERIOD_US = 50000;  // 20 Hz ohne Stream
+static constexpr uint32_t CPULOAD_IDLE_GAP_US = 20;     // Idle-Hook-Abstand = Leerlauf
+
+// ---------------------------- Statischer Betrieb (core/HeapGuard) ---------
+// Nach App::begin() kein Heap mehr. Modus zur Compile-Zeit:
+// -DSTATIC_ALLOC_MODE=0 aus / 1 zählen (Standard) / 2 Abbruch beim ersten Verstoß
+
+// ---------------------------- Boot (App::begin, core/BootSequencer) -------
+// Debug-Wartezeiten nur auf Wunsch: Serial abwarten, Testbild, Nachlauf
+static constexpr bool     BOOT_DEBUG_DELAYS   = false;
+static constexpr uint16_t BOOT_SERIAL_WAIT_MS = 2000;   // nur mit BOOT_DEBUG_DELAYS
+static constexpr uint16_t BOOT_TTFF_TARGET_MS = 200;    // erster HUD-Frame ab App-Start
+static constexpr int      BOOT_DISPLAY_CORE   = 0;      // Display-Init parallel zum Loop-Task
+static constexpr uint8_t  BOOT_POLL_MS        = 2;      // Abfrage paralleler Schritte
+static constexpr uint8_t  TOUCH_RST_LOW_MS    = 50;     // CST328 Reset-Puls
+static constexpr uint8_t  TOUCH_RST_BOOT_MS   = 100;    // Anlaufzeit nach RST high
+static constexpr uint8_t  IMU_RESET_MS        = 10;     // QMI8658 nach Soft-Reset
+static constexpr uint8_t  IMU_ENABLE_MS       = 5;      // nach aEN/gEN
+static constexpr const char* BOOT_NVS_NS      = "boot"; // I²C-Adresskarten je Bus
+
+// ---------------------------- Serielle Konsole ----------------------------
+static constexpr size_t   CONSOLE_LINE_BYTES = 160;  // längere Zeilen werden verworfen
+
+// ---------------------------- Profiling-Zonen (PROF_ZONE) -----------------
+// Abschalten zur Compile-Zeit: -DPROF_ENABLED=0 (siehe core/Profiler.h)
+static constexpr size_t   PROF_RING_EVENTS = 1024;  // je Kern, 2er-Potenz, 12 B je Ereignis
+static constexpr uint8_t  PROF_MAX_TASKS   = 12;    // unterscheidbare Tasks im Trace
+
+// ---------------------------- Speicher-Platzierung (core/Placement) -------
+// Abschalten zur Compile-Zeit: -DPLACEMENT_ENABLED=0 (HOT_FN/HOT_DATA leer)
+static constexpr size_t   PLACE_BULK_FALLBACK_MAX = 16 * 1024;  // Bulk ohne PSRAM intern bis hier
+static constexpr size_t   PLACE_LOG_ENTRIES       = 16;         // Allokationen mit Tag in "place"
+static constexpr uint32_t PLACE_BENCH_FRAMES      = 2000;       // "touch bench" Vorgabe
+
+// ---------------------------- Messdaten-Strom (USB-CDC, binär) -------------
+static constexpr size_t   STREAM_RING_RECORDS  = 256;   // 2er-Potenz, ~400 ms bei 600 Rec/s
+static constexpr size_t   STREAM_CHUNK_BYTES   = 1024;  // Rohgröße je Chunk/Write
+static constexpr uint16_t STREAM_FLUSH_MS      = 20;    // max. Alter des offenen Chunks
+static constexpr uint8_t  STREAM_IMU_PERIOD_MS = 2;     // 500 Hz während des Streams
+static constexpr uint8_t  STREAM_TASK_PRIORITY = 2;     // unter I2C/Audio
+static constexpr int      STREAM_TASK_CORE     = 1;     // I/O-Kern
+
+// ---------------------------- Bildschirm-Spiegel (display/ScreenMirror) ----
+// Schatten 320x240 RGB565 im PSRAM (150 KB), geänderte 16x16-Tiles RLE über
+// USB-CDC (Protokoll: comm/MirrorProto.h, Viewer: tools/mirror_view)
+static constexpr size_t   MIRROR_CHUNK_BYTES     = 2048;    // Rohgröße je Chunk (>= 1 Tile Worst Case)
+static constexpr uint32_t MIRROR_BUDGET_BPS      = 200000;  // Vorgabe, "mirror budget <B/s>"
+static constexpr uint16_t MIRROR_BURST_MS        = 100;     // Bucket-Tiefe in ms Budget
+static constexpr uint16_t MIRROR_KEY_INTERVAL_MS = 5000;    // Vollbild gegen verlorene Chunks
+static constexpr uint8_t  MIRROR_POLL_MS         = 10;      // Task: Nachzügler/Budget prüfen
+static constexpr uint8_t  MIRROR_TASK_PRIORITY   = 1;       // unter allem anderen
+static constexpr int      MIRROR_TASK_CORE       = 0;       // Loop (Kern 1) bleibt frei
+
+// ---------------------------- Telemetrie (RS485, binär) --------------------
+static constexpr size_t   TELEM_MTU       = 128;  // Byte je Frame auf der Leitung
+static constexpr uint16_t TELEM_FLUSH_MS  = 20;   // max. Wartezeit im offenen Frame
+static constexpr uint8_t  TELEM_IMU_BATCH = 4;    // IMU-Proben je Nachricht (20 Hz)
+
+// ---------------------------- Modbus RTU (RS485) ---------------------------
+static constexpr uint8_t  MODBUS_DEFAULT_SLAVE_ID    = 1;
+static constexpr uint16_t MODBUS_RESPONSE_TIMEOUT_MS = 100;
+static constexpr uint8_t  MODBUS_POLL_MAX          = 16;  // Einträge im Abfrageplan
+static constexpr uint8_t  MODBUS_POLL_MAX_DEVICES  = 8;
+static constexpr uint8_t  MODBUS_POLL_MAX_REGS     = 8;   // Register je Abfrage
+static constexpr uint8_t  MODBUS_POLL_RETRIES      = 1;   // sofortige Wiederholungen
+static constexpr uint8_t  MODBUS_OFFLINE_AFTER     = 3;   // Fehler in Folge -> offline
+static constexpr uint8_t  MODBUS_OFFLINE_BACKOFF   = 10;  // Periodenfaktor für offline-Geräte
+
 // ---------------------------- Touch Mapping - KORRIGIERT -------------------
 static constexpr int  TOUCH_RAW_X_MIN = 0;
 static constexpr int  TOUCH_RAW_X_MAX = 4095;  // volle 12-bit Range
@@ -22,20 +146,23 @@ static constexpr bool TOUCH_SWAP_XY   = true;   // wie in deiner funktionierende
 static constexpr bool TOUCH_INVERT_X  = false;
 static constexpr bool TOUCH_INVERT_Y  = true;
 
+// ---------------------------- Touch-Aufnahme (touch/TouchSession) ---------
+// Rohframes delta/varint-kodiert im PSRAM ("touchrec"): ~6 B je Frame mit
+// Finger, Ruhe kostet nichts; rege Bedienung ~120 B/s -> 2 MB reichen ~5 h
+static constexpr size_t   TOUCH_REC_BYTES        = 2 * 1024 * 1024;
+static constexpr uint32_t TOUCH_REPLAY_MAX_CALLS = 256;    // je Eingabe-Schritt bei Tempo 0 (max.)
+static constexpr uint32_t TOUCH_REPLAY_TAIL_MS   = 2000;   // Engine-Ticks nach dem letzten Frame
+
 
-// ---------------------------- Gesten Parameter - OPTIMIERT -----------------
+// ---------------------------- Gesten Parameter -----------------------------
+// Erkennungsschwellen (TAP_*, DOUBLE_TAP_INTERVAL, LONG_PRESS_DURATION,
+// SWIPE_*, TOUCH_SETTLE_MS) stehen in gestures/gesture_params.h, erzeugt von
+// tools/gesture_tune aus gelabelten Aufnahmen
 static constexpr uint8_t  MAX_TOUCH_POINTS    = 5;
-static constexpr uint16_t TAP_MAX_DURATION    = 300; // ms
-static constexpr uint16_t TAP_MAX_MOVEMENT    = 40;  // px - toleranter
-static constexpr uint16_t DOUBLE_TAP_INTERVAL = 500; // ms
-static constexpr uint16_t LONG_PRESS_DURATION = 700; // ms - nicht zu schnell
-static constexpr uint16_t SWIPE_MIN_DISTANCE  = 30;  // px
 // Touch-Qualität
 static constexpr uint16_t TOUCH_MIN_STRENGTH = 0;  // nach Bedarf anpassen
-static constexpr uint16_t TOUCH_SETTLE_MS    = 20;   // ms - mehr Stabilität
 
 // Erweiterte interne Schwellwerte
-static constexpr float SWIPE_AXIS_RATIO  = 1.3f;   
 static constexpr float PINCH_THRESHOLD   = 15.0f;  // px
 static constexpr float ROTATE_THRESHOLD  = 12.0f;  // Grad
 static constexpr float PROXIMITY_TOLER_PX= 60.0f;  // px
\ No newline at end of file
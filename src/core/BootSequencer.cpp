@@ -0,0 +1,64 @@
+// ============================================================================
+// File: src/core/BootSequencer.cpp
+// ----------------------------------------------------------------------------
+#include "BootSequencer.h"
+
+int BootSequencer::add(const char* name, StepFn fn, void* ctx, uint32_t after){
+  if (_count >= MAX_STEPS || !fn || !_now) return -1;
+  if (after >> _count) return -1;               // nur bereits bekannte Vorgänger
+  Step& s = _steps[_count];
+  s = Step{};
+  s.name  = name;
+  s.fn    = fn;
+  s.ctx   = ctx;
+  s.after = after;
+  return (int)_count++;
+}
+
+bool BootSequencer::run(){
+  uint32_t doneMask = 0;
+  bool ok = true;
+  const uint32_t all = _count >= 32 ? UINT32_MAX : ((1u << _count) - 1);
+
+  while (doneMask != all) {
+    // Bereiten Schritt mit der frühesten Freigabe wählen (Reihenfolge = add())
+    int pick = -1;
+    uint32_t nextReady = UINT32_MAX;
+    const uint32_t now = rel();
+    for (size_t i = 0; i < _count; i++) {
+      const Step& s = _steps[i];
+      if (s.finished || (s.after & ~doneMask)) continue;
+      if ((int32_t)(s.readyUs - now) <= 0) {
+        if (pick < 0 || (int32_t)(s.readyUs - _steps[pick].readyUs) < 0) pick = (int)i;
+      } else if (s.readyUs < nextReady) {
+        nextReady = s.readyUs;
+      }
+    }
+    if (pick < 0) {
+      if (nextReady == UINT32_MAX) break;       // Zyklus in den Abhängigkeiten
+      _sleep(nextReady - now);
+      _sleptUs += rel() - now;                  // tatsächlich (Tick-Rundung)
+      continue;
+    }
+
+    Step& s = _steps[pick];
+    const uint32_t t0 = rel();
+    if (!s.started) { s.started = true; s.stats.startUs = t0; }
+    const BootResult r = s.fn(s.ctx, s.phase);
+    const uint32_t t1 = rel();
+    s.stats.activeUs += t1 - t0;
+    if (s.phase < UINT8_MAX) s.phase++;         // kein Rücksprung auf 0 (Pollen > 255 Runden)
+    s.stats.phases = s.phase;
+    if (r.kind == BootResult::Wait) {
+      s.readyUs = t1 + r.waitUs;
+      continue;
+    }
+    s.finished     = true;
+    s.stats.endUs  = t1;
+    s.stats.ok     = r.kind == BootResult::Done;
+    ok            &= s.stats.ok;
+    doneMask      |= 1u << pick;
+  }
+  _totalUs = rel();
+  return ok && doneMask == all;
+}
@@ -0,0 +1,89 @@
+// ============================================================================
+// File: src/core/BootSequencer.h
+// ----------------------------------------------------------------------------
+// Purpose: Boot-Ablauf für App::begin() mit verschränkten Wartezeiten
+//  • Jeder Init-Schritt ist eine kleine Zustandsmaschine: fn(ctx, phase)
+//    liefert "fertig", "Fehler" oder "in N µs mit der nächsten Phase
+//    weiter" (Reset-Pulse, Anlaufzeiten) statt delay()
+//  • phase zählt die Aufrufe und bleibt bei 255 stehen: Schritte, die
+//    pollen, halten ihren Zustand selbst statt phase == 0 zu prüfen
+//  • Während ein Schritt wartet, laufen die anderen; lange blockierende
+//    Arbeit (Display-Init) startet ein Schritt in einem eigenen Task und
+//    fragt sie mit kurzen Wartezeiten ab
+//  • Abhängigkeiten als Bitmaske: ein Schritt startet erst, wenn seine
+//    Vorgänger fertig sind (fehlgeschlagen zählt als fertig)
+//  • Zeitleiste je Schritt: Start, Ende, aktive Zeit, Phasen ("boot")
+//  • Plattformneutral, Zeitquelle und Warten injiziert
+//    (Host-Test: tools/boot_test.cpp)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+struct BootResult {
+  enum Kind : uint8_t { Done, Failed, Wait };
+  Kind     kind;
+  uint32_t waitUs;
+
+  static BootResult done(){ return {Done, 0}; }
+  static BootResult failed(){ return {Failed, 0}; }
+  static BootResult waitUsFor(uint32_t us){ return {Wait, us}; }
+  static BootResult waitMs(uint32_t ms){ return {Wait, ms * 1000u}; }
+  static BootResult of(bool ok){ return ok ? done() : failed(); }
+};
+
+struct BootStepStats {
+  uint32_t startUs = 0;       // erster Aufruf (relativ zum Boot-Beginn)
+  uint32_t endUs = 0;         // fertig/Fehler
+  uint32_t activeUs = 0;      // Summe der Laufzeit in fn (ohne Warten)
+  uint8_t  phases = 0;        // Aufrufe, bei 255 gesättigt
+  bool     ok = false;
+};
+
+class BootSequencer {
+public:
+  static constexpr size_t MAX_STEPS = 12;
+
+  using StepFn = BootResult (*)(void* ctx, uint8_t phase);
+  using Clock  = uint32_t (*)();
+  using Sleep  = void (*)(uint32_t us);
+
+  void begin(Clock now, Sleep sleep){ _now = now; _sleep = sleep; _t0 = now(); }
+
+  // after: Bitmaske der Schritt-IDs, die vorher fertig sein müssen.
+  // Liefert die Schritt-ID oder -1 (voll/ungültig).
+  int add(const char* name, StepFn fn, void* ctx, uint32_t after = 0);
+
+  // Alle Schritte abarbeiten; true = keiner fehlgeschlagen
+  bool run();
+
+  size_t count() const { return _count; }
+  const char* name(int id) const { return _steps[id].name; }
+  const BootStepStats& stats(int id) const { return _steps[id].stats; }
+  uint32_t totalUs() const { return _totalUs; }
+  uint32_t sleptUs() const { return _sleptUs; }   // keiner lauffähig: gewartet
+  uint32_t startUs() const { return _t0; }
+
+private:
+  struct Step {
+    const char* name = nullptr;
+    StepFn      fn = nullptr;
+    void*       ctx = nullptr;
+    uint32_t    after = 0;
+    uint8_t     phase = 0;
+    bool        started = false;
+    bool        finished = false;
+    uint32_t    readyUs = 0;        // nächster Aufruf frühestens (relativ)
+    BootStepStats stats;
+  };
+
+  uint32_t rel() const { return _now() - _t0; }
+
+  Step     _steps[MAX_STEPS];
+  size_t   _count = 0;
+  Clock    _now = nullptr;
+  Sleep    _sleep = nullptr;
+  uint32_t _t0 = 0;
+  uint32_t _totalUs = 0;
+  uint32_t _sleptUs = 0;
+};
@@ -0,0 +1,96 @@
+// ============================================================================
+// File: src/core/CpuLoad.cpp
+// ----------------------------------------------------------------------------
+#include "CpuLoad.h"
+#include <atomic>
+#include <esp_freertos_hooks.h>
+#include <esp_timer.h>
+#include "../config/params.h"
+
+namespace cpuload {
+
+// Je Kern schreibt nur der eigene Idle-Hook
+static std::atomic<uint32_t> s_idleUs[CORES];
+static uint32_t s_lastHookUs[CORES];
+
+static bool     s_active = false;
+static uint32_t s_windowUs = 0;
+static uint32_t s_idleAtWindow[CORES];
+static float    s_percent[CORES];
+
+template <uint8_t CORE>
+static bool IRAM_ATTR idleHook(){
+  const uint32_t now = (uint32_t)esp_timer_get_time();
+  const uint32_t d = now - s_lastHookUs[CORE];
+  s_lastHookUs[CORE] = now;
+  if (d < CPULOAD_IDLE_GAP_US) s_idleUs[CORE].fetch_add(d, std::memory_order_relaxed);
+  return false;                      // weiter aufrufen (kein WFI im Messbetrieb)
+}
+
+bool start(){
+  if (s_active) return true;
+  const uint32_t now = (uint32_t)esp_timer_get_time();
+  for (uint8_t c = 0; c < CORES; c++) {
+    s_lastHookUs[c] = now;
+    s_idleAtWindow[c] = s_idleUs[c].load(std::memory_order_relaxed);
+    s_percent[c] = 0.f;
+  }
+  s_windowUs = now;
+  if (esp_register_freertos_idle_hook_for_cpu(idleHook<0>, 0) != ESP_OK) return false;
+  if (esp_register_freertos_idle_hook_for_cpu(idleHook<1>, 1) != ESP_OK) {
+    esp_deregister_freertos_idle_hook_for_cpu(idleHook<0>, 0);
+    return false;
+  }
+  s_active = true;
+  return true;
+}
+
+void stop(){
+  if (!s_active) return;
+  esp_deregister_freertos_idle_hook_for_cpu(idleHook<0>, 0);
+  esp_deregister_freertos_idle_hook_for_cpu(idleHook<1>, 1);
+  s_active = false;
+}
+
+bool active(){ return s_active; }
+
+void sample(){
+  if (!s_active) return;
+  const uint32_t now = (uint32_t)esp_timer_get_time();
+  const uint32_t dt = now - s_windowUs;
+  if (dt == 0) return;
+  for (uint8_t c = 0; c < CORES; c++) {
+    const uint32_t idle = s_idleUs[c].load(std::memory_order_relaxed);
+    const uint32_t d = idle - s_idleAtWindow[c];
+    s_idleAtWindow[c] = idle;
+    const float busy = 100.f * (1.f - (float)d / (float)dt);
+    s_percent[c] = busy < 0.f ? 0.f : busy;
+  }
+  s_windowUs = now;
+}
+
+float percent(uint8_t core){ return core < CORES ? s_percent[core] : 0.f; }
+
+void print(Print& out){
+  if (!s_active) {
+    out.println("[CPU] Messung aus (\"cpu on\"; verhindert WFI, danach \"cpu off\")");
+    return;
+  }
+  for (uint8_t c = 0; c < CORES; c++) out.printf("[CPU] core%u %5.1f %%\n", c, s_percent[c]);
+}
+
+static constexpr cmd::Command CPU_CMDS[] = {
+  {"cpu", "?b", "[on|off]", [](void*, const cmd::Args& a){
+    if (!a.count) { print(Serial); return; }
+    if (!a.b(0)) { stop(); Serial.println("[CPU] Messung aus"); return; }
+    Serial.println(start() ? "[CPU] Messung an, erste Werte nach ~1 s"
+                           : "[CPU] ERROR: Idle-Hooks nicht registriert");
+  }},
+};
+static_assert(cmd::sorted(CPU_CMDS), "CPU_CMDS nicht sortiert");
+
+void registerCommands(cmd::Registry& r){
+  r.add(CPU_CMDS, nullptr, "cpu");
+}
+
+}  // namespace cpuload
@@ -0,0 +1,32 @@
+// ============================================================================
+// File: src/core/CpuLoad.h
+// ----------------------------------------------------------------------------
+// Purpose: Auslastung je Kern (Core 0: Eingabe/I²C, Core 1: Loop/Display/Audio)
+//  • Idle-Hook je Kern zählt die Zeit, in der der Idle-Task läuft: Abstände
+//    zwischen zwei Hook-Aufrufen < CPULOAD_IDLE_GAP_US gelten als Leerlauf,
+//    größere Lücken als Arbeit anderer Tasks
+//  • Kurze Unterbrechungen (< Schwelle) zählen als Leerlauf, die Last wird
+//    also eher unterschätzt; für Vorher/Nachher-Vergleiche genügt das
+//  • Der Hook kehrt mit false zurück (sonst schläft der Idle-Task per WFI bis
+//    zum nächsten Interrupt und jede Lücke zählt als Arbeit): der Kern
+//    erreicht während der Messung kein WFI. Deshalb nur auf Anforderung
+//    ("cpu on" .. "cpu off"), Hooks sind sonst nicht registriert
+//  • sample() einmal pro Sekunde aus dem Loop, Ausgabe über "cpu"
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include "../comm/CommandTable.h"
+
+namespace cpuload {
+
+static constexpr uint8_t CORES = 2;
+
+bool start();                        // Hooks registrieren, Zähler auf 0
+void stop();                         // Hooks entfernen (Kerne wieder mit WFI)
+bool active();
+void sample();                       // Fenster abschließen (~1 s), nur aktiv
+float percent(uint8_t core);         // letztes Fenster, 0..100
+void print(Print& out);
+void registerCommands(cmd::Registry& r);   // cpu [on|off]
+
+}  // namespace cpuload
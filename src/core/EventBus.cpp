@@ -0,0 +1,131 @@
+// ============================================================================
+// File: src/core/EventBus.cpp
+// ----------------------------------------------------------------------------
+#include "EventBus.h"
+
+void EventBus::begin(Clock now){
+  _now = now;
+  for (uint32_t i = 0; i < QUEUE_DEPTH; i++) _cells[i].seq.store(i, std::memory_order_relaxed);
+  _enqPos.store(0, std::memory_order_relaxed);
+  _deqPos.store(0, std::memory_order_relaxed);
+  resetStats();
+}
+
+bool EventBus::subscribe(const char* name, uint32_t topicMask, Delivery d, Handler fn, void* ctx){
+  topicMask &= (1u << MAX_TOPICS) - 1;
+  if (_subCount >= MAX_SUBS || !fn || !topicMask) return false;
+  const uint8_t idx = (uint8_t)_subCount++;
+  _subs[idx] = Sub{name, topicMask, d, fn, ctx};
+  for (uint8_t t = 0; t < MAX_TOPICS; t++) {
+    if (!(topicMask & (1u << t))) continue;
+    Route& r = _routes[t];
+    if (d == Delivery::Sync) r.sync[r.syncCount++] = idx;
+    else                     r.deferred[r.deferredCount++] = idx;
+  }
+  return true;
+}
+
+void EventBus::raiseMax(std::atomic<uint32_t>& m, uint32_t v){
+  uint32_t cur = m.load(std::memory_order_relaxed);
+  while (v > cur && !m.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+bool EventBus::publish(uint8_t topic, const void* data, size_t len){
+  if (topic >= MAX_TOPICS || len > Event::PAYLOAD_BYTES) return false;
+  const Route& r = _routes[topic];
+  Counters& c = _counters[topic];
+  const uint32_t us = _now ? _now() : 0;
+  c.published.fetch_add(1, std::memory_order_relaxed);
+
+  if (r.syncCount) {
+    Event e;
+    e.topic = topic;
+    e.len   = (uint8_t)len;
+    e.us    = us;
+    memcpy(e.data, data, len);
+    for (uint8_t i = 0; i < r.syncCount; i++) {
+      const Sub& s = _subs[r.sync[i]];
+      s.fn(e, s.ctx);
+    }
+    c.delivered.fetch_add(r.syncCount, std::memory_order_relaxed);
+  }
+  if (!r.deferredCount) return true;
+  // vor dem Einreihen zählen: der Konsument kann sofort zustellen
+  const uint32_t pending = c.pending.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (!enqueue(topic, data, len, us)) {
+    c.pending.fetch_sub(1, std::memory_order_relaxed);
+    c.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  raiseMax(c.pendingHigh, pending);
+  return true;
+}
+
+// Begrenzter Ring mit Sequenz je Slot (mehrere Produzenten): Slot gehört dem
+// Produzenten, dessen CAS auf _enqPos gelingt; seq = pos + 1 gibt ihn frei.
+bool EventBus::enqueue(uint8_t topic, const void* data, size_t len, uint32_t us){
+  uint32_t pos = _enqPos.load(std::memory_order_relaxed);
+  Cell* cell;
+  for (;;) {
+    cell = &_cells[pos & MASK];
+    const uint32_t seq = cell->seq.load(std::memory_order_acquire);
+    const int32_t dif = (int32_t)(seq - pos);
+    if (dif == 0) {
+      if (_enqPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (dif < 0) {
+      return false;                                  // voll
+    } else {
+      pos = _enqPos.load(std::memory_order_relaxed);
+    }
+  }
+  cell->ev.topic = topic;
+  cell->ev.len   = (uint8_t)len;
+  cell->ev.us    = us;
+  memcpy(cell->ev.data, data, len);
+  cell->seq.store(pos + 1, std::memory_order_release);
+  raiseMax(_queueHigh, pos + 1 - _deqPos.load(std::memory_order_relaxed));
+  return true;
+}
+
+size_t EventBus::dispatchPending(size_t max){
+  size_t n = 0;
+  uint32_t pos = _deqPos.load(std::memory_order_relaxed);
+  while (n < max) {
+    Cell& cell = _cells[pos & MASK];
+    if (cell.seq.load(std::memory_order_acquire) != pos + 1) break;   // leer bzw. noch in Arbeit
+    const Event& e = cell.ev;
+    const Route& r = _routes[e.topic];
+    for (uint8_t i = 0; i < r.deferredCount; i++) {
+      const Sub& s = _subs[r.deferred[i]];
+      s.fn(e, s.ctx);
+    }
+    Counters& c = _counters[e.topic];
+    c.delivered.fetch_add(r.deferredCount, std::memory_order_relaxed);
+    c.pending.fetch_sub(1, std::memory_order_relaxed);
+    cell.seq.store(pos + QUEUE_DEPTH, std::memory_order_release);
+    _deqPos.store(++pos, std::memory_order_relaxed);
+    n++;
+  }
+  return n;
+}
+
+BusTopicStats EventBus::topicStats(uint8_t topic) const {
+  BusTopicStats s;
+  if (topic >= MAX_TOPICS) return s;
+  const Counters& c = _counters[topic];
+  s.published   = c.published.load(std::memory_order_relaxed);
+  s.delivered   = c.delivered.load(std::memory_order_relaxed);
+  s.dropped     = c.dropped.load(std::memory_order_relaxed);
+  s.pendingHigh = c.pendingHigh.load(std::memory_order_relaxed);
+  return s;
+}
+
+void EventBus::resetStats(){
+  for (Counters& c : _counters) {
+    c.published.store(0, std::memory_order_relaxed);
+    c.delivered.store(0, std::memory_order_relaxed);
+    c.dropped.store(0, std::memory_order_relaxed);
+    c.pendingHigh.store(c.pending.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  _queueHigh.store(0, std::memory_order_relaxed);
+}
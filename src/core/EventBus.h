@@ -0,0 +1,122 @@
+// ============================================================================
+// File: src/core/EventBus.h
+// ----------------------------------------------------------------------------
+// Purpose: Publish/Subscribe für Touch-, Gesten-, IMU- und Comm-Ereignisse
+//  • Ereignisse: Topic + Nutzlast (bis PAYLOAD_BYTES, trivial kopierbar)
+//  • Abonnenten mit Topic-Maske und Zustellart:
+//     Sync     – im Kontext des Publishers (Eingabe-Task bzw. Loop); nur für
+//                kurze, thread-sichere Handler (Audio-Queue, USB-Ring)
+//     Deferred – gesammelt im Loop über dispatchPending()
+//  • Pool: Die Deferred-Queue ist ein fester Ring aus QUEUE_DEPTH Slots;
+//    publish() reserviert einen Slot per CAS und füllt ihn an Ort und Stelle,
+//    dispatchPending() gibt ihn nach der Zustellung frei (mehrere Publisher,
+//    ein Konsument, kein Lock, keine Allokation). Voll = verworfen + gezählt
+//  • Abonnieren nur während der Initialisierung (vor Start der Tasks)
+//  • Je Topic: veröffentlicht, zugestellt, verworfen, offene Ereignisse
+//    (Höchststand); Queue-Höchststand gesamt
+//  • Plattformneutral (Host-Benchmark: tools/eventbus_bench.cpp)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+struct Event {
+  static constexpr size_t PAYLOAD_BYTES = 40;
+
+  uint8_t  topic = 0;
+  uint8_t  len = 0;
+  uint32_t us = 0;                   // Zeitpunkt des publish()
+  alignas(4) uint8_t data[PAYLOAD_BYTES];
+
+  template <typename T> const T& as() const { return *reinterpret_cast<const T*>(data); }
+};
+
+enum class Delivery : uint8_t { Sync, Deferred };
+
+struct BusTopicStats {
+  uint32_t published = 0;
+  uint32_t delivered = 0;            // Handler-Aufrufe (sync + deferred)
+  uint32_t dropped = 0;              // Queue voll
+  uint32_t pendingHigh = 0;          // offene Deferred-Ereignisse (max)
+};
+
+class EventBus {
+public:
+  static constexpr size_t QUEUE_DEPTH = 64;      // 2er-Potenz
+  static constexpr size_t MAX_SUBS    = 12;
+  static constexpr size_t MAX_TOPICS  = 8;
+
+  using Handler = void (*)(const Event& e, void* ctx);
+  using Clock   = uint32_t (*)();
+
+  void begin(Clock now);
+  // false = voll oder Maske leer
+  bool subscribe(const char* name, uint32_t topicMask, Delivery d, Handler fn, void* ctx);
+
+  template <typename T>
+  bool publish(uint8_t topic, const T& payload){
+    static_assert(std::is_trivially_copyable<T>::value, "Nutzlast muss trivial kopierbar sein");
+    static_assert(sizeof(T) <= Event::PAYLOAD_BYTES, "Nutzlast zu groß");
+    return publish(topic, &payload, sizeof(T));
+  }
+  // false = mindestens ein Deferred-Abonnent verpasst das Ereignis (Queue voll)
+  bool publish(uint8_t topic, const void* data, size_t len);
+
+  // Nur ein Konsument (Loop). Liefert die Zahl zugestellter Ereignisse.
+  size_t dispatchPending(size_t max = QUEUE_DEPTH);
+
+  BusTopicStats topicStats(uint8_t topic) const;
+  uint32_t queueHigh() const { return _queueHigh.load(std::memory_order_relaxed); }
+  size_t subscriberCount() const { return _subCount; }
+  const char* subscriberName(size_t i) const { return _subs[i].name; }
+  uint32_t subscriberMask(size_t i) const { return _subs[i].mask; }
+  Delivery subscriberDelivery(size_t i) const { return _subs[i].delivery; }
+  void resetStats();
+
+private:
+  static constexpr uint32_t MASK = QUEUE_DEPTH - 1;
+  static_assert((QUEUE_DEPTH & MASK) == 0, "QUEUE_DEPTH muss 2er-Potenz sein");
+
+  struct Sub {
+    const char* name = nullptr;
+    uint32_t    mask = 0;
+    Delivery    delivery = Delivery::Sync;
+    Handler     fn = nullptr;
+    void*       ctx = nullptr;
+  };
+  // Je Topic vorberechnete Handler-Listen: Zustellung kostet nur die Treffer
+  struct Route {
+    uint8_t sync[MAX_SUBS];
+    uint8_t syncCount = 0;
+    uint8_t deferred[MAX_SUBS];
+    uint8_t deferredCount = 0;
+  };
+  struct Counters {
+    std::atomic<uint32_t> published{0};
+    std::atomic<uint32_t> delivered{0};
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint32_t> pending{0};
+    std::atomic<uint32_t> pendingHigh{0};
+  };
+  struct Cell {
+    std::atomic<uint32_t> seq{0};
+    Event ev;
+  };
+
+  static void raiseMax(std::atomic<uint32_t>& m, uint32_t v);
+  bool enqueue(uint8_t topic, const void* data, size_t len, uint32_t us);
+
+  Clock    _now = nullptr;
+  Sub      _subs[MAX_SUBS];
+  size_t   _subCount = 0;
+  Route    _routes[MAX_TOPICS];
+  Counters _counters[MAX_TOPICS];
+
+  Cell     _cells[QUEUE_DEPTH];
+  std::atomic<uint32_t> _enqPos{0};
+  std::atomic<uint32_t> _deqPos{0};    // nur der Konsument schreibt
+  std::atomic<uint32_t> _queueHigh{0};
+};
@@ -0,0 +1,53 @@
+// ============================================================================
+// File: src/core/Events.h
+// ----------------------------------------------------------------------------
+// Purpose: Topics und Nutzlasten des Event-Bus (EventBus.h) in dieser App
+//  • Touch   – dekodierter Frame (aktive Slots), Eingabe-Task
+//  • Gesture – GestureEvent, Eingabe-Task (je Aufruf der Engine eines)
+//  • Imu     – IMUData je Probe, Eingabe-Task
+//  • Comm    – Modbus-Schreibzugriff/-Ergebnis, RS485-Textzeile, Loop
+//  publishEvent(bus, payload) leitet das Topic aus dem Typ ab.
+// ============================================================================
+#pragma once
+#include "EventBus.h"
+#include "types.h"
+#include "../config/params.h"
+#include "../imu/QMI8658.h"
+
+enum class Topic : uint8_t { Touch = 0, Gesture, Imu, Comm, Count };
+static_assert((size_t)Topic::Count <= EventBus::MAX_TOPICS, "zu viele Topics");
+
+inline uint32_t topicMask(Topic t){ return 1u << (uint8_t)t; }
+inline const char* topicName(uint8_t t){
+  static const char* const NAMES[] = {"touch", "gesture", "imu", "comm"};
+  return t < (uint8_t)Topic::Count ? NAMES[t] : "?";
+}
+
+struct TouchFrameEvent {
+  uint32_t originUs = 0;              // IRQ-Tag des Frames
+  uint8_t  activeMask = 0;            // Bit i = Slot i aktiv
+  uint8_t  count = 0;
+  uint16_t x[MAX_TOUCH_POINTS] = {0};
+  uint16_t y[MAX_TOUCH_POINTS] = {0};
+  uint16_t strength[MAX_TOUCH_POINTS] = {0};
+};
+
+enum class CommKind : uint8_t { ModbusWrite = 0, ModbusResult, Rs485Line };
+
+struct CommEvent {
+  CommKind kind = CommKind::ModbusWrite;
+  uint8_t  code = 0;                  // ModbusResult bzw. Exception-Code
+  uint16_t addr = 0;                  // Register bzw. Zeilenlänge
+  uint16_t value = 0;
+};
+
+template <typename T> struct TopicOf;
+template <> struct TopicOf<TouchFrameEvent> { static constexpr Topic value = Topic::Touch; };
+template <> struct TopicOf<GestureEvent>    { static constexpr Topic value = Topic::Gesture; };
+template <> struct TopicOf<IMUData>         { static constexpr Topic value = Topic::Imu; };
+template <> struct TopicOf<CommEvent>       { static constexpr Topic value = Topic::Comm; };
+
+template <typename T>
+inline bool publishEvent(EventBus& bus, const T& payload){
+  return bus.publish((uint8_t)TopicOf<T>::value, payload);
+}
@@ -0,0 +1,163 @@
+// ============================================================================
+// File: src/core/HeapGuard.cpp
+// ----------------------------------------------------------------------------
+#include "HeapGuard.h"
+#include <atomic>
+#include <new>
+#include <esp_heap_caps.h>
+
+namespace heapguard {
+
+static std::atomic<bool>     s_sealed{false};
+static std::atomic<uint32_t> s_count{0};
+static std::atomic<uint32_t> s_bytes{0};
+static std::atomic<uint32_t> s_allowed{0};
+
+// Allow gilt nur für den Task, der es angelegt hat (Loop/Konsole)
+static TaskHandle_t s_allowTask = nullptr;
+static uint8_t      s_allowDepth = 0;
+
+// Letzter Verstoß: unter Spinlock, weil Hooks aus allen Tasks kommen
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t     s_lastSize = 0;
+static void*        s_lastCaller = nullptr;
+static char         s_lastTask[16] = "-";
+
+static uint32_t s_blocksAtSeal = 0;
+static uint32_t s_blocksNow = 0;
+static uint32_t s_blocksMax = 0;
+static uint32_t s_grownSamples = 0;     // Stichproben mit mehr Blöcken als bei seal()
+
+static uint32_t allocatedBlocks(){
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_DEFAULT);
+  return (uint32_t)info.allocated_blocks;
+}
+
+void seal(){
+  s_blocksAtSeal = s_blocksNow = s_blocksMax = allocatedBlocks();
+  s_sealed.store(true);
+}
+
+bool sealed(){ return s_sealed.load(std::memory_order_relaxed); }
+
+uint32_t violations(){ return s_count.load(std::memory_order_relaxed); }
+
+void noteAlloc(size_t bytes, void* caller){
+  if (!s_sealed.load(std::memory_order_relaxed)) return;
+  const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  if (s_allowDepth && self == s_allowTask) {
+    s_allowed.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  s_count.fetch_add(1, std::memory_order_relaxed);
+  s_bytes.fetch_add((uint32_t)bytes, std::memory_order_relaxed);
+
+  // Kein snprintf: im Hook darf nichts allokieren
+  const char* name = self ? pcTaskGetName(self) : "-";
+  portENTER_CRITICAL(&s_mux);
+  s_lastSize   = (uint32_t)bytes;
+  s_lastCaller = caller;
+  size_t i = 0;
+  for (; name[i] && i < sizeof(s_lastTask) - 1; i++) s_lastTask[i] = name[i];
+  s_lastTask[i] = '\0';
+  portEXIT_CRITICAL(&s_mux);
+
+#if STATIC_ALLOC_MODE >= 2
+  ets_printf("[HEAP] Allokation nach seal(): %u B in Task %s, Aufrufer %p\n",
+             (unsigned)bytes, s_lastTask, caller);
+  abort();
+#endif
+}
+
+Allow::Allow(){
+  if (s_allowDepth++ == 0) s_allowTask = xTaskGetCurrentTaskHandle();
+}
+
+Allow::~Allow(){
+  if (--s_allowDepth == 0) s_allowTask = nullptr;
+}
+
+void sample(){
+  if (!sealed()) return;
+  s_blocksNow = allocatedBlocks();
+  if (s_blocksNow > s_blocksMax) s_blocksMax = s_blocksNow;
+  if (s_blocksNow > s_blocksAtSeal) s_grownSamples++;
+}
+
+void reset(){
+  s_count.store(0);
+  s_bytes.store(0);
+  s_allowed.store(0);
+  portENTER_CRITICAL(&s_mux);
+  s_lastSize   = 0;
+  s_lastCaller = nullptr;
+  s_lastTask[0] = '-';
+  s_lastTask[1] = '\0';
+  portEXIT_CRITICAL(&s_mux);
+  if (sealed()) s_blocksAtSeal = s_blocksNow = s_blocksMax = allocatedBlocks();
+  s_grownSamples = 0;
+}
+
+void print(Print& out){
+  static const char* const MODES[] = {"aus", "zählen", "Abbruch"};
+  const uint32_t size  = ESP.getHeapSize();
+  const uint32_t freeB = ESP.getFreeHeap();
+  out.printf("[HEAP] Modus=%s (STATIC_ALLOC_MODE=%d) seal=%s\n",
+             MODES[STATIC_ALLOC_MODE < 2 ? STATIC_ALLOC_MODE : 2], STATIC_ALLOC_MODE, sealed() ? "ja" : "nein");
+  out.printf("[HEAP] belegt=%u B Spitze=%u B von %u B, größter freier Block=%u B\n",
+             size - freeB, size - ESP.getMinFreeHeap(), size, ESP.getMaxAllocHeap());
+  out.printf("[HEAP] Blöcke seal=%u jetzt=%u max=%u, Stichproben über seal=%u\n",
+             s_blocksAtSeal, s_blocksNow, s_blocksMax, s_grownSamples);
+  out.printf("[HEAP] nach seal: Allokationen=%u (%u B), Konsole erlaubt=%u\n",
+             s_count.load(), s_bytes.load(), s_allowed.load());
+  portENTER_CRITICAL(&s_mux);
+  const uint32_t lastSize = s_lastSize;
+  void* const caller = s_lastCaller;
+  char task[sizeof(s_lastTask)];
+  memcpy(task, s_lastTask, sizeof(task));
+  portEXIT_CRITICAL(&s_mux);
+  if (s_count.load()) out.printf("[HEAP] letzter Verstoß: %u B in Task %s, Aufrufer %p\n", lastSize, task, caller);
+}
+
+static constexpr cmd::Command HEAP_CMDS[] = {
+  {"heap", "", "", [](void*, const cmd::Args&){ sample(); print(Serial); }},
+  {"heap reset", "", "", [](void*, const cmd::Args&){
+    reset();
+    Serial.println("[HEAP] Zähler zurückgesetzt, Blockstand neu");
+  }},
+};
+static_assert(cmd::sorted(HEAP_CMDS), "HEAP_CMDS nicht sortiert");
+
+void registerCommands(cmd::Registry& r){
+  r.add(HEAP_CMDS, nullptr, "heap");
+}
+
+}  // namespace heapguard
+
+// ---------------------------- Hooks -----------------------------------------
+// Ersetzen die Varianten aus libstdc++; der Simulator zählt stattdessen in
+// seinen malloc-Wrappern (SimHeap.cpp)
+#if STATIC_ALLOC_MODE && !defined(HOSTSIM)
+static void* guardedNew(size_t n, void* caller){
+  heapguard::noteAlloc(n, caller);
+  void* p = malloc(n ? n : 1);
+  if (!p) abort();
+  return p;
+}
+
+void* operator new(size_t n){ return guardedNew(n, __builtin_return_address(0)); }
+void* operator new[](size_t n){ return guardedNew(n, __builtin_return_address(0)); }
+void* operator new(size_t n, const std::nothrow_t&) noexcept {
+  heapguard::noteAlloc(n, __builtin_return_address(0));
+  return malloc(n ? n : 1);
+}
+void* operator new[](size_t n, const std::nothrow_t&) noexcept {
+  heapguard::noteAlloc(n, __builtin_return_address(0));
+  return malloc(n ? n : 1);
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#endif
@@ -0,0 +1,48 @@
+// ============================================================================
+// File: src/core/HeapGuard.h
+// ----------------------------------------------------------------------------
+// Purpose: Statischer Betrieb – kein Heap mehr nach App::begin()
+//  • Laufzeitpuffer liegen statisch oder werden in begin() angelegt (Pools,
+//    Queues, Tasks); seal() am Ende von begin() macht jede weitere
+//    Allokation zum Verstoß
+//  • Hook: globaler operator new/delete (auch Container, std::function).
+//    Verstöße: Anzahl, Bytes, letzter Task + Aufrufer-PC (addr2line)
+//  • malloc/String/FreeRTOS-Objekte haben in Arduino-ESP32 2.x keinen Hook:
+//    sample() vergleicht die belegten Blöcke mit dem Stand bei seal()
+//  • Wasserstand: Heap belegt jetzt / Spitze seit Boot, größter freier Block
+//  • Allow: Konsolenbefehle dürfen (lange printf-Zeilen > 63 Zeichen holen
+//    sich in Print::printf einen Puffer) – nur gezählt, nie abgebrochen
+//  • STATIC_ALLOC_MODE: 0 = aus (nur Wasserstand), 1 = zählen,
+//    2 = Abbruch mit Backtrace beim ersten Verstoß
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include "../comm/CommandTable.h"
+
+#ifndef STATIC_ALLOC_MODE
+  #define STATIC_ALLOC_MODE 1
+#endif
+
+namespace heapguard {
+
+void seal();                          // Ende von App::begin()
+bool sealed();
+void sample();                        // ~1 s aus dem Loop
+// Aus den Allokations-Hooks (Gerät: operator new, Simulator: malloc)
+void noteAlloc(size_t bytes, void* caller);
+uint32_t violations();                // Allokationen nach seal() außerhalb Allow
+
+// Bewusste Allokationen (Konsolenbefehl) im aufrufenden Task zulassen
+class Allow {
+public:
+  Allow();
+  ~Allow();
+  Allow(const Allow&) = delete;
+  Allow& operator=(const Allow&) = delete;
+};
+
+void print(Print& out);
+void reset();
+void registerCommands(cmd::Registry& r);   // heap, heap reset
+
+}  // namespace heapguard
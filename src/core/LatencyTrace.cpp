@@ -0,0 +1,54 @@
+// ============================================================================
+// File: src/core/LatencyTrace.cpp
+// ----------------------------------------------------------------------------
+#include "LatencyTrace.h"
+#include "LogHistogram.h"
+
+namespace latency {
+
+using Histogram = LogHistogram<2, BUCKETS>;   // < 4 µs linear, 4 Stufen je Oktave
+
+static Histogram s_hist[(size_t)LatStage::Count];
+
+static const char* const STAGE_NAMES[] = {
+  "irq->frame", "frame->gesture", "gesture->audio",
+  "gesture->display", "irq->audio", "irq->display"
+};
+
+void record(LatStage stage, uint32_t us){
+  s_hist[(size_t)stage].add(us);
+}
+
+uint32_t percentile(LatStage stage, float p){
+  return s_hist[(size_t)stage].percentile(p);
+}
+
+void print(Print& out){
+  out.println("[LAT] stage              count      p50      p95      p99      max     mean (us)");
+  for (size_t i = 0; i < (size_t)LatStage::Count; i++) {
+    const Histogram& h = s_hist[i];
+    LatStage st = (LatStage)i;
+    out.printf("[LAT] %-16s %8u %8u %8u %8u %8u %8u\n", STAGE_NAMES[i], h.count,
+               percentile(st, 0.50f), percentile(st, 0.95f), percentile(st, 0.99f),
+               h.max, h.mean());
+  }
+}
+
+void reset(){
+  for (auto& h : s_hist) h.clear();
+}
+
+static constexpr cmd::Command LATENCY_CMDS[] = {
+  {"latency", "", "", [](void*, const cmd::Args&){ print(Serial); }},
+  {"latency reset", "", "", [](void*, const cmd::Args&){
+    reset();
+    Serial.println("[LAT] Histograms reset");
+  }},
+};
+static_assert(cmd::sorted(LATENCY_CMDS), "LATENCY_CMDS nicht sortiert");
+
+void registerCommands(cmd::Registry& r){
+  r.add(LATENCY_CMDS, nullptr, "latency");
+}
+
+}  // namespace latency
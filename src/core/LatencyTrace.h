@@ -0,0 +1,35 @@
+// ============================================================================
+// File: src/core/LatencyTrace.h
+// ----------------------------------------------------------------------------
+// Purpose: Latenz-Tracing Touch-IRQ -> Geste -> Audio / Display
+//  • Jeder Touch-Frame trägt den IRQ-Zeitstempel (µs); er wandert über das
+//    GestureEvent (origin_us) bis zur Audio-Ausgabe und zum fertigen HUD
+//  • Pro Stufe ein log-lineares Histogramm (4 Buckets/Oktave, ~25 %),
+//    daraus p50/p95/p99 – Ausgabe über die Konsole ("latency")
+//  • Jede Stufe hat genau einen Schreiber (Loop bzw. Audio-Task)
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include "../comm/CommandTable.h"
+
+enum class LatStage : uint8_t {
+  IrqToFrame = 0,     // INT-Flanke (bzw. Poll) -> Frame dekodiert
+  FrameToGesture,     // Frame dekodiert -> GestureEvent
+  GestureToAudio,     // GestureEvent -> erster Cue-Block an I2S übergeben
+  GestureToDisplay,   // GestureEvent -> HUD mit dieser Geste fertig gezeichnet
+  IrqToAudio,         // Ende-zu-Ende Audio
+  IrqToDisplay,       // Ende-zu-Ende Display
+  Count
+};
+
+namespace latency {
+
+static constexpr uint8_t BUCKETS = 92;   // 1 µs .. ~16 s
+
+void record(LatStage stage, uint32_t us);
+uint32_t percentile(LatStage stage, float p);
+void print(Print& out);
+void reset();
+void registerCommands(cmd::Registry& r);   // latency [reset]
+
+}  // namespace latency
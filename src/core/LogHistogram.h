@@ -0,0 +1,66 @@
+// ============================================================================
+// File: src/core/LogHistogram.h
+// ----------------------------------------------------------------------------
+// Purpose: Log-lineares Histogramm für Zeiten in µs (Latenz-Trace, Loop-
+//          Jitter, I²C-Buszeit)
+//  • Werte < 2^SUB_BITS linear, darüber 2^SUB_BITS Stufen je Zweierpotenz:
+//    SUB_BITS = 2 -> 4 Stufen (~25 %), SUB_BITS = 0 -> reine log2-Buckets
+//  • Letzter Bucket sammelt alles darüber (Sättigung); Perzentile aus dem
+//    Bucket-Walk, nach oben durch max begrenzt
+//  • Ein Schreiber je Histogramm, keine Sperren; plattformneutral
+// ============================================================================
+#pragma once
+#include <stdint.h>
+
+template <uint8_t SUB_BITS, uint8_t BUCKETS>
+struct LogHistogram {
+  static constexpr uint32_t SUB = 1u << SUB_BITS;
+  static_assert(BUCKETS > SUB, "LogHistogram: zu wenige Buckets");
+
+  uint32_t count = 0;
+  uint32_t max = 0;
+  uint64_t sum = 0;
+  uint32_t bins[BUCKETS] = {0};
+
+  static uint8_t bucketOf(uint32_t v){
+    if (v < SUB) return (uint8_t)v;
+    const uint32_t e = 31 - __builtin_clz(v);
+    const uint32_t b = SUB + (e - SUB_BITS) * SUB + ((v >> (e - SUB_BITS)) & (SUB - 1));
+    return (uint8_t)(b < BUCKETS ? b : BUCKETS - 1);
+  }
+
+  // Größter Wert des Buckets (ohne Sättigung)
+  static uint32_t bucketUpper(uint8_t b){
+    if (b < SUB) return b;
+    const uint32_t e   = (b - SUB) / SUB + SUB_BITS;
+    const uint32_t sub = (b - SUB) % SUB;
+    return ((SUB + 1 + sub) << (e - SUB_BITS)) - 1;
+  }
+
+  void add(uint32_t v){
+    count++;
+    sum += v;
+    if (v > max) max = v;
+    bins[bucketOf(v)]++;
+  }
+
+  uint32_t mean() const { return count ? (uint32_t)(sum / count) : 0; }
+
+  // p = 0..1; Obergrenze des Buckets, in dem das p-Quantil liegt
+  uint32_t percentile(float p) const {
+    if (count == 0) return 0;
+    uint32_t target = (uint32_t)(p * (float)count + 0.999f);
+    if (target == 0) target = 1;
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < BUCKETS - 1; b++) {
+      seen += bins[b];
+      if (seen >= target) {
+        const uint32_t up = bucketUpper(b);
+        return up < max ? up : max;
+      }
+    }
+    return max;                              // letzter Bucket: gesättigt
+  }
+
+  void clear(){ *this = LogHistogram{}; }
+};
@@ -0,0 +1,127 @@
+// ============================================================================
+// File: src/core/Placement.cpp
+// ----------------------------------------------------------------------------
+#include "Placement.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "../comm/CommandTable.h"
+#include "../config/params.h"
+
+namespace place {
+
+static constexpr const char* MEM_NAMES[] = {"Hot", "Dma", "Bulk"};
+static_assert(sizeof(MEM_NAMES) / sizeof(MEM_NAMES[0]) == (size_t)Mem::Count, "MEM_NAMES unvollständig");
+
+static constexpr uint32_t CAPS_INTERNAL = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+static constexpr uint32_t CAPS_DMA      = MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+static constexpr uint32_t CAPS_PSRAM    = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+
+struct ClassStats {
+  uint16_t blocks = 0;
+  uint32_t bytes = 0;
+  uint16_t failed = 0;
+  uint16_t fallback = 0;       // Bulk ohne PSRAM intern angelegt
+};
+
+struct Entry {
+  void*       p = nullptr;
+  const char* tag = nullptr;
+  uint32_t    bytes = 0;
+  Mem         mem = Mem::Hot;
+  bool        psram = false;
+};
+
+// Nur aus begin()-Phasen bzw. dem Loop: kein Lock
+static ClassStats s_stats[(size_t)Mem::Count];
+static Entry      s_log[PLACE_LOG_ENTRIES];
+static uint16_t   s_dropped = 0;          // Log voll
+
+static void note(void* p, size_t bytes, Mem mem, const char* tag, bool psram){
+  ClassStats& s = s_stats[(size_t)mem];
+  s.blocks++;
+  s.bytes += (uint32_t)bytes;
+  for (Entry& e : s_log) {
+    if (e.p) continue;
+    e = Entry{p, tag, (uint32_t)bytes, mem, psram};
+    return;
+  }
+  s_dropped++;
+}
+
+void* alloc(size_t bytes, Mem mem, const char* tag){
+  if (mem >= Mem::Count || bytes == 0) return nullptr;
+  void* p = nullptr;
+  bool psram = false;
+  switch (mem) {
+    case Mem::Hot: p = heap_caps_malloc(bytes, CAPS_INTERNAL); break;
+    case Mem::Dma: p = heap_caps_malloc(bytes, CAPS_DMA); break;
+    default:
+      p = heap_caps_malloc(bytes, CAPS_PSRAM);
+      psram = p != nullptr;
+      // Ohne PSRAM nur kleine Puffer intern – große würden den heißen Pfad verdrängen
+      if (!p && bytes <= PLACE_BULK_FALLBACK_MAX) {
+        p = heap_caps_malloc(bytes, CAPS_INTERNAL);
+        if (p) s_stats[(size_t)mem].fallback++;
+      }
+      break;
+  }
+  if (!p) {
+    s_stats[(size_t)mem].failed++;
+    Serial.printf("[PLACE] %s: %u B (%s) nicht verfügbar\n", tag ? tag : "-", (unsigned)bytes, MEM_NAMES[(size_t)mem]);
+    return nullptr;
+  }
+  note(p, bytes, mem, tag, psram);
+  return p;
+}
+
+void free(void* p){
+  if (!p) return;
+  for (Entry& e : s_log) {
+    if (e.p != p) continue;
+    ClassStats& s = s_stats[(size_t)e.mem];
+    s.blocks--;
+    s.bytes -= e.bytes;
+    e = Entry{};
+    break;
+  }
+  heap_caps_free(p);
+}
+
+static void printRegion(Print& out, const char* name, uint32_t caps){
+  const size_t total = heap_caps_get_total_size(caps);
+  if (!total) { out.printf("[PLACE] %-6s nicht vorhanden\n", name); return; }
+  const size_t freeB = heap_caps_get_free_size(caps);
+  out.printf("[PLACE] %-6s frei %7u von %7u B (%4.1f %% belegt), größter Block %u B\n",
+             name, (unsigned)freeB, (unsigned)total, 100.f * (total - freeB) / total,
+             (unsigned)heap_caps_get_largest_free_block(caps));
+}
+
+void print(Print& out){
+  out.printf("[PLACE] HOT_FN/HOT_DATA %s (PLACEMENT_ENABLED=%d)\n",
+             PLACEMENT_ACTIVE ? "IRAM/DRAM" : "aus", PLACEMENT_ENABLED);
+  printRegion(out, "intern", CAPS_INTERNAL);
+  printRegion(out, "DMA", CAPS_DMA);
+  printRegion(out, "PSRAM", CAPS_PSRAM);
+  for (size_t m = 0; m < (size_t)Mem::Count; m++) {
+    const ClassStats& s = s_stats[m];
+    out.printf("[PLACE] %-4s %u Blöcke, %u B, fehlgeschlagen %u, intern statt PSRAM %u\n",
+               MEM_NAMES[m], s.blocks, (unsigned)s.bytes, s.failed, s.fallback);
+  }
+  for (const Entry& e : s_log) {
+    if (!e.p) continue;
+    out.printf("[PLACE]   %-12s %-4s %8u B %s\n", e.tag ? e.tag : "-", MEM_NAMES[(size_t)e.mem],
+               (unsigned)e.bytes, e.psram ? "PSRAM" : "intern");
+  }
+  if (s_dropped) out.printf("[PLACE]   (+%u ohne Eintrag)\n", s_dropped);
+}
+
+static constexpr cmd::Command PLACE_CMDS[] = {
+  {"place", "", "", [](void*, const cmd::Args&){ print(Serial); }},
+};
+static_assert(cmd::sorted(PLACE_CMDS), "PLACE_CMDS nicht sortiert");
+
+void registerCommands(cmd::Registry& r){
+  r.add(PLACE_CMDS, nullptr, "place");
+}
+
+}  // namespace place
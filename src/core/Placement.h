@@ -0,0 +1,58 @@
+// ============================================================================
+// File: src/core/Placement.h
+// ----------------------------------------------------------------------------
+// Purpose: Speicher-Platzierung – heißer Pfad intern, Massendaten im PSRAM
+//  • HOT_FN: Code im IRAM (Touch-Dekodierung -> Tracker -> Gesten, Audio-
+//    Synthese). Läuft dann ohne Cache-Fehlzugriffe, auch wenn Flash oder
+//    PSRAM gerade belegt sind. Macht Funktionen NICHT cache-sicher wie ein
+//    ISR: Aufrufe in Flash-Code (libm, printf) und Konstanten im Flash
+//    bleiben erlaubt
+//  • HOT_DATA: konstante Tabellen im DRAM statt .rodata im Flash. Statische
+//    Variablen liegen ohnehin intern
+//  • place::alloc(): Klasse statt Caps – Hot (intern), Dma (intern, DMA-
+//    fähig), Bulk (PSRAM; ohne PSRAM bis PLACE_BULK_FALLBACK_MAX intern).
+//    Nur in begin()-Phasen (vor heapguard::seal)
+//  • Belegung je Region: zur Laufzeit "place", statisch aus der Linker-Map
+//    mit tools/mapreport
+//  • PLACEMENT_ENABLED=0 lässt HOT_FN/HOT_DATA leer (Vergleich "touch bench")
+//  • Makros plattformneutral (Dds, ImaAdpcm, Gesten laufen auch auf dem Host)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef PLACEMENT_ENABLED
+  #define PLACEMENT_ENABLED 1
+#endif
+
+#if defined(ESP_PLATFORM) && PLACEMENT_ENABLED
+  #include <esp_attr.h>
+  #define HOT_FN   IRAM_ATTR
+  #define HOT_DATA DRAM_ATTR
+  #define PLACEMENT_ACTIVE 1
+#else
+  #define HOT_FN
+  #define HOT_DATA
+  #define PLACEMENT_ACTIVE 0
+#endif
+
+class Print;
+namespace cmd { class Registry; }
+
+namespace place {
+
+enum class Mem : uint8_t {
+  Hot = 0,      // Zustand im heißen Pfad, klein
+  Dma,          // Puffer für Peripherie-DMA
+  Bulk,         // Bilder, Audio, Aufnahmen, Ringe
+  Count
+};
+
+// nullptr, wenn die Klasse keinen Platz hat; tag erscheint in "place"
+void* alloc(size_t bytes, Mem mem, const char* tag);
+void  free(void* p);
+
+void print(Print& out);
+void registerCommands(cmd::Registry& r);   // place
+
+}  // namespace place
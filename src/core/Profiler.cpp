@@ -0,0 +1,192 @@
+// ============================================================================
+// File: src/core/Profiler.cpp
+// ----------------------------------------------------------------------------
+#include "Profiler.h"
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace prof {
+
+static const char* const ZONE_NAMES[] = {
+  "touch", "gesture", "imu", "input", "hud", "console",
+  "rs485.write", "rs485.rx", "modbus", "i2c", "audio"
+};
+static_assert(sizeof(ZONE_NAMES) / sizeof(ZONE_NAMES[0]) == (size_t)ProfZone::Count, "ZONE_NAMES");
+
+static constexpr uint8_t CORES = 2;
+
+#if PROF_ENABLED
+static_assert((PROF_RING_EVENTS & (PROF_RING_EVENTS - 1)) == 0, "PROF_RING_EVENTS muss 2er-Potenz sein");
+static constexpr uint32_t MASK        = PROF_RING_EVENTS - 1;
+static constexpr uint32_t REF_EVERY   = 256;   // Bezugspaar alle n Ereignisse erneuern
+static constexpr uint8_t  NO_TASK     = 0xFF;
+
+struct Event {
+  uint32_t start;       // CCOUNT des Kerns
+  uint32_t cycles;
+  uint8_t  zone;
+  uint8_t  task;        // Index in s_tasks
+};
+
+struct ZoneAgg {
+  uint32_t count = 0;
+  uint32_t min = UINT32_MAX;
+  uint32_t max = 0;
+  uint64_t sum = 0;
+};
+
+// Ein Ring je Kern: Tasks desselben Kerns können sich verdrängen, daher
+// vergibt fetch_add die Plätze; kernübergreifend gibt es keine Schreiber.
+// Die Aggregate (mehrere Felder je Zone) schützt eine kurze Sperre je Kern.
+struct CoreRing {
+  std::atomic<uint32_t> head{0};
+  Event    ev[PROF_RING_EVENTS];
+  uint32_t refCycles = 0;
+  uint32_t refUs = 0;
+  portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+  ZoneAgg  agg[(size_t)ProfZone::Count];
+};
+
+struct TaskSlot {
+  TaskHandle_t handle = nullptr;
+  char         name[16] = {0};
+};
+
+static CoreRing          s_ring[CORES];
+static TaskSlot          s_tasks[PROF_MAX_TASKS];
+static std::atomic<bool> s_capture{true};
+static std::atomic<uint32_t> s_migrated{0};
+static portMUX_TYPE      s_taskMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Aufrufender Task -> kleiner Index; neue Tasks einmalig unter Sperre
+static uint8_t taskIndex(){
+  const TaskHandle_t h = xTaskGetCurrentTaskHandle();
+  for (uint8_t i = 0; i < PROF_MAX_TASKS; i++) {
+    if (s_tasks[i].handle == h) return i;
+    if (!s_tasks[i].handle) break;
+  }
+  uint8_t idx = NO_TASK;
+  portENTER_CRITICAL(&s_taskMux);
+  for (uint8_t i = 0; i < PROF_MAX_TASKS; i++) {
+    if (s_tasks[i].handle == h) { idx = i; break; }
+    if (!s_tasks[i].handle) {
+      const char* name = pcTaskGetName(h);   // kein snprintf unter Sperre
+      size_t k = 0;
+      for (; name[k] && k < sizeof(s_tasks[i].name) - 1; k++) s_tasks[i].name[k] = name[k];
+      s_tasks[i].name[k] = '\0';
+      s_tasks[i].handle = h;
+      idx = i;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&s_taskMux);
+  return idx;
+}
+
+void record(ProfZone zone, uint32_t startCycles, uint32_t endCycles, uint8_t startCore){
+  if (!s_capture.load(std::memory_order_relaxed)) return;
+  const uint32_t core = (uint32_t)xPortGetCoreID() % CORES;
+  if (core != startCore) {                 // CCOUNT zweier Kerne: nicht vergleichbar
+    s_migrated.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  CoreRing& r = s_ring[core];
+  const uint32_t cycles = endCycles - startCycles;
+  const uint32_t slot = r.head.fetch_add(1, std::memory_order_relaxed);
+  Event& e = r.ev[slot & MASK];
+  e.start  = startCycles;
+  e.cycles = cycles;
+  e.zone   = (uint8_t)zone;
+  e.task   = taskIndex();
+  if ((slot % REF_EVERY) == 0) {
+    r.refUs     = micros();
+    r.refCycles = ESP.getCycleCount();
+  }
+
+  ZoneAgg& a = r.agg[(size_t)zone];
+  portENTER_CRITICAL(&r.mux);
+  a.count++;
+  a.sum += cycles;
+  if (cycles < a.min) a.min = cycles;
+  if (cycles > a.max) a.max = cycles;
+  portEXIT_CRITICAL(&r.mux);
+}
+
+void print(Print& out){
+  const float mhz = (float)ESP.getCpuFreqMHz();
+  out.println("[PROF] zone        core    count    min us   mean us    max us");
+  for (uint8_t c = 0; c < CORES; c++) {
+    for (size_t z = 0; z < (size_t)ProfZone::Count; z++) {
+      portENTER_CRITICAL(&s_ring[c].mux);
+      const ZoneAgg a = s_ring[c].agg[z];
+      portEXIT_CRITICAL(&s_ring[c].mux);
+      if (!a.count) continue;
+      out.printf("[PROF] %-11s %4u %8u %9.1f %9.1f %9.1f\n", ZONE_NAMES[z], c, a.count,
+                 a.min / mhz, (float)((double)a.sum / a.count) / mhz, a.max / mhz);
+    }
+  }
+  if (const uint32_t m = s_migrated.load()) out.printf("[PROF] verworfen (Kernwechsel in der Zone): %u\n", m);
+}
+
+// Textformat (eine Zeile je Eintrag, Zahlen dezimal):
+//   [PROF] begin mhz=<MHz> cores=<n>
+//   [PROF] zone <id> <name>        [PROF] task <id> <name>
+//   [PROF] ref <core> <cycles> <us>
+//   [PROF] ev <core> <task> <zone> <startCycles> <cycles>
+//   [PROF] end events=<n>
+void dump(Print& out){
+  s_capture.store(false);                  // Fenster einfrieren
+  delay(1);                                // laufende record()-Aufrufe abschließen lassen
+  out.printf("[PROF] begin mhz=%u cores=%u\n", (unsigned)ESP.getCpuFreqMHz(), (unsigned)CORES);
+  for (size_t z = 0; z < (size_t)ProfZone::Count; z++) out.printf("[PROF] zone %u %s\n", (unsigned)z, ZONE_NAMES[z]);
+  for (uint8_t i = 0; i < PROF_MAX_TASKS && s_tasks[i].handle; i++) out.printf("[PROF] task %u %s\n", i, s_tasks[i].name);
+  uint32_t total = 0;
+  for (uint8_t c = 0; c < CORES; c++) {
+    const CoreRing& r = s_ring[c];
+    const uint32_t head = r.head.load();
+    const uint32_t n = head < PROF_RING_EVENTS ? head : PROF_RING_EVENTS;
+    out.printf("[PROF] ref %u %u %u\n", c, r.refCycles, r.refUs);
+    for (uint32_t i = head - n; i != head; i++) {
+      const Event& e = r.ev[i & MASK];
+      out.printf("[PROF] ev %u %u %u %u %u\n", c, e.task, e.zone, e.start, e.cycles);
+    }
+    total += n;
+  }
+  out.printf("[PROF] end events=%u\n", total);
+  s_capture.store(true);
+}
+
+void reset(){
+  s_capture.store(false);
+  delay(1);
+  for (auto& r : s_ring) {
+    r.head.store(0);
+    portENTER_CRITICAL(&r.mux);
+    for (auto& a : r.agg) a = ZoneAgg{};
+    portEXIT_CRITICAL(&r.mux);
+  }
+  s_migrated.store(0);
+  s_capture.store(true);
+}
+#else
+void print(Print& out){ out.println("[PROF] aus (PROF_ENABLED=0)"); }
+void dump(Print& out){ print(out); }
+void reset(){}
+#endif
+
+static constexpr cmd::Command PROF_CMDS[] = {
+  {"prof", "", "", [](void*, const cmd::Args&){ print(Serial); }},
+  {"prof dump", "", "", [](void*, const cmd::Args&){ dump(Serial); }},
+  {"prof reset", "", "", [](void*, const cmd::Args&){
+    reset();
+    Serial.println("[PROF] reset");
+  }},
+};
+static_assert(cmd::sorted(PROF_CMDS), "PROF_CMDS nicht sortiert");
+
+void registerCommands(cmd::Registry& r){
+  r.add(PROF_CMDS, nullptr, "prof");
+}
+
+}  // namespace prof
@@ -0,0 +1,72 @@
+// ============================================================================
+// File: src/core/Profiler.h
+// ----------------------------------------------------------------------------
+// Purpose: Profiling-Zonen mit Zyklenzähler (CCOUNT)
+//  • PROF_ZONE(ProfZone::Hud) misst den umgebenden Block (RAII) und legt
+//    Start + Dauer in Zyklen in den Ring des ausführenden Kerns
+//  • Je Kern und Zone: Anzahl, Min/Mittel/Max ("prof")
+//  • CCOUNT ist je Kern: wandert der Task innerhalb der Zone auf den anderen
+//    Kern (nicht gepinnte Tasks), ist die Differenz wertlos – die Probe wird
+//    verworfen und nur gezählt ("migriert")
+//  • "prof dump" gibt das Fenster der letzten PROF_RING_EVENTS Ereignisse
+//    je Kern als Text aus; tools/prof2trace macht daraus Chrome-Trace-JSON
+//    (Perfetto/chrome://tracing)
+//  • CCOUNT läuft je Kern getrennt: jeder Ring führt ein Bezugspaar
+//    (Zyklen, micros()) mit, der Host rechnet damit auf eine Zeitachse um
+//  • PROF_ENABLED=0: PROF_ZONE erzeugt keinen Code, Befehle melden "aus"
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include "../config/params.h"
+#include "../comm/CommandTable.h"
+
+#ifndef PROF_ENABLED
+  #define PROF_ENABLED 1
+#endif
+
+enum class ProfZone : uint8_t {
+  Touch = 0,        // CST328: Frame lesen/dekodieren
+  Gesture,          // GestureEngine::process
+  Imu,              // QMI8658: Burst lesen/dekodieren
+  InputStep,        // App::inputStep (Eingabe-Task bzw. Loop-Job)
+  Hud,              // DisplayManager::renderHUD
+  Console,          // Konsolenbefehl ausführen
+  Rs485Write,       // RS485Bus::write
+  Rs485Rx,          // RS485Bus::onRxEvent (uart_event-Task)
+  Modbus,           // Modbus-Frame bearbeiten (Slave/Master)
+  I2C,              // I2C-Worker: ein Deskriptor
+  Audio,            // AudioI2S: Block rendern
+  Count
+};
+
+namespace prof {
+
+#if PROF_ENABLED
+// startCore = Kern beim Start; weicht der aktuelle ab, wird verworfen
+void record(ProfZone zone, uint32_t startCycles, uint32_t endCycles, uint8_t startCore);
+
+class Scope {
+public:
+  explicit Scope(ProfZone zone) : _zone(zone), _core((uint8_t)xPortGetCoreID()), _start(ESP.getCycleCount()) {}
+  ~Scope(){ record(_zone, _start, ESP.getCycleCount(), _core); }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+private:
+  ProfZone _zone;
+  uint8_t  _core;
+  uint32_t _start;
+};
+
+  #define PROF_CAT2(a, b) a##b
+  #define PROF_CAT(a, b)  PROF_CAT2(a, b)
+  #define PROF_ZONE(zone) prof::Scope PROF_CAT(_profScope, __LINE__)(zone)
+#else
+  #define PROF_ZONE(zone) do {} while (0)
+#endif
+
+void print(Print& out);            // Aggregate je Kern/Zone
+void dump(Print& out);             // Ereignisfenster für tools/prof2trace
+void reset();
+void registerCommands(cmd::Registry& r);   // prof [dump|reset]
+
+}  // namespace prof
@@ -0,0 +1,141 @@
+// ============================================================================
+// File: src/core/Scheduler.cpp
+// ----------------------------------------------------------------------------
+#include "Scheduler.h"
+
+int Scheduler::add(const char* name, JobFn fn, void* ctx, uint32_t periodUs, uint32_t deadlineUs,
+                   uint8_t priority, uint32_t budgetUs){
+  if (_count >= MAX_JOBS || !fn || !_now) return -1;
+  if (deadlineUs == 0) deadlineUs = periodUs;
+  if (deadlineUs == 0) return -1;               // Ereignisjob ohne Deadline
+  Job& j = _jobs[_count];
+  j = Job{};
+  j.name       = name;
+  j.fn         = fn;
+  j.ctx        = ctx;
+  j.periodUs   = periodUs;
+  j.deadlineUs = deadlineUs;
+  j.budgetUs   = budgetUs;
+  j.priority   = priority;
+  j.nextUs     = _now();                        // periodisch: sofort erste Freigabe
+  return (int)_count++;
+}
+
+void Scheduler::setPeriod(int id, uint32_t periodUs){
+  if (id < 0 || (size_t)id >= _count || _jobs[id].periodUs == periodUs) return;
+  Job& j = _jobs[id];
+  const bool deadlineFollows = j.deadlineUs == j.periodUs;
+  j.periodUs = periodUs;
+  if (deadlineFollows && periodUs) j.deadlineUs = periodUs;
+  j.nextUs = _now() + periodUs;
+}
+
+void Scheduler::trigger(int id){
+  if (id < 0 || (size_t)id >= _count) return;
+  Job& j = _jobs[id];
+  if (j.ready) return;
+  j.ready     = true;
+  j.releaseUs = _now();
+}
+
+// Periodische Freigaben nachziehen (ohne Drift: nextUs += Periode)
+void Scheduler::release(uint32_t now){
+  for (size_t i = 0; i < _count; i++) {
+    Job& j = _jobs[i];
+    if (!j.periodUs || (int32_t)(now - j.nextUs) < 0) continue;
+    if (j.ready) {
+      // Vorige Freigabe läuft noch nicht: Periode verfällt
+      j.stats.skipped++;
+    } else {
+      j.ready     = true;
+      j.releaseUs = j.nextUs;
+    }
+    j.nextUs += j.periodUs;
+    // Weit zurückgefallen (z.B. nach langem Block): Raster neu ansetzen
+    if ((int32_t)(now - j.nextUs) >= 0) {
+      j.stats.skipped += (now - j.nextUs) / j.periodUs + 1;
+      j.nextUs = now + j.periodUs;
+    }
+  }
+}
+
+int Scheduler::pick(uint32_t skipMask) const {
+  int best = -1;
+  uint32_t bestDl = 0;
+  for (size_t i = 0; i < _count; i++) {
+    const Job& j = _jobs[i];
+    if (!j.ready || (skipMask & (1u << i))) continue;
+    const uint32_t dl = j.releaseUs + j.deadlineUs;
+    if (best < 0) { best = (int)i; bestDl = dl; continue; }
+    const int32_t diff = (int32_t)(dl - bestDl);
+    if (diff < 0 || (diff == 0 && j.priority > _jobs[best].priority)) {
+      best = (int)i;
+      bestDl = dl;
+    }
+  }
+  return best;
+}
+
+int Scheduler::runOne(){
+  const uint32_t now = _now();
+  release(now);
+  const int id = pick();
+  if (id >= 0) execute(id, now);
+  return id;
+}
+
+void Scheduler::execute(int id, uint32_t now){
+  Job& j = _jobs[id];
+  j.ready = false;
+  const uint32_t late = now - j.releaseUs;
+  j.fn(j.ctx);
+  const uint32_t end = _now();
+  const uint32_t run = end - now;
+
+  JobStats& s = j.stats;
+  s.runs++;
+  s.runLastUs  = run;
+  s.runSumUs  += run;
+  s.lateSumUs += late;
+  if (run > s.runMaxUs) s.runMaxUs = run;
+  if (late > s.lateMaxUs) s.lateMaxUs = late;
+  if (end - j.releaseUs > j.deadlineUs) s.misses++;
+  if (j.budgetUs && run > j.budgetUs) s.overruns++;
+}
+
+size_t Scheduler::runReady(){
+  // Begrenzung: ein Job mit Periode < Laufzeit darf den Loop nicht festhalten.
+  // Schon gelaufene Jobs bleiben für diesen Durchgang ausgeblendet, auch wenn
+  // sie inzwischen neu freigegeben wurden.
+  static_assert(MAX_JOBS <= 32, "runReady: Bitmaske zu klein");
+  uint32_t ran = 0;
+  size_t n = 0;
+  for (;;) {
+    const uint32_t now = _now();
+    release(now);
+    const int id = pick(ran);
+    if (id < 0) break;
+    ran |= 1u << id;
+    execute(id, now);
+    n++;
+  }
+  return n;
+}
+
+uint32_t Scheduler::usUntilNext() const {
+  const uint32_t now = _now();
+  uint32_t best = UINT32_MAX;
+  for (size_t i = 0; i < _count; i++) {
+    const Job& j = _jobs[i];
+    if (j.ready) return 0;
+    if (!j.periodUs) continue;
+    const int32_t d = (int32_t)(j.nextUs - now);
+    if (d <= 0) return 0;
+    if ((uint32_t)d < best) best = (uint32_t)d;
+  }
+  return best;
+}
+
+void Scheduler::resetStats(){
+  for (size_t i = 0; i < _count; i++) _jobs[i].stats = JobStats{};
+}
@@ -0,0 +1,90 @@
+// ============================================================================
+// File: src/core/Scheduler.h
+// ----------------------------------------------------------------------------
+// Purpose: Kooperativer Scheduler für App::loop() (ersetzt millis()-Timer)
+//  • Jobs periodisch (Periode) und/oder ereignisgesteuert (trigger()),
+//    jeweils mit relativer Deadline, Priorität und optionalem Zeitbudget
+//  • Ausgeführt wird der bereite Job mit der frühesten absoluten Deadline
+//    (EDF); bei Gleichstand entscheidet die Priorität
+//  • Nicht präemptiv: ein Job läuft bis zum Ende; ein langsamer Job verzögert
+//    die anderen höchstens um seine eigene Laufzeit, statt dass eine feste
+//    Reihenfolge einzelne Stufen dauerhaft verdrängt
+//  • Je Job: Laufzeit (letzte/mittel/max), Verspätung beim Start,
+//    Deadline-Verfehlungen, Budget-Überschreitungen, ausgelassene Perioden
+//  • Plattformneutral, Zeitquelle injiziert (Host-Simulation: tools/sched_sim.cpp)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+struct JobStats {
+  uint32_t runs = 0;
+  uint32_t misses = 0;        // fertig nach der absoluten Deadline
+  uint32_t overruns = 0;      // Laufzeit > Budget
+  uint32_t skipped = 0;       // Perioden ausgelassen (Job war noch fällig)
+  uint32_t runLastUs = 0;
+  uint32_t runMaxUs = 0;
+  uint64_t runSumUs = 0;
+  uint32_t lateMaxUs = 0;     // Freigabe -> Start
+  uint64_t lateSumUs = 0;
+
+  uint32_t runAvgUs() const { return runs ? (uint32_t)(runSumUs / runs) : 0; }
+  uint32_t lateAvgUs() const { return runs ? (uint32_t)(lateSumUs / runs) : 0; }
+};
+
+class Scheduler {
+public:
+  static constexpr size_t MAX_JOBS = 12;   // <= 32 (Bitmaske in runReady)
+
+  using JobFn = void (*)(void* ctx);
+  using Clock = uint32_t (*)();
+
+  void begin(Clock now){ _now = now; }
+
+  // periodUs = 0: nur ereignisgesteuert. deadlineUs = 0: Deadline = Periode.
+  // Liefert die Job-ID oder -1 (voll/ungültig).
+  int add(const char* name, JobFn fn, void* ctx, uint32_t periodUs, uint32_t deadlineUs,
+          uint8_t priority, uint32_t budgetUs = 0);
+  void setPeriod(int id, uint32_t periodUs);
+
+  // Job sofort freigeben (z.B. Touch-IRQ); bereits fälliger Job bleibt fällig
+  void trigger(int id);
+
+  // Einen Job ausführen: -1 = keiner bereit
+  int runOne();
+  // Bereite Jobs der Reihe nach abarbeiten, höchstens einmal je Job
+  size_t runReady();
+  // Zeit bis zur nächsten Freigabe (0 = bereit, UINT32_MAX = keine)
+  uint32_t usUntilNext() const;
+
+  size_t count() const { return _count; }
+  const char* name(int id) const { return _jobs[id].name; }
+  uint32_t periodUs(int id) const { return _jobs[id].periodUs; }
+  uint32_t deadlineUs(int id) const { return _jobs[id].deadlineUs; }
+  uint8_t priority(int id) const { return _jobs[id].priority; }
+  const JobStats& stats(int id) const { return _jobs[id].stats; }
+  void resetStats();
+
+private:
+  struct Job {
+    const char* name = nullptr;
+    JobFn       fn = nullptr;
+    void*       ctx = nullptr;
+    uint32_t    periodUs = 0;
+    uint32_t    deadlineUs = 0;
+    uint32_t    budgetUs = 0;
+    uint8_t     priority = 0;
+    bool        ready = false;
+    uint32_t    releaseUs = 0;     // aktuelle Freigabe
+    uint32_t    nextUs = 0;        // nächste periodische Freigabe
+    JobStats    stats;
+  };
+
+  void release(uint32_t now);
+  int  pick(uint32_t skipMask = 0) const;
+  void execute(int id, uint32_t now);
+
+  Job      _jobs[MAX_JOBS];
+  size_t   _count = 0;
+  Clock    _now = nullptr;
+};
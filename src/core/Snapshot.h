@@ -0,0 +1,89 @@
+// ============================================================================
+// File: src/core/Snapshot.h
+// ----------------------------------------------------------------------------
+// Purpose: Lock-freie Übergabe von Zuständen zwischen den Kernen
+//  • TripleBuffer<T>: ein Schreiber, ein Leser; der Leser sieht immer den
+//    zuletzt veröffentlichten vollständigen Stand, keiner wartet je.
+//    Für große Zustände (Eingabe-Snapshot mit Touchpunkten, IMU, Gesten)
+//  • Seqlock<T>: ein Schreiber, beliebig viele Leser; Leser wiederholen, wenn
+//    der Schreiber dazwischenkam. Für kleine, häufig gelesene Werte
+//    (Zähler, Auslastung). Daten liegen als atomare 32-Bit-Worte vor, damit
+//    ein abgebrochener Lesevorgang formal kein Data Race ist
+//  • Keine Mutexe, keine Allokation; plattformneutral (Host-Test:
+//    tools/snapshot_test.cpp mit Threads)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+template <typename T>
+class TripleBuffer {
+  static_assert(std::is_trivially_copyable<T>::value, "TripleBuffer<T>: T muss trivial kopierbar sein");
+public:
+  // ---- Schreiber ----
+  T& back() { return _buf[_back]; }
+  void publish(){
+    _back = _mid.exchange((uint8_t)(_back | FRESH), std::memory_order_acq_rel) & INDEX;
+  }
+
+  // ---- Leser ----
+  // Neuesten Stand übernehmen; false = seit dem letzten Aufruf nichts Neues
+  bool update(){
+    if (!(_mid.load(std::memory_order_relaxed) & FRESH)) return false;
+    _front = _mid.exchange(_front, std::memory_order_acq_rel) & INDEX;
+    return true;
+  }
+  const T& front() const { return _buf[_front]; }
+
+private:
+  static constexpr uint8_t INDEX = 0x03;
+  static constexpr uint8_t FRESH = 0x04;
+
+  T _buf[3]{};
+  uint8_t _back = 0;                       // nur Schreiber
+  uint8_t _front = 1;                      // nur Leser
+  std::atomic<uint8_t> _mid{2};            // Tausch-Slot + FRESH-Bit
+};
+
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable<T>::value, "Seqlock<T>: T muss trivial kopierbar sein");
+public:
+  // ---- Schreiber (genau einer) ----
+  void write(const T& v){
+    uint32_t w[WORDS] = {0};
+    memcpy(w, &v, sizeof(T));
+    const uint32_t s = _seq.load(std::memory_order_relaxed);
+    _seq.store(s + 1, std::memory_order_relaxed);            // ungerade: Schreiben läuft
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++) _data[i].store(w[i], std::memory_order_relaxed);
+    _seq.store(s + 2, std::memory_order_release);
+  }
+
+  // ---- Leser ----
+  // false = nach maxTries immer noch gestört (Schreiber sehr schnell)
+  bool read(T& out, uint16_t maxTries = 16) const {
+    uint32_t w[WORDS];
+    for (uint16_t t = 0; t < maxTries; t++) {
+      const uint32_t s0 = _seq.load(std::memory_order_acquire);
+      if (s0 & 1u) continue;
+      for (size_t i = 0; i < WORDS; i++) w[i] = _data[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (_seq.load(std::memory_order_relaxed) == s0) {
+        memcpy(&out, w, sizeof(T));
+        return true;
+      }
+    }
+    return false;
+  }
+  uint32_t version() const { return _seq.load(std::memory_order_acquire) >> 1; }
+
+private:
+  static constexpr size_t WORDS = (sizeof(T) + 3) / 4;
+
+  std::atomic<uint32_t> _seq{0};
+  std::atomic<uint32_t> _data[WORDS]{};
+};
@@ -0,0 +1,94 @@
+// ============================================================================
+// File: src/core/StallMonitor.cpp
+// ----------------------------------------------------------------------------
+#include "StallMonitor.h"
+
+StallMonitor* StallMonitor::s_active = nullptr;
+
+static const char* const SITE_NAMES[(size_t)BlockSite::Count] = {
+  "console", "serial", "rs485write", "i2csync", "display", "loopload"
+};
+
+const char* blockSiteName(BlockSite s){
+  return s < BlockSite::Count ? SITE_NAMES[(size_t)s] : "-";
+}
+
+void StallMonitor::begin(Clock nowUs, IsOwner owner, uint32_t budgetUs){
+  _now      = nowUs;
+  _owner    = owner;
+  _budgetUs = budgetUs;
+  reset();
+}
+
+void StallMonitor::reset(){
+  _started = false;
+  for (auto& b : _iterBlocked) b = 0;
+  _iter.clear();
+  _stalls = 0;
+  for (auto& s : _sites) s = BlockSiteStats{};
+  _worstN = 0;
+  _overflow = 0;
+  // _stack/_depth bleiben: reset() kann aus einem offenen Scope kommen ("stall reset")
+}
+
+void StallMonitor::iterationStart(){
+  if (!_now) return;
+  const uint32_t now = _now();
+  if (_started) finishIteration(now - _iterStartUs, now);
+  _started     = true;
+  _iterStartUs = now;
+  for (auto& b : _iterBlocked) b = 0;
+}
+
+void StallMonitor::finishIteration(uint32_t iterUs, uint32_t nowUs){
+  _iter.add(iterUs);
+  if (!_budgetUs || iterUs <= _budgetUs) return;
+
+  // Stall: Stelle mit der größten Eigenzeit in diesem Durchlauf
+  StallRecord r;
+  r.iterUs = iterUs;
+  r.atMs   = nowUs / 1000;
+  for (size_t i = 0; i < (size_t)BlockSite::Count; i++) {
+    r.blockedUs += _iterBlocked[i];
+    if (_iterBlocked[i] > r.siteUs) {
+      r.siteUs = _iterBlocked[i];
+      r.site   = (BlockSite)i;
+    }
+  }
+  _stalls++;
+  if (r.site < BlockSite::Count) _sites[(size_t)r.site].stalls++;
+  keepWorst(r);
+}
+
+void StallMonitor::keepWorst(const StallRecord& r){
+  // Tabelle absteigend halten; voll: kleinsten Eintrag verdrängen
+  size_t pos = _worstN;
+  while (pos > 0 && _worst[pos - 1].iterUs < r.iterUs) pos--;
+  if (pos >= WORST) return;
+  const size_t last = _worstN < WORST ? _worstN : WORST - 1;
+  for (size_t i = last; i > pos; i--) _worst[i] = _worst[i - 1];
+  _worst[pos] = r;
+  if (_worstN < WORST) _worstN++;
+}
+
+void StallMonitor::enter(BlockSite s){
+  if (!_now || (_owner && !_owner())) return;
+  if (_depth >= DEPTH) { _overflow++; return; }
+  _stack[_depth++] = Frame{s, _now(), 0};
+}
+
+void StallMonitor::leave(){
+  if (!_now || (_owner && !_owner())) return;
+  if (_overflow) { _overflow--; return; }
+  if (_depth == 0) return;
+  const Frame f = _stack[--_depth];
+  const uint32_t total = _now() - f.startUs;
+  const uint32_t self  = total > f.childUs ? total - f.childUs : 0;
+  if (_depth) _stack[_depth - 1].childUs += total;
+
+  _iterBlocked[(size_t)f.site] += self;
+  BlockSiteStats& st = _sites[(size_t)f.site];
+  st.calls++;
+  st.sumUs += self;
+  if (self > st.maxUs) st.maxUs = self;
+}
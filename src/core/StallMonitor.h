@@ -0,0 +1,128 @@
+// ============================================================================
+// File: src/core/StallMonitor.h
+// ----------------------------------------------------------------------------
+// Purpose: Loop-Jitter und Stall-Zuordnung für App::loop()
+//  • iterationStart() am Anfang jedes loop(): Dauer des vorigen Durchlaufs
+//    geht in ein log-lineares Histogramm (p50/p95/p99/max)
+//  • BLOCKING_SCOPE(site) markiert blockierende Aufrufe (RS485-Write,
+//    Serial-Ausgabe, synchroner I²C-Transfer, HUD-SPI ...). Gezählt wird nur
+//    im Loop-Task; verschachtelte Scopes buchen ihre Eigenzeit
+//  • Durchlauf > Budget: Stall. Zugeordnet wird die Stelle mit der größten
+//    blockierten Eigenzeit im Durchlauf; die WORST schlimmsten Fälle
+//    bleiben in einer Tabelle ("stall")
+//  • Plattformneutral, Zeitquelle/Task-Prüfung injiziert
+//    (Host-Test: tools/stall_test.cpp)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "LogHistogram.h"
+
+enum class BlockSite : uint8_t {
+  Console,       // Konsolenbefehl inkl. Serial-Ausgabe
+  SerialOut,     // sonstige Serial-Ausgabe aus dem Loop (Log, RS485-RX-Echo)
+  Rs485Write,    // RS485Bus::write (GPIO-DE: flush)
+  I2CSync,       // I2CEngine::transfer (wartet auf Worker)
+  Display,       // HUD-Rendering (SPI)
+  LoopLoad,      // künstliche Last ("rs485 load")
+  Count
+};
+
+const char* blockSiteName(BlockSite s);
+
+struct StallRecord {
+  uint32_t  iterUs = 0;       // Dauer des Durchlaufs
+  uint32_t  siteUs = 0;       // blockierte Eigenzeit der zugeordneten Stelle
+  uint32_t  blockedUs = 0;    // blockiert insgesamt (alle Stellen)
+  uint32_t  atMs = 0;         // Zeitpunkt (Ende des Durchlaufs)
+  BlockSite site = BlockSite::Count;   // Count = keiner Stelle zuzuordnen
+};
+
+struct BlockSiteStats {
+  uint32_t calls = 0;
+  uint32_t maxUs = 0;         // längster einzelner Aufruf (Eigenzeit)
+  uint64_t sumUs = 0;
+  uint32_t stalls = 0;        // Stalls, die dieser Stelle zugeordnet wurden
+};
+
+class StallMonitor {
+public:
+  static constexpr size_t  WORST   = 8;     // Einträge der Worst-Tabelle
+  static constexpr uint8_t BUCKETS = 72;    // log-linear, 4 Stufen je Oktave (bis ~0,5 s)
+  static constexpr uint8_t DEPTH   = 4;     // Verschachtelung von BLOCKING_SCOPE
+
+  using Clock   = uint32_t (*)();
+  using IsOwner = bool (*)();               // läuft der Aufrufer im Loop-Task?
+
+  void begin(Clock nowUs, IsOwner owner, uint32_t budgetUs);
+  void setBudget(uint32_t us){ _budgetUs = us; }
+  uint32_t budgetUs() const { return _budgetUs; }
+
+  // Am Anfang jedes Loop-Durchlaufs: schließt den vorigen ab
+  void iterationStart();
+
+  void enter(BlockSite s);
+  void leave();
+
+  // Blockierende Aufrufe melden sich hier (nullptr = kein Monitor aktiv)
+  static StallMonitor* active(){ return s_active; }
+  void install(){ s_active = this; }
+
+  using Histogram = LogHistogram<2, BUCKETS>;
+
+  uint32_t iterations() const { return _iter.count; }
+  uint32_t stalls() const { return _stalls; }
+  uint32_t iterMaxUs() const { return _iter.max; }
+  uint32_t iterMeanUs() const { return _iter.mean(); }
+  uint32_t percentile(float p) const { return _iter.percentile(p); }
+  uint32_t bin(uint8_t b) const { return _iter.bins[b]; }
+  static uint32_t bucketUpper(uint8_t b){ return Histogram::bucketUpper(b); }
+
+  size_t worstCount() const { return _worstN; }
+  const StallRecord& worst(size_t i) const { return _worst[i]; }
+  const BlockSiteStats& siteStats(BlockSite s) const { return _sites[(size_t)s]; }
+
+  void reset();
+
+private:
+  struct Frame { BlockSite site; uint32_t startUs; uint32_t childUs; };
+
+  void finishIteration(uint32_t iterUs, uint32_t nowUs);
+  void keepWorst(const StallRecord& r);
+
+  static StallMonitor* s_active;
+
+  Clock    _now = nullptr;
+  IsOwner  _owner = nullptr;
+  uint32_t _budgetUs = 0;
+
+  bool     _started = false;
+  uint32_t _iterStartUs = 0;
+  uint32_t _iterBlocked[(size_t)BlockSite::Count]{};   // Eigenzeit je Stelle im Durchlauf
+
+  Frame    _stack[DEPTH]{};
+  uint8_t  _depth = 0;
+  uint8_t  _overflow = 0;        // Scopes jenseits DEPTH (nur mitgezählt)
+
+  Histogram _iter;               // Dauer je Durchlauf
+  uint32_t  _stalls = 0;
+
+  BlockSiteStats _sites[(size_t)BlockSite::Count]{};
+  StallRecord    _worst[WORST]{};      // absteigend nach iterUs
+  size_t         _worstN = 0;
+};
+
+// RAII: blockierenden Aufruf für die Stall-Zuordnung markieren
+class BlockingScope {
+public:
+  explicit BlockingScope(BlockSite s) : _m(StallMonitor::active()) { if (_m) _m->enter(s); }
+  ~BlockingScope(){ if (_m) _m->leave(); }
+  BlockingScope(const BlockingScope&) = delete;
+  BlockingScope& operator=(const BlockingScope&) = delete;
+private:
+  StallMonitor* _m;
+};
+
+#define BLOCKING_CAT2(a, b) a##b
+#define BLOCKING_CAT(a, b)  BLOCKING_CAT2(a, b)
+#define BLOCKING_SCOPE(site) BlockingScope BLOCKING_CAT(_blockScope, __LINE__)(site)
@@ -4,7 +4,7 @@
 // Purpose: Gemeinsame Datentypen für Touchpunkte & Gestenereignisse
 // ============================================================================
 #pragma once
-#include <Arduino.h>
+#include <stdint.h>
 
 enum class GestureType : uint8_t {
   None = 0,
@@ -28,8 +28,8 @@ struct TouchPoint {
   uint16_t strength = 0;
   bool active = false;
   bool was_active_last_frame = false;
-  unsigned long touch_start = 0;
-  unsigned long touch_end = 0;
+  uint32_t touch_start = 0;   // ms
+  uint32_t touch_end = 0;     // ms; solange aktiv: letzter Frame
   uint16_t start_x = 0, start_y = 0;
   bool long_press_fired = false;
 };
@@ -39,5 +39,7 @@ struct GestureEvent {
   uint16_t x = 0, y = 0; // ggf. Mittelpunkt
   float value = 0.0f;    // z.B. Distanz-/Winkeländerung
   uint8_t finger_count = 0;
-  unsigned long timestamp = 0;
+  uint32_t timestamp = 0;     // ms
+  uint32_t origin_us = 0; // IRQ-Zeitstempel des auslösenden Touch-Frames (Latenz-Trace)
+  uint32_t event_us = 0;  // micros() bei Erkennung
 };
\ No newline at end of file
@@ -2,6 +2,9 @@
 // File: src/display/DisplayManager.cpp - ERWEITERT FÜR TOUCH DEBUG
 // ----------------------------------------------------------------------------
 #include "DisplayManager.h"
+#include "../core/LatencyTrace.h"
+#include "../core/Profiler.h"
+#include "../core/StallMonitor.h"
 
 bool DisplayManager::begin() {
   if (!_gfx.begin()) return false;
@@ -10,9 +13,8 @@ bool DisplayManager::begin() {
   pinMode(PIN_LCD_BL, OUTPUT);
   digitalWrite(PIN_LCD_BL, PIN_LCD_BL_ACTIVE_HIGH ? HIGH : LOW);
 
-// Testbild (kurz) – hilft beim Inbetriebnehmen
-  _gfx.fillScreen(TFT_BLUE); delay(150);
-  _gfx.fillScreen(TFT_BLACK);
+// Testbild (kurz) – hilft beim Inbetriebnehmen, kostet aber Boot-Zeit
+  if (BOOT_DEBUG_DELAYS) { _gfx.fillScreen(TFT_BLUE); delay(150); }
   _gfx.setRotation(DISPLAY_ROTATION);
   _gfx.fillScreen(TFT_BLACK);
   _gfx.setTextColor(TFT_WHITE, TFT_BLACK);
@@ -28,20 +30,23 @@ bool DisplayManager::begin() {
 void DisplayManager::renderHUD(const GestureEvent& g, float fps,
                                float ax, float ay, float az,
                                float gx, float gy, float gz) {
+  PROF_ZONE(ProfZone::Hud);
+  BLOCKING_SCOPE(BlockSite::Display);
+  lgfx::LGFXBase& out = surface();
   // Kopfbereich löschen
-  _gfx.fillRect(0, 0, DISPLAY_WIDTH, 48, TFT_BLACK);
-  _gfx.setCursor(4, 4);
-  _gfx.printf("FPS: %.1f\n", fps);
+  out.fillRect(0, 0, DISPLAY_WIDTH, 48, TFT_BLACK);
+  out.setCursor(4, 4);
+  out.printf("FPS: %.1f\n", fps);
 
-  _gfx.setCursor(4, 16);
-  _gfx.printf("IMU a[g]: %+.2f %+.2f %+.2f\n", ax, ay, az);
+  out.setCursor(4, 16);
+  out.printf("IMU a[g]: %+.2f %+.2f %+.2f\n", ax, ay, az);
 
-  _gfx.setCursor(4, 28);
-  _gfx.printf("IMU g[dps]: %+.1f %+.1f %+.1f\n", gx, gy, gz);
+  out.setCursor(4, 28);
+  out.printf("IMU g[dps]: %+.1f %+.1f %+.1f\n", gx, gy, gz);
 
-  _gfx.fillRect(0, 48, DISPLAY_WIDTH, 12, TFT_DARKGREY);
-  _gfx.setTextColor(TFT_YELLOW, TFT_DARKGREY);
-  _gfx.setCursor(4, 50);
+  out.fillRect(0, 48, DISPLAY_WIDTH, 12, TFT_DARKGREY);
+  out.setTextColor(TFT_YELLOW, TFT_DARKGREY);
+  out.setCursor(4, 50);
   const char* name = "None";
   switch (g.type) {
     case GestureType::Tap: name = "Tap"; break;
@@ -59,15 +64,27 @@ void DisplayManager::renderHUD(const GestureEvent& g, float fps,
     case GestureType::ThreeFingerTap: name = "ThreeFingerTap"; break;
     default: name = "None"; break;
   }
-  _gfx.printf("Gesture: %s (%u) val=%.2f [@%u,%u]",
-              name, g.finger_count, g.value, g.x, g.y);
-  _gfx.setTextColor(TFT_WHITE, TFT_BLACK);
+  out.printf("Gesture: %s (%u) val=%.2f [@%u,%u]",
+             name, g.finger_count, g.value, g.x, g.y);
+  out.setTextColor(TFT_WHITE, TFT_BLACK);
+  _mirror.mark(0, 0, DISPLAY_WIDTH, 48 + 12);   // Kopf + Gestenleiste
+  _mirror.present();
+
+  // Latenz-Trace: erste vollständige Darstellung dieser Geste
+  if (g.event_us && g.event_us != _tracedEventUs) {
+    _gfx.waitDMA();
+    uint32_t now = micros();
+    _tracedEventUs = g.event_us;
+    latency::record(LatStage::GestureToDisplay, now - g.event_us);
+    if (g.origin_us) latency::record(LatStage::IrqToDisplay, now - g.origin_us);
+  }
 }
 
 // NEU: Touch-Punkte visuell anzeigen
 void DisplayManager::renderTouchPoints(const TouchPoint pts[MAX_TOUCH_POINTS], uint8_t activeCount) {
   // Touch area (unterhalb der HUD)
   const int TOUCH_AREA_TOP = 70;
+  lgfx::LGFXBase& out = surface();
   
   // Lösche vorherige Touch-Anzeige
   static uint16_t lastTouchX[MAX_TOUCH_POINTS] = {0};
@@ -77,7 +94,7 @@ void DisplayManager::renderTouchPoints(const TouchPoint pts[MAX_TOUCH_POINTS], u
   // Lösche alte Positionen
   for (int i = 0; i < MAX_TOUCH_POINTS; i++) {
     if (lastActive[i] && lastTouchY[i] >= TOUCH_AREA_TOP) {
-      _gfx.fillCircle(lastTouchX[i], lastTouchY[i], 8, TFT_BLACK);
+      out.fillCircle(lastTouchX[i], lastTouchY[i], 8, TFT_BLACK);
     }
   }
   
@@ -93,13 +110,13 @@ void DisplayManager::renderTouchPoints(const TouchPoint pts[MAX_TOUCH_POINTS], u
         uint16_t colors[] = {TFT_RED, TFT_GREEN, TFT_BLUE, TFT_YELLOW, TFT_MAGENTA};
         uint16_t color = colors[i % 5];
         
-        _gfx.fillCircle(x, y, 6, color);
-        _gfx.drawCircle(x, y, 8, TFT_WHITE);
+        out.fillCircle(x, y, 6, color);
+        out.drawCircle(x, y, 8, TFT_WHITE);
         
         // Touch-Info
-        _gfx.setTextColor(TFT_WHITE, TFT_BLACK);
-        _gfx.setCursor(x + 12, y - 4);
-        _gfx.printf("%d", i);
+        out.setTextColor(TFT_WHITE, TFT_BLACK);
+        out.setCursor(x + 12, y - 4);
+        out.printf("%d", i);
       }
       
       lastTouchX[i] = x;
@@ -109,18 +126,20 @@ void DisplayManager::renderTouchPoints(const TouchPoint pts[MAX_TOUCH_POINTS], u
   }
   
   // Touch-Status unten anzeigen
-  _gfx.fillRect(0, DISPLAY_HEIGHT - 20, DISPLAY_WIDTH, 20, TFT_NAVY);
-  _gfx.setTextColor(TFT_WHITE, TFT_NAVY);
-  _gfx.setCursor(4, DISPLAY_HEIGHT - 16);
-  _gfx.printf("Touch Points: %d", activeCount);
+  out.fillRect(0, DISPLAY_HEIGHT - 20, DISPLAY_WIDTH, 20, TFT_NAVY);
+  out.setTextColor(TFT_WHITE, TFT_NAVY);
+  out.setCursor(4, DISPLAY_HEIGHT - 16);
+  out.printf("Touch Points: %d", activeCount);
   
   // Erste aktive Touch-Koordinaten anzeigen
   for (int i = 0; i < MAX_TOUCH_POINTS; i++) {
     if (pts[i].active) {
-      _gfx.printf("  [%d] (%d,%d) S:%d", i, pts[i].x, pts[i].y, pts[i].strength);
+      out.printf("  [%d] (%d,%d) S:%d", i, pts[i].x, pts[i].y, pts[i].strength);
       break; // Nur ersten anzeigen wegen Platz
     }
   }
   
-  _gfx.setTextColor(TFT_WHITE, TFT_BLACK);
+  out.setTextColor(TFT_WHITE, TFT_BLACK);
+  _mirror.mark(0, TOUCH_AREA_TOP - 8, DISPLAY_WIDTH, DISPLAY_HEIGHT - (TOUCH_AREA_TOP - 8));
+  _mirror.present();
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "../config/pins.h"
 #include "../config/params.h"
 #include "../core/types.h"
+#include "ScreenMirror.h"
 
 class LGFX_ST7789 : public lgfx::LGFX_Device {
   lgfx::Panel_ST7789 _panel;
@@ -61,6 +62,12 @@ public:
                  float ax, float ay, float az, float gx, float gy, float gz);
   void renderTouchPoints(const TouchPoint pts[MAX_TOUCH_POINTS], uint8_t activeCount); // NEU
   LGFX_ST7789& gfx() { return _gfx; }
+  ScreenMirror& mirror() { return _mirror; }
 private:
+  // Spiegel aktiv: in den Schatten, present() schiebt die Änderungen ans Panel
+  lgfx::LGFXBase& surface() { return _mirror.active() ? _mirror.surface() : _gfx; }
+
   LGFX_ST7789 _gfx;
+  ScreenMirror _mirror;
+  uint32_t    _tracedEventUs = 0;   // Geste, deren Anzeige schon gemessen wurde
 };
\ No newline at end of file
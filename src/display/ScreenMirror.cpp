@@ -0,0 +1,334 @@
+// ============================================================================
+// File: src/display/ScreenMirror.cpp
+// ----------------------------------------------------------------------------
+#include "ScreenMirror.h"
+#include "../comm/TelemetryProto.h"
+#include "../comm/UsbOwner.h"
+#include "../core/Placement.h"
+
+static_assert(MIRROR_CHUNK_BYTES >= mirror::HEADER_MAX + mirror::TILE_MAX + mirror::TRAILER,
+              "MIRROR_CHUNK_BYTES kleiner als ein Tile im Worst Case");
+
+// FNV-1a über die Pixel, wie sie im Speicher stehen (Loop und Task gleich)
+static uint32_t hashRows(const uint16_t* p, size_t stride, uint16_t w, uint16_t h){
+  uint32_t hash = 2166136261u;
+  for (uint16_t y = 0; y < h; y++, p += stride) {
+    for (uint16_t x = 0; x < w; x++) {
+      hash ^= p[x];
+      hash *= 16777619u;
+    }
+  }
+  return hash;
+}
+
+static inline uint16_t tileW(uint16_t tx){
+  const uint16_t x = tx * ScreenMirror::TILE;
+  return DISPLAY_WIDTH - x < ScreenMirror::TILE ? DISPLAY_WIDTH - x : ScreenMirror::TILE;
+}
+
+static inline uint16_t tileH(uint16_t ty){
+  const uint16_t y = ty * ScreenMirror::TILE;
+  return DISPLAY_HEIGHT - y < ScreenMirror::TILE ? DISPLAY_HEIGHT - y : ScreenMirror::TILE;
+}
+
+bool ScreenMirror::begin(lgfx::LGFX_Device& panel){
+  if (_task) return true;
+  _panel = &panel;
+  if (!_buf) {
+    _buf = static_cast<uint16_t*>(place::alloc((size_t)DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(uint16_t),
+                                               place::Mem::Bulk, "mirror"));
+    if (!_buf) return false;
+    _shadow.setColorDepth(16);
+    _shadow.setBuffer(_buf, DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    _shadow.setFont(&fonts::Font0);
+    _shadow.setTextSize(1);
+    _shadow.setTextColor(TFT_WHITE, TFT_BLACK);
+  }
+  for (auto& h : _panelHash) h.store(0, std::memory_order_relaxed);
+  for (auto& d : _dirty) d.store(0, std::memory_order_relaxed);
+  return xTaskCreatePinnedToCore(taskEntry, "mirror", 3072, this, MIRROR_TASK_PRIORITY,
+                                 &_task, MIRROR_TASK_CORE) == pdPASS;
+}
+
+// Kein Vollbild-Push ans Panel (~30 ms im Loop): außerhalb der Bereiche,
+// die DisplayManager zeichnet, ist das Panel schwarz wie der frische Schatten
+static const char* const USB_OWNER = "mirror";
+
+bool ScreenMirror::start(){
+  if (!_task) return false;
+  if (_active) return true;
+  _shadow.fillScreen(TFT_BLACK);
+  for (uint16_t ty = 0; ty < TILES_Y; ty++)
+    for (uint16_t tx = 0; tx < TILES_X; tx++)
+      _panelHash[ty * TILES_X + tx].store(hashTile(tx, ty), std::memory_order_relaxed);
+  for (auto& m : _marked) m = 0;
+  _stats  = MirrorStats{};
+  _rateMs = millis();
+  _rateFrames = _rateBytes = 0;
+  _keyReq.store(true);
+  if (!usbowner::acquire(USB_OWNER, _active)) return false;
+  xTaskNotifyGive(_task);
+  return true;
+}
+
+void ScreenMirror::stop(){
+  _active = false;   // Panel zeigt den Schattenstand, DisplayManager zeichnet wieder direkt
+}
+
+// ---------------------------- Loop-Seite -------------------------------------
+void ScreenMirror::mark(int32_t x, int32_t y, int32_t w, int32_t h){
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > DISPLAY_WIDTH) w = DISPLAY_WIDTH - x;
+  if (y + h > DISPLAY_HEIGHT) h = DISPLAY_HEIGHT - y;
+  if (w <= 0 || h <= 0) return;
+  for (int32_t ty = y / TILE; ty <= (y + h - 1) / TILE; ty++) {
+    for (int32_t tx = x / TILE; tx <= (x + w - 1) / TILE; tx++) {
+      const uint16_t i = (uint16_t)(ty * TILES_X + tx);
+      _marked[i >> 5] |= 1u << (i & 31);
+    }
+  }
+}
+
+uint32_t ScreenMirror::hashTile(uint16_t tx, uint16_t ty) const {
+  const uint16_t* p = _buf + (size_t)ty * TILE * DISPLAY_WIDTH + (size_t)tx * TILE;
+  return hashRows(p, DISPLAY_WIDTH, tileW(tx), tileH(ty));
+}
+
+// Zusammenhängende geänderte Tiles einer Zeile: ein Clip-Fenster, ein Push
+void ScreenMirror::pushSpan(uint16_t ty, uint16_t tx0, uint16_t tx1){
+  const int32_t x = tx0 * TILE, y = ty * TILE;
+  const int32_t w = (tx1 - 1) * TILE + tileW(tx1 - 1) - x;
+  _panel->setClipRect(x, y, w, tileH(ty));
+  _shadow.pushSprite(_panel, 0, 0);
+  _panel->clearClipRect();
+  _stats.panelTiles += tx1 - tx0;
+}
+
+void ScreenMirror::present(){
+  if (!_active) return;
+  const uint32_t t0 = micros();
+  bool changedAny = false;
+  for (uint16_t ty = 0; ty < TILES_Y; ty++) {
+    int32_t run = -1;
+    for (uint16_t tx = 0; tx <= TILES_X; tx++) {
+      bool changed = false;
+      if (tx < TILES_X) {
+        const uint16_t i = ty * TILES_X + tx;
+        const uint32_t bit = 1u << (i & 31);
+        if (_marked[i >> 5] & bit) {
+          const uint32_t h = hashTile(tx, ty);
+          if (h != _panelHash[i].load(std::memory_order_relaxed)) {
+            _panelHash[i].store(h, std::memory_order_relaxed);
+            _dirty[i >> 5].fetch_or(bit, std::memory_order_release);
+            changed = true;
+          }
+        }
+      }
+      if (changed && run < 0) run = tx;
+      if (!changed && run >= 0) {
+        pushSpan(ty, (uint16_t)run, tx);
+        run = -1;
+        changedAny = true;
+      }
+    }
+  }
+  for (auto& m : _marked) m = 0;
+  if (changedAny) xTaskNotifyGive(_task);
+
+  const uint32_t dt = micros() - t0;
+  _stats.presents++;
+  _stats.presentSumUs += dt;
+  if (dt > _stats.presentMaxUs) _stats.presentMaxUs = dt;
+}
+
+// ---------------------------- Task -------------------------------------------
+void ScreenMirror::taskEntry(void* arg){
+  static_cast<ScreenMirror*>(arg)->taskLoop();
+}
+
+// false: Loop hat das Tile seit present() überzeichnet -> im nächsten Durchlauf
+bool ScreenMirror::copyTile(uint16_t index, uint32_t& hash){
+  const uint16_t tx = index % TILES_X, ty = index / TILES_X;
+  const uint16_t w = tileW(tx), h = tileH(ty);
+  const uint16_t* src = _buf + (size_t)ty * TILE * DISPLAY_WIDTH + (size_t)tx * TILE;
+  for (uint16_t y = 0; y < h; y++) memcpy(_tile + y * TILE, src + (size_t)y * DISPLAY_WIDTH, w * sizeof(uint16_t));
+  hash = hashRows(_tile, TILE, w, h);
+  if (hash != _panelHash[index].load(std::memory_order_relaxed)) return false;
+  // Sprite: RGB565 byte-vertauscht (Panel-Reihenfolge), Protokoll: nativ
+  for (uint16_t y = 0; y < TILE; y++) {
+    uint16_t* row = _tile + y * TILE;
+    for (uint16_t x = 0; x < TILE; x++)
+      row[x] = (y < h && x < w) ? (uint16_t)((row[x] << 8) | (row[x] >> 8)) : 0;
+  }
+  return true;
+}
+
+void ScreenMirror::refill(){
+  const uint32_t now = millis();
+  const uint32_t add = (uint32_t)((uint64_t)_budget * (now - _refillMs) / 1000u);
+  if (!add) return;
+  _refillMs = now;
+  int32_t cap = (int32_t)((uint64_t)_budget * MIRROR_BURST_MS / 1000u);
+  if (cap < (int32_t)sizeof(_wire)) cap = (int32_t)sizeof(_wire);
+  _tokens = _tokens + (int32_t)add > cap ? cap : _tokens + (int32_t)add;
+}
+
+// Nur so viel, wie der USB-Puffer frei hat: blockiert weder Task noch
+// (über das Schreib-Lock der Konsole) den Loop
+void ScreenMirror::writeWire(size_t n){
+  size_t off = 0;
+  while (off < n) {
+    if (!_active) return;           // Rest verwerfen: Host verwirft den Chunk (CRC)
+    const int room = Serial.availableForWrite();
+    if (room <= 0) {
+      _stats.writeWaits++;
+      vTaskDelay(1);
+      continue;
+    }
+    const size_t k = (size_t)room < n - off ? (size_t)room : n - off;
+    off += Serial.write(_wire + off, k);
+  }
+}
+
+void ScreenMirror::flushChunk(bool frameEnd){
+  const size_t raw = _enc.finish(frameEnd ? mirror::FRAME_END : 0);
+  // 0x00 auch vorn: Konsolentext davor endet so als eigener (ungültiger) Frame
+  _wire[0] = 0x00;
+  size_t n = 1 + telem::cobsEncode(_raw, raw, _wire + 1);
+  _wire[n++] = 0x00;
+
+  if (_budget) {
+    refill();
+    while (_tokens < (int32_t)n && _active) {
+      _stats.budgetWaits++;
+      vTaskDelay(pdMS_TO_TICKS(MIRROR_POLL_MS));
+      refill();
+    }
+    _tokens -= (int32_t)n;
+  }
+  writeWire(n);
+  _stats.chunks++;
+  _stats.bytes += n;
+  _rateBytes   += n;
+}
+
+void ScreenMirror::sendFrame(bool key){
+  _hdr.flags  = key ? mirror::KEY : 0;
+  _hdr.frame  = _stats.frames;
+  _hdr.ms     = millis();
+  _hdr.width  = DISPLAY_WIDTH;
+  _hdr.height = DISPLAY_HEIGHT;
+  _enc.begin(_raw, sizeof(_raw), _hdr);
+  for (uint16_t i = 0; i < TILES; i++) {
+    const uint32_t bit = 1u << (i & 31);
+    if (!(_pending[i >> 5] & bit)) continue;
+    uint32_t h;
+    if (!copyTile(i, h)) { _stats.retried++; continue; }    // bleibt offen
+    _pending[i >> 5] &= ~bit;
+    if (!key && h == _sentHash[i]) { _stats.skipped++; continue; }
+    if (!_enc.addTile(i, _tile)) {
+      flushChunk(false);
+      _hdr.seq++;
+      _enc.begin(_raw, sizeof(_raw), _hdr);
+      _enc.addTile(i, _tile);
+    }
+    _sentHash[i] = h;
+    _stats.tiles++;
+  }
+  if (!_enc.tiles()) return;        // alles schon so gesendet
+  flushChunk(true);
+  _hdr.seq++;
+  _stats.frames++;
+  if (key) _stats.keyFrames++;
+  _rateFrames++;
+}
+
+void ScreenMirror::updateRate(uint32_t nowMs){
+  const uint32_t dt = nowMs - _rateMs;
+  if (dt < 1000) return;
+  _stats.fps         = (uint32_t)((uint64_t)_rateFrames * 10000u / dt);
+  _stats.bytesPerSec = (uint32_t)((uint64_t)_rateBytes * 1000u / dt);
+  _rateFrames = _rateBytes = 0;
+  _rateMs = nowMs;
+}
+
+void ScreenMirror::taskLoop(){
+  _refillMs = millis();
+  for (;;) {
+    if (!_active) {                        // schlafen bis zum ersten present()
+      usbowner::releaseIfIdle(USB_OWNER, _active);
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    bool any = false;
+    for (uint16_t w = 0; w < WORDS; w++) {
+      _pending[w] |= _dirty[w].exchange(0, std::memory_order_acquire);
+      any |= _pending[w] != 0;
+    }
+    const uint32_t now = millis();
+    const bool key = _keyReq.exchange(false) || now - _lastKeyMs >= MIRROR_KEY_INTERVAL_MS;
+    if (key) {
+      for (uint16_t w = 0; w < WORDS; w++) _pending[w] = ~0u;
+      if (TILES % 32) _pending[WORDS - 1] = (1u << (TILES % 32)) - 1;
+      _lastKeyMs = now;
+      any = true;
+    }
+    if (any) sendFrame(key);
+    updateRate(millis());
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MIRROR_POLL_MS));
+  }
+}
+
+// ---------------------------- Konsole ---------------------------------------
+void MirrorStats::print(Print& out) const {
+  out.printf("[MIRROR] frames=%u (key %u) %.1f fps, %u B/s, %.0f B/Frame\n", frames, keyFrames,
+             fps / 10.f, bytesPerSec, frames ? (float)bytes / frames : 0.f);
+  out.printf("[MIRROR] tiles=%u (%.1f/Frame) skipped=%u retried=%u chunks=%u bytes=%u\n",
+             tiles, frames ? (float)tiles / frames : 0.f, skipped, retried, chunks, bytes);
+  out.printf("[MIRROR] waits budget=%u usb=%u, present %u x avg %u us max %u us, panel tiles=%u\n",
+             budgetWaits, writeWaits, presents, presents ? (unsigned)(presentSumUs / presents) : 0u,
+             presentMaxUs, panelTiles);
+}
+
+static void printState(const ScreenMirror& m, uint32_t budget){
+  Serial.printf("[MIRROR] %s, %ux%u Tiles à %u px, Budget %u B/s%s\n", m.active() ? "an" : "aus",
+                ScreenMirror::TILES_X, ScreenMirror::TILES_Y, ScreenMirror::TILE, budget,
+                budget ? "" : " (unbegrenzt)");
+}
+
+static constexpr cmd::Command MIRROR_CMDS[] = {
+  {"mirror budget", "u", "<B/s, 0=unbegrenzt>", [](void* c, const cmd::Args& a){
+    ScreenMirror& m = *static_cast<ScreenMirror*>(c);
+    m.setBudget(a.u(0));
+    printState(m, a.u(0));
+  }},
+  {"mirror key", "", "", [](void* c, const cmd::Args&){ static_cast<ScreenMirror*>(c)->requestKey(); }},
+  {"mirror off", "", "", [](void* c, const cmd::Args&){
+    ScreenMirror& m = *static_cast<ScreenMirror*>(c);
+    m.stop();
+    Serial.println();
+    m.stats().print(Serial);
+  }},
+  {"mirror on", "", "", [](void* c, const cmd::Args&){
+    ScreenMirror& m = *static_cast<ScreenMirror*>(c);
+    if (!m.ready()) { Serial.println("[MIRROR] nicht verfügbar (kein PSRAM/Task)"); return; }
+    const char* other = usbowner::holder();
+    if (other && usbowner::busy(USB_OWNER)) {
+      Serial.printf("[MIRROR] USB belegt durch \"%s\" ('%s off', dann erneut)\n", other, other);
+      return;
+    }
+    Serial.println("[MIRROR] an (binär, 'mirror off' beendet)");
+    if (!m.start()) Serial.println("[MIRROR] USB belegt");
+  }},
+  {"mirror stats", "", "", [](void* c, const cmd::Args&){
+    const ScreenMirror& m = *static_cast<ScreenMirror*>(c);
+    printState(m, m.budget());
+    m.stats().print(Serial);
+  }},
+};
+static_assert(cmd::sorted(MIRROR_CMDS), "MIRROR_CMDS nicht sortiert");
+
+void ScreenMirror::registerCommands(cmd::Registry& r){
+  r.add(MIRROR_CMDS, this, "mirror");
+}
@@ -0,0 +1,114 @@
+// ============================================================================
+// File: src/display/ScreenMirror.h
+// ----------------------------------------------------------------------------
+// Purpose: Bildschirm-Spiegel – Anzeige live am PC (Protokoll: comm/MirrorProto.h)
+//  • "mirror on": DisplayManager zeichnet in einen Schatten (Sprite im
+//    PSRAM) statt aufs Panel, markiert die Bereiche (mark) und ruft
+//    present(): nur geänderte 16x16-Tiles gehen per pushSprite ans Panel
+//  • Geändert = Tile-Hash weicht vom Panelstand ab; das Tile wird dann für
+//    den Spiegel-Task als schmutzig markiert (Atomics, kein Lock)
+//  • Spiegel-Task (Kern 0, niedrigste Priorität): Tile kopieren, gegen den
+//    Panel-Hash prüfen (gerade überzeichnet -> später), RLE, Chunk; schreibt
+//    nur so viel wie der USB-Puffer frei hat, Budget per Token-Bucket
+//    ("mirror budget"). Der Loop wartet nie auf USB
+//  • Vollbild bei "mirror on", "mirror key" und alle MIRROR_KEY_INTERVAL_MS
+//  • Schatten + Task in begin() (vor heapguard::seal); aus: direkt aufs Panel
+//  • Schließt "stream on" aus (comm/UsbOwner.h): beide schreiben binär auf Serial
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include <atomic>
+#include <LovyanGFX.hpp>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../comm/CommandTable.h"
+#include "../comm/MirrorProto.h"
+#include "../config/params.h"
+
+struct MirrorStats {
+  uint32_t frames = 0;        // Bilder mit mindestens einem Tile
+  uint32_t keyFrames = 0;
+  uint32_t tiles = 0;         // gesendet
+  uint32_t skipped = 0;       // schmutzig, aber wie zuletzt gesendet
+  uint32_t retried = 0;       // beim Kopieren überzeichnet
+  uint32_t chunks = 0;
+  uint32_t bytes = 0;         // auf USB (inkl. COBS)
+  uint32_t budgetWaits = 0;   // Token-Bucket leer
+  uint32_t writeWaits = 0;    // USB-Puffer voll
+  uint32_t fps = 0;           // letzte volle Sekunde, x10
+  uint32_t bytesPerSec = 0;
+  uint32_t presents = 0;      // Loop-Seite
+  uint32_t presentMaxUs = 0;
+  uint64_t presentSumUs = 0;
+  uint32_t panelTiles = 0;    // ans Panel geschoben
+
+  void print(Print& out) const;
+};
+
+class ScreenMirror {
+public:
+  static constexpr uint8_t  TILE    = mirror::TILE;
+  static constexpr uint16_t TILES_X = (DISPLAY_WIDTH + TILE - 1) / TILE;
+  static constexpr uint16_t TILES_Y = (DISPLAY_HEIGHT + TILE - 1) / TILE;
+  static constexpr uint16_t TILES   = TILES_X * TILES_Y;
+  static constexpr uint16_t WORDS   = (TILES + 31) / 32;
+
+  bool begin(lgfx::LGFX_Device& panel);
+  bool ready() const { return _task != nullptr; }
+  bool active() const { return _active; }
+  bool start();                    // Loop: Schatten leeren, Vollbild anfordern; false: USB belegt
+  void stop();
+  void requestKey() { _keyReq.store(true); }
+  void setBudget(uint32_t bytesPerSec) { _budget = bytesPerSec; }   // 0 = unbegrenzt
+  uint32_t budget() const { return _budget; }
+
+  // Nur bei active(): Zeichenziel statt Panel
+  lgfx::LGFXBase& surface() { return _shadow; }
+  void mark(int32_t x, int32_t y, int32_t w, int32_t h);
+  void present();                  // Loop, nach dem Zeichnen
+
+  const MirrorStats& stats() const { return _stats; }
+  void registerCommands(cmd::Registry& r);   // mirror on|off|key|stats|budget
+
+private:
+  static void taskEntry(void* arg);
+  void taskLoop();
+  void sendFrame(bool key);
+  bool copyTile(uint16_t index, uint32_t& hash);
+  void flushChunk(bool frameEnd);
+  void writeWire(size_t n);
+  void refill();
+  void updateRate(uint32_t nowMs);
+  void pushSpan(uint16_t ty, uint16_t tx0, uint16_t tx1);
+  uint32_t hashTile(uint16_t tx, uint16_t ty) const;
+
+  lgfx::LGFX_Device* _panel = nullptr;
+  LGFX_Sprite        _shadow;
+  uint16_t*          _buf = nullptr;    // Sprite-Speicher (RGB565 byte-vertauscht)
+  TaskHandle_t       _task = nullptr;
+  volatile bool      _active = false;
+  volatile uint32_t  _budget = MIRROR_BUDGET_BPS;
+  std::atomic<bool>  _keyReq{false};
+
+  // Loop -> Task
+  std::atomic<uint32_t> _panelHash[TILES];
+  std::atomic<uint32_t> _dirty[WORDS];
+
+  // nur Loop
+  uint32_t _marked[WORDS] = {};
+
+  // nur Task
+  uint32_t _pending[WORDS] = {};
+  uint32_t _sentHash[TILES] = {};
+  uint16_t _tile[mirror::TILE_PIXELS];
+  mirror::ChunkEncoder _enc;
+  mirror::ChunkHeader  _hdr;
+  uint8_t  _raw[MIRROR_CHUNK_BYTES];
+  uint8_t  _wire[MIRROR_CHUNK_BYTES + MIRROR_CHUNK_BYTES / 254 + 3];
+  int32_t  _tokens = 0;
+  uint32_t _refillMs = 0;
+  uint32_t _lastKeyMs = 0;
+  uint32_t _rateMs = 0, _rateFrames = 0, _rateBytes = 0;
+
+  MirrorStats _stats;
+};
@@ -2,20 +2,19 @@
 // File: src/gestures/GestureEngine.cpp - KORRIGIERT & VOLLSTÄNDIG
 // ----------------------------------------------------------------------------
 #include "GestureEngine.h"
+#include "../core/Placement.h"
 #include <math.h>
+#include <stdlib.h>
 
-// Bewährte Parameter
-#define TAP_MAX_DURATION    250  // ms
-#define TAP_MAX_MOVEMENT    20   // px
-#define DOUBLE_TAP_INTERVAL 400  // ms  
-#define LONG_PRESS_DURATION 800  // ms
-#define SWIPE_MIN_DISTANCE  30   // px
+// Schwellen: _p (Vorgabe gesture_params.h, erzeugt von tools/gesture_tune)
 
 void GestureEngine::reset(){
   _lastTapTime = 0;
   _lastTapX = 0;
   _lastTapY = 0;
-  _lastLongPressTime = 0;
+  _longPressTouch = 0;
+  _settleCount = 0;
+  _settleSince = 0;
   
   for(int i = 0; i < MAX_TOUCH_POINTS; i++){
     _lastActiveState[i] = false;
@@ -23,19 +22,25 @@ void GestureEngine::reset(){
   _lastActiveCount = 0;
 }
 
-GestureEvent GestureEngine::process(const TouchPoint pts[MAX_TOUCH_POINTS], uint8_t activeCount){
+GestureEvent HOT_FN GestureEngine::process(const TouchPoint pts[MAX_TOUCH_POINTS], uint8_t activeCount, uint32_t now,
+                                           uint32_t frameOriginUs){
   GestureEvent g;
   g.type = GestureType::None;
-  g.timestamp = millis();
+  g.timestamp = now;
   g.finger_count = activeCount;
-  
-  unsigned long now = millis();
+
+  // Fingerzahl erst nach settleMs übernehmen (Aufsetzen/Abheben prellt)
+  if (activeCount != _settleCount) {
+    _settleCount = activeCount;
+    _settleSince = now;
+  }
+  if (now - _settleSince < _p.settleMs) return g;
   
   // Touch beendet → Gesten auswerten
   if(_lastActiveCount > 0 && activeCount == 0){
     
     if(_lastActiveCount == 1){
-      g = processSingleFingerGesture(pts[0], now);
+      g = processSingleFingerGesture(primary(pts), now);
       
     } else if(_lastActiveCount == 2){
       g = processTwoFingerGesture(pts[0], pts[1], now);
@@ -47,10 +52,7 @@ GestureEvent GestureEngine::process(const TouchPoint pts[MAX_TOUCH_POINTS], uint
   
   // Long-Press: Live während Touch (nur einmalig)
   if(activeCount == 1 && _lastActiveCount == 1){
-    GestureEvent longPress = checkLongPress(pts[0], now);
-    if(longPress.type != GestureType::None){
-      g = longPress;
-    }
+    g = checkLongPress(primary(pts), now);
   }
   
   // State für nächsten Frame speichern
@@ -58,11 +60,23 @@ GestureEvent GestureEngine::process(const TouchPoint pts[MAX_TOUCH_POINTS], uint
   for(int i = 0; i < MAX_TOUCH_POINTS; i++){
     _lastActiveState[i] = pts[i].active;
   }
-  
+  if (g.type != GestureType::None) g.origin_us = frameOriginUs;
   return g;
 }
 
-GestureEvent GestureEngine::processSingleFingerGesture(const TouchPoint& tp, unsigned long now){
+// Einzelner Finger: der aktive Slot, sonst der zuletzt losgelassene
+// (bleibt nach zwei Fingern nur der zweite übrig, steht er nicht in Slot 0)
+const TouchPoint& HOT_FN GestureEngine::primary(const TouchPoint pts[MAX_TOUCH_POINTS]){
+  int best = 0;
+  for (int i = 0; i < MAX_TOUCH_POINTS; i++) {
+    if (pts[i].active) return pts[i];
+    if (pts[i].was_active_last_frame && (!pts[best].was_active_last_frame ||
+        (int32_t)(pts[i].touch_end - pts[best].touch_end) > 0)) best = i;
+  }
+  return pts[best];
+}
+
+GestureEvent HOT_FN GestureEngine::processSingleFingerGesture(const TouchPoint& tp, uint32_t now){
   GestureEvent g;
   g.type = GestureType::None;
   g.timestamp = now;
@@ -72,14 +86,14 @@ GestureEvent GestureEngine::processSingleFingerGesture(const TouchPoint& tp, uns
   
   if(!tp.was_active_last_frame) return g;
   
-  unsigned long duration = tp.touch_end - tp.touch_start;
-  float movement = sqrt(pow(tp.x - tp.start_x, 2) + pow(tp.y - tp.start_y, 2));
+  uint32_t duration = tp.touch_end - tp.touch_start;
+  float movement = sqrtf(powf(tp.x - tp.start_x, 2) + powf(tp.y - tp.start_y, 2));
   
-  if(movement <= TAP_MAX_MOVEMENT && duration <= TAP_MAX_DURATION){
+  if(movement <= _p.tapMaxMovementPx && duration <= _p.tapMaxDurationMs){
     // TAP oder DOUBLE_TAP
-    if(now - _lastTapTime < DOUBLE_TAP_INTERVAL &&
-       abs(tp.x - _lastTapX) < TAP_MAX_MOVEMENT &&
-       abs(tp.y - _lastTapY) < TAP_MAX_MOVEMENT){
+    if(now - _lastTapTime < _p.doubleTapIntervalMs &&
+       abs(tp.x - _lastTapX) < _p.tapMaxMovementPx &&
+       abs(tp.y - _lastTapY) < _p.tapMaxMovementPx){
       // DOUBLE TAP erkannt
       g.type = GestureType::DoubleTap;
       g.value = 2;
@@ -93,12 +107,15 @@ GestureEvent GestureEngine::processSingleFingerGesture(const TouchPoint& tp, uns
       _lastTapY = tp.y;
     }
     
-  } else if(movement > SWIPE_MIN_DISTANCE && duration < 500){
-    // SWIPE
+  } else if(movement > _p.swipeMinDistancePx && duration < _p.swipeMaxDurationMs){
+    // SWIPE – nur klar achsig (Hauptachse >= swipeAxisRatio x Nebenachse)
     float dx = tp.x - tp.start_x;
     float dy = tp.y - tp.start_y;
     
-    if(abs(dx) > abs(dy)){
+    if(fabsf(dx) < _p.swipeAxisRatio * fabsf(dy) && fabsf(dy) < _p.swipeAxisRatio * fabsf(dx)){
+      return g;
+    }
+    if(fabsf(dx) > fabsf(dy)){
       if(dx > 0){
         g.type = GestureType::SwipeRight;
       } else {
@@ -117,7 +134,7 @@ GestureEvent GestureEngine::processSingleFingerGesture(const TouchPoint& tp, uns
   return g;
 }
 
-GestureEvent GestureEngine::processTwoFingerGesture(const TouchPoint& tp1, const TouchPoint& tp2, unsigned long now){
+GestureEvent HOT_FN GestureEngine::processTwoFingerGesture(const TouchPoint& tp1, const TouchPoint& tp2, uint32_t now){
   GestureEvent g;
   g.type = GestureType::TwoFingerTap;
   g.timestamp = now;
@@ -129,7 +146,7 @@ GestureEvent GestureEngine::processTwoFingerGesture(const TouchPoint& tp1, const
   return g;
 }
 
-GestureEvent GestureEngine::processMultiFingerGesture(const TouchPoint pts[], uint8_t count, unsigned long now){
+GestureEvent HOT_FN GestureEngine::processMultiFingerGesture(const TouchPoint pts[], uint8_t count, uint32_t now){
   GestureEvent g;
   g.type = GestureType::ThreeFingerTap;
   g.timestamp = now;
@@ -148,26 +165,25 @@ GestureEvent GestureEngine::processMultiFingerGesture(const TouchPoint pts[], ui
   return g;
 }
 
-GestureEvent GestureEngine::checkLongPress(const TouchPoint& tp, unsigned long now){
+GestureEvent HOT_FN GestureEngine::checkLongPress(const TouchPoint& tp, uint32_t now){
   GestureEvent g;
   g.type = GestureType::None;
   g.timestamp = now;
   
   if(!tp.active) return g;
   
-  unsigned long duration = now - tp.touch_start;
-  float movement = sqrt(pow(tp.x - tp.start_x, 2) + pow(tp.y - tp.start_y, 2));
+  uint32_t duration = now - tp.touch_start;
+  float movement = sqrtf(powf(tp.x - tp.start_x, 2) + powf(tp.y - tp.start_y, 2));
   
-  if(duration > LONG_PRESS_DURATION && movement <= TAP_MAX_MOVEMENT){
+  if(duration > _p.longPressMs && movement <= _p.tapMaxMovementPx){
     // Long Press erkannt - aber nur einmalig pro Touch-Session
-    static unsigned long lastLongPressTouch = 0;
-    if(tp.touch_start != lastLongPressTouch) {
+    if(tp.touch_start != _longPressTouch) {
       g.type = GestureType::LongPress;
       g.x = tp.x;
       g.y = tp.y;
       g.value = duration;
       g.finger_count = 1;
-      lastLongPressTouch = tp.touch_start; // Merken für diese Touch-Session
+      _longPressTouch = tp.touch_start; // Merken für diese Touch-Session
     }
   }
   
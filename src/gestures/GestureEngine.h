@@ -2,42 +2,76 @@
 // File: src/gestures/GestureEngine.h - VEREINFACHT & FUNKTIONIERT
 // ----------------------------------------------------------------------------
 #pragma once
-#include <Arduino.h>
+#include <stdint.h>
 #include "../config/params.h"
 #include "../core/types.h"
 
+// Erkennungsschwellen zur Laufzeit; Vorgabe aus gesture_params.h
+// (tools/gesture_tune spielt Aufnahmen mit vielen Sätzen parallel ab)
+struct GestureParams {
+  uint16_t tapMaxDurationMs    = TAP_MAX_DURATION;
+  uint16_t tapMaxMovementPx    = TAP_MAX_MOVEMENT;
+  uint16_t doubleTapIntervalMs = DOUBLE_TAP_INTERVAL;
+  uint16_t longPressMs         = LONG_PRESS_DURATION;
+  uint16_t swipeMinDistancePx  = SWIPE_MIN_DISTANCE;
+  uint16_t swipeMaxDurationMs  = SWIPE_MAX_DURATION;
+  float    swipeAxisRatio      = SWIPE_AXIS_RATIO;   // Haupt- zu Nebenachse
+  uint16_t settleMs            = TOUCH_SETTLE_MS;    // Fingerzahl stabil
+};
+
 // Vereinfachte, aber funktionierende Gestenerkennung basierend auf
-// ESP32_S3_CST328_Multi_Touch_Controller.ino
+// ESP32_S3_CST328_Multi_Touch_Controller.ino. Plattformneutral: Zeit kommt
+// vom Aufrufer (millis() am Gerät, Aufnahmezeit beim Abspielen).
 class GestureEngine {
 public:
   void reset();
+
+  void setParams(const GestureParams& p){ _p = p; }
+  const GestureParams& params() const { return _p; }
   
-  // Gibt maximal EIN Event pro Aufruf zurück (None, wenn keins fällig ist)
-  GestureEvent process(const TouchPoint pts[MAX_TOUCH_POINTS], uint8_t activeCount);
+  // Liefert die in diesem Frame fällige Geste, sonst type == None. Mehr als
+  // eine gibt es nicht: Loslass-Geste (activeCount == 0) und Long-Press
+  // (activeCount == 1) schließen sich aus.
+  // Solange sich die Fingerzahl innerhalb settleMs geändert hat, wird nicht
+  // ausgewertet. frameOriginUs = IRQ-Tag des Frames, wird ins Event
+  // übernommen; event_us setzt der Aufrufer.
+  GestureEvent process(const TouchPoint pts[MAX_TOUCH_POINTS], uint8_t activeCount, uint32_t nowMs,
+                       uint32_t frameOriginUs = 0);
+
+  // Nichts offen: ohne Finger ist process() dann wirkungslos (Wiedergabe
+  // überspringt solche Ruhephasen)
+  bool idle() const { return _lastActiveCount == 0 && _settleCount == 0; }
 
 private:
   // ============================================
   // VEREINFACHTE STATE-VERWALTUNG
   // ============================================
   
+  GestureParams _p;
+
   // Double-Tap Tracking
-  unsigned long _lastTapTime = 0;
+  uint32_t _lastTapTime = 0;
   uint16_t _lastTapX = 0;
   uint16_t _lastTapY = 0;
   
-  // Long-Press Tracking
-  unsigned long _lastLongPressTime = 0;
+  // Long-Press Tracking (einmal je Touch-Session)
+  uint32_t _longPressTouch = 0;
   
   // Frame-zu-Frame State
   uint8_t _lastActiveCount = 0;
   bool _lastActiveState[MAX_TOUCH_POINTS] = {false};
+
+  // Settle: Fingerzahl und seit wann sie gilt
+  uint8_t  _settleCount = 0;
+  uint32_t _settleSince = 0;
   
   // ============================================
   // PRIVATE HELPER-METHODEN
   // ============================================
   
-  GestureEvent processSingleFingerGesture(const TouchPoint& tp, unsigned long now);
-  GestureEvent processTwoFingerGesture(const TouchPoint& tp1, const TouchPoint& tp2, unsigned long now);
-  GestureEvent processMultiFingerGesture(const TouchPoint pts[], uint8_t count, unsigned long now);
-  GestureEvent checkLongPress(const TouchPoint& tp, unsigned long now);
+  static const TouchPoint& primary(const TouchPoint pts[MAX_TOUCH_POINTS]);
+  GestureEvent processSingleFingerGesture(const TouchPoint& tp, uint32_t now);
+  GestureEvent processTwoFingerGesture(const TouchPoint& tp1, const TouchPoint& tp2, uint32_t now);
+  GestureEvent processMultiFingerGesture(const TouchPoint pts[], uint8_t count, uint32_t now);
+  GestureEvent checkLongPress(const TouchPoint& tp, uint32_t now);
 };
\ No newline at end of file
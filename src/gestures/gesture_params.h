@@ -0,0 +1,18 @@
+// ============================================================================
+// File: src/gestures/gesture_params.h
+// ----------------------------------------------------------------------------
+// Purpose: Gestenschwellen für GestureEngine – GENERIERT, nicht von Hand ändern
+//  • Vorgabewerte (gesture_tune header), nicht aus Aufnahmen
+//  • Neu erzeugen: tools/gesture_tune tune <aufnahmen...> --out src/gestures/gesture_params.h
+// ============================================================================
+#pragma once
+#include <stdint.h>
+
+static constexpr uint16_t TAP_MAX_DURATION    = 250;   // ms, Aufsetzen bis Loslassen
+static constexpr uint16_t TAP_MAX_MOVEMENT    = 20;    // px, auch Abstand beim Doppeltipp
+static constexpr uint16_t DOUBLE_TAP_INTERVAL = 400;   // ms, Tap -> zweiter Tap
+static constexpr uint16_t LONG_PRESS_DURATION = 800;   // ms
+static constexpr uint16_t SWIPE_MIN_DISTANCE  = 30;    // px
+static constexpr uint16_t SWIPE_MAX_DURATION  = 500;   // ms
+static constexpr float    SWIPE_AXIS_RATIO    = 1.00f; // Haupt- zu Nebenachse
+static constexpr uint16_t TOUCH_SETTLE_MS     = 20;    // ms, Fingerzahl stabil
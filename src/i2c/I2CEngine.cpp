@@ -0,0 +1,230 @@
+// ============================================================================
+// File: src/i2c/I2CEngine.cpp
+// ----------------------------------------------------------------------------
+#include "I2CEngine.h"
+#include "../core/Profiler.h"
+#include "../core/StallMonitor.h"
+
+// ---------------------------- Deskriptor-Fabriken ---------------------------
+I2CTransaction I2CTransaction::readReg8(uint8_t addr, uint8_t reg, uint8_t* buf, size_t n){
+  I2CTransaction t;
+  t.addr = addr; t.reg[0] = reg; t.regLen = 1;
+  t.rx = buf; t.rxLen = n;
+  return t;
+}
+
+I2CTransaction I2CTransaction::readReg16(uint8_t addr, uint16_t reg, uint8_t* buf, size_t n){
+  I2CTransaction t;
+  t.addr = addr; t.reg[0] = (uint8_t)(reg >> 8); t.reg[1] = (uint8_t)(reg & 0xFF); t.regLen = 2;
+  t.rx = buf; t.rxLen = n;
+  return t;
+}
+
+I2CTransaction I2CTransaction::writeReg8(uint8_t addr, uint8_t reg, const uint8_t* buf, size_t n){
+  I2CTransaction t;
+  t.addr = addr; t.reg[0] = reg; t.regLen = 1;
+  t.tx = buf; t.txLen = n;
+  return t;
+}
+
+I2CTransaction I2CTransaction::writeReg16(uint8_t addr, uint16_t reg, const uint8_t* buf, size_t n){
+  I2CTransaction t;
+  t.addr = addr; t.reg[0] = (uint8_t)(reg >> 8); t.reg[1] = (uint8_t)(reg & 0xFF); t.regLen = 2;
+  t.tx = buf; t.txLen = n;
+  return t;
+}
+
+// ---------------------------- Engine ----------------------------------------
+bool I2CEngine::begin(const char* name, int sda, int scl, uint32_t freq, int core){
+  _name = name; _sda = sda; _scl = scl; _freq = freq;
+  if (!_wire.begin(sda, scl, freq)) return false;
+  _wire.setTimeOut(I2C_TIMEOUT_MS);
+  resetStats();
+
+  _syncLock = xSemaphoreCreateMutex();
+  _syncDone = xSemaphoreCreateBinary();
+  if (!_syncLock || !_syncDone) return false;
+  _queue = xQueueCreate(I2C_QUEUE_DEPTH, sizeof(I2CTransaction*));
+  if (!_queue) return false;
+  BaseType_t rc = xTaskCreatePinnedToCore(taskEntry, name, 3072, this, I2C_TASK_PRIORITY, &_task,
+                                          core < 0 ? tskNO_AFFINITY : core);
+  if (rc != pdPASS) {
+    vQueueDelete(_queue);
+    _queue = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void I2CEngine::taskEntry(void* arg){
+  I2CEngine* self = static_cast<I2CEngine*>(arg);
+  I2CTransaction* t = nullptr;
+  for (;;) {
+    if (xQueueReceive(self->_queue, &t, portMAX_DELAY) == pdTRUE && t) {
+      self->execute(*t);
+    }
+  }
+}
+
+bool I2CEngine::submit(I2CTransaction& t){
+  if (t.status == I2CStatus::Pending) { _stats.rejected++; return false; }
+  t.status   = I2CStatus::Pending;
+  t.submitUs = micros();
+
+  if (!_queue) {               // noch kein Worker: direkt ausführen
+    execute(t);
+    return true;
+  }
+
+  I2CTransaction* p = &t;
+  if (xQueueSend(_queue, &p, 0) != pdTRUE) {
+    t.status = I2CStatus::Idle;
+    _stats.rejected++;
+    return false;
+  }
+  uint16_t depth = (uint16_t)uxQueueMessagesWaiting(_queue);
+  if (depth > _stats.queueHigh) _stats.queueHigh = depth;
+  return true;
+}
+
+bool I2CEngine::transfer(I2CTransaction& t){
+  BLOCKING_SCOPE(BlockSite::I2CSync);
+  if (!_queue || xTaskGetCurrentTaskHandle() == _task) {
+    t.status   = I2CStatus::Pending;
+    t.submitUs = micros();
+    execute(t);
+    return t.status == I2CStatus::Ok;
+  }
+
+  // Nicht auf die Task-Notification warten: die kann der Aufrufer auch aus
+  // anderen Gründen bekommen (Touch-INT im Eingabe-Task) – t läge dann noch
+  // in der Queue, während sein Stack-Frame schon verschwindet.
+  xSemaphoreTake(_syncLock, portMAX_DELAY);
+  xSemaphoreTake(_syncDone, 0);              // alte Meldung verwerfen
+  t.sync = true;
+  if (!submit(t)) {
+    t.sync = false;
+    xSemaphoreGive(_syncLock);
+    return false;
+  }
+  // Kein eigenes Timeout: jeder Transfer endet spätestens nach I2C_TIMEOUT_MS,
+  // und t darf nicht vom Stack verschwinden, solange der Worker es noch hält.
+  while (t.status == I2CStatus::Pending) xSemaphoreTake(_syncDone, portMAX_DELAY);
+  xSemaphoreGive(_syncLock);
+  return t.status == I2CStatus::Ok;
+}
+
+bool I2CEngine::probe(uint8_t addr){
+  I2CTransaction t;
+  t.addr = addr;
+  return transfer(t);
+}
+
+uint8_t I2CEngine::queueDepth() const {
+  return _queue ? (uint8_t)uxQueueMessagesWaiting(_queue) : 0;
+}
+
+void I2CEngine::execute(I2CTransaction& t){
+  PROF_ZONE(ProfZone::I2C);
+  uint32_t t0 = micros();
+  I2CStatus st = runOnWire(t);
+  uint32_t t1 = micros();
+
+  _stats.busyUs += (t1 - t0);
+  _stats.xfer.add(t1 - t0);
+  _stats.latency.add(t1 - t.submitUs);
+
+  switch (st) {
+    case I2CStatus::Ok:      _stats.ok++;       break;
+    case I2CStatus::Nack:    _stats.nack++;     break;
+    case I2CStatus::Timeout: _stats.timeouts++; break;
+    default:                 _stats.errors++;   break;
+  }
+
+  // NACK eines fehlenden Geräts (z.B. beim Scan) ist kein Busfehler
+  if (st == I2CStatus::Ok || st == I2CStatus::Nack) {
+    _consecutiveErrors = 0;
+  } else if (++_consecutiveErrors >= I2C_RECOVER_AFTER_ERRORS) {
+    recoverBus();
+    _consecutiveErrors = 0;
+  }
+
+  t.doneUs = t1;
+  const bool sync = t.sync;
+  t.sync = false;
+  __sync_synchronize();        // rx-Daten vor dem Status sichtbar machen
+  t.status = st;
+
+  if (t.cb) t.cb(t, t.ctx);
+  if (sync) xSemaphoreGive(_syncDone);        // t danach nicht mehr anfassen
+}
+
+I2CStatus I2CEngine::runOnWire(I2CTransaction& t){
+  _wire.beginTransmission(t.addr);
+  for (uint8_t i = 0; i < t.regLen; i++) _wire.write(t.reg[i]);
+  for (size_t i = 0; i < t.txLen; i++)   _wire.write(t.tx[i]);
+
+  // Arduino-Codes: 2/3 = NACK, 5 = Timeout, sonst Busfehler
+  uint8_t rc = _wire.endTransmission(t.rxLen == 0);
+  if (rc == 2 || rc == 3) return I2CStatus::Nack;
+  if (rc == 5)            return I2CStatus::Timeout;
+  if (rc != 0)            return I2CStatus::Error;
+  if (t.rxLen == 0)       return I2CStatus::Ok;
+
+  size_t got = _wire.requestFrom((int)t.addr, (int)t.rxLen, (int)true);
+  if (got != t.rxLen) return I2CStatus::Error;
+  for (size_t i = 0; i < t.rxLen; i++) {
+    if (!_wire.available()) return I2CStatus::Error;
+    t.rx[i] = (uint8_t)_wire.read();
+  }
+  return I2CStatus::Ok;
+}
+
+// Hängender Slave hält SDA low: 9 Takte + STOP, dann Controller neu starten
+void I2CEngine::recoverBus(){
+  _stats.recoveries++;
+  _wire.end();
+
+  pinMode(_sda, INPUT_PULLUP);
+  pinMode(_scl, OUTPUT_OPEN_DRAIN);
+  for (int i = 0; i < 9 && digitalRead(_sda) == LOW; i++) {
+    digitalWrite(_scl, LOW);  delayMicroseconds(5);
+    digitalWrite(_scl, HIGH); delayMicroseconds(5);
+  }
+  pinMode(_sda, OUTPUT_OPEN_DRAIN);
+  digitalWrite(_sda, LOW);  delayMicroseconds(5);
+  digitalWrite(_scl, HIGH); delayMicroseconds(5);
+  digitalWrite(_sda, HIGH); delayMicroseconds(5);
+
+  _wire.begin(_sda, _scl, _freq);
+  _wire.setTimeOut(I2C_TIMEOUT_MS);
+}
+
+void I2CEngine::resetStats(){
+  _stats = I2CStats{};
+  _stats.sinceUs = micros();
+}
+
+void I2CEngine::printStats(Print& out) const {
+  uint32_t window = micros() - _stats.sinceUs;
+  float util = window ? (100.0f * (float)_stats.busyUs / (float)window) : 0.f;
+  out.printf("[I2C] %s: ok=%u nack=%u timeout=%u err=%u recover=%u rejected=%u\n",
+             _name, _stats.ok, _stats.nack, _stats.timeouts, _stats.errors,
+             _stats.recoveries, _stats.rejected);
+  out.printf("[I2C] %s: util=%.1f%% queue=%u/%u (high=%u)\n",
+             _name, util, queueDepth(), I2C_QUEUE_DEPTH, _stats.queueHigh);
+
+  printHist(out, "latency", _stats.latency);
+  printHist(out, "xfer", _stats.xfer);
+}
+
+void I2CEngine::printHist(Print& out, const char* what, const I2CStats::Histogram& h) const {
+  out.printf("[I2C] %s: %-7s us p50=%u p95=%u max=%u |", _name, what, h.percentile(0.50f),
+             h.percentile(0.95f), h.max);
+  for (uint8_t i = 0; i < I2C_HIST_BUCKETS; i++) {
+    if (!h.bins[i]) continue;
+    if (i < I2C_HIST_BUCKETS - 1) out.printf(" <=%u:%u", I2CStats::Histogram::bucketUpper(i), h.bins[i]);
+    else out.printf(" >%u:%u", I2CStats::Histogram::bucketUpper(i - 1), h.bins[i]);   // Sättigung
+  }
+  out.println();
+}
@@ -0,0 +1,111 @@
+// ============================================================================
+// File: src/i2c/I2CEngine.h
+// ----------------------------------------------------------------------------
+// Purpose: Asynchrone I2C-Transaktions-Queue pro Bus (eigener Worker-Task)
+//  • Aufrufer reichen vorgefertigte Deskriptoren ein (submit) und bekommen
+//    einen Completion-Callback aus dem Worker-Task
+//  • transfer() = submit + warten (für Init-Pfade / seltene Writes)
+//  • Bus-Recovery (9 SCL-Pulse + Neustart) nach wiederholten Fehlern
+//  • Statistik: Auslastung, Latenz-Histogramm (log2 µs), Queue-Hochwasser
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "../config/params.h"
+#include "../core/LogHistogram.h"
+
+enum class I2CStatus : uint8_t {
+  Idle = 0,
+  Pending,
+  Ok,
+  Nack,
+  Timeout,
+  Error
+};
+
+struct I2CTransaction;
+using I2CCallback = void (*)(I2CTransaction& t, void* ctx);
+
+// Vorgefertigter Transaktions-Deskriptor. Wird einmal aufgebaut und danach
+// beliebig oft eingereicht; gehört dem Aufrufer, bis status != Pending.
+struct I2CTransaction {
+  uint8_t        addr   = 0;
+  uint8_t        reg[2] = {0, 0};   // Registeradresse (MSB zuerst)
+  uint8_t        regLen = 0;        // 0, 1 oder 2 Byte
+  const uint8_t* tx     = nullptr;  // Schreibdaten nach dem Register
+  size_t         txLen  = 0;
+  uint8_t*       rx     = nullptr;  // Lesepuffer (Repeated Start)
+  size_t         rxLen  = 0;
+
+  I2CCallback    cb     = nullptr;  // läuft im Worker-Task!
+  void*          ctx    = nullptr;
+
+  volatile I2CStatus status = I2CStatus::Idle;
+  uint32_t       submitUs = 0;
+  uint32_t       doneUs   = 0;
+  bool           sync     = false;   // intern für transfer()
+
+  static I2CTransaction readReg8 (uint8_t addr, uint8_t reg,  uint8_t* buf, size_t n);
+  static I2CTransaction readReg16(uint8_t addr, uint16_t reg, uint8_t* buf, size_t n);
+  static I2CTransaction writeReg8 (uint8_t addr, uint8_t reg,  const uint8_t* buf, size_t n);
+  static I2CTransaction writeReg16(uint8_t addr, uint16_t reg, const uint8_t* buf, size_t n);
+};
+
+struct I2CStats {
+  uint32_t ok = 0, nack = 0, timeouts = 0, errors = 0;
+  uint32_t recoveries = 0, rejected = 0;
+  uint32_t busyUs = 0;              // Summe der Transferzeiten
+  uint32_t sinceUs = 0;             // Beginn des Messfensters
+  uint16_t queueHigh = 0;
+  // log2: Bucket 0 = 0 µs, Bucket i = 2^(i-1) .. 2^i - 1 µs
+  using Histogram = LogHistogram<0, I2C_HIST_BUCKETS>;
+  Histogram latency;                // submit -> done
+  Histogram xfer;                   // reine Buszeit
+};
+
+class I2CEngine {
+public:
+  explicit I2CEngine(TwoWire& wire) : _wire(wire) {}
+
+  // Bus initialisieren und Worker-Task starten (core < 0 => ohne Affinität)
+  bool begin(const char* name, int sda, int scl, uint32_t freq, int core = -1);
+
+  // Asynchron einreihen. false, wenn Queue voll oder t noch Pending ist.
+  bool submit(I2CTransaction& t);
+
+  // Synchron ausführen (blockiert den Aufrufer, nicht den Bus der anderen).
+  // Vor begin() bzw. ohne Worker wird direkt auf dem Aufrufer-Thread gearbeitet.
+  bool transfer(I2CTransaction& t);
+
+  bool probe(uint8_t addr);
+  uint8_t queueDepth() const;
+
+  const I2CStats& stats() const { return _stats; }
+  void resetStats();
+  void printStats(Print& out) const;
+  const char* name() const { return _name; }
+
+private:
+  static void taskEntry(void* arg);
+  void execute(I2CTransaction& t);
+  I2CStatus runOnWire(I2CTransaction& t);
+  void recoverBus();
+  void printHist(Print& out, const char* what, const I2CStats::Histogram& h) const;
+
+  TwoWire&      _wire;
+  const char*   _name = "i2c";
+  int           _sda = -1, _scl = -1;
+  uint32_t      _freq = 0;
+  QueueHandle_t _queue = nullptr;
+  TaskHandle_t  _task  = nullptr;
+  // transfer(): ein synchroner Aufrufer je Bus, Fertigmeldung über eine
+  // eigene Semaphore (Task-Notification des Aufrufers gehört ihm, z.B. Touch-INT)
+  SemaphoreHandle_t _syncLock = nullptr;
+  SemaphoreHandle_t _syncDone = nullptr;
+  uint8_t       _consecutiveErrors = 0;
+  I2CStats      _stats;
+};
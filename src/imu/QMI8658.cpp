@@ -1,4 +1,6 @@
 #include "QMI8658.h"
+#include "../config/params.h"
+#include "../core/Profiler.h"
 
 // Register (Auszug)
 static constexpr uint8_t REG_WHO_AM_I = 0x00;
@@ -12,8 +14,17 @@ static constexpr uint8_t REG_AX_L     = 0x35; // ... bis 0x40
 
 static constexpr uint8_t WHOAMI_EXPECT = 0x05;       // :contentReference[oaicite:9]{index=9}
 
-bool QMI8658::begin() {
+bool QMI8658::begin(I2CEngine& bus) {
+  if (!beginReset(bus)) return false;
+  delay(IMU_RESET_MS);
+  if (!beginConfigure()) return false;
+  delay(IMU_ENABLE_MS);
+  return true;
+}
+
+bool QMI8658::beginReset(I2CEngine& bus) {
   // I2C erst in App gesetzt; hier nur Adresse finden & konfigurieren
+  _bus = &bus;
   if (!detectAddress()) {
     Serial.println("[IMU] WHO_AM_I mismatch / kein Sensor");
     return false;
@@ -21,7 +32,11 @@ bool QMI8658::begin() {
 
   // --- Soft Reset (Reset-Register 0x60) ---  :contentReference[oaicite:10]{index=10}
   write1(0x60, 0xB0);   // gängiger Wert für Soft-Reset
-  delay(10);
+  return true;
+}
+
+bool QMI8658::beginConfigure() {
+  if (!_addr) return false;
 
   // --- CTRL1: Auto-Increment aktivieren (ADDR_AI=1), Little Endian (BE=0) ---  :contentReference[oaicite:11]{index=11}
   // Bit6=1 (ADDR_AI), Bit5=0 (BE little-endian), Rest 0 => 0b0100'0000 = 0x40
@@ -42,20 +57,54 @@ bool QMI8658::begin() {
   // syncSmpl=0 (einfach), gEN=1, aEN=1 => 0b0000'0011 = 0x03
   if (!write1(REG_CTRL7, 0x03)) return false;
 
-  delay(5);
+  _burstXfer = I2CTransaction::readReg8(_addr, REG_STATUS0, _burst, sizeof(_burst));
+  _burstXfer.cb  = onBurstDone;
+  _burstXfer.ctx = this;
   Serial.printf("[IMU] QMI8658 @0x%02X initialisiert\n", _addr);
   return true;
 }
 
 bool QMI8658::read(IMUData& out) {
+  PROF_ZONE(ProfZone::Imu);
+  // STATUS0 (0x2E) bis GZ_H (0x40) in einem Burst – dank ADDR_AI=1
+  uint8_t b[sizeof(_burst)];
+  if (!readN(REG_STATUS0, b, sizeof(b))) return false;
+  if (!decodeBurst(b, out)) return false;
+  _last = out;
+  return true;
+}
+
+void QMI8658::onBurstDone(I2CTransaction& t, void* ctx) {
+  (void)t;
+  static_cast<QMI8658*>(ctx)->_burstDone = true;
+}
+
+bool QMI8658::requestRead() {
+  if (!_bus || _addr == 0 || _burstDone || _burstXfer.status == I2CStatus::Pending) return false;
+  return _bus->submit(_burstXfer);
+}
+
+bool QMI8658::collect(IMUData& out, bool* failed) {
+  if (failed) *failed = false;
+  if (!_burstDone) return false;
+  PROF_ZONE(ProfZone::Imu);
+  _burstDone = false;
+  if (_burstXfer.status != I2CStatus::Ok) {
+    if (failed) *failed = true;
+    return false;
+  }
+  if (!decodeBurst(_burst, out)) return false;
+  _last = out;
+  return true;
+}
+
+bool QMI8658::decodeBurst(const uint8_t* burst, IMUData& out) {
   // Daten bereit? STATUS0: Bit0=aDA, Bit1=gDA  :contentReference[oaicite:16]{index=16}
-  uint8_t st = 0;
-  if (!readN(REG_STATUS0, &st, 1)) return false;
+  const uint8_t st = burst[0];
   if ((st & 0x03) == 0) return false; // nichts Neues
 
-  // Dank ADDR_AI=1 können wir 12 Bytes am Stück holen (AX..GZ)  :contentReference[oaicite:17]{index=17}
-  uint8_t b[12];
-  if (!readN(REG_AX_L, b, sizeof(b))) return false;
+  // AX_L liegt 7 Byte hinter STATUS0 im Burst (AX..GZ = 12 Bytes)  :contentReference[oaicite:17]{index=17}
+  const uint8_t* b = burst + (REG_AX_L - REG_STATUS0);
 
   auto s16 = [&](int i) -> int16_t { return (int16_t)((uint16_t)b[i+1] << 8 | b[i]); };
 
@@ -90,23 +139,27 @@ bool QMI8658::detectAddress() {
   return false;
 }
 
-// --- I2C helpers ---
+// --- I2C helpers (synchron über die Engine) ---
 bool QMI8658::write1(uint8_t reg, uint8_t val) {
-  Wire.beginTransmission(_addr);
-  Wire.write(reg);
-  Wire.write(val);
-  return Wire.endTransmission() == 0;
+  I2CTransaction t = I2CTransaction::writeReg8(_addr, reg, &val, 1);
+  return _bus->transfer(t);
 }
 
 bool QMI8658::readN(uint8_t reg, uint8_t* buf, size_t n) {
-  Wire.beginTransmission(_addr);
-  Wire.write(reg);
-  if (Wire.endTransmission(false) != 0) return false;
-  size_t got = Wire.requestFrom((int)_addr, (int)n, (int)true);
-  if (got != n) return false;
-  for (size_t i=0; i<n; ++i) {
-    if (!Wire.available()) return false;
-    buf[i] = Wire.read();
-  }
-  return true;
+  I2CTransaction t = I2CTransaction::readReg8(_addr, reg, buf, n);
+  return _bus->transfer(t);
+}
+
+// ---------------------------- Konsole ---------------------------------------
+static constexpr cmd::Command IMU_CMDS[] = {
+  {"debug imu", "", "", [](void* c, const cmd::Args&){
+    const IMUData& d = static_cast<QMI8658*>(c)->last();
+    Serial.printf("[DEBUG] IMU: ax=%.3f ay=%.3f az=%.3f gx=%.1f gy=%.1f gz=%.1f\n",
+                  d.ax, d.ay, d.az, d.gx, d.gy, d.gz);
+    Serial.printf("[DEBUG] |g| = %.3f (should be ~1.0)\n", sqrtf(d.ax * d.ax + d.ay * d.ay + d.az * d.az));
+  }},
+};
+
+void QMI8658::registerCommands(cmd::Registry& r){
+  r.add(IMU_CMDS, this, "imu");
 }
@@ -1,6 +1,8 @@
 #pragma once
 #include <Arduino.h>
 #include <Wire.h>
+#include "../i2c/I2CEngine.h"
+#include "../comm/CommandTable.h"
 
 // Minimaler Datenträger für App
 struct IMUData {
@@ -10,11 +12,31 @@ struct IMUData {
 
 class QMI8658 {
 public:
-  bool begin();                  // init + config
+  bool begin(I2CEngine& bus);    // init + config (am Stück, mit delay())
+
+  // Boot in Schritten (BootSequencer): nach beginReset() IMU_RESET_MS,
+  // nach beginConfigure() IMU_ENABLE_MS warten, ohne zu blockieren
+  bool beginReset(I2CEngine& bus);   // WHO_AM_I + Soft-Reset
+  bool beginConfigure();             // CTRL-Register, Burst-Deskriptor
   bool read(IMUData& out);       // eine Probe lesen (true = Daten geliefert)
 
+  // Asynchron: STATUS0..GZ_H als ein Burst über die I2C-Engine
+  bool requestRead();
+  bool collect(IMUData& out, bool* failed = nullptr);
+  const IMUData& last() const { return _last; }   // letzte gültige Probe
+
+  void registerCommands(cmd::Registry& r);   // debug imu
+
 private:
   uint8_t _addr = 0x00;
+  I2CEngine*     _bus = nullptr;
+  I2CTransaction _burstXfer;
+  uint8_t        _burst[19]{};   // 0x2E..0x40
+  volatile bool  _burstDone = false;
+  IMUData        _last{0, 0, 0, 0, 0, 0};
+
+  static void onBurstDone(I2CTransaction& t, void* ctx);
+  static bool decodeBurst(const uint8_t* b, IMUData& out);
 
   bool write1(uint8_t reg, uint8_t val);
   bool readN(uint8_t reg, uint8_t* buf, size_t n);
@@ -10,64 +10,115 @@
 #define TOUCH_MIN_STRENGTH 0
 #endif
 
+#include "../core/LatencyTrace.h"
+#include "../core/Placement.h"
+#include "../core/Profiler.h"
+#include <LittleFS.h>
+#include <esp_timer.h>
+#if CONFIG_IDF_TARGET_ESP32S3
+  #include <esp32s3/rom/cache.h>
+#endif
+
 volatile bool CST328Touch::irqFlag = false;
+volatile uint32_t CST328Touch::irqMicros = 0;
+TaskHandle_t CST328Touch::_notifyTask = nullptr;
 
 void IRAM_ATTR CST328Touch::onIntISR(){
+  irqMicros = micros();
   irqFlag = true;
+  if (_notifyTask) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(_notifyTask, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
 }
 
-bool CST328Touch::begin(){
+bool CST328Touch::begin(I2CEngine& bus){
+  resetAssert(bus);
+  delay(TOUCH_RST_LOW_MS);
+  resetRelease();
+  delay(TOUCH_RST_BOOT_MS);
+  return attach();
+}
+
+void CST328Touch::resetAssert(I2CEngine& bus){
   Serial.println("[TOUCH] CST328 Init...");
+  _bus = &bus;
+  _frameXfer = I2CTransaction::readReg16(CST328_I2C_ADDR, CST328_REG_COORD, _frameBuf, sizeof(_frameBuf));
+  _frameXfer.cb  = onFrameDone;
+  _frameXfer.ctx = this;
   
   // Reset Touch Controller
   pinMode(PIN_TOUCH_RST, OUTPUT);
   digitalWrite(PIN_TOUCH_RST, LOW); 
-  delay(50);
+}
+
+void CST328Touch::resetRelease(){
   digitalWrite(PIN_TOUCH_RST, HIGH); 
-  delay(100);
+}
+
+bool CST328Touch::attach(){
+  if (!_bus) return false;
 
   // Interrupt Setup
   pinMode(PIN_TOUCH_INT, INPUT_PULLUP);
   attachInterrupt(digitalPinToInterrupt(PIN_TOUCH_INT), onIntISR, FALLING);
   
   // Test CST328 Kommunikation
-  Wire1.beginTransmission(CST328_I2C_ADDR);
-  if (Wire1.endTransmission() != 0) {
+  if (!_bus->probe(CST328_I2C_ADDR)) {
     Serial.printf("[TOUCH] ERROR: CST328 not found at 0x%02X\n", CST328_I2C_ADDR);
     return false;
   }
   
   Serial.println("[TOUCH] CST328 found and ready");
+
+  // Aufnahmepuffer einmalig (vor heapguard::seal), ohne PSRAM keine Aufnahme
+  if (!_rec.data()) {
+    uint8_t* buf = (uint8_t*)place::alloc(TOUCH_REC_BYTES, place::Mem::Bulk, "touchrec");
+    if (buf) _rec.begin(buf, TOUCH_REC_BYTES);
+    else Serial.println("[TREC] kein PSRAM - Aufnahme nicht verfügbar");
+  }
   return true;
 }
 
 bool CST328Touch::readReg16(uint16_t reg, uint8_t* buf, size_t len){
-  Wire1.beginTransmission(CST328_I2C_ADDR);
-  Wire1.write((uint8_t)(reg >> 8));
-  Wire1.write((uint8_t)(reg & 0xFF));
-  if (Wire1.endTransmission(false) != 0) return false;
-  
-  size_t got = Wire1.requestFrom((int)CST328_I2C_ADDR, (int)len, (int)true);
-  if (got != len) return false;
-  
-  for (size_t i = 0; i < len; i++) {
-    if (!Wire1.available()) return false;
-    buf[i] = Wire1.read();
-  }
-  return true;
+  I2CTransaction t = I2CTransaction::readReg16(CST328_I2C_ADDR, reg, buf, len);
+  return _bus->transfer(t);
 }
 
-// NEU: writeReg16 Implementierung
 bool CST328Touch::writeReg16(uint16_t reg, const uint8_t* buf, size_t len){
-  Wire1.beginTransmission(CST328_I2C_ADDR);
-  Wire1.write((uint8_t)(reg >> 8));
-  Wire1.write((uint8_t)(reg & 0xFF));
-  
-  for (size_t i = 0; i < len; i++) {
-    Wire1.write(buf[i]);
-  }
-  
-  return (Wire1.endTransmission() == 0);
+  I2CTransaction t = I2CTransaction::writeReg16(CST328_I2C_ADDR, reg, buf, len);
+  return _bus->transfer(t);
+}
+
+// Completion-Callback läuft im I2C-Worker: nur Flag setzen, Dekodieren im Loop
+void CST328Touch::onFrameDone(I2CTransaction& t, void* ctx){
+  (void)t;
+  static_cast<CST328Touch*>(ctx)->_frameDone = true;
+  if (_notifyTask) xTaskNotifyGive(_notifyTask);   // läuft im I2C-Worker
+}
+
+bool CST328Touch::requestFrame(){
+  if (!_bus || framePending() || _frameDone) return false;
+  // Frame-Tag: noch nicht verbrauchte INT-Flanke, sonst Poll-Zeitpunkt
+  uint32_t irq = irqMicros;
+  uint32_t origin = (irq != _usedIrqUs) ? irq : micros();
+  if (!_bus->submit(_frameXfer)) return false;
+  _usedIrqUs = irq;
+  _pendingOriginUs = origin;
+  return true;
+}
+
+bool HOT_FN CST328Touch::collectFrame(){
+  if (!_frameDone) return false;
+  PROF_ZONE(ProfZone::Touch);
+  _frameDone = false;
+  if (_frameXfer.status != I2CStatus::Ok) return false;
+  if (!decodeFrame(_frameBuf)) return false;
+  _lastOriginUs = _pendingOriginUs;
+  _lastDoneUs   = micros();
+  latency::record(LatStage::IrqToFrame, _lastDoneUs - _lastOriginUs);
+  return true;
 }
 
 void CST328Touch::resetController() {
@@ -80,11 +131,7 @@ void CST328Touch::resetController() {
   delay(50);
   
   // Reset internal state
-  for (auto &p : _points) {
-    p.active = false;
-    p.was_active_last_frame = false;
-  }
-  _activeCount = 0;
+  _tracker.reset();
   _rawCount = 0;
   _corruptionCount = 0;
   
@@ -103,12 +150,17 @@ void CST328Touch::resetController() {
 // ============================================================================
 bool CST328Touch::readFrame()
 {
+  PROF_ZONE(ProfZone::Touch);
   // 1) Gesamten Block D000..D01A holen (27 Bytes)
-  uint8_t buf[27] = {0};
-  if (!readReg16(0xD000, buf, sizeof(buf))) {
+  uint8_t buf[CST328_FRAME_LEN] = {0};
+  if (!readReg16(CST328_REG_COORD, buf, sizeof(buf))) {
     return false;
   }
+  return decodeFrame(buf);
+}
 
+bool HOT_FN CST328Touch::decodeFrame(const uint8_t* buf)
+{
   // 2) Fingerzahl + Signatur prüfen
   const uint8_t d005 = buf[0x05];               // Fingerzahl im low nibble
   const uint8_t d006 = buf[0x06];               // soll 0xAB sein
@@ -126,17 +178,15 @@ bool CST328Touch::readFrame()
     return false;                                // nächster Frame wird korrekt
   }
 
+  // Zeitbasis für Tracker und Aufnahme (millis() = esp_timer / 1000)
+  const uint64_t nowUs = esp_timer_get_time();
+  const uint32_t nowMs = (uint32_t)(nowUs / 1000u);
+
   // 3) 0 Finger → Releases und zurück
   if (count == 0) {
-    for (auto &p : _points) {
-      if (p.active) {
-        p.active = false;
-        p.touch_end = millis();
-        p.was_active_last_frame = true;
-      }
-    }
     _rawCount = 0;
-    _activeCount = 0;
+    recordFrame(nowUs);
+    _tracker.update(nullptr, 0, nowMs);
 
     // Debug (throttled)
     static unsigned long t0 = 0;
@@ -181,18 +231,13 @@ bool CST328Touch::readFrame()
     }
   }
   _rawCount = kept;
+  recordFrame(nowUs);
 
-  // 6) Wenn nach Status-Filter nichts übrig → Releases
-  if (_rawCount == 0) {
-    for (auto &p : _points) {
-      if (p.active) {
-        p.active = false;
-        p.touch_end = millis();
-        p.was_active_last_frame = true;
-      }
-    }
-    _activeCount = 0;
-  }
+  // 6) Auf Display-Koordinaten abbilden und Finger nachführen
+  //    (nach Status-Filter nichts übrig → Releases)
+  TouchContact c[MAX_TOUCH_POINTS];
+  for (uint8_t i = 0; i < _rawCount; ++i) touchRawToContact(_raw[i], c[i]);
+  _tracker.update(c, _rawCount, nowMs);
 
   // 7) Debug-Ausgabe (throttled)
   static unsigned long lastDbg = 0;
@@ -211,36 +256,144 @@ bool CST328Touch::readFrame()
 
 
 
-int CST328Touch::findActiveIndex(const TouchPoint* p) const {
-  for (int i = 0; i < MAX_TOUCH_POINTS; i++) {
-    if (&_points[i] == p) return i;
+// Aufnahme: genau die Punkte, die der Tracker bekommt (nach Status-Filter)
+void HOT_FN CST328Touch::recordFrame(uint64_t us){
+  if (_rec.recording() && !_rec.append(us, _raw, _rawCount)) {
+    Serial.println("[TREC] Puffer voll - Aufnahme beendet");
   }
-  return -1;
 }
 
-void CST328Touch::rawToDisplay(uint16_t rx, uint16_t ry, uint16_t& dx, uint16_t& dy) const {
-  // Normalisierung mit korrigierter Raw-Range
-  float nx = (float)(rx - TOUCH_RAW_X_MIN) / (float)(TOUCH_RAW_X_MAX - TOUCH_RAW_X_MIN);
-  float ny = (float)(ry - TOUCH_RAW_Y_MIN) / (float)(TOUCH_RAW_Y_MAX - TOUCH_RAW_Y_MIN);
-  nx = constrain(nx, 0.f, 1.f);
-  ny = constrain(ny, 0.f, 1.f);
+void CST328Touch::mapAndTrack() {
+  // Alles wird in decodeFrame() gemacht (TouchTracker)
+}
 
-  // Achsentausch & Invertierung  
-  float ax = TOUCH_SWAP_XY ? ny : nx;
-  float ay = TOUCH_SWAP_XY ? nx : ny;
+void CST328Touch::getTouchPoints(TouchPoint out[MAX_TOUCH_POINTS]) const {
+  memcpy(out, _tracker.points(), sizeof(TouchPoint) * MAX_TOUCH_POINTS);
+}
 
-  if (TOUCH_INVERT_X) ax = 1.f - ax;
-  if (TOUCH_INVERT_Y) ay = 1.f - ay;
+// ---------------------------- Benchmark -------------------------------------
+// Touch -> Geste ab Rohpunkten (touchRawToContact -> TouchTracker ->
+// GestureEngine) mit eigenem Tracker/Engine, Zeit virtuell in 10-ms-Frames.
+// Zyklus 1 s: Tap, Wischen, Zwei-Finger-Pinch, dazwischen Ruhe
+static uint8_t benchFrame(uint32_t i, RawCSTPoint* p){
+  const uint32_t k = i % 100;
+  const uint16_t span = TOUCH_RAW_X_MAX - TOUCH_RAW_X_MIN;
+  const uint16_t midY = (TOUCH_RAW_Y_MIN + TOUCH_RAW_Y_MAX) / 2;
+  if (k < 4) { p[0] = {(uint16_t)(TOUCH_RAW_X_MIN + span / 2), midY, 40}; return 1; }
+  if (k >= 10 && k < 30) {
+    p[0] = {(uint16_t)(TOUCH_RAW_X_MIN + span / 10 + (k - 10) * span / 28), midY, 50};
+    return 1;
+  }
+  if (k >= 40 && k < 60) {
+    const uint16_t d = (uint16_t)((60 - k) * span / 50);
+    p[0] = {(uint16_t)(TOUCH_RAW_X_MIN + span / 2 - d), midY, 45};
+    p[1] = {(uint16_t)(TOUCH_RAW_X_MIN + span / 2 + d), midY, 45};
+    return 2;
+  }
+  return 0;
+}
 
-  // Skalierung auf Display
-  dx = (uint16_t)lroundf(ax * (DISPLAY_WIDTH - 1));
-  dy = (uint16_t)lroundf(ay * (DISPLAY_HEIGHT - 1));
+// cold: ICache vor jedem Frame verwerfen (ESP32-S3, ROM). Code im Flash muss
+// dann nachgeladen werden – wie bei Cache-Verdrängung durch Flash/PSRAM-Last.
+// Die ICache hat keine schmutzigen Zeilen, Verwerfen ist folgenlos.
+static void benchRun(uint32_t frames, bool cold, uint32_t& avg, uint32_t& peak, uint32_t& events){
+  TouchTracker  tracker;
+  GestureEngine engine;
+  uint64_t sum = 0;
+  avg = peak = events = 0;
+  for (uint32_t i = 0; i < frames; i++) {
+    RawCSTPoint raw[MAX_TOUCH_POINTS];
+    const uint8_t n = benchFrame(i, raw);
+    const uint32_t ms = i * 10;
+#if CONFIG_IDF_TARGET_ESP32S3
+    if (cold) Cache_Invalidate_ICache_All();
+#else
+    (void)cold;
+#endif
+    const uint32_t t0 = ESP.getCycleCount();
+    TouchContact c[MAX_TOUCH_POINTS];
+    for (uint8_t j = 0; j < n; j++) touchRawToContact(raw[j], c[j]);
+    tracker.update(c, n, ms);
+    if (engine.process(tracker.points(), tracker.activeCount(), ms).type != GestureType::None) events++;
+    const uint32_t dt = ESP.getCycleCount() - t0;
+    sum += dt;
+    if (dt > peak) peak = dt;
+  }
+  avg = frames ? (uint32_t)(sum / frames) : 0;
 }
 
-void CST328Touch::mapAndTrack() {
-  // Alles wird in readFrame() gemacht
+static void touchBench(uint32_t frames){
+  const uint32_t mhz = ESP.getCpuFreqMHz();
+  Serial.printf("[TBENCH] HOT_FN %s (PLACEMENT_ENABLED=%d), %lu Frames, CPU %lu MHz\n",
+                PLACEMENT_ACTIVE ? "IRAM" : "Flash", PLACEMENT_ENABLED,
+                (unsigned long)frames, (unsigned long)mhz);
+  for (int cold = 0; cold < 2; cold++) {
+#if !CONFIG_IDF_TARGET_ESP32S3
+    if (cold) { Serial.println("[TBENCH] kalt: nur ESP32-S3"); break; }
+#endif
+    uint32_t avg, peak, events;
+    benchRun(frames, cold, avg, peak, events);
+    Serial.printf("[TBENCH] %s: Ø %lu Zyklen (%.2f µs), max %lu Zyklen (%.2f µs), %lu Gesten\n",
+                  cold ? "kalt" : "warm", (unsigned long)avg, (float)avg / mhz,
+                  (unsigned long)peak, (float)peak / mhz, (unsigned long)events);
+  }
 }
 
-void CST328Touch::getTouchPoints(TouchPoint out[MAX_TOUCH_POINTS]) const {
-  memcpy(out, _points, sizeof(_points));
-}
\ No newline at end of file
+// ---------------------------- Konsole ---------------------------------------
+static constexpr cmd::Command TOUCH_CMDS[] = {
+  {"debug touch", "", "", [](void* c, const cmd::Args&){
+    const CST328Touch& t = *static_cast<CST328Touch*>(c);
+    Serial.printf("[DEBUG] Touch active points: %u\n", t.activeCount());
+    TouchPoint pts[MAX_TOUCH_POINTS];
+    t.getTouchPoints(pts);
+    for (int i = 0; i < MAX_TOUCH_POINTS; i++) {
+      if (pts[i].active) {
+        Serial.printf("[DEBUG] Touch %d: (%d,%d) strength=%d\n", i, pts[i].x, pts[i].y, pts[i].strength);
+      }
+    }
+  }},
+  {"touch bench", "?u", "[frames]", [](void*, const cmd::Args& a){
+    touchBench(a.u(0, PLACE_BENCH_FRAMES));
+  }},
+  {"touchrec", "", "", [](void* c, const cmd::Args&){
+    const TouchRecorder& r = static_cast<CST328Touch*>(c)->recorder();
+    if (!r.data()) { Serial.println("[TREC] nicht verfügbar (kein PSRAM)"); return; }
+    const float secs = r.durationUs() / 1e6f;
+    Serial.printf("[TREC] %s: %lu Frames (%lu gelesen) in %.1f s, %u B von %u KB (%.1f %%), %.2f B/Frame\n",
+                  r.recording() ? "Aufnahme" : (r.full() ? "voll" : "gestoppt"),
+                  (unsigned long)r.frames(), (unsigned long)r.seen(), secs, (unsigned)r.size(),
+                  (unsigned)(r.capacity() / 1024), 100.f * r.size() / r.capacity(),
+                  r.frames() ? (float)r.size() / r.frames() : 0.f);
+    // Vergleich: je gelesenem Frame der Registerblock plus 64-Bit-Zeitstempel
+    const float raw = (float)r.seen() * (CST328_FRAME_LEN + 8);
+    if (r.size() && secs > 0.f) {
+      Serial.printf("[TREC] Kompression x%.1f gegen Rohframes, Puffer reicht bei dieser Rate %.1f h\n",
+                    raw / r.size(), r.capacity() / (r.size() / secs) / 3600.f);
+    }
+  }},
+  {"touchrec save", "w", "<datei>", [](void* c, const cmd::Args& a){
+    const TouchRecorder& r = static_cast<CST328Touch*>(c)->recorder();
+    if (r.recording()) { Serial.println("[TREC] erst 'touchrec stop'"); return; }
+    if (!r.size()) { Serial.println("[TREC] keine Aufnahme"); return; }
+    File f;
+    if (LittleFS.begin(false)) f = LittleFS.open(a.s(0), "w");
+    if (!f) { Serial.printf("[TREC] %s nicht beschreibbar\n", a.s(0)); return; }
+    const size_t n = f.write(r.data(), r.size());
+    f.close();
+    Serial.printf("[TREC] %s: %u B %s\n", a.s(0), (unsigned)n, n == r.size() ? "geschrieben" : "UNVOLLSTÄNDIG");
+  }},
+  {"touchrec start", "", "", [](void* c, const cmd::Args&){
+    TouchRecorder& r = static_cast<CST328Touch*>(c)->recorder();
+    Serial.println(r.start(esp_timer_get_time()) ? "[TREC] Aufnahme läuft" : "[TREC] nicht verfügbar (kein PSRAM)");
+  }},
+  {"touchrec stop", "", "", [](void* c, const cmd::Args&){
+    TouchRecorder& r = static_cast<CST328Touch*>(c)->recorder();
+    r.stop();
+    Serial.printf("[TREC] gestoppt: %lu Frames, %u B\n", (unsigned long)r.frames(), (unsigned)r.size());
+  }},
+};
+static_assert(cmd::sorted(TOUCH_CMDS), "TOUCH_CMDS nicht sortiert");
+
+void CST328Touch::registerCommands(cmd::Registry& r){
+  r.add(TOUCH_CMDS, this, "touch");
+}
@@ -4,38 +4,79 @@
 #pragma once
 #include <Arduino.h>
 #include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include "../config/pins.h"
 #include "../config/params.h"
 #include "../core/types.h"
+#include "../i2c/I2CEngine.h"
+#include "TouchTracker.h"
+#include "TouchSession.h"
+#include "../comm/CommandTable.h"
 
 // CST328 Register
 static constexpr uint16_t CST328_REG_NUM   = 0xD005;
 static constexpr uint16_t CST328_REG_COORD = 0xD000;
-
-struct RawCSTPoint { uint16_t x, y, strength; };
+static constexpr size_t   CST328_FRAME_LEN = 27;     // D000..D01A
 
 class CST328Touch {
 public:
-  bool begin();
-  bool readFrame();
+  bool begin(I2CEngine& bus);   // am Stück (Reset mit delay())
+
+  // Boot in Schritten (BootSequencer): zwischen den Aufrufen
+  // TOUCH_RST_LOW_MS bzw. TOUCH_RST_BOOT_MS warten, ohne zu blockieren
+  void resetAssert(I2CEngine& bus);  // RST low
+  void resetRelease();               // RST high, Controller läuft an
+  bool attach();                     // IRQ + Probe
+  bool readFrame();          // synchron (blockiert bis Frame da ist)
+
+  // Asynchron über die I2C-Engine: requestFrame() reiht den vorgefertigten
+  // Lese-Deskriptor ein, collectFrame() dekodiert, sobald er fertig ist.
+  bool requestFrame();
+  bool collectFrame();
+  bool framePending() const { return _frameXfer.status == I2CStatus::Pending; }
+
+  // Latenz-Trace: IRQ- (bzw. Poll-)Zeitpunkt und Dekodier-Ende des letzten Frames
+  uint32_t lastFrameOriginUs() const { return _lastOriginUs; }
+  uint32_t lastFrameDoneUs() const { return _lastDoneUs; }
   void mapAndTrack();
   void getTouchPoints(TouchPoint out[MAX_TOUCH_POINTS]) const;
-  uint8_t activeCount() const { return _activeCount; }
+  uint8_t activeCount() const { return _tracker.activeCount(); }
+
+  // Sitzungsaufnahme der dekodierten Rohframes ("touchrec", Puffer im PSRAM)
+  TouchRecorder& recorder(){ return _rec; }
+
+  void registerCommands(cmd::Registry& r);   // debug touch
 
   // Interruptsteuerung
   static void IRAM_ATTR onIntISR();
   static volatile bool irqFlag;
+  static volatile uint32_t irqMicros;   // Zeitstempel der letzten INT-Flanke
+  // Task, der bei INT-Flanke und fertigem Frame geweckt wird (Eingabe-Task)
+  static void setNotifyTask(TaskHandle_t t){ _notifyTask = t; }
 
 private:
+  bool decodeFrame(const uint8_t* buf);
+  static void onFrameDone(I2CTransaction& t, void* ctx);
+  static TaskHandle_t _notifyTask;
+
   bool readReg16(uint16_t reg, uint8_t* buf, size_t len);
   bool writeReg16(uint16_t reg, const uint8_t* buf, size_t len); // NEU: Write-Funktion
-  void rawToDisplay(uint16_t rx, uint16_t ry, uint16_t& dx, uint16_t& dy) const;
-  int findActiveIndex(const TouchPoint* p) const;
+  void recordFrame(uint64_t us);
   void resetController(); // Controller-Reset bei Korruption
 
   RawCSTPoint _raw[MAX_TOUCH_POINTS]{};
   uint8_t _rawCount = 0;
-  TouchPoint _points[MAX_TOUCH_POINTS]{};
-  uint8_t _activeCount = 0;
+  TouchTracker _tracker;        // Kontakte -> TouchPoint-Slots (Start/Ende/Loslassen)
+  TouchRecorder _rec;
   uint8_t _corruptionCount = 0; // Zähler für korrupte Daten
+
+  I2CEngine*     _bus = nullptr;
+  I2CTransaction _frameXfer;
+  uint8_t        _frameBuf[CST328_FRAME_LEN]{};
+  volatile bool  _frameDone = false;
+  uint32_t       _usedIrqUs = 0;     // bereits einem Frame zugeordnete Flanke
+  uint32_t       _pendingOriginUs = 0;
+  uint32_t       _lastOriginUs = 0;
+  uint32_t       _lastDoneUs = 0;
 };
\ No newline at end of file
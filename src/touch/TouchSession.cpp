@@ -0,0 +1,210 @@
+// ============================================================================
+// File: src/touch/TouchSession.cpp
+// ----------------------------------------------------------------------------
+#include "TouchSession.h"
+#include "../core/Placement.h"
+#include <math.h>
+#include <string.h>
+
+static_assert(MAX_TOUCH_POINTS <= 7, "Fingerzahl muss in 3 Bit passen");
+
+static constexpr uint8_t MAGIC[3] = {'T', 'R', 'C'};
+
+void HOT_FN touchRawToContact(const RawCSTPoint& r, TouchContact& c){
+  // Normalisierung mit korrigierter Raw-Range
+  float nx = (float)(r.x - TOUCH_RAW_X_MIN) / (float)(TOUCH_RAW_X_MAX - TOUCH_RAW_X_MIN);
+  float ny = (float)(r.y - TOUCH_RAW_Y_MIN) / (float)(TOUCH_RAW_Y_MAX - TOUCH_RAW_Y_MIN);
+  nx = nx < 0.f ? 0.f : (nx > 1.f ? 1.f : nx);
+  ny = ny < 0.f ? 0.f : (ny > 1.f ? 1.f : ny);
+
+  // Achsentausch & Invertierung
+  float ax = TOUCH_SWAP_XY ? ny : nx;
+  float ay = TOUCH_SWAP_XY ? nx : ny;
+  if (TOUCH_INVERT_X) ax = 1.f - ax;
+  if (TOUCH_INVERT_Y) ay = 1.f - ay;
+
+  // Skalierung auf Display
+  c.x = (uint16_t)lroundf(ax * (DISPLAY_WIDTH - 1));
+  c.y = (uint16_t)lroundf(ay * (DISPLAY_HEIGHT - 1));
+  c.strength = r.strength;
+}
+
+// ---------------------------- Varint ----------------------------------------
+size_t HOT_FN trec::putVarint(uint8_t* p, uint64_t v){
+  size_t n = 0;
+  while (v >= 0x80) { p[n++] = (uint8_t)(v | 0x80); v >>= 7; }
+  p[n++] = (uint8_t)v;
+  return n;
+}
+
+bool trec::getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v){
+  v = 0;
+  for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+    const uint8_t b = *p++;
+    v |= (uint64_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+// ---------------------------- Aufnahme --------------------------------------
+bool TouchRecorder::start(uint64_t nowUs){
+  if (!_buf || _cap < trec::HEADER_MAX) return false;
+  _on = false;
+  memcpy(_buf, MAGIC, sizeof(MAGIC));
+  _buf[3] = trec::VERSION;
+  _len = 4 + trec::putVarint(_buf + 4, nowUs);
+  _startUs = _lastUs = nowUs;
+  _lastN = 0;
+  memset(_prev, 0, sizeof(_prev));
+  _frames = _seen = 0;
+  _full = false;
+  _on = true;
+  return true;
+}
+
+bool HOT_FN TouchRecorder::append(uint64_t us, const RawCSTPoint* p, uint8_t n){
+  if (!_on) return false;
+  if (n > MAX_TOUCH_POINTS) n = MAX_TOUCH_POINTS;
+  _seen++;
+  if (n == 0 && _lastN == 0) return true;        // Ruhe: nichts Neues
+  if (_len + trec::FRAME_MAX > _cap) { _full = true; _on = false; return false; }
+
+  bool same = n > 0 && n == _lastN;
+  for (uint8_t i = 0; same && i < n; i++) {
+    same = p[i].x == _prev[i].x && p[i].y == _prev[i].y && p[i].strength == _prev[i].strength;
+  }
+  const uint64_t dt = us > _lastUs ? us - _lastUs : 0;
+
+  uint8_t* w = _buf + _len;
+  w += trec::putVarint(w, dt << 4 | (uint64_t)same << 3 | n);
+  if (!same) {
+    for (uint8_t i = 0; i < n; i++) {
+      w += trec::putVarint(w, trec::zigzag((int32_t)p[i].x - _prev[i].x));
+      w += trec::putVarint(w, trec::zigzag((int32_t)p[i].y - _prev[i].y));
+      w += trec::putVarint(w, trec::zigzag((int32_t)p[i].strength - _prev[i].strength));
+      _prev[i] = p[i];
+    }
+  }
+  _lastUs = us;
+  _lastN  = n;
+  _frames++;
+  _len = (size_t)(w - _buf);                     // Frame erst jetzt sichtbar
+  return true;
+}
+
+// ---------------------------- Lesen -----------------------------------------
+bool TouchReader::begin(const uint8_t* data, size_t len){
+  _data = _p = data;
+  _end = data + len;
+  _err = true;
+  _lastN = 0;
+  memset(_prev, 0, sizeof(_prev));
+  if (!data || len < 5 || memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || data[3] != trec::VERSION) return false;
+  _p += 4;
+  if (!trec::getVarint(_p, _end, _startUs)) return false;
+  _us = _startUs;
+  _err = false;
+  return true;
+}
+
+bool TouchReader::next(TouchRecFrame& f){
+  if (_err || _p >= _end) return false;
+  uint64_t h;
+  if (!trec::getVarint(_p, _end, h)) { _err = true; return false; }
+  const uint8_t n    = (uint8_t)(h & 7);
+  const bool    same = (h >> 3) & 1;
+  if (n > MAX_TOUCH_POINTS || (same && (n == 0 || n != _lastN))) { _err = true; return false; }
+  _us += h >> 4;
+  f.us = _us;
+  f.n  = n;
+  if (!same) {
+    for (uint8_t i = 0; i < n; i++) {
+      uint64_t dx, dy, ds;
+      if (!trec::getVarint(_p, _end, dx) || !trec::getVarint(_p, _end, dy) ||
+          !trec::getVarint(_p, _end, ds)) { _err = true; return false; }
+      _prev[i].x        = (uint16_t)(_prev[i].x + trec::unzigzag((uint32_t)dx));
+      _prev[i].y        = (uint16_t)(_prev[i].y + trec::unzigzag((uint32_t)dy));
+      _prev[i].strength = (uint16_t)(_prev[i].strength + trec::unzigzag((uint32_t)ds));
+    }
+  }
+  memcpy(f.p, _prev, sizeof(RawCSTPoint) * n);
+  _lastN = n;
+  return true;
+}
+
+// ---------------------------- Wiedergabe ------------------------------------
+bool TouchReplay::begin(const uint8_t* data, size_t len, const GestureParams& p,
+                        EventFn fn, void* ctx, uint32_t tickUs){
+  _done = true;
+  TouchReader scan;
+  if (!scan.begin(data, len)) return false;
+  TouchRecFrame f;
+  uint64_t last = scan.startUs();
+  _totalFrames = 0;
+  while (scan.next(f)) { last = f.us; _totalFrames++; }
+  if (scan.error()) return false;
+  _lengthUs = last - scan.startUs();
+
+  _reader.begin(data, len);
+  _tracker.reset();
+  _engine.reset();
+  _engine.setParams(p);
+  _fn = fn;
+  _ctx = ctx;
+  _tickUs = tickUs ? tickUs : 1;
+  _nowUs = _reader.startUs();
+  _nextTickUs = _nowUs + _tickUs;
+  _haveNext = _reader.next(_next);
+  _frames = _calls = _events = 0;
+  _hash = 2166136261u;
+  _done = false;
+  return true;
+}
+
+bool TouchReplay::advance(uint64_t relUs, uint32_t maxCalls){
+  const uint64_t start = _reader.startUs();
+  const uint64_t limit = relUs > UINT64_MAX - start ? UINT64_MAX : start + relUs;
+  const uint64_t tailEnd = start + _lengthUs + (uint64_t)TOUCH_REPLAY_TAIL_MS * 1000u;
+  uint32_t calls = 0;
+  while (!_done) {
+    // Ruhe: keine Ticks bis zum nächsten Frame (Engine-Aufruf wäre wirkungslos)
+    const bool idle = _tracker.activeCount() == 0 && _engine.idle();
+    const uint64_t tFrame = _haveNext ? _next.us : UINT64_MAX;
+    const uint64_t tTick  = (idle || _nextTickUs > tailEnd) ? UINT64_MAX : _nextTickUs;
+    if (tFrame == UINT64_MAX && tTick == UINT64_MAX) { _done = true; break; }
+    const uint64_t t = tFrame < tTick ? tFrame : tTick;
+    if (t > limit || (maxCalls && calls >= maxCalls)) break;
+    step(t, tFrame <= t);
+    calls++;
+  }
+  return !_done;
+}
+
+void TouchReplay::step(uint64_t t, bool frame){
+  const uint64_t start = _reader.startUs();
+  const uint32_t ms = (uint32_t)(t / 1000u);     // wie millis() am Gerät
+  _nowUs = t;
+  if (frame) {
+    TouchContact c[MAX_TOUCH_POINTS];
+    for (uint8_t i = 0; i < _next.n; i++) touchRawToContact(_next.p[i], c[i]);
+    _tracker.update(c, _next.n, ms);
+    _frames++;
+    _haveNext = _reader.next(_next);
+  }
+
+  const GestureEvent ev = _engine.process(_tracker.points(), _tracker.activeCount(), ms);
+  _calls++;
+  if (ev.type != GestureType::None) {
+    // Prüfsumme ohne Float-Bits (libm darf sich im letzten Bit unterscheiden)
+    const int32_t v = (int32_t)lroundf(ev.value * 1000.f);
+    const uint32_t words[5] = {(uint32_t)ev.type | (uint32_t)ev.finger_count << 8,
+                               ev.timestamp, ev.x, ev.y, (uint32_t)v};
+    for (uint32_t w : words) {
+      for (int b = 0; b < 4; b++) { _hash ^= (uint8_t)(w >> (8 * b)); _hash *= 16777619u; }
+    }
+    _events++;
+    if (_fn) _fn(_ctx, ev);
+  }
+  _nextTickUs = start + ((t - start) / _tickUs + 1) * _tickUs;
+}
@@ -0,0 +1,155 @@
+// ============================================================================
+// File: src/touch/TouchSession.h
+// ----------------------------------------------------------------------------
+// Purpose: Touch-Sitzungen aufnehmen und deterministisch wieder abspielen
+//  • TouchRecorder: dekodierte Rohframes des CST328 (12-Bit-Koordinaten,
+//    Druck) mit µs-Zeitstempel, Delta + Varint kodiert. Leere Frames nach
+//    einem leeren Frame entfallen (ändern am Tracker nichts)
+//  • TouchReader: Frames wieder auspacken
+//  • TouchReplay: Rohframes -> touchRawToContact -> TouchTracker ->
+//    GestureEngine in Aufnahmezeit. Engine-Aufruf bei jedem Frame und im
+//    Raster INPUT_TOUCH_POLL_US; Ruhephasen (kein Finger, Engine leer) werden
+//    übersprungen. Ergebnis unabhängig von Tempo und Plattform (Prüfsumme)
+//  • Plattformneutral (Host: tools/touchrec_tool.cpp)
+//
+// Format (Varint = LEB128, zz = ZigZag):
+//   Kopf:  'T' 'R' 'C' <Version>  varint(startUs)
+//   Frame: varint(dtUs << 4 | same << 3 | n)       n = 0..MAX_TOUCH_POINTS
+//          same = 0: je Finger zz(dx) zz(dy) zz(ds) gegen denselben Index
+//                    im letzten Frame mit Punkten
+//          same = 1: Punkte unverändert wie im Vorframe (nur n > 0)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "../config/params.h"
+#include "../core/types.h"
+#include "../gestures/GestureEngine.h"
+#include "TouchTracker.h"
+
+struct RawCSTPoint { uint16_t x, y, strength; };
+
+// Rohkoordinaten -> Display (TOUCH_RAW_*, TOUCH_SWAP_XY, TOUCH_INVERT_*)
+void touchRawToContact(const RawCSTPoint& r, TouchContact& c);
+
+namespace trec {
+static constexpr uint8_t VERSION     = 1;
+static constexpr size_t  HEADER_MAX  = 4 + 10;    // Magic/Version + varint(startUs)
+static constexpr size_t  FRAME_MAX   = 10 + MAX_TOUCH_POINTS * 3 * 3;
+
+size_t putVarint(uint8_t* p, uint64_t v);
+bool   getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v);
+inline uint32_t zigzag(int32_t v){ return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+inline int32_t  unzigzag(uint32_t v){ return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+}  // namespace trec
+
+struct TouchRecFrame {
+  uint64_t    us = 0;                    // Aufnahmezeit (esp_timer)
+  uint8_t     n = 0;
+  RawCSTPoint p[MAX_TOUCH_POINTS]{};
+};
+
+class TouchRecorder {
+public:
+  void begin(uint8_t* buf, size_t cap){ _buf = buf; _cap = cap; _len = 0; _on = false; }
+
+  bool start(uint64_t nowUs);            // Puffer leeren, Kopf schreiben
+  void stop(){ _on = false; }
+  bool recording() const { return _on; }
+
+  // Ein dekodierter Frame; false = Puffer voll (Aufnahme endet)
+  bool append(uint64_t us, const RawCSTPoint* p, uint8_t n);
+
+  // Aufnahme von außen (Datei) in den Puffer übernehmen
+  uint8_t* buffer(){ return _on ? nullptr : _buf; }
+  size_t   capacity() const { return _cap; }
+  void     setLength(size_t len){ if (!_on && len <= _cap) _len = len; }
+
+  const uint8_t* data() const { return _buf; }
+  size_t   size() const { return _len; }
+  bool     full() const { return _full; }
+  uint32_t frames() const { return _frames; }     // geschrieben
+  uint32_t seen() const { return _seen; }         // inkl. ausgelassener Leerframes
+  uint64_t durationUs() const { return _lastUs - _startUs; }
+
+private:
+  uint8_t*    _buf = nullptr;
+  size_t      _cap = 0;
+  volatile size_t _len = 0;              // erst nach vollständigem Frame erhöht
+  volatile bool   _on = false;
+  bool        _full = false;
+  uint64_t    _startUs = 0;
+  uint64_t    _lastUs = 0;
+  uint8_t     _lastN = 0;
+  RawCSTPoint _prev[MAX_TOUCH_POINTS]{};
+  uint32_t    _frames = 0;
+  uint32_t    _seen = 0;
+};
+
+class TouchReader {
+public:
+  bool begin(const uint8_t* data, size_t len);     // Kopf prüfen
+  bool next(TouchRecFrame& f);                     // false: Ende oder Fehler
+  bool error() const { return _err; }
+  uint64_t startUs() const { return _startUs; }
+  size_t   offset() const { return (size_t)(_p - _data); }
+
+private:
+  const uint8_t* _data = nullptr;
+  const uint8_t* _p = nullptr;
+  const uint8_t* _end = nullptr;
+  bool        _err = false;
+  uint64_t    _startUs = 0;
+  uint64_t    _us = 0;
+  uint8_t     _lastN = 0;
+  RawCSTPoint _prev[MAX_TOUCH_POINTS]{};
+};
+
+class TouchReplay {
+public:
+  using EventFn = void (*)(void* ctx, const GestureEvent& e);
+
+  // Aufnahme einmal prüfen (Frames, Länge), Tracker/Engine zurücksetzen
+  bool begin(const uint8_t* data, size_t len, const GestureParams& p,
+             EventFn fn, void* ctx, uint32_t tickUs = INPUT_TOUCH_POLL_US);
+
+  // Bis relUs nach Aufnahmebeginn abspielen, höchstens maxCalls
+  // Engine-Aufrufe (0 = unbegrenzt). false, sobald alles abgespielt ist.
+  bool advance(uint64_t relUs, uint32_t maxCalls = 0);
+
+  bool done() const { return _done; }
+  uint64_t positionUs() const { return _nowUs - _reader.startUs(); }
+  uint64_t lengthUs() const { return _lengthUs; }
+  uint32_t totalFrames() const { return _totalFrames; }
+
+  const TouchPoint* points() const { return _tracker.points(); }
+  uint8_t activeCount() const { return _tracker.activeCount(); }
+
+  uint32_t frames() const { return _frames; }
+  uint32_t calls() const { return _calls; }
+  uint32_t events() const { return _events; }
+  uint32_t hash() const { return _hash; }          // FNV-1a über alle Gesten
+
+private:
+  void step(uint64_t t, bool frame);
+
+  TouchReader   _reader;
+  TouchTracker  _tracker;
+  GestureEngine _engine;
+  EventFn       _fn = nullptr;
+  void*         _ctx = nullptr;
+  uint32_t      _tickUs = 0;
+
+  TouchRecFrame _next;
+  bool          _haveNext = false;
+  bool          _done = true;
+  uint64_t      _nowUs = 0;
+  uint64_t      _nextTickUs = 0;
+  uint64_t      _lengthUs = 0;
+  uint32_t      _totalFrames = 0;
+
+  uint32_t      _frames = 0;
+  uint32_t      _calls = 0;
+  uint32_t      _events = 0;
+  uint32_t      _hash = 0;
+};
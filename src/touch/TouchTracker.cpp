@@ -0,0 +1,79 @@
+// ============================================================================
+// File: src/touch/TouchTracker.cpp
+// ----------------------------------------------------------------------------
+#include "TouchTracker.h"
+#include "../core/Placement.h"
+
+void TouchTracker::reset(){
+  for (auto& p : _pts) p = TouchPoint{};
+  _active = 0;
+}
+
+void HOT_FN TouchTracker::update(const TouchContact* c, uint8_t n, uint32_t nowMs){
+  if (n > MAX_TOUCH_POINTS) n = MAX_TOUCH_POINTS;
+  int8_t slotOf[MAX_TOUCH_POINTS];
+  bool   taken[MAX_TOUCH_POINTS] = {false};
+  for (auto& s : slotOf) s = -1;
+
+  if (n == 1 && _active == 1) {
+    // Ein Finger bleibt ein Finger, egal wie weit er gesprungen ist
+    for (uint8_t s = 0; s < MAX_TOUCH_POINTS; s++) {
+      if (_pts[s].active) { slotOf[0] = (int8_t)s; taken[s] = true; }
+    }
+  } else {
+    // Gierig: jeweils das nächstgelegene Paar (Kontakt, aktiver Slot)
+    const int32_t tol2 = (int32_t)(PROXIMITY_TOLER_PX * PROXIMITY_TOLER_PX);
+    for (uint8_t k = 0; k < n; k++) {
+      int32_t best = tol2 + 1;
+      int bi = -1, bs = -1;
+      for (uint8_t i = 0; i < n; i++) {
+        if (slotOf[i] >= 0) continue;
+        for (uint8_t s = 0; s < MAX_TOUCH_POINTS; s++) {
+          if (!_pts[s].active || taken[s]) continue;
+          const int32_t dx = (int32_t)c[i].x - _pts[s].x, dy = (int32_t)c[i].y - _pts[s].y;
+          const int32_t d2 = dx * dx + dy * dy;
+          if (d2 < best) { best = d2; bi = i; bs = s; }
+        }
+      }
+      if (bi < 0) break;
+      slotOf[bi] = (int8_t)bs;
+      taken[bs] = true;
+    }
+  }
+
+  // Verschwundene Finger loslassen
+  for (uint8_t s = 0; s < MAX_TOUCH_POINTS; s++) {
+    TouchPoint& p = _pts[s];
+    if (!p.active || taken[s]) continue;
+    p.active = false;
+    p.touch_end = nowMs;
+    p.was_active_last_frame = true;
+  }
+
+  // Bekannte Finger nachführen, neue in freie Slots
+  _active = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    int s = slotOf[i];
+    if (s < 0) {
+      for (uint8_t f = 0; f < MAX_TOUCH_POINTS && s < 0; f++) {
+        if (!_pts[f].active && !taken[f]) s = f;
+      }
+      if (s < 0) continue;
+      TouchPoint& p = _pts[s];
+      p = TouchPoint{};
+      p.active = true;
+      p.touch_start = nowMs;
+      p.start_x = c[i].x;
+      p.start_y = c[i].y;
+      taken[s] = true;
+    } else {
+      _pts[s].was_active_last_frame = true;
+    }
+    TouchPoint& p = _pts[s];
+    p.x = c[i].x;
+    p.y = c[i].y;
+    p.strength = c[i].strength;
+    p.touch_end = nowMs;
+    _active++;
+  }
+}
@@ -0,0 +1,32 @@
+// ============================================================================
+// File: src/touch/TouchTracker.h
+// ----------------------------------------------------------------------------
+// Purpose: Kontakte eines Touch-Frames -> TouchPoint-Slots für GestureEngine
+//  • Zuordnung zum Vorframe über den nächsten Punkt (PROXIMITY_TOLER_PX);
+//    bei genau einem Finger vorher und nachher immer derselbe Slot
+//  • Neuer Kontakt: freier Slot, touch_start/start_x/start_y gesetzt;
+//    verschwundener Kontakt: active=false, touch_end, was_active_last_frame
+//    bleibt bis zum nächsten Kontakt im Slot stehen (Loslass-Auswertung)
+//  • Plattformneutral, Zeit als Parameter (Host: tools/gesture_tune)
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include "../config/params.h"
+#include "../core/types.h"
+
+struct TouchContact { uint16_t x, y, strength; };   // Display-Koordinaten
+
+class TouchTracker {
+public:
+  void reset();
+
+  // Ein dekodierter Frame; n = 0: alle Finger losgelassen
+  void update(const TouchContact* c, uint8_t n, uint32_t nowMs);
+
+  const TouchPoint* points() const { return _pts; }
+  uint8_t activeCount() const { return _active; }
+
+private:
+  TouchPoint _pts[MAX_TOUCH_POINTS];
+  uint8_t    _active = 0;
+};
@@ -0,0 +1,213 @@
+// ============================================================================
+// File: tools/adpcm_tool.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Tool für die IMA-ADPCM-Clips (src/audio/ImaAdpcm.cpp)
+//  encode <in.wav> <out.ima> [rate] [blockBytes]  WAV (16 bit) -> .ima
+//  decode <in.ima> <out.wav>                      .ima -> WAV (Kontrolle)
+//  bench  [in.ima]                                Decode-Durchsatz + Größen
+// Fertige Clips nach data/sfx/<geste>.ima legen und per LittleFS-Upload
+// ins Flash bringen (Namen siehe CLIP_NAMES in AudioI2S.cpp).
+// Build: g++ -O2 -std=c++17 tools/adpcm_tool.cpp src/audio/ImaAdpcm.cpp -o adpcm_tool
+// ============================================================================
+#include "../src/audio/ImaAdpcm.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static bool readFile(const char* path, std::vector<uint8_t>& out){
+  FILE* f = fopen(path, "rb");
+  if (!f) { perror(path); return false; }
+  uint8_t tmp[4096];
+  size_t n;
+  while ((n = fread(tmp, 1, sizeof(tmp), f)) > 0) out.insert(out.end(), tmp, tmp + n);
+  fclose(f);
+  return true;
+}
+
+static bool writeFile(const char* path, const std::vector<uint8_t>& data){
+  FILE* f = fopen(path, "wb");
+  if (!f) { perror(path); return false; }
+  bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+  fclose(f);
+  return ok;
+}
+
+static uint32_t le32(const uint8_t* p){ return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static uint16_t le16(const uint8_t* p){ return (uint16_t)(p[0] | (p[1] << 8)); }
+
+// Minimaler RIFF-Parser: PCM 16 bit, Mono oder Stereo (wird gemischt)
+static bool parseWav(const std::vector<uint8_t>& w, std::vector<int16_t>& pcm, uint32_t& rate){
+  if (w.size() < 12 || memcmp(w.data(), "RIFF", 4) || memcmp(w.data() + 8, "WAVE", 4)) return false;
+  uint16_t channels = 0, bits = 0, fmt = 0;
+  size_t pos = 12;
+  while (pos + 8 <= w.size()) {
+    const uint8_t* ck = w.data() + pos;
+    uint32_t len = le32(ck + 4);
+    if (pos + 8 + len > w.size()) len = (uint32_t)(w.size() - pos - 8);
+    if (!memcmp(ck, "fmt ", 4) && len >= 16) {
+      fmt = le16(ck + 8); channels = le16(ck + 10); rate = le32(ck + 12); bits = le16(ck + 22);
+    } else if (!memcmp(ck, "data", 4)) {
+      if (fmt != 1 || bits != 16 || channels == 0) return false;
+      size_t frames = len / (2 * channels);
+      pcm.resize(frames);
+      for (size_t i = 0; i < frames; i++) {
+        int32_t acc = 0;
+        for (uint16_t c = 0; c < channels; c++) acc += (int16_t)le16(ck + 8 + (i * channels + c) * 2);
+        pcm[i] = (int16_t)(acc / channels);
+      }
+      return true;
+    }
+    pos += 8 + len + (len & 1);
+  }
+  return false;
+}
+
+static std::vector<uint8_t> makeWav(const std::vector<int16_t>& pcm, uint32_t rate){
+  std::vector<uint8_t> w(44 + pcm.size() * 2);
+  auto put32 = [&](size_t o, uint32_t v){ for (int i = 0; i < 4; i++) w[o + i] = (uint8_t)(v >> (8 * i)); };
+  auto put16 = [&](size_t o, uint16_t v){ w[o] = (uint8_t)v; w[o + 1] = (uint8_t)(v >> 8); };
+  memcpy(&w[0], "RIFF", 4); put32(4, (uint32_t)(36 + pcm.size() * 2)); memcpy(&w[8], "WAVE", 4);
+  memcpy(&w[12], "fmt ", 4); put32(16, 16); put16(20, 1); put16(22, 1);
+  put32(24, rate); put32(28, rate * 2); put16(32, 2); put16(34, 16);
+  memcpy(&w[36], "data", 4); put32(40, (uint32_t)(pcm.size() * 2));
+  for (size_t i = 0; i < pcm.size(); i++) put16(44 + i * 2, (uint16_t)pcm[i]);
+  return w;
+}
+
+// Lineares Resampling – für kurze UI-Sounds ausreichend
+static std::vector<int16_t> resample(const std::vector<int16_t>& in, uint32_t from, uint32_t to){
+  if (from == to || in.empty()) return in;
+  size_t n = (size_t)((double)in.size() * to / from);
+  std::vector<int16_t> out(n);
+  for (size_t i = 0; i < n; i++) {
+    double src = (double)i * from / to;
+    size_t a = (size_t)src;
+    size_t b = a + 1 < in.size() ? a + 1 : a;
+    double f = src - a;
+    out[i] = (int16_t)lrint(in[a] * (1.0 - f) + in[b] * f);
+  }
+  return out;
+}
+
+static std::vector<uint8_t> encode(const std::vector<int16_t>& pcm, uint32_t rate, uint16_t blockBytes){
+  ImaHeader h;
+  h.sampleRate = rate;
+  h.numSamples = (uint32_t)pcm.size();
+  h.blockBytes = blockBytes;
+  h.samplesPerBlock = ima::samplesPerBlock(blockBytes);
+
+  size_t blocks = (pcm.size() + h.samplesPerBlock - 1) / h.samplesPerBlock;
+  std::vector<uint8_t> out(IMA_HEADER_BYTES + blocks * blockBytes);
+  ima::writeHeader(h, out.data());
+  ImaState st;
+  for (size_t b = 0; b < blocks; b++) {
+    size_t first = b * h.samplesPerBlock;
+    size_t n = std::min<size_t>(h.samplesPerBlock, pcm.size() - first);
+    ima::encodeBlock(pcm.data() + first, n, st, out.data() + IMA_HEADER_BYTES + b * blockBytes, blockBytes);
+  }
+  return out;
+}
+
+static bool decode(const std::vector<uint8_t>& ima, ImaHeader& h, std::vector<int16_t>& pcm){
+  if (ima.size() < IMA_HEADER_BYTES || !ima::parseHeader(ima.data(), h)) return false;
+  pcm.assign(h.numSamples, 0);
+  size_t done = 0;
+  for (size_t off = IMA_HEADER_BYTES; off + h.blockBytes <= ima.size() && done < h.numSamples; off += h.blockBytes) {
+    done += ima::decodeBlock(ima.data() + off, h.blockBytes, pcm.data() + done, h.numSamples - done);
+  }
+  return true;
+}
+
+static void report(const ImaHeader& h, size_t imaBytes, const std::vector<int16_t>* ref, const std::vector<int16_t>& dec){
+  size_t pcmBytes = (size_t)h.numSamples * 2;
+  printf("samples   : %u @ %u Hz (%.3f s), block %u B / %u samples\n",
+         h.numSamples, h.sampleRate, (double)h.numSamples / h.sampleRate, h.blockBytes, h.samplesPerBlock);
+  printf("flash     : %zu B ADPCM vs %zu B PCM16 (%.2fx kleiner)\n",
+         imaBytes, pcmBytes, imaBytes ? (double)pcmBytes / imaBytes : 0.0);
+  if (ref && ref->size() == dec.size() && !dec.empty()) {
+    double sig = 0, err = 0;
+    for (size_t i = 0; i < dec.size(); i++) {
+      double d = (double)(*ref)[i] - dec[i];
+      sig += (double)(*ref)[i] * (*ref)[i];
+      err += d * d;
+    }
+    printf("quality   : SNR %.1f dB\n", err > 0 ? 10.0 * log10(sig / err) : 99.0);
+  }
+}
+
+static void bench(const std::vector<uint8_t>& ima){
+  ImaHeader h;
+  std::vector<int16_t> pcm;
+  if (!decode(ima, h, pcm)) { fprintf(stderr, "kein gültiger .ima\n"); return; }
+  report(h, ima.size(), nullptr, pcm);
+
+  // Wie im Audio-Task: Sample für Sample aus dem Blockpuffer
+  const int rounds = std::max(1, (int)(50000000 / std::max<uint32_t>(h.numSamples, 1)));
+  volatile int32_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (size_t off = IMA_HEADER_BYTES; off + h.blockBytes <= ima.size(); off += h.blockBytes) {
+      const uint8_t* blk = ima.data() + off;
+      ImaState st;
+      int32_t acc = ima::beginBlock(blk, st);
+      for (size_t i = IMA_BLOCK_HEADER; i < h.blockBytes; i++) {
+        acc += ima::decodeNibble(blk[i] & 0x0F, st);
+        acc += ima::decodeNibble(blk[i] >> 4, st);
+      }
+      sink = sink + acc;
+    }
+  }
+  double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  double sps = (double)rounds * (ima.size() - IMA_HEADER_BYTES) / h.blockBytes * h.samplesPerBlock / sec;
+  printf("decode    : %.1f Msamples/s (%.0fx Echtzeit @ %u Hz)\n", sps / 1e6, sps / h.sampleRate, h.sampleRate);
+}
+
+int main(int argc, char** argv){
+  if (argc >= 4 && !strcmp(argv[1], "encode")) {
+    std::vector<uint8_t> wav; std::vector<int16_t> pcm; uint32_t rate = 0;
+    if (!readFile(argv[2], wav) || !parseWav(wav, pcm, rate)) { fprintf(stderr, "WAV (PCM16) erwartet\n"); return 1; }
+    uint32_t target = argc > 4 ? (uint32_t)atoi(argv[4]) : 22050;
+    uint16_t block  = argc > 5 ? (uint16_t)atoi(argv[5]) : 256;
+    pcm = resample(pcm, rate, target);
+    std::vector<uint8_t> ima = encode(pcm, target, block);
+    if (!writeFile(argv[3], ima)) return 1;
+    ImaHeader h; std::vector<int16_t> dec;
+    decode(ima, h, dec);
+    report(h, ima.size(), &pcm, dec);
+    return 0;
+  }
+  if (argc >= 4 && !strcmp(argv[1], "decode")) {
+    std::vector<uint8_t> ima; ImaHeader h; std::vector<int16_t> pcm;
+    if (!readFile(argv[2], ima) || !decode(ima, h, pcm)) { fprintf(stderr, "kein gültiger .ima\n"); return 1; }
+    return writeFile(argv[3], makeWav(pcm, h.sampleRate)) ? 0 : 1;
+  }
+  if (argc >= 2 && !strcmp(argv[1], "bench")) {
+    std::vector<uint8_t> ima;
+    if (argc >= 3) {
+      if (!readFile(argv[2], ima)) return 1;
+    } else {
+      // Ohne Datei: 1 s Testsignal (Sweep 300..3000 Hz) erzeugen
+      std::vector<int16_t> pcm(22050);
+      double ph = 0;
+      for (size_t i = 0; i < pcm.size(); i++) {
+        double hz = 300.0 + 2700.0 * i / pcm.size();
+        ph += 2 * M_PI * hz / 22050.0;
+        pcm[i] = (int16_t)(12000 * sin(ph));
+      }
+      ima = encode(pcm, 22050, 256);
+      ImaHeader h; std::vector<int16_t> dec;
+      decode(ima, h, dec);
+      report(h, ima.size(), &pcm, dec);
+    }
+    bench(ima);
+    return 0;
+  }
+  fprintf(stderr, "usage: %s encode <in.wav> <out.ima> [rate=22050] [blockBytes=256]\n"
+                  "       %s decode <in.ima> <out.wav>\n"
+                  "       %s bench  [in.ima]\n", argv[0], argv[0], argv[0]);
+  return 2;
+}
@@ -0,0 +1,157 @@
+// ============================================================================
+// File: tools/boot_test.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Test des Boot-Sequenzers (src/core/BootSequencer.cpp)
+//  • Virtuelle Zeit; Schritte wie in App::begin(): Touch (Reset 50 ms +
+//    Anlauf 100 ms), IMU (10 + 5 ms), Display (150 ms im eigenen Task,
+//    abgefragt), Scans nach Touch bzw. IMU
+//  • Prüft:
+//     1) alle Schritte fertig, Abhängigkeiten eingehalten
+//     2) Wartezeiten verschränkt: Dauer = längste Kette statt Summe
+//     3) blockierender Schritt verschiebt wartende (Vergleich)
+//     4) Fehler zählt als fertig, Nachfolger laufen, run() meldet false
+//     5) add() lehnt Vorwärts-Abhängigkeiten und Überlauf ab
+//     6) Pollen länger als 255 Runden (2-ms-Takt > 512 ms): phase sättigt,
+//        die Arbeit startet genau einmal
+// Usage: boot_test
+// Build: g++ -O2 -std=c++17 tools/boot_test.cpp src/core/BootSequencer.cpp -o boot_test
+// ============================================================================
+#include "../src/core/BootSequencer.h"
+#include <cstdio>
+
+static uint32_t g_now = 0;
+static uint32_t simClock(){ return g_now; }
+static void     simSleep(uint32_t us){ g_now += us; }
+
+static int g_failed = 0;
+static void check(bool ok, const char* what){
+  printf("  [%s] %s\n", ok ? " ok " : "FAIL", what);
+  if (!ok) g_failed++;
+}
+
+// Schritt: "work" µs aktiv je Phase, danach "waits" (0-terminiert) warten
+struct Model {
+  uint32_t work;
+  uint32_t waits[3];
+  bool     fail;
+};
+
+static BootResult step(void* ctx, uint8_t phase){
+  const Model& m = *static_cast<Model*>(ctx);
+  g_now += m.work;
+  if (phase < 3 && m.waits[phase]) return BootResult::waitUsFor(m.waits[phase]);
+  return BootResult::of(!m.fail);
+}
+
+// Arbeit in einem anderen Task (Display-Init auf Core 0): erster Aufruf
+// startet (Zustand wie App::_dispBoot), danach alle 2 ms nachsehen
+struct Parallel { uint32_t us; uint32_t doneAt; uint32_t starts; };
+
+static BootResult parallel(void* ctx, uint8_t){
+  Parallel& p = *static_cast<Parallel*>(ctx);
+  if (!p.starts++) p.doneAt = g_now + p.us;
+  if ((int32_t)(g_now - p.doneAt) < 0) return BootResult::waitMs(2);
+  return BootResult::done();
+}
+
+// Alter Display-Schritt: startet bei phase == 0 (lief mit uint8_t-Überlauf
+// nach 256 Runden ein zweites Mal an); zählt Starts, Ende bleibt beim ersten
+static BootResult phaseZero(void* ctx, uint8_t phase){
+  Parallel& p = *static_cast<Parallel*>(ctx);
+  if (phase == 0 && !p.starts++) p.doneAt = g_now + p.us;
+  if ((int32_t)(g_now - p.doneAt) < 0) return BootResult::waitMs(2);
+  return BootResult::done();
+}
+
+static void report(const BootSequencer& b){
+  printf("  %-10s %9s %9s %9s %6s\n", "step", "start/ms", "ende/ms", "aktiv/ms", "phasen");
+  for (size_t i = 0; i < b.count(); i++) {
+    const BootStepStats& s = b.stats((int)i);
+    printf("  %-10s %9.1f %9.1f %9.1f %6u%s\n", b.name((int)i), s.startUs / 1000.0, s.endUs / 1000.0,
+           s.activeUs / 1000.0, s.phases, s.ok ? "" : "  FEHLER");
+  }
+  printf("  gesamt %.1f ms, gewartet %.1f ms\n", b.totalUs() / 1000.0, b.sleptUs() / 1000.0);
+}
+
+int main(){
+  printf("Boot wie App::begin():\n");
+  Model touch  {100, {50000, 100000, 0}, false};
+  Model imu    {300, {10000, 5000, 0}, false};
+  Parallel display{150000, 0, 0};
+  Model audio  {2000, {0}, false};
+  Model scan   {200, {0}, false};
+
+  BootSequencer b;
+  g_now = 1000000;                                   // App-Start liegt nicht bei 0
+  b.begin(simClock, simSleep);
+  const int t = b.add("touch", step, &touch);
+  const int i = b.add("imu", step, &imu);
+  const int d = b.add("display", parallel, &display);
+  b.add("audio", step, &audio);
+  const int s0 = b.add("scan i2c0", step, &scan, 1u << i);
+  const int s1 = b.add("scan i2c1", step, &scan, 1u << t);
+  const bool ok = b.run();
+  report(b);
+
+  bool allOk = ok;
+  for (size_t k = 0; k < b.count(); k++) allOk &= b.stats((int)k).ok;
+  check(allOk && b.count() == 6, "alle Schritte fertig");
+  check(b.stats(s0).startUs >= b.stats(i).endUs && b.stats(s1).startUs >= b.stats(t).endUs,
+        "Scans erst nach ihren Treibern");
+  check(b.stats(t).phases == 3 && b.stats(i).phases == 3, "Phasen je Wartezeit");
+
+  // Sequentiell: Summe aller aktiven Zeiten und Wartezeiten
+  const uint32_t serial = 3 * touch.work + 150000 + 3 * imu.work + 15000 + display.us + audio.work + 2 * scan.work;
+  printf("  sequentiell %.1f ms -> verschränkt %.1f ms\n", serial / 1000.0, b.totalUs() / 1000.0);
+  check(b.totalUs() < serial * 2 / 3, "verschränkt deutlich kürzer als sequentiell");
+  check(b.totalUs() <= 160000 && b.stats(d).endUs >= 150000, "Dauer = längste Kette (Display/Touch) + Scan");
+  check(b.sleptUs() <= b.totalUs(), "gewartete Zeit <= Gesamtdauer");
+
+  printf("\nVergleich: Display blockierend im selben Task:\n");
+  Model blocking{150000, {0}, false};
+  BootSequencer c;
+  g_now = 0;
+  c.begin(simClock, simSleep);
+  const int ct = c.add("touch", step, &touch);
+  c.add("display", step, &blocking);
+  const bool cok = c.run();
+  report(c);
+  check(cok && c.stats(ct).endUs >= 150000 + 100000,
+        "Touch-Anlauf erst nach dem blockierenden Schritt (deshalb eigener Task)");
+
+  printf("\nFehlschlag und Abhängigkeiten:\n");
+  Model bad {100, {1000, 0}, true};
+  Model after {100, {0}, false};
+  BootSequencer f;
+  g_now = 0;
+  f.begin(simClock, simSleep);
+  const int fb = f.add("bad", step, &bad);
+  const int fa = f.add("after", step, &after, 1u << fb);
+  const bool fok = f.run();
+  report(f);
+  check(!fok && !f.stats(fb).ok, "Fehler wird gemeldet");
+  check(f.stats(fa).ok && f.stats(fa).startUs >= f.stats(fb).endUs, "Nachfolger läuft trotzdem (danach)");
+
+  BootSequencer g;
+  g.begin(simClock, simSleep);
+  check(g.add("vorwärts", step, &after, 1u << 0) < 0, "Abhängigkeit auf unbekannten Schritt abgelehnt");
+  int last = 0;
+  for (size_t k = 0; k < BootSequencer::MAX_STEPS; k++) last = g.add("x", step, &after);
+  check(last == (int)BootSequencer::MAX_STEPS - 1 && g.add("zuviel", step, &after) < 0, "MAX_STEPS begrenzt");
+
+  printf("\nLanger Display-Init (1,5 s, Abfrage alle 2 ms):\n");
+  Parallel slow{1500000, 0, 0}, slowOld{1500000, 0, 0};
+  BootSequencer w;
+  g_now = 0;
+  w.begin(simClock, simSleep);
+  const int ws = w.add("display", parallel, &slow);
+  const int wo = w.add("phase==0", phaseZero, &slowOld);
+  const bool wok = w.run();
+  report(w);
+  check(wok && w.stats(ws).endUs >= 1500000, "fertig nach der Init-Dauer");
+  check(slow.starts > 255 && w.stats(ws).phases == 255, "phase sättigt bei 255 (kein Überlauf auf 0)");
+  check(slowOld.starts == 1 && w.stats(wo).ok, "phase == 0 nur im ersten Aufruf, Init genau einmal gestartet");
+
+  printf("\n%s (%d Fehler)\n", g_failed ? "FAIL" : "OK", g_failed);
+  return g_failed ? 1 : 0;
+}
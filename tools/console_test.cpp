@@ -0,0 +1,207 @@
+// ============================================================================
+// File: tools/console_test.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Test des Konsolen-Dispatchers (src/comm/CommandTable.cpp)
+//  • Namensauflösung (mehrere Wörter, längster Name, mehrere Tabellen),
+//    typisierte Argumente, Fehlerfälle, generierte Hilfe
+//  • Zählt Heap-Aufrufe (operator new / malloc) während des Dispatch –
+//    erwartet 0 je Befehl
+//  • Misst die Dispatch-Zeit je Zeile
+// Usage: console_test [iterationen=200000]
+// Build: g++ -O2 -std=c++17 tools/console_test.cpp src/comm/CommandTable.cpp -o console_test
+// ============================================================================
+#include "../src/comm/CommandTable.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// ---------------------------- Heap-Zähler -----------------------------------
+// glibc: malloc & Co. umleiten, operator new landet ebenfalls hier
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void  __libc_free(void*);
+
+static volatile size_t g_allocs = 0;
+
+extern "C" void* malloc(size_t n){ g_allocs++; return __libc_malloc(n); }
+extern "C" void* calloc(size_t a, size_t b){ g_allocs++; return __libc_calloc(a, b); }
+extern "C" void* realloc(void* p, size_t n){ g_allocs++; return __libc_realloc(p, n); }
+extern "C" void  free(void* p){ __libc_free(p); }
+void* operator new(size_t n){ g_allocs++; if (void* p = __libc_malloc(n ? n : 1)) return p; throw std::bad_alloc(); }
+void* operator new[](size_t n){ return operator new(n); }
+void operator delete(void* p) noexcept { __libc_free(p); }
+void operator delete[](void* p) noexcept { __libc_free(p); }
+void operator delete(void* p, size_t) noexcept { __libc_free(p); }
+void operator delete[](void* p, size_t) noexcept { __libc_free(p); }
+
+// ---------------------------- Testtabellen ----------------------------------
+struct Hit {
+  int      id = -1;
+  cmd::Args args;
+  char     text[64] = {0};
+};
+static Hit g_hit;
+
+template <int ID>
+static void record(void*, const cmd::Args& a){
+  g_hit.id   = ID;
+  g_hit.args = a;
+  if (ID == 6 && a.count) snprintf(g_hit.text, sizeof(g_hit.text), "%s", a.s(a.count - 1));
+}
+
+static constexpr cmd::Command APP[] = {
+  {"modbus master",   "",        "",                                   record<1>},
+  {"modbus poll add", "cchhh?c", "<id> <fn> <addr> <n> <ms> [prio]",   record<2>},
+  {"modbus poll",     "w",       "start|stop",                         record<3>},
+  {"modbus slave",    "?u",      "[id]",                               record<4>},
+  {"modbus write",    "chh",     "<id> <addr> <val>",                  record<8>},
+  {"rs485 sink",      "b",       "on|off",                             record<5>},
+  {"rs485send",       "r",       "<text>",                             record<6>},
+  {"set",             "wif",     "<name> <int> <float>",               record<7>},
+};
+static constexpr cmd::Command MOD[] = {
+  {"debug imu",   "", "", record<10>},
+  {"debug touch", "", "", record<11>},
+  {"modbus",      "", "", record<12>},   // kürzer als die App-Namen
+};
+static_assert(cmd::sorted(MOD), "MOD nicht sortiert");
+
+// "modbus poll" < "modbus poll add" nach strcmp -> Reihenfolge in APP prüfen
+static_assert(!cmd::sorted(APP), "APP absichtlich unsortiert?");
+static constexpr cmd::Command APP_SORTED[] = {
+  APP[0], APP[2], APP[1], APP[3], APP[4], APP[5], APP[6], APP[7],
+};
+static_assert(cmd::sorted(APP_SORTED), "APP_SORTED nicht sortiert");
+
+struct Case {
+  const char* line;
+  cmd::Result result;
+  int         id;
+  int         argc;
+};
+
+static const Case CASES[] = {
+  {"modbus master",                 cmd::Result::Ok,      1,  0},
+  {"  modbus   master  ",           cmd::Result::Ok,      1,  0},
+  {"modbus poll add 2 3 0 4 50",    cmd::Result::Ok,      2,  5},
+  {"modbus poll add 2 3 0x10 4 50 1", cmd::Result::Ok,    2,  6},
+  {"modbus poll add 2 3 0 4",       cmd::Result::BadArgs, -1, 0},
+  {"modbus poll add 2 3 0 4 50 1 9", cmd::Result::BadArgs, -1, 0},
+  {"modbus poll add -2 3 0 4 50",   cmd::Result::BadArgs, -1, 0},
+  {"modbus poll add 2 3 0 4 65535", cmd::Result::Ok,      2,  5},
+  {"modbus poll add 2 3 0 4 70000", cmd::Result::BadArgs, -1, 0},   // früher: 4464 ms
+  {"modbus poll add 256 3 0 4 50",  cmd::Result::BadArgs, -1, 0},
+  {"modbus poll add 2 3 0x10000 4 50", cmd::Result::BadArgs, -1, 0},
+  {"modbus poll add 2 3 0 4 50 0x100", cmd::Result::BadArgs, -1, 0},
+  {"modbus write 255 0xFFFF 65535", cmd::Result::Ok,      8,  3},
+  {"modbus write 1 2 65536",        cmd::Result::BadArgs, -1, 0},
+  {"modbus poll start",             cmd::Result::Ok,      3,  1},
+  {"modbus slave",                  cmd::Result::Ok,      4,  0},
+  {"modbus slave 7",                cmd::Result::Ok,      4,  1},
+  {"modbus slave x",                cmd::Result::BadArgs, -1, 0},
+  {"modbus slave 4294967295",       cmd::Result::Ok,      4,  1},
+  {"modbus slave 4294967296",       cmd::Result::BadArgs, -1, 0},
+  {"modbus slave 99999999999999999999", cmd::Result::BadArgs, -1, 0},   // ERANGE
+  {"modbus",                        cmd::Result::Ok,      12, 0},
+  {"modbus foo",                    cmd::Result::BadArgs, -1, 0},
+  {"rs485 sink on",                 cmd::Result::Ok,      5,  1},
+  {"rs485 sink maybe",              cmd::Result::BadArgs, -1, 0},
+  {"rs485send hallo  welt 1 2",     cmd::Result::Ok,      6,  1},
+  {"rs485send",                     cmd::Result::BadArgs, -1, 0},
+  {"set gain -12 0.25",             cmd::Result::Ok,      7,  3},
+  {"set gain 12x 0.25",             cmd::Result::BadArgs, -1, 0},
+  {"set gain -2147483648 0.25",     cmd::Result::Ok,      7,  3},
+  {"set gain 2147483648 0.25",      cmd::Result::BadArgs, -1, 0},
+  {"set gain -99999999999999999999 0.25", cmd::Result::BadArgs, -1, 0},   // ERANGE
+  {"debug touch",                   cmd::Result::Ok,      11, 0},
+  {"debug",                         cmd::Result::Unknown, -1, 0},
+  {"debugimu",                      cmd::Result::Unknown, -1, 0},
+  {"",                              cmd::Result::Empty,   -1, 0},
+  {"   \t ",                        cmd::Result::Empty,   -1, 0},
+};
+
+static int g_failed = 0;
+
+static void check(bool ok, const char* what, const char* line){
+  if (ok) return;
+  g_failed++;
+  printf("FAIL: %s  [%s]\n", what, line);
+}
+
+static void countLine(const char*, void* ctx){ (*static_cast<int*>(ctx))++; }
+
+int main(int argc, char** argv){
+  const long iters = argc > 1 ? atol(argv[1]) : 200000;
+
+  cmd::Registry reg;
+  reg.add(APP_SORTED, nullptr, "app");
+  reg.add(MOD, nullptr, "mod");
+
+  // ---- Funktion
+  char buf[160];
+  for (const Case& c : CASES) {
+    g_hit = Hit{};
+    snprintf(buf, sizeof(buf), "%s", c.line);
+    const cmd::Result r = reg.dispatch(buf);
+    check(r == c.result, "Ergebnis", c.line);
+    check(g_hit.id == c.id, "Handler", c.line);
+    if (r == cmd::Result::Ok) check(g_hit.args.count == c.argc, "Argumentanzahl", c.line);
+  }
+  snprintf(buf, sizeof(buf), "modbus poll add 2 3 0x10 4 50 1");
+  reg.dispatch(buf);
+  check(g_hit.args.u(2) == 16 && g_hit.args.u(5) == 1, "Hex/optional", "modbus poll add");
+  snprintf(buf, sizeof(buf), "modbus slave");
+  reg.dispatch(buf);
+  check(g_hit.args.u(0, 42) == 42, "Default optional", "modbus slave");
+  snprintf(buf, sizeof(buf), "modbus write 255 0xFFFF 65535");
+  reg.dispatch(buf);
+  check(g_hit.args.u(0) == 255 && g_hit.args.u(1) == 0xFFFF && g_hit.args.u(2) == 65535, "c/h Grenzwerte", "modbus write");
+  snprintf(buf, sizeof(buf), "set gain -12 0.25");
+  reg.dispatch(buf);
+  check(!strcmp(g_hit.args.s(0), "gain") && g_hit.args.i(1) == -12 && std::fabs(g_hit.args.f(2) - 0.25f) < 1e-6f,
+        "typisierte Werte", "set");
+  snprintf(buf, sizeof(buf), "rs485send hallo  welt 1 2  ");
+  reg.dispatch(buf);
+  check(!strcmp(g_hit.text, "hallo  welt 1 2"), "Rest der Zeile", "rs485send");
+  snprintf(buf, sizeof(buf), "modbus poll add 1");
+  check(reg.dispatch(buf) == cmd::Result::BadArgs && reg.matched() == &APP_SORTED[2], "matched() bei BadArgs", buf);
+
+  int helpLines = 0;
+  reg.help(countLine, &helpLines);
+  check(helpLines == 2 + 8 + 3, "Hilfe", "help");
+
+  // ---- Heap + Zeit
+  static const char* const LOAD[] = {
+    "modbus poll add 2 3 0 4 50 1", "rs485 sink off", "debug imu", "set gain -1 2.5",
+    "rs485send ping 123", "modbus slave 3", "unbekannt x", "modbus poll add 1",
+  };
+  const size_t nLoad = sizeof(LOAD) / sizeof(LOAD[0]);
+  size_t lens[nLoad];
+  for (size_t k = 0; k < nLoad; k++) lens[k] = strlen(LOAD[k]) + 1;
+
+  // Zähler selbst prüfen
+  const size_t probe = g_allocs;
+  void* volatile p = malloc(16);
+  free(p);
+  check(g_allocs == probe + 1, "Heap-Zähler aktiv", "malloc");
+
+  const size_t before = g_allocs;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (long n = 0; n < iters; n++) {
+    const size_t k = (size_t)n % nLoad;
+    memcpy(buf, LOAD[k], lens[k]);
+    reg.dispatch(buf);
+  }
+  const auto t1 = std::chrono::steady_clock::now();
+  const size_t allocs = g_allocs - before;
+  check(allocs == 0, "Heap-Aufrufe im Dispatch", "Last");
+
+  const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)iters;
+  printf("%ld Zeilen, Heap-Aufrufe: %zu, %.0f ns/Zeile\n", iters, allocs, ns);
+  printf("%s (%d Fehler)\n", g_failed ? "FAIL" : "OK", g_failed);
+  return g_failed ? 1 : 0;
+}
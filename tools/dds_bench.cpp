@@ -0,0 +1,97 @@
+// ============================================================================
+// File: tools/dds_bench.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Benchmark für den DDS-Kernel (src/audio/Dds.cpp)
+//  • Durchsatz in Samples/s: alter sinf-Scalar-Loop vs. DDS (Sinus/Rechteck/Dreieck)
+//  • Genauigkeit der interpolierten Sinustabelle gegen sinf()
+// Build: g++ -O2 -std=c++17 tools/dds_bench.cpp src/audio/Dds.cpp -o dds_bench
+// ============================================================================
+#include "../src/audio/Dds.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+static constexpr uint32_t SR    = 22050;
+static constexpr size_t   BLOCK = 256;
+static constexpr size_t   TOTAL = 20u * 1000u * 1000u;   // Samples pro Messung
+
+using Clock = std::chrono::steady_clock;
+
+static volatile int32_t g_sink;   // verhindert Wegoptimieren
+
+// Referenz: der frühere AudioI2S::toneHz()-Loop
+static double benchSinf(float hz){
+  int16_t buf[BLOCK];
+  const float twoPiOverSR = 2.0f * (float)M_PI / (float)SR;
+  const float amp = 0.2f;
+  float phase = 0.f;
+  auto t0 = Clock::now();
+  for (size_t done = 0; done < TOTAL; done += BLOCK) {
+    for (size_t j = 0; j < BLOCK; j++) {
+      float s = sinf(phase) * amp;
+      buf[j] = (int16_t)(s * 32767);
+      phase += twoPiOverSR * hz;
+      if (phase > 2 * M_PI) phase -= 2 * M_PI;
+    }
+    g_sink += buf[BLOCK - 1];
+  }
+  double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+  return TOTAL / sec;
+}
+
+static double benchDds(float hz, Waveform w){
+  int16_t buf[BLOCK];
+  DdsOsc o;
+  o.inc  = dds::phaseIncrement(hz, SR);
+  o.wave = w;
+  auto t0 = Clock::now();
+  for (size_t done = 0; done < TOTAL; done += BLOCK) {
+    dds::render(o, buf, BLOCK, (int16_t)(0.2f * 32767));
+    g_sink += buf[BLOCK - 1];
+  }
+  double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+  return TOTAL / sec;
+}
+
+// Ganze Phasenumdrehung in feinen Schritten gegen sinf (double) vergleichen
+static void accuracy(){
+  DdsOsc o;
+  o.inc = 0x00010000u;                   // 65536 Schritte pro Periode
+  double maxErr = 0, sumSq = 0;
+  const size_t N = 65536;
+  for (size_t i = 0; i < N; i++) {
+    double ref = 32767.0 * std::sin(2.0 * M_PI * (double)o.phase / 4294967296.0);
+    double err = std::fabs((double)dds::sample(o) - ref);
+    if (err > maxErr) maxErr = err;
+    sumSq += err * err;
+    o.phase += o.inc;
+  }
+  double rms = std::sqrt(sumSq / N);
+  printf("accuracy  sine table %u pts + lerp: max |err| = %.2f LSB, rms = %.3f LSB (%.1f dB SNR)\n",
+         dds::SINE_SIZE, maxErr, rms, 20.0 * std::log10(32767.0 / std::sqrt(2.0) / (rms > 0 ? rms : 1e-9)));
+
+  // Frequenzauflösung des 32-bit Akkus
+  printf("accuracy  frequency step = %.6f Hz @ %u Hz\n", (double)SR / 4294967296.0, SR);
+}
+
+int main(){
+  dds::initTables();
+  accuracy();
+
+  const float hz = 1200.f;
+  double ref = benchSinf(hz);
+  printf("throughput sinf scalar   : %8.1f Msamples/s\n", ref / 1e6);
+  const struct { const char* name; Waveform w; } modes[] = {
+    {"dds sine    ", Waveform::Sine},
+    {"dds square  ", Waveform::Square},
+    {"dds triangle", Waveform::Triangle},
+  };
+  for (auto& m : modes) {
+    double r = benchDds(hz, m.w);
+    printf("throughput %s     : %8.1f Msamples/s (x%.1f)\n", m.name, r / 1e6, r / ref);
+  }
+  printf("realtime budget @ %u Hz : sinf %.0fx, dds %.0fx\n", SR, ref / SR, benchDds(hz, Waveform::Sine) / SR);
+  return 0;
+}
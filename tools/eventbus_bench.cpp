@@ -0,0 +1,153 @@
+// ============================================================================
+// File: tools/eventbus_bench.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Benchmark des Event-Bus (src/core/EventBus.cpp)
+//  • Kosten je Ereignis (ns) über der Zahl passender Abonnenten, getrennt
+//    nach Sync (im Publisher) und Deferred (Queue + dispatchPending)
+//  • Filterkosten: Abonnenten anderer Topics dürfen nichts kosten
+//  • Nebenläufigkeit: zwei Publisher-Threads + Konsument; je Publisher
+//    lückenlose Reihenfolge, veröffentlicht = zugestellt + verworfen
+// Usage: eventbus_bench [ereignisse=2000000]
+// Build: g++ -O2 -std=c++17 -pthread tools/eventbus_bench.cpp src/core/EventBus.cpp -o eventbus_bench
+// ============================================================================
+#include "../src/core/EventBus.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <memory>
+#include <thread>
+
+// Nutzlast in Gestengröße
+struct Payload {
+  uint32_t seq;
+  uint16_t x, y;
+  float    value;
+  uint8_t  producer;
+  uint8_t  pad[11];
+};
+
+static uint32_t hostMicros(){
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static volatile uint64_t g_sink = 0;
+static void consume(const Event& e, void*){ g_sink = g_sink + e.as<Payload>().seq; }
+
+static double nsPerEvent(Delivery d, unsigned matching, unsigned other, uint32_t n){
+  std::unique_ptr<EventBus> owner(new EventBus);   // ~4 KB Ring, nicht auf den Stack
+  EventBus& bus = *owner;
+  bus.begin(hostMicros);
+  for (unsigned i = 0; i < matching; i++) bus.subscribe("m", 1u << 0, d, consume, nullptr);
+  for (unsigned i = 0; i < other; i++) bus.subscribe("o", 1u << 1, d, consume, nullptr);
+  Payload p{};
+  const auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++) {
+    p.seq = i;
+    bus.publish(0, p);
+    if (d == Delivery::Deferred && (i & 31) == 31) bus.dispatchPending();
+  }
+  bus.dispatchPending();
+  const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+  return ns / n;
+}
+
+static int g_failed = 0;
+static void check(bool ok, const char* what){
+  printf("  [%s] %s\n", ok ? " ok " : "FAIL", what);
+  if (!ok) g_failed++;
+}
+
+// Zwei Produzenten, ein Konsument
+struct Order {
+  uint32_t next[2] = {0, 0};
+  uint32_t gaps = 0, reordered = 0, received = 0;
+};
+static void checkOrder(const Event& e, void* ctx){
+  Order& o = *static_cast<Order*>(ctx);
+  const Payload& p = e.as<Payload>();
+  if (p.seq < o.next[p.producer]) o.reordered++;
+  else if (p.seq > o.next[p.producer]) o.gaps++;   // verworfene Ereignisse
+  o.next[p.producer] = p.seq + 1;
+  o.received++;
+}
+
+static void concurrency(uint32_t perProducer){
+  std::unique_ptr<EventBus> owner(new EventBus);
+  EventBus& bus = *owner;
+  bus.begin(hostMicros);
+  Order order;
+  bus.subscribe("order", 1u << 0, Delivery::Deferred, checkOrder, &order);
+  std::atomic<int> running{2};
+  std::atomic<uint32_t> ok[2] = {{0}, {0}};
+  auto producer = [&](uint8_t id){
+    Payload p{};
+    p.producer = id;
+    for (uint32_t i = 0; i < perProducer; i++) {
+      p.seq = i;
+      if (bus.publish(0, p)) ok[id]++;
+      if ((i & 7) == 7) std::this_thread::yield();
+    }
+    running--;
+  };
+  std::thread a(producer, 0), b(producer, 1);
+  while (running.load() > 0) {
+    if (!bus.dispatchPending()) std::this_thread::yield();
+  }
+  a.join();
+  b.join();
+  bus.dispatchPending();
+
+  const BusTopicStats s = bus.topicStats(0);
+  printf("Nebenläufig: 2 x %u veröffentlicht, %u zugestellt, %u verworfen, Queue max %u/%zu\n",
+         perProducer, order.received, s.dropped, bus.queueHigh(), EventBus::QUEUE_DEPTH);
+  check(order.reordered == 0, "Reihenfolge je Publisher bleibt erhalten");
+  check(order.received == ok[0] + ok[1], "jedes angenommene Ereignis genau einmal zugestellt");
+  check(s.published == order.received + s.dropped, "veröffentlicht = zugestellt + verworfen");
+  check(s.delivered == order.received, "Zustellzähler stimmt");
+  check(bus.queueHigh() <= EventBus::QUEUE_DEPTH, "Queue-Höchststand <= Tiefe");
+}
+
+// Ohne Konsument: Ring läuft voll, Überschuss wird gezählt statt überschrieben
+static void overflow(){
+  std::unique_ptr<EventBus> owner(new EventBus);
+  EventBus& bus = *owner;
+  bus.begin(hostMicros);
+  Order order;
+  bus.subscribe("order", 1u << 0, Delivery::Deferred, checkOrder, &order);
+  Payload p{};
+  for (uint32_t i = 0; i < EventBus::QUEUE_DEPTH + 10; i++) { p.seq = i; bus.publish(0, p); }
+  const BusTopicStats s = bus.topicStats(0);
+  const size_t n = bus.dispatchPending();
+  printf("Überlauf: %zu zugestellt, %u verworfen, offen max %u\n", n, s.dropped, s.pendingHigh);
+  check(n == EventBus::QUEUE_DEPTH && s.dropped == 10, "volle Queue verwirft neue Ereignisse und zählt sie");
+  check(order.gaps == 0 && order.reordered == 0, "die ältesten Ereignisse bleiben vollständig erhalten");
+  p.seq = 0;
+  check(bus.publish(0, p) && bus.dispatchPending() == 1, "nach dem Leeren wieder Platz");
+}
+
+int main(int argc, char** argv){
+  const uint32_t n = argc > 1 ? (uint32_t)atoi(argv[1]) : 2000000;
+  printf("%u Ereignisse je Messung, Nutzlast %zu B\n\n", n, sizeof(Payload));
+  printf("  Abonnenten   sync ns/Ereignis   deferred ns/Ereignis\n");
+  double sync0 = 0, sync8 = 0, syncOther = 0;
+  for (unsigned k : {0u, 1u, 2u, 4u, 8u, 12u}) {
+    const double s = nsPerEvent(Delivery::Sync, k, 0, n);
+    const double d = nsPerEvent(Delivery::Deferred, k, 0, n);
+    printf("  %10u   %16.1f   %20.1f\n", k, s, d);
+    if (k == 0) sync0 = s;
+    if (k == 8) sync8 = s;
+  }
+  syncOther = nsPerEvent(Delivery::Sync, 0, 8, n);
+  printf("  8 Abonnenten anderer Topics (sync): %.1f ns/Ereignis\n\n", syncOther);
+  check(syncOther < sync0 * 1.5 + 5, "nicht passende Abonnenten kosten (fast) nichts");
+  check(sync8 > sync0, "Kosten wachsen mit passenden Abonnenten");
+  printf("\n");
+  overflow();
+  printf("\n");
+  concurrency(n / 4);
+  printf("\n%s (%d Fehler)\n", g_failed ? "FAIL" : "OK", g_failed);
+  return g_failed ? 1 : 0;
+}
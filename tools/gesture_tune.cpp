@@ -0,0 +1,503 @@
+// ============================================================================
+// File: tools/gesture_tune.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Gestenschwellen offline aus gelabelten Touch-Aufnahmen bestimmen
+//  • Spielt Aufnahmen durch dieselbe Kette wie am Gerät ab: TouchTracker ->
+//    GestureEngine (src/, unverändert), Engine-Aufruf alle 5 ms wie der
+//    Eingabe-Task (INPUT_TOUCH_POLL_US), Frames zur Aufnahmezeit
+//  • Raster über die Schwellen (--grid), parallel auf allen Kernen
+//  • Je Parametersatz: Trefferquote und Zeit bis Ereignis (Gestenbeginn ->
+//    Ereignis, Mittel/p95); Ausgabe der Pareto-Front und des gewählten
+//    Satzes mit Verwechslungstabelle
+//  • --out schreibt src/gestures/gesture_params.h (Firmware nutzt ihn direkt)
+//
+// Aufnahme (Text, eine oder mehrere Dateien):
+//    # Kommentar
+//    label <Geste>              folgende Frames gehören zu dieser Geste:
+//                               Tap DoubleTap LongPress SwipeLeft SwipeRight
+//                               SwipeUp SwipeDown TwoFingerTap None
+//    <t_ms> <n> [<x> <y>]...    Touch-Frame, Display-Koordinaten, n = 0: los
+//  Bewertet wird je Abschnitt das letzte Ereignis (Doppeltipp meldet vorher
+//  einen Tap); richtig, wenn es zum Label passt, "None": kein Ereignis.
+//
+// Usage: gesture_tune synth <out.txt> [gesten=300] [seed=1]
+//        gesture_tune eval <aufnahme...>
+//        gesture_tune tune <aufnahme...> [--grid name=lo:hi:step]... [--threads N]
+//                          [--min-acc 0.95] [--out src/gestures/gesture_params.h]
+//        gesture_tune header <out.h>          Vorgabewerte ohne Tuning
+// Build: g++ -O2 -std=c++17 -pthread tools/gesture_tune.cpp src/gestures/GestureEngine.cpp src/touch/TouchTracker.cpp -o gesture_tune
+// ============================================================================
+#include "../src/gestures/GestureEngine.h"
+#include "../src/touch/TouchTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static constexpr uint32_t TICK_MS = INPUT_TOUCH_POLL_US / 1000;   // Eingabe-Task ohne INT
+static constexpr uint32_t TAIL_MS = 2000;                         // nach dem letzten Frame
+
+// ---------------------------- Gesten-Namen ----------------------------------
+static const struct { GestureType t; const char* name; } NAMES[] = {
+  {GestureType::None, "None"},           {GestureType::Tap, "Tap"},
+  {GestureType::DoubleTap, "DoubleTap"}, {GestureType::LongPress, "LongPress"},
+  {GestureType::SwipeLeft, "SwipeLeft"}, {GestureType::SwipeRight, "SwipeRight"},
+  {GestureType::SwipeUp, "SwipeUp"},     {GestureType::SwipeDown, "SwipeDown"},
+  {GestureType::PinchIn, "PinchIn"},     {GestureType::PinchOut, "PinchOut"},
+  {GestureType::RotateCW, "RotateCW"},   {GestureType::RotateCCW, "RotateCCW"},
+  {GestureType::TwoFingerTap, "TwoFingerTap"}, {GestureType::ThreeFingerTap, "ThreeFingerTap"},
+};
+static constexpr size_t NTYPES = (size_t)GestureType::ThreeFingerTap + 1;
+
+static const char* typeName(GestureType t){
+  for (const auto& n : NAMES) if (n.t == t) return n.name;
+  return "?";
+}
+static bool parseType(const std::string& s, GestureType& t){
+  for (const auto& n : NAMES) if (s == n.name) { t = n.t; return true; }
+  return false;
+}
+
+// ---------------------------- Aufnahme --------------------------------------
+struct Frame {
+  uint32_t     t;
+  uint8_t      n;
+  TouchContact c[MAX_TOUCH_POINTS];
+};
+struct Segment {
+  GestureType label;
+  size_t      firstFrame;     // erster Frame des Abschnitts
+  uint32_t    startMs;        // erster Frame mit Kontakt (Gestenbeginn)
+};
+struct Recording {
+  std::string          name;
+  std::vector<Frame>   frames;
+  std::vector<Segment> segs;
+};
+
+static bool loadRecording(const char* path, Recording& r){
+  std::ifstream f(path);
+  if (!f) { fprintf(stderr, "nicht lesbar: %s\n", path); return false; }
+  r.name = path;
+  std::string line;
+  int ln = 0;
+  bool wantStart = false;
+  while (std::getline(f, line)) {
+    ln++;
+    const size_t h = line.find('#');
+    if (h != std::string::npos) line.resize(h);
+    std::istringstream in(line);
+    std::string tok;
+    if (!(in >> tok)) continue;
+    if (tok == "label") {
+      std::string name;
+      Segment s{};
+      if (!(in >> name) || !parseType(name, s.label)) { fprintf(stderr, "%s:%d: Geste?\n", path, ln); return false; }
+      s.firstFrame = r.frames.size();
+      r.segs.push_back(s);
+      wantStart = true;
+      continue;
+    }
+    Frame fr{};
+    unsigned n = 0;
+    fr.t = (uint32_t)strtoul(tok.c_str(), nullptr, 10);
+    if (!(in >> n) || n > MAX_TOUCH_POINTS) { fprintf(stderr, "%s:%d: Frame?\n", path, ln); return false; }
+    fr.n = (uint8_t)n;
+    for (unsigned i = 0; i < n; i++) {
+      unsigned x, y;
+      if (!(in >> x >> y)) { fprintf(stderr, "%s:%d: Koordinaten?\n", path, ln); return false; }
+      fr.c[i] = {(uint16_t)x, (uint16_t)y, 80};
+    }
+    if (!r.frames.empty() && fr.t < r.frames.back().t) { fprintf(stderr, "%s:%d: Zeit rückwärts\n", path, ln); return false; }
+    if (wantStart && !r.segs.empty() && fr.n) { r.segs.back().startMs = fr.t; wantStart = false; }
+    r.frames.push_back(fr);
+  }
+  // Abschnitte ohne Kontakt (None-Pausen): Beginn = erster Frame
+  for (auto& s : r.segs) {
+    if (!s.startMs && s.firstFrame < r.frames.size()) s.startMs = r.frames[s.firstFrame].t;
+  }
+  return true;
+}
+
+// ---------------------------- Synthetische Aufnahme -------------------------
+// Menschliche Streuung: Tap-Dauer, Zittern, Doppeltipp-Abstand, Wisch-Tempo
+// und -Winkel, Pausen zwischen den Gesten (auch kürzer als ein Doppeltipp)
+static int synth(const char* out, int count, unsigned seed){
+  std::mt19937 rng(seed);
+  auto U = [&](double a, double b){ return std::uniform_real_distribution<double>(a, b)(rng); };
+  auto N = [&](double m, double s, double lo, double hi){
+    return std::min(hi, std::max(lo, std::normal_distribution<double>(m, s)(rng)));
+  };
+  FILE* f = fopen(out, "w");
+  if (!f) { perror(out); return 1; }
+  fprintf(f, "# synthetisch: gesture_tune synth %s %d %u\n", out, count, seed);
+  uint32_t t = 500;
+  auto frame = [&](uint32_t tm, int n, const double* xy){
+    fprintf(f, "%u %d", tm, n);
+    for (int i = 0; i < n; i++) {
+      const int x = (int)lround(std::min(319.0, std::max(0.0, xy[2 * i])));
+      const int y = (int)lround(std::min(239.0, std::max(0.0, xy[2 * i + 1])));
+      fprintf(f, " %d %d", x, y);
+    }
+    fprintf(f, "\n");
+  };
+  // Ein Finger von (x0,y0) nach (x1,y1) in dur ms, 100 Hz wie der CST328
+  auto stroke = [&](double x0, double y0, double x1, double y1, double dur, double jitter){
+    const uint32_t t0 = t;
+    for (double dt = 0; dt <= dur; dt += 10) {
+      const double a = dur > 0 ? dt / dur : 1;
+      double xy[2] = {x0 + (x1 - x0) * a + N(0, jitter, -3 * jitter - 1, 3 * jitter + 1),
+                      y0 + (y1 - y0) * a + N(0, jitter, -3 * jitter - 1, 3 * jitter + 1)};
+      frame(t0 + (uint32_t)dt, 1, xy);
+    }
+    t = t0 + (uint32_t)dur + 10;
+    frame(t, 0, nullptr);
+  };
+  static const char* const KINDS[] = {"Tap", "Tap", "DoubleTap", "LongPress", "SwipeLeft", "SwipeRight",
+                                      "SwipeUp", "SwipeDown", "TwoFingerTap"};
+  for (int g = 0; g < count; g++) {
+    const char* kind = KINDS[rng() % (sizeof(KINDS) / sizeof(KINDS[0]))];
+    fprintf(f, "label %s\n", kind);
+    const double x = U(40, 280), y = U(40, 200);
+    const std::string k = kind;
+    if (k == "Tap") {
+      const double drift = U(0, 1) < 0.15 ? U(8, 28) : U(0, 6);
+      const double a = U(0, 2 * M_PI);
+      stroke(x, y, x + drift * cos(a), y + drift * sin(a), N(90, 45, 20, 380), 1.0);
+    } else if (k == "DoubleTap") {
+      stroke(x, y, x + U(-3, 3), y + U(-3, 3), N(80, 30, 20, 250), 1.0);
+      t += (uint32_t)N(160, 70, 50, 450);
+      const double x2 = x + N(0, 6, -20, 20), y2 = y + N(0, 6, -20, 20);
+      stroke(x2, y2, x2 + U(-3, 3), y2 + U(-3, 3), N(80, 30, 20, 250), 1.0);
+    } else if (k == "LongPress") {
+      stroke(x, y, x + U(-8, 8), y + U(-8, 8), N(1000, 250, 550, 1800), 1.5);
+    } else if (k == "TwoFingerTap") {
+      const uint32_t t0 = t, dur = (uint32_t)N(120, 40, 50, 260);
+      const double dx = U(30, 70);
+      for (uint32_t dt = 0; dt <= dur; dt += 10) {
+        double xy[4] = {x + N(0, 1, -3, 3), y + N(0, 1, -3, 3), x + dx + N(0, 1, -3, 3), y + N(0, 1, -3, 3)};
+        frame(t0 + dt, dt == 0 && U(0, 1) < 0.3 ? 1 : 2, xy);   // zweiter Finger teils einen Frame später
+      }
+      t = t0 + dur + 10;
+      frame(t, 0, nullptr);
+    } else {
+      // Wischen: Richtung mit Winkelstreuung, Strecke und Tempo variieren
+      const double base = k == "SwipeRight" ? 0 : k == "SwipeDown" ? M_PI / 2 : k == "SwipeLeft" ? M_PI : -M_PI / 2;
+      const double ang = base + N(0, 0.25, -0.7, 0.7), dist = N(110, 50, 25, 220);
+      const double x1 = std::min(310.0, std::max(10.0, x + dist * cos(ang)));
+      const double y1 = std::min(230.0, std::max(10.0, y + dist * sin(ang)));
+      stroke(x, y, x1, y1, N(180, 80, 50, 600), 1.5);
+    }
+    t += (uint32_t)N(550, 300, 120, 2000);                     // Pause bis zur nächsten Geste
+  }
+  fclose(f);
+  printf("%d Gesten -> %s (%.1f s)\n", count, out, t / 1000.0);
+  return 0;
+}
+
+// ---------------------------- Abspielen und bewerten ------------------------
+struct Score {
+  uint32_t segs = 0, correct = 0;
+  double   tteSum = 0;
+  std::vector<uint32_t> tte;                     // je richtigem Abschnitt, ms
+  uint32_t confusion[NTYPES][NTYPES] = {};       // [Label][erkannt]
+  double   accuracy() const { return segs ? (double)correct / segs : 0; }
+  double   tteMean() const { return correct ? tteSum / correct : 0; }
+  uint32_t ttePct(double p){
+    if (tte.empty()) return 0;
+    std::sort(tte.begin(), tte.end());
+    return tte[std::min(tte.size() - 1, (size_t)(p * (tte.size() - 1) + 0.5))];
+  }
+};
+
+struct Event { uint32_t t; GestureType type; };
+
+static void replay(const Recording& r, const GestureParams& p, Score& sc, bool keepConfusion){
+  TouchTracker tracker;
+  GestureEngine eng;
+  eng.setParams(p);
+  eng.reset();
+  std::vector<Event> ev;
+  auto step = [&](uint32_t now){
+    const GestureEvent g = eng.process(tracker.points(), tracker.activeCount(), now);
+    if (g.type != GestureType::None) ev.push_back({now, g.type});
+  };
+  uint32_t tick = r.frames.empty() ? 0 : r.frames.front().t;
+  for (const Frame& f : r.frames) {
+    for (; tick < f.t; tick += TICK_MS) step(tick);
+    tracker.update(f.c, f.n, f.t);
+    step(f.t);
+  }
+  const uint32_t end = tick + TAIL_MS;
+  for (; tick < end; tick += TICK_MS) step(tick);
+
+  // Ereignisse den Abschnitten zuordnen: [Beginn, nächster Abschnitt)
+  size_t e = 0;
+  for (size_t s = 0; s < r.segs.size(); s++) {
+    const Segment& seg = r.segs[s];
+    const uint32_t from = seg.firstFrame < r.frames.size() ? r.frames[seg.firstFrame].t : end;
+    const uint32_t to = s + 1 < r.segs.size() && r.segs[s + 1].firstFrame < r.frames.size()
+                        ? r.frames[r.segs[s + 1].firstFrame].t : end + 1;
+    while (e < ev.size() && ev[e].t < from) e++;
+    GestureType last = GestureType::None;
+    int32_t firstMatch = -1;
+    for (; e < ev.size() && ev[e].t < to; e++) {
+      last = ev[e].type;
+      if (last == seg.label && firstMatch < 0) firstMatch = (int32_t)(ev[e].t - seg.startMs);
+    }
+    sc.segs++;
+    if (keepConfusion) sc.confusion[(size_t)seg.label][(size_t)last]++;
+    if (last == seg.label) {
+      sc.correct++;
+      const uint32_t d = firstMatch > 0 ? (uint32_t)firstMatch : 0;
+      sc.tteSum += d;
+      sc.tte.push_back(d);
+    }
+  }
+}
+
+static Score evaluate(const std::vector<Recording>& recs, const GestureParams& p, bool keepConfusion){
+  Score sc;
+  for (const auto& r : recs) replay(r, p, sc, keepConfusion);
+  return sc;
+}
+
+// ---------------------------- Parameter-Raster ------------------------------
+struct Param {
+  const char* name;
+  double lo, hi, step;                     // Standard-Raster
+  double (*get)(const GestureParams&);
+  void   (*set)(GestureParams&, double);
+};
+#define PARAM_U16(field, lo, hi, st) \
+  {#field, lo, hi, st, [](const GestureParams& p){ return (double)p.field; }, \
+   [](GestureParams& p, double v){ p.field = (uint16_t)lround(v); }}
+static Param PARAMS[] = {
+  PARAM_U16(tapMaxDurationMs, 150, 350, 50),
+  PARAM_U16(tapMaxMovementPx, 10, 40, 10),
+  PARAM_U16(doubleTapIntervalMs, 250, 500, 50),
+  PARAM_U16(longPressMs, 400, 1000, 100),
+  PARAM_U16(swipeMinDistancePx, 20, 50, 10),
+  PARAM_U16(swipeMaxDurationMs, 500, 500, 100),
+  {"swipeAxisRatio", 1.0, 2.0, 0.5, [](const GestureParams& p){ return (double)p.swipeAxisRatio; },
+   [](GestureParams& p, double v){ p.swipeAxisRatio = (float)v; }},
+  PARAM_U16(settleMs, 20, 20, 10),
+};
+static constexpr size_t NPARAMS = sizeof(PARAMS) / sizeof(PARAMS[0]);
+
+static bool parseGrid(const char* arg){
+  const char* eq = strchr(arg, '=');
+  if (!eq) return false;
+  const std::string name(arg, eq - arg);
+  for (auto& p : PARAMS) {
+    if (name != p.name) continue;
+    double lo, hi, st = 1;
+    const int n = sscanf(eq + 1, "%lf:%lf:%lf", &lo, &hi, &st);
+    if (n == 1) { hi = lo; st = 1; }
+    else if (n < 2 || st <= 0 || hi < lo) return false;
+    p.lo = lo; p.hi = hi; p.step = st;
+    return true;
+  }
+  return false;
+}
+
+static size_t steps(const Param& p){ return (size_t)floor((p.hi - p.lo) / p.step + 1e-9) + 1; }
+
+static GestureParams gridPoint(size_t idx){
+  GestureParams gp;
+  for (const auto& p : PARAMS) {
+    const size_t n = steps(p);
+    p.set(gp, p.lo + (double)(idx % n) * p.step);
+    idx /= n;
+  }
+  return gp;
+}
+
+static void printParams(const GestureParams& gp){
+  for (const auto& p : PARAMS) printf(" %s=%g", p.name, p.get(gp));
+  printf("\n");
+}
+
+static void printScore(Score& sc, const GestureParams& gp, bool confusion){
+  printf("  Treffer %u/%u = %.1f %%, Zeit bis Ereignis Mittel %.0f ms, p95 %u ms\n", sc.correct, sc.segs,
+         100.0 * sc.accuracy(), sc.tteMean(), sc.ttePct(0.95));
+  printf("  Satz:");
+  printParams(gp);
+  if (!confusion) return;
+  printf("  %-13s", "Label\\erkannt");
+  for (size_t j = 0; j < NTYPES; j++) printf(" %5.5s", typeName((GestureType)j));
+  printf("\n");
+  for (size_t i = 0; i < NTYPES; i++) {
+    uint32_t row = 0;
+    for (size_t j = 0; j < NTYPES; j++) row += sc.confusion[i][j];
+    if (!row) continue;
+    printf("  %-13s", typeName((GestureType)i));
+    for (size_t j = 0; j < NTYPES; j++) printf(" %5u", sc.confusion[i][j]);
+    printf("\n");
+  }
+}
+
+// ---------------------------- Header ----------------------------------------
+static bool writeHeader(const char* path, const GestureParams& gp, const std::string& origin){
+  FILE* f = fopen(path, "wb");
+  if (!f) { perror(path); return false; }
+  // Zeilenende CRLF wie der Rest von src/
+  auto line = [&](const char* fmt, auto... a){ fprintf(f, fmt, a...); fputs("\r\n", f); };
+  line("// ============================================================================");
+  line("// File: src/gestures/gesture_params.h");
+  line("// ----------------------------------------------------------------------------");
+  line("// Purpose: Gestenschwellen für GestureEngine – GENERIERT, nicht von Hand ändern");
+  line("//  • %s", origin.c_str());
+  line("//  • Neu erzeugen: tools/gesture_tune tune <aufnahmen...> --out src/gestures/gesture_params.h");
+  line("// ============================================================================");
+  line("#pragma once");
+  line("#include <stdint.h>");
+  line("");
+  line("static constexpr uint16_t TAP_MAX_DURATION    = %u;   // ms, Aufsetzen bis Loslassen", gp.tapMaxDurationMs);
+  line("static constexpr uint16_t TAP_MAX_MOVEMENT    = %u;    // px, auch Abstand beim Doppeltipp", gp.tapMaxMovementPx);
+  line("static constexpr uint16_t DOUBLE_TAP_INTERVAL = %u;   // ms, Tap -> zweiter Tap", gp.doubleTapIntervalMs);
+  line("static constexpr uint16_t LONG_PRESS_DURATION = %u;   // ms", gp.longPressMs);
+  line("static constexpr uint16_t SWIPE_MIN_DISTANCE  = %u;    // px", gp.swipeMinDistancePx);
+  line("static constexpr uint16_t SWIPE_MAX_DURATION  = %u;   // ms", gp.swipeMaxDurationMs);
+  line("static constexpr float    SWIPE_AXIS_RATIO    = %.2ff; // Haupt- zu Nebenachse", gp.swipeAxisRatio);
+  line("static constexpr uint16_t TOUCH_SETTLE_MS     = %u;    // ms, Fingerzahl stabil", gp.settleMs);
+  fclose(f);
+  printf("-> %s\n", path);
+  return true;
+}
+
+// ---------------------------- Modi ------------------------------------------
+static bool loadAll(int argc, char** argv, int from, std::vector<Recording>& recs, int& next){
+  next = from;
+  for (; next < argc && strncmp(argv[next], "--", 2) != 0; next++) {
+    recs.emplace_back();
+    if (!loadRecording(argv[next], recs.back())) return false;
+  }
+  size_t segs = 0, frames = 0;
+  for (const auto& r : recs) { segs += r.segs.size(); frames += r.frames.size(); }
+  printf("%zu Aufnahme(n), %zu Gesten, %zu Frames\n", recs.size(), segs, frames);
+  return !recs.empty() && segs > 0;
+}
+
+struct Result { size_t idx; double acc; double tte; };
+
+static int tune(int argc, char** argv){
+  std::vector<Recording> recs;
+  int i;
+  if (!loadAll(argc, argv, 2, recs, i)) return 2;
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  double minAcc = -1;
+  const char* out = nullptr;
+  for (; i < argc; i++) {
+    const std::string a = argv[i];
+    if (a == "--grid" && i + 1 < argc) {
+      if (!parseGrid(argv[++i])) { fprintf(stderr, "Raster? %s\n", argv[i]); return 2; }
+    } else if (a == "--threads" && i + 1 < argc) threads = (unsigned)atoi(argv[++i]);
+    else if (a == "--min-acc" && i + 1 < argc) minAcc = atof(argv[++i]);
+    else if (a == "--out" && i + 1 < argc) out = argv[++i];
+    else { fprintf(stderr, "Option? %s\n", a.c_str()); return 2; }
+  }
+
+  size_t total = 1;
+  printf("Raster:");
+  for (const auto& p : PARAMS) { printf(" %s=%g..%g/%g", p.name, p.lo, p.hi, p.step); total *= steps(p); }
+  printf("\n%zu Parametersätze auf %u Threads\n", total, threads);
+
+  // Parallel: jeder Thread holt sich den nächsten Rasterpunkt
+  std::vector<Result> res(total);
+  std::atomic<size_t> next{0};
+  const auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < threads; t++) {
+    pool.emplace_back([&]{
+      for (size_t k; (k = next.fetch_add(1)) < total;) {
+        const Score sc = evaluate(recs, gridPoint(k), false);
+        res[k] = {k, sc.accuracy(), sc.tteMean()};
+      }
+    });
+  }
+  for (auto& t : pool) t.join();
+  const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  printf("%.2f s (%.0f Sätze/s)\n", secs, total / secs);
+
+  // Pareto-Front: keine andere Lösung ist genauer UND schneller
+  std::sort(res.begin(), res.end(), [](const Result& a, const Result& b){
+    return a.tte != b.tte ? a.tte < b.tte : a.acc > b.acc;
+  });
+  std::vector<Result> front;
+  for (const auto& r : res) {
+    if (front.empty() || r.acc > front.back().acc + 1e-12) front.push_back(r);
+  }
+  printf("\nPareto-Front (Trefferquote vs. Zeit bis Ereignis), %zu Punkte:\n", front.size());
+  printf("  %7s %9s  Satz\n", "Treffer", "Mittel/ms");
+  for (const auto& r : front) {
+    printf("  %6.1f%% %9.0f ", 100 * r.acc, r.tte);
+    printParams(gridPoint(r.idx));
+  }
+
+  // Wahl: schnellster Satz mit Trefferquote >= min-acc, sonst der genaueste
+  const Result* pick = &front.back();
+  if (minAcc >= 0) {
+    for (const auto& r : front) if (r.acc >= minAcc) { pick = &r; break; }
+  }
+  const GestureParams best = gridPoint(pick->idx);
+  printf("\nGewählt%s:\n", minAcc >= 0 ? " (schnellster über --min-acc)" : " (höchste Trefferquote)");
+  Score sc = evaluate(recs, best, true);
+  printScore(sc, best, true);
+  printf("\nVorgabe (gesture_params.h):\n");
+  Score sd = evaluate(recs, GestureParams{}, false);
+  printScore(sd, GestureParams{}, false);
+
+  if (out) {
+    char origin[200];
+    size_t segs = 0;
+    for (const auto& r : recs) segs += r.segs.size();
+    snprintf(origin, sizeof(origin), "gesture_tune tune: %zu Aufnahme(n), %zu Gesten, Treffer %.1f %%, "
+             "Zeit bis Ereignis %.0f ms", recs.size(), segs, 100.0 * sc.accuracy(), sc.tteMean());
+    if (!writeHeader(out, best, origin)) return 1;
+  }
+  return 0;
+}
+
+static int eval(int argc, char** argv){
+  std::vector<Recording> recs;
+  int i;
+  if (!loadAll(argc, argv, 2, recs, i)) return 2;
+  const auto t0 = std::chrono::steady_clock::now();
+  Score sc = evaluate(recs, GestureParams{}, true);
+  const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  printf("Vorgabe (gesture_params.h), %.1f ms:\n", secs * 1000);
+  printScore(sc, GestureParams{}, true);
+  return 0;
+}
+
+int main(int argc, char** argv){
+  const std::string mode = argc > 1 ? argv[1] : "";
+  if (mode == "synth" && argc >= 3) {
+    return synth(argv[2], argc > 3 ? atoi(argv[3]) : 300, argc > 4 ? (unsigned)atoi(argv[4]) : 1);
+  }
+  if (mode == "eval" && argc >= 3) return eval(argc, argv);
+  if (mode == "tune" && argc >= 3) return tune(argc, argv);
+  if (mode == "header" && argc >= 3) {
+    return writeHeader(argv[2], GestureParams{}, "Vorgabewerte (gesture_tune header), nicht aus Aufnahmen") ? 0 : 1;
+  }
+  fprintf(stderr,
+    "usage: gesture_tune synth <out.txt> [gesten=300] [seed=1]\n"
+    "       gesture_tune eval <aufnahme...>\n"
+    "       gesture_tune tune <aufnahme...> [--grid name=lo:hi:step]... [--threads N]\n"
+    "                         [--min-acc 0.95] [--out src/gestures/gesture_params.h]\n"
+    "       gesture_tune header <out.h>\n"
+    "Raster-Namen:");
+  for (const auto& p : PARAMS) fprintf(stderr, " %s", p.name);
+  fprintf(stderr, "\n");
+  return 2;
+}
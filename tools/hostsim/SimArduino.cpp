@@ -0,0 +1,179 @@
+// ============================================================================
+// File: tools/hostsim/SimArduino.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Arduino-Kern im Simulator: Zeit, GPIO/Interrupts, USB-Konsole
+// ============================================================================
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <deque>
+#include "SimHost.h"
+#include "SimKernel.h"
+
+using sim::SimCost;
+
+HWCDC    Serial;
+EspClass ESP;
+
+// ---------------------------- Zeit ------------------------------------------
+// Wie am ESP32: 32 Bit, läuft nach ~71 min (micros) bzw. ~49 Tagen über
+unsigned long micros(){
+  sim::charge(SimCost::TIMER_READ_NS);
+  return (uint32_t)(sim::nowNs() / 1000);
+}
+
+unsigned long millis(){
+  sim::charge(SimCost::TIMER_READ_NS);
+  return (uint32_t)(sim::nowNs() / 1000000);
+}
+
+void delay(uint32_t ms){ vTaskDelay(pdMS_TO_TICKS(ms)); }
+void delayMicroseconds(uint32_t us){ sim::charge((uint64_t)us * 1000); }   // aktives Warten
+
+uint32_t EspClass::getCycleCount(){ return (uint32_t)(sim::nowNs() * 240 / 1000); }
+
+void EspClass::restart(){
+  fflush(stdout);
+  _Exit(3);
+}
+
+// Deterministisch (LCG), damit Läufe vergleichbar bleiben
+static uint32_t s_rand = 12345;
+long random(long howbig){
+  if (howbig <= 0) return 0;
+  s_rand = s_rand * 1103515245u + 12345u;
+  return (long)((s_rand >> 1) % (uint32_t)howbig);
+}
+long random(long howsmall, long howbig){
+  return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+// PSRAM: zählt nicht zum internen Heap (ESP.getFreeHeap(), App-Blöcke)
+void* ps_malloc(size_t size){ return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT); }
+
+// ---------------------------- GPIO ------------------------------------------
+static constexpr int PINS = 64;
+static uint8_t s_level[PINS];
+static void (*s_isr[PINS])() = {};
+static int     s_isrMode[PINS] = {};
+static bool    s_gpioInit = false;
+
+static void gpioInit(){
+  if (s_gpioInit) return;
+  for (auto& l : s_level) l = HIGH;             // offene Leitungen mit Pull-up
+  s_gpioInit = true;
+}
+
+void pinMode(uint8_t pin, uint8_t mode){ (void)pin; (void)mode; gpioInit(); }
+
+void digitalWrite(uint8_t pin, uint8_t val){
+  gpioInit();
+  if (pin < PINS) s_level[pin] = val ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin){
+  gpioInit();
+  return pin < PINS ? s_level[pin] : LOW;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode){
+  if (pin >= PINS) return;
+  s_isr[pin] = isr;
+  s_isrMode[pin] = mode;
+}
+
+void detachInterrupt(uint8_t pin){
+  if (pin < PINS) s_isr[pin] = nullptr;
+}
+
+namespace sim {
+
+void gpioWrite(uint8_t pin, int level){
+  gpioInit();
+  if (pin >= PINS) return;
+  const uint8_t old = s_level[pin];
+  s_level[pin] = level ? HIGH : LOW;
+  if (old == s_level[pin] || !s_isr[pin]) return;
+  const bool rising = s_level[pin] == HIGH;
+  const int  mode   = s_isrMode[pin];
+  if (mode == CHANGE || (mode == RISING && rising) || (mode == FALLING && !rising)) s_isr[pin]();
+}
+
+int gpioRead(uint8_t pin){ return digitalRead(pin); }
+
+}  // namespace sim
+
+// ---------------------------- String / Print --------------------------------
+void String::trim(){
+  size_t a = _s.find_first_not_of(" \t\r\n");
+  size_t b = _s.find_last_not_of(" \t\r\n");
+  _s = (a == std::string::npos) ? std::string() : _s.substr(a, b - a + 1);
+}
+
+void String::toLowerCase(){
+  for (char& c : _s) if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+}
+
+size_t Print::write(const uint8_t* buf, size_t n){
+  size_t w = 0;
+  while (w < n && write(buf[w])) w++;
+  return w;
+}
+
+// Wie im Arduino-Kern: 64 B auf dem Stack, längere Zeilen aus dem Heap
+// (sichtbar für core/HeapGuard)
+size_t Print::printf(const char* fmt, ...){
+  char small[64];
+  va_list ap;
+  va_start(ap, fmt);
+  int len = vsnprintf(small, sizeof(small), fmt, ap);
+  va_end(ap);
+  if (len < 0) return 0;
+  if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, (size_t)len);
+  char* big = (char*)malloc((size_t)len + 1);
+  if (!big) return 0;
+  va_start(ap, fmt);
+  vsnprintf(big, (size_t)len + 1, fmt, ap);
+  va_end(ap);
+  const size_t n = write((const uint8_t*)big, (size_t)len);
+  free(big);
+  return n;
+}
+
+// ---------------------------- USB-Konsole -----------------------------------
+static FILE*               s_sink = stdout;
+static uint64_t            s_outBytes = 0;
+static std::deque<uint8_t> s_in;
+
+size_t HWCDC::write(const uint8_t* buf, size_t n){
+  sim::charge(SimCost::SERIAL_CALL_NS + n * SimCost::SERIAL_BYTE_NS);
+  s_outBytes += n;
+  if (s_sink) fwrite(buf, 1, n, s_sink);
+  return n;
+}
+
+int HWCDC::available(){ return (int)s_in.size(); }
+
+int HWCDC::read(){
+  if (s_in.empty()) return -1;
+  const int c = s_in.front();
+  s_in.pop_front();
+  return c;
+}
+
+int HWCDC::peek(){ return s_in.empty() ? -1 : s_in.front(); }
+
+namespace sim {
+
+void consoleSink(FILE* f){
+  if (s_sink) fflush(s_sink);
+  s_sink = f;
+}
+
+void consoleInject(const char* text){
+  while (*text) s_in.push_back((uint8_t)*text++);
+  s_in.push_back('\n');
+}
+
+uint64_t consoleBytesOut(){ return s_outBytes; }
+
+}  // namespace sim
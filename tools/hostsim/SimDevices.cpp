@@ -0,0 +1,160 @@
+// ============================================================================
+// File: tools/hostsim/SimDevices.cpp
+// ----------------------------------------------------------------------------
+#include "SimDevices.h"
+#include "SimHost.h"
+#include "SimKernel.h"
+#include "../../src/config/params.h"
+#include <math.h>
+#include <string.h>
+
+// ---------------------------- CST328 ----------------------------------------
+void Cst328Model::start(){
+  sim::at(sim::nowNs() + CST_REPORT_NS, [this](uint64_t now){ return report(now); });
+}
+
+// Umkehrung von CST328Touch::rawToDisplay() mit denselben Parametern
+void Cst328Model::toRaw(uint16_t x, uint16_t y, uint16_t& rx, uint16_t& ry) const {
+  float ax = (float)x / (float)(DISPLAY_WIDTH - 1);
+  float ay = (float)y / (float)(DISPLAY_HEIGHT - 1);
+  if (TOUCH_INVERT_X) ax = 1.f - ax;
+  if (TOUCH_INVERT_Y) ay = 1.f - ay;
+  const float nx = TOUCH_SWAP_XY ? ay : ax;
+  const float ny = TOUCH_SWAP_XY ? ax : ay;
+  rx = (uint16_t)lroundf(TOUCH_RAW_X_MIN + nx * (TOUCH_RAW_X_MAX - TOUCH_RAW_X_MIN));
+  ry = (uint16_t)lroundf(TOUCH_RAW_Y_MIN + ny * (TOUCH_RAW_Y_MAX - TOUCH_RAW_Y_MIN));
+}
+
+void Cst328Model::down(uint8_t id, uint16_t x, uint16_t y, uint8_t pressure){
+  if (id >= FINGERS) return;
+  Finger& f = _f[id];
+  f.active   = true;
+  f.pressure = pressure;
+  toRaw(x, y, f.rx, f.ry);
+}
+
+void Cst328Model::move(uint8_t id, uint16_t x, uint16_t y){
+  if (id >= FINGERS || !_f[id].active) return;
+  toRaw(x, y, _f[id].rx, _f[id].ry);
+}
+
+void Cst328Model::up(uint8_t id){
+  if (id >= FINGERS || !_f[id].active) return;
+  _f[id].active = false;
+  _releasePending = true;
+}
+
+// INT (low-aktiv) pulsen, solange Finger liegen, und einmal nach dem Loslassen
+uint64_t Cst328Model::report(uint64_t now){
+  bool any = _releasePending;
+  for (const Finger& f : _f) any |= f.active;
+  if (any) {
+    sim::gpioWrite(_intPin, LOW);
+    sim::gpioWrite(_intPin, HIGH);
+    _irqPulses++;
+    _releasePending = false;
+  }
+  return now + CST_REPORT_NS;
+}
+
+bool Cst328Model::onWrite(const uint8_t* data, size_t n){
+  if (n < 2) return true;                       // Probe bzw. unvollständige Adresse
+  _reg = (uint16_t)(data[0] << 8 | data[1]);
+  if (n > 2 && _reg == 0xD109) _normalMode = true;   // ENUM_MODE_NORMAL
+  return true;
+}
+
+void Cst328Model::buildFrame(uint8_t* out) const {
+  static constexpr uint8_t BASE[FINGERS] = {0x00, 0x07, 0x0C, 0x11, 0x16};
+  memset(out, 0, 27);
+  uint8_t count = 0;
+  for (uint8_t id = 0; id < FINGERS; id++) {
+    const Finger& f = _f[id];
+    if (!f.active) continue;
+    uint8_t* s = out + BASE[count++];
+    s[0] = (uint8_t)(id << 4 | 0x06);            // ID | Status "Touch"
+    s[1] = (uint8_t)(f.rx >> 4);
+    s[2] = (uint8_t)(f.ry >> 4);
+    s[3] = (uint8_t)((f.rx & 0x0F) << 4 | (f.ry & 0x0F));
+    s[4] = f.pressure;
+  }
+  out[0x05] = count;
+  out[0x06] = _normalMode ? 0xAB : 0x00;
+}
+
+size_t Cst328Model::onRead(uint8_t* data, size_t n){
+  uint8_t frame[27];
+  buildFrame(frame);
+  if (_reg == 0xD000 && n >= sizeof(frame)) _frameReads++;
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t r = (uint32_t)_reg + i;
+    data[i] = (r >= 0xD000 && r < 0xD000 + sizeof(frame)) ? frame[r - 0xD000] : 0;
+  }
+  return n;
+}
+
+// ---------------------------- QMI8658 ---------------------------------------
+static constexpr uint8_t QMI_WHO_AM_I = 0x00;
+static constexpr uint8_t QMI_STATUS0  = 0x2E;
+static constexpr uint8_t QMI_AX_L     = 0x35;
+static constexpr uint8_t QMI_RESET    = 0x60;
+static constexpr uint64_t QMI_ODR_NS  = 2000000;       // 500 Hz (CTRL2/CTRL3 der App)
+
+Qmi8658Model::Qmi8658Model(){
+  memset(_regs, 0, sizeof(_regs));
+  _regs[QMI_WHO_AM_I] = 0x05;
+  _regs[0x01] = 0x7C;                                   // Revision
+}
+
+void Qmi8658Model::setMotion(float ax, float ay, float az, float gx, float gy, float gz){
+  _a[0] = ax; _a[1] = ay; _a[2] = az;
+  _g[0] = gx; _g[1] = gy; _g[2] = gz;
+}
+
+// Probe zum aktuellen Zeitpunkt; kleine Schwingung, damit sich Werte ändern
+void Qmi8658Model::refresh(){
+  const uint64_t now = sim::nowNs();
+  const bool fresh = now - _lastSampleNs >= QMI_ODR_NS;
+  _regs[QMI_STATUS0] = fresh ? 0x03 : 0x00;             // aDA | gDA
+  if (!fresh) return;
+  _lastSampleNs = now - (now % QMI_ODR_NS);
+  const float wobble = 0.01f * sinf(2.f * (float)M_PI * 0.5f * (float)(now / 1000000) / 1000.f);
+  auto put = [&](uint8_t reg, float v, float lsb){
+    long raw = lroundf(v * lsb);
+    if (raw > 32767) raw = 32767;
+    if (raw < -32768) raw = -32768;
+    _regs[reg]     = (uint8_t)(raw & 0xFF);
+    _regs[reg + 1] = (uint8_t)((raw >> 8) & 0xFF);
+  };
+  for (int i = 0; i < 3; i++) put((uint8_t)(QMI_AX_L + 2 * i), _a[i] + wobble, 8192.f);     // ±4 g
+  for (int i = 0; i < 3; i++) put((uint8_t)(QMI_AX_L + 6 + 2 * i), _g[i] + wobble, 16.4f);  // ±2048 dps
+}
+
+bool Qmi8658Model::onWrite(const uint8_t* data, size_t n){
+  if (n == 0) return true;
+  _ptr = data[0] & 0x7F;
+  for (size_t i = 1; i < n; i++) {
+    if (_ptr == QMI_RESET && data[i] == 0xB0) {
+      const uint8_t who = _regs[QMI_WHO_AM_I], rev = _regs[0x01];
+      memset(_regs, 0, sizeof(_regs));
+      _regs[QMI_WHO_AM_I] = who;
+      _regs[0x01] = rev;
+    } else {
+      _regs[_ptr] = data[i];
+    }
+    _ptr = (_ptr + 1) & 0x7F;
+  }
+  return true;
+}
+
+size_t Qmi8658Model::onRead(uint8_t* data, size_t n){
+  if (_ptr <= QMI_STATUS0 && _ptr + n > QMI_STATUS0) {
+    refresh();
+    _burstReads++;
+  }
+  for (size_t i = 0; i < n; i++) {
+    data[i] = _regs[_ptr];
+    _ptr = (_ptr + 1) & 0x7F;                          // ADDR_AI (CTRL1 Bit 6)
+  }
+  return n;
+}
@@ -0,0 +1,77 @@
+// ============================================================================
+// File: tools/hostsim/SimDevices.h
+// ----------------------------------------------------------------------------
+// Purpose: Registermodelle der I²C-Geräte des Boards
+//  • Cst328Model: Touch-Controller @0x1A (16-Bit-Register), 27-Byte-Frame
+//    ab 0xD000 wie im Datenblatt; INT-Puls je Report (CST_REPORT_NS) solange
+//    Finger liegen, plus einer beim Loslassen
+//  • Qmi8658Model: IMU @0x6B (8-Bit-Register, Auto-Inkrement), WHO_AM_I,
+//    STATUS0 mit aDA/gDA im ODR-Takt, Rohwerte aus setMotion()
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+class SimI2CDevice {
+public:
+  virtual ~SimI2CDevice() = default;
+  virtual bool   onWrite(const uint8_t* data, size_t n) = 0;   // false = NACK auf Daten
+  virtual size_t onRead(uint8_t* data, size_t n) = 0;
+};
+
+class Cst328Model : public SimI2CDevice {
+public:
+  static constexpr uint8_t  ADDR = 0x1A;
+  static constexpr uint8_t  FINGERS = 5;
+  static constexpr uint64_t CST_REPORT_NS = 10000000;   // 100 Hz Report-Rate
+
+  explicit Cst328Model(uint8_t intPin) : _intPin(intPin) {}
+  void start();                                  // INT-Takt anlegen (nach begin der App)
+
+  // Szenario: Display-Koordinaten, wie DisplayManager sie zeichnet
+  void down(uint8_t id, uint16_t x, uint16_t y, uint8_t pressure = 80);
+  void move(uint8_t id, uint16_t x, uint16_t y);
+  void up(uint8_t id);
+
+  bool   onWrite(const uint8_t* data, size_t n) override;
+  size_t onRead(uint8_t* data, size_t n) override;
+
+  uint32_t frameReads() const { return _frameReads; }
+  uint32_t irqPulses() const { return _irqPulses; }
+
+private:
+  struct Finger { bool active = false; uint16_t rx = 0, ry = 0; uint8_t pressure = 0; };
+  void toRaw(uint16_t x, uint16_t y, uint16_t& rx, uint16_t& ry) const;
+  void buildFrame(uint8_t* out) const;
+  uint64_t report(uint64_t now);
+
+  uint8_t  _intPin;
+  uint16_t _reg = 0;
+  bool     _normalMode = true;
+  Finger   _f[FINGERS];
+  bool     _releasePending = false;
+  uint32_t _frameReads = 0, _irqPulses = 0;
+};
+
+class Qmi8658Model : public SimI2CDevice {
+public:
+  static constexpr uint8_t  ADDR = 0x6B;
+
+  Qmi8658Model();
+  void setMotion(float ax, float ay, float az, float gx, float gy, float gz);
+
+  bool   onWrite(const uint8_t* data, size_t n) override;
+  size_t onRead(uint8_t* data, size_t n) override;
+
+  uint32_t burstReads() const { return _burstReads; }
+
+private:
+  void refresh();                                // Daten für "jetzt" eintragen
+
+  uint8_t  _regs[0x80];
+  uint8_t  _ptr = 0;
+  float    _a[3] = {0.f, 0.f, 1.f};
+  float    _g[3] = {0.f, 0.f, 0.f};
+  uint64_t _lastSampleNs = 0;                    // letzte vom Host gelesene Probe
+  uint32_t _burstReads = 0;
+};
@@ -0,0 +1,74 @@
+// ============================================================================
+// File: tools/hostsim/SimFs.cpp
+// ----------------------------------------------------------------------------
+#include <LittleFS.h>
+#include <sys/stat.h>
+
+fs::LittleFSFS LittleFS;
+
+namespace fs {
+
+File::File(FILE* f, const char* path) : _f(f, fclose), _name(path) {}
+
+size_t File::write(const uint8_t* buf, size_t n){ return _f ? fwrite(buf, 1, n, _f.get()) : 0; }
+
+int File::available(){
+  if (!_f) return 0;
+  return (int)(size() - position());
+}
+
+int File::read(){
+  if (!_f) return -1;
+  const int c = fgetc(_f.get());
+  return c == EOF ? -1 : c;
+}
+
+size_t File::read(uint8_t* buf, size_t n){ return _f ? fread(buf, 1, n, _f.get()) : 0; }
+
+bool File::seek(uint32_t pos, SeekMode mode){
+  if (!_f) return false;
+  const int whence = mode == SeekCur ? SEEK_CUR : (mode == SeekEnd ? SEEK_END : SEEK_SET);
+  return fseek(_f.get(), (long)pos, whence) == 0;
+}
+
+size_t File::position() const { return _f ? (size_t)ftell(_f.get()) : 0; }
+
+size_t File::size() const {
+  if (!_f) return 0;
+  struct stat st;
+  return fstat(fileno(_f.get()), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close(){ _f.reset(); }
+
+std::string FS::hostPath(const char* path) const {
+  return _root + (path && path[0] == '/' ? "" : "/") + (path ? path : "");
+}
+
+File FS::open(const char* path, const char* mode, bool create){
+  (void)create;
+  if (_root.empty()) return File();
+  const std::string p = hostPath(path);
+  const char* m = (mode && mode[0] == 'w') ? "wb" : (mode && mode[0] == 'a') ? "ab" : "rb";
+  FILE* f = fopen(p.c_str(), m);
+  return f ? File(f, path) : File();
+}
+
+bool FS::exists(const char* path){
+  if (_root.empty()) return false;
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path){
+  return !_root.empty() && ::remove(hostPath(path).c_str()) == 0;
+}
+
+// Ohne --fs: "nicht gemountet" wie ein leeres Flash ohne Partition
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles, const char* partitionLabel){
+  (void)formatOnFail; (void)basePath; (void)maxOpenFiles; (void)partitionLabel;
+  struct stat st;
+  return !_root.empty() && stat(_root.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+}  // namespace fs
@@ -0,0 +1,195 @@
+// ============================================================================
+// File: tools/hostsim/SimGfx.cpp
+// ----------------------------------------------------------------------------
+#include <LovyanGFX.hpp>
+#include "SimHost.h"
+#include "SimKernel.h"
+
+using sim::SimCost;
+
+const fonts::IFont fonts::Font0 = {6, 8};
+
+static lgfx::LGFX_Device* s_display = nullptr;
+
+namespace lgfx {
+
+void LGFXBase::initSurface(int32_t w, int32_t h, uint32_t spiHz){
+  _memW  = w;
+  _memH  = h;
+  _spiHz = spiHz;
+  _mem.assign((size_t)w * (size_t)h, 0);
+  _px = _mem.data();
+  clearClipRect();
+}
+
+void LGFXBase::setClipRect(int32_t x, int32_t y, int32_t w, int32_t h){
+  _clipX0 = x < 0 ? 0 : x;
+  _clipY0 = y < 0 ? 0 : y;
+  _clipX1 = x + w > width() ? width() : x + w;
+  _clipY1 = y + h > height() ? height() : y + h;
+}
+
+static inline uint16_t swap16(uint16_t v){ return (uint16_t)((v << 8) | (v >> 8)); }
+
+// Logische Koordinaten (nach Rotation) -> Panelspeicher
+bool LGFXBase::plot(int32_t x, int32_t y, uint16_t c){
+  if (x < _clipX0 || y < _clipY0 || x >= _clipX1 || y >= _clipY1) return false;
+  int32_t mx = x, my = y;
+  switch (_rotation) {
+    case 1: mx = _memW - 1 - y; my = x; break;
+    case 2: mx = _memW - 1 - x; my = _memH - 1 - y; break;
+    case 3: mx = y; my = _memH - 1 - x; break;
+    default: break;
+  }
+  _px[(size_t)my * (size_t)_memW + (size_t)mx] = _swap ? swap16(c) : c;
+  return true;
+}
+
+uint16_t LGFXBase::readPixel(int32_t x, int32_t y) const {
+  if (x < 0 || y < 0 || x >= width() || y >= height()) return 0;
+  int32_t mx = x, my = y;
+  switch (_rotation) {
+    case 1: mx = _memW - 1 - y; my = x; break;
+    case 2: mx = _memW - 1 - x; my = _memH - 1 - y; break;
+    case 3: mx = y; my = _memH - 1 - x; break;
+    default: break;
+  }
+  const uint16_t v = _px[(size_t)my * (size_t)_memW + (size_t)mx];
+  return _swap ? swap16(v) : v;
+}
+
+// Ein Befehl: Adressfenster + Pixel mit 16 Bit über SPI (Sprite: RAM)
+void LGFXBase::chargeSpi(uint64_t pixels){
+  _stats.commands++;
+  _stats.pixels += pixels;
+  uint64_t ns;
+  if (_spiHz) ns = SimCost::SPI_CMD_NS + pixels * 16ull * 1000000000ull / _spiHz;
+  else        ns = pixels * SimCost::RAM_PIXEL_NS;
+  _stats.busyNs += ns;
+  sim::charge(ns);
+}
+
+void LGFXBase::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color){
+  if (w < 0) { x += w; w = -w; }
+  if (h < 0) { y += h; h = -h; }
+  int32_t x0 = x < _clipX0 ? _clipX0 : x, y0 = y < _clipY0 ? _clipY0 : y;
+  int32_t x1 = x + w > _clipX1 ? _clipX1 : x + w;
+  int32_t y1 = y + h > _clipY1 ? _clipY1 : y + h;
+  if (x0 >= x1 || y0 >= y1) return;
+  for (int32_t j = y0; j < y1; j++)
+    for (int32_t i = x0; i < x1; i++) plot(i, j, (uint16_t)color);
+  chargeSpi((uint64_t)(x1 - x0) * (uint64_t)(y1 - y0));
+}
+
+void LGFXBase::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color){
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+// Wie LovyanGFX: je Zeile ein waagrechter Lauf
+void LGFXBase::fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color){
+  for (int32_t dy = -r; dy <= r; dy++) {
+    const int32_t dx = (int32_t)sqrtf((float)(r * r - dy * dy));
+    drawFastHLine(x - dx, y + dy, 2 * dx + 1, color);
+  }
+}
+
+void LGFXBase::drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color){
+  int32_t px = r, py = 0, err = 1 - r;
+  uint64_t n = 0;
+  while (px >= py) {
+    const int32_t pts[8][2] = {{px, py}, {py, px}, {-py, px}, {-px, py},
+                               {-px, -py}, {-py, -px}, {py, -px}, {px, -py}};
+    for (auto& p : pts) { plot(x + p[0], y + p[1], (uint16_t)color); n++; }
+    py++;
+    if (err < 0) err += 2 * py + 1;
+    else { px--; err += 2 * (py - px) + 1; }
+  }
+  // Einzelpixel: je Pixel ein (kurzes) Adressfenster
+  for (uint64_t i = 0; i < n; i++) chargeSpi(1);
+}
+
+// Wie LovyanGFX: nur der sichtbare Teil geht über den Bus
+void LGFXBase::blit(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data, bool swapped){
+  if (!data || w <= 0 || h <= 0) return;
+  uint64_t n = 0;
+  for (int32_t j = 0; j < h; j++) {
+    for (int32_t i = 0; i < w; i++) {
+      const uint16_t v = data[(size_t)j * (size_t)w + (size_t)i];
+      n += plot(x + i, y + j, swapped ? swap16(v) : v);
+    }
+  }
+  if (n) chargeSpi(n);
+}
+
+// 6x8-Zelle je Zeichen; Muster aus dem Zeichencode statt Schrift
+size_t LGFXBase::write(uint8_t c){
+  const int32_t cw = 6 * _textSize, ch = 8 * _textSize;
+  if (c == '\n') { _cx = 0; _cy += ch; return 1; }
+  if (c == '\r') return 1;
+  if (_cx + cw > width()) { _cx = 0; _cy += ch; }
+  uint64_t px = 0;
+  const uint32_t bits = (uint32_t)c * 0x9E3779B1u;
+  for (int32_t row = 0; row < 8; row++) {
+    for (int32_t col = 0; col < 6; col++) {
+      const bool on = c > ' ' && row < 7 && col < 5 && ((bits >> ((row * 5 + col) % 32)) & 1u);
+      if (!on && !_bgFill) continue;
+      for (int32_t sy = 0; sy < _textSize; sy++)
+        for (int32_t sx = 0; sx < _textSize; sx++)
+          plot(_cx + col * _textSize + sx, _cy + row * _textSize + sy, on ? _fg : _bg);
+      px += (uint64_t)_textSize * _textSize;
+    }
+  }
+  if (px) chargeSpi(px);
+  _cx += cw;
+  return 1;
+}
+
+bool LGFXBase::simWritePpm(const char* path) const {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  fprintf(f, "P6\n%d %d\n255\n", (int)width(), (int)height());
+  for (int32_t y = 0; y < height(); y++) {
+    for (int32_t x = 0; x < width(); x++) {
+      const uint16_t p = readPixel(x, y);
+      const uint8_t rgb[3] = {(uint8_t)((p >> 11) << 3), (uint8_t)(((p >> 5) & 0x3F) << 2), (uint8_t)((p & 0x1F) << 3)};
+      fwrite(rgb, 1, 3, f);
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+// Panel-Reset/Init am Gerät ~120 ms
+bool LGFX_Device::init(){
+  if (!_panel) return false;
+  const auto& pc = _panel->config();
+  const uint32_t hz = _panel->bus() ? _panel->bus()->config().freq_write : 40000000;
+  initSurface(pc.memory_width, pc.memory_height, hz ? hz : 40000000);
+  sim::sleepFor(120000000);
+  s_display = this;
+  return true;
+}
+
+}  // namespace lgfx
+
+void* LGFX_Sprite::createSprite(int32_t w, int32_t h){
+  if (w <= 0 || h <= 0) return nullptr;
+  initSurface(w, h, 0);
+  return _px;
+}
+
+void LGFX_Sprite::setBuffer(void* buffer, int32_t w, int32_t h, int bits){
+  (void)bits;
+  _mem.clear();
+  _memW = w;
+  _memH = h;
+  _px   = static_cast<uint16_t*>(buffer);
+  clearClipRect();
+}
+
+namespace sim {
+lgfx::LGFX_Device* display(){ return s_display; }
+}
@@ -0,0 +1,225 @@
+// ============================================================================
+// File: tools/hostsim/SimHeap.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Heap des Simulators für den statischen Betrieb (core/HeapGuard)
+//  • malloc & Co. umgeleitet (glibc __libc_*), operator new landet ebenfalls
+//    hier: ersetzt die operator-new-Hooks des Geräts
+//  • Allokationen aus App-Tasks (nicht ISR/Timer, nicht im Simulator-Inneren
+//    unter HeapQuiet) gehen an heapguard::noteAlloc()
+//  • App-Blöcke (aus Tasks, nicht unter HeapQuiet) in eigener Tabelle:
+//    daraus ESP.getFreeHeap() & Co. und heap_caps_get_info(), Größe wie
+//    der interne RAM des ESP32-S3; WAV-Puffer & Co. zählen nicht mit
+//  • HOSTSIM_HEAP_TRAP=1: Backtrace beim ersten Verstoß und Abbruch
+// ============================================================================
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <atomic>
+#include <execinfo.h>
+#include <malloc.h>
+#include <unistd.h>
+#include "SimHost.h"
+#include "SimKernel.h"
+#include "../../src/core/HeapGuard.h"
+
+extern "C" void* __libc_malloc(size_t);
+extern "C" void* __libc_calloc(size_t, size_t);
+extern "C" void* __libc_realloc(void*, size_t);
+extern "C" void  __libc_free(void*);
+
+static constexpr size_t HEAP_SIZE = 320 * 1024;
+
+static std::atomic<int64_t> s_used{0};         // alle Allokationen
+static std::atomic<int64_t> s_blocks{0};
+static std::atomic<int64_t> s_peak{0};
+static thread_local int     t_quiet = 0;
+static thread_local bool    t_inHook = false;
+static int                  s_trap = -1;        // -1 = Umgebung noch nicht gelesen
+
+namespace sim {
+HeapQuiet::HeapQuiet(){ t_quiet++; }
+HeapQuiet::~HeapQuiet(){ t_quiet--; }
+}
+
+static void noteUsed(int64_t bytes, int64_t blocks){
+  const int64_t used = s_used.fetch_add(bytes) + bytes;
+  s_blocks.fetch_add(blocks);
+  int64_t peak = s_peak.load();
+  while (used > peak && !s_peak.compare_exchange_weak(peak, used)) {}
+}
+
+// ---------------------------- App-Blöcke ------------------------------------
+// Offene Adressierung ohne Heap; Grabstein = TOMB
+static constexpr size_t APP_SLOTS = 1 << 16;
+struct AppBlock { void* p; size_t size; };
+static AppBlock         s_app[APP_SLOTS];
+static std::atomic_flag s_appLock = ATOMIC_FLAG_INIT;
+static void* const      TOMB = (void*)1;
+static int64_t          s_appUsed = 0, s_appPeak = 0, s_appBlocks = 0;
+
+struct AppLock {
+  AppLock(){ while (s_appLock.test_and_set(std::memory_order_acquire)) {} }
+  ~AppLock(){ s_appLock.clear(std::memory_order_release); }
+};
+
+static size_t slotOf(void* p){ return (size_t)(((uintptr_t)p >> 4) * 0x9E3779B97F4A7C15ull >> 48) & (APP_SLOTS - 1); }
+
+static bool isApp(){ return !t_quiet && sim::current(); }
+
+static void appAdd(void* p){
+  const size_t n = malloc_usable_size(p);
+  AppLock lk;
+  for (size_t i = slotOf(p), k = 0; k < APP_SLOTS; i = (i + 1) & (APP_SLOTS - 1), k++) {
+    if (s_app[i].p && s_app[i].p != TOMB) continue;
+    s_app[i] = AppBlock{p, n};
+    s_appUsed += (int64_t)n;
+    s_appBlocks++;
+    if (s_appUsed > s_appPeak) s_appPeak = s_appUsed;
+    return;
+  }
+}
+
+static void appRemove(void* p){
+  AppLock lk;
+  for (size_t i = slotOf(p), k = 0; k < APP_SLOTS && s_app[i].p; i = (i + 1) & (APP_SLOTS - 1), k++) {
+    if (s_app[i].p != p) continue;
+    s_appUsed -= (int64_t)s_app[i].size;
+    s_appBlocks--;
+    s_app[i].p = TOMB;
+    return;
+  }
+}
+
+static void noteApp(size_t n, void* caller){
+  if (t_quiet || t_inHook || !heapguard::sealed() || !sim::current()) return;
+  t_inHook = true;
+  const uint32_t before = heapguard::violations();
+  heapguard::noteAlloc(n, caller);
+  if (s_trap < 0) { const char* e = getenv("HOSTSIM_HEAP_TRAP"); s_trap = e && *e == '1'; }
+  if (s_trap && heapguard::violations() != before) {
+    dprintf(2, "[SIM] Allokation nach seal(): %zu B in Task %s\n", n, sim::nameOf(sim::current()));
+    void* bt[32];
+    backtrace_symbols_fd(bt, backtrace(bt, 32), 2);
+    abort();
+  }
+  t_inHook = false;
+}
+
+extern "C" void* malloc(size_t n){
+  void* p = __libc_malloc(n);
+  if (p) noteUsed((int64_t)malloc_usable_size(p), 1);
+  if (p && isApp()) appAdd(p);
+  noteApp(n, __builtin_return_address(0));
+  return p;
+}
+
+extern "C" void* calloc(size_t n, size_t sz){
+  void* p = __libc_calloc(n, sz);
+  if (p) noteUsed((int64_t)malloc_usable_size(p), 1);
+  if (p && isApp()) appAdd(p);
+  noteApp(n * sz, __builtin_return_address(0));
+  return p;
+}
+
+extern "C" void* realloc(void* old, size_t n){
+  const int64_t before = old ? (int64_t)malloc_usable_size(old) : 0;
+  if (old) appRemove(old);
+  void* p = __libc_realloc(old, n);
+  if (p) noteUsed((int64_t)malloc_usable_size(p) - before, old ? 0 : 1);
+  else if (old && n == 0) noteUsed(-before, -1);
+  if (p && isApp()) appAdd(p);
+  noteApp(n, __builtin_return_address(0));
+  return p;
+}
+
+extern "C" void free(void* p){
+  if (!p) return;
+  noteUsed(-(int64_t)malloc_usable_size(p), -1);
+  appRemove(p);
+  __libc_free(p);
+}
+
+// ---------------------------- ESP-Heap-API ----------------------------------
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t){
+  int64_t used, peak, blocks;
+  {
+    AppLock lk;
+    used = s_appUsed; peak = s_appPeak; blocks = s_appBlocks;
+  }
+  *info = multi_heap_info_t{};
+  info->total_allocated_bytes = (size_t)used;
+  info->total_free_bytes      = used < (int64_t)HEAP_SIZE ? HEAP_SIZE - (size_t)used : 0;
+  info->largest_free_block    = info->total_free_bytes;
+  info->minimum_free_bytes    = peak < (int64_t)HEAP_SIZE ? HEAP_SIZE - (size_t)peak : 0;
+  info->allocated_blocks      = (size_t)blocks;
+}
+
+// PSRAM: Blöcke unter HeapQuiet, eigene Tabelle (wenige große Puffer)
+static constexpr size_t PSRAM_SIZE   = 8 * 1024 * 1024;
+static constexpr size_t PSRAM_BLOCKS = 64;
+static AppBlock s_psram[PSRAM_BLOCKS];
+static int64_t  s_psramUsed = 0;
+
+void* heap_caps_malloc(size_t size, uint32_t caps){
+  if (!(caps & MALLOC_CAP_SPIRAM)) return malloc(size);
+  AppLock lk;
+  if (s_psramUsed + (int64_t)size > (int64_t)PSRAM_SIZE) return nullptr;
+  for (AppBlock& b : s_psram) {
+    if (b.p) continue;
+    sim::HeapQuiet q;
+    b.p = malloc(size);
+    if (!b.p) return nullptr;
+    b.size = size;
+    s_psramUsed += (int64_t)size;
+    return b.p;
+  }
+  return nullptr;
+}
+
+void heap_caps_free(void* p){
+  if (!p) return;
+  {
+    AppLock lk;
+    for (AppBlock& b : s_psram) {
+      if (b.p != p) continue;
+      s_psramUsed -= (int64_t)b.size;
+      b = AppBlock{};
+      break;
+    }
+  }
+  free(p);
+}
+
+size_t heap_caps_get_total_size(uint32_t caps){
+  return (caps & MALLOC_CAP_SPIRAM) ? PSRAM_SIZE : HEAP_SIZE;
+}
+
+size_t heap_caps_get_free_size(uint32_t caps){
+  if (caps & MALLOC_CAP_SPIRAM) {
+    AppLock lk;
+    return PSRAM_SIZE - (size_t)s_psramUsed;
+  }
+  multi_heap_info_t i;
+  heap_caps_get_info(&i, caps);
+  return i.total_free_bytes;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps){ return heap_caps_get_free_size(caps); }
+
+uint32_t EspClass::getHeapSize(){ return HEAP_SIZE; }
+uint32_t EspClass::getFreeHeap(){
+  multi_heap_info_t i;
+  heap_caps_get_info(&i, MALLOC_CAP_DEFAULT);
+  return (uint32_t)i.total_free_bytes;
+}
+uint32_t EspClass::getMinFreeHeap(){
+  multi_heap_info_t i;
+  heap_caps_get_info(&i, MALLOC_CAP_DEFAULT);
+  return (uint32_t)i.minimum_free_bytes;
+}
+uint32_t EspClass::getMaxAllocHeap(){ return getFreeHeap(); }
+
+sim::HeapInfo sim::heapInfo(){
+  AppLock lk;
+  return HeapInfo{(uint64_t)s_used.load(), (uint64_t)s_peak.load(), (uint64_t)s_blocks.load(),
+                  (uint64_t)s_appUsed, (uint64_t)s_appPeak, (uint64_t)s_appBlocks};
+}
@@ -0,0 +1,77 @@
+// ============================================================================
+// File: tools/hostsim/SimHost.h
+// ----------------------------------------------------------------------------
+// Purpose: Steuerung der Fake-Peripherie aus main.cpp und dem Szenario
+//  • Konsole (USB-CDC): Ausgabe-Senke, Eingabezeilen einspeisen
+//  • GPIO-Flanken (löst attachInterrupt-ISRs aus), Anzeige, I2S-Senke, UART
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+#include <string>
+
+namespace sim {
+
+// ---------------------------- Konsole ---------------------------------------
+void     consoleSink(FILE* f);                 // nullptr = verwerfen (nur zählen)
+void     consoleInject(const char* text);      // wie getippt, inkl. '\n'
+uint64_t consoleBytesOut();
+
+// ---------------------------- GPIO ------------------------------------------
+void gpioWrite(uint8_t pin, int level);        // Flanke -> ISR (im ISR-Kontext aufrufen)
+int  gpioRead(uint8_t pin);
+
+// ---------------------------- Anzeige ---------------------------------------
+lgfx::LGFX_Device* display();                  // zuletzt initialisiertes Panel
+
+// ---------------------------- I2S -------------------------------------------
+struct I2SStats {
+  uint32_t sampleRate = 0;
+  uint32_t writes = 0;
+  uint64_t samples = 0;         // vom Audio-Task geschrieben
+  uint64_t silence = 0;         // DMA leer gelaufen (als Stille aufgezeichnet)
+  uint64_t nonZero = 0;
+  int16_t  peak = 0;
+  uint32_t underrunEvents = 0;  // I2S_EVENT_TX_Q_OVF gemeldet
+  uint64_t blockedNs = 0;       // i2s_write wartete auf freien DMA-Puffer
+};
+I2SStats i2sStats(int port = 0);
+bool     i2sWriteWav(const char* path, int port = 0);
+
+// ---------------------------- Heap ------------------------------------------
+// Allokationen im Simulator-Inneren (Timer, Queues, Modelle) zählen nicht
+// als App-Allokation nach seal()
+struct HeapQuiet {
+  HeapQuiet();
+  ~HeapQuiet();
+  HeapQuiet(const HeapQuiet&) = delete;
+  HeapQuiet& operator=(const HeapQuiet&) = delete;
+};
+struct HeapInfo {
+  uint64_t usedBytes;           // alle Allokationen (App + Simulator)
+  uint64_t peakBytes;
+  uint64_t blocks;
+  uint64_t appBytes;            // nur aus App-Tasks (= ESP.getFreeHeap()-Sicht)
+  uint64_t appPeakBytes;
+  uint64_t appBlocks;
+};
+HeapInfo heapInfo();
+
+// ---------------------------- NVS (Preferences) -----------------------------
+bool nvsFile(const char* path);                // laden; Änderungen zurückschreiben
+
+// ---------------------------- UART ------------------------------------------
+struct UartStats {
+  uint64_t txBytes = 0;
+  uint64_t rxBytes = 0;
+  uint32_t rxOverflows = 0;
+  uint32_t rxEvents = 0;        // onReceive-Aufrufe
+};
+HardwareSerial* uart(int port);
+UartStats       uartStats(int port);
+void            uartInject(int port, const uint8_t* data, size_t n);
+void            uartLink(int a, int b);       // TX von a -> RX von b und umgekehrt
+// PTY für den Port öffnen; realtime: virtuelle Zeit nicht schneller als die Uhr
+bool            uartOpenPty(int port, bool realtime, std::string& slaveName);
+
+}  // namespace sim
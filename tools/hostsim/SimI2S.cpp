@@ -0,0 +1,144 @@
+// ============================================================================
+// File: tools/hostsim/SimI2S.cpp
+// ----------------------------------------------------------------------------
+// Purpose: I2S-Senke: Samples landen in virtueller Echtzeit in einer
+// Aufnahme (WAV). Der DMA-Ring wird nicht als Speicher nachgebaut, nur sein
+// Füllstand: playEnd = Zeitpunkt, an dem das letzte Sample ausgespielt ist.
+// ============================================================================
+#include <driver/i2s.h>
+#include <vector>
+#include "SimHost.h"
+#include "SimKernel.h"
+
+static constexpr size_t MAX_RECORD_SAMPLES = 48000u * 600u;    // ~10 min
+
+struct I2SPort {
+  bool          installed = false;
+  i2s_config_t  cfg{};
+  QueueHandle_t events = nullptr;
+  uint64_t      playEnd = 0;
+  bool          played = false;       // Daten im Ring seit dem letzten Leerlauf
+  std::vector<int16_t> rec;
+  sim::I2SStats stats;
+};
+
+static I2SPort s_port[2];
+
+static uint64_t sampleNs(const I2SPort& p){ return 1000000000ull / (uint64_t)p.cfg.sample_rate; }
+
+static void record(I2SPort& p, const int16_t* s, size_t n){
+  sim::HeapQuiet quiet;              // WAV-Mitschnitt gehört zum Simulator
+  if (p.rec.size() + n > MAX_RECORD_SAMPLES) n = MAX_RECORD_SAMPLES - p.rec.size();
+  if (s) p.rec.insert(p.rec.end(), s, s + n);
+  else   p.rec.insert(p.rec.end(), n, (int16_t)0);
+}
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t* cfg, int queueSize, void* queue){
+  if ((int)port > 1 || !cfg || cfg->sample_rate <= 0) return ESP_ERR_INVALID_ARG;
+  I2SPort& p = s_port[port];
+  if (p.installed) return ESP_ERR_INVALID_STATE;
+  p = I2SPort{};
+  p.installed = true;
+  p.cfg = *cfg;
+  p.stats.sampleRate = (uint32_t)cfg->sample_rate;
+  p.playEnd = sim::nowNs();
+  if (queue && queueSize > 0) {
+    p.events = xQueueCreate((UBaseType_t)queueSize, sizeof(i2s_event_t));
+    *static_cast<QueueHandle_t*>(queue) = p.events;
+  }
+  return ESP_OK;
+}
+
+esp_err_t i2s_driver_uninstall(i2s_port_t port){
+  if ((int)port > 1 || !s_port[port].installed) return ESP_ERR_INVALID_STATE;
+  s_port[port].installed = false;
+  return ESP_OK;
+}
+
+esp_err_t i2s_set_pin(i2s_port_t port, const i2s_pin_config_t* pins){
+  (void)pins;
+  return ((int)port <= 1 && s_port[port].installed) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t i2s_zero_dma_buffer(i2s_port_t port){
+  return ((int)port <= 1 && s_port[port].installed) ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+// Mono, 16 Bit (I2S_CHANNEL_FMT_ONLY_LEFT wie AudioI2S)
+esp_err_t i2s_write(i2s_port_t port, const void* src, size_t size, size_t* written, TickType_t ticks){
+  (void)ticks;
+  if ((int)port > 1 || !s_port[port].installed) return ESP_ERR_INVALID_STATE;
+  I2SPort& p = s_port[port];
+  const uint64_t dt = sampleNs(p);
+  const size_t   n  = size / sizeof(int16_t);
+  const uint64_t cap = (uint64_t)p.cfg.dma_buf_count * (uint64_t)p.cfg.dma_buf_len;
+  uint64_t now = sim::nowNs();
+
+  // Ring leer gelaufen: DMA spielt Nullen (tx_desc_auto_clear)
+  if (p.playEnd < now) {
+    const uint64_t gap = (now - p.playEnd) / dt;
+    record(p, nullptr, (size_t)gap);
+    p.stats.silence += gap;
+    p.playEnd = now;
+  }
+
+  // Kein Platz im Ring: warten, bis genug ausgespielt ist
+  const uint64_t limit = (cap > n ? cap - n : 0) * dt;
+  if (p.playEnd - now > limit) {
+    const uint64_t wait = p.playEnd - limit - now;
+    sim::sleepFor(wait);
+    p.stats.blockedNs += sim::nowNs() - now;
+    now = sim::nowNs();
+  }
+
+  const int16_t* s = static_cast<const int16_t*>(src);
+  record(p, s, n);
+  for (size_t i = 0; i < n; i++) {
+    if (s[i]) p.stats.nonZero++;
+    const int16_t a = s[i] < 0 ? (int16_t)(s[i] == INT16_MIN ? INT16_MAX : -s[i]) : s[i];
+    if (a > p.stats.peak) p.stats.peak = a;
+  }
+  p.playEnd += n * dt;
+  p.played = true;
+
+  // Ring läuft leer, wenn bis playEnd nichts nachkommt: Ereignis zur Leerlaufzeit
+  const uint64_t end = p.playEnd;
+  sim::at(end, [&p, end](uint64_t) -> uint64_t {
+    if (p.playEnd != end || !p.played) return sim::NEVER;
+    p.played = false;
+    if (p.events) {
+      const i2s_event_t ev{I2S_EVENT_TX_Q_OVF, 0};
+      xQueueSendFromISR(p.events, &ev, nullptr);
+      p.stats.underrunEvents++;
+    }
+    return sim::NEVER;
+  });
+  p.stats.writes++;
+  p.stats.samples += n;
+  if (written) *written = n * sizeof(int16_t);
+  return ESP_OK;
+}
+
+namespace sim {
+
+I2SStats i2sStats(int port){ return (port >= 0 && port <= 1) ? s_port[port].stats : I2SStats{}; }
+
+static void put16(FILE* f, uint16_t v){ fputc(v & 0xFF, f); fputc(v >> 8, f); }
+static void put32(FILE* f, uint32_t v){ put16(f, (uint16_t)v); put16(f, (uint16_t)(v >> 16)); }
+
+bool i2sWriteWav(const char* path, int port){
+  if (port < 0 || port > 1 || !s_port[port].stats.sampleRate) return false;
+  const I2SPort& p = s_port[port];
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  const uint32_t data = (uint32_t)(p.rec.size() * sizeof(int16_t));
+  fwrite("RIFF", 1, 4, f); put32(f, 36 + data); fwrite("WAVE", 1, 4, f);
+  fwrite("fmt ", 1, 4, f); put32(f, 16); put16(f, 1); put16(f, 1);
+  put32(f, p.stats.sampleRate); put32(f, p.stats.sampleRate * 2); put16(f, 2); put16(f, 16);
+  fwrite("data", 1, 4, f); put32(f, data);
+  for (int16_t s : p.rec) put16(f, (uint16_t)s);
+  fclose(f);
+  return true;
+}
+
+}  // namespace sim
@@ -0,0 +1,522 @@
+// ============================================================================
+// File: tools/hostsim/SimKernel.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Virtuelle Zeit, Task-Wechsel und FreeRTOS-API des Host-Simulators
+//  • Jeder Task ist ein Host-Thread, aber nur der Inhaber des Staffelstabs
+//    (g_running) läuft; Wechsel nur an Modellpunkten (charge, block, yield)
+//  • reschedule() entscheidet allein aus virtuellen Zeiten -> gleiche
+//    Eingabe, gleicher Ablauf (außer mit --cpu-scale bzw. PTY-Eingabe)
+// ============================================================================
+#include "SimKernel.h"
+#include "SimHost.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_freertos_hooks.h"
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim {
+
+enum class St : uint8_t { Ready, Blocked, Dead };
+
+struct Task {
+  std::string    name;
+  TaskFunction_t fn = nullptr;
+  void*          arg = nullptr;
+  int            prio = 0;
+  int            core = 0;
+  St             st = St::Ready;
+  uint64_t       wakeNs = NEVER;
+  bool           timedOut = false;
+  uint32_t       notify = 0;
+  int            crit = 0;
+  uint64_t       lastPick = 0;         // Reihum-Wechsel bei gleicher Priorität
+  uint64_t       runNs = 0;
+  uint32_t       switches = 0;
+};
+
+struct Cpu {
+  uint64_t ns = 0;
+  uint64_t idleNs = 0;
+  Task*    last = nullptr;
+  std::vector<bool (*)()> hooks;
+};
+
+struct Timer {
+  uint64_t ns;
+  uint64_t seq;
+  std::function<uint64_t(uint64_t)> fn;
+  bool operator>(const Timer& o) const { return ns != o.ns ? ns > o.ns : seq > o.seq; }
+};
+
+static std::mutex              g_m;
+static std::condition_variable g_cv;
+static Task*                   g_running = nullptr;   // nullptr = Hauptthread
+static std::vector<Task*>      g_tasks;
+static Cpu                     g_cpu[CORES];
+static std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> g_timers;
+static uint64_t g_timerSeq = 0;
+static uint64_t g_pickSeq  = 0;
+static uint64_t g_endNs    = 0;
+static uint64_t g_sliceEnd = 0;
+static bool     g_isr      = false;
+static uint64_t g_isrNs    = 0;
+static double   g_cpuScale = 0.0;
+static thread_local uint64_t t_cpuMark = 0;
+
+static uint64_t hostCpuNs(){
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void init(double cpuScale){
+  g_cpuScale = cpuScale;
+}
+
+uint64_t nowNs(){
+  if (g_isr) return g_isrNs;
+  if (g_running) return g_cpu[g_running->core].ns;
+  return g_cpu[0].ns > g_cpu[1].ns ? g_cpu[0].ns : g_cpu[1].ns;
+}
+
+uint64_t coreNs(int core){ return g_cpu[core].ns; }
+bool inIsr(){ return g_isr; }
+Task* current(){ return g_isr ? nullptr : g_running; }
+uint32_t& notifyCount(Task* t){ return t->notify; }
+int coreOf(Task* t){ return t ? t->core : 0; }
+const char* nameOf(Task* t){ return t ? t->name.c_str() : "main"; }
+uint64_t idleNs(int core){ return g_cpu[core].idleNs; }
+
+// ---------------------------- Auswahl ---------------------------------------
+static Task* pick(int core){
+  Task* best = nullptr;
+  for (Task* t : g_tasks) {
+    if (t->core != core || t->st != St::Ready) continue;
+    if (!best || t->prio > best->prio || (t->prio == best->prio && t->lastPick < best->lastPick)) best = t;
+  }
+  return best;
+}
+
+static bool hasPeer(int core, const Task* next){
+  for (Task* t : g_tasks)
+    if (t != next && t->core == core && t->st == St::Ready && t->prio == next->prio) return true;
+  return false;
+}
+
+static uint64_t nextEvent(){
+  uint64_t t = g_timers.empty() ? NEVER : g_timers.top().ns;
+  for (Task* k : g_tasks)
+    if (k->st == St::Blocked && k->wakeNs < t) t = k->wakeNs;
+  return t;
+}
+
+// Kern ohne Task bis T vorziehen; Idle-Hooks im Abstand IDLE_HOOK_NS
+static void idleTo(int core, uint64_t T){
+  Cpu& c = g_cpu[core];
+  if (c.ns >= T) return;
+  if (!c.hooks.empty()) {
+    const bool isr = g_isr;
+    const uint64_t isrNs = g_isrNs;
+    g_isr = true;
+    for (uint64_t t = c.ns; t < T; t += SimCost::IDLE_HOOK_NS) {
+      for (auto h : c.hooks) { g_isrNs = t; h(); }
+    }
+    g_isr = isr;
+    g_isrNs = isrNs;
+  }
+  c.idleNs += T - c.ns;
+  c.ns = T;
+}
+
+static void fireEvents(uint64_t T){
+  HeapQuiet quiet;                   // Timer-Kopien, Modelle: Simulator-Inneres
+  for (int c = 0; c < CORES; c++) if (!pick(c)) idleTo(c, T);
+  while (!g_timers.empty() && g_timers.top().ns <= T) {
+    Timer tm = g_timers.top();
+    g_timers.pop();
+    g_isr = true;
+    g_isrNs = tm.ns;
+    const uint64_t next = tm.fn(tm.ns);
+    g_isr = false;
+    if (next != NEVER) g_timers.push(Timer{next, g_timerSeq++, std::move(tm.fn)});
+  }
+  for (Task* k : g_tasks) {
+    if (k->st == St::Blocked && k->wakeNs <= T) {
+      k->st = St::Ready;
+      k->wakeNs = NEVER;
+      k->timedOut = true;
+    }
+  }
+}
+
+static void handOff(Task* self, Task* next){
+  std::unique_lock<std::mutex> lk(g_m);
+  g_running = next;
+  if (next == self) return;
+  g_cv.notify_all();
+  g_cv.wait(lk, [&]{ return g_running == self; });
+}
+
+static void reschedule(){
+  Task* self = g_running;
+  for (;;) {
+    Task* cand[CORES];
+    int best = -1;
+    for (int c = 0; c < CORES; c++) {
+      cand[c] = pick(c);
+      if (cand[c] && (best < 0 || g_cpu[c].ns < g_cpu[best].ns)) best = c;
+    }
+    const uint64_t tEv  = nextEvent();
+    const uint64_t tRun = best >= 0 ? g_cpu[best].ns : NEVER;
+    if ((tEv < tRun ? tEv : tRun) >= g_endNs) {     // Laufzeit erreicht
+      for (int c = 0; c < CORES; c++) if (!cand[c]) idleTo(c, g_endNs);
+      handOff(self, nullptr);
+      break;
+    }
+    if (tEv <= tRun) { fireEvents(tEv); continue; }
+
+    Task* next = cand[best];
+    Cpu&  cpu  = g_cpu[best];
+    uint64_t slice = tEv < g_endNs ? tEv : g_endNs;
+    for (int c = 0; c < CORES; c++)
+      if (c != best && cand[c] && g_cpu[c].ns + QUANTUM_NS < slice) slice = g_cpu[c].ns + QUANTUM_NS;
+    if (hasPeer(best, next)) {
+      const uint64_t tick = (cpu.ns / TICK_NS + 1) * TICK_NS;
+      if (tick < slice) slice = tick;
+    }
+    g_sliceEnd = slice;
+    next->lastPick = ++g_pickSeq;
+    if (cpu.last != next) {
+      if (cpu.last && cpu.last->st != St::Dead) cpu.last->switches++;
+      cpu.last = next;
+      cpu.ns += SimCost::SWITCH_NS;
+      next->runNs += SimCost::SWITCH_NS;
+    }
+    handOff(self, next);
+    break;
+  }
+  if (g_cpuScale > 0) t_cpuMark = hostCpuNs();
+}
+
+void charge(uint64_t ns){
+  if (g_isr) { g_isrNs += ns; return; }
+  Task* t = g_running;
+  if (!t) return;
+  if (g_cpuScale > 0) ns += (uint64_t)((double)(hostCpuNs() - t_cpuMark) * g_cpuScale);
+  Cpu& c = g_cpu[t->core];
+  c.ns     += ns;
+  t->runNs += ns;
+  if (c.ns >= g_sliceEnd && t->crit == 0) reschedule();
+  else if (g_cpuScale > 0) t_cpuMark = hostCpuNs();
+}
+
+// ---------------------------- Tasks -----------------------------------------
+static void taskMain(Task* t){
+  {
+    std::unique_lock<std::mutex> lk(g_m);
+    g_cv.wait(lk, [&]{ return g_running == t; });
+  }
+  t_cpuMark = hostCpuNs();
+  t->fn(t->arg);
+  deleteTask(t);                     // Rückkehr aus der Task-Funktion wie vTaskDelete
+}
+
+Task* createTask(TaskFunction_t fn, void* arg, const char* name, int prio, int core){
+  Task* t = new Task;
+  t->name = name ? name : "?";
+  t->fn   = fn;
+  t->arg  = arg;
+  t->prio = prio;
+  t->core = (core >= 0 && core < CORES) ? core : 0;
+  t->st   = St::Blocked;
+  g_tasks.push_back(t);
+  std::thread(taskMain, t).detach();
+  wake(t);
+  return t;
+}
+
+void deleteTask(Task* t){
+  if (!t) t = g_running;
+  if (!t) return;
+  t->st = St::Dead;
+  if (t == g_running && !g_isr) reschedule();     // kehrt nie zurück
+}
+
+void wake(Task* t){
+  if (!t || t->st != St::Blocked) return;
+  t->st       = St::Ready;
+  t->wakeNs   = NEVER;
+  t->timedOut = false;
+  const uint64_t now = nowNs();
+  // Leerlaufender Kern übernimmt die Weckzeit
+  bool coreBusy = g_running && !g_isr && g_running->core == t->core;
+  for (Task* k : g_tasks) if (k != t && k->core == t->core && k->st == St::Ready) coreBusy = true;
+  if (!coreBusy) idleTo(t->core, now);
+  if (g_isr || !g_running) return;               // reschedule() rechnet neu
+  if (t->core == g_running->core) {
+    if (t->prio > g_running->prio) g_sliceEnd = 0;
+  } else if (g_cpu[t->core].ns + QUANTUM_NS < g_sliceEnd) {
+    g_sliceEnd = g_cpu[t->core].ns + QUANTUM_NS;
+  }
+}
+
+bool block(uint64_t untilNs){
+  Task* t = g_running;
+  if (!t || g_isr) return false;
+  t->st       = St::Blocked;
+  t->wakeNs   = untilNs;
+  t->timedOut = false;
+  reschedule();
+  return !t->timedOut;
+}
+
+void sleepFor(uint64_t ns){
+  if (!g_running || g_isr) { charge(ns); return; }
+  const uint64_t dl = nowNs() + ns;
+  while (nowNs() < dl) block(dl);
+}
+
+void yield(){
+  if (g_running && !g_isr) reschedule();
+}
+
+void enterCritical(){
+  if (g_running && !g_isr) g_running->crit++;
+}
+
+void exitCritical(){
+  if (!g_running || g_isr || g_running->crit == 0) return;
+  if (--g_running->crit == 0 && g_cpu[g_running->core].ns >= g_sliceEnd) reschedule();
+}
+
+void at(uint64_t ns, std::function<uint64_t(uint64_t)> fn){
+  HeapQuiet quiet;
+  g_timers.push(Timer{ns, g_timerSeq++, std::move(fn)});
+  if (!g_isr && g_running && ns < g_sliceEnd) g_sliceEnd = ns;
+}
+
+void addIdleHook(int core, bool (*hook)()){
+  if (core >= 0 && core < CORES) g_cpu[core].hooks.push_back(hook);
+}
+
+void removeIdleHook(int core, bool (*hook)()){
+  if (core < 0 || core >= CORES) return;
+  auto& h = g_cpu[core].hooks;
+  h.erase(std::remove(h.begin(), h.end(), hook), h.end());
+}
+
+void runUntil(uint64_t endNs){
+  g_endNs = endNs;
+  reschedule();
+}
+
+size_t taskInfo(TaskInfo* out, size_t max){
+  size_t n = 0;
+  for (Task* t : g_tasks) {
+    if (n >= max) break;
+    out[n++] = TaskInfo{t->name.c_str(), t->core, t->prio, t->runNs, t->switches};
+  }
+  return n;
+}
+
+}  // namespace sim
+
+// ============================================================================
+// FreeRTOS-API
+// ============================================================================
+using sim::SimCost;
+
+// Timeout in Ticks -> absolute Zeit auf der nächsten Tick-Grenze
+static uint64_t deadlineFor(TickType_t ticks){
+  if (ticks == portMAX_DELAY) return sim::NEVER;
+  return (sim::nowNs() / sim::TICK_NS + ticks) * sim::TICK_NS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                   UBaseType_t prio, TaskHandle_t* out, BaseType_t core){
+  (void)stack;
+  sim::Task* t = sim::createTask(fn, arg, name, (int)prio, core == tskNO_AFFINITY ? 0 : (int)core);
+  if (out) *out = t;
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                       UBaseType_t prio, TaskHandle_t* out){
+  return xTaskCreatePinnedToCore(fn, name, stack, arg, prio, out, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t t){ sim::deleteTask(static_cast<sim::Task*>(t)); }
+
+void vTaskDelay(TickType_t ticks){
+  sim::charge(SimCost::QUEUE_OP_NS);
+  if (ticks == 0) { sim::yield(); return; }
+  const uint64_t dl = deadlineFor(ticks);
+  while (sim::nowNs() < dl) sim::block(dl);
+}
+
+void taskYIELD(){ sim::yield(); }
+TaskHandle_t xTaskGetCurrentTaskHandle(){ return sim::current(); }
+char* pcTaskGetName(TaskHandle_t t){
+  return const_cast<char*>(sim::nameOf(static_cast<sim::Task*>(t ? t : sim::current())));
+}
+TickType_t xTaskGetTickCount(){ return (TickType_t)(sim::nowNs() / sim::TICK_NS); }
+BaseType_t xPortGetCoreID(){ return sim::coreOf(sim::current()); }
+
+BaseType_t xTaskNotifyGive(TaskHandle_t h){
+  sim::charge(SimCost::QUEUE_OP_NS);
+  sim::Task* t = static_cast<sim::Task*>(h);
+  if (!t) return pdFAIL;
+  sim::notifyCount(t)++;
+  sim::wake(t);
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t h, BaseType_t* woken){
+  sim::Task* t = static_cast<sim::Task*>(h);
+  if (!t) return;
+  sim::notifyCount(t)++;
+  sim::wake(t);
+  if (woken) *woken = pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks){
+  sim::charge(SimCost::QUEUE_OP_NS);
+  sim::Task* t = sim::current();
+  if (!t) return 0;
+  uint32_t& n = sim::notifyCount(t);
+  const uint64_t dl = deadlineFor(ticks);
+  for (;;) {
+    if (n) {
+      const uint32_t r = n;
+      n = clearOnExit ? 0 : n - 1;
+      return r;
+    }
+    if (ticks == 0 || sim::nowNs() >= dl) return 0;
+    sim::block(dl);
+  }
+}
+
+void vPortEnterCritical(portMUX_TYPE* mux){ (void)mux; sim::enterCritical(); }
+void vPortExitCritical(portMUX_TYPE* mux){ (void)mux; sim::exitCritical(); }
+
+// ---------------------------- Queues ----------------------------------------
+struct SimQueue {
+  size_t itemSize = 0, cap = 0, head = 0, count = 0;
+  std::vector<uint8_t>    buf;
+  std::vector<sim::Task*> waiters;     // Sender und Empfänger (prüfen nach dem Wecken neu)
+};
+
+static void wakeWaiters(SimQueue* q){
+  std::vector<sim::Task*> w;
+  w.swap(q->waiters);
+  for (sim::Task* t : w) sim::wake(t);
+}
+
+static void waitOn(SimQueue* q, uint64_t dl){
+  sim::Task* t = sim::current();
+  {
+    sim::HeapQuiet quiet;
+    q->waiters.push_back(t);
+  }
+  sim::block(dl);
+  for (size_t i = 0; i < q->waiters.size(); i++)
+    if (q->waiters[i] == t) { q->waiters.erase(q->waiters.begin() + (long)i); break; }
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize){
+  SimQueue* q = new SimQueue;
+  q->itemSize = itemSize;
+  q->cap      = length;
+  q->buf.resize((size_t)length * itemSize);
+  return q;
+}
+
+void vQueueDelete(QueueHandle_t q){ delete q; }
+
+static bool tryPush(SimQueue* q, const void* item){
+  if (q->count >= q->cap) return false;
+  if (q->itemSize)
+    memcpy(&q->buf[((q->head + q->count) % q->cap) * q->itemSize], item, q->itemSize);
+  q->count++;
+  wakeWaiters(q);
+  return true;
+}
+
+static bool tryPop(SimQueue* q, void* item){
+  if (q->count == 0) return false;
+  if (q->itemSize && item) memcpy(item, &q->buf[q->head * q->itemSize], q->itemSize);
+  q->head = (q->head + 1) % q->cap;
+  q->count--;
+  wakeWaiters(q);
+  return true;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks){
+  if (!q) return pdFAIL;
+  sim::charge(SimCost::QUEUE_OP_NS);
+  const uint64_t dl = deadlineFor(ticks);
+  for (;;) {
+    if (tryPush(q, item)) return pdTRUE;
+    if (ticks == 0 || sim::inIsr() || sim::nowNs() >= dl) return pdFALSE;
+    waitOn(q, dl);
+  }
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t q, const void* item, BaseType_t* woken){
+  if (woken) *woken = pdFALSE;
+  return q && tryPush(q, item) ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks){
+  if (!q) return pdFAIL;
+  sim::charge(SimCost::QUEUE_OP_NS);
+  const uint64_t dl = deadlineFor(ticks);
+  for (;;) {
+    if (tryPop(q, item)) return pdTRUE;
+    if (ticks == 0 || sim::inIsr() || sim::nowNs() >= dl) return pdFALSE;
+    waitOn(q, dl);
+  }
+}
+
+BaseType_t xQueueReset(QueueHandle_t q){
+  if (!q) return pdFAIL;
+  q->head = q->count = 0;
+  wakeWaiters(q);
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q){ return q ? (UBaseType_t)q->count : 0; }
+
+SemaphoreHandle_t xSemaphoreCreateBinary(){ return xQueueCreate(1, 0); }
+
+SemaphoreHandle_t xSemaphoreCreateMutex(){
+  SemaphoreHandle_t s = xQueueCreate(1, 0);
+  s->count = 1;
+  return s;
+}
+
+// ---------------------------- esp_timer / Idle-Hooks ------------------------
+int64_t esp_timer_get_time(){
+  sim::charge(SimCost::TIMER_READ_NS);
+  return (int64_t)(sim::nowNs() / 1000);
+}
+
+esp_err_t esp_register_freertos_idle_hook_for_cpu(esp_freertos_idle_cb_t cb, UBaseType_t cpu){
+  if (!cb || cpu >= (UBaseType_t)sim::CORES) return ESP_ERR_INVALID_ARG;
+  sim::addIdleHook((int)cpu, cb);
+  return ESP_OK;
+}
+
+void esp_deregister_freertos_idle_hook_for_cpu(esp_freertos_idle_cb_t cb, UBaseType_t cpu){
+  sim::removeIdleHook((int)cpu, cb);
+}
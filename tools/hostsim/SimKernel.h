@@ -0,0 +1,87 @@
+// ============================================================================
+// File: tools/hostsim/SimKernel.h
+// ----------------------------------------------------------------------------
+// Purpose: Virtuelle Zeit und Tasks des Host-Simulators
+//  • Zwei virtuelle Kerne mit eigener Uhr (ns). Es läuft immer genau ein
+//    Host-Thread (Staffelstab), der Kern mit der kleinsten Uhr ist dran;
+//    Vorsprung höchstens QUANTUM_NS -> Ablauf deterministisch
+//  • Zeit vergeht nur über charge(): Kostenmodell je Peripheriezugriff
+//    (SimCost) und optional gemessene Host-CPU-Zeit x cpuScale
+//  • Kern ohne lauffähigen Task springt zur nächsten Weckzeit/Timer
+//    (dort laufen auch die Idle-Hooks) -> beschleunigte Zeit
+//  • Pro Kern Prioritäten wie FreeRTOS, gleiche Priorität im Tick-Wechsel;
+//    Tasks ohne Kernbindung laufen auf Kern 0
+//  • Timer (at()) laufen im ISR-Kontext: nowNs() = Timerzeit, kein Wechsel
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <functional>
+#include "freertos/FreeRTOS.h"
+
+namespace sim {
+
+// Kostenmodell in ns. Grobe ESP32-S3-Werte (240 MHz), nur Größenordnung:
+// die Zahlen bestimmen Loop-Durchläufe/s und Job-Laufzeiten im
+// deterministischen Modus, nicht die Reihenfolge der Ereignisse.
+struct SimCost {
+  static constexpr uint64_t TIMER_READ_NS    = 300;    // micros()/millis()/esp_timer_get_time()
+  static constexpr uint64_t LOOP_TASK_NS     = 500;    // Arduino-loopTask je loop()-Aufruf
+  static constexpr uint64_t QUEUE_OP_NS      = 400;    // xQueueSend/Receive, Notify
+  static constexpr uint64_t SWITCH_NS        = 2000;   // Kontextwechsel
+  static constexpr uint64_t SERIAL_CALL_NS   = 2000;   // USB-CDC write()
+  static constexpr uint64_t SERIAL_BYTE_NS   = 50;
+  static constexpr uint64_t I2C_CALL_NS      = 8000;   // Treiber je Wire-Aufruf (IDF 4.4), Bus: 9 Takte/Byte
+  static constexpr uint64_t SPI_CMD_NS       = 3000;   // Adressfenster + Befehl, Bus: 16 Bit/Pixel
+  static constexpr uint64_t RAM_PIXEL_NS     = 4;      // Sprite-Pixel im RAM
+  static constexpr uint64_t UART_CALL_NS     = 3000;   // HardwareSerial::write()
+  static constexpr uint64_t IDLE_HOOK_NS     = 5000;   // Abstand der Idle-Hook-Aufrufe
+};
+
+static constexpr uint64_t NEVER      = UINT64_MAX;
+static constexpr uint64_t TICK_NS    = 1000000;        // configTICK_RATE_HZ = 1000
+static constexpr uint64_t QUANTUM_NS = 20000;          // max. Vorsprung eines Kerns
+static constexpr int      CORES      = 2;
+
+struct Task;
+
+struct TaskInfo {
+  const char* name;
+  int         core;
+  int         prio;
+  uint64_t    runNs;          // Laufzeit auf dem Kern
+  uint32_t    switches;       // vom Kern genommen (Block/Verdrängung)
+};
+
+void     init(double cpuScale);
+uint64_t nowNs();
+uint64_t coreNs(int core);
+void     charge(uint64_t ns);             // Laufzeit des aktuellen Kontexts
+bool     inIsr();
+
+// Tasks
+Task*    createTask(TaskFunction_t fn, void* arg, const char* name, int prio, int core);
+Task*    current();
+void     deleteTask(Task* t);             // nullptr = aktueller
+bool     block(uint64_t untilNs);         // true = geweckt, false = Zeit abgelaufen
+void     sleepFor(uint64_t ns);           // Task wartet (Bus/DMA), CPU frei für andere
+void     wake(Task* t);
+void     yield();
+uint32_t& notifyCount(Task* t);
+int      coreOf(Task* t);
+const char* nameOf(Task* t);
+void     enterCritical();
+void     exitCritical();
+
+// Timer im ISR-Kontext; periodisch: fn liefert die nächste Zeit (NEVER = Ende)
+void     at(uint64_t ns, std::function<uint64_t(uint64_t)> fn);
+
+void     addIdleHook(int core, bool (*hook)());
+void     removeIdleHook(int core, bool (*hook)());
+
+// Hauptthread: simulieren bis endNs (Tasks behalten ihren Zustand)
+void     runUntil(uint64_t endNs);
+
+size_t   taskInfo(TaskInfo* out, size_t max);
+uint64_t idleNs(int core);                 // Summe der Leerlaufzeit
+
+}  // namespace sim
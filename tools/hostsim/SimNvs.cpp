@@ -0,0 +1,102 @@
+// ============================================================================
+// File: tools/hostsim/SimNvs.cpp
+// ----------------------------------------------------------------------------
+// Purpose: NVS hinter Preferences.h als Map "namespace/key" -> Bytes
+//  • sim::nvsFile(): Datei laden, jede Änderung zurückschreiben (zweiter
+//    Lauf sieht den Stand des ersten, z.B. I²C-Adresskarten beim Boot)
+// ============================================================================
+#include <Preferences.h>
+#include <stdio.h>
+#include <string.h>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+#include "SimHost.h"
+
+namespace {
+std::map<std::string, std::vector<uint8_t>> s_nvs;
+std::string s_file;
+
+// Format: je Eintrag <Schlüssel-Länge u16><Schlüssel><Länge u16><Bytes>
+void save(){
+  if (s_file.empty()) return;
+  FILE* f = fopen(s_file.c_str(), "wb");
+  if (!f) return;
+  for (const auto& e : s_nvs) {
+    const uint16_t kl = (uint16_t)e.first.size(), vl = (uint16_t)e.second.size();
+    fwrite(&kl, 2, 1, f);
+    fwrite(e.first.data(), 1, kl, f);
+    fwrite(&vl, 2, 1, f);
+    fwrite(e.second.data(), 1, vl, f);
+  }
+  fclose(f);
+}
+}  // namespace
+
+namespace sim {
+bool nvsFile(const char* path){
+  HeapQuiet q;
+  s_file = path ? path : "";
+  s_nvs.clear();
+  FILE* f = s_file.empty() ? nullptr : fopen(s_file.c_str(), "rb");
+  if (!f) return true;                       // neu: leerer NVS
+  uint16_t kl, vl;
+  while (fread(&kl, 2, 1, f) == 1) {
+    std::string k(kl, '\0');
+    if (fread(&k[0], 1, kl, f) != kl || fread(&vl, 2, 1, f) != 1) break;
+    std::vector<uint8_t> v(vl);
+    if (fread(v.data(), 1, vl, f) != vl) break;
+    s_nvs[k] = std::move(v);
+  }
+  fclose(f);
+  return true;
+}
+}  // namespace sim
+
+bool Preferences::begin(const char* name, bool readOnly, const char*){
+  if (!name || !*name) return false;
+  _ns = name;
+  _open = true;
+  _readOnly = readOnly;
+  return true;
+}
+
+void Preferences::end(){ _open = false; }
+
+bool Preferences::clear(){
+  if (!_open || _readOnly) return false;
+  const std::string prefix = _ns + "/";
+  for (auto it = s_nvs.begin(); it != s_nvs.end();)
+    it = it->first.compare(0, prefix.size(), prefix) == 0 ? s_nvs.erase(it) : std::next(it);
+  save();
+  return true;
+}
+
+bool Preferences::remove(const char* key){
+  if (!_open || _readOnly) return false;
+  const bool found = s_nvs.erase(_ns + "/" + key) > 0;
+  if (found) save();
+  return found;
+}
+
+size_t Preferences::getBytesLength(const char* key){
+  if (!_open) return 0;
+  const auto it = s_nvs.find(_ns + "/" + key);
+  return it == s_nvs.end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen){
+  if (!_open || !buf) return 0;
+  const auto it = s_nvs.find(_ns + "/" + key);
+  if (it == s_nvs.end() || it->second.size() > maxLen) return 0;
+  memcpy(buf, it->second.data(), it->second.size());
+  return it->second.size();
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len){
+  if (!_open || _readOnly || !value || len > 0xFFFF) return 0;
+  s_nvs[_ns + "/" + key].assign((const uint8_t*)value, (const uint8_t*)value + len);
+  save();
+  return len;
+}
@@ -0,0 +1,337 @@
+// ============================================================================
+// File: tools/hostsim/SimUart.cpp
+// ----------------------------------------------------------------------------
+// Purpose: HardwareSerial in virtueller Zeit
+//  • TX: Zeichen verlassen den Ring im Zeichentakt (Start/Daten/Parität/
+//    Stopp); write() wartet nur, wenn der Ring voll ist
+//  • RX: Ankunft im Zeichentakt, Ereignis bei FIFO-Schwelle bzw. nach
+//    _rxTimeoutSym ruhigen Zeichenzeiten; Callbacks im Task "uart_event"
+//  • --pty: Pseudo-Terminal als zweites Ende der Leitung
+//  • uartLink(): zwei Ports über Kreuz verbunden (TX des einen = RX des
+//    anderen), z.B. Modbus-Master gegen -Slave in tools/modbus_host.cpp
+// ============================================================================
+#include <HardwareSerial.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "SimHost.h"
+#include "SimKernel.h"
+
+using sim::SimCost;
+
+static constexpr size_t UART_PORTS     = 3;
+static constexpr size_t UART_FIFO      = 128;      // Hardware-FIFO ohne TX-Ring
+static constexpr int    UART_EVENT_PRIO = configMAX_PRIORITIES - 1;
+
+struct UartSim {
+  HardwareSerial* ser = nullptr;
+  sim::UartStats  stats;
+  TaskHandle_t    task = nullptr;
+  uint32_t        pendingErrors = 0;     // Ring-Überläufe für onReceiveError
+  bool            pendingData = false;
+  int             ptyMaster = -1, ptySlave = -1;
+  int             link = -1;             // Gegenstelle (uartLink)
+  bool            realtime = false;
+  uint64_t        wallStartNs = 0, simStartNs = 0;
+
+  static void taskEntry(void* arg);
+  static uint64_t rxTick(HardwareSerial* s, uint32_t gen, uint64_t now);
+  static void signal(UartSim& u);
+};
+
+static UartSim s_uart[UART_PORTS];
+
+static UartSim& simOf(const HardwareSerial* s){ return s_uart[(size_t)s->simPort() % UART_PORTS]; }
+
+HardwareSerial::HardwareSerial(int uartNum) : _port(uartNum) {
+  if ((size_t)uartNum < UART_PORTS) s_uart[uartNum].ser = this;
+}
+
+// Start + 8 Daten + Parität + Stopp
+uint64_t HardwareSerial::charNs() const {
+  const uint32_t parity = (_config & 0x3) >= 2 ? 1 : 0;
+  const uint32_t stop   = (_config & 0x30) == 0x30 ? 2 : 1;
+  const uint64_t bits   = 1 + 8 + parity + stop;
+  return _baud ? bits * 1000000000ull / _baud : 0;
+}
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin, bool invert,
+                           unsigned long timeoutMs, uint8_t rxfifoFull){
+  (void)rxPin; (void)txPin; (void)invert; (void)timeoutMs;
+  _baud     = baud;
+  _config   = config;
+  _fifoFull = rxfifoFull > 127 ? 127 : rxfifoFull;
+  _open     = true;
+  _rx.clear();
+  _line.clear();
+  _sinceEvent = 0;
+  _txDoneNs = sim::nowNs();
+  _rxGen++;
+}
+
+// Wie Arduino-Kern 2.x: fullyTerminate löst auch die Callbacks
+void HardwareSerial::end(bool fullyTerminate){
+  flush();
+  _open = false;
+  _rx.clear();
+  _line.clear();
+  _rxGen++;
+  if (fullyTerminate) {
+    _onRx  = nullptr;
+    _onErr = nullptr;
+  }
+}
+
+void HardwareSerial::updateBaudRate(unsigned long baud){ _baud = baud; }
+
+size_t HardwareSerial::setRxBufferSize(size_t n){
+  if (_open) return 0;                  // nur vor begin()
+  _rxCap = n;
+  return n;
+}
+
+size_t HardwareSerial::setTxBufferSize(size_t n){
+  if (_open) return 0;
+  _txCap = n;
+  return n;
+}
+
+bool HardwareSerial::setPins(int8_t rx, int8_t tx, int8_t cts, int8_t rts){
+  (void)rx; (void)tx; (void)cts; (void)rts;
+  return _open;
+}
+
+bool HardwareSerial::setMode(uint8_t mode){ (void)mode; return _open; }
+
+bool HardwareSerial::setRxTimeout(uint8_t symbols){
+  _rxTimeoutSym = symbols ? symbols : 1;
+  return true;
+}
+
+bool HardwareSerial::setRxFIFOFull(uint8_t bytes){
+  _fifoFull = bytes > 127 ? 127 : (bytes ? bytes : 1);
+  return true;
+}
+
+void HardwareSerial::onReceive(OnReceiveCb cb, bool onlyOnTimeout){
+  _onRx = cb;
+  _onlyOnTimeout = onlyOnTimeout;
+  UartSim& u = simOf(this);
+  if (cb && !u.task)
+    xTaskCreatePinnedToCore(UartSim::taskEntry, "uart_event", 2048, &u, UART_EVENT_PRIO, &u.task, tskNO_AFFINITY);
+}
+
+void HardwareSerial::onReceiveError(OnReceiveErrorCb cb){ _onErr = cb; }
+
+// ---------------------------- RX ---------------------------------------------
+int HardwareSerial::available(){ return (int)_rx.size(); }
+
+int HardwareSerial::read(){
+  if (_rx.empty()) return -1;
+  const uint8_t c = _rx.front();
+  _rx.pop_front();
+  return c;
+}
+
+size_t HardwareSerial::read(uint8_t* buf, size_t n){
+  size_t i = 0;
+  while (i < n && !_rx.empty()) { buf[i++] = _rx.front(); _rx.pop_front(); }
+  return i;
+}
+
+void HardwareSerial::simInject(const uint8_t* data, size_t n){
+  if (!_open || !_baud || n == 0) return;
+  const uint64_t now = sim::nowNs();
+  if (_line.empty()) {
+    const uint64_t earliest = _lastRxNs + charNs();
+    _lineNextNs = (now + charNs() > earliest ? now + charNs() : earliest);
+  }
+  _line.insert(_line.end(), data, data + n);
+  const uint32_t gen = ++_rxGen;
+  sim::at(_lineNextNs, [this, gen](uint64_t t){ return UartSim::rxTick(this, gen, t); });
+}
+
+// Angekommene Zeichen in den Treiber-Ring
+void HardwareSerial::deliverArrived(){
+  UartSim& u = simOf(this);
+  const uint64_t now = sim::nowNs(), cn = charNs();
+  while (!_line.empty() && _lineNextNs <= now) {
+    if (_rx.size() >= _rxCap) {
+      u.pendingErrors++;
+      u.stats.rxOverflows++;
+    } else {
+      _rx.push_back(_line.front());
+    }
+    _line.pop_front();
+    u.stats.rxBytes++;
+    _lastRxNs = _lineNextNs;
+    _lineNextNs += cn;
+    _sinceEvent++;
+  }
+}
+
+void UartSim::signal(UartSim& u){
+  u.pendingData = true;
+  if (u.task) vTaskNotifyGiveFromISR(u.task, nullptr);
+}
+
+uint64_t UartSim::rxTick(HardwareSerial* s, uint32_t gen, uint64_t now){
+  (void)now;
+  if (gen != s->_rxGen || !s->_open) return sim::NEVER;
+  UartSim& u = simOf(s);
+  s->deliverArrived();
+  const uint64_t cn = s->charNs();
+  if (s->_sinceEvent >= s->_fifoFull) {            // FIFO-Schwelle
+    s->_sinceEvent = 0;
+    if (!s->_onlyOnTimeout || u.pendingErrors) signal(u);
+  }
+  if (s->_line.empty()) {
+    const uint64_t tmo = s->_lastRxNs + (uint64_t)s->_rxTimeoutSym * cn;
+    if (sim::nowNs() < tmo) return tmo;
+    if (s->_sinceEvent || !s->_onlyOnTimeout) signal(u);   // RX-Timeout = Frame-Ende
+    s->_sinceEvent = 0;
+    return sim::NEVER;
+  }
+  const size_t toFifo = s->_fifoFull - s->_sinceEvent;
+  const size_t k = toFifo < s->_line.size() ? toFifo : s->_line.size();
+  return s->_lineNextNs + (uint64_t)(k - 1) * cn;
+}
+
+void UartSim::taskEntry(void* arg){
+  UartSim& u = *static_cast<UartSim*>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    HardwareSerial* s = u.ser;
+    if (!s) continue;
+    while (u.pendingErrors) {
+      u.pendingErrors--;
+      if (s->_onErr) s->_onErr(UART_BUFFER_FULL_ERROR);
+    }
+    if (u.pendingData) {
+      u.pendingData = false;
+      u.stats.rxEvents++;
+      if (s->_onRx) s->_onRx();
+    }
+  }
+}
+
+// ---------------------------- TX ---------------------------------------------
+int HardwareSerial::availableForWrite(){
+  const uint64_t now = sim::nowNs(), cn = charNs();
+  const size_t cap = _txCap ? _txCap : UART_FIFO;
+  const size_t pending = (_txDoneNs > now && cn) ? (size_t)((_txDoneNs - now + cn - 1) / cn) : 0;
+  return pending >= cap ? 0 : (int)(cap - pending);
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t n){
+  if (!_open || !_baud) return 0;
+  sim::charge(SimCost::UART_CALL_NS);
+  UartSim& u = simOf(this);
+  const uint64_t cn = charNs();
+  const size_t cap = _txCap ? _txCap : UART_FIFO;
+  size_t left = n;
+  while (left) {
+    const uint64_t now = sim::nowNs();
+    if (_txDoneNs < now) _txDoneNs = now;
+    const size_t room = (size_t)availableForWrite();
+    if (room == 0) {                               // Ring voll: auf ein Zeichen warten
+      sim::sleepFor(_txDoneNs - now - (uint64_t)(cap - 1) * cn);
+      continue;
+    }
+    const size_t chunk = left < room ? left : room;
+    _txDoneNs += (uint64_t)chunk * cn;
+    left -= chunk;
+  }
+  u.stats.txBytes += n;
+  // Gegenstelle: Ankunft ab jetzt im Zeichentakt, hinter noch laufenden Zeichen
+  if (u.link >= 0 && s_uart[u.link].ser) s_uart[u.link].ser->simInject(buf, n);
+  if (u.ptyMaster >= 0 && ::write(u.ptyMaster, buf, n) < 0) { /* Gegenstelle weg: verwerfen */ }
+  return n;
+}
+
+void HardwareSerial::flush(){
+  const uint64_t now = sim::nowNs();
+  if (_txDoneNs > now) sim::sleepFor(_txDoneNs - now);
+}
+
+esp_err_t uart_wait_tx_done(uart_port_t port, TickType_t ticks){
+  if ((size_t)port >= UART_PORTS || !s_uart[port].ser) return ESP_ERR_INVALID_ARG;
+  HardwareSerial* s = s_uart[port].ser;
+  const uint64_t now = sim::nowNs();
+  if (s->simTxDoneNs() <= now) return ESP_OK;
+  if (ticks == 0) return ESP_ERR_TIMEOUT;
+  const uint64_t limit = ticks == portMAX_DELAY ? sim::NEVER : now + (uint64_t)ticks * sim::TICK_NS;
+  if (s->simTxDoneNs() > limit) { sim::sleepFor(limit - now); return ESP_ERR_TIMEOUT; }
+  sim::sleepFor(s->simTxDoneNs() - now);
+  return ESP_OK;
+}
+
+// Einzelner Teilnehmer am Bus: keine Kollisionen
+esp_err_t uart_get_collision_flag(uart_port_t port, bool* flag){
+  if ((size_t)port >= UART_PORTS || !flag) return ESP_ERR_INVALID_ARG;
+  *flag = false;
+  return ESP_OK;
+}
+
+// ---------------------------- Steuerung --------------------------------------
+static uint64_t wallNs(){
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+namespace sim {
+
+HardwareSerial* uart(int port){ return (size_t)port < UART_PORTS ? s_uart[port].ser : nullptr; }
+
+UartStats uartStats(int port){ return (size_t)port < UART_PORTS ? s_uart[port].stats : UartStats{}; }
+
+void uartInject(int port, const uint8_t* data, size_t n){
+  if ((size_t)port < UART_PORTS && s_uart[port].ser) s_uart[port].ser->simInject(data, n);
+}
+
+void uartLink(int a, int b){
+  if ((size_t)a >= UART_PORTS || (size_t)b >= UART_PORTS || a == b) return;
+  s_uart[a].link = b;
+  s_uart[b].link = a;
+}
+
+bool uartOpenPty(int port, bool realtime, std::string& slaveName){
+  if ((size_t)port >= UART_PORTS) return false;
+  UartSim& u = s_uart[port];
+  const int m = posix_openpt(O_RDWR | O_NOCTTY);
+  if (m < 0 || grantpt(m) != 0 || unlockpt(m) != 0) { if (m >= 0) close(m); return false; }
+  const char* name = ptsname(m);
+  if (!name) { close(m); return false; }
+  slaveName = name;
+  // Slave offen halten (sonst EIO ohne Gegenstelle) und roh schalten
+  const int s = open(name, O_RDWR | O_NOCTTY);
+  if (s >= 0) {
+    termios tio;
+    if (tcgetattr(s, &tio) == 0) { cfmakeraw(&tio); tcsetattr(s, TCSANOW, &tio); }
+  }
+  fcntl(m, F_SETFL, fcntl(m, F_GETFL) | O_NONBLOCK);
+  u.ptyMaster   = m;
+  u.ptySlave    = s;
+  u.realtime    = realtime;
+  u.wallStartNs = wallNs();
+  u.simStartNs  = nowNs();
+
+  // 1-ms-Abfrage im Timer-Kontext; realtime bremst auf Uhrzeit
+  at(nowNs() + 1000000, [port](uint64_t t) -> uint64_t {
+    UartSim& p = s_uart[port];
+    uint8_t buf[256];
+    const ssize_t r = ::read(p.ptyMaster, buf, sizeof(buf));
+    if (r > 0) uartInject(port, buf, (size_t)r);
+    if (p.realtime) {
+      const uint64_t simEl = t - p.simStartNs, wallEl = wallNs() - p.wallStartNs;
+      if (simEl > wallEl) usleep((useconds_t)((simEl - wallEl) / 1000));
+    }
+    return t + 1000000;
+  });
+  return true;
+}
+
+}  // namespace sim
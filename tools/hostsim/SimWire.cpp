@@ -0,0 +1,86 @@
+// ============================================================================
+// File: tools/hostsim/SimWire.cpp
+// ----------------------------------------------------------------------------
+// Übertragungszeit: der aufrufende Task wartet (sleepFor) wie auf den
+// I²C-Interrupt im IDF-Treiber, der Kern ist in der Zeit frei
+// ============================================================================
+#include <Wire.h>
+#include "SimDevices.h"
+#include "SimKernel.h"
+
+TwoWire Wire(0);
+TwoWire Wire1(1);
+
+bool TwoWire::begin(int sda, int scl, uint32_t freq){
+  (void)sda; (void)scl;
+  if (freq) _freq = freq;
+  _begun = true;
+  _begins++;
+  return true;
+}
+
+bool TwoWire::end(){
+  _begun = false;
+  return true;
+}
+
+void TwoWire::simAttach(uint8_t addr, SimI2CDevice* dev){
+  if (_devCount < sizeof(_devs) / sizeof(_devs[0])) _devs[_devCount++] = Slot{addr, dev};
+}
+
+SimI2CDevice* TwoWire::find(uint16_t addr) const {
+  for (uint8_t i = 0; i < _devCount; i++) if (_devs[i].addr == addr) return _devs[i].dev;
+  return nullptr;
+}
+
+// START + Adresse + Daten (je 9 Takte) + STOP
+void TwoWire::chargeBytes(size_t bytes){
+  sim::charge(sim::SimCost::I2C_CALL_NS);
+  sim::sleepFor(((uint64_t)(bytes + 1) * 9 + 2) * 1000000000ull / _freq);
+}
+
+void TwoWire::beginTransmission(uint16_t addr){
+  _txAddr = addr;
+  _txLen  = 0;
+}
+
+size_t TwoWire::write(uint8_t c){
+  if (_txLen >= BUF) return 0;
+  _tx[_txLen++] = c;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* buf, size_t n){
+  size_t w = 0;
+  while (w < n && write(buf[w])) w++;
+  return w;
+}
+
+// Arduino-Codes: 0 OK, 2 NACK Adresse, 3 NACK Daten, 4 Busfehler
+uint8_t TwoWire::endTransmission(bool sendStop){
+  (void)sendStop;
+  if (!_begun) return 4;
+  _transfers++;
+  if (_failCount) {
+    _failCount--;
+    chargeBytes(_txLen);
+    return _failRc;
+  }
+  SimI2CDevice* dev = find(_txAddr);
+  chargeBytes(dev ? _txLen : 0);
+  if (!dev) return 2;
+  return dev->onWrite(_tx, _txLen) ? 0 : 3;
+}
+
+size_t TwoWire::requestFrom(uint16_t addr, size_t len, bool sendStop){
+  (void)sendStop;
+  _rxLen = _rxPos = 0;
+  if (!_begun) return 0;
+  _transfers++;
+  SimI2CDevice* dev = find(addr);
+  if (len > BUF) len = BUF;
+  chargeBytes(dev ? len : 0);
+  if (!dev) return 0;
+  _rxLen = dev->onRead(_rx, len);
+  return _rxLen;
+}
@@ -0,0 +1,177 @@
+// ============================================================================
+// File: tools/hostsim/include/Arduino.h
+// ----------------------------------------------------------------------------
+// Purpose: Arduino-ESP32-Kern für den Host-Simulator (SimArduino.cpp)
+//  • millis()/micros() liefern virtuelle Zeit und kosten SimCost::TIMER_READ_NS
+//  • Serial (USB-CDC) schreibt in die Simulator-Ausgabe, Eingabe kommt
+//    aus dem Szenario (Befehl "con")
+//  • Nur was src/ benutzt; Signaturen wie im Kern 2.x
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define EXT_RAM_ATTR
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT             0x01
+#define OUTPUT            0x03
+#define PULLUP            0x04
+#define INPUT_PULLUP      0x05
+#define OPEN_DRAIN        0x10
+#define OUTPUT_OPEN_DRAIN 0x13
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define SERIAL_8N1 0x800001c
+#define SERIAL_8E1 0x800001e
+#define SERIAL_8O1 0x800001f
+#define SERIAL_8N2 0x800003c
+
+using std::min;
+using std::max;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int  digitalRead(uint8_t pin);
+inline int digitalPinToInterrupt(int pin){ return pin; }
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void* ps_malloc(size_t size);
+// ROM-printf: ohne Heap, direkt auf die Debug-UART (hier stderr)
+inline int ets_printf(const char* fmt, ...){
+  va_list ap;
+  va_start(ap, fmt);
+  const int n = vfprintf(stderr, fmt, ap);
+  va_end(ap);
+  return n;
+}
+
+template <class T, class L, class H>
+inline T constrain(T v, L lo, H hi){ return v < lo ? (T)lo : (v > hi ? (T)hi : v); }
+
+// ---------------------------- String (WString) ------------------------------
+class String {
+public:
+  String(const char* s = "") : _s(s ? s : "") {}
+  explicit String(char c, unsigned n = 1) : _s(n, c) {}
+  explicit String(int v) : _s(std::to_string(v)) {}
+  explicit String(unsigned v) : _s(std::to_string(v)) {}
+  explicit String(long v) : _s(std::to_string(v)) {}
+  explicit String(unsigned long v) : _s(std::to_string(v)) {}
+  const char* c_str() const { return _s.c_str(); }
+  unsigned length() const { return (unsigned)_s.size(); }
+  bool startsWith(const String& p) const { return _s.rfind(p._s, 0) == 0; }
+  bool endsWith(const String& p) const {
+    return _s.size() >= p._s.size() && _s.compare(_s.size() - p._s.size(), p._s.size(), p._s) == 0;
+  }
+  String substring(unsigned from) const { return from < _s.size() ? String(_s.substr(from).c_str()) : String(); }
+  String substring(unsigned from, unsigned to) const {
+    return from < _s.size() ? String(_s.substr(from, to - from).c_str()) : String();
+  }
+  int indexOf(char c) const { size_t p = _s.find(c); return p == std::string::npos ? -1 : (int)p; }
+  long toInt() const { return atol(_s.c_str()); }
+  float toFloat() const { return (float)atof(_s.c_str()); }
+  void trim();
+  void toLowerCase();
+  void remove(unsigned idx) { if (idx < _s.size()) _s.erase(idx); }
+  char operator[](unsigned i) const { return i < _s.size() ? _s[i] : 0; }
+  String& operator+=(const String& o) { _s += o._s; return *this; }
+  String& operator+=(const char* o) { _s += o; return *this; }
+  String& operator+=(char c) { _s += c; return *this; }
+  bool operator==(const String& o) const { return _s == o._s; }
+  bool operator==(const char* o) const { return _s == o; }
+  bool operator!=(const char* o) const { return _s != o; }
+  friend String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+  friend String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+  friend String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+private:
+  std::string _s;
+};
+
+// ---------------------------- Print / Stream --------------------------------
+class Print {
+public:
+  virtual ~Print() = default;
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buf, size_t n);
+  size_t write(const char* s) { return s ? write((const uint8_t*)s, strlen(s)) : 0; }
+  size_t write(const char* buf, size_t n) { return write((const uint8_t*)buf, n); }
+  size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v) { return printf("%d", v); }
+  size_t print(unsigned v) { return printf("%u", v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+  size_t println() { return write("\r\n"); }
+  template <class T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() { return -1; }
+};
+
+// USB-CDC-Konsole: Ausgabe in den Simulator-Log, Eingabe aus dem Szenario
+class HWCDC : public Stream {
+public:
+  void begin(unsigned long baud = 0) { (void)baud; }
+  void end() {}
+  operator bool() const { return true; }
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int peek() override;
+  int availableForWrite() { return 256; }
+  void setTxTimeoutMs(uint32_t) {}
+  void flush() override {}
+};
+extern HWCDC Serial;
+
+class EspClass {
+public:
+  uint32_t getCycleCount();
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getHeapSize();           // SimHeap.cpp
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  uint32_t getPsramSize() { return 8 * 1024 * 1024; }
+  uint32_t getFreePsram() { return 8 * 1024 * 1024; }
+  void restart();
+};
+extern EspClass ESP;
+
+#include "HardwareSerial.h"
@@ -0,0 +1,52 @@
+// ============================================================================
+// File: tools/hostsim/include/FS.h
+// ----------------------------------------------------------------------------
+// Dateien im Simulator: Host-Verzeichnis (--fs <dir>) statt Flash
+#pragma once
+#include <Arduino.h>
+#include <memory>
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Stream {
+public:
+  File() = default;
+  explicit File(FILE* f, const char* path);
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  size_t read(uint8_t* buf, size_t n);
+  bool seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t position() const;
+  size_t size() const;
+  void close();
+  operator bool() const { return (bool)_f; }
+  const char* name() const { return _name.c_str(); }
+private:
+  std::shared_ptr<FILE> _f;
+  std::string _name;
+};
+
+class FS {
+public:
+  File open(const char* path, const char* mode = "r", bool create = false);
+  bool exists(const char* path);
+  bool remove(const char* path);
+  size_t totalBytes() { return 1024 * 1024; }
+  size_t usedBytes() { return 0; }
+protected:
+  std::string hostPath(const char* path) const;
+  std::string _root;
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
@@ -0,0 +1,84 @@
+// ============================================================================
+// File: tools/hostsim/include/HardwareSerial.h
+// ----------------------------------------------------------------------------
+// Purpose: UART für RS485Bus im Host-Simulator (SimUart.cpp)
+//  • TX läuft mit der eingestellten Baudrate in virtueller Zeit ab
+//    (Ring RS485_TX_RING_BYTES, uart_wait_tx_done, flush)
+//  • RX: Bytes aus dem Szenario ("rs485 ...") oder vom PTY (--pty),
+//    onReceive-Callback im Task "uart_event" wie im Arduino-Kern
+//    (FIFO-Schwelle bzw. RX-Timeout in Zeichenzeiten)
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include <functional>
+#include <deque>
+#include "driver/uart.h"
+
+typedef enum {
+  UART_NO_ERROR,
+  UART_BREAK_ERROR,
+  UART_BUFFER_FULL_ERROR,
+  UART_FIFO_OVF_ERROR,
+  UART_FRAME_ERROR,
+  UART_PARITY_ERROR
+} hardwareSerial_error_t;
+
+typedef std::function<void(void)> OnReceiveCb;
+typedef std::function<void(hardwareSerial_error_t)> OnReceiveErrorCb;
+
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int uartNum);
+
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1,
+             bool invert = false, unsigned long timeoutMs = 20000UL, uint8_t rxfifoFull = 112);
+  void end(bool fullyTerminate = true);
+  void updateBaudRate(unsigned long baud);
+  uint32_t baudRate() const { return _baud; }
+
+  size_t setRxBufferSize(size_t n);
+  size_t setTxBufferSize(size_t n);
+  bool setPins(int8_t rx, int8_t tx, int8_t cts = -1, int8_t rts = -1);
+  bool setMode(uint8_t mode);
+  bool setRxTimeout(uint8_t symbols);
+  bool setRxFIFOFull(uint8_t bytes);
+  void onReceive(OnReceiveCb cb, bool onlyOnTimeout = false);
+  void onReceiveError(OnReceiveErrorCb cb);
+
+  int available() override;
+  int read() override;
+  size_t read(uint8_t* buf, size_t n);
+  int availableForWrite();
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  void flush() override;
+
+  // Simulator: Bytes "auf der Leitung" ankommen lassen (ab jetzt im Zeichentakt)
+  void simInject(const uint8_t* data, size_t n);
+  uint64_t simTxDoneNs() const { return _txDoneNs; }
+  int simPort() const { return _port; }
+
+private:
+  friend struct UartSim;
+  uint64_t charNs() const;
+  void     deliverArrived();
+
+  int           _port;
+  unsigned long _baud = 0;
+  uint32_t      _config = SERIAL_8N1;
+  bool          _open = false;
+  size_t        _rxCap = 256, _txCap = 0;
+  uint8_t       _rxTimeoutSym = 2, _fifoFull = 120;
+  bool          _onlyOnTimeout = false;
+  OnReceiveCb      _onRx;
+  OnReceiveErrorCb _onErr;
+
+  std::deque<uint8_t>  _rx;                  // im Treiber-Ring
+  std::deque<uint8_t>  _line;                // noch "unterwegs" (Ankunft im Zeichentakt)
+  uint64_t _lineNextNs = 0;                  // Ankunft des nächsten Zeichens
+  uint64_t _lastRxNs = 0;
+  size_t   _sinceEvent = 0;                  // Bytes seit letztem Callback
+  uint32_t _rxGen = 0;                       // veraltete RX-Timer erkennen
+  uint64_t _txDoneNs = 0;                    // letztes Bit draußen
+};
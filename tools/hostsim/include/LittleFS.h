@@ -0,0 +1,17 @@
+// ============================================================================
+// File: tools/hostsim/include/LittleFS.h
+// ----------------------------------------------------------------------------
+#pragma once
+#include "FS.h"
+
+namespace fs {
+class LittleFSFS : public FS {
+public:
+  bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+             const char* partitionLabel = "spiffs");
+  void end() {}
+  void simSetRoot(const char* dir) { _root = dir ? dir : ""; }
+};
+}  // namespace fs
+
+extern fs::LittleFSFS LittleFS;
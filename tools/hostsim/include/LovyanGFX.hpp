@@ -0,0 +1,164 @@
+// ============================================================================
+// File: tools/hostsim/include/LovyanGFX.hpp
+// ----------------------------------------------------------------------------
+// Purpose: LovyanGFX-kompatible Zeichenfläche für den Host-Simulator (SimGfx.cpp)
+//  • RGB565-Speicher in Panelgröße (memory_width x memory_height), Rotation
+//    wie am Gerät; Inhalt am Szenario-Ende als PPM (--ppm)
+//  • Jeder Zeichenbefehl kostet Adressfenster + 16 Bit je Pixel beim
+//    SPI-Takt freq_write (blockierend wie ohne DMA)
+//  • Text: 6x8-Zellen je Zeichen; Glyphen nur als Bitmuster des
+//    Zeichencodes (Fläche und Kosten stimmen, lesbar ist es nicht)
+//  • Clip-Rechteck (setClipRect) wie LovyanGFX: begrenzt Zeichnen, Push
+//    und Buskosten
+//  • Sprite: RGB565 byte-vertauscht im Speicher wie am Gerät, auch auf
+//    fremdem Puffer (setBuffer); pushSprite tauscht zurück
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+#include <vector>
+
+#define SPI2_HOST 1
+#define SPI3_HOST 2
+#define SPI_DMA_CH_AUTO 3
+
+enum : uint16_t {
+  TFT_BLACK = 0x0000, TFT_NAVY = 0x000F, TFT_DARKGREEN = 0x03E0, TFT_MAROON = 0x7800,
+  TFT_DARKGREY = 0x7BEF, TFT_BLUE = 0x001F, TFT_GREEN = 0x07E0, TFT_CYAN = 0x07FF,
+  TFT_RED = 0xF800, TFT_MAGENTA = 0xF81F, TFT_YELLOW = 0xFFE0, TFT_WHITE = 0xFFFF,
+  TFT_ORANGE = 0xFDA0, TFT_LIGHTGREY = 0xD69A
+};
+
+namespace fonts {
+struct IFont { uint8_t w, h; };
+extern const IFont Font0;
+}  // namespace fonts
+
+struct SimGfxStats {
+  uint32_t commands = 0;       // Zeichenbefehle (je Adressfenster)
+  uint64_t pixels = 0;         // über SPI geschrieben
+  uint64_t busyNs = 0;         // SPI-Zeit
+};
+
+class LGFX_Sprite;
+
+namespace lgfx {
+
+struct Bus_SPI {
+  struct config_t {
+    int spi_host = SPI3_HOST, spi_mode = 0;
+    uint32_t freq_write = 40000000, freq_read = 16000000;
+    bool spi_3wire = false, use_lock = true;
+    int dma_channel = SPI_DMA_CH_AUTO, pin_sclk = -1, pin_mosi = -1, pin_miso = -1, pin_dc = -1;
+  };
+  const config_t& config() const { return _cfg; }
+  void config(const config_t& c) { _cfg = c; }
+private:
+  config_t _cfg;
+};
+
+struct Panel_ST7789 {
+  struct config_t {
+    int pin_cs = -1, pin_rst = -1, pin_busy = -1;
+    int memory_width = 240, memory_height = 320, panel_width = 240, panel_height = 320;
+    int offset_x = 0, offset_y = 0, offset_rotation = 0, dummy_read_pixel = 8, dummy_read_bits = 1;
+    bool readable = true, invert = false, rgb_order = false, dlen_16bit = false, bus_shared = true;
+  };
+  const config_t& config() const { return _cfg; }
+  void config(const config_t& c) { _cfg = c; }
+  void setBus(Bus_SPI* b) { _bus = b; }
+  Bus_SPI* bus() const { return _bus; }
+private:
+  config_t _cfg;
+  Bus_SPI* _bus = nullptr;
+};
+
+class LGFXBase : public Print {
+  friend class ::LGFX_Sprite;
+public:
+  int32_t width() const { return (_rotation & 1) ? _memH : _memW; }
+  int32_t height() const { return (_rotation & 1) ? _memW : _memH; }
+  void setRotation(uint8_t r) { _rotation = r & 3; clearClipRect(); }
+  uint8_t getRotation() const { return _rotation; }
+
+  void startWrite() {}
+  void endWrite() {}
+  void waitDMA() {}
+  void fillScreen(uint32_t color) { fillRect(0, 0, width(), height(), color); }
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawPixel(int32_t x, int32_t y, uint32_t color) { fillRect(x, y, 1, 1, color); }
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) { fillRect(x, y, w, 1, color); }
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) { fillRect(x, y, 1, h, color); }
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+  void drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) { blit(x, y, w, h, data, false); }
+  void setClipRect(int32_t x, int32_t y, int32_t w, int32_t h);
+  void clearClipRect() { setClipRect(0, 0, width(), height()); }
+
+  void setTextColor(uint32_t fg) { _fg = (uint16_t)fg; _bgFill = false; }
+  void setTextColor(uint32_t fg, uint32_t bg) { _fg = (uint16_t)fg; _bg = (uint16_t)bg; _bgFill = true; }
+  void setTextSize(float s) { _textSize = s < 1.f ? 1 : (uint8_t)s; }
+  void setFont(const fonts::IFont* f) { (void)f; }
+  void setCursor(int32_t x, int32_t y) { _cx = x; _cy = y; }
+  int32_t getCursorX() const { return _cx; }
+  int32_t getCursorY() const { return _cy; }
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  uint16_t readPixel(int32_t x, int32_t y) const;
+  const std::vector<uint16_t>& simMemory() const { return _mem; }
+  int32_t simMemWidth() const { return _memW; }
+  int32_t simMemHeight() const { return _memH; }
+  const SimGfxStats& simStats() const { return _stats; }
+  bool simWritePpm(const char* path) const;       // in Anzeige-Orientierung
+
+protected:
+  void initSurface(int32_t w, int32_t h, uint32_t spiHz);
+  bool plot(int32_t x, int32_t y, uint16_t c);     // ohne Kosten, false = geclippt
+  void chargeSpi(uint64_t pixels);
+  void blit(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data, bool swapped);
+
+  std::vector<uint16_t> _mem;    // eigener Speicher (Panel, createSprite)
+  uint16_t* _px = nullptr;       // _mem oder setBuffer()
+  bool     _swap = false;        // Sprite: RGB565 byte-vertauscht
+  int32_t  _memW = 0, _memH = 0;
+  int32_t  _clipX0 = 0, _clipY0 = 0, _clipX1 = 0, _clipY1 = 0;   // logisch, exklusiv
+  uint8_t  _rotation = 0;
+  uint32_t _spiHz = 40000000;    // 0 = Sprite im RAM, keine Buskosten
+  uint16_t _fg = TFT_WHITE, _bg = TFT_BLACK;
+  bool     _bgFill = false;
+  uint8_t  _textSize = 1;
+  int32_t  _cx = 0, _cy = 0;
+  SimGfxStats _stats;
+};
+
+class LGFX_Device : public LGFXBase {
+public:
+  bool begin() { return init(); }
+  bool init();
+  void setPanel(Panel_ST7789* p) { _panel = p; }
+  void setBrightness(uint8_t b) { _brightness = b; }
+private:
+  Panel_ST7789* _panel = nullptr;
+  uint8_t _brightness = 255;
+};
+
+}  // namespace lgfx
+
+// Sprite: Fläche im RAM, pushSprite() kostet die SPI-Zeit des Ziels
+class LGFX_Sprite : public lgfx::LGFXBase {
+public:
+  explicit LGFX_Sprite(lgfx::LGFXBase* parent = nullptr) : _parent(parent) { _spiHz = 0; _swap = true; }
+  void setColorDepth(int bits) { (void)bits; }
+  void setPsram(bool on) { (void)on; }
+  void* createSprite(int32_t w, int32_t h);
+  void setBuffer(void* buffer, int32_t w, int32_t h, int bits = 16);
+  void deleteSprite() { _mem.clear(); _px = nullptr; _memW = _memH = 0; }
+  void* getBuffer() { return _px; }
+  void pushSprite(int32_t x, int32_t y) { if (_parent) pushSprite(_parent, x, y); }
+  void pushSprite(lgfx::LGFXBase* dst, int32_t x, int32_t y) {
+    dst->blit(x, y, _memW, _memH, _px, true);
+  }
+private:
+  lgfx::LGFXBase* _parent;
+};
@@ -0,0 +1,27 @@
+// ============================================================================
+// File: tools/hostsim/include/Preferences.h
+// ----------------------------------------------------------------------------
+// Purpose: Arduino-Preferences (NVS) für den Host-Simulator
+//  • Nur Bytes-Einträge (getBytes/putBytes), mehr nutzt die App nicht
+//  • Inhalt im Speicher, mit --nvs <datei> über Läufe hinweg erhalten
+// ============================================================================
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+class Preferences {
+public:
+  bool   begin(const char* name, bool readOnly = false, const char* partitionLabel = nullptr);
+  void   end();
+  bool   clear();
+  bool   remove(const char* key);
+  size_t getBytesLength(const char* key);
+  size_t getBytes(const char* key, void* buf, size_t maxLen);
+  size_t putBytes(const char* key, const void* value, size_t len);
+
+private:
+  std::string _ns;
+  bool        _open = false;
+  bool        _readOnly = false;
+};
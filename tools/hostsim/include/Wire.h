@@ -0,0 +1,67 @@
+// ============================================================================
+// File: tools/hostsim/include/Wire.h
+// ----------------------------------------------------------------------------
+// Purpose: I²C-Controller des Host-Simulators (SimWire.cpp)
+//  • Geräte hängen als Registermodell am Bus (simAttach), fehlende
+//    Adressen antworten mit NACK (endTransmission() == 2)
+//  • Jede Übertragung kostet 9 Takte je Byte + START/STOP bei der
+//    eingestellten Frequenz, gezählt auf dem Kern des aufrufenden Tasks
+//  • simFail(): die nächsten Übertragungen enden mit einem Fehlercode
+//    (Timeout, Busfehler) – für Tests der Bus-Recovery (tools/i2c_test.cpp)
+// ============================================================================
+#pragma once
+#include <Arduino.h>
+
+class SimI2CDevice;
+
+class TwoWire : public Stream {
+public:
+  explicit TwoWire(uint8_t busNum) : _num(busNum) {}
+
+  bool begin(int sda = -1, int scl = -1, uint32_t freq = 0);
+  bool end();
+  bool setClock(uint32_t freq) { _freq = freq; return true; }
+  void setTimeOut(uint16_t ms) { _timeoutMs = ms; }
+
+  void    beginTransmission(uint16_t addr);
+  uint8_t endTransmission(bool sendStop = true);
+  size_t  requestFrom(uint16_t addr, size_t len, bool sendStop = true);
+  size_t  requestFrom(int addr, int len, int sendStop) { return requestFrom((uint16_t)addr, (size_t)len, sendStop != 0); }
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buf, size_t n) override;
+  using Print::write;
+  int available() override { return (int)(_rxLen - _rxPos); }
+  int read() override { return _rxPos < _rxLen ? _rx[_rxPos++] : -1; }
+
+  // Simulator
+  void simAttach(uint8_t addr, SimI2CDevice* dev);
+  void simFail(uint8_t rc, uint32_t count) { _failRc = rc; _failCount = count; }
+  uint32_t simTransfers() const { return _transfers; }
+  uint32_t simBegins() const { return _begins; }
+
+private:
+  SimI2CDevice* find(uint16_t addr) const;
+  void chargeBytes(size_t bytes);
+
+  static constexpr size_t BUF = 128;
+  uint8_t  _num;
+  bool     _begun = false;
+  uint32_t _freq = 100000;
+  uint16_t _timeoutMs = 50;
+  uint16_t _txAddr = 0;
+  uint8_t  _tx[BUF];
+  size_t   _txLen = 0;
+  uint8_t  _rx[BUF];
+  size_t   _rxLen = 0, _rxPos = 0;
+  uint32_t _transfers = 0;
+  uint32_t _begins = 0;
+  uint8_t  _failRc = 0;
+  uint32_t _failCount = 0;
+  struct Slot { uint8_t addr; SimI2CDevice* dev; };
+  Slot     _devs[8];
+  uint8_t  _devCount = 0;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
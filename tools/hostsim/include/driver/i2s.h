@@ -0,0 +1,61 @@
+// ============================================================================
+// File: tools/hostsim/include/driver/i2s.h
+// ----------------------------------------------------------------------------
+// Purpose: I2S-Senke des Host-Simulators (SimI2S.cpp)
+//  • DMA-Ring aus dma_buf_count x dma_buf_len Samples, Abspielen im
+//    Sample-Takt der virtuellen Zeit; i2s_write blockiert bei vollem Ring
+//  • Leerlauf wird als Stille aufgezeichnet, Unterlauf als I2S_EVENT_TX_Q_OVF
+// ============================================================================
+#pragma once
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef enum { I2S_NUM_0 = 0, I2S_NUM_1 = 1 } i2s_port_t;
+typedef enum { I2S_MODE_MASTER = 1, I2S_MODE_SLAVE = 2, I2S_MODE_TX = 4, I2S_MODE_RX = 8 } i2s_mode_t;
+typedef enum { I2S_BITS_PER_SAMPLE_16BIT = 16, I2S_BITS_PER_SAMPLE_32BIT = 32 } i2s_bits_per_sample_t;
+typedef enum {
+  I2S_CHANNEL_FMT_RIGHT_LEFT = 0,
+  I2S_CHANNEL_FMT_ONLY_RIGHT = 3,
+  I2S_CHANNEL_FMT_ONLY_LEFT = 4
+} i2s_channel_fmt_t;
+typedef enum { I2S_COMM_FORMAT_STAND_I2S = 1 } i2s_comm_format_t;
+typedef enum {
+  I2S_EVENT_DMA_ERROR,
+  I2S_EVENT_TX_DONE,
+  I2S_EVENT_RX_DONE,
+  I2S_EVENT_TX_Q_OVF,
+  I2S_EVENT_RX_Q_OVF,
+  I2S_EVENT_MAX
+} i2s_event_type_t;
+typedef struct { i2s_event_type_t type; size_t size; } i2s_event_t;
+
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+#define I2S_PIN_NO_CHANGE    (-1)
+
+typedef struct {
+  i2s_mode_t            mode;
+  int                   sample_rate;
+  i2s_bits_per_sample_t bits_per_sample;
+  i2s_channel_fmt_t     channel_format;
+  i2s_comm_format_t     communication_format;
+  int                   intr_alloc_flags;
+  int                   dma_buf_count;
+  int                   dma_buf_len;
+  bool                  use_apll;
+  bool                  tx_desc_auto_clear;
+  int                   fixed_mclk;
+} i2s_config_t;
+
+typedef struct {
+  int mck_io_num;
+  int bck_io_num;
+  int ws_io_num;
+  int data_out_num;
+  int data_in_num;
+} i2s_pin_config_t;
+
+esp_err_t i2s_driver_install(i2s_port_t port, const i2s_config_t* cfg, int queueSize, void* queue);
+esp_err_t i2s_driver_uninstall(i2s_port_t port);
+esp_err_t i2s_set_pin(i2s_port_t port, const i2s_pin_config_t* pins);
+esp_err_t i2s_zero_dma_buffer(i2s_port_t port);
+esp_err_t i2s_write(i2s_port_t port, const void* src, size_t size, size_t* written, TickType_t ticks);
@@ -0,0 +1,18 @@
+// ============================================================================
+// File: tools/hostsim/include/driver/uart.h
+// ----------------------------------------------------------------------------
+#pragma once
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef int uart_port_t;
+typedef enum {
+  UART_MODE_UART = 0,
+  UART_MODE_RS485_HALF_DUPLEX = 1,
+  UART_MODE_IRDA = 2,
+  UART_MODE_RS485_COLLISION_DETECT = 3,
+  UART_MODE_RS485_APP_CTRL = 4
+} uart_mode_t;
+
+esp_err_t uart_wait_tx_done(uart_port_t port, TickType_t ticks);
+esp_err_t uart_get_collision_flag(uart_port_t port, bool* flag);
@@ -0,0 +1,13 @@
+// ============================================================================
+// File: tools/hostsim/include/esp_freertos_hooks.h
+// ----------------------------------------------------------------------------
+// Idle-Hooks laufen im Simulator, solange der Kern keinen Task hat
+// (Aufrufabstand SimCost::IDLE_HOOK_NS)
+#pragma once
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+typedef bool (*esp_freertos_idle_cb_t)();
+
+esp_err_t esp_register_freertos_idle_hook_for_cpu(esp_freertos_idle_cb_t cb, UBaseType_t cpu);
+void      esp_deregister_freertos_idle_hook_for_cpu(esp_freertos_idle_cb_t cb, UBaseType_t cpu);
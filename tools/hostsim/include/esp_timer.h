@@ -0,0 +1,7 @@
+// ============================================================================
+// File: tools/hostsim/include/esp_timer.h
+// ----------------------------------------------------------------------------
+#pragma once
+#include <stdint.h>
+
+int64_t esp_timer_get_time();      // virtuelle Zeit in µs
@@ -0,0 +1,40 @@
+// ============================================================================
+// File: tools/hostsim/include/freertos/FreeRTOS.h
+// ----------------------------------------------------------------------------
+// Purpose: FreeRTOS-Ersatz für den Host-Simulator (Implementierung: SimKernel.cpp)
+//  • Tick 1 ms, 25 Prioritäten, zwei virtuelle Kerne wie beim ESP32-S3
+//  • portENTER_CRITICAL sperrt nur den Task-Wechsel im Simulator
+// ============================================================================
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define configTICK_RATE_HZ   1000
+#define configMAX_PRIORITIES 25
+#define portTICK_PERIOD_MS   1
+#define portMAX_DELAY        0xffffffffu
+#define portNUM_PROCESSORS   2
+#define pdTRUE               1
+#define pdFALSE              0
+#define pdPASS               1
+#define pdFAIL               0
+#define pdMS_TO_TICKS(ms)    ((TickType_t)(ms))
+#define tskNO_AFFINITY       0x7FFFFFFF
+#define tskIDLE_PRIORITY     0
+
+typedef struct { int owner; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+void vPortEnterCritical(portMUX_TYPE* mux);
+void vPortExitCritical(portMUX_TYPE* mux);
+#define portENTER_CRITICAL(m)     vPortEnterCritical(m)
+#define portEXIT_CRITICAL(m)      vPortExitCritical(m)
+#define portENTER_CRITICAL_ISR(m) vPortEnterCritical(m)
+#define portEXIT_CRITICAL_ISR(m)  vPortExitCritical(m)
+
+#include "freertos/task.h"
+#include "freertos/queue.h"
@@ -0,0 +1,17 @@
+// ============================================================================
+// File: tools/hostsim/include/freertos/queue.h
+// ----------------------------------------------------------------------------
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef struct SimQueue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void          vQueueDelete(QueueHandle_t q);
+BaseType_t    xQueueSend(QueueHandle_t q, const void* item, TickType_t ticks);
+BaseType_t    xQueueSendFromISR(QueueHandle_t q, const void* item, BaseType_t* woken);
+BaseType_t    xQueueReceive(QueueHandle_t q, void* item, TickType_t ticks);
+BaseType_t    xQueueReset(QueueHandle_t q);
+UBaseType_t   uxQueueMessagesWaiting(QueueHandle_t q);
+
+#define xQueueSendToBack(q, i, t) xQueueSend(q, i, t)
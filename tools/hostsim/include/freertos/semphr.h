@@ -0,0 +1,14 @@
+// ============================================================================
+// File: tools/hostsim/include/freertos/semphr.h
+// ----------------------------------------------------------------------------
+// Semaphoren als Queue mit Elementgröße 0 (wie im Original-FreeRTOS)
+#pragma once
+#include "freertos/queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateMutex();
+#define xSemaphoreTake(s, t) xQueueReceive(s, nullptr, t)
+#define xSemaphoreGive(s)    xQueueSend(s, nullptr, 0)
+#define vSemaphoreDelete(s)  vQueueDelete(s)
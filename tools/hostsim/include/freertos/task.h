@@ -0,0 +1,26 @@
+// ============================================================================
+// File: tools/hostsim/include/freertos/task.h
+// ----------------------------------------------------------------------------
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t   xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                                     UBaseType_t prio, TaskHandle_t* out, BaseType_t core);
+BaseType_t   xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stack, void* arg,
+                         UBaseType_t prio, TaskHandle_t* out);
+void         vTaskDelete(TaskHandle_t t);
+void         vTaskDelay(TickType_t ticks);
+void         taskYIELD();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+char*        pcTaskGetName(TaskHandle_t t);
+TickType_t   xTaskGetTickCount();
+BaseType_t   xPortGetCoreID();
+
+BaseType_t   xTaskNotifyGive(TaskHandle_t t);
+void         vTaskNotifyGiveFromISR(TaskHandle_t t, BaseType_t* woken);
+uint32_t     ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks);
+
+#define portYIELD_FROM_ISR(x) (void)(x)
@@ -0,0 +1,352 @@
+// ============================================================================
+// File: tools/hostsim/main.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Simulator der kompletten App (src/ unverändert) unter Linux
+//  • App::begin()/loop() im Arduino-loopTask (Kern 1, Priorität 1), alle
+//    App-Tasks (I2C-Worker, Eingabe, Audio, Stream, ...) wie am Gerät
+//  • Fake-Peripherie: CST328 an Wire1 (INT an PIN_TOUCH_INT), QMI8658 an
+//    Wire, ST7789 als RGB565-Speicher, I2S als WAV, UART1 (RS485) optional
+//    als PTY, LittleFS als Host-Verzeichnis
+//  • Szenario (--script): Touch-, IMU-, Konsolen- und RS485-Eingaben mit
+//    Zeitstempel in ms ab Ende von setup(); ohne Skript ein Standardablauf
+//  • Am Ende: die Statistik-Befehle der App ("sched stats", "input stats",
+//    "latency", ...) plus [SIM]-Zusammenfassung je Task und Kern
+//  • --heap-check: Exit-Code 1, wenn App-Tasks nach App::begin() noch
+//    Heap anfordern (core/HeapGuard, SimHeap.cpp)
+//  • --nvs: NVS (Preferences) in einer Datei, z.B. für den Boot-Cache
+//  • --console-out: Konsolenausgabe (auch binär: stream, mirror) in eine
+//    Datei statt stdout, z.B. für tools/stream_decode und tools/mirror_view
+// Usage: hostsim [--seconds N] [--script f] [--quiet] [--cpu-scale F]
+//                [--pty] [--realtime] [--wav f] [--ppm f] [--fs dir]
+//                [--heap-check] [--nvs f] [--console-out f]
+// Build: cmake -S tools/hostsim -B build-sim && cmake --build build-sim
+// ============================================================================
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <Wire.h>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../src/app/App.h"
+#include "../../src/core/HeapGuard.h"
+#include "SimDevices.h"
+#include "SimHost.h"
+#include "SimKernel.h"
+
+static constexpr uint64_t MS = 1000000ull;
+
+// Ohne --script: Tap, Doppeltipp, Wischen, Long-Press, Zwei-Finger-Tap,
+// dazu Bewegung der IMU und ein paar Konsolen-/RS485-Zeilen
+static const char* const DEFAULT_SCRIPT =
+  "100  tap 120 160\n"
+  "600  tap 60 80\n"
+  "750  tap 62 82\n"
+  "1200 swipe 40 160 200 160 150\n"
+  "1700 swipe 120 200 120 40 200\n"
+  "2200 down 0 120 160\n"
+  "3300 up 0\n"
+  "3600 down 0 80 160\n"
+  "3600 down 1 160 160\n"
+  "3700 up 0\n"
+  "3700 up 1\n"
+  "4000 imu 0.2 -0.1 0.97 15 -5 2\n"
+  "4500 imu 0 0 1 0 0 0\n"
+  "4200 con help\n"
+  "4300 rs485 hello from sim\n"
+  "loop 5000\n";
+
+// ---------------------------- Optionen --------------------------------------
+struct Options {
+  double      seconds = 10.0;
+  std::string script;
+  bool        quiet = false;
+  double      cpuScale = 0.0;
+  bool        pty = false, realtime = false;
+  bool        heapCheck = false;       // Exit 1 bei App-Allokation nach seal()
+  std::string wav, ppm, fs, nvs, consoleOut;
+};
+
+static void usage(){
+  fprintf(stderr,
+    "usage: hostsim [--seconds N] [--script file] [--quiet] [--cpu-scale F]\n"
+    "               [--pty] [--realtime] [--wav file] [--ppm file] [--fs dir]\n"
+    "               [--heap-check] [--nvs file] [--console-out file]\n");
+}
+
+static bool parseArgs(int argc, char** argv, Options& o){
+  for (int i = 1; i < argc; i++) {
+    const std::string a = argv[i];
+    auto val = [&](const char*& out) -> bool {
+      if (i + 1 >= argc) return false;
+      out = argv[++i];
+      return true;
+    };
+    const char* v = nullptr;
+    if      (a == "--seconds"   && val(v)) o.seconds  = atof(v);
+    else if (a == "--script"    && val(v)) o.script   = v;
+    else if (a == "--cpu-scale" && val(v)) o.cpuScale = atof(v);
+    else if (a == "--wav"       && val(v)) o.wav      = v;
+    else if (a == "--ppm"       && val(v)) o.ppm      = v;
+    else if (a == "--fs"        && val(v)) o.fs       = v;
+    else if (a == "--nvs"       && val(v)) o.nvs      = v;
+    else if (a == "--console-out" && val(v)) o.consoleOut = v;
+    else if (a == "--quiet")    o.quiet    = true;
+    else if (a == "--pty")      o.pty      = true;
+    else if (a == "--realtime") o.realtime = true;
+    else if (a == "--heap-check") o.heapCheck = true;
+    else return false;
+  }
+  return o.seconds > 0;
+}
+
+// ---------------------------- Szenario --------------------------------------
+struct Step {
+  uint64_t    ms;
+  std::string op;                      // down/move/up/imu/con/rs485/rs485hex/rs485lines
+  float       v[6] = {};
+  std::string text;
+};
+
+struct Script {
+  std::vector<Step> steps;
+  uint64_t loopMs = 0;
+};
+
+// tap/swipe werden hier in down/move/up zerlegt
+static bool parseScript(const std::string& src, Script& out){
+  std::istringstream in(src);
+  std::string line;
+  int lineNo = 0;
+  while (std::getline(in, line)) {
+    lineNo++;
+    const size_t hash = line.find('#');
+    if (hash != std::string::npos) line.resize(hash);
+    std::istringstream ls(line);
+    std::string first;
+    if (!(ls >> first)) continue;
+    if (first == "loop") {
+      if (!(ls >> out.loopMs)) { fprintf(stderr, "[SIM] script:%d: loop <ms>\n", lineNo); return false; }
+      continue;
+    }
+    Step s;
+    s.ms = strtoull(first.c_str(), nullptr, 10);
+    if (!(ls >> s.op)) { fprintf(stderr, "[SIM] script:%d: Befehl fehlt\n", lineNo); return false; }
+    if (s.op == "con" || s.op == "rs485" || s.op == "rs485hex") {
+      std::getline(ls >> std::ws, s.text);
+      out.steps.push_back(s);
+      continue;
+    }
+    int n = 0;
+    while (n < 6 && ls >> s.v[n]) n++;
+    if (s.op == "tap" && n >= 2) {
+      const uint64_t hold = n >= 3 ? (uint64_t)s.v[2] : 80;
+      out.steps.push_back(Step{s.ms, "down", {0, s.v[0], s.v[1]}, ""});
+      out.steps.push_back(Step{s.ms + hold, "up", {0}, ""});
+    } else if (s.op == "swipe" && n >= 5) {
+      const uint64_t dur = (uint64_t)s.v[4];
+      out.steps.push_back(Step{s.ms, "down", {0, s.v[0], s.v[1]}, ""});
+      for (uint64_t t = 10; t < dur; t += 10) {
+        const float f = (float)t / (float)dur;
+        out.steps.push_back(Step{s.ms + t, "move", {0, s.v[0] + (s.v[2] - s.v[0]) * f, s.v[1] + (s.v[3] - s.v[1]) * f}, ""});
+      }
+      out.steps.push_back(Step{s.ms + dur, "move", {0, s.v[2], s.v[3]}, ""});
+      out.steps.push_back(Step{s.ms + dur + 10, "up", {0}, ""});
+    } else if ((s.op == "down" && n >= 3) || (s.op == "move" && n >= 3) || (s.op == "up" && n >= 1) ||
+               (s.op == "imu" && n == 6) || (s.op == "rs485lines" && n >= 2 && s.v[1] >= 2)) {
+      out.steps.push_back(s);
+    } else {
+      fprintf(stderr, "[SIM] script:%d: unbekannt oder zu wenig Werte: %s\n", lineNo, s.op.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::vector<uint8_t> parseHex(const std::string& s){
+  std::vector<uint8_t> out;
+  std::istringstream in(s);
+  std::string tok;
+  while (in >> tok) out.push_back((uint8_t)strtoul(tok.c_str(), nullptr, 16));
+  return out;
+}
+
+// ---------------------------- Simulation ------------------------------------
+static App*          s_app = nullptr;
+static Cst328Model   s_cst(PIN_TOUCH_INT);
+static Qmi8658Model  s_imu;
+static volatile bool s_setupDone = false;
+static uint64_t      s_loops = 0;
+
+static void loopTask(void*){
+  s_app->begin();
+  s_setupDone = true;
+  for (;;) {
+    s_app->loop();
+    s_loops++;
+    sim::charge(sim::SimCost::LOOP_TASK_NS);
+  }
+}
+
+static void runStep(const Step& s){
+  const uint8_t id = (uint8_t)s.v[0];
+  if      (s.op == "down") s_cst.down(id, (uint16_t)s.v[1], (uint16_t)s.v[2]);
+  else if (s.op == "move") s_cst.move(id, (uint16_t)s.v[1], (uint16_t)s.v[2]);
+  else if (s.op == "up")   s_cst.up(id);
+  else if (s.op == "imu")  s_imu.setMotion(s.v[0], s.v[1], s.v[2], s.v[3], s.v[4], s.v[5]);
+  else if (s.op == "con")  sim::consoleInject(s.text.c_str());
+  else if (s.op == "rs485") {
+    const std::string line = s.text + "\n";
+    sim::uartInject(RS485_UART_PORT, (const uint8_t*)line.data(), line.size());
+  } else if (s.op == "rs485hex") {
+    const std::vector<uint8_t> b = parseHex(s.text);
+    sim::uartInject(RS485_UART_PORT, b.data(), b.size());
+  } else if (s.op == "rs485lines") {
+    // Dauerlast: n Zeilen zu je len Byte inkl. '\n' am Stück (Baudtakt)
+    const size_t n = (size_t)s.v[0], len = (size_t)s.v[1];
+    std::vector<uint8_t> b(n * len);
+    for (size_t i = 0; i < n; i++) {
+      for (size_t k = 0; k + 1 < len; k++) b[i * len + k] = (uint8_t)"0123456789ABCDEF"[(i + k) & 15];
+      b[i * len + len - 1] = '\n';
+    }
+    sim::uartInject(RS485_UART_PORT, b.data(), b.size());
+  }
+}
+
+static void armScript(const Script& sc, uint64_t baseNs){
+  for (const Step& s : sc.steps) {
+    const uint64_t period = sc.loopMs * MS;
+    sim::at(baseNs + s.ms * MS, [s, period](uint64_t t) -> uint64_t {
+      runStep(s);
+      return period ? t + period : sim::NEVER;
+    });
+  }
+}
+
+static std::string readFile(const std::string& path){
+  FILE* f = fopen(path.c_str(), "rb");
+  if (!f) return std::string();
+  std::string s;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) s.append(buf, n);
+  fclose(f);
+  return s;
+}
+
+static double pct(uint64_t part, uint64_t whole){ return whole ? 100.0 * (double)part / (double)whole : 0.0; }
+
+int main(int argc, char** argv){
+  Options opt;
+  if (!parseArgs(argc, argv, opt)) { usage(); return 2; }
+
+  Script script;
+  std::string src = DEFAULT_SCRIPT;
+  if (!opt.script.empty()) {
+    src = readFile(opt.script);
+    if (src.empty()) { fprintf(stderr, "[SIM] Skript nicht lesbar: %s\n", opt.script.c_str()); return 2; }
+  }
+  if (!parseScript(src, script)) return 2;
+
+  sim::init(opt.cpuScale);
+  if (!opt.fs.empty()) LittleFS.simSetRoot(opt.fs.c_str());
+  if (!opt.nvs.empty()) sim::nvsFile(opt.nvs.c_str());
+  if (opt.quiet) sim::consoleSink(nullptr);
+  FILE* consoleFile = nullptr;
+  if (!opt.consoleOut.empty()) {
+    consoleFile = fopen(opt.consoleOut.c_str(), "wb");
+    if (!consoleFile) { fprintf(stderr, "[SIM] --console-out nicht schreibbar: %s\n", opt.consoleOut.c_str()); return 2; }
+    sim::consoleSink(consoleFile);
+  }
+  Wire.simAttach(Qmi8658Model::ADDR, &s_imu);
+  Wire1.simAttach(Cst328Model::ADDR, &s_cst);
+
+  const auto wall0 = std::chrono::steady_clock::now();
+  s_app = new App;
+  xTaskCreatePinnedToCore(loopTask, "loopTask", 8192, nullptr, 1, nullptr, 1);
+
+  // setup() bis zum Ende laufen lassen (Verzögerungen kosten nur virtuelle Zeit)
+  while (!s_setupDone && sim::nowNs() < 30000 * MS) sim::runUntil(sim::nowNs() + 10 * MS);
+  if (!s_setupDone) { fprintf(stderr, "[SIM] setup() nach 30 s nicht beendet\n"); fflush(stdout); _Exit(1); }
+
+  if (opt.pty) {
+    std::string name;
+    if (sim::uartOpenPty(RS485_UART_PORT, opt.realtime, name))
+      fprintf(stderr, "[SIM] RS485 (UART%d) an PTY %s\n", RS485_UART_PORT, name.c_str());
+    else
+      fprintf(stderr, "[SIM] PTY nicht verfügbar\n");
+  }
+
+  const uint64_t t0 = sim::nowNs();
+  s_cst.start();
+  armScript(script, t0);
+  sim::consoleInject("sched reset");
+  sim::consoleInject("latency reset");
+
+  const uint64_t loops0 = s_loops;
+  uint64_t idle0[sim::CORES], core0[sim::CORES];
+  for (int c = 0; c < sim::CORES; c++) { idle0[c] = sim::idleNs(c); core0[c] = sim::coreNs(c); }
+
+  const uint64_t tEnd = t0 + (uint64_t)(opt.seconds * 1e9);
+  sim::runUntil(tEnd);
+  const uint64_t loops = s_loops - loops0;
+  uint64_t busy[sim::CORES], span[sim::CORES];
+  for (int c = 0; c < sim::CORES; c++) {
+    span[c] = sim::coreNs(c) - core0[c];
+    busy[c] = span[c] - (sim::idleNs(c) - idle0[c]);
+  }
+  const double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+  // Panel wie am Szenario-Ende (gleicher Zeitpunkt wie das Ende von --console-out)
+  if (!opt.ppm.empty() && !(sim::display() && sim::display()->simWritePpm(opt.ppm.c_str())))
+    fprintf(stderr, "[SIM] PPM nicht geschrieben\n");
+
+  // Bericht: Statistik-Befehle der App, danach die Sicht des Simulators
+  sim::consoleSink(stdout);
+  if (consoleFile) fclose(consoleFile);
+  printf("\n[SIM] ---- App-Statistik nach %.1f s ----\n", opt.seconds);
+  fflush(stdout);
+  for (const char* c : {"sched stats", "input stats", "bus stats", "latency", "i2c stats",
+                        "audio stats", "rs485 stats", "cpu", "stall", "heap", "boot"})
+    sim::consoleInject(c);
+  sim::runUntil(tEnd + 200 * MS);
+  fflush(stdout);
+
+  printf("\n[SIM] ---- Simulator ----\n");
+  printf("[SIM] virtuell %.3f s, Host %.3f s (x%.1f)%s\n", opt.seconds, wallS,
+         wallS > 0 ? opt.seconds / wallS : 0.0, opt.cpuScale > 0 ? "" : ", deterministisch");
+  printf("[SIM] loop(): %llu Durchläufe (%.0f/s)\n", (unsigned long long)loops, (double)loops / opt.seconds);
+  sim::TaskInfo ti[32];
+  const size_t nt = sim::taskInfo(ti, 32);
+  for (size_t i = 0; i < nt; i++)
+    printf("[SIM] task %-12s core=%d prio=%2d run=%9.3f ms switches=%u\n", ti[i].name, ti[i].core, ti[i].prio,
+           (double)ti[i].runNs / 1e6, ti[i].switches);
+  for (int c = 0; c < sim::CORES; c++)
+    printf("[SIM] core %d busy %.1f%%\n", c, pct(busy[c], span[c]));
+
+  const sim::I2SStats a = sim::i2sStats(0);
+  printf("[SIM] i2s: rate=%u writes=%u samples=%llu nonzero=%llu peak=%d silence=%llu underruns=%u blocked=%.1f ms\n",
+         a.sampleRate, a.writes, (unsigned long long)a.samples, (unsigned long long)a.nonZero, a.peak,
+         (unsigned long long)a.silence, a.underrunEvents, (double)a.blockedNs / 1e6);
+  if (lgfx::LGFX_Device* d = sim::display()) {
+    const SimGfxStats& g = d->simStats();
+    printf("[SIM] display: %dx%d cmds=%u pixels=%llu spi=%.1f ms\n", (int)d->width(), (int)d->height(),
+           g.commands, (unsigned long long)g.pixels, (double)g.busyNs / 1e6);
+  }
+  const sim::UartStats u = sim::uartStats(RS485_UART_PORT);
+  printf("[SIM] console out=%llu B, uart%d tx=%llu rx=%llu overflows=%u rxEvents=%u\n",
+         (unsigned long long)sim::consoleBytesOut(), RS485_UART_PORT, (unsigned long long)u.txBytes,
+         (unsigned long long)u.rxBytes, u.rxOverflows, u.rxEvents);
+  printf("[SIM] i2c: Wire=%u Wire1=%u transfers, cst frames=%u irq=%u, imu bursts=%u\n",
+         Wire.simTransfers(), Wire1.simTransfers(), s_cst.frameReads(), s_cst.irqPulses(), s_imu.burstReads());
+  const sim::HeapInfo h = sim::heapInfo();
+  const uint32_t heapViolations = heapguard::violations();
+  printf("[SIM] heap: App-Allokationen nach seal()=%u, App belegt=%llu B Spitze=%llu B Blöcke=%llu"
+         " (Host gesamt %llu B)\n", heapViolations, (unsigned long long)h.appBytes,
+         (unsigned long long)h.appPeakBytes, (unsigned long long)h.appBlocks, (unsigned long long)h.usedBytes);
+
+  if (!opt.wav.empty() && !sim::i2sWriteWav(opt.wav.c_str())) fprintf(stderr, "[SIM] WAV nicht geschrieben\n");
+  fflush(stdout);
+  fflush(stderr);
+  _Exit(opt.heapCheck && heapViolations ? 1 : 0);                          // Task-Threads hängen am Staffelstab
+}
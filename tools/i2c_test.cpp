@@ -0,0 +1,242 @@
+// ============================================================================
+// File: tools/i2c_test.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Test der I²C-Transaktions-Engine (src/i2c/I2CEngine.cpp)
+//  • Läuft auf dem Fake-Kern des Host-Simulators (virtuelle Zeit, echte
+//    Tasks/Queues) gegen dessen TwoWire mit einem Skript-Gerät @0x40:
+//    protokolliert Registerzugriffe, hält den Takt (Clock-Stretching) für
+//    eine einstellbare Zeit fest; Fehlercodes über Wire.simFail()
+//  • Prüft:
+//     1) Queue: Ausführung in Einreichungsreihenfolge, volle Queue und
+//        noch laufender Deskriptor werden abgelehnt, Hochwasser
+//     2) Callback im Worker-Task mit ctx und fertigem Status/rx-Daten
+//     3) Histogramm (core/LogHistogram, log2): Buszeit im erwarteten Bucket,
+//        letzter Bucket sammelt alles darüber, Perzentile, Latenz >= Buszeit
+//     4) Recovery nach I2C_RECOVER_AFTER_ERRORS Folgefehlern (Timeout,
+//        Busfehler) mit Neustart des Controllers; NACK fehlender Geräte
+//        (Scan) und unterbrochene Fehlerfolgen lösen keine aus
+//     5) transfer() kehrt erst nach dem Ende zurück, auch wenn den Aufrufer
+//        währenddessen eine fremde Task-Notification erreicht (Touch-INT)
+// Usage: i2c_test
+// Build: cmake -S tools/hostsim -B build-sim && cmake --build build-sim
+//        (Ziel i2c_test, läuft mit ctest --test-dir build-sim)
+// ============================================================================
+#include <Arduino.h>
+#include <Wire.h>
+#include <cstdio>
+#include <cstring>
+#include "../src/i2c/I2CEngine.h"
+#include "hostsim/SimDevices.h"
+#include "hostsim/SimKernel.h"
+
+static constexpr uint8_t DEV_ADDR    = 0x40;
+static constexpr uint8_t ABSENT_ADDR = 0x41;
+
+static int g_failed = 0;
+static void check(bool ok, const char* what){
+  printf("  [%s] %s\n", ok ? " ok " : "FAIL", what);
+  if (!ok) g_failed++;
+}
+
+// Skript-Gerät: merkt sich die Register der Schreibzugriffe
+class ScriptDevice : public SimI2CDevice {
+public:
+  bool onWrite(const uint8_t* data, size_t n) override {
+    if (stretchUs) sim::sleepFor((uint64_t)stretchUs * 1000);
+    if (n && writes < sizeof(regs)) regs[writes] = data[0];
+    writes++;
+    return true;
+  }
+  size_t onRead(uint8_t* data, size_t n) override {
+    for (size_t i = 0; i < n; i++) data[i] = (uint8_t)(0xA0 + i);
+    return n;
+  }
+
+  uint32_t stretchUs = 0;
+  uint32_t writes = 0;
+  uint8_t  regs[32] = {};
+};
+
+static ScriptDevice g_dev;
+static I2CEngine    g_eng(Wire);
+static volatile bool g_done = false;
+
+// ---------------------------- 1) + 2) Queue, Callback -----------------------
+struct CallbackLog {
+  uint8_t n = 0;
+  uint8_t order[I2C_QUEUE_DEPTH + 1] = {};
+  bool    inWorker = true;
+  bool    statusOk = true;
+  bool    rxReady = true;
+};
+
+static void onDone(I2CTransaction& t, void* ctx){
+  CallbackLog& log = *static_cast<CallbackLog*>(ctx);
+  if (log.n < sizeof(log.order)) log.order[log.n] = t.reg[0];
+  log.n++;
+  log.inWorker &= strcmp(pcTaskGetName(xTaskGetCurrentTaskHandle()), "i2ct") == 0;
+  log.statusOk &= t.status == I2CStatus::Ok;
+  if (t.rx) log.rxReady &= t.rx[0] == 0xA0 && t.rx[t.rxLen - 1] == (uint8_t)(0xA0 + t.rxLen - 1);
+}
+
+static void testQueue(){
+  printf("\n1) Reihenfolge, Hochwasser  2) Callback\n");
+  static I2CTransaction t[I2C_QUEUE_DEPTH + 1];
+  static uint8_t rx[I2C_QUEUE_DEPTH + 1][4];
+  static CallbackLog log;
+  const uint8_t one = 0x55;
+
+  // Testtask hat höhere Priorität als der Worker (gleicher Kern): die
+  // Queue füllt sich, bevor der erste Deskriptor läuft
+  g_eng.resetStats();
+  g_dev.writes = 0;
+  uint8_t accepted = 0;
+  for (uint8_t i = 0; i <= I2C_QUEUE_DEPTH; i++) {
+    t[i] = (i & 1) ? I2CTransaction::readReg8(DEV_ADDR, i, rx[i], sizeof(rx[i]))
+                   : I2CTransaction::writeReg8(DEV_ADDR, i, &one, 1);
+    t[i].cb  = onDone;
+    t[i].ctx = &log;
+    if (g_eng.submit(t[i])) accepted++;
+  }
+  const bool pendingRejected = !g_eng.submit(t[0]);
+  const I2CStats& s = g_eng.stats();
+  check(accepted == I2C_QUEUE_DEPTH, "volle Queue: Deskriptor I2C_QUEUE_DEPTH+1 abgelehnt");
+  check(t[I2C_QUEUE_DEPTH].status == I2CStatus::Idle, "abgelehnter Deskriptor wieder Idle");
+  check(pendingRejected, "noch Pending: erneutes submit abgelehnt");
+  check(s.rejected == 2, "rejected zählt beide Ablehnungen");
+  check(s.queueHigh == I2C_QUEUE_DEPTH, "Hochwasser = Queue-Tiefe");
+
+  vTaskDelay(pdMS_TO_TICKS(50));
+  bool inOrder = log.n == I2C_QUEUE_DEPTH && g_dev.writes == I2C_QUEUE_DEPTH;
+  for (uint8_t i = 0; i < I2C_QUEUE_DEPTH && inOrder; i++) inOrder = log.order[i] == i && g_dev.regs[i] == i;
+  printf("  callbacks=%u ok=%u queueHigh=%u\n", log.n, s.ok, s.queueHigh);
+  check(inOrder, "Bus und Callbacks in Einreichungsreihenfolge");
+  check(log.inWorker, "Callback läuft im Worker-Task");
+  check(log.statusOk && log.rxReady, "Callback sieht Status Ok und die rx-Daten");
+  check(g_eng.queueDepth() == 0 && s.ok == I2C_QUEUE_DEPTH, "Queue leer, alle Ok");
+}
+
+// ---------------------------- 3) Histogramm ---------------------------------
+static uint8_t populated(const uint32_t* h, uint32_t& total){
+  uint8_t buckets = 0;
+  total = 0;
+  for (uint8_t i = 0; i < I2C_HIST_BUCKETS; i++) { total += h[i]; if (h[i]) buckets++; }
+  return buckets;
+}
+
+static void testHistogram(){
+  printf("\n3) Histogramm (Bucket i: 2^(i-1) .. 2^i - 1 us)\n");
+  const uint8_t one = 0x55;
+  I2CTransaction t = I2CTransaction::writeReg8(DEV_ADDR, 0x10, &one, 1);
+  g_eng.resetStats();
+
+  // Stretch mittig in die Buckets legen: Protokoll-Overhead ~100 us
+  g_dev.stretchUs = 300;     for (int i = 0; i < 4; i++) g_eng.transfer(t);   // 256..511
+  g_dev.stretchUs = 3000;    for (int i = 0; i < 3; i++) g_eng.transfer(t);   // 2048..4095
+  g_dev.stretchUs = 200000;  g_eng.transfer(t);                               // > 65 ms: letzter
+  g_dev.stretchUs = 0;
+
+  const I2CStats& s = g_eng.stats();
+  uint32_t xferTotal, latTotal;
+  const uint8_t xferBuckets = populated(s.xfer.bins, xferTotal);
+  populated(s.latency.bins, latTotal);
+  g_eng.printStats(Serial);
+  check(s.xfer.bins[9] == 4, "300 us -> Bucket 9 (256..511)");
+  check(s.xfer.bins[12] == 3, "3 ms -> Bucket 12 (2048..4095)");
+  check(s.xfer.bins[I2C_HIST_BUCKETS - 1] == 1, "200 ms -> letzter Bucket (Sättigung)");
+  check(xferBuckets == 3 && xferTotal == 8 && latTotal == 8, "jeder Transfer genau einmal gezählt");
+  check(s.xfer.percentile(0.50f) == 511 && s.xfer.percentile(0.80f) == 4095, "p50/p80 = Bucket-Obergrenze");
+  check(s.xfer.percentile(1.0f) == s.xfer.max && s.xfer.max >= 200000, "p100 im gesättigten Bucket = max");
+
+  // Latenz = submit -> done enthält die Buszeit: kumuliert nie vor xfer
+  bool latAfterXfer = true;
+  uint32_t cx = 0, cl = 0;
+  for (uint8_t i = 0; i < I2C_HIST_BUCKETS; i++) { cx += s.xfer.bins[i]; cl += s.latency.bins[i]; latAfterXfer &= cl <= cx; }
+  check(latAfterXfer, "Latenz-Verteilung liegt nicht unter der Buszeit");
+}
+
+// ---------------------------- 4) Recovery -----------------------------------
+static void testRecovery(){
+  printf("\n4) Recovery nach %u Folgefehlern\n", I2C_RECOVER_AFTER_ERRORS);
+  const uint8_t one = 0x55;
+  I2CTransaction ok     = I2CTransaction::writeReg8(DEV_ADDR, 0x20, &one, 1);
+  I2CTransaction absent = I2CTransaction::writeReg8(ABSENT_ADDR, 0x20, &one, 1);
+  const I2CStats& s = g_eng.stats();
+  g_eng.resetStats();
+  const uint32_t begins0 = Wire.simBegins();
+
+  for (int i = 0; i < 5; i++) g_eng.transfer(absent);
+  check(s.nack == 5 && s.recoveries == 0, "5x NACK (fehlendes Gerät, Scan): keine Recovery");
+
+  Wire.simFail(5, I2C_RECOVER_AFTER_ERRORS - 1);
+  for (int i = 0; i < I2C_RECOVER_AFTER_ERRORS - 1; i++) g_eng.transfer(ok);
+  const bool midOk = g_eng.transfer(ok);
+  Wire.simFail(5, I2C_RECOVER_AFTER_ERRORS - 1);
+  for (int i = 0; i < I2C_RECOVER_AFTER_ERRORS - 1; i++) g_eng.transfer(ok);
+  check(midOk && s.recoveries == 0, "Fehlerfolge durch Ok unterbrochen: keine Recovery");
+
+  Wire.simFail(5, 1);
+  const bool third = g_eng.transfer(ok);
+  check(!third && s.recoveries == 1, "Timeout Nr. 3 in Folge: Recovery");
+  check(Wire.simBegins() == begins0 + 1, "Controller neu gestartet (Wire.begin)");
+  check(g_eng.transfer(ok), "Bus danach wieder nutzbar");
+
+  Wire.simFail(4, I2C_RECOVER_AFTER_ERRORS);
+  for (int i = 0; i < I2C_RECOVER_AFTER_ERRORS; i++) g_eng.transfer(ok);
+  printf("  ok=%u nack=%u timeout=%u err=%u recover=%u\n", s.ok, s.nack, s.timeouts, s.errors, s.recoveries);
+  check(s.recoveries == 2 && s.errors == I2C_RECOVER_AFTER_ERRORS, "3x Busfehler: zweite Recovery");
+  check(s.timeouts == 2 * (I2C_RECOVER_AFTER_ERRORS - 1) + 1, "Timeouts gezählt");
+}
+
+// ---------------------------- 5) fremde Notification -----------------------
+static TaskHandle_t g_tester = nullptr;
+
+static void notifier(void*){
+  vTaskDelay(pdMS_TO_TICKS(2));              // mitten in den 5-ms-Transfer
+  xTaskNotifyGive(g_tester);                 // wie CST328Touch::onIntISR
+  vTaskDelete(nullptr);
+}
+
+static void testForeignNotify(){
+  printf("\n5) Fremde Notification während transfer()\n");
+  const uint8_t one = 0x55;
+  I2CTransaction t = I2CTransaction::writeReg8(DEV_ADDR, 0x30, &one, 1);
+  g_tester = xTaskGetCurrentTaskHandle();
+  g_dev.stretchUs = 5000;
+  g_dev.writes = 0;
+  xTaskCreatePinnedToCore(notifier, "irq", 2048, nullptr, I2C_TASK_PRIORITY + 2, nullptr, 1);
+  const uint32_t t0 = micros();
+  const bool ok = g_eng.transfer(t);
+  const uint32_t us = micros() - t0;
+  g_dev.stretchUs = 0;
+  printf("  transfer %u us, status=%u\n", us, (unsigned)t.status);
+  check(ok && t.status == I2CStatus::Ok && g_dev.writes == 1, "transfer() wartet auf das Ende, nicht auf die Notification");
+  check(us >= 5000, "Rückkehr erst nach der Buszeit");
+  check(ulTaskNotifyTake(pdTRUE, 0) == 1, "Notification bleibt dem Aufrufer erhalten");
+}
+
+static void testTask(void*){
+  if (!g_eng.begin("i2ct", 1, 2, I2C_FREQ_HZ, 0)) {
+    check(false, "I2CEngine::begin");
+  } else {
+    testQueue();
+    testHistogram();
+    testRecovery();
+    testForeignNotify();
+  }
+  g_done = true;
+  for (;;) vTaskDelay(portMAX_DELAY);
+}
+
+int main(){
+  sim::init(0.0);
+  Wire.simAttach(DEV_ADDR, &g_dev);
+  // Worker läuft mit I2C_TASK_PRIORITY auf Kern 0, der Test darüber
+  xTaskCreatePinnedToCore(testTask, "test", 8192, nullptr, I2C_TASK_PRIORITY + 1, nullptr, 0);
+  while (!g_done && sim::nowNs() < 10000000000ull) sim::runUntil(sim::nowNs() + 10000000ull);
+  check(g_done, "Test in 10 s virtueller Zeit beendet");
+
+  printf("\n%s (%d Fehler)\n", g_failed ? "FEHLER" : "OK", g_failed);
+  fflush(stdout);
+  _Exit(g_failed ? 1 : 0);
+}
@@ -0,0 +1,218 @@
+// ============================================================================
+// File: tools/linkbench_host.cpp
+// ----------------------------------------------------------------------------
+// Purpose: RS485-Streckentest (src/comm/LinkBench.cpp) unter Linux
+//  pty   [--flip <rate>]        Master + Peer in einem Prozess über ein
+//                               Pseudo-Terminal-Paar; Leitungszeit wird aus
+//                               der Baudrate nachgebildet, --flip kippt
+//                               zufällige Bits (CRC-Zählung prüfen)
+//  master <tty> [baud...]       gegen ein Gerät mit "rs485bench peer"
+//  peer   <tty>                 Gegenstelle für "rs485bench run" am Gerät
+// Startbaudrate jeweils 115200 (wie RS485Bus::begin in App.cpp).
+// Build: g++ -O2 -std=c++17 tools/linkbench_host.cpp src/comm/LinkBench.cpp src/comm/TelemetryProto.cpp -o linkbench_host
+// ============================================================================
+#include "../src/comm/LinkBench.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <random>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+static uint32_t hostMicros(){
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static speed_t toSpeed(uint32_t baud){
+  switch (baud) {
+    case 9600:   return B9600;
+    case 19200:  return B19200;
+    case 38400:  return B38400;
+    case 57600:  return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 460800: return B460800;
+    case 921600: return B921600;
+    default:     return B115200;
+  }
+}
+
+// TTY oder PTY als Transport. pace=true bildet die Leitung nach (ein PTY
+// überträgt sonst beliebig schnell): Frames werden erst nach ihrer Leitungszeit
+// geschrieben, der Sendepuffer ist wie auf dem Gerät begrenzt.
+class PosixTransport : public BenchTransport {
+public:
+  PosixTransport(int fd, bool pace, double flipRate, uint32_t seed)
+    : _fd(fd), _pace(pace), _flip(flipRate), _rng(seed), _busyUntil(hostMicros()) {}
+
+  bool send(const uint8_t* data, size_t len) override {
+    pump();
+    if (_pace && _queuedBytes + len > TX_BUFFER_BYTES) return false;
+    std::vector<uint8_t> buf(data, data + len);
+    if (_flip > 0) {
+      std::uniform_real_distribution<double> u(0, 1);
+      for (auto& b : buf) if (u(_rng) < _flip) b ^= (uint8_t)(1u << (_rng() % 8));
+    }
+    if (!_pace) { writeAll(buf); return true; }
+    const uint32_t now = hostMicros();
+    const uint32_t start = (int32_t)(_busyUntil - now) > 0 ? _busyUntil : now;
+    _busyUntil = start + (uint32_t)((uint64_t)len * 10u * 1000000u / _baud);
+    _queuedBytes += len;
+    _line.push_back({_busyUntil, std::move(buf)});
+    return true;
+  }
+
+  size_t receive(uint8_t* out, size_t cap) override {
+    pump();
+    uint8_t tmp[4096];
+    ssize_t n;
+    while ((n = read(_fd, tmp, sizeof(tmp))) > 0) _rx.insert(_rx.end(), tmp, tmp + n);
+    while (true) {
+      auto it = std::find(_rx.begin(), _rx.end(), (uint8_t)0);
+      if (it == _rx.end()) return 0;
+      size_t len = (size_t)(it - _rx.begin());
+      bool fits = len > 0 && len <= cap;
+      if (fits) memcpy(out, _rx.data(), len);
+      _rx.erase(_rx.begin(), it + 1);
+      if (fits) return len;            // leere/zu lange Frames verwerfen
+    }
+  }
+
+  bool txIdle() override {
+    pump();
+    if (_pace) return _line.empty();
+    int q = 0;
+    return ioctl(_fd, TIOCOUTQ, &q) != 0 || q == 0;
+  }
+
+  void setBaud(uint32_t baud) override {
+    _baud = baud;
+    termios tio;
+    if (tcgetattr(_fd, &tio) != 0) return;
+    cfsetispeed(&tio, toSpeed(baud));
+    cfsetospeed(&tio, toSpeed(baud));
+    tcsetattr(_fd, TCSANOW, &tio);
+  }
+
+  uint32_t nowUs() override { return hostMicros(); }
+
+private:
+  static constexpr size_t TX_BUFFER_BYTES = 512;   // wie RS485_TX_RING_BYTES
+
+  struct Pending { uint32_t doneUs; std::vector<uint8_t> bytes; };
+
+  // Frames ausliefern, deren letztes Byte "auf der Leitung" angekommen ist
+  void pump(){
+    const uint32_t now = hostMicros();
+    while (!_line.empty() && (int32_t)(now - _line.front().doneUs) >= 0) {
+      writeAll(_line.front().bytes);
+      _queuedBytes -= _line.front().bytes.size();
+      _line.pop_front();
+    }
+  }
+
+  void writeAll(const std::vector<uint8_t>& buf){
+    size_t off = 0;
+    while (off < buf.size()) {
+      ssize_t w = write(_fd, buf.data() + off, buf.size() - off);
+      if (w > 0) off += (size_t)w;
+      else usleep(100);
+    }
+  }
+
+  int _fd;
+  bool _pace;
+  double _flip;
+  std::mt19937 _rng;
+  uint32_t _baud = 115200;
+  uint32_t _busyUntil;             // Ende der Leitungsbelegung (Mikrosekunden, umlaufend)
+  size_t _queuedBytes = 0;
+  std::deque<Pending> _line;
+  std::vector<uint8_t> _rx;
+};
+
+static bool makeRaw(int fd){
+  termios tio;
+  if (tcgetattr(fd, &tio) != 0) return false;
+  cfmakeraw(&tio);
+  tio.c_cc[VMIN]  = 0;
+  tio.c_cc[VTIME] = 0;
+  return tcsetattr(fd, TCSANOW, &tio) == 0;
+}
+
+static int openTty(const char* path){
+  int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (fd < 0) { perror(path); return -1; }
+  if (!makeRaw(fd)) { perror("tcsetattr"); close(fd); return -1; }
+  return fd;
+}
+
+static void printLine(const char* line, void*){ printf("[BENCH] %s\n", line); fflush(stdout); }
+
+static int runPty(double flip){
+  int m = posix_openpt(O_RDWR | O_NOCTTY);
+  if (m < 0 || grantpt(m) != 0 || unlockpt(m) != 0) { perror("posix_openpt"); return 1; }
+  int s = openTty(ptsname(m));
+  if (s < 0) return 1;
+  fcntl(m, F_SETFL, fcntl(m, F_GETFL) | O_NONBLOCK);
+  makeRaw(m);
+
+  PosixTransport tm(m, true, flip, 1), ts(s, true, flip, 2);
+  LinkBench bench;
+  LinkBenchPeer peer;
+  bench.begin(tm, printLine, nullptr);
+  peer.begin(ts, 115200);
+  LinkBenchConfig cfg;
+  bench.start(cfg);
+  while (bench.running()) {
+    bench.poll();
+    peer.poll();
+    usleep(50);
+  }
+  close(s);
+  close(m);
+  return 0;
+}
+
+int main(int argc, char** argv){
+  if (argc >= 2 && !strcmp(argv[1], "pty")) {
+    double flip = (argc >= 4 && !strcmp(argv[2], "--flip")) ? atof(argv[3]) : 0.0;
+    return runPty(flip);
+  }
+  if (argc >= 3 && !strcmp(argv[1], "master")) {
+    int fd = openTty(argv[2]);
+    if (fd < 0) return 1;
+    PosixTransport t(fd, false, 0, 1);
+    LinkBench bench;
+    LinkBenchConfig cfg;
+    if (argc > 3) {
+      cfg.baudCount = 0;
+      for (int i = 3; i < argc && cfg.baudCount < LinkBenchConfig::MAX_BAUDS; i++) cfg.bauds[cfg.baudCount++] = (uint32_t)atoi(argv[i]);
+    }
+    bench.begin(t, printLine, nullptr);
+    bench.start(cfg);
+    while (bench.running()) { bench.poll(); usleep(100); }
+    close(fd);
+    return 0;
+  }
+  if (argc >= 3 && !strcmp(argv[1], "peer")) {
+    int fd = openTty(argv[2]);
+    if (fd < 0) return 1;
+    PosixTransport t(fd, false, 0, 2);
+    LinkBenchPeer peer;
+    peer.begin(t, 115200);
+    printf("[BENCH] Peer auf %s (Strg+C beendet)\n", argv[2]);
+    for (;;) { peer.poll(); usleep(100); }
+  }
+  fprintf(stderr, "usage: %s pty [--flip <rate>]\n"
+                  "       %s master <tty> [baud...]\n"
+                  "       %s peer <tty>\n", argv[0], argv[0], argv[0]);
+  return 2;
+}
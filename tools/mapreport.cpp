@@ -0,0 +1,400 @@
+// ============================================================================
+// File: tools/mapreport.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Belegung je Speicherregion aus der Linker-Map (GNU ld -Map)
+//  • Regionen aus "Memory Configuration" (ESP32-S3: iram0_0_seg, dram0_0_seg,
+//    iram0_2_seg = Flash-Code, drom0_0_seg = Flash-Konstanten, rtc_*,
+//    extern_ram_seg), Zuordnung über die Adresse der Ausgabe-Sektion
+//  • Je Region belegt / Länge / %, dazu die größten Objekte (.o bzw.
+//    lib.a(x.o)) aus den Eingabe-Sektionen – zeigt, was HOT_FN/HOT_DATA
+//    (src/core/Placement.h) ins IRAM/DRAM bringen
+//  • Map ohne Regionen (nur *default*, z.B. Host-Build): je Ausgabe-Sektion
+//  • Beim ESP32-S3 teilen sich IRAM und DRAM denselben SRAM; die Regionen
+//    des Linker-Skripts sind schon entsprechend verkürzt
+// Usage: mapreport <f.map> [--top n] [--fail-above pct]
+//                  (Exit 2, wenn eine Region über pct % belegt ist)
+//        mapreport diff <alt.map> <neu.map>   Änderung je Region in Byte
+//        mapreport selftest
+// Map: arduino-esp32 2.x legt <sketch>.ino.map im Build-Ordner ab (Arduino
+//      IDE: "Kompilierte Binärdatei exportieren" bzw. --build-path bei
+//      arduino-cli); als Build-Schritt siehe README (platform.local.txt)
+// Build: g++ -O2 -std=c++17 tools/mapreport.cpp -o mapreport
+// ============================================================================
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Region {
+  std::string name;
+  uint64_t origin = 0, length = 0;
+  uint64_t used = 0;                          // Summe der Ausgabe-Sektionen
+  std::map<std::string, uint64_t> objects;    // Eingabe-Sektionen je Objekt
+};
+
+struct MapReport {
+  std::vector<Region> regions;
+  bool byRegion = true;                       // false: nur *default*, je Sektion
+};
+
+static bool isHex(const std::string& s){
+  return s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X');
+}
+
+static uint64_t hex(const std::string& s){ return strtoull(s.c_str(), nullptr, 16); }
+
+static std::vector<std::string> words(const std::string& line){
+  std::vector<std::string> w;
+  std::istringstream in(line);
+  std::string t;
+  while (in >> t) w.push_back(t);
+  return w;
+}
+
+// "…/build/sketch/CST328Touch.cpp.o" -> "CST328Touch.cpp.o",
+// "…/libfreertos.a(tasks.c.obj)" -> "libfreertos.a(tasks.c.obj)"
+static std::string objName(const std::string& path){
+  const size_t paren = path.find('(');
+  const size_t slash = path.find_last_of("/\\", paren == std::string::npos ? std::string::npos : paren);
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+class Parser {
+public:
+  explicit Parser(MapReport& r) : _r(r) {}
+
+  void line(std::string l){
+    while (!l.empty() && (l.back() == '\r' || l.back() == '\n')) l.pop_back();
+    if (l.rfind("Memory Configuration", 0) == 0) { _state = State::Memory; return; }
+    if (l.rfind("Linker script and memory map", 0) == 0) { finishMemory(); _state = State::Map; return; }
+    if (_state == State::Memory) memoryLine(l);
+    else if (_state == State::Map) mapLine(l);
+  }
+
+  void finish(){ if (_state == State::Memory) finishMemory(); }
+
+private:
+  enum class State { Start, Memory, Map };
+
+  void memoryLine(const std::string& l){
+    const auto w = words(l);
+    if (w.size() < 3 || !isHex(w[1]) || !isHex(w[2])) return;
+    if (w[0] == "*default*") return;
+    Region g;
+    g.name = w[0];
+    g.origin = hex(w[1]);
+    g.length = hex(w[2]);
+    _r.regions.push_back(g);
+  }
+
+  void finishMemory(){ _r.byRegion = !_r.regions.empty(); }
+
+  // Kleinste Region, die addr enthält
+  Region* regionOf(uint64_t addr){
+    Region* best = nullptr;
+    for (Region& g : _r.regions) {
+      if (addr < g.origin || addr - g.origin >= g.length) continue;
+      if (!best || g.length < best->length) best = &g;
+    }
+    return best;
+  }
+
+  Region* sectionRegion(const std::string& name){
+    for (Region& g : _r.regions) if (g.name == name) return &g;
+    Region g;
+    g.name = name;
+    _r.regions.push_back(g);
+    return &_r.regions.back();
+  }
+
+  void output(const std::string& name, uint64_t addr, uint64_t size){
+    _out = nullptr;
+    if (!_r.byRegion) {
+      if (size == 0 || addr == 0) return;     // Debug-Info u.ä. ohne Adresse
+      _out = sectionRegion(name);
+    } else {
+      _out = regionOf(addr);
+    }
+    if (_out) _out->used += size;
+  }
+
+  void input(const std::string& name, uint64_t addr, uint64_t size, const std::string& obj){
+    (void)name;
+    if (!_out || size == 0) return;
+    Region* g = _r.byRegion ? regionOf(addr) : _out;
+    if (g) g->objects[obj.empty() ? "*fill*" : objName(obj)] += size;
+  }
+
+  void mapLine(const std::string& l){
+    if (l.empty()) return;
+    const auto w = words(l);
+    if (w.empty()) return;
+
+    // Zweite Zeile einer umbrochenen Sektion: "   0xADDR 0xSIZE [obj]"
+    if (!_pendingName.empty()) {
+      const std::string name = _pendingName;
+      const bool out = _pendingOut;
+      _pendingName.clear();
+      if (w.size() >= 2 && isHex(w[0]) && isHex(w[1]) && l[0] == ' ') {
+        if (out) output(name, hex(w[0]), hex(w[1]));
+        else input(name, hex(w[0]), hex(w[1]), w.size() >= 3 ? w[2] : "");
+        return;
+      }
+      if (out) _out = nullptr;                // Sektion ohne Adresse
+    }
+
+    if (l[0] == '.') {                        // Ausgabe-Sektion
+      if (w.size() >= 3 && isHex(w[1]) && isHex(w[2])) output(w[0], hex(w[1]), hex(w[2]));
+      else if (w.size() == 1) { _pendingName = w[0]; _pendingOut = true; }
+      else _out = nullptr;
+      return;
+    }
+    if (l[0] != ' ' || l.size() < 2 || l[1] == ' ') {
+      if (l[0] != ' ') _out = nullptr;        // LOAD, OUTPUT(...), START GROUP …
+      return;                                 // Symbole, Zuweisungen
+    }
+    // Eingabe-Sektion: genau ein Leerzeichen Einrückung
+    if (w[0][0] == '*' && w[0] != "*fill*") return;   // Muster "*(.iram1 …)"
+    if (w.size() == 1) { _pendingName = w[0]; _pendingOut = false; return; }
+    if (w.size() >= 3 && isHex(w[1]) && isHex(w[2])) {
+      input(w[0], hex(w[1]), hex(w[2]), w[0] == "*fill*" ? "" : (w.size() >= 4 ? w[3] : ""));
+    }
+  }
+
+  MapReport&  _r;
+  State       _state = State::Start;
+  Region*     _out = nullptr;
+  std::string _pendingName;
+  bool        _pendingOut = false;
+};
+
+static MapReport parseText(const std::string& text){
+  MapReport r;
+  Parser p(r);
+  std::istringstream in(text);
+  std::string l;
+  while (std::getline(in, l)) p.line(l);
+  p.finish();
+  return r;
+}
+
+static bool parseFile(const char* path, MapReport& r){
+  FILE* f = fopen(path, "rb");
+  if (!f) { fprintf(stderr, "%s: nicht lesbar\n", path); return false; }
+  r = MapReport{};
+  Parser p(r);
+  std::string l;
+  char buf[4096];
+  while (fgets(buf, sizeof(buf), f)) {
+    l += buf;
+    if (l.back() != '\n' && !feof(f)) continue;     // lange Zeile fortsetzen
+    p.line(l);
+    l.clear();
+  }
+  if (!l.empty()) p.line(l);
+  p.finish();
+  fclose(f);
+  return true;
+}
+
+static const Region* find(const MapReport& r, const std::string& name){
+  for (const Region& g : r.regions) if (g.name == name) return &g;
+  return nullptr;
+}
+
+static double percent(const Region& g){ return g.length ? 100.0 * g.used / g.length : 0.0; }
+
+static void print(const MapReport& r, unsigned top){
+  printf("%-18s %12s %11s %10s %7s\n", r.byRegion ? "Region" : "Sektion", "Origin", "Länge", "belegt", "%");
+  for (const Region& g : r.regions) {
+    if (!g.used && !g.length) continue;
+    if (g.length) {
+      printf("%-18s 0x%010" PRIx64 " %10" PRIu64 " %10" PRIu64 " %6.1f%%\n",
+             g.name.c_str(), g.origin, g.length, g.used, percent(g));
+    } else {
+      printf("%-18s %12s %10s %10" PRIu64 " %7s\n", g.name.c_str(), "-", "-", g.used, "-");
+    }
+  }
+  if (!top) return;
+  for (const Region& g : r.regions) {
+    if (g.objects.empty()) continue;
+    std::vector<std::pair<uint64_t, std::string>> v;
+    for (const auto& o : g.objects) v.push_back({o.second, o.first});
+    std::sort(v.begin(), v.end(), [](const auto& a, const auto& b){ return a.first > b.first; });
+    printf("\n[%s] größte Objekte:\n", g.name.c_str());
+    for (size_t i = 0; i < v.size() && i < top; i++) printf("  %9" PRIu64 "  %s\n", v[i].first, v[i].second.c_str());
+  }
+}
+
+static void diff(const MapReport& a, const MapReport& b){
+  printf("%-18s %10s %10s %10s\n", "Region", "alt", "neu", "Differenz");
+  std::vector<std::string> names;
+  for (const Region& g : a.regions) names.push_back(g.name);
+  for (const Region& g : b.regions) if (!find(a, g.name)) names.push_back(g.name);
+  for (const std::string& n : names) {
+    const Region* ga = find(a, n);
+    const Region* gb = find(b, n);
+    const uint64_t ua = ga ? ga->used : 0, ub = gb ? gb->used : 0;
+    if (!ua && !ub) continue;
+    printf("%-18s %10" PRIu64 " %10" PRIu64 " %+10" PRId64 "\n", n.c_str(), ua, ub, (int64_t)(ub - ua));
+  }
+}
+
+// ---------------------------- Selbsttest ------------------------------------
+static int fails = 0;
+
+static void check(bool ok, const char* what){
+  if (!ok) { fails++; fprintf(stderr, "FAIL: %s\n", what); }
+}
+
+// Ausschnitt im Aufbau einer arduino-esp32-Map (Adressen ESP32-S3)
+static const char* SAMPLE =
+  "Archive member included to satisfy reference by file (symbol)\n"
+  "\n"
+  "Memory Configuration\n"
+  "\n"
+  "Name             Origin             Length             Attributes\n"
+  "iram0_0_seg      0x0000000040370000 0x0000000000050000 xr\n"
+  "iram0_2_seg      0x0000000042000020 0x00000000007fffe0 xr\n"
+  "dram0_0_seg      0x000000003fc88000 0x0000000000050000 rw\n"
+  "drom0_0_seg      0x000000003c000020 0x00000000007fffe0 r\n"
+  "rtc_iram_seg     0x00000000600fe000 0x0000000000002000 xrw\n"
+  "*default*        0x0000000000000000 0xffffffffffffffff\n"
+  "\n"
+  "Linker script and memory map\n"
+  "\n"
+  "LOAD /tmp/arduino/sketches/ABC/sketch/CST328Touch.cpp.o\n"
+  "                0x0000000040370000                _iram_start = ABSOLUTE (.)\n"
+  "\n"
+  ".iram0.vectors  0x0000000040370000      0x403\n"
+  " *(.exception_vectors.text)\n"
+  " .exception_vectors.text\n"
+  "                0x0000000040370000      0x3cb /x/libxtensa.a(xtensa_vectors.S.obj)\n"
+  "                0x0000000040370000                _WindowOverflow4\n"
+  " *fill*         0x00000000403703cb       0x38 \n"
+  "\n"
+  ".iram0.text     0x0000000040370404     0x1200\n"
+  " *(.iram1 .iram1.*)\n"
+  " .iram1.3       0x0000000040370404      0x100 /tmp/arduino/sketches/ABC/sketch/CST328Touch.cpp.o\n"
+  "                0x0000000040370404                CST328Touch::decodeFrame(unsigned char const*)\n"
+  " .iram1.4.literal\n"
+  "                0x0000000040370504       0x20 /tmp/arduino/sketches/ABC/sketch/CST328Touch.cpp.o\n"
+  " .iram1.7       0x0000000040370524      0x300 /tmp/arduino/sketches/ABC/sketch/src/gestures/GestureEngine.cpp.o\n"
+  " .iram1.0       0x0000000040370824      0xde0 /x/libfreertos.a(tasks.c.obj)\n"
+  "\n"
+  ".dram0.data     0x000000003fc88000      0x210 load address 0x000000003c010000\n"
+  " .dram1.2       0x000000003fc88000       0xb2 /tmp/arduino/sketches/ABC/sketch/src/audio/ImaAdpcm.cpp.o\n"
+  " .data          0x000000003fc880b2      0x15e /x/libc.a(lib_a-impure.o)\n"
+  "\n"
+  ".dram0.bss\n"
+  "                0x000000003fc88210     0x1000\n"
+  " COMMON         0x000000003fc88210     0x1000 /tmp/arduino/sketches/ABC/sketch/src/app/App.cpp.o\n"
+  "\n"
+  ".flash.text     0x0000000042000020     0x8000\n"
+  " .text._ZN3App4loopEv\n"
+  "                0x0000000042000020     0x8000 /tmp/arduino/sketches/ABC/sketch/src/app/App.cpp.o\n"
+  "\n"
+  ".debug_info     0x0000000000000000    0x12345\n"
+  " .debug_info    0x0000000000000000    0x12345 /tmp/arduino/sketches/ABC/sketch/src/app/App.cpp.o\n"
+  "OUTPUT(/tmp/arduino/sketches/ABC/sketch.ino.elf elf32-littlexten)\n";
+
+// Host-Map ohne Regionen
+static const char* SAMPLE_HOST =
+  "Memory Configuration\n"
+  "\n"
+  "Name             Origin             Length             Attributes\n"
+  "*default*        0x0000000000000000 0xffffffffffffffff\n"
+  "\n"
+  "Linker script and memory map\n"
+  "\n"
+  ".text           0x0000000000001040      0x200\n"
+  " .text          0x0000000000001040      0x180 /tmp/a.o\n"
+  " .text          0x00000000000011c0       0x80 /tmp/b.o\n"
+  ".rodata         0x0000000000002000       0x40\n"
+  " .rodata        0x0000000000002000       0x40 /tmp/a.o\n"
+  ".comment        0x0000000000000000       0x2b\n";
+
+static int selftest(){
+  const MapReport r = parseText(SAMPLE);
+  check(r.byRegion, "Regionen erkannt");
+  check(r.regions.size() == 5, "fünf Regionen ohne *default*");
+  const Region* iram = find(r, "iram0_0_seg");
+  const Region* dram = find(r, "dram0_0_seg");
+  const Region* flash = find(r, "iram0_2_seg");
+  const Region* rtc = find(r, "rtc_iram_seg");
+  check(iram && iram->used == 0x403 + 0x1200, "IRAM = Vektoren + .iram0.text");
+  check(iram && iram->length == 0x50000, "IRAM-Länge");
+  check(iram && iram->objects.at("CST328Touch.cpp.o") == 0x120, "CST328Touch einzeilig + umbrochen");
+  check(iram && iram->objects.at("GestureEngine.cpp.o") == 0x300, "GestureEngine im IRAM");
+  check(iram && iram->objects.at("libfreertos.a(tasks.c.obj)") == 0xde0, "Archiv-Objekt");
+  check(iram && iram->objects.at("libxtensa.a(xtensa_vectors.S.obj)") == 0x3cb, "Vektoren, Symbolzeile ignoriert");
+  check(iram && iram->objects.at("*fill*") == 0x38, "Füllbytes");
+  check(dram && dram->used == 0x210 + 0x1000, "DRAM = .data (VMA) + umbrochene .bss");
+  check(dram && dram->objects.at("ImaAdpcm.cpp.o") == 0xb2, "HOT_DATA-Tabelle im DRAM");
+  check(dram && dram->objects.at("App.cpp.o") == 0x1000, "COMMON");
+  check(flash && flash->used == 0x8000 && flash->objects.at("App.cpp.o") == 0x8000, "Flash-Code");
+  check(rtc && rtc->used == 0, "leere Region");
+  uint64_t total = 0;
+  for (const Region& g : r.regions) total += g.used;
+  check(total == 0x403 + 0x1200 + 0x210 + 0x1000 + 0x8000, "Debug-Sektionen ohne Region nicht gezählt");
+
+  const MapReport h = parseText(SAMPLE_HOST);
+  check(!h.byRegion, "Host-Map ohne Regionen");
+  const Region* text = find(h, ".text");
+  const Region* ro = find(h, ".rodata");
+  check(text && text->used == 0x200 && text->objects.at("a.o") == 0x180 && text->objects.at("b.o") == 0x80, "Host .text");
+  check(ro && ro->used == 0x40, "Host .rodata");
+  check(!find(h, ".comment"), "Sektion ohne Adresse ausgelassen");
+
+  // CRLF-Zeilen (Map unter Windows erzeugt)
+  std::string crlf;
+  for (const char* p = SAMPLE; *p; p++) { if (*p == '\n') crlf += '\r'; crlf += *p; }
+  const MapReport c = parseText(crlf);
+  const Region* ci = find(c, "iram0_0_seg");
+  check(ci && iram && ci->used == iram->used && ci->objects == iram->objects, "CRLF wie LF");
+
+  print(r, 3);
+  printf("\n%s (%d Fehler)\n", fails ? "FEHLER" : "OK", fails);
+  return fails ? 1 : 0;
+}
+
+int main(int argc, char** argv){
+  if (argc >= 2 && !strcmp(argv[1], "selftest")) return selftest();
+  if (argc >= 4 && !strcmp(argv[1], "diff")) {
+    MapReport a, b;
+    if (!parseFile(argv[2], a) || !parseFile(argv[3], b)) return 1;
+    diff(a, b);
+    return 0;
+  }
+  if (argc < 2 || argv[1][0] == '-') {
+    fprintf(stderr, "Usage: mapreport <f.map> [--top n] [--fail-above pct]\n"
+                    "       mapreport diff <alt.map> <neu.map>\n"
+                    "       mapreport selftest\n");
+    return 1;
+  }
+  unsigned top = 8;
+  double failAbove = 0;
+  for (int i = 2; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--top")) top = (unsigned)atoi(argv[i + 1]);
+    else if (!strcmp(argv[i], "--fail-above")) failAbove = atof(argv[i + 1]);
+    else { fprintf(stderr, "unbekannte Option %s\n", argv[i]); return 1; }
+  }
+  MapReport r;
+  if (!parseFile(argv[1], r)) return 1;
+  print(r, top);
+  if (failAbove > 0) {
+    for (const Region& g : r.regions) {
+      if (g.length && percent(g) > failAbove) {
+        fprintf(stderr, "[MAP] %s: %.1f %% belegt (Grenze %.1f %%)\n", g.name.c_str(), percent(g), failAbove);
+        return 2;
+      }
+    }
+  }
+  return 0;
+}
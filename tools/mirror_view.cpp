@@ -0,0 +1,535 @@
+// ============================================================================
+// File: tools/mirror_view.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Viewer/Decoder für den Bildschirm-Spiegel (src/comm/MirrorProto.cpp)
+//  decode <datei|-> [--ppm out.ppm] [--compare ref.ppm]
+//      Mitschnitt dekodieren (Konsolentext und Messdaten-Chunks fallen
+//      heraus), letztes Bild als PPM; Bilder/s aus den Zeitstempeln,
+//      Byte je Bild, verlorene Chunks. --compare: pixelgenau gegen ein PPM
+//      (z.B. hostsim --ppm), Exit 1 bei Abweichung
+//  view <tty|datei> [--scale n] [--ppm live.ppm]
+//      Live im Terminal (ANSI-Halbblöcke, 24 Bit Farbe, jede n-te Spalte,
+//      Vorgabe 2), optional jedes Bild als PPM (z.B. für feh --reload)
+//  selftest
+//      RLE/Chunk-Round-Trip, CRC-Fehler, synthetisches HUD über viele
+//      Bilder mit Tile-Vergleich wie die Firmware -> exakt rekonstruiert
+//  bench [tiles]
+//      RLE-Durchsatz je Tile-Art auf dem Host
+// Gerät: "mirror on" in der Konsole, dann z.B. mirror_view view /dev/ttyACM0
+// Build: g++ -O2 -std=c++17 tools/mirror_view.cpp src/comm/MirrorProto.cpp src/comm/TelemetryProto.cpp -o mirror_view
+// ============================================================================
+#include "../src/comm/MirrorProto.h"
+#include "../src/comm/TelemetryProto.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace mirror;
+
+// ---------------------------- Bildspeicher -----------------------------------
+struct Framebuffer {
+  uint16_t w = 0, h = 0;
+  std::vector<uint16_t> px;
+
+  void resize(uint16_t nw, uint16_t nh){
+    if (nw == w && nh == h) return;
+    w = nw;
+    h = nh;
+    px.assign((size_t)w * h, 0);
+  }
+  uint16_t tilesX() const { return (uint16_t)((w + TILE - 1) / TILE); }
+  void putTile(uint16_t index, const uint16_t* t){
+    const int tx = index % tilesX(), ty = index / tilesX();
+    for (int y = 0; y < TILE; y++) {
+      const int py = ty * TILE + y;
+      if (py >= h) break;
+      for (int x = 0; x < TILE; x++) {
+        const int pxx = tx * TILE + x;
+        if (pxx < w) px[(size_t)py * w + pxx] = t[y * TILE + x];
+      }
+    }
+  }
+};
+
+static inline void toRgb(uint16_t p, uint8_t rgb[3]){
+  rgb[0] = (uint8_t)((p >> 11) << 3);
+  rgb[1] = (uint8_t)(((p >> 5) & 0x3F) << 2);
+  rgb[2] = (uint8_t)((p & 0x1F) << 3);
+}
+
+// Wie hostsim --ppm (RGB565 -> RGB888 ohne Auffüllen der unteren Bits)
+static bool writePpm(const Framebuffer& fb, const char* path){
+  const std::string tmp = std::string(path) + ".tmp";
+  FILE* f = fopen(tmp.c_str(), "wb");
+  if (!f) return false;
+  fprintf(f, "P6\n%d %d\n255\n", fb.w, fb.h);
+  for (uint16_t p : fb.px) {
+    uint8_t rgb[3];
+    toRgb(p, rgb);
+    fwrite(rgb, 1, 3, f);
+  }
+  fclose(f);
+  return rename(tmp.c_str(), path) == 0;   // Betrachter sieht nie ein halbes Bild
+}
+
+static bool readPpm(const char* path, int& w, int& h, std::vector<uint8_t>& rgb){
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  int maxv = 0;
+  const bool ok = fscanf(f, "P6 %d %d %d", &w, &h, &maxv) == 3 && maxv == 255 && fgetc(f) != EOF;
+  if (ok) {
+    rgb.resize((size_t)w * h * 3);
+    if (fread(rgb.data(), 1, rgb.size(), f) != rgb.size()) { fclose(f); return false; }
+  }
+  fclose(f);
+  return ok;
+}
+
+// ---------------------------- Strom-Zerlegung --------------------------------
+struct DecodeStats {
+  size_t bytes = 0;
+  size_t chunks = 0;
+  size_t bad = 0;            // CRC/COBS/MAGIC (Konsolentext, Messdaten-Strom)
+  size_t seqGaps = 0;
+  size_t chunkBytes = 0;     // Spiegel-Chunks auf der Leitung (inkl. COBS + Trenner)
+  size_t frames = 0;         // FRAME_END
+  size_t keyFrames = 0;
+  size_t tiles = 0;
+  uint32_t firstMs = 0, lastMs = 0;
+  uint32_t lastFrame = 0;
+};
+
+struct Decoder {
+  Framebuffer fb;
+  DecodeStats st;
+  bool haveSeq = false, haveMs = false;
+  uint32_t lastSeq = 0;
+  std::vector<uint8_t> frame, raw;
+  bool frameEnd = false;           // seit dem letzten take()
+
+  static void onTile(void* ctx, uint16_t index, const uint16_t* px){
+    Decoder& d = *static_cast<Decoder*>(ctx);
+    d.fb.putTile(index, px);
+    d.st.tiles++;
+  }
+
+  // Bytes zwischen zwei 0x00 = ein Chunk (oder Text)
+  void chunk(){
+    if (frame.empty()) return;
+    raw.resize(frame.size());
+    const size_t r = telem::cobsDecode(frame.data(), frame.size(), raw.data(), raw.size());
+    ChunkHeader h;
+    // Größe vor den Tiles setzen: Kopf einmal ohne Visitor prüfen
+    if (r && decodeChunk(raw.data(), r, h, nullptr, nullptr)) {
+      fb.resize(h.width, h.height);
+      decodeChunk(raw.data(), r, h, onTile, this);
+      if (haveSeq && h.seq != lastSeq + 1) st.seqGaps += h.seq > lastSeq ? h.seq - lastSeq - 1 : 1;
+      lastSeq = h.seq;
+      haveSeq = true;
+      st.chunks++;
+      st.chunkBytes += frame.size() + 2;
+      if (h.flags & FRAME_END) {
+        st.frames++;
+        if (h.flags & KEY) st.keyFrames++;
+        if (!haveMs) { st.firstMs = h.ms; haveMs = true; }
+        st.lastMs = h.ms;
+        st.lastFrame = h.frame;
+        frameEnd = true;
+      }
+    } else {
+      st.bad++;
+    }
+    frame.clear();
+  }
+
+  void feed(const uint8_t* p, size_t n){
+    st.bytes += n;
+    for (size_t i = 0; i < n; i++) {
+      if (p[i] == 0x00) chunk();
+      else frame.push_back(p[i]);
+    }
+  }
+
+  bool take(){ const bool f = frameEnd; frameEnd = false; return f; }
+};
+
+static void printStats(const DecodeStats& s, const Framebuffer& fb){
+  printf("%zu Byte, %zu Chunks (%zu B), %zu verworfen (Text/CRC/andere), %zu Chunks verloren (Sequenz)\n",
+         s.bytes, s.chunks, s.chunkBytes, s.bad, s.seqGaps);
+  const double secs = (s.lastMs - s.firstMs) / 1000.0;
+  printf("Bild %ux%u: %zu Bilder (%zu Vollbilder), %zu Tiles (%.1f/Bild) über %.2f s",
+         fb.w, fb.h, s.frames, s.keyFrames, s.tiles, s.frames ? (double)s.tiles / s.frames : 0.0, secs);
+  if (secs > 0 && s.frames > 1) printf(" = %.1f Bilder/s, %.0f B/s", (s.frames - 1) / secs, s.chunkBytes / secs);
+  printf("\n");
+  if (s.frames) printf("%.0f Byte/Bild, letztes Bild #%u\n", (double)s.chunkBytes / s.frames, s.lastFrame);
+}
+
+static std::vector<uint8_t> readAll(const char* path){
+  FILE* f = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+  if (!f) { perror(path); exit(1); }
+  std::vector<uint8_t> buf;
+  uint8_t tmp[65536];
+  size_t n;
+  while ((n = fread(tmp, 1, sizeof(tmp), f)) > 0) buf.insert(buf.end(), tmp, tmp + n);
+  if (f != stdin) fclose(f);
+  return buf;
+}
+
+// ---------------------------- decode -----------------------------------------
+static int cmdDecode(int argc, char** argv){
+  const char* path = argv[0];
+  const char* ppm = nullptr;
+  const char* ref = nullptr;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--ppm")) ppm = argv[i + 1];
+    else if (!strcmp(argv[i], "--compare")) ref = argv[i + 1];
+  }
+  Decoder d;
+  const std::vector<uint8_t> in = readAll(path);
+  d.feed(in.data(), in.size());
+  d.chunk();                                   // Rest ohne abschließende 0x00
+  printStats(d.st, d.fb);
+  if (ppm && !writePpm(d.fb, ppm)) { perror(ppm); return 1; }
+  if (!ref) return 0;
+
+  int w = 0, h = 0;
+  std::vector<uint8_t> rgb;
+  if (!readPpm(ref, w, h, rgb)) { fprintf(stderr, "%s: kein P6-PPM\n", ref); return 1; }
+  if (w != d.fb.w || h != d.fb.h) {
+    printf("Vergleich: Größe %dx%d statt %ux%u\n", w, h, d.fb.w, d.fb.h);
+    return 1;
+  }
+  size_t diff = 0;
+  std::vector<bool> tileDiff((size_t)d.fb.tilesX() * ((h + TILE - 1) / TILE), false);
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      uint8_t c[3];
+      toRgb(d.fb.px[(size_t)y * w + x], c);
+      if (memcmp(c, &rgb[((size_t)y * w + x) * 3], 3)) {
+        diff++;
+        tileDiff[(size_t)(y / TILE) * d.fb.tilesX() + x / TILE] = true;
+      }
+    }
+  }
+  size_t tiles = 0;
+  for (bool b : tileDiff) tiles += b;
+  printf("Vergleich mit %s: %zu Pixel in %zu Tiles abweichend -> %s\n", ref, diff, tiles, diff ? "FEHLER" : "OK");
+  return diff ? 1 : 0;
+}
+
+// ---------------------------- view -------------------------------------------
+// Zwei Bildzeilen je Terminalzeile: oben Vorder-, unten Hintergrundfarbe
+static void renderAnsi(const Framebuffer& fb, int scale, const DecodeStats& s, double fps){
+  std::string out = "\x1b[H";
+  char buf[64];
+  for (int y = 0; y + scale < fb.h; y += 2 * scale) {
+    for (int x = 0; x < fb.w; x += scale) {
+      uint8_t a[3], b[3];
+      toRgb(fb.px[(size_t)y * fb.w + x], a);
+      toRgb(fb.px[(size_t)(y + scale) * fb.w + x], b);
+      snprintf(buf, sizeof(buf), "\x1b[38;2;%u;%u;%um\x1b[48;2;%u;%u;%um\xe2\x96\x80", a[0], a[1], a[2], b[0], b[1], b[2]);
+      out += buf;
+    }
+    out += "\x1b[0m\n";
+  }
+  snprintf(buf, sizeof(buf), "\x1b[0m\x1b[K#%u  %.1f Bilder/s  %zu B  verloren %zu\n",
+           s.lastFrame, fps, s.chunkBytes, s.seqGaps);
+  out += buf;
+  fwrite(out.data(), 1, out.size(), stdout);
+  fflush(stdout);
+}
+
+static int cmdView(int argc, char** argv){
+  const char* path = argv[0];
+  const char* ppm = nullptr;
+  int scale = 2;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--ppm")) ppm = argv[i + 1];
+    else if (!strcmp(argv[i], "--scale")) scale = atoi(argv[i + 1]) > 0 ? atoi(argv[i + 1]) : 1;
+  }
+  const int fd = strcmp(path, "-") ? open(path, O_RDONLY | O_NOCTTY) : 0;
+  if (fd < 0) { perror(path); return 1; }
+  if (isatty(fd)) {                            // CDC-ACM: roh, sonst verschluckt die Leitungsdisziplin Bytes
+    termios t;
+    if (tcgetattr(fd, &t) == 0) {
+      cfmakeraw(&t);
+      t.c_cc[VMIN]  = 1;
+      t.c_cc[VTIME] = 0;
+      tcsetattr(fd, TCSANOW, &t);
+    }
+  }
+  Decoder d;
+  using clock = std::chrono::steady_clock;
+  auto lastDraw = clock::now() - std::chrono::seconds(1);
+  auto rateT0 = clock::now();
+  size_t rateFrames = 0;
+  double fps = 0;
+  bool pending = false;
+  printf("\x1b[2J");
+  uint8_t buf[4096];
+  for (;;) {
+    const ssize_t n = read(fd, buf, sizeof(buf));
+    if (n <= 0) break;
+    d.feed(buf, (size_t)n);
+    if (d.take()) { pending = true; rateFrames++; }
+    const auto now = clock::now();
+    const double rs = std::chrono::duration<double>(now - rateT0).count();
+    if (rs >= 1.0) { fps = rateFrames / rs; rateFrames = 0; rateT0 = now; }
+    // Terminal höchstens ~20x/s neu zeichnen
+    if (pending && d.fb.w && now - lastDraw >= std::chrono::milliseconds(50)) {
+      renderAnsi(d.fb, scale, d.st, fps);
+      if (ppm) writePpm(d.fb, ppm);
+      lastDraw = now;
+      pending = false;
+    }
+  }
+  if (fd) close(fd);
+  if (pending && d.fb.w) renderAnsi(d.fb, scale, d.st, fps);
+  printStats(d.st, d.fb);
+  return 0;
+}
+
+// ---------------------------- Selbsttest -------------------------------------
+static int fails = 0;
+
+static void check(bool ok, const char* what){
+  if (ok) return;
+  fails++;
+  printf("FEHLER: %s\n", what);
+}
+
+static bool rleRoundTrip(const std::vector<uint16_t>& px){
+  std::vector<uint8_t> enc(2 * px.size() + px.size() / 128 + 2);
+  const size_t n = rleEncode(px.data(), px.size(), enc.data());
+  std::vector<uint16_t> back(px.size());
+  const uint8_t* p = enc.data();
+  return rleDecode(p, enc.data() + n, back.data(), back.size()) && p == enc.data() + n && back == px;
+}
+
+// Text wie im HUD: 6x8-Zellen, Muster aus dem Zeichencode (wie hostsim)
+static void drawText(Framebuffer& fb, int x, int y, const char* s, uint16_t fg, uint16_t bg){
+  for (; *s; s++, x += 6) {
+    const uint32_t bits = (uint32_t)(uint8_t)*s * 0x9E3779B1u;
+    for (int row = 0; row < 8; row++) {
+      for (int col = 0; col < 6; col++) {
+        const bool on = *s > ' ' && row < 7 && col < 5 && ((bits >> ((row * 5 + col) % 32)) & 1u);
+        if (x + col < fb.w && y + row < fb.h) fb.px[(size_t)(y + row) * fb.w + x + col] = on ? fg : bg;
+      }
+    }
+  }
+}
+
+static void fill(Framebuffer& fb, int x, int y, int w, int h, uint16_t c){
+  for (int j = y; j < y + h && j < fb.h; j++)
+    for (int i = x; i < x + w && i < fb.w; i++) fb.px[(size_t)j * fb.w + i] = c;
+}
+
+static void drawHud(Framebuffer& fb, int frame, std::mt19937& rng){
+  char line[64];
+  std::uniform_real_distribution<float> u(-1.f, 1.f);
+  fill(fb, 0, 0, fb.w, 48, 0x0000);
+  snprintf(line, sizeof(line), "FPS: %.1f", 30.f + (frame % 10) * 0.1f);
+  drawText(fb, 4, 4, line, 0xFFFF, 0x0000);
+  snprintf(line, sizeof(line), "IMU a[g]: %+.2f %+.2f %+.2f", 0.02f * u(rng), 0.02f * u(rng), 1.f + 0.01f * u(rng));
+  drawText(fb, 4, 16, line, 0xFFFF, 0x0000);
+  snprintf(line, sizeof(line), "IMU g[dps]: %+.1f %+.1f %+.1f", u(rng), u(rng), u(rng));
+  drawText(fb, 4, 28, line, 0xFFFF, 0x0000);
+  fill(fb, 0, 48, fb.w, 12, 0x7BEF);
+  snprintf(line, sizeof(line), "Gesture: %s (1) val=0.00 [@%d,%d]", frame / 30 % 2 ? "Tap" : "SwipeLeft", frame % 320, 120);
+  drawText(fb, 4, 50, line, 0xFFE0, 0x7BEF);
+}
+
+static uint32_t tileHash(const Framebuffer& fb, uint16_t index, uint16_t* out){
+  const int tx = index % fb.tilesX(), ty = index / fb.tilesX();
+  uint32_t h = 2166136261u;
+  for (int y = 0; y < TILE; y++) {
+    for (int x = 0; x < TILE; x++) {
+      const int px = tx * TILE + x, py = ty * TILE + y;
+      const uint16_t v = (px < fb.w && py < fb.h) ? fb.px[(size_t)py * fb.w + px] : 0;
+      out[y * TILE + x] = v;
+      h = (h ^ v) * 16777619u;
+    }
+  }
+  return h;
+}
+
+static int cmdSelftest(){
+  std::mt19937 rng(7);
+  // RLE: Grenzfälle und Zufall
+  {
+    std::vector<uint16_t> a(TILE_PIXELS, 0x1234);
+    check(rleRoundTrip(a), "RLE einfarbig");
+    std::vector<uint8_t> enc(TILE_MAX);
+    check(rleEncode(a.data(), a.size(), enc.data()) == 6, "RLE einfarbig = 6 Byte");
+    for (size_t i = 0; i < a.size(); i++) a[i] = (uint16_t)i;
+    check(rleRoundTrip(a), "RLE ohne Läufe");
+    check(rleEncode(a.data(), a.size(), enc.data()) == 2 + 2 * TILE_PIXELS, "RLE Worst Case");
+    for (size_t n : {1u, 2u, 127u, 128u, 129u, 255u, 256u, 257u, 1000u}) {
+      std::vector<uint16_t> b(n, 7);
+      check(rleRoundTrip(b), "RLE Lauflänge");
+      for (size_t i = 0; i < n; i += 2) b[i] = (uint16_t)i;
+      check(rleRoundTrip(b), "RLE abwechselnd");
+    }
+    std::uniform_int_distribution<int> pick(0, 3);
+    for (int it = 0; it < 2000; it++) {
+      std::vector<uint16_t> c(1 + rng() % 600);
+      for (auto& v : c) v = (uint16_t)(pick(rng) ? 0x0000 : rng());
+      check(rleRoundTrip(c), "RLE Zufall");
+    }
+    const uint8_t shortRun[] = {0x85, 0x00};
+    const uint8_t* p = shortRun;
+    uint16_t out[8];
+    check(!rleDecode(p, shortRun + sizeof(shortRun), out, 6), "RLE abgeschnitten erkannt");
+    const uint8_t tooLong[] = {0x8F, 0x00, 0x00};
+    p = tooLong;
+    check(!rleDecode(p, tooLong + sizeof(tooLong), out, 8), "RLE Überlauf erkannt");
+  }
+
+  // Chunk: mehrere Tiles, Kopf, CRC
+  {
+    uint8_t buf[2048];
+    ChunkHeader h;
+    h.seq = 300; h.frame = 70000; h.ms = 0xFFFFFFF0u; h.width = 320; h.height = 240; h.flags = KEY;
+    ChunkEncoder enc;
+    enc.begin(buf, sizeof(buf), h);
+    std::vector<uint16_t> tiles[3];
+    for (int t = 0; t < 3; t++) {
+      tiles[t].resize(TILE_PIXELS);
+      for (auto& v : tiles[t]) v = (uint16_t)(t == 1 ? rng() : 0x07E0 * t);
+      check(enc.addTile((uint16_t)(t * 100 + 5), tiles[t].data()), "Tile passt");
+    }
+    const size_t n = enc.finish(FRAME_END);
+    struct Got { std::vector<uint16_t> idx; std::vector<std::vector<uint16_t>> px; } got;
+    ChunkHeader r;
+    const bool ok = decodeChunk(buf, n, r, [](void* c, uint16_t i, const uint16_t* px){
+      Got& g = *static_cast<Got*>(c);
+      g.idx.push_back(i);
+      g.px.emplace_back(px, px + TILE_PIXELS);
+    }, &got);
+    check(ok && r.seq == 300 && r.frame == 70000 && r.ms == 0xFFFFFFF0u && r.width == 320 && r.height == 240 &&
+          r.flags == (KEY | FRAME_END), "Chunk-Kopf");
+    check(got.idx.size() >= 3 && got.idx[0] == 5 && got.idx[1] == 105 && got.idx[2] == 205 &&
+          got.px[0] == tiles[0] && got.px[1] == tiles[1] && got.px[2] == tiles[2], "Chunk-Tiles");
+    buf[n / 2] ^= 0x10;
+    check(!decodeChunk(buf, n, r, nullptr, nullptr), "CRC-Fehler erkannt");
+    buf[n / 2] ^= 0x10;
+    buf[0] = 1;                                   // Messdaten-Strom (Version 1)
+    check(!decodeChunk(buf, n, r, nullptr, nullptr), "fremder Chunk verworfen");
+
+    uint8_t small[HEADER_MAX + TILE_MAX + TRAILER];   // genau ein Tile im Worst Case
+    enc.begin(small, sizeof(small), h);
+    check(enc.addTile(1, tiles[1].data()) && !enc.addTile(2, tiles[0].data()), "Chunk voll erkannt");
+    check(decodeChunk(small, enc.finish(0), r, nullptr, nullptr), "voller Chunk gültig");
+  }
+
+  // HUD über viele Bilder: Sender vergleicht Tiles wie die Firmware, Strom mit Text
+  Framebuffer screen, ref;
+  screen.resize(320, 240);
+  const uint16_t tiles = (uint16_t)(screen.tilesX() * ((screen.h + TILE - 1) / TILE));
+  std::vector<uint32_t> sent(tiles, 0);
+  std::vector<uint8_t> wire, lossy;             // lossy: ohne den 7. Chunk
+  uint8_t raw[2048], cobs[2048 + 2048 / 254 + 3];
+  uint16_t px[TILE_PIXELS];
+  ChunkHeader h;
+  h.width = screen.w;
+  h.height = screen.h;
+  size_t frames = 0, sentTiles = 0, chunks = 0;
+  const int FRAMES = 300;
+  auto flush = [&](ChunkEncoder& e, uint8_t flags){
+    const size_t n = e.finish(flags);
+    wire.push_back(0x00);
+    const size_t m = telem::cobsEncode(raw, n, cobs);
+    wire.insert(wire.end(), cobs, cobs + m);
+    wire.push_back(0x00);
+    if (chunks != 6) {
+      lossy.push_back(0x00);
+      lossy.insert(lossy.end(), cobs, cobs + m);
+      lossy.push_back(0x00);
+    }
+    if (++chunks % 5 == 0) {
+      const char* text = "[GESTURE] Tap @120,160\n";
+      wire.insert(wire.end(), text, text + strlen(text));
+    }
+    h.seq++;
+  };
+  for (int f = 0; f < FRAMES; f++) {
+    drawHud(screen, f, rng);
+    if (f == 100) fill(screen, 40, 100, 200, 80, 0x001F);     // einmal großer Bereich
+    const bool key = f == 0 || f == 150;
+    h.flags = key ? KEY : 0;
+    h.frame = (uint32_t)frames;
+    h.ms    = (uint32_t)(f * 33);
+    ChunkEncoder e;
+    e.begin(raw, sizeof(raw), h);
+    for (uint16_t i = 0; i < tiles; i++) {
+      const uint32_t th = tileHash(screen, i, px);
+      if (!key && th == sent[i]) continue;
+      sent[i] = th;
+      if (!e.addTile(i, px)) { flush(e, 0); e.begin(raw, sizeof(raw), h); e.addTile(i, px); }
+      sentTiles++;
+    }
+    if (e.tiles()) { flush(e, FRAME_END); frames++; }
+  }
+  Decoder d;
+  d.feed(wire.data(), wire.size());
+  check(d.st.chunks == chunks && d.st.seqGaps == 0 && d.st.frames == frames, "Strom: Chunks/Bilder");
+  check(d.fb.px == screen.px, "HUD exakt rekonstruiert");
+
+  // Verlorener Chunk: Rest dekodiert weiter, Lücke gezählt
+  Decoder e;
+  e.feed(lossy.data(), lossy.size());
+  check(e.st.seqGaps == 1 && e.st.chunks == chunks - 1, "verlorener Chunk gezählt");
+
+  const size_t rawFrame = (size_t)screen.w * screen.h * 2;
+  printf("HUD synthetisch: %d Bilder, %zu gesendet, %zu Tiles (%.1f/Bild), %zu Chunks\n",
+         FRAMES, frames, sentTiles, (double)sentTiles / frames, chunks);
+  printf("Strom %zu Byte = %.0f Byte/Bild (Vollbild roh %zu Byte, Faktor %.0f)\n",
+         wire.size(), (double)wire.size() / frames, rawFrame, rawFrame / ((double)wire.size() / frames));
+  printf("\n%s (%d Fehler)\n", fails ? "FEHLER" : "OK", fails);
+  return fails ? 1 : 0;
+}
+
+// ---------------------------- bench ------------------------------------------
+static int cmdBench(size_t n){
+  std::mt19937 rng(3);
+  Framebuffer fb;
+  fb.resize(TILE, TILE);
+  std::vector<uint8_t> enc(TILE_MAX);
+  struct Kind { const char* name; void (*make)(Framebuffer&, std::mt19937&); };
+  const Kind kinds[] = {
+    {"einfarbig", [](Framebuffer& f, std::mt19937&){ fill(f, 0, 0, TILE, TILE, 0); }},
+    {"Text", [](Framebuffer& f, std::mt19937&){ fill(f, 0, 0, TILE, TILE, 0); drawText(f, 0, 4, "a[g", 0xFFFF, 0); }},
+    {"Rauschen", [](Framebuffer& f, std::mt19937& r){ for (auto& v : f.px) v = (uint16_t)r(); }},
+  };
+  for (const Kind& k : kinds) {
+    k.make(fb, rng);
+    size_t bytes = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; i++) {
+      bytes += rleEncode(fb.px.data(), TILE_PIXELS, enc.data());
+    }
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("%-10s %6.1f B/Tile  %7.3f us/Tile  %6.0f MPixel/s\n", k.name, (double)bytes / n,
+           s * 1e6 / n, n * TILE_PIXELS / s / 1e6);
+  }
+  return 0;
+}
+
+int main(int argc, char** argv){
+  if (argc >= 3 && !strcmp(argv[1], "decode")) return cmdDecode(argc - 2, argv + 2);
+  if (argc >= 3 && !strcmp(argv[1], "view")) return cmdView(argc - 2, argv + 2);
+  if (argc >= 2 && !strcmp(argv[1], "selftest")) return cmdSelftest();
+  if (argc >= 2 && !strcmp(argv[1], "bench")) return cmdBench(argc > 2 ? (size_t)atol(argv[2]) : 200000);
+  fprintf(stderr, "usage: %s decode <datei|-> [--ppm out.ppm] [--compare ref.ppm]\n"
+                  "       %s view <tty|datei> [--scale n] [--ppm live.ppm]\n"
+                  "       %s selftest\n"
+                  "       %s bench [tiles]\n", argv[0], argv[0], argv[0], argv[0]);
+  return 2;
+}
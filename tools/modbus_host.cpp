@@ -0,0 +1,218 @@
+// ============================================================================
+// File: tools/modbus_host.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Modbus RTU Ende-zu-Ende am Host: echter ModbusMaster gegen echten
+//          ModbusSlave (src/comm/Modbus.cpp), jeweils auf eigenem RS485Bus
+//  • Läuft auf dem Fake-Kern des Host-Simulators: UART1 (Master) und UART2
+//    (Slave) über Kreuz verbunden (sim::uartLink), Zeichen im Baudtakt,
+//    Frame-Ende per RX-Timeout (t3.5) wie am Gerät
+//  • Je Funktionscode (03, 04, 06, 16) n Anfragen, Registeranzahl 1..32
+//    umlaufend; Master-Aufrufer wie im Loop (Task, Kern 1), Slave antwortet
+//    aus dem UART-Event-Task
+//  • Ausgabe je Funktionscode: Turnaround des Masters (Request geschrieben
+//    -> Antwort geprüft) und des Slaves (Frame-Ende -> Antwort eingereiht)
+//    als p50/p95/max, dazu die reine Leitungszeit + 2x t3.5 als Untergrenze
+//  • Prüft Daten (gelesene Werte, geschriebene Register), keine Timeouts,
+//    CRC-Fehler oder Exceptions
+//  • cpu-scale wie hostsim --cpu-scale: 0 = deterministisch (nur Kostenmodell,
+//    Slave-Zeiten sind dann eine Untergrenze), 1 = Host-CPU-Zeit zählt mit
+// Usage: modbus_host [baud=115200] [n=200] [cpu-scale=0]
+// Build: cmake -S tools/hostsim -B build-sim && cmake --build build-sim
+//        (Ziel modbus_host, läuft mit ctest --test-dir build-sim)
+// ============================================================================
+#include <Arduino.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "../src/comm/Modbus.h"
+#include "hostsim/SimHost.h"
+#include "hostsim/SimKernel.h"
+
+static constexpr uint8_t  MASTER_PORT = 1;
+static constexpr uint8_t  SLAVE_PORT  = 2;
+static constexpr uint8_t  SLAVE_ID    = 7;
+static constexpr uint16_t REGS        = 32;
+
+static int g_failed = 0;
+static void check(bool ok, const char* what){
+  printf("  [%s] %s\n", ok ? " ok " : "FAIL", what);
+  if (!ok) g_failed++;
+}
+
+// ---------------------------- Slave-Registerkarte ---------------------------
+static uint16_t  g_holding[REGS], g_input[REGS];
+static ModbusReg g_holdingTbl[REGS], g_inputTbl[REGS];
+
+static void buildMap(ModbusRegMap& map){
+  for (uint16_t i = 0; i < REGS; i++) {
+    g_holding[i]    = (uint16_t)(0x1000 + i);
+    g_input[i]      = (uint16_t)(0x2000 + i);
+    g_holdingTbl[i] = ModbusReg{i, &g_holding[i], true};
+    g_inputTbl[i]   = ModbusReg{i, &g_input[i], false};
+  }
+  map.holding      = g_holdingTbl;
+  map.holdingCount = REGS;
+  map.input        = g_inputTbl;
+  map.inputCount   = REGS;
+}
+
+static RS485Bus     g_masterBus(MASTER_PORT), g_slaveBus(SLAVE_PORT);
+static ModbusMaster g_master;
+static ModbusSlave  g_slave;
+static uint32_t     g_baud = 115200;
+static uint32_t     g_n = 200;
+static volatile bool g_done = false;
+
+// ---------------------------- Messung ---------------------------------------
+struct Completion {
+  TaskHandle_t waiter = nullptr;
+  bool         done = false;
+  ModbusResult result = ModbusResult::Ok;
+};
+
+// Direkte Zustellung: läuft im UART-Event-Task des Masters
+static void onDone(ModbusResult r, uint8_t, void* ctx){
+  Completion& c = *static_cast<Completion*>(ctx);
+  c.result = r;
+  c.done   = true;
+  xTaskNotifyGive(c.waiter);
+}
+
+static bool await(Completion& c){
+  while (!c.done) {
+    ulTaskNotifyTake(pdTRUE, 1);
+    g_master.loop();                     // Timeout-Überwachung wie im Loop
+    g_masterBus.loop();
+    g_slaveBus.loop();
+  }
+  return c.result == ModbusResult::Ok;
+}
+
+static uint32_t pct(std::vector<uint32_t> v, float p){
+  if (v.empty()) return 0;
+  std::sort(v.begin(), v.end());
+  return v[std::min(v.size() - 1, (size_t)(p * (float)(v.size() - 1) + 0.5f))];
+}
+
+// 8N1: 10 Bit je Zeichen
+static uint32_t charsUs(size_t chars){ return (uint32_t)((uint64_t)chars * 10u * 1000000u / g_baud); }
+static uint32_t gapUs(){ return charsUs(modbus::gapSymbols(g_baud)); }
+
+struct FnResult {
+  const char* name;
+  std::vector<uint32_t> master, slave, line;   // line: Request + Antwort auf der Leitung
+  uint32_t failed = 0;
+};
+
+static void runFunction(uint8_t fn, FnResult& res){
+  uint16_t dest[REGS], values[REGS];
+  for (uint32_t i = 0; i < g_n; i++) {
+    const uint16_t count = (uint16_t)(1 + i % REGS);
+    const uint16_t start = (uint16_t)(REGS - count);
+    Completion c;
+    c.waiter = xTaskGetCurrentTaskHandle();
+    bool issued = false, dataOk = true;
+    size_t req = 0, resp = 0;
+
+    switch (fn) {
+      case modbus::ReadHolding:
+      case modbus::ReadInput:
+        issued = g_master.readRegisters(SLAVE_ID, fn, start, count, dest, onDone, &c);
+        req = 8; resp = 5 + 2u * count;
+        if (issued && await(c)) {
+          const uint16_t* src = fn == modbus::ReadHolding ? g_holding : g_input;
+          for (uint16_t k = 0; k < count; k++) dataOk &= dest[k] == src[start + k];
+        }
+        break;
+      case modbus::WriteSingle: {
+        const uint16_t a = (uint16_t)(i % REGS), v = (uint16_t)(0x6000 + i);
+        issued = g_master.writeSingle(SLAVE_ID, a, v, onDone, &c);
+        req = 8; resp = 8;
+        if (issued && await(c)) dataOk = g_holding[a] == v;
+        break;
+      }
+      case modbus::WriteMultiple:
+        for (uint16_t k = 0; k < count; k++) values[k] = (uint16_t)(0x7000 + i + k);
+        issued = g_master.writeMultiple(SLAVE_ID, start, values, count, onDone, &c);
+        req = 9 + 2u * count; resp = 8;
+        if (issued && await(c)) {
+          for (uint16_t k = 0; k < count; k++) dataOk &= g_holding[start + k] == values[k];
+        }
+        break;
+    }
+
+    if (!issued || c.result != ModbusResult::Ok || !dataOk) { res.failed++; continue; }
+    res.master.push_back(g_master.stats().turnLastUs);
+    res.slave.push_back(g_slave.stats().turnLastUs);
+    res.line.push_back(charsUs(req + resp));
+    vTaskDelay(1);                       // Ruhe vor der nächsten Anfrage (> t3.5)
+  }
+}
+
+static void report(const FnResult& r){
+  printf("  %-14s %5u %8u %8u %8u   %8u %8u %8u   %8u\n", r.name, (unsigned)r.master.size(),
+         pct(r.master, 0.50f), pct(r.master, 0.95f), pct(r.master, 1.0f),
+         pct(r.slave, 0.50f), pct(r.slave, 0.95f), pct(r.slave, 1.0f), pct(r.line, 0.50f) + 2 * gapUs());
+}
+
+static void masterTask(void*){
+  ModbusRegMap map;
+  buildMap(map);
+  const bool up = g_masterBus.begin(g_baud) && g_slaveBus.begin(g_baud) &&
+                  g_master.begin(g_masterBus) && g_slave.begin(g_slaveBus, SLAVE_ID, map);
+  check(up, "Busse, Master und Slave gestartet");
+  if (up) {
+    g_master.setDirectCompletion(true);
+    FnResult res[] = {{"03 ReadHold", {}, {}, {}}, {"04 ReadInput", {}, {}, {}},
+                      {"06 WriteSingle", {}, {}, {}}, {"16 WriteMulti", {}, {}, {}}};
+    const uint8_t fns[] = {modbus::ReadHolding, modbus::ReadInput, modbus::WriteSingle, modbus::WriteMultiple};
+    for (size_t i = 0; i < 4; i++) runFunction(fns[i], res[i]);
+
+    printf("\n  Turnaround in us bei %u Baud, t3.5 = %u Zeichen (Register 1..%u umlaufend)\n",
+           g_baud, modbus::gapSymbols(g_baud), REGS);
+    printf("  %-14s %5s %8s %8s %8s   %8s %8s %8s   %8s\n", "Funktion", "n",
+           "M p50", "M p95", "M max", "S p50", "S p95", "S max", "Ltg p50");
+    for (const FnResult& r : res) report(r);
+    printf("  M = Master (Request geschrieben -> Antwort geprüft), S = Slave (Frame-Ende -> Antwort\n"
+           "  eingereiht), Ltg = Request + Antwort auf der Leitung + 2x t3.5\n\n");
+    g_master.printStats(Serial);
+    g_slave.printStats(Serial);
+
+    uint32_t failed = 0;
+    for (const FnResult& r : res) failed += r.failed;
+    const ModbusStats& ms = g_master.stats();
+    const ModbusStats& ss = g_slave.stats();
+    check(failed == 0, "alle Anfragen Ok, gelesene/geschriebene Werte stimmen");
+    check(ms.timeouts == 0 && ms.crcErrors == 0 && ss.crcErrors == 0, "keine Timeouts/CRC-Fehler");
+    check(ms.exceptions == 0 && ss.exceptions == 0 && ss.ignored == 0, "keine Exceptions/verworfenen Frames");
+    check(ss.frames == 4 * g_n && ms.turnCount == 4 * g_n, "jede Anfrage genau einmal beantwortet");
+    bool aboveLine = true;
+    for (const FnResult& r : res)
+      for (size_t k = 0; k < r.master.size(); k++) aboveLine &= r.master[k] >= r.line[k];
+    check(aboveLine, "Master-Turnaround >= Leitungszeit (Messung plausibel)");
+  }
+  g_done = true;
+  for (;;) vTaskDelay(portMAX_DELAY);
+}
+
+int main(int argc, char** argv){
+  if (argc > 1) g_baud = (uint32_t)strtoul(argv[1], nullptr, 10);
+  if (argc > 2) g_n    = (uint32_t)strtoul(argv[2], nullptr, 10);
+  const double cpuScale = argc > 3 ? atof(argv[3]) : 0.0;
+  if (g_baud < 1200 || g_n == 0 || cpuScale < 0) {
+    fprintf(stderr, "Usage: modbus_host [baud=115200] [n=200] [cpu-scale=0]\n");
+    return 2;
+  }
+
+  sim::init(cpuScale);
+  sim::uartLink(MASTER_PORT, SLAVE_PORT);
+  // Master-Aufrufer wie der Arduino-loopTask (Kern 1, Priorität 1)
+  xTaskCreatePinnedToCore(masterTask, "loopTask", 8192, nullptr, 1, nullptr, 1);
+  while (!g_done && sim::nowNs() < 600000000000ull) sim::runUntil(sim::nowNs() + 10000000ull);
+  check(g_done, "Lauf in 600 s virtueller Zeit beendet");
+
+  printf("\n%s (%d Fehler)\n", g_failed ? "FEHLER" : "OK", g_failed);
+  fflush(stdout);
+  _Exit(g_failed ? 1 : 0);
+}
@@ -0,0 +1,148 @@
+// ============================================================================
+// File: tools/prof2trace.cpp
+// ----------------------------------------------------------------------------
+// Purpose: "prof dump" (src/core/Profiler.cpp) -> Chrome-Trace-Event-JSON
+//  • Liest einen Konsolen-Mitschnitt, nimmt nur die [PROF]-Zeilen zwischen
+//    "begin" und "end" (der letzte vollständige Dump gilt)
+//  • Zyklen je Kern über das Bezugspaar (CCOUNT, micros()) auf eine
+//    gemeinsame µs-Achse; Differenzen modulo 2^32 (±8,9 s bei 240 MHz)
+//  • Prozess = Kern, Thread = Task, Ereignis "X" = Zone mit Dauer
+//  • Zusammenfassung je Zone (Anzahl, Min/Mittel/Max µs) auf stderr
+// Usage: prof2trace <mitschnitt.log|-> [out.json]   (ohne out: stdout)
+//        Ansicht: https://ui.perfetto.dev oder chrome://tracing
+// Mitschnitt: z.B. "pio device monitor | tee cap.log", dann "prof dump"
+// Build: g++ -O2 -std=c++17 tools/prof2trace.cpp -o prof2trace
+// ============================================================================
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+struct Ref { uint32_t cycles = 0, us = 0; bool set = false; };
+struct Ev  { unsigned core, task, zone; uint32_t start, cycles; };
+
+struct Dump {
+  unsigned mhz = 240, cores = 2;
+  std::map<unsigned, std::string> zones, tasks;
+  std::map<unsigned, Ref> refs;
+  std::vector<Ev> ev;
+};
+
+static void jsonStr(FILE* f, const std::string& s){
+  fputc('"', f);
+  for (char c : s) {
+    if (c == '"' || c == '\\') fputc('\\', f);
+    if ((unsigned char)c >= 0x20) fputc(c, f);
+  }
+  fputc('"', f);
+}
+
+// Letzten vollständigen Dump aus dem Mitschnitt holen
+static bool parse(FILE* in, Dump& out){
+  char line[512];
+  Dump cur;
+  bool inDump = false, found = false;
+  while (fgets(line, sizeof(line), in)) {
+    const char* p = strstr(line, "[PROF] ");
+    if (!p) continue;
+    p += 7;
+    char name[128];
+    unsigned a, b, c;
+    uint32_t s, d;
+    if (sscanf(p, "begin mhz=%u cores=%u", &a, &b) == 2) {
+      cur = Dump{};
+      cur.mhz = a ? a : 240;
+      cur.cores = b;
+      inDump = true;
+    } else if (!inDump) {
+      continue;
+    } else if (sscanf(p, "zone %u %127s", &a, name) == 2) {
+      cur.zones[a] = name;
+    } else if (sscanf(p, "task %u %127[^\r\n]", &a, name) == 2) {
+      cur.tasks[a] = name;
+    } else if (sscanf(p, "ref %u %u %u", &a, &s, &d) == 3) {
+      cur.refs[a] = Ref{s, d, true};
+    } else if (sscanf(p, "ev %u %u %u %u %u", &a, &b, &c, &s, &d) == 5) {
+      cur.ev.push_back(Ev{a, b, c, s, d});
+    } else if (strncmp(p, "end", 3) == 0) {
+      out = cur;
+      inDump = false;
+      found = true;
+    }
+  }
+  return found;
+}
+
+static double toUs(const Dump& d, const Ev& e){
+  auto it = d.refs.find(e.core);
+  if (it == d.refs.end() || !it->second.set) return (double)e.start / d.mhz;
+  const int32_t dc = (int32_t)(e.start - it->second.cycles);
+  return (double)it->second.us + (double)dc / d.mhz;
+}
+
+int main(int argc, char** argv){
+  if (argc < 2) {
+    fprintf(stderr, "usage: prof2trace <mitschnitt.log|-> [out.json]\n");
+    return 2;
+  }
+  FILE* in = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+  if (!in) { perror(argv[1]); return 1; }
+  Dump d;
+  const bool ok = parse(in, d);
+  if (in != stdin) fclose(in);
+  if (!ok) { fprintf(stderr, "kein vollständiger 'prof dump' gefunden\n"); return 1; }
+
+  FILE* out = argc > 2 ? fopen(argv[2], "w") : stdout;
+  if (!out) { perror(argv[2]); return 1; }
+
+  double t0 = 1e300;
+  for (const Ev& e : d.ev) t0 = std::min(t0, toUs(d, e));
+
+  fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  bool first = true;
+  auto sep = [&]{ if (!first) fputs(",\n", out); first = false; };
+  for (unsigned c = 0; c < d.cores; c++) {
+    sep();
+    fprintf(out, "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":%u,\"args\":{\"name\":\"core %u\"}}", c, c);
+  }
+  // Task-Namen je Kern, auf dem er vorkommt
+  std::map<std::pair<unsigned, unsigned>, bool> seen;
+  for (const Ev& e : d.ev) seen[{e.core, e.task}] = true;
+  for (auto& kv : seen) {
+    auto it = d.tasks.find(kv.first.second);
+    sep();
+    fprintf(out, "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+            kv.first.first, kv.first.second);
+    jsonStr(out, it != d.tasks.end() ? it->second : "task " + std::to_string(kv.first.second));
+    fputs("}}", out);
+  }
+
+  struct Agg { uint32_t n = 0; double sum = 0, min = 1e300, max = 0; };
+  std::map<std::string, Agg> agg;
+  for (const Ev& e : d.ev) {
+    auto zn = d.zones.find(e.zone);
+    const std::string zone = zn != d.zones.end() ? zn->second : "zone" + std::to_string(e.zone);
+    const double dur = (double)e.cycles / d.mhz;
+    sep();
+    fputs("{\"ph\":\"X\",\"name\":", out);
+    jsonStr(out, zone);
+    fprintf(out, ",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", e.core, e.task, toUs(d, e) - t0, dur);
+    Agg& a = agg[zone];
+    a.n++;
+    a.sum += dur;
+    a.min = std::min(a.min, dur);
+    a.max = std::max(a.max, dur);
+  }
+  fprintf(out, "\n]}\n");
+  if (out != stdout) fclose(out);
+
+  fprintf(stderr, "%zu Ereignisse, %u MHz\n", d.ev.size(), d.mhz);
+  fprintf(stderr, "zone            count     min us    mean us     max us\n");
+  for (auto& kv : agg)
+    fprintf(stderr, "%-12s %8u %10.1f %10.1f %10.1f\n", kv.first.c_str(), kv.second.n, kv.second.min,
+            kv.second.sum / kv.second.n, kv.second.max);
+  return 0;
+}
@@ -0,0 +1,161 @@
+// ============================================================================
+// File: tools/rs485_poll_sim.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Simulation des Modbus-Abfrageplans (src/comm/PollSchedule.cpp)
+//  • Virtuelle Slaves mit Antwortzeit, Fehlerrate bzw. "nicht vorhanden"
+//  • Leitungszeit aus Baudrate (11 Bit/Zeichen), Frame-Ende nach t3.5,
+//    Timeout-Erkennung im Loop-Takt wie auf dem Gerät
+//  • Vergleich: nächste Anfrage direkt nach der Antwort (ModbusPoller) vs.
+//    erst beim nächsten Loop-Durchlauf
+//  • Ausgabe: Busauslastung, Polls/s, Round-Trip/Fehler je Gerät,
+//    erreichte Periode je Abfrage
+// Usage: rs485_poll_sim [baud=115200] [sekunden=60] [loop_ms=5]
+// Build: g++ -O2 -std=c++17 tools/rs485_poll_sim.cpp src/comm/PollSchedule.cpp -o rs485_poll_sim
+// ============================================================================
+#include "../src/comm/PollSchedule.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+struct VirtualSlave {
+  uint8_t  id;
+  uint32_t respMinUs, respMaxUs;   // Verarbeitungszeit bis Antwortbeginn
+  double   errorRate;              // Anteil gestörter Antworten (CRC)
+  bool     present;
+};
+
+struct SimPoll {
+  uint8_t  device;
+  uint16_t count;
+  uint16_t periodMs;
+  uint8_t  priority;
+};
+
+// Gleiche Defaults wie params.h
+static constexpr uint32_t TIMEOUT_US     = 100000;
+static constexpr uint8_t  RETRIES        = 1;
+static constexpr uint8_t  OFFLINE_AFTER  = 3;
+static constexpr uint8_t  OFFLINE_BACKOFF = 10;
+
+static const VirtualSlave SLAVES[] = {
+  { 1,  300,  800, 0.00, true  },
+  { 2,  500, 2000, 0.00, true  },
+  { 3, 1000, 5000, 0.02, true  },   // langsam, gelegentlich CRC-Fehler
+  { 4,  200,  400, 0.00, true  },
+  { 5,  300,  600, 0.00, false },   // abgeklemmt -> Timeouts, offline
+};
+
+static const SimPoll POLLS[] = {
+  { 0, 4,  20, 2 },   // schnelle Prozesswerte
+  { 1, 8,  50, 1 },
+  { 2, 2, 100, 1 },
+  { 3, 6,  20, 2 },
+  { 0, 8, 500, 0 },   // Diagnose, langsam
+  { 2, 8, 500, 0 },
+  { 4, 4, 100, 1 },
+};
+
+static constexpr size_t NS = sizeof(SLAVES) / sizeof(SLAVES[0]);
+static constexpr size_t NP = sizeof(POLLS) / sizeof(POLLS[0]);
+
+struct Result {
+  double   busyUs = 0;       // Leitung belegt (Bytes auf dem Draht)
+  double   heldUs = 0;       // Master blockiert (Anfrage bis Ergebnis verarbeitet)
+  uint32_t polls = 0;
+  PollDeviceStats dev[NS];
+  uint32_t runs[NP] = {0};
+  uint32_t lateMaxMs[NP] = {0};
+};
+
+static uint32_t charUs(uint32_t baud){ return (11u * 1000000u + baud - 1) / baud; }
+
+static uint32_t t35Us(uint32_t baud){
+  return baud > 19200 ? 1750 : (uint32_t)(3.5 * charUs(baud));
+}
+
+static Result simulate(uint32_t baud, double seconds, uint32_t loopUs, bool pipelined){
+  std::mt19937 rng(7);
+  PollEntry entries[NP];
+  PollDeviceStats devs[NS];
+  for (size_t i = 0; i < NP; i++) {
+    entries[i].device   = POLLS[i].device;
+    entries[i].periodMs = POLLS[i].periodMs;
+    entries[i].priority = POLLS[i].priority;
+  }
+  PollSchedule sched;
+  sched.init(entries, NP, devs, NS, RETRIES, OFFLINE_AFTER, OFFLINE_BACKOFF);
+  sched.start(0);
+
+  Result res;
+  const uint64_t endUs = (uint64_t)(seconds * 1e6);
+  const uint32_t cUs = charUs(baud), gapUs = t35Us(baud);
+  uint64_t now = 0;
+
+  auto nextTick = [&](uint64_t t){ return ((t + loopUs - 1) / loopUs) * loopUs; };
+
+  while (now < endUs) {
+    const int idx = sched.next((uint32_t)(now / 1000));
+    if (idx < 0) {
+      // Leerlauf bis zur nächsten Fälligkeit, geprüft im Loop-Takt
+      now = nextTick(now + (uint64_t)sched.msUntilDue((uint32_t)(now / 1000)) * 1000 + 1);
+      continue;
+    }
+    const uint32_t lateMs = (uint32_t)(now / 1000) - entries[idx].nextDueMs;
+    if ((int32_t)lateMs > 0 && lateMs > res.lateMaxMs[idx]) res.lateMaxMs[idx] = lateMs;
+
+    const VirtualSlave& s = SLAVES[POLLS[idx].device];
+    const uint64_t start = now;
+    const uint32_t reqUs = 8 * cUs;
+    res.busyUs += reqUs;
+    uint64_t done;
+    PollOutcome out;
+    if (!s.present) {
+      done = nextTick(start + reqUs + TIMEOUT_US);       // Timeout erst im Loop bemerkt
+      out  = PollOutcome::Timeout;
+    } else {
+      std::uniform_int_distribution<uint32_t> d(s.respMinUs, s.respMaxUs);
+      const uint32_t respUs = (5 + 2u * POLLS[idx].count) * cUs;
+      res.busyUs += respUs;
+      done = start + reqUs + d(rng) + respUs + gapUs;     // RX-Timeout = Frame-Ende
+      out  = std::uniform_real_distribution<double>(0, 1)(rng) < s.errorRate ? PollOutcome::Error : PollOutcome::Ok;
+      if (!pipelined) done = nextTick(done);              // Ergebnis erst im nächsten Loop
+    }
+    sched.complete(idx, out, (uint32_t)(done - start), (uint32_t)(done / 1000));
+    res.heldUs += (double)(done - start);
+    res.polls++;
+    if (out == PollOutcome::Ok) res.runs[idx]++;
+    now = done;
+  }
+  for (size_t d = 0; d < NS; d++) res.dev[d] = sched.device(d);
+  return res;
+}
+
+static void report(const char* title, const Result& r, double seconds){
+  printf("%s\n", title);
+  printf("  Leitung belegt: %5.1f %%   Master blockiert: %5.1f %%   Polls: %.0f/s\n",
+         100.0 * r.busyUs / (seconds * 1e6), 100.0 * r.heldUs / (seconds * 1e6), r.polls / seconds);
+  for (size_t d = 0; d < NS; d++) {
+    const PollDeviceStats& s = r.dev[d];
+    printf("  slave %u: ok=%6u to=%4u err=%3u retry=%3u%s rtt min/avg/max = %5u/%5u/%5u us\n",
+           SLAVES[d].id, s.ok, s.timeouts, s.errors, s.retries, s.offline ? " OFFLINE" : "        ",
+           s.ok ? s.rttMinUs : 0, s.rttAvgUs(), s.rttMaxUs);
+  }
+  for (size_t i = 0; i < NP; i++) {
+    printf("  poll #%zu slave %u /%4ums prio %u: erreicht ", i, SLAVES[POLLS[i].device].id,
+           POLLS[i].periodMs, POLLS[i].priority);
+    if (r.runs[i]) printf("%7.1f ms", seconds * 1000.0 / r.runs[i]);
+    else           printf("      - ");
+    printf(", max. verspätet %u ms\n", r.lateMaxMs[i]);
+  }
+}
+
+int main(int argc, char** argv){
+  const uint32_t baud    = argc > 1 ? (uint32_t)atoi(argv[1]) : 115200;
+  const double   seconds = argc > 2 ? atof(argv[2]) : 60.0;
+  const uint32_t loopUs  = (argc > 3 ? (uint32_t)atoi(argv[3]) : 5) * 1000;
+  printf("Baud %u, %.0f s, Loop %u ms, Timeout %u ms\n\n", baud, seconds, loopUs / 1000, TIMEOUT_US / 1000);
+  report("Direkt nach Antwort (ModbusPoller):", simulate(baud, seconds, loopUs, true), seconds);
+  printf("\n");
+  report("Nächster Loop-Durchlauf:", simulate(baud, seconds, loopUs, false), seconds);
+  return 0;
+}
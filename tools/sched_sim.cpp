@@ -0,0 +1,228 @@
+// ============================================================================
+// File: tools/sched_sim.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Simulation des Loop-Schedulers (src/core/Scheduler.cpp)
+//  • Virtuelle Zeit, Jobs mit zufälligen Laufzeiten wie in App::loop()
+//    (Eingabe 1 ms, Touch-Anforderung 5 ms + IRQ, IMU, RS485, HUD, Konsole)
+//  • Vergleich EDF-Scheduler vs. alte feste Reihenfolge mit millis()-Timern
+//  • Prüft Deadline-Verhalten:
+//     1) ohne blockierenden Job: keine Deadline-Verfehlung
+//     2) mit HUD-Block: Verspätung <= längster fremder Job + eigener Job
+//     3) IRQ-Ereignisse starten spätestens nach dem laufenden Job
+//     4) Überlast: Budget-Überschreitung und ausgelassene Perioden gezählt
+//     5) runReady(): je Job höchstens ein Lauf pro Durchgang
+// Usage: sched_sim [sekunden=20]
+// Build: g++ -O2 -std=c++17 tools/sched_sim.cpp src/core/Scheduler.cpp -o sched_sim
+// ============================================================================
+#include "../src/core/Scheduler.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static uint64_t g_now = 0;
+static uint32_t simClock(){ return (uint32_t)g_now; }
+static std::mt19937 g_rng(11);
+
+struct SimJob {
+  const char* name;
+  uint32_t periodUs;      // 0 = nur IRQ
+  uint32_t deadlineUs;
+  uint8_t  priority;
+  uint32_t costMinUs, costMaxUs;
+  uint32_t budgetUs;
+  bool     irq;           // zusätzlich per Ereignis freigegeben
+};
+
+static void runCost(void* ctx){
+  const SimJob& j = *static_cast<const SimJob*>(ctx);
+  std::uniform_int_distribution<uint32_t> d(j.costMinUs, j.costMaxUs);
+  g_now += d(g_rng);
+}
+
+struct Outcome {
+  std::vector<JobStats> stats;
+  uint32_t irqLateMaxUs = 0;
+};
+
+// IRQ-Zeitpunkte: Touch-Controller ~ alle 8-12 ms während Berührung
+static std::vector<uint64_t> makeIrqs(double seconds){
+  std::vector<uint64_t> t;
+  std::uniform_int_distribution<uint32_t> gap(8000, 12000);
+  for (uint64_t x = 1000; x < (uint64_t)(seconds * 1e6); x += gap(g_rng)) t.push_back(x);
+  return t;
+}
+
+static Outcome runEdf(const std::vector<SimJob>& jobs, double seconds, const std::vector<uint64_t>& irqs){
+  g_now = 0;
+  Scheduler s;
+  s.begin(simClock);
+  std::vector<int> ids;
+  for (const SimJob& j : jobs) {
+    ids.push_back(s.add(j.name, runCost, const_cast<SimJob*>(&j), j.periodUs, j.deadlineUs, j.priority, j.budgetUs));
+  }
+  Outcome o;
+  size_t nextIrq = 0;
+  const uint64_t end = (uint64_t)(seconds * 1e6);
+  while (g_now < end) {
+    // Loop-Anfang: IRQ-Flag prüfen wie App::loop()
+    while (nextIrq < irqs.size() && irqs[nextIrq] <= g_now) {
+      for (size_t k = 0; k < jobs.size(); k++) if (jobs[k].irq) s.trigger(ids[k]);
+      const uint32_t late = (uint32_t)(g_now - irqs[nextIrq]);
+      if (late > o.irqLateMaxUs) o.irqLateMaxUs = late;
+      nextIrq++;
+    }
+    if (s.runReady() == 0) {
+      uint64_t next = g_now + s.usUntilNext();
+      if (nextIrq < irqs.size() && irqs[nextIrq] < next) next = irqs[nextIrq];
+      g_now = next > g_now ? next : g_now + 1;
+    }
+  }
+  for (int id : ids) o.stats.push_back(s.stats(id));
+  return o;
+}
+
+// Alte Struktur: jede Runde alle Timer in fester Reihenfolge prüfen
+static Outcome runFixed(const std::vector<SimJob>& jobs, double seconds, const std::vector<uint64_t>& irqs){
+  g_now = 0;
+  Outcome o;
+  o.stats.resize(jobs.size());
+  std::vector<uint64_t> last(jobs.size(), 0), due(jobs.size(), 0);
+  size_t nextIrq = 0;
+  const uint64_t end = (uint64_t)(seconds * 1e6);
+  while (g_now < end) {
+    bool irq = false;
+    uint64_t irqAt = 0;
+    while (nextIrq < irqs.size() && irqs[nextIrq] <= g_now) { irq = true; irqAt = irqs[nextIrq++]; }
+    if (irq && g_now - irqAt > o.irqLateMaxUs) o.irqLateMaxUs = (uint32_t)(g_now - irqAt);
+    bool ran = false;
+    for (size_t k = 0; k < jobs.size(); k++) {
+      const SimJob& j = jobs[k];
+      const bool periodic = j.periodUs && g_now - last[k] >= j.periodUs;
+      const bool event = j.irq && irq;
+      if (!periodic && !event) continue;
+      const uint64_t rel = periodic ? last[k] + j.periodUs : irqAt;
+      if (periodic) last[k] = g_now;
+      const uint64_t start = g_now;
+      runCost(const_cast<SimJob*>(&j));
+      JobStats& s = o.stats[k];
+      const uint32_t run = (uint32_t)(g_now - start), late = (uint32_t)(start - rel);
+      s.runs++;
+      s.runSumUs += run;
+      s.lateSumUs += late;
+      if (run > s.runMaxUs) s.runMaxUs = run;
+      if (late > s.lateMaxUs) s.lateMaxUs = late;
+      if (g_now - rel > j.deadlineUs) s.misses++;
+      if (j.budgetUs && run > j.budgetUs) s.overruns++;
+      ran = true;
+    }
+    if (!ran) g_now += 50;   // Leerlauf-Runde
+  }
+  return o;
+}
+
+static void report(const char* title, const std::vector<SimJob>& jobs, const Outcome& o){
+  printf("%s\n", title);
+  printf("  %-9s %6s %8s %8s %7s %7s %7s %7s\n", "job", "runs", "run avg", "run max", "late", "max", "miss", "skip");
+  for (size_t k = 0; k < jobs.size(); k++) {
+    const JobStats& s = o.stats[k];
+    printf("  %-9s %6u %6uus %6uus %5uus %5uus %7u %7u%s\n", jobs[k].name, s.runs, s.runAvgUs(), s.runMaxUs,
+           s.lateAvgUs(), s.lateMaxUs, s.misses, s.skipped, s.overruns ? "  OVERRUN" : "");
+  }
+  printf("  IRQ -> Loop bemerkt: max %u us\n", o.irqLateMaxUs);
+}
+
+static int g_failed = 0;
+static void check(bool ok, const char* what){
+  printf("  [%s] %s\n", ok ? " ok " : "FAIL", what);
+  if (!ok) g_failed++;
+}
+
+// Job läuft länger als seine Periode: wird während des eigenen Laufs neu
+// freigegeben und wäre ohne Sperre im selben Durchgang gleich wieder dran
+static int g_slowRuns = 0;
+static void slowJob(void*){ g_slowRuns++; g_now += 150; }
+static void idleJob(void*){}
+
+static bool oncePerPass(){
+  g_now = 0;
+  Scheduler s;
+  s.begin(simClock);
+  s.add("slow", slowJob, nullptr, 100, 100, 1);
+  s.add("idle", idleJob, nullptr, 10000, 10000, 0);
+  g_slowRuns = 0;
+  const size_t n = s.runReady();
+  return n == 2 && g_slowRuns == 1;
+}
+
+int main(int argc, char** argv){
+  const double seconds = argc > 1 ? atof(argv[1]) : 20.0;
+
+  // Ohne HUD-Block: Auslastung ~35 %, alle Laufzeiten klein gegen Deadlines
+  std::vector<SimJob> light = {
+    {"input",     1000, 1000, 3,  40, 150,    0, false},
+    {"touchreq",  5000, 1000, 3,  15,  30,    0, true },
+    {"imureq",    2000, 2000, 2,  15,  30,    0, false},
+    {"rs485",     1000, 2000, 2,  20, 120,    0, false},
+    {"hud",      33000, 33000, 1, 800, 1500, 2000, false},
+    {"console",  10000, 50000, 0,  10,  40,    0, false},
+  };
+  const std::vector<uint64_t> irqs = makeIrqs(seconds);
+
+  Outcome a = runEdf(light, seconds, irqs);
+  report("EDF, ohne blockierenden Job:", light, a);
+  uint32_t misses = 0;
+  for (auto& s : a.stats) misses += s.misses;
+  check(misses == 0, "keine Deadline-Verfehlung bei Auslastung < 100 % und kurzen Jobs");
+
+  // HUD zeichnet voll (SPI) ~10 ms: nicht präemptiv -> blockiert die anderen
+  std::vector<SimJob> heavy = light;
+  heavy[4].costMinUs = 8000;
+  heavy[4].costMaxUs = 12000;
+  heavy[4].budgetUs  = 10000;
+  Outcome b = runEdf(heavy, seconds, irqs);
+  Outcome c = runFixed(heavy, seconds, irqs);
+  printf("\n");
+  report("EDF, HUD 8-12 ms:", heavy, b);
+  printf("\n");
+  report("Feste Reihenfolge (alter Loop), HUD 8-12 ms:", heavy, c);
+  printf("\n");
+
+  bool bounded = true;
+  for (size_t k = 0; k < heavy.size(); k++) {
+    uint32_t blockMax = 0;
+    for (size_t m = 0; m < heavy.size(); m++) if (m != k && heavy[m].costMaxUs > blockMax) blockMax = heavy[m].costMaxUs;
+    // Obergrenze: ein fremder Job läuft gerade + alle dringlicheren je einmal
+    uint32_t bound = blockMax;
+    for (size_t m = 0; m < heavy.size(); m++) if (m != k && heavy[m].deadlineUs <= heavy[k].deadlineUs) bound += heavy[m].costMaxUs;
+    if (b.stats[k].lateMaxUs > bound + heavy[k].costMaxUs) {
+      bounded = false;
+      printf("  %s: Verspätung %u us > Schranke %u us\n", heavy[k].name, b.stats[k].lateMaxUs, bound);
+    }
+  }
+  check(bounded, "Verspätung je Job begrenzt durch längsten fremden Job + dringlichere Jobs");
+  check(b.irqLateMaxUs <= heavy[4].costMaxUs + 200, "IRQ wird spätestens nach dem laufenden Job bemerkt");
+  check(b.stats[4].overruns > 0, "HUD-Budgetüberschreitung wird gezählt");
+  check(b.stats[0].skipped > 0, "ausgelassene Eingabe-Perioden während des HUD-Blocks werden gezählt");
+  check(b.stats[0].lateMaxUs <= c.stats[0].lateMaxUs + heavy[0].costMaxUs, "EDF: Eingabe nicht später als im alten Loop (+ eine Eingabe-Laufzeit)");
+  printf("\n");
+
+  // Überlast: Konsole mit langer Laufzeit darf Eingabe nicht dauerhaft verdrängen
+  std::vector<SimJob> over = light;
+  over[5].costMinUs = 3000;
+  over[5].costMaxUs = 6000;
+  over[5].periodUs  = 4000;
+  over[5].deadlineUs = 50000;
+  over[5].budgetUs  = 1000;
+  Outcome d = runEdf(over, seconds, irqs);
+  report("EDF, Konsole in Dauerlast (Auslastung > 100 %):", over, d);
+  const double inputRate = d.stats[0].runs / seconds;
+  check(inputRate > 150, "Eingabe läuft weiter (> 150/s) trotz Überlast");
+  check(d.stats[5].skipped > 0 && d.stats[5].overruns > 0, "Überlast sichtbar: Perioden ausgelassen, Budget überschritten");
+  printf("\n");
+
+  check(oncePerPass(), "runReady(): neu freigegebener Job läuft erst im nächsten Durchgang");
+
+  printf("\n%s (%d Fehler)\n", g_failed ? "FAIL" : "OK", g_failed);
+  return g_failed ? 1 : 0;
+}
@@ -0,0 +1,150 @@
+// ============================================================================
+// File: tools/snapshot_test.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Test der Kern-Übergabe (src/core/Snapshot.h) mit Threads
+//  • Schreiber-Thread füllt jeden Stand mit einem Muster aus der Sequenz-
+//    nummer; Leser prüfen, dass kein Stand zerrissen ist (alle Felder
+//    passen zur Sequenz) und die Sequenz nie rückwärts läuft
+//  • TripleBuffer: ein Leser; Seqlock: mehrere Leser
+//  • Ausgabe: gelesene Stände, übersprungene Stände, Lese-Wiederholungen
+// Usage: snapshot_test [sekunden=2]
+// Build: g++ -O2 -std=c++17 -pthread tools/snapshot_test.cpp -o snapshot_test
+//        (mit -fsanitize=thread zusätzlich auf Data Races prüfen)
+// ============================================================================
+#include "../src/core/Snapshot.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Groß genug, dass ein Kopiervorgang mehrere Cachezeilen überspannt
+struct Sample {
+  uint32_t seq;
+  uint32_t fill[45];
+  uint32_t check;
+};
+
+static void fillSample(Sample& s, uint32_t seq){
+  s.seq = seq;
+  for (size_t i = 0; i < 45; i++) s.fill[i] = seq * 2654435761u + (uint32_t)i;
+  s.check = ~seq;
+}
+
+static bool consistent(const Sample& s){
+  if (s.check != ~s.seq) return false;
+  for (size_t i = 0; i < 45; i++) if (s.fill[i] != s.seq * 2654435761u + (uint32_t)i) return false;
+  return true;
+}
+
+struct ReaderResult {
+  uint64_t reads = 0;
+  uint64_t torn = 0;
+  uint64_t backwards = 0;
+  uint64_t failed = 0;       // Seqlock: maxTries erschöpft
+  uint32_t lastSeq = 0;
+};
+
+static int g_failed = 0;
+static void check(bool ok, const char* what){
+  printf("  [%s] %s\n", ok ? " ok " : "FAIL", what);
+  if (!ok) g_failed++;
+}
+
+static void testTriple(double seconds){
+  TripleBuffer<Sample> tb;
+  std::atomic<bool> stop{false};
+  std::atomic<uint32_t> written{0};
+
+  std::thread writer([&]{
+    uint32_t seq = 0;
+    while (!stop.load(std::memory_order_relaxed)) {
+      fillSample(tb.back(), ++seq);
+      tb.publish();
+      if ((seq & 15) == 0) std::this_thread::yield();   // auch auf 1 CPU verzahnen
+    }
+    written = seq;
+  });
+
+  ReaderResult r;
+  uint64_t updates = 0;
+  const auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+  while (std::chrono::steady_clock::now() < end) {
+    if (!tb.update()) { std::this_thread::yield(); continue; }
+    updates++;
+    const Sample& s = tb.front();
+    r.reads++;
+    if (!consistent(s)) r.torn++;
+    if (s.seq <= r.lastSeq) r.backwards++;
+    r.lastSeq = s.seq;
+  }
+  stop = true;
+  writer.join();
+  // nach Ende des Schreibers muss der letzte Stand ankommen
+  const bool finalSeen = tb.update() ? tb.front().seq == written.load() : r.lastSeq == written.load();
+
+  printf("TripleBuffer: %u veröffentlicht, %llu übernommen (%.1f %%)\n", written.load(),
+         (unsigned long long)updates, written ? 100.0 * updates / written : 0.0);
+  check(r.torn == 0, "kein zerrissener Stand");
+  check(r.backwards == 0, "Sequenz läuft nie rückwärts und kein Stand doppelt");
+  check(finalSeen, "letzter Stand kommt an");
+  check(updates > 1000, "Leser bekommt laufend neue Stände");
+}
+
+static void testSeqlock(double seconds, unsigned readers){
+  Seqlock<Sample> sl;
+  std::atomic<bool> stop{false};
+  std::atomic<uint32_t> written{0};
+  std::vector<ReaderResult> res(readers);
+
+  std::thread writer([&]{
+    uint32_t seq = 0;
+    Sample s;
+    while (!stop.load(std::memory_order_relaxed)) {
+      fillSample(s, ++seq);
+      sl.write(s);
+      if ((seq & 15) == 0) std::this_thread::yield();
+    }
+    written = seq;
+  });
+  std::vector<std::thread> rt;
+  for (unsigned k = 0; k < readers; k++) {
+    rt.emplace_back([&, k]{
+      ReaderResult& r = res[k];
+      Sample s;
+      while (!stop.load(std::memory_order_relaxed)) {
+        if (!sl.read(s)) { r.failed++; std::this_thread::yield(); continue; }
+        r.reads++;
+        if (s.seq == 0) continue;                 // noch nichts geschrieben
+        if (!consistent(s)) r.torn++;
+        if (s.seq < r.lastSeq) r.backwards++;
+        r.lastSeq = s.seq;
+      }
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  stop = true;
+  writer.join();
+  for (auto& t : rt) t.join();
+
+  Sample last;
+  const bool finalOk = sl.read(last) && last.seq == written.load() && consistent(last);
+  uint64_t reads = 0, torn = 0, back = 0, failed = 0;
+  for (auto& r : res) { reads += r.reads; torn += r.torn; back += r.backwards; failed += r.failed; }
+  printf("Seqlock: %u geschrieben, %u Leser, %llu gelesen, %llu Lesevorgänge nach 16 Versuchen aufgegeben\n",
+         written.load(), readers, (unsigned long long)reads, (unsigned long long)failed);
+  check(torn == 0, "kein zerrissener Stand");
+  check(back == 0, "Sequenz läuft je Leser nie rückwärts");
+  check(finalOk, "letzter Stand lesbar");
+  check(reads > 1000, "Leser kommen trotz Dauerschreiber durch");
+}
+
+int main(int argc, char** argv){
+  const double seconds = argc > 1 ? atof(argv[1]) : 2.0;
+  testTriple(seconds);
+  printf("\n");
+  testSeqlock(seconds, 3);
+  printf("\n%s (%d Fehler)\n", g_failed ? "FAIL" : "OK", g_failed);
+  return g_failed ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+// ============================================================================
+// File: tools/stall_test.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Test des Stall-Monitors (src/core/StallMonitor.cpp)
+//  • Virtuelle Zeit; ein simulierter Loop mit kurzen Durchläufen, in den
+//    künstliche Stalls an bekannten Stellen eingestreut werden
+//    (RS485-flush, Serial-Ausgabe, synchroner I²C-Transfer, HUD)
+//  • Prüft:
+//     1) Histogramm zählt jeden Durchlauf, Perzentile/Max passen
+//     2) jeder Stall > Budget wird der eingespritzten Stelle zugeordnet
+//     3) verschachtelte Scopes buchen Eigenzeit (Konsole -> RS485-Write)
+//     4) Scopes anderer Tasks zählen nicht
+//     5) Worst-Tabelle absteigend, begrenzt, behält die größten Stalls
+//     6) Stall ohne markierten Aufruf bleibt unzugeordnet ("-")
+// Usage: stall_test [durchläufe=200000]
+// Build: g++ -O2 -std=c++17 tools/stall_test.cpp src/core/StallMonitor.cpp -o stall_test
+// ============================================================================
+#include "../src/core/StallMonitor.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static uint64_t g_now = 0;
+static bool     g_inLoop = true;      // "läuft der Aufrufer im Loop-Task?"
+static uint32_t simClock(){ return (uint32_t)g_now; }
+static bool     simOwner(){ return g_inLoop; }
+static std::mt19937 g_rng(7);
+
+static int g_failed = 0;
+static void check(bool ok, const char* what){
+  printf("  [%s] %s\n", ok ? " ok " : "FAIL", what);
+  if (!ok) g_failed++;
+}
+
+// Blockierender Aufruf an Stelle s, der us Mikrosekunden dauert
+static void block(BlockSite s, uint32_t us){
+  BLOCKING_SCOPE(s);
+  g_now += us;
+}
+
+struct Injected { uint32_t iterUs; BlockSite site; };
+
+static void report(const StallMonitor& m){
+  printf("  iter=%u mean=%uus p50=%uus p99=%uus max=%uus stalls=%u (budget %uus)\n",
+         m.iterations(), m.iterMeanUs(), m.percentile(0.50f), m.percentile(0.99f),
+         m.iterMaxUs(), m.stalls(), m.budgetUs());
+  printf("  %-10s %7s %8s %8s %7s\n", "site", "calls", "avg/us", "max/us", "stalls");
+  for (uint8_t i = 0; i < (uint8_t)BlockSite::Count; i++) {
+    const BlockSiteStats& s = m.siteStats((BlockSite)i);
+    printf("  %-10s %7u %8u %8u %7u\n", blockSiteName((BlockSite)i), s.calls,
+           s.calls ? (uint32_t)(s.sumUs / s.calls) : 0u, s.maxUs, s.stalls);
+  }
+  printf("  worst:");
+  for (size_t i = 0; i < m.worstCount(); i++) printf(" %u(%s)", m.worst(i).iterUs, blockSiteName(m.worst(i).site));
+  printf("\n");
+}
+
+int main(int argc, char** argv){
+  const uint32_t iterations = argc > 1 ? (uint32_t)atoi(argv[1]) : 200000;
+  const uint32_t budget = 5000;
+
+  StallMonitor m;
+  m.begin(simClock, simOwner, budget);
+  m.install();
+
+  // Kurze Durchläufe 20..200 µs, dazu in ~0,1 % der Durchläufe ein Stall
+  // an einer zufälligen Stelle (6..40 ms)
+  const BlockSite stallSites[] = {BlockSite::Rs485Write, BlockSite::SerialOut,
+                                  BlockSite::I2CSync, BlockSite::Display};
+  std::uniform_int_distribution<uint32_t> work(20, 200);
+  std::uniform_int_distribution<uint32_t> stallLen(6000, 40000);
+  std::uniform_int_distribution<uint32_t> pick(0, 999);
+  std::vector<Injected> injected;
+  bool attributed = true;
+  uint32_t lastStalls = 0;
+
+  m.iterationStart();
+  for (uint32_t i = 0; i < iterations; i++) {
+    const uint64_t t0 = g_now;
+    g_now += work(g_rng);
+    block(BlockSite::Console, 2);                  // kurzer, harmloser Aufruf
+    const uint32_t p = pick(g_rng);
+    if (p < 4) {
+      const BlockSite s = stallSites[p];
+      block(s, stallLen(g_rng));
+      injected.push_back({0, s});
+    } else if (p == 4) {
+      // Anderer Task blockiert lange: darf dem Loop nicht zugeordnet werden
+      g_inLoop = false;
+      block(BlockSite::I2CSync, 50000);
+      g_inLoop = true;
+      g_now = t0 + 100;                            // Loop selbst war nicht betroffen
+    }
+    m.iterationStart();
+    if (!injected.empty() && injected.back().iterUs == 0 && p < 4) {
+      injected.back().iterUs = (uint32_t)(g_now - t0);
+      if (m.stalls() != lastStalls + 1) attributed = false;
+    }
+    lastStalls = m.stalls();
+  }
+  printf("Zufällige Stalls (%zu eingespritzt, Budget %u us):\n", injected.size(), budget);
+  report(m);
+
+  check(m.iterations() == iterations, "Histogramm zählt jeden Durchlauf");
+  uint32_t binSum = 0;
+  for (uint8_t b = 0; b < StallMonitor::BUCKETS; b++) binSum += m.bin(b);
+  check(binSum == iterations, "Summe der Buckets = Durchläufe");
+  check(m.percentile(0.50f) <= 255, "p50 im Bereich der kurzen Durchläufe");
+  uint32_t injMax = 0;
+  for (auto& j : injected) if (j.iterUs > injMax) injMax = j.iterUs;
+  check(m.iterMaxUs() == injMax, "Max = längster eingespritzter Stall");
+  check(m.stalls() == injected.size() && attributed, "jeder eingespritzte Stall wird als Stall erkannt");
+
+  bool sitesOk = true;
+  for (uint8_t i = 0; i < 4; i++) {
+    uint32_t n = 0;
+    for (auto& j : injected) if (j.site == stallSites[i]) n++;
+    if (m.siteStats(stallSites[i]).stalls != n) sitesOk = false;
+  }
+  check(sitesOk, "Stalls je Stelle = eingespritzte Stalls je Stelle");
+  check(m.siteStats(BlockSite::I2CSync).maxUs <= 40000, "Scopes anderer Tasks zählen nicht");
+
+  std::vector<Injected> sorted = injected;
+  std::sort(sorted.begin(), sorted.end(), [](const Injected& a, const Injected& b){ return a.iterUs > b.iterUs; });
+  bool worstOk = m.worstCount() == (injected.size() < StallMonitor::WORST ? injected.size() : StallMonitor::WORST);
+  for (size_t i = 0; i < m.worstCount() && worstOk; i++) {
+    if (m.worst(i).iterUs != sorted[i].iterUs) worstOk = false;
+    if (i && m.worst(i).iterUs > m.worst(i - 1).iterUs) worstOk = false;
+  }
+  check(worstOk, "Worst-Tabelle hält die größten Stalls absteigend");
+  printf("\n");
+
+  // Verschachtelt: Konsolenbefehl schreibt auf RS485 (flush 9 ms),
+  // die Konsole selbst gibt 1 ms aus -> RS485 ist der Verursacher
+  printf("Verschachtelte Scopes / unzugeordneter Stall:\n");
+  m.reset();
+  m.iterationStart();
+  {
+    BLOCKING_SCOPE(BlockSite::Console);
+    g_now += 1000;
+    block(BlockSite::Rs485Write, 9000);
+  }
+  m.iterationStart();
+  const StallRecord n = m.worst(0);
+  printf("  verschachtelt: iter=%uus site=%s site/us=%u blocked/us=%u\n",
+         n.iterUs, blockSiteName(n.site), n.siteUs, n.blockedUs);
+  check(m.stalls() == 1 && n.site == BlockSite::Rs485Write && n.siteUs == 9000 && n.blockedUs == 10000,
+        "verschachtelter Stall: Eigenzeit, innerer Aufruf als Verursacher");
+  check(m.siteStats(BlockSite::Console).maxUs == 1000, "äußerer Scope bucht nur seine Eigenzeit");
+
+  // Reine Rechenlast ohne markierten Aufruf
+  g_now += 7000;
+  m.iterationStart();
+  check(m.stalls() == 2 && m.worst(1).site == BlockSite::Count, "Stall ohne markierten Aufruf bleibt unzugeordnet");
+
+  // Budget zur Laufzeit anheben: derselbe Durchlauf ist kein Stall mehr
+  m.setBudget(20000);
+  g_now += 7000;
+  m.iterationStart();
+  check(m.stalls() == 2, "Budget zur Laufzeit änderbar");
+
+  printf("\n%s (%d Fehler)\n", g_failed ? "FAIL" : "OK", g_failed);
+  return g_failed ? 1 : 0;
+}
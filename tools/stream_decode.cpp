@@ -0,0 +1,363 @@
+// ============================================================================
+// File: tools/stream_decode.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Decoder für den USB-Messdaten-Strom (src/comm/UsbStreamProto.cpp)
+//  decode <datei|-> [--csv <prefix>] [--columnar <dir>]
+//      Chunks an 0x00 trennen, COBS/CRC prüfen (Konsolentext fällt heraus),
+//      Sequenzlücken zählen, Zusammenfassung inkl. Stats-Records der Firmware
+//      --csv:      <prefix>_imu.csv, _touch.csv, _gesture.csv, _stats.csv
+//      --columnar: je Spalte eine Binärdatei <tabelle>.<spalte> (little-endian,
+//                  z.B. numpy.fromfile) + schema.txt mit Typ und Zeilenzahl
+//  selftest [records] [out.bin]
+//      Synthetischer Strom (IMU 500 Hz, Touch, Gesten) mit eingestreutem Text:
+//      Round-Trip-Vergleich, Byte je Record gegenüber Rohformat; optional
+//      den Strom als Beispieldatei für "decode" schreiben
+// Mitschnitt: stty -F /dev/ttyACM0 raw; cat /dev/ttyACM0 > cap.bin ("stream on")
+// Build: g++ -O2 -std=c++17 tools/stream_decode.cpp src/comm/UsbStreamProto.cpp src/comm/TelemetryProto.cpp -o stream_decode
+// ============================================================================
+#include "../src/comm/UsbStreamProto.h"
+#include "../src/comm/TelemetryProto.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace usbstream;
+
+// ---------------------------- Ausgabe ----------------------------------------
+// Spaltenweise Binärdateien, angelegt beim ersten Wert
+class ColumnStore {
+public:
+  explicit ColumnStore(const std::string& dir) : _dir(dir) {}
+  ~ColumnStore(){
+    FILE* schema = fopen((_dir + "/schema.txt").c_str(), "w");
+    for (auto& kv : _cols) {
+      if (schema) fprintf(schema, "%s %s %zu\n", kv.first.c_str(), kv.second.type, kv.second.rows);
+      fclose(kv.second.f);
+    }
+    if (schema) fclose(schema);
+  }
+  template <typename T>
+  void put(const char* table, const char* col, const char* type, T v){
+    const std::string key = std::string(table) + "." + col;
+    auto it = _cols.find(key);
+    if (it == _cols.end()) {
+      Column c{fopen((_dir + "/" + key).c_str(), "wb"), type, 0};
+      if (!c.f) { perror(key.c_str()); exit(1); }
+      it = _cols.emplace(key, c).first;
+    }
+    fwrite(&v, sizeof(v), 1, it->second.f);   // Host ist little-endian
+    it->second.rows++;
+  }
+private:
+  struct Column { FILE* f; const char* type; size_t rows; };
+  std::string _dir;
+  std::map<std::string, Column> _cols;
+};
+
+struct Sink {
+  FILE* imu = nullptr;
+  FILE* touch = nullptr;
+  FILE* gesture = nullptr;
+  FILE* stats = nullptr;
+  ColumnStore* cols = nullptr;
+
+  // Zeitbasis: micros() läuft nach ~71 min über -> 64 bit fortschreiben
+  uint64_t wrap = 0;
+  uint32_t lastUs = 0;
+  bool     haveUs = false;
+
+  size_t   counts[4] = {0, 0, 0, 0};
+  uint64_t firstT = 0, lastT = 0;
+  StatsVals lastStats{};
+  bool     haveStats = false;
+
+  uint64_t unwrap(uint32_t us){
+    if (haveUs && us < lastUs && lastUs - us > 0x80000000u) wrap += 1ull << 32;
+    lastUs = us;
+    haveUs = true;
+    return wrap + us;
+  }
+};
+
+static void onRecord(const Record& r, void* ctx){
+  Sink& s = *static_cast<Sink*>(ctx);
+  const uint64_t t = s.unwrap(r.us);
+  if (!s.counts[0] && !s.counts[1] && !s.counts[2] && !s.counts[3]) s.firstT = t;
+  s.lastT = t;
+  s.counts[(int)r.type]++;
+  switch (r.type) {
+    case RecType::Imu:
+      if (s.imu) fprintf(s.imu, "%llu,%d,%d,%d,%d,%d,%d\n", (unsigned long long)t,
+                         r.imu.ax, r.imu.ay, r.imu.az, r.imu.gx, r.imu.gy, r.imu.gz);
+      if (s.cols) {
+        s.cols->put("imu", "t_us", "u64", t);
+        s.cols->put("imu", "ax_mg", "i16", r.imu.ax);
+        s.cols->put("imu", "ay_mg", "i16", r.imu.ay);
+        s.cols->put("imu", "az_mg", "i16", r.imu.az);
+        s.cols->put("imu", "gx_ddps", "i16", r.imu.gx);
+        s.cols->put("imu", "gy_ddps", "i16", r.imu.gy);
+        s.cols->put("imu", "gz_ddps", "i16", r.imu.gz);
+      }
+      break;
+    case RecType::Touch:
+      // eine Zeile je Punkt; leerer Frame (alle losgelassen) als slot=-1
+      for (int i = 0; i < (r.count ? r.count : 1); i++) {
+        const bool none = r.count == 0;
+        const TouchVals& p = r.touch[i];
+        if (s.touch) {
+          if (none) fprintf(s.touch, "%llu,0,-1,,,\n", (unsigned long long)t);
+          else fprintf(s.touch, "%llu,%u,%u,%u,%u,%u\n", (unsigned long long)t, r.count, p.slot, p.x, p.y, p.strength);
+        }
+        if (s.cols) {
+          s.cols->put("touch", "t_us", "u64", t);
+          s.cols->put("touch", "count", "u8", r.count);
+          s.cols->put("touch", "slot", "i8", (int8_t)(none ? -1 : p.slot));
+          s.cols->put("touch", "x", "u16", none ? (uint16_t)0 : p.x);
+          s.cols->put("touch", "y", "u16", none ? (uint16_t)0 : p.y);
+          s.cols->put("touch", "strength", "u16", none ? (uint16_t)0 : p.strength);
+        }
+      }
+      break;
+    case RecType::Gesture:
+      if (s.gesture) fprintf(s.gesture, "%llu,%u,%u,%u,%u,%.3f\n", (unsigned long long)t, r.gesture.type,
+                             r.gesture.fingers, r.gesture.x, r.gesture.y, r.gesture.valueMilli / 1000.0);
+      if (s.cols) {
+        s.cols->put("gesture", "t_us", "u64", t);
+        s.cols->put("gesture", "type", "u8", r.gesture.type);
+        s.cols->put("gesture", "fingers", "u8", r.gesture.fingers);
+        s.cols->put("gesture", "x", "u16", r.gesture.x);
+        s.cols->put("gesture", "y", "u16", r.gesture.y);
+        s.cols->put("gesture", "value_milli", "i32", r.gesture.valueMilli);
+      }
+      break;
+    case RecType::Stats:
+      s.lastStats = r.stats;
+      s.haveStats = true;
+      if (s.stats) fprintf(s.stats, "%llu,%u,%u,%u,%u\n", (unsigned long long)t, r.stats.records,
+                           r.stats.dropped, r.stats.ringHigh, r.stats.recPerSec);
+      break;
+  }
+}
+
+// ---------------------------- Chunk-Zerlegung --------------------------------
+struct SplitResult {
+  size_t chunks = 0;
+  size_t bad = 0;          // CRC/COBS/Version (z.B. Konsolentext)
+  size_t seqGaps = 0;      // verlorene Chunks
+  size_t bytes = 0;
+};
+
+static SplitResult decodeStream(const std::vector<uint8_t>& in, RecordVisitor visit, void* ctx){
+  SplitResult res;
+  res.bytes = in.size();
+  std::vector<uint8_t> raw;
+  bool haveSeq = false;
+  uint32_t lastSeq = 0;
+  size_t start = 0;
+  for (size_t i = 0; i < in.size(); i++) {
+    if (in[i] != 0x00) continue;
+    const size_t n = i - start;
+    if (n > 0) {
+      raw.resize(n);
+      const size_t r = telem::cobsDecode(in.data() + start, n, raw.data(), raw.size());
+      uint32_t seq = 0;
+      if (r && decodeChunk(raw.data(), r, seq, visit, ctx)) {
+        if (haveSeq && seq != lastSeq + 1) res.seqGaps += seq > lastSeq ? seq - lastSeq - 1 : 1;
+        lastSeq = seq;
+        haveSeq = true;
+        res.chunks++;
+      } else {
+        res.bad++;
+      }
+    }
+    start = i + 1;
+  }
+  return res;
+}
+
+static std::vector<uint8_t> readAll(const char* path){
+  FILE* f = strcmp(path, "-") ? fopen(path, "rb") : stdin;
+  if (!f) { perror(path); exit(1); }
+  std::vector<uint8_t> buf;
+  uint8_t tmp[65536];
+  size_t n;
+  while ((n = fread(tmp, 1, sizeof(tmp), f)) > 0) buf.insert(buf.end(), tmp, tmp + n);
+  if (f != stdin) fclose(f);
+  return buf;
+}
+
+static FILE* openCsv(const std::string& prefix, const char* name, const char* header){
+  const std::string path = prefix + "_" + name + ".csv";
+  FILE* f = fopen(path.c_str(), "w");
+  if (!f) { perror(path.c_str()); exit(1); }
+  fprintf(f, "%s\n", header);
+  return f;
+}
+
+static int cmdDecode(int argc, char** argv){
+  const char* path = argv[0];
+  const char* csv = nullptr;
+  const char* dir = nullptr;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (!strcmp(argv[i], "--csv")) csv = argv[i + 1];
+    else if (!strcmp(argv[i], "--columnar")) dir = argv[i + 1];
+  }
+  Sink s;
+  if (csv) {
+    s.imu     = openCsv(csv, "imu", "t_us,ax_mg,ay_mg,az_mg,gx_ddps,gy_ddps,gz_ddps");
+    s.touch   = openCsv(csv, "touch", "t_us,count,slot,x,y,strength");
+    s.gesture = openCsv(csv, "gesture", "t_us,type,fingers,x,y,value");
+    s.stats   = openCsv(csv, "stats", "t_us,records,dropped,ring_high,rec_per_s");
+  }
+  ColumnStore* cols = dir ? new ColumnStore(dir) : nullptr;
+  s.cols = cols;
+
+  const std::vector<uint8_t> in = readAll(path);
+  const SplitResult r = decodeStream(in, onRecord, &s);
+
+  const double secs = (s.lastT - s.firstT) / 1e6;
+  const size_t total = s.counts[0] + s.counts[1] + s.counts[2] + s.counts[3];
+  printf("%zu Byte, %zu Chunks, %zu verworfen (Text/CRC), %zu Chunks verloren (Sequenz)\n",
+         r.bytes, r.chunks, r.bad, r.seqGaps);
+  printf("Records: %zu (imu %zu, touch %zu, gesture %zu, stats %zu) über %.2f s",
+         total, s.counts[0], s.counts[1], s.counts[2], s.counts[3], secs);
+  if (secs > 0) printf(" = %.0f Records/s, %.0f B/s", total / secs, r.bytes / secs);
+  printf("\n");
+  if (s.haveStats) {
+    printf("Firmware: %u Records, %u/s, Ring-Überläufe %u, Ring max. %u\n",
+           s.lastStats.records, s.lastStats.recPerSec, s.lastStats.dropped, s.lastStats.ringHigh);
+  }
+  for (FILE* f : {s.imu, s.touch, s.gesture, s.stats}) if (f) fclose(f);
+  delete cols;
+  return 0;
+}
+
+// ---------------------------- Selbsttest -------------------------------------
+struct Collect {
+  std::vector<Record> out;
+};
+
+static void onCollect(const Record& r, void* ctx){ static_cast<Collect*>(ctx)->out.push_back(r); }
+
+static bool sameRecord(const Record& a, const Record& b){
+  if (a.type != b.type || a.us != b.us) return false;
+  switch (a.type) {
+    case RecType::Imu:
+      return !memcmp(&a.imu, &b.imu, sizeof(a.imu));
+    case RecType::Touch:
+      if (a.count != b.count) return false;
+      for (int i = 0; i < a.count; i++) {
+        const TouchVals &p = a.touch[i], &q = b.touch[i];
+        if (p.slot != q.slot || p.x != q.x || p.y != q.y || p.strength != q.strength) return false;
+      }
+      return true;
+    case RecType::Gesture:
+      return a.gesture.type == b.gesture.type && a.gesture.fingers == b.gesture.fingers &&
+             a.gesture.x == b.gesture.x && a.gesture.y == b.gesture.y &&
+             a.gesture.valueMilli == b.gesture.valueMilli;
+    case RecType::Stats:
+      return !memcmp(&a.stats, &b.stats, sizeof(a.stats));
+  }
+  return false;
+}
+
+static int cmdSelftest(size_t n, const char* outPath){
+  std::mt19937 rng(5);
+  std::normal_distribution<float> noise(0.f, 4.f);
+  std::vector<Record> recs;
+  uint32_t us = 0xFFF00000u;   // Überlauf von micros() mittesten
+  for (size_t i = 0; i < n; i++) {
+    Record r;
+    memset(&r, 0, sizeof(r));
+    us += 2000;                                        // 500 Hz Grundtakt
+    r.us = us;
+    const float ph = i * 0.01f;
+    if (i % 5 == 4) {                                  // Touch ~100 Hz, 2 Finger
+      r.type  = RecType::Touch;
+      r.count = (i / 500) % 3;
+      for (int k = 0; k < r.count; k++) {
+        r.touch[k].slot     = (uint8_t)k;
+        r.touch[k].x        = (uint16_t)(160 + 100 * std::sin(ph + k));
+        r.touch[k].y        = (uint16_t)(120 + 80 * std::cos(ph + k));
+        r.touch[k].strength = (uint16_t)(40 + (i % 7));
+      }
+    } else if (i % 997 == 0) {
+      r.type               = RecType::Gesture;
+      r.gesture.type       = (uint8_t)(1 + i % 13);
+      r.gesture.fingers    = 1;
+      r.gesture.x          = 100;
+      r.gesture.y          = 200;
+      r.gesture.valueMilli = -(int32_t)i;
+    } else if (i % 2000 == 1) {
+      r.type = RecType::Stats;
+      r.stats = StatsVals{(uint32_t)i, 3, 17, 612};
+    } else {
+      r.type   = RecType::Imu;
+      r.imu.ax = (int16_t)(30 + noise(rng));
+      r.imu.ay = (int16_t)(-12 + noise(rng));
+      r.imu.az = (int16_t)(1000 + 300 * std::sin(ph) + noise(rng));
+      r.imu.gx = (int16_t)(noise(rng) * 2);
+      r.imu.gy = (int16_t)(noise(rng) * 2);
+      r.imu.gz = (int16_t)(500 * std::sin(ph * 3));
+    }
+    recs.push_back(r);
+  }
+
+  // Kodieren wie UsbStream (0x00 vor und nach dem Chunk), nach jedem 7. Chunk Konsolentext
+  std::vector<uint8_t> wire;
+  uint8_t raw[1024], enc[1100];
+  ChunkEncoder ce;
+  uint32_t seq = 0;
+  size_t chunks = 0;
+  auto flush = [&](){
+    size_t m = telem::cobsEncode(raw, ce.finish(), enc);
+    wire.push_back(0x00);
+    wire.insert(wire.end(), enc, enc + m);
+    wire.push_back(0x00);
+    if (++chunks % 7 == 0) {
+      const char* text = "[GESTURE] Touch count changed: 2\n";
+      wire.insert(wire.end(), text, text + strlen(text));
+    }
+    ce.begin(raw, sizeof(raw), ++seq);
+  };
+  ce.begin(raw, sizeof(raw), seq);
+  for (const Record& r : recs) {
+    if (!ce.add(r)) { flush(); ce.add(r); }
+  }
+  flush();
+
+  if (outPath) {
+    FILE* f = fopen(outPath, "wb");
+    if (!f) { perror(outPath); return 1; }
+    fwrite(wire.data(), 1, wire.size(), f);
+    fclose(f);
+  }
+
+  Collect c;
+  const SplitResult res = decodeStream(wire, onCollect, &c);
+  size_t mismatch = 0;
+  if (c.out.size() != recs.size()) mismatch = (size_t)-1;
+  else for (size_t i = 0; i < recs.size(); i++) if (!sameRecord(recs[i], c.out[i])) mismatch++;
+
+  printf("%zu Records -> %zu Chunks, %zu Byte Strom (%.2f B/Record, Rohrecord %zu B)\n",
+         recs.size(), res.chunks, wire.size(), (double)wire.size() / recs.size(), sizeof(Record));
+  printf("eingestreuter Text: %zu Stellen verworfen, Sequenzlücken: %zu\n", res.bad, res.seqGaps);
+  const bool ok = mismatch == 0 && res.seqGaps == 0 && res.chunks == chunks;
+  printf("%s\n", ok ? "OK" : "FAIL");
+  return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv){
+  if (argc >= 3 && !strcmp(argv[1], "decode")) return cmdDecode(argc - 2, argv + 2);
+  if (argc >= 2 && !strcmp(argv[1], "selftest")) {
+    return cmdSelftest(argc > 2 ? (size_t)atol(argv[2]) : 200000, argc > 3 ? argv[3] : nullptr);
+  }
+  fprintf(stderr, "usage: %s decode <datei|-> [--csv <prefix>] [--columnar <dir>]\n"
+                  "       %s selftest [records] [out.bin]\n", argv[0], argv[0]);
+  return 2;
+}
@@ -0,0 +1,292 @@
+// ============================================================================
+// File: tools/telemetry_tool.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Seite des RS485-Telemetrie-Protokolls (src/comm/TelemetryProto.cpp)
+//  decode <datei|->   Rohmitschnitt (z.B. cat /dev/ttyUSB0) -> Nachrichten,
+//                     Sequenzlücken, CRC-/COBS-Fehler
+//  bench  [mtu]       Encode/Decode-Durchsatz, Overhead Batching vs. 1 Nachricht/Frame
+//  fuzz   [n]         Zufällige Round-Trips + Bitfehler/Abschneiden; bricht beim
+//                     ersten Fehler mit Exit-Code 1 ab
+// Build: g++ -O2 -std=c++17 tools/telemetry_tool.cpp src/comm/TelemetryProto.cpp -o telemetry_tool
+// ============================================================================
+#include "../src/comm/TelemetryProto.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace telem;
+
+static const char* const GESTURE_NAMES[] = {
+  "None", "Tap", "DoubleTap", "LongPress", "SwipeLeft", "SwipeRight", "SwipeUp",
+  "SwipeDown", "PinchIn", "PinchOut", "RotateCW", "RotateCCW", "TwoFingerTap", "ThreeFingerTap"
+};
+
+static const char* const PARSE_NAMES[] = { "ok", "cobs", "short", "crc", "version", "malformed" };
+
+// ---------------------------- decode -----------------------------------------
+static void printMsg(MsgType type, const uint8_t* p, size_t n, void*){
+  switch (type) {
+    case MsgType::Gesture: {
+      GestureMsg m;
+      if (!decodeGesture(p, n, m)) break;
+      printf("  gesture %-14s fingers=%u at (%u,%u) value=%.3f age=%ums\n",
+             m.type < 14 ? GESTURE_NAMES[m.type] : "?", m.fingers, m.x, m.y,
+             m.valueMilli / 1000.0, m.ageMs);
+      return;
+    }
+    case MsgType::ImuBatch: {
+      ImuBatchMsg m;
+      if (!decodeImuBatch(p, n, m)) break;
+      printf("  imu     t0=%ums dt=%ums n=%u\n", m.t0Ms, m.dtMs, m.count);
+      for (uint8_t i = 0; i < m.count; i++) {
+        const ImuSample& s = m.s[i];
+        printf("          a=(%6d,%6d,%6d)mg g=(%7.1f,%7.1f,%7.1f)dps\n",
+               s.ax, s.ay, s.az, s.gx / 10.0, s.gy / 10.0, s.gz / 10.0);
+      }
+      return;
+    }
+    case MsgType::TouchState: {
+      TouchStateMsg m;
+      if (!decodeTouchState(p, n, m)) break;
+      printf("  touch   n=%u", m.count);
+      for (uint8_t i = 0; i < m.count; i++) printf(" [%u:(%u,%u) s=%u]", m.p[i].id, m.p[i].x, m.p[i].y, m.p[i].strength);
+      printf("\n");
+      return;
+    }
+  }
+  printf("  ? type=%u len=%zu\n", (unsigned)type, n);
+}
+
+static int decodeStream(FILE* f){
+  std::vector<uint8_t> enc, scratch;
+  uint32_t frames = 0, gaps = 0, errors[6] = {0};
+  bool haveSeq = false; uint16_t lastSeq = 0;
+  int c;
+  while ((c = fgetc(f)) != EOF) {
+    if (c != 0) { enc.push_back((uint8_t)c); continue; }
+    if (enc.empty()) continue;
+    scratch.resize(enc.size());
+    uint16_t seq = 0;
+    ParseResult r = parseFrame(enc.data(), enc.size(), scratch.data(), seq, nullptr, nullptr);
+    if (r == ParseResult::Ok) {
+      if (haveSeq && seq != (uint16_t)(lastSeq + 1)) {
+        gaps += (uint16_t)(seq - lastSeq - 1);
+        printf("# Lücke: %u Frame(s) vor seq %u\n", (uint16_t)(seq - lastSeq - 1), seq);
+      }
+      haveSeq = true; lastSeq = seq;
+      printf("frame seq=%u (%zu Byte)\n", seq, enc.size() + 1);
+      parseFrame(enc.data(), enc.size(), scratch.data(), seq, printMsg, nullptr);
+      frames++;
+    } else {
+      errors[(int)r]++;
+      printf("# verworfen: %s (%zu Byte)\n", PARSE_NAMES[(int)r], enc.size() + 1);
+    }
+    enc.clear();
+    fflush(stdout);
+  }
+  fprintf(stderr, "%u Frames, %u verloren (seq), Fehler: cobs=%u short=%u crc=%u version=%u malformed=%u\n",
+          frames, gaps, errors[1], errors[2], errors[3], errors[4], errors[5]);
+  return 0;
+}
+
+// ---------------------------- Zufallsnachrichten -----------------------------
+struct Msg { MsgType type; std::vector<uint8_t> payload; };
+
+static Msg randomMsg(std::mt19937& rng){
+  uint8_t buf[MAX_PAYLOAD];
+  size_t n = 0;
+  Msg m;
+  switch (rng() % 3) {
+    case 0: {
+      GestureMsg g;
+      g.type = (uint8_t)(rng() % 14); g.fingers = (uint8_t)(rng() % 4);
+      g.x = (uint16_t)(rng() % 240); g.y = (uint16_t)(rng() % 320);
+      g.valueMilli = (int32_t)rng(); g.ageMs = (uint16_t)rng();
+      m.type = MsgType::Gesture; n = encodeGesture(g, buf);
+      break;
+    }
+    case 1: {
+      ImuBatchMsg b;
+      b.t0Ms = rng(); b.dtMs = 50; b.count = (uint8_t)(1 + rng() % 8);
+      for (uint8_t i = 0; i < b.count; i++) {
+        b.s[i] = { (int16_t)rng(), (int16_t)rng(), (int16_t)rng(), (int16_t)rng(), (int16_t)rng(), (int16_t)rng() };
+      }
+      m.type = MsgType::ImuBatch; n = encodeImuBatch(b, buf);
+      break;
+    }
+    default: {
+      TouchStateMsg t;
+      t.count = (uint8_t)(rng() % (TOUCH_MAX + 1));
+      for (uint8_t i = 0; i < t.count; i++) {
+        t.p[i] = { i, (uint16_t)rng(), (uint16_t)rng(), (uint16_t)rng() };
+      }
+      m.type = MsgType::TouchState; n = encodeTouchState(t, buf);
+      break;
+    }
+  }
+  // Zufällig viele Nullbytes einstreuen, damit COBS-Sonderfälle vorkommen
+  if (rng() % 4 == 0) for (size_t i = 0; i < n; i++) if (rng() % 3 == 0) buf[i] = 0;
+  m.payload.assign(buf, buf + n);
+  return m;
+}
+
+// Nachrichten in Frames packen (wie TelemetryLink::add/send)
+static size_t packFrames(const std::vector<Msg>& msgs, size_t mtu, uint16_t& seq,
+                         std::vector<std::vector<uint8_t>>& frames){
+  static uint8_t wire[MAX_RAW * 2];
+  FrameBuilder fb;
+  fb.begin(seq, mtu);
+  size_t bytes = 0;
+  auto flush = [&](){
+    if (fb.empty()) return;
+    size_t n = fb.finish(wire);
+    frames.emplace_back(wire, wire + n);
+    bytes += n;
+    fb.begin(++seq, mtu);
+  };
+  for (const Msg& m : msgs) {
+    if (!fb.fits(m.payload.size())) flush();
+    fb.add(m.type, m.payload.data(), m.payload.size());
+  }
+  flush();
+  return bytes;
+}
+
+struct Collect { std::vector<Msg>* out; };
+static void collectMsg(MsgType t, const uint8_t* p, size_t n, void* ctx){
+  static_cast<Collect*>(ctx)->out->push_back({t, std::vector<uint8_t>(p, p + n)});
+}
+
+// ---------------------------- fuzz -------------------------------------------
+static int fuzz(uint32_t iterations){
+  std::mt19937 rng(12345);
+  uint32_t corruptOk = 0, corruptRejected = 0;
+  for (uint32_t it = 0; it < iterations; it++) {
+    const size_t mtu = 32 + rng() % (MAX_RAW - 32);
+    std::vector<Msg> msgs;
+    const size_t count = 1 + rng() % 40;
+    for (size_t i = 0; i < count; i++) {
+      Msg m = randomMsg(rng);
+      if (cobsMaxEncoded(HEADER + MSG_HEADER + m.payload.size() + TRAILER) + 1 <= mtu) msgs.push_back(m);
+    }
+    uint16_t seq = (uint16_t)rng();
+    const uint16_t seq0 = seq;
+    std::vector<std::vector<uint8_t>> frames;
+    packFrames(msgs, mtu, seq, frames);
+
+    // Round-Trip: jede Nachricht identisch, Reihenfolge und Sequenz stimmen
+    std::vector<Msg> back;
+    Collect col{&back};
+    for (size_t f = 0; f < frames.size(); f++) {
+      const auto& fr = frames[f];
+      if (fr.size() > mtu || fr.back() != 0 || memchr(fr.data(), 0, fr.size() - 1)) {
+        fprintf(stderr, "FAIL it=%u: Frame %zu verletzt MTU/Trenner\n", it, f); return 1;
+      }
+      std::vector<uint8_t> scratch(fr.size());
+      uint16_t s = 0;
+      ParseResult r = parseFrame(fr.data(), fr.size() - 1, scratch.data(), s, collectMsg, &col);
+      if (r != ParseResult::Ok || s != (uint16_t)(seq0 + f)) {
+        fprintf(stderr, "FAIL it=%u: Frame %zu -> %s seq=%u\n", it, f, PARSE_NAMES[(int)r], s); return 1;
+      }
+    }
+    if (back.size() != msgs.size()) { fprintf(stderr, "FAIL it=%u: %zu/%zu Nachrichten\n", it, back.size(), msgs.size()); return 1; }
+    for (size_t i = 0; i < msgs.size(); i++) {
+      if (back[i].type != msgs[i].type || back[i].payload != msgs[i].payload) {
+        fprintf(stderr, "FAIL it=%u: Nachricht %zu verändert\n", it, i); return 1;
+      }
+    }
+
+    // Störung: Bitfehler oder abgeschnittener Frame darf nie als gültig durchgehen,
+    // es sei denn, die CRC passt zufällig (2^-32) – Parser darf nicht abstürzen
+    for (const auto& fr : frames) {
+      std::vector<uint8_t> bad(fr.begin(), fr.end() - 1);
+      if (rng() % 2) bad[rng() % bad.size()] ^= (uint8_t)(1u << (rng() % 8));
+      else bad.resize(rng() % bad.size());
+      if (bad == std::vector<uint8_t>(fr.begin(), fr.end() - 1)) continue;
+      std::vector<uint8_t> scratch(bad.size() + 1);
+      uint16_t s = 0;
+      if (parseFrame(bad.data(), bad.size(), scratch.data(), s, nullptr, nullptr) == ParseResult::Ok) corruptOk++;
+      else corruptRejected++;
+    }
+  }
+  printf("fuzz: %u Iterationen ok, gestörte Frames: %u verworfen, %u unerkannt\n",
+         iterations, corruptRejected, corruptOk);
+  return corruptOk ? 1 : 0;
+}
+
+// ---------------------------- bench ------------------------------------------
+static void bench(size_t mtu){
+  std::mt19937 rng(1);
+  std::vector<Msg> msgs;
+  size_t payloadBytes = 0;
+  for (int i = 0; i < 20000; i++) { msgs.push_back(randomMsg(rng)); payloadBytes += msgs.back().payload.size(); }
+
+  using clk = std::chrono::steady_clock;
+  std::vector<std::vector<uint8_t>> frames;
+  uint16_t seq = 0;
+  const int reps = 20;
+  size_t wireBytes = 0;
+  auto t0 = clk::now();
+  for (int r = 0; r < reps; r++) { frames.clear(); wireBytes = packFrames(msgs, mtu, seq, frames); }
+  double encS = std::chrono::duration<double>(clk::now() - t0).count() / reps;
+
+  std::vector<uint8_t> scratch(MAX_RAW * 2);
+  t0 = clk::now();
+  size_t ok = 0;
+  for (int r = 0; r < reps; r++) {
+    for (const auto& fr : frames) {
+      uint16_t s;
+      ok += parseFrame(fr.data(), fr.size() - 1, scratch.data(), s, nullptr, nullptr) == ParseResult::Ok;
+    }
+  }
+  double decS = std::chrono::duration<double>(clk::now() - t0).count() / reps;
+
+  // Vergleich: jede Nachricht in einem eigenen Frame
+  std::vector<std::vector<uint8_t>> single;
+  size_t singleBytes = 0;
+  for (const Msg& m : msgs) {
+    std::vector<Msg> one{m};
+    singleBytes += packFrames(one, mtu, seq, single);
+  }
+
+  printf("MTU %zu: %zu Nachrichten, %zu Byte Nutzdaten\n", mtu, msgs.size(), payloadBytes);
+  printf("  encode: %8.1f MB/s  (%.2f us/Frame)\n", wireBytes / encS / 1e6, encS * 1e6 / frames.size());
+  printf("  decode: %8.1f MB/s  (%.2f us/Frame, %zu/%zu ok)\n", wireBytes / decS / 1e6,
+         decS * 1e6 / frames.size(), ok / reps, frames.size());
+  printf("  gebündelt: %6zu Frames, %7zu Byte Leitung (Overhead %.1f %%, %.1f Nachr./Frame)\n",
+         frames.size(), wireBytes, 100.0 * (wireBytes - payloadBytes) / payloadBytes,
+         (double)msgs.size() / frames.size());
+  printf("  einzeln:   %6zu Frames, %7zu Byte Leitung (Overhead %.1f %%)\n",
+         single.size(), singleBytes, 100.0 * (singleBytes - payloadBytes) / payloadBytes);
+
+  // Leitungszeit inkl. 3.5 Zeichen Pause je Frame (Richtungswechsel/Turnaround)
+  for (unsigned baud : {9600u, 115200u, 921600u}) {
+    const double charS = 11.0 / baud;
+    double tB = (wireBytes + frames.size() * 3.5) * charS;
+    double tS = (singleBytes + single.size() * 3.5) * charS;
+    printf("  %6u Baud: %8.0f Nachr./s gebündelt, %8.0f Nachr./s einzeln\n",
+           baud, msgs.size() / tB, msgs.size() / tS);
+  }
+}
+
+int main(int argc, char** argv){
+  if (argc >= 3 && !strcmp(argv[1], "decode")) {
+    FILE* f = strcmp(argv[2], "-") ? fopen(argv[2], "rb") : stdin;
+    if (!f) { perror(argv[2]); return 1; }
+    return decodeStream(f);
+  }
+  if (argc >= 2 && !strcmp(argv[1], "bench")) {
+    bench(argc >= 3 ? (size_t)atoi(argv[2]) : 128);
+    return 0;
+  }
+  if (argc >= 2 && !strcmp(argv[1], "fuzz")) {
+    return fuzz(argc >= 3 ? (uint32_t)atoi(argv[2]) : 20000);
+  }
+  fprintf(stderr, "usage: %s decode <datei|->\n"
+                  "       %s bench [mtu=128]\n"
+                  "       %s fuzz [n=20000]\n", argv[0], argv[0], argv[0]);
+  return 2;
+}
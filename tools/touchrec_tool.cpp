@@ -0,0 +1,414 @@
+// ============================================================================
+// File: tools/touchrec_tool.cpp
+// ----------------------------------------------------------------------------
+// Purpose: Host-Seite der Touch-Aufnahmen (src/touch/TouchSession.cpp)
+//  info   <f.trc>              Frames, Dauer, Größe, B/Frame, Vergleich mit
+//                              festen Records
+//  dump   <f.trc> [n]          Rohframes als Text (µs ab Beginn, x y s je Finger)
+//  replay <f.trc> [tempo]      Tracker + GestureEngine wie am Gerät ("touchrec
+//                              play"), gleiche Ausgabe und Prüfsumme; tempo > 0
+//                              bremst auf Uhrzeit, Vorgabe 0 = so schnell wie möglich
+//  text   <f.trc> <out.txt>    Display-Frames im Format von tools/gesture_tune
+//                              (Labels von Hand ergänzen)
+//  synth  <out.trc> [min=60] [seed=1]
+//                              Sitzung mit Ruhe, Taps, Wischen, Long-Press,
+//                              Zwei-Finger-Gesten; Poll alle INPUT_TOUCH_POLL_US
+//  bench  [f.trc]              Kodieren/Dekodieren (MB/s, Frames/s), Wiedergabe
+//                              (x Echtzeit), Kompression; ohne Datei: synth 60 min
+//  fuzz   [n=2000]             Round-Trips, gestörte Daten, Wiedergabe in
+//                              zufälligen Schritten = ein Durchlauf (Exit 1 bei Fehler)
+// Build: g++ -O2 -std=c++17 tools/touchrec_tool.cpp src/touch/TouchSession.cpp src/touch/TouchTracker.cpp src/gestures/GestureEngine.cpp -o touchrec_tool
+// ============================================================================
+#include "../src/touch/TouchSession.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+static constexpr size_t RAW_FRAME_BYTES = 27 + 8;   // CST328-Registerblock + 64-Bit-Zeit
+
+static bool readFile(const char* path, std::vector<uint8_t>& out){
+  FILE* f = fopen(path, "rb");
+  if (!f) { perror(path); return false; }
+  uint8_t buf[65536];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+static bool writeFile(const char* path, const uint8_t* p, size_t n){
+  FILE* f = fopen(path, "wb");
+  if (!f || fwrite(p, 1, n, f) != n) { perror(path); if (f) fclose(f); return false; }
+  fclose(f);
+  return true;
+}
+
+// ---------------------------- info / dump / text ----------------------------
+static int info(const std::vector<uint8_t>& d){
+  TouchReader r;
+  if (!r.begin(d.data(), d.size())) { fprintf(stderr, "kein gültiger Kopf\n"); return 1; }
+  TouchRecFrame f;
+  uint64_t frames = 0, points = 0, empty = 0, last = r.startUs();
+  uint8_t maxN = 0;
+  while (r.next(f)) {
+    frames++;
+    points += f.n;
+    empty += f.n == 0;
+    if (f.n > maxN) maxN = f.n;
+    last = f.us;
+  }
+  const double secs = (last - r.startUs()) / 1e6;
+  const uint64_t fixed = frames * 9 + points * 6;   // 8 B Zeit + n + 6 B je Finger
+  printf("%zu B, %llu Frames (%llu leer, max. %u Finger) in %.1f s, %.2f B/Frame\n",
+         d.size(), (unsigned long long)frames, (unsigned long long)empty, maxN, secs,
+         frames ? (double)d.size() / frames : 0.0);
+  printf("feste Records: %llu B (x%.1f), Rohframes: %llu B (x%.1f, nur gespeicherte Frames)\n",
+         (unsigned long long)fixed, (double)fixed / d.size(),
+         (unsigned long long)(frames * RAW_FRAME_BYTES), (double)frames * RAW_FRAME_BYTES / d.size());
+  if (secs > 0) {
+    printf("Rate %.1f B/s: %u KB Puffer (TOUCH_REC_BYTES) reichen %.1f h\n", d.size() / secs,
+           (unsigned)(TOUCH_REC_BYTES / 1024), TOUCH_REC_BYTES / (d.size() / secs) / 3600.0);
+  }
+  if (r.error()) { fprintf(stderr, "Fehler bei Offset %zu\n", r.offset()); return 1; }
+  return 0;
+}
+
+static int dump(const std::vector<uint8_t>& d, uint64_t max){
+  TouchReader r;
+  if (!r.begin(d.data(), d.size())) { fprintf(stderr, "kein gültiger Kopf\n"); return 1; }
+  TouchRecFrame f;
+  for (uint64_t k = 0; k < max && r.next(f); k++) {
+    printf("%12llu %u", (unsigned long long)(f.us - r.startUs()), f.n);
+    for (uint8_t i = 0; i < f.n; i++) printf("  %4u %4u %3u", f.p[i].x, f.p[i].y, f.p[i].strength);
+    printf("\n");
+  }
+  if (r.error()) { fprintf(stderr, "Fehler bei Offset %zu\n", r.offset()); return 1; }
+  return 0;
+}
+
+static int text(const std::vector<uint8_t>& d, const char* out){
+  TouchReader r;
+  if (!r.begin(d.data(), d.size())) { fprintf(stderr, "kein gültiger Kopf\n"); return 1; }
+  FILE* o = fopen(out, "w");
+  if (!o) { perror(out); return 1; }
+  fprintf(o, "# aus touchrec: Display-Koordinaten, Zeit in ms ab Aufnahmebeginn\n"
+             "# vor jede Geste 'label <Geste>' setzen (siehe tools/gesture_tune.cpp)\n");
+  TouchRecFrame f;
+  size_t n = 0;
+  while (r.next(f)) {
+    fprintf(o, "%llu %u", (unsigned long long)((f.us - r.startUs()) / 1000u), f.n);
+    for (uint8_t i = 0; i < f.n; i++) {
+      TouchContact c;
+      touchRawToContact(f.p[i], c);
+      fprintf(o, " %u %u", c.x, c.y);
+    }
+    fprintf(o, "\n");
+    n++;
+  }
+  fclose(o);
+  printf("%zu Frames -> %s\n", n, out);
+  return r.error() ? 1 : 0;
+}
+
+// ---------------------------- replay ----------------------------------------
+static const char* const GESTURE_NAMES[] = {
+  "None", "Tap", "DoubleTap", "LongPress", "SwipeLeft", "SwipeRight", "SwipeUp",
+  "SwipeDown", "PinchIn", "PinchOut", "RotateCW", "RotateCCW", "TwoFingerTap", "ThreeFingerTap"
+};
+
+static void printEvent(void*, const GestureEvent& e){
+  printf("%10u ms  %-14s fingers=%u at (%u,%u) value=%.2f\n", e.timestamp,
+         (size_t)e.type < 14 ? GESTURE_NAMES[(size_t)e.type] : "?", e.finger_count, e.x, e.y, e.value);
+}
+
+static int replay(const std::vector<uint8_t>& d, double speed){
+  TouchReplay rp;
+  if (!rp.begin(d.data(), d.size(), GestureParams{}, printEvent, nullptr)) {
+    fprintf(stderr, "keine gültige Aufnahme\n");
+    return 1;
+  }
+  using clk = std::chrono::steady_clock;
+  const auto t0 = clk::now();
+  if (speed > 0) {
+    // Wie am Gerät: Eingabe-Schritt etwa jede Millisekunde
+    while (rp.advance((uint64_t)(std::chrono::duration<double, std::micro>(clk::now() - t0).count() * speed))) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  } else {
+    while (rp.advance(UINT64_MAX, TOUCH_REPLAY_MAX_CALLS)) {}
+  }
+  const double wall = std::chrono::duration<double>(clk::now() - t0).count();
+  printf("[TREC] Wiedergabe fertig: frames=%lu calls=%lu events=%lu hash=%08lX, %.1f s in %.1f s\n",
+         (unsigned long)rp.frames(), (unsigned long)rp.calls(), (unsigned long)rp.events(),
+         (unsigned long)rp.hash(), rp.positionUs() / 1e6, wall);
+  return 0;
+}
+
+// ---------------------------- synth -----------------------------------------
+// Rohkoordinaten (12 Bit) mit Sensorrauschen; Frames alle 5 ms (Poll) und
+// dazwischen IRQ-Frames, solange ein Finger liegt
+struct SynthStats { uint64_t seen = 0, points = 0; };
+
+static void synthSession(double minutes, unsigned seed, std::vector<TouchRecFrame>& out, SynthStats& st){
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> U(0.0, 1.0);
+  auto noise = [&](double v){ return (uint16_t)std::lround(std::fmin(4095.0, std::fmax(0.0, v + (U(rng) < 0.5 ? 0 : (int)(U(rng) * 5) - 2)))); };
+  const uint64_t endUs = (uint64_t)(minutes * 60e6);
+  uint64_t t = 1000000;
+  out.clear();
+  st = SynthStats{};
+
+  auto idle = [&](uint64_t untilUs){
+    for (; t < untilUs; t += INPUT_TOUCH_POLL_US) {
+      TouchRecFrame f;
+      f.us = t;
+      out.push_back(f);
+    }
+  };
+  // Finger i bewegt sich von a nach b über durUs
+  struct Stroke { double x0, y0, x1, y1; };
+  auto touch = [&](const Stroke* s, uint8_t n, uint64_t durUs){
+    const uint64_t t0 = t;
+    const uint16_t pres = (uint16_t)(30 + U(rng) * 40);
+    while (t - t0 <= durUs) {
+      const double k = durUs ? (double)(t - t0) / durUs : 1.0;
+      TouchRecFrame f;
+      f.us = t;
+      f.n = n;
+      for (uint8_t i = 0; i < n; i++) {
+        f.p[i] = {noise(s[i].x0 + (s[i].x1 - s[i].x0) * k), noise(s[i].y0 + (s[i].y1 - s[i].y0) * k),
+                  (uint16_t)(pres + (U(rng) < 0.7 ? 0 : (int)(U(rng) * 7) - 3))};
+      }
+      out.push_back(f);
+      st.points += n;
+      t += 2000 + (uint64_t)(U(rng) * 4000);     // IRQ bzw. Poll
+    }
+    TouchRecFrame up;
+    up.us = t;
+    out.push_back(up);
+    t += INPUT_TOUCH_POLL_US;
+  };
+  auto pos = [&]{ return 400.0 + U(rng) * 3300.0; };
+
+  while (t < endUs) {
+    idle(t + (uint64_t)(-std::log(1.0 - U(rng)) * 8e6));      // Pause, Mittel 8 s
+    const double x = pos(), y = pos();
+    const int kind = (int)(U(rng) * 7);
+    Stroke s[2];
+    switch (kind) {
+      case 0:                                                  // Tap
+        s[0] = {x, y, x, y};
+        touch(s, 1, 60000 + (uint64_t)(U(rng) * 120000));
+        break;
+      case 1:                                                  // Doppeltipp
+        s[0] = {x, y, x, y};
+        touch(s, 1, 80000);
+        idle(t + 120000);
+        touch(s, 1, 80000);
+        break;
+      case 2:                                                  // Long-Press
+        s[0] = {x, y, x + 10, y - 10};
+        touch(s, 1, 900000 + (uint64_t)(U(rng) * 600000));
+        break;
+      case 3: case 4: {                                        // Wischen
+        const double a = U(rng) * 6.2832, len = 800 + U(rng) * 1500;
+        s[0] = {x, y, x + std::cos(a) * len, y + std::sin(a) * len};
+        touch(s, 1, 150000 + (uint64_t)(U(rng) * 250000));
+        break;
+      }
+      case 5:                                                  // Ziehen (langsam)
+        s[0] = {x, y, pos(), pos()};
+        touch(s, 1, 1000000 + (uint64_t)(U(rng) * 2000000));
+        break;
+      default: {                                               // Zwei Finger: Pinch
+        const double d0 = 300 + U(rng) * 400, d1 = d0 + (U(rng) < 0.5 ? -1 : 1) * (200 + U(rng) * 300);
+        s[0] = {2048 - d0, 2048, 2048 - d1, 2048};
+        s[1] = {2048 + d0, 2048, 2048 + d1, 2048};
+        touch(s, 2, 300000 + (uint64_t)(U(rng) * 300000));
+        break;
+      }
+    }
+  }
+  st.seen = out.size();
+}
+
+static size_t encode(const std::vector<TouchRecFrame>& fr, std::vector<uint8_t>& buf, TouchRecorder& rec){
+  buf.resize(fr.size() * trec::FRAME_MAX / 4 + (1u << 20));
+  rec.begin(buf.data(), buf.size());
+  rec.start(fr.empty() ? 0 : fr.front().us);
+  for (const auto& f : fr) {
+    if (!rec.append(f.us, f.p, f.n)) break;
+  }
+  rec.stop();
+  return rec.size();
+}
+
+static int synth(const char* out, double minutes, unsigned seed){
+  std::vector<TouchRecFrame> fr;
+  SynthStats st;
+  synthSession(minutes, seed, fr, st);
+  std::vector<uint8_t> buf;
+  TouchRecorder rec;
+  const size_t n = encode(fr, buf, rec);
+  printf("%.0f min: %llu Frames gelesen, %lu gespeichert, %zu B (%.2f B/Frame), Kompression x%.1f gegen Rohframes\n",
+         minutes, (unsigned long long)st.seen, (unsigned long)rec.frames(), n, (double)n / rec.frames(),
+         (double)st.seen * RAW_FRAME_BYTES / n);
+  return writeFile(out, buf.data(), n) ? 0 : 1;
+}
+
+// ---------------------------- bench -----------------------------------------
+static int bench(const char* path){
+  using clk = std::chrono::steady_clock;
+  std::vector<TouchRecFrame> fr;
+  SynthStats st;
+  std::vector<uint8_t> data;
+  if (path) {
+    if (!readFile(path, data)) return 1;
+    TouchReader r;
+    TouchRecFrame f;
+    if (!r.begin(data.data(), data.size())) { fprintf(stderr, "kein gültiger Kopf\n"); return 1; }
+    while (r.next(f)) { fr.push_back(f); st.points += f.n; }
+    st.seen = fr.size();                          // Leerframes kennt die Datei nicht
+  } else {
+    synthSession(60, 1, fr, st);
+  }
+
+  std::vector<uint8_t> buf;
+  TouchRecorder rec;
+  const int reps = 5;
+  auto t0 = clk::now();
+  size_t n = 0;
+  for (int k = 0; k < reps; k++) n = encode(fr, buf, rec);
+  const double encS = std::chrono::duration<double>(clk::now() - t0).count() / reps;
+
+  TouchRecFrame f;
+  uint64_t sum = 0, decoded = 0;
+  t0 = clk::now();
+  for (int k = 0; k < reps; k++) {
+    TouchReader r;
+    r.begin(buf.data(), n);
+    while (r.next(f)) { sum += f.p[0].x; decoded++; }
+  }
+  const double decS = std::chrono::duration<double>(clk::now() - t0).count() / reps;
+  decoded /= reps;
+
+  TouchReplay rp;
+  rp.begin(buf.data(), n, GestureParams{}, nullptr, nullptr);
+  t0 = clk::now();
+  while (rp.advance(UINT64_MAX)) {}
+  const double repS = std::chrono::duration<double>(clk::now() - t0).count();
+
+  const uint64_t fixed = (uint64_t)rec.frames() * 9 + st.points * 6;
+  printf("%llu Frames gelesen, %llu gespeichert (%llu Fingerpunkte), %.1f min\n",
+         (unsigned long long)st.seen, (unsigned long long)rec.frames(), (unsigned long long)st.points,
+         rec.durationUs() / 60e6);
+  printf("  Größe:   %zu B, %.2f B/gespeichertem Frame, %.1f B/s\n", n, (double)n / rec.frames(),
+         n / (rec.durationUs() / 1e6));
+  printf("  Kompression: x%.1f gegen Rohframes (%zu B je gelesenem Frame), x%.1f gegen feste Records\n",
+         (double)st.seen * RAW_FRAME_BYTES / n, RAW_FRAME_BYTES, (double)fixed / n);
+  printf("  TOUCH_REC_BYTES = %u KB reichen %.1f h\n", (unsigned)(TOUCH_REC_BYTES / 1024),
+         TOUCH_REC_BYTES / (n / (rec.durationUs() / 1e6)) / 3600.0);
+  printf("  encode:  %8.1f MB/s  %6.1f MFrames/s (gelesene Frames)\n", n / encS / 1e6, st.seen / encS / 1e6);
+  printf("  decode:  %8.1f MB/s  %6.1f MFrames/s  (%llu Frames, Prüfwert %llu)\n", n / decS / 1e6,
+         decoded / decS / 1e6, (unsigned long long)decoded, (unsigned long long)(sum & 0xFFFF));
+  printf("  replay:  %8.0f Frames/s, x%.0f Echtzeit (%lu Engine-Aufrufe, %lu Gesten, hash=%08lX)\n",
+         rp.frames() / repS, rp.positionUs() / 1e6 / repS, (unsigned long)rp.calls(),
+         (unsigned long)rp.events(), (unsigned long)rp.hash());
+  return 0;
+}
+
+// ---------------------------- fuzz ------------------------------------------
+static int fails = 0;
+static void check(bool ok, const char* what, unsigned it){
+  if (!ok) { fails++; fprintf(stderr, "FAIL it=%u: %s\n", it, what); }
+}
+
+static int fuzz(unsigned iterations){
+  std::mt19937 rng(7);
+  unsigned corruptErr = 0, corruptOk = 0;
+  for (unsigned it = 0; it < iterations; it++) {
+    // Zufällige Frames inkl. großer Sprünge, langer Pausen (nur ohne Finger,
+    // sonst tickt die Engine die ganze Pause durch) und Wiederholungen
+    std::vector<TouchRecFrame> fr(1 + rng() % 200);
+    uint64_t t = ((uint64_t)rng() << 20) | rng();
+    for (size_t k = 0; k < fr.size(); k++) {
+      TouchRecFrame& f = fr[k];
+      const bool up = k == 0 || fr[k - 1].n == 0;
+      t += up && rng() % 4 == 0 ? ((uint64_t)rng() << 8) : rng() % 20000;
+      f.us = t;
+      f.n = (uint8_t)(rng() % (MAX_TOUCH_POINTS + 1));
+      for (uint8_t i = 0; i < f.n; i++) {
+        if (k && rng() % 3 == 0 && i < fr[k - 1].n) { f.p[i] = fr[k - 1].p[i]; continue; }
+        f.p[i] = {(uint16_t)(rng() % 4096), (uint16_t)(rng() % 4096), (uint16_t)(rng() % 256)};
+      }
+      if (k && !up && rng() % 5 == 0) { f.n = fr[k - 1].n; memcpy(f.p, fr[k - 1].p, sizeof(f.p)); }
+    }
+    std::vector<uint8_t> buf;
+    TouchRecorder rec;
+    const size_t n = encode(fr, buf, rec);
+
+    // Round-Trip: alle Frames außer Leerframes nach Leerframes, identisch
+    TouchReader r;
+    check(r.begin(buf.data(), n), "Kopf", it);
+    TouchRecFrame f;
+    uint8_t lastN = 0;
+    bool same = true;
+    for (const auto& e : fr) {
+      if (e.n == 0 && lastN == 0) continue;
+      lastN = e.n;
+      if (!r.next(f) || f.us != e.us || f.n != e.n ||
+          memcmp(f.p, e.p, sizeof(RawCSTPoint) * e.n) != 0) { same = false; break; }
+    }
+    check(same && !r.next(f) && !r.error(), "Round-Trip", it);
+
+    // Wiedergabe in zufälligen Schritten = ein Durchlauf (Tempo egal)
+    TouchReplay a, b;
+    a.begin(buf.data(), n, GestureParams{}, nullptr, nullptr);
+    b.begin(buf.data(), n, GestureParams{}, nullptr, nullptr);
+    while (a.advance(UINT64_MAX)) {}
+    uint64_t rel = 0;
+    while (b.advance(rel += rng() % 2 ? rng() % 30000 : (uint64_t)rng() << 10, 1 + rng() % 8)) {}
+    check(a.hash() == b.hash() && a.events() == b.events() && a.calls() == b.calls(), "Wiedergabe schrittweise", it);
+
+    // Gestört: darf nicht abstürzen; abgeschnitten/verfälscht meist erkannt.
+    // Ein verfälschter Zeitsprung bei liegendem Finger tickt lange: begrenzt
+    std::vector<uint8_t> bad(buf.begin(), buf.begin() + n);
+    if (rng() % 2) bad[rng() % bad.size()] ^= (uint8_t)(1u << (rng() % 8));
+    else bad.resize(rng() % bad.size());
+    TouchReplay c;
+    if (c.begin(bad.data(), bad.size(), GestureParams{}, nullptr, nullptr)) {
+      c.advance(UINT64_MAX, 200000);
+      corruptOk++;
+    } else {
+      corruptErr++;
+    }
+  }
+  printf("fuzz: %u Iterationen, gestörte Aufnahmen: %u abgewiesen, %u lesbar (Varint-Format ohne CRC)\n",
+         iterations, corruptErr, corruptOk);
+  printf("\n%s (%d Fehler)\n", fails ? "FEHLER" : "OK", fails);
+  return fails ? 1 : 0;
+}
+
+int main(int argc, char** argv){
+  std::vector<uint8_t> d;
+  if (argc >= 3 && !strcmp(argv[1], "info")) return readFile(argv[2], d) ? info(d) : 1;
+  if (argc >= 3 && !strcmp(argv[1], "dump")) {
+    return readFile(argv[2], d) ? dump(d, argc >= 4 ? strtoull(argv[3], nullptr, 10) : UINT64_MAX) : 1;
+  }
+  if (argc >= 3 && !strcmp(argv[1], "replay")) {
+    return readFile(argv[2], d) ? replay(d, argc >= 4 ? atof(argv[3]) : 0.0) : 1;
+  }
+  if (argc >= 4 && !strcmp(argv[1], "text")) return readFile(argv[2], d) ? text(d, argv[3]) : 1;
+  if (argc >= 3 && !strcmp(argv[1], "synth")) {
+    return synth(argv[2], argc >= 4 ? atof(argv[3]) : 60.0, argc >= 5 ? (unsigned)atoi(argv[4]) : 1);
+  }
+  if (argc >= 2 && !strcmp(argv[1], "bench")) return bench(argc >= 3 ? argv[2] : nullptr);
+  if (argc >= 2 && !strcmp(argv[1], "fuzz")) return fuzz(argc >= 3 ? (unsigned)atoi(argv[2]) : 2000);
+  fprintf(stderr, "usage: %s info|dump|replay|text|synth|bench|fuzz ... (siehe Kopf der Datei)\n", argv[0]);
+  return 2;
+}